@@ -0,0 +1,123 @@
+#include "benchmarks/allocation_counter.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace dbc_parser {
+namespace bench {
+namespace {
+
+std::atomic<std::uint64_t> g_allocations{0};
+std::atomic<std::uint64_t> g_bytes{0};
+std::atomic<std::uint64_t> g_live_bytes{0};
+std::atomic<std::uint64_t> g_peak_live_bytes{0};
+
+// Every block starts with a header holding its size, so that the unsized
+// operator delete can account for the bytes it frees. The header keeps the
+// alignment malloc guarantees.
+constexpr std::size_t kHeaderSize = alignof(std::max_align_t);
+
+void RaisePeak(std::uint64_t live) noexcept {
+  std::uint64_t peak = g_peak_live_bytes.load(std::memory_order_relaxed);
+  while (live > peak && !g_peak_live_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+  }
+}
+
+void* CountedAllocate(std::size_t size) noexcept {
+  if (size > SIZE_MAX - kHeaderSize) {
+    return nullptr;
+  }
+  void* block = std::malloc(kHeaderSize + size);
+  if (block == nullptr) {
+    return nullptr;
+  }
+  *static_cast<std::size_t*>(block) = size;
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  g_bytes.fetch_add(size, std::memory_order_relaxed);
+  RaisePeak(g_live_bytes.fetch_add(size, std::memory_order_relaxed) + size);
+  return static_cast<char*>(block) + kHeaderSize;
+}
+
+void CountedFree(void* ptr) noexcept {
+  if (ptr == nullptr) {
+    return;
+  }
+  void* block = static_cast<char*>(ptr) - kHeaderSize;
+  g_live_bytes.fetch_sub(*static_cast<std::size_t*>(block), std::memory_order_relaxed);
+  std::free(block);
+}
+
+}  // namespace
+
+AllocationStats CurrentAllocations() noexcept {
+  return {g_allocations.load(std::memory_order_relaxed), g_bytes.load(std::memory_order_relaxed),
+          g_live_bytes.load(std::memory_order_relaxed), g_peak_live_bytes.load(std::memory_order_relaxed)};
+}
+
+AllocationScope::AllocationScope() noexcept : start_(CurrentAllocations()) {
+  outer_peak_ = g_peak_live_bytes.exchange(start_.live_bytes, std::memory_order_relaxed);
+}
+
+AllocationScope::~AllocationScope() {
+  RaisePeak(outer_peak_);
+}
+
+AllocationStats AllocationScope::Delta() const noexcept {
+  const AllocationStats now = CurrentAllocations();
+  AllocationStats delta;
+  delta.allocations = now.allocations - start_.allocations;
+  delta.bytes = now.bytes - start_.bytes;
+  delta.live_bytes = now.live_bytes > start_.live_bytes ? now.live_bytes - start_.live_bytes : 0;
+  delta.peak_live_bytes = now.peak_live_bytes > start_.live_bytes ? now.peak_live_bytes - start_.live_bytes : 0;
+  return delta;
+}
+
+}  // namespace bench
+}  // namespace dbc_parser
+
+// Replacements for the global allocation functions. The array and sized forms
+// are replaced as well so that no path bypasses the counters.
+void* operator new(std::size_t size) {
+  if (void* ptr = dbc_parser::bench::CountedAllocate(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+  return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  return dbc_parser::bench::CountedAllocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  return dbc_parser::bench::CountedAllocate(size);
+}
+
+void operator delete(void* ptr) noexcept {
+  dbc_parser::bench::CountedFree(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  dbc_parser::bench::CountedFree(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+  dbc_parser::bench::CountedFree(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+  dbc_parser::bench::CountedFree(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+  dbc_parser::bench::CountedFree(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+  dbc_parser::bench::CountedFree(ptr);
+}
@@ -0,0 +1,61 @@
+#ifndef DBC_PARSER_BENCHMARKS_ALLOCATION_COUNTER_H_
+#define DBC_PARSER_BENCHMARKS_ALLOCATION_COUNTER_H_
+
+#include <cstdint>
+
+namespace dbc_parser {
+namespace bench {
+
+/**
+ * @brief Process-wide heap usage totals recorded by the replaced operator new.
+ */
+struct AllocationStats {
+  std::uint64_t allocations = 0;      ///< Number of successful operator new calls
+  std::uint64_t bytes = 0;            ///< Total bytes requested from operator new
+  std::uint64_t live_bytes = 0;       ///< Bytes allocated and not yet freed
+  std::uint64_t peak_live_bytes = 0;  ///< Highest live_bytes seen
+};
+
+/**
+ * @brief Returns the totals accumulated since program start.
+ *
+ * Linking the allocation_counter target replaces the global operator new and
+ * operator delete, so every heap allocation in the binary is counted. The
+ * over-aligned forms are left to the standard library and are not counted.
+ */
+[[nodiscard]] AllocationStats CurrentAllocations() noexcept;
+
+/**
+ * @brief Measures the allocations made between construction and Delta().
+ *
+ * Counters are global, so the measured region should not race with other
+ * allocating threads. Scopes may nest: a scope restarts the peak at the
+ * current live size and, when destroyed, restores the peak of the enclosing
+ * scope.
+ */
+class AllocationScope {
+ public:
+  AllocationScope() noexcept;
+  ~AllocationScope();
+
+  AllocationScope(const AllocationScope&) = delete;
+  AllocationScope& operator=(const AllocationScope&) = delete;
+
+  /**
+   * @brief Returns the allocations made since this scope was created.
+   *
+   * live_bytes is what the scope allocated and still holds (memory it freed
+   * from before the scope does not count against it); peak_live_bytes is
+   * the highest live size above the size at construction.
+   */
+  [[nodiscard]] AllocationStats Delta() const noexcept;
+
+ private:
+  AllocationStats start_;
+  std::uint64_t outer_peak_;
+};
+
+}  // namespace bench
+}  // namespace dbc_parser
+
+#endif  // DBC_PARSER_BENCHMARKS_ALLOCATION_COUNTER_H_
@@ -0,0 +1,150 @@
+// Decoding a Vector ASC trace file: AscReader over an mmap'd file on 1..N
+// threads against the naive reader, std::getline plus istringstream fields.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "benchmarks/benchmark_inputs.h"
+#include "src/dbc_parser/decoder/asc_reader.h"
+#include "src/dbc_parser/decoder/frame_decoder.h"
+#include "src/dbc_parser/parser/dbc_file_parser.h"
+
+namespace dbc_parser {
+namespace bench {
+namespace {
+
+using decoder::AscReader;
+using decoder::CanFrame;
+using decoder::FrameDecoder;
+using decoder::LogDecodeOptions;
+using decoder::LogDecodeStats;
+using parser::DbcFile;
+using parser::DbcFileParser;
+
+constexpr int kFrames = 1000000;
+
+// A parsed database and a trace of its messages written to a temporary file
+struct TraceInput {
+  DbcFile dbc;
+  std::string path;
+  std::int64_t bytes = 0;
+};
+
+const TraceInput& Input() {
+  static const TraceInput* input = [] {
+    auto* result = new TraceInput;
+    result->dbc = *DbcFileParser().Parse(MakeDbcText(200, 8).text);
+    std::vector<const DbcFile::MessageDef*> messages;
+    for (const auto& [id, message] : result->dbc.messages_detailed) {
+      messages.push_back(&message);
+    }
+
+    std::string trace =
+        "date Mon Sep 16 10:03:02.123 am 2019\nbase hex  timestamps absolute\ninternal events logged\n"
+        "Begin Triggerblock Mon Sep 16 10:03:02.123 am 2019\n   0.000000 Start of measurement\n";
+    char line[128];
+    for (int i = 0; i < kFrames; ++i) {
+      const DbcFile::MessageDef& message = *messages[static_cast<std::size_t>(i) * 7919 % messages.size()];
+      const auto id = static_cast<std::uint32_t>(message.id);
+      const bool extended = (id & CanFrame::kDbcExtendedIdFlag) != 0;
+      int length = std::snprintf(line, sizeof(line), "%11.6f %d  %X%s             Rx   d 8", i * 0.0001,
+                                 1 + i % 2, id & 0x1FFFFFFFu, extended ? "x" : "");
+      for (int byte = 0; byte < 8; ++byte) {
+        length += std::snprintf(line + length, sizeof(line) - length, " %02X", (i * 31 + byte * 17) & 0xFF);
+      }
+      trace.append(line, static_cast<std::size_t>(length)).append("\n");
+    }
+    trace += "End TriggerBlock\n";
+
+    result->path = (std::filesystem::temp_directory_path() / "asc_reader_benchmark.asc").string();
+    std::ofstream(result->path, std::ios::binary) << trace;
+    result->bytes = static_cast<std::int64_t>(trace.size());
+    return result;
+  }();
+  return *input;
+}
+
+void Report(benchmark::State& state, std::int64_t bytes, std::int64_t frames) {
+  state.SetBytesProcessed(bytes * static_cast<std::int64_t>(state.iterations()));
+  state.SetItemsProcessed(frames * static_cast<std::int64_t>(state.iterations()));
+}
+
+// Argument: worker threads
+void BM_AscReader(benchmark::State& state) {
+  const TraceInput& input = Input();
+  const FrameDecoder frame_decoder(input.dbc);
+  LogDecodeOptions options;
+  options.threads = static_cast<std::size_t>(state.range(0));
+  const AscReader reader(frame_decoder, options);
+
+  std::int64_t frames = 0;
+  for (auto _ : state) {
+    const std::optional<LogDecodeStats> stats = reader.DecodeFile(input.path);
+    if (!stats || stats->frames != kFrames) {
+      state.SkipWithError("trace did not decode");
+      return;
+    }
+    frames = static_cast<std::int64_t>(stats->frames);
+  }
+  Report(state, input.bytes, frames);
+}
+
+// What a first version would look like: one thread, a std::string per line
+// and formatted stream extraction per field.
+void BM_AscNaiveGetline(benchmark::State& state) {
+  const TraceInput& input = Input();
+  const FrameDecoder frame_decoder(input.dbc);
+  std::vector<double> values(std::max<std::size_t>(frame_decoder.MaxSignalCount(), 1));
+
+  std::int64_t frames = 0;
+  for (auto _ : state) {
+    std::ifstream file(input.path);
+    std::string line;
+    std::int64_t signals = 0;
+    frames = 0;
+    while (std::getline(file, line)) {
+      std::istringstream fields(line);
+      double seconds;
+      int channel;
+      std::string id;
+      std::string direction;
+      std::string type;
+      unsigned dlc;
+      if (!(fields >> seconds >> channel >> id >> direction >> type >> std::hex >> dlc) || type != "d") {
+        continue;
+      }
+      CanFrame frame;
+      frame.timestamp_ns = static_cast<std::int64_t>(seconds * 1e9);
+      frame.channel = static_cast<std::uint16_t>(channel);
+      frame.id = static_cast<std::uint32_t>(std::strtoul(id.c_str(), nullptr, 16));
+      if (id.back() == 'x') {
+        frame.flags |= CanFrame::kExtended;
+      }
+      for (unsigned byte; frame.size < dlc && fields >> byte;) {
+        frame.data[frame.size++] = static_cast<std::uint8_t>(byte);
+      }
+      ++frames;
+      signals += static_cast<std::int64_t>(frame_decoder.Decode(frame, values.data()).value_or(0));
+    }
+    benchmark::DoNotOptimize(signals);
+  }
+  Report(state, input.bytes, frames);
+}
+
+BENCHMARK(BM_AscReader)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_AscNaiveGetline)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+}  // namespace
+}  // namespace bench
+}  // namespace dbc_parser
+
+BENCHMARK_MAIN();
@@ -0,0 +1,228 @@
+#include "benchmarks/benchmark_inputs.h"
+
+#include <array>
+
+namespace dbc_parser {
+namespace bench {
+namespace {
+
+constexpr std::array<const char*, 8> kSubsystems = {
+    "Engine", "Brake", "Steering", "Battery", "Door", "Climate", "Gear", "Wheel"};
+constexpr std::array<const char*, 8> kQuantities = {
+    "Speed", "Temp", "Pressure", "Status", "Torque", "Voltage", "Position", "Request"};
+constexpr std::array<const char*, 6> kNodes = {
+    "EngineControlUnit", "BrakeModule", "InstrumentCluster", "GatewayModule", "BodyController",
+    "Vector__XXX"};
+constexpr std::array<const char*, 6> kUnits = {"rpm", "degC", "kPa", "%", "Nm", "V"};
+
+std::string Name(int index) {
+  return std::string(kSubsystems[index % kSubsystems.size()]) +
+         kQuantities[(index / kSubsystems.size()) % kQuantities.size()] + "_" +
+         std::to_string(index);
+}
+
+std::string MessageName(int index) {
+  return std::string(kSubsystems[index % kSubsystems.size()]) + "Frame_" + std::to_string(index);
+}
+
+int MessageId(int index) {
+  return 0x100 + index;
+}
+
+std::string Node(int index) {
+  return kNodes[index % kNodes.size()];
+}
+
+// Comment texts vary from a few words to a short paragraph.
+std::string CommentText(int index) {
+  std::string text = "Reported by " + Node(index) + ".";
+  for (int i = 0; i < index % 6; ++i) {
+    text += " Value is filtered over a 10 ms window and clamped to the physical range.";
+  }
+  return text;
+}
+
+std::string SignalLine(int message_index, int signal_index, int signals_per_message) {
+  const int index = message_index * signals_per_message + signal_index;
+  const int width = 64 / (signals_per_message > 0 ? signals_per_message : 1);
+  const int length = width >= 16 ? 16 : (width > 0 ? width : 1);
+  const bool motorola = index % 4 == 3;
+  // Motorola start bits name the MSB, so shift to the top of the first byte.
+  const int start_bit = motorola ? (signal_index * width) / 8 * 8 + 7 : (signal_index * width) % 64;
+  return " SG_ " + Name(index) + " : " + std::to_string(start_bit) + "|" +
+         std::to_string(length) + (motorola ? "@0" : "@1") + (index % 3 == 0 ? "-" : "+") +
+         " (0." + std::to_string(1 + index % 9) + "," + std::to_string(-(index % 50)) + ") [" +
+         std::to_string(-(index % 50)) + "|" + std::to_string(1000 + index % 7000) + "] \"" +
+         kUnits[index % kUnits.size()] + "\" " + Node(index + 1) + "," + Node(index + 2);
+}
+
+std::string ValuePairs(int index, int pairs) {
+  static constexpr std::array<const char*, 6> kLabels = {"Off", "On", "Error", "Init", "Standby",
+                                                         "Not available"};
+  std::string text;
+  for (int v = 0; v < pairs; ++v) {
+    text += " " + std::to_string(v) + " \"" + kLabels[(index + v) % kLabels.size()] + "\"";
+  }
+  return text;
+}
+
+std::string MakeStatement(StatementKind kind, int i) {
+  switch (kind) {
+    case StatementKind::kVersion:
+      return "VERSION \"" + std::to_string(1 + i % 3) + "." + std::to_string(i % 10) + "\"";
+    case StatementKind::kNewSymbols:
+      return "NS_ : NS_DESC_ CM_ BA_DEF_ BA_ VAL_ CAT_DEF_ CAT_ FILTER BA_DEF_DEF_ EV_DATA_ "
+             "ENVVAR_DATA_ SGTYPE_ SGTYPE_VAL_ BA_DEF_SGTYPE_ BA_SGTYPE_ SIG_TYPE_REF_ "
+             "VAL_TABLE_ SIG_GROUP_ SIG_VALTYPE_ SIGTYPE_VALTYPE_ BO_TX_BU_ BA_DEF_REL_ "
+             "BA_REL_ BA_DEF_DEF_REL_ BU_SG_REL_ BU_EV_REL_ BU_BO_REL_ SG_MUL_VAL_";
+    case StatementKind::kBitTiming:
+      return "BS_: " + std::to_string(125 * (1 + i % 8)) + " " + std::to_string(i % 100) + ".5";
+    case StatementKind::kNodes: {
+      std::string text = "BU_:";
+      for (int n = 0; n < 4 + i % 12; ++n) {
+        text += " " + std::string(kSubsystems[n % kSubsystems.size()]) + "Ecu" + std::to_string(n);
+      }
+      return text;
+    }
+    case StatementKind::kMessage: {
+      const int signals = 4 + i % 13;
+      std::string text = "BO_ " + std::to_string(MessageId(i)) + " " + MessageName(i) + ": 8 " +
+                         Node(i) + "\n";
+      for (int s = 0; s < signals; ++s) {
+        text += SignalLine(i, s, signals) + "\n";
+      }
+      return text;
+    }
+    case StatementKind::kSignal:
+      // SignalParser takes the statement without its leading indentation.
+      return SignalLine(i / 8, i % 8, 8).substr(1);
+    case StatementKind::kMessageTransmitters:
+      return "BO_TX_BU_ " + std::to_string(MessageId(i)) + " : " + Node(i) + "," + Node(i + 1) + ";";
+    case StatementKind::kSignalGroup:
+      return "SIG_GROUP_ " + std::to_string(MessageId(i)) + " " + MessageName(i) + "Group 1 : " +
+             Name(i) + "," + Name(i + 1) + "," + Name(i + 2) + ";";
+    case StatementKind::kSignalTypeDef:
+      return "SIG_TYPE_DEF_ " + Name(i) + "Type: 16, 1, +, 0.1, 0, 0, 6553.5, \"" +
+             kUnits[i % kUnits.size()] + "\", 0, " + Name(i) + "Table;";
+    case StatementKind::kSignalValueType:
+      return "SIG_VALTYPE_ " + std::to_string(MessageId(i)) + " " + Name(i) + " " +
+             std::to_string(1 + i % 2) + ";";
+    case StatementKind::kComment:
+      switch (i % 4) {
+        case 0:
+          return "CM_ SG_ " + std::to_string(MessageId(i)) + " " + Name(i) + " \"" +
+                 CommentText(i) + "\";";
+        case 1:
+          return "CM_ BO_ " + std::to_string(MessageId(i)) + " \"" + CommentText(i) + "\";";
+        case 2:
+          return "CM_ BU_ " + Node(i) + " \"" + CommentText(i) + "\";";
+        default:
+          return "CM_ \"" + CommentText(i) + "\";";
+      }
+    case StatementKind::kAttributeDefinition:
+      switch (i % 4) {
+        case 0:
+          return "BA_DEF_ BO_ \"GenMsgCycleTime" + std::to_string(i) + "\" INT 0 65535;";
+        case 1:
+          return "BA_DEF_ SG_ \"GenSigStartValue" + std::to_string(i) + "\" FLOAT 0 100000;";
+        case 2:
+          return "BA_DEF_ BU_ \"NodeLayerModules" + std::to_string(i) + "\" STRING;";
+        default:
+          return "BA_DEF_ BO_ \"GenMsgSendType" + std::to_string(i) +
+                 "\" ENUM \"Cyclic\",\"Event\",\"CyclicIfActive\",\"NoMsgSendType\";";
+      }
+    case StatementKind::kAttributeDefinitionDefault:
+      return i % 2 == 0 ? "BA_DEF_DEF_ \"GenMsgCycleTime" + std::to_string(i) + "\" 100;"
+                        : "BA_DEF_DEF_ \"GenMsgSendType" + std::to_string(i) + "\" \"Cyclic\";";
+    case StatementKind::kAttributeValue:
+      switch (i % 3) {
+        case 0:
+          return "BA_ \"GenMsgCycleTime\" BO_ " + std::to_string(MessageId(i)) + " " +
+                 std::to_string(10 * (1 + i % 10)) + ";";
+        case 1:
+          // AttributeValueParser expects signal and node names quoted.
+          return "BA_ \"GenSigStartValue\" SG_ " + std::to_string(MessageId(i)) + " \"" + Name(i) +
+                 "\" " + std::to_string(i % 255) + ";";
+        default:
+          return "BA_ \"NodeLayerModules\" BU_ \"" + Node(i) + "\" \"CANoeILNVector.dll\";";
+      }
+    case StatementKind::kValueTable:
+      return "VAL_TABLE_ " + Name(i) + "Table" + ValuePairs(i, 2 + i % 6) + " ;";
+    case StatementKind::kValueDescription:
+      return "VAL_ " + std::to_string(MessageId(i)) + " " + Name(i) + ValuePairs(i, 2 + i % 6) + ";";
+    case StatementKind::kEnvironmentVariable:
+      return "EV_ " + Name(i) + " " + std::to_string(i % 2) + " [0 " + std::to_string(100 + i) +
+             "] \"" + kUnits[i % kUnits.size()] + "\" 0 " + std::to_string(2000 + i) +
+             " DUMMY_NODE_VECTOR0 " + Node(i) + ";";
+    case StatementKind::kEnvironmentVariableData:
+      return "ENVVAR_DATA_ " + Name(i) + ": " + std::to_string(1 + i % 8) + ";";
+  }
+  return {};
+}
+
+}  // namespace
+
+std::vector<std::string> MakeStatements(StatementKind kind, int count) {
+  std::vector<std::string> statements;
+  statements.reserve(static_cast<std::size_t>(count));
+  for (int i = 0; i < count; ++i) {
+    statements.push_back(MakeStatement(kind, i));
+  }
+  return statements;
+}
+
+DbcText MakeDbcText(int num_messages, int signals_per_message) {
+  DbcText result;
+  std::string& text = result.text;
+  auto add_line = [&](const std::string& line) {
+    text += line;
+    text += '\n';
+    ++result.statements;
+  };
+
+  add_line("VERSION \"1.0\"");
+  text += '\n';
+  add_line(MakeStatement(StatementKind::kNewSymbols, 0));
+  text += '\n';
+  add_line("BS_:");
+  text += '\n';
+  add_line("BU_: EngineControlUnit BrakeModule InstrumentCluster GatewayModule BodyController");
+  text += '\n';
+
+  for (int m = 0; m < num_messages; ++m) {
+    add_line("BO_ " + std::to_string(MessageId(m)) + " " + MessageName(m) + ": 8 " + Node(m));
+    for (int s = 0; s < signals_per_message; ++s) {
+      add_line(SignalLine(m, s, signals_per_message));
+    }
+    text += '\n';
+  }
+
+  // Satellite statements in rough production proportions: a transmitter list
+  // for a tenth of the messages, a comment and cycle time for every message,
+  // and value descriptions for a quarter of the signals.
+  for (int m = 0; m < num_messages; m += 10) {
+    add_line(MakeStatement(StatementKind::kMessageTransmitters, m));
+  }
+  for (int m = 0; m < num_messages; ++m) {
+    add_line("CM_ BO_ " + std::to_string(MessageId(m)) + " \"" + CommentText(m) + "\";");
+  }
+  for (int i = 0; i < 4; ++i) {
+    add_line(MakeStatement(StatementKind::kAttributeDefinition, i));
+  }
+  add_line("BA_DEF_DEF_ \"GenMsgCycleTime0\" 100;");
+  for (int m = 0; m < num_messages; ++m) {
+    add_line("BA_ \"GenMsgCycleTime0\" BO_ " + std::to_string(MessageId(m)) + " " +
+             std::to_string(10 * (1 + m % 10)) + ";");
+  }
+  for (int m = 0; m < num_messages; ++m) {
+    for (int s = 0; s < signals_per_message; s += 4) {
+      const int index = m * signals_per_message + s;
+      add_line("VAL_ " + std::to_string(MessageId(m)) + " " + Name(index) +
+               ValuePairs(index, 2 + index % 6) + ";");
+    }
+  }
+  return result;
+}
+
+}  // namespace bench
+}  // namespace dbc_parser
@@ -0,0 +1,72 @@
+#ifndef DBC_PARSER_BENCHMARKS_BENCHMARK_INPUTS_H_
+#define DBC_PARSER_BENCHMARKS_BENCHMARK_INPUTS_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace dbc_parser {
+namespace bench {
+
+/**
+ * @brief Statement kinds for which realistic benchmark inputs can be built.
+ */
+enum class StatementKind {
+  kVersion,
+  kNewSymbols,
+  kBitTiming,
+  kNodes,
+  kMessage,                 ///< BO_ header followed by its SG_ lines
+  kSignal,
+  kMessageTransmitters,
+  kSignalGroup,
+  kSignalTypeDef,
+  kSignalValueType,
+  kComment,
+  kAttributeDefinition,
+  kAttributeDefinitionDefault,
+  kAttributeValue,
+  kValueTable,
+  kValueDescription,
+  kEnvironmentVariable,
+  kEnvironmentVariableData,
+};
+
+/**
+ * @brief Builds count distinct statements of one kind.
+ *
+ * Names, IDs and lengths vary with the index in the way they do in vendor
+ * files, so that branch predictors and allocators see realistic variety. The
+ * output is deterministic.
+ *
+ * @param kind Statement kind
+ * @param count Number of statements
+ * @return std::vector<std::string> Statements without trailing newlines
+ */
+[[nodiscard]] std::vector<std::string> MakeStatements(StatementKind kind, int count);
+
+/**
+ * @brief A complete DBC file plus the number of statements it contains.
+ */
+struct DbcText {
+  std::string text;              ///< DBC file contents
+  std::size_t statements = 0;    ///< Number of non-empty lines (each SG_ counts)
+};
+
+/**
+ * @brief Builds a complete DBC file.
+ *
+ * Besides BO_/SG_ blocks the file contains the usual satellite statements:
+ * comments, attribute definitions and values, value descriptions and
+ * transmitter lists, in proportions typical for production databases.
+ *
+ * @param num_messages Number of BO_ blocks
+ * @param signals_per_message Number of SG_ lines per BO_ block
+ * @return DbcText The file text and its statement count
+ */
+[[nodiscard]] DbcText MakeDbcText(int num_messages, int signals_per_message);
+
+}  // namespace bench
+}  // namespace dbc_parser
+
+#endif  // DBC_PARSER_BENCHMARKS_BENCHMARK_INPUTS_H_
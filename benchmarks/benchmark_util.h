@@ -0,0 +1,77 @@
+#ifndef DBC_PARSER_BENCHMARKS_BENCHMARK_UTIL_H_
+#define DBC_PARSER_BENCHMARKS_BENCHMARK_UTIL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "benchmarks/allocation_counter.h"
+
+namespace dbc_parser {
+namespace bench {
+
+/**
+ * @brief Publishes the standard counters of a parser benchmark.
+ *
+ * bytes_per_second (MB/s in the console) and items_per_second
+ * (statements/s) come from Google Benchmark itself; allocation counters are
+ * averaged per statement. All counters appear in --benchmark_format=json.
+ *
+ * @param state Benchmark state
+ * @param bytes Total input bytes parsed
+ * @param statements Total statements parsed
+ * @param allocations Heap allocations made while parsing
+ */
+inline void ReportParseCounters(benchmark::State& state, std::int64_t bytes,
+                                std::int64_t statements, const AllocationStats& allocations) {
+  state.SetBytesProcessed(bytes);
+  state.SetItemsProcessed(statements);
+  const double per = statements > 0 ? 1.0 / static_cast<double>(statements) : 0.0;
+  state.counters["allocs_per_stmt"] = static_cast<double>(allocations.allocations) * per;
+  state.counters["alloc_bytes_per_stmt"] = static_cast<double>(allocations.bytes) * per;
+}
+
+/**
+ * @brief Runs a parse function over a set of statements once per iteration.
+ *
+ * Every statement must parse; a failure aborts the benchmark with an error
+ * so that a grammar regression cannot masquerade as a speedup.
+ *
+ * @param state Benchmark state
+ * @param statements Inputs, each passed to parse on its own
+ * @param parse Callable taking std::string_view and returning std::optional
+ */
+template <typename ParseFn>
+void RunStatementBenchmark(benchmark::State& state, const std::vector<std::string>& statements,
+                           ParseFn parse) {
+  std::int64_t bytes_per_pass = 0;
+  for (const auto& statement : statements) {
+    bytes_per_pass += static_cast<std::int64_t>(statement.size());
+    if (!parse(statement)) {
+      state.SkipWithError(("failed to parse: " + statement).c_str());
+      return;
+    }
+  }
+
+  AllocationStats total;
+  for (auto _ : state) {
+    AllocationScope scope;
+    for (const auto& statement : statements) {
+      auto result = parse(statement);
+      benchmark::DoNotOptimize(result);
+    }
+    const AllocationStats delta = scope.Delta();
+    total.allocations += delta.allocations;
+    total.bytes += delta.bytes;
+  }
+  const auto passes = static_cast<std::int64_t>(state.iterations());
+  ReportParseCounters(state, passes * bytes_per_pass,
+                      passes * static_cast<std::int64_t>(statements.size()), total);
+}
+
+}  // namespace bench
+}  // namespace dbc_parser
+
+#endif  // DBC_PARSER_BENCHMARKS_BENCHMARK_UTIL_H_
@@ -0,0 +1,187 @@
+// Decoded signal samples written to a column file (ColumnWriter) and to a
+// row-oriented CSV dump (time,signal,value per line), and one signal queried
+// back from each: ColumnReader::Scan against a full pass over the CSV lines.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "src/dbc_parser/parser/dbc_file_parser.h"
+#include "src/dbc_parser/storage/column_reader.h"
+#include "src/dbc_parser/storage/column_writer.h"
+
+namespace dbc_parser {
+namespace bench {
+namespace {
+
+using parser::DbcFile;
+using storage::ColumnReader;
+using storage::ColumnWriter;
+
+constexpr std::uint32_t kSignals = 16;
+constexpr int kFrames = 50000;
+
+struct Sample {
+  std::int64_t timestamp_ns;
+  std::uint32_t signal_id;
+  double value;
+};
+
+struct StoreInput {
+  DbcFile dbc_file;
+  std::vector<Sample> samples;
+  std::string columns;
+  std::string csv;
+};
+
+void AppendCsv(std::string& csv, const DbcFile& dbc_file, const Sample& sample) {
+  char line[128];
+  const int length = std::snprintf(line, sizeof(line), "%lld.%06lld,%s,%g\n",
+                                   static_cast<long long>(sample.timestamp_ns / 1000000000),
+                                   static_cast<long long>(sample.timestamp_ns % 1000000000 / 1000),
+                                   dbc_file.signal_infos[sample.signal_id].name.c_str(), sample.value);
+  csv.append(line, static_cast<std::size_t>(length));
+}
+
+// 16 signals of one 10 ms message with microseconds of jitter: counters,
+// enums and slowly moving scaled sensor values
+StoreInput MakeInput() {
+  StoreInput input;
+  input.dbc_file.signal_layouts.resize(kSignals);
+  input.dbc_file.signal_infos.resize(kSignals);
+  for (std::uint32_t i = 0; i < kSignals; ++i) {
+    input.dbc_file.signal_layouts[i].factor = i % 4 == 3 ? 0.01 : 1.0;
+    input.dbc_file.signal_infos[i].name = "Signal" + std::to_string(i);
+    input.dbc_file.signal_infos[i].message_id = 0x100;
+  }
+  std::mt19937 rng(46);
+  std::vector<std::int64_t> raw(kSignals, 1000);
+  for (int frame = 0; frame < kFrames; ++frame) {
+    const std::int64_t timestamp_ns = 1'600'000'000'000'000'000 + frame * std::int64_t{10'000'000} + rng() % 2000;
+    for (std::uint32_t i = 0; i < kSignals; ++i) {
+      switch (i % 4) {
+        case 0:
+          raw[i] = (raw[i] + 1) % 16;
+          break;
+        case 1:
+          raw[i] = rng() % 64 == 0 ? rng() % 4 : raw[i];
+          break;
+        default:
+          raw[i] += rng() % 4 == 0 ? static_cast<int>(rng() % 5) - 2 : 0;
+          break;
+      }
+      input.samples.push_back(
+          {timestamp_ns, i, static_cast<double>(raw[i]) * input.dbc_file.signal_layouts[i].factor});
+    }
+  }
+
+  std::ostringstream out;
+  ColumnWriter writer(out, input.dbc_file);
+  for (const Sample& sample : input.samples) {
+    writer.Add(sample.signal_id, sample.timestamp_ns, sample.value);
+  }
+  writer.Finish();
+  input.columns = out.str();
+  for (const Sample& sample : input.samples) {
+    AppendCsv(input.csv, input.dbc_file, sample);
+  }
+  return input;
+}
+
+const StoreInput& Input() {
+  static const StoreInput input = MakeInput();
+  return input;
+}
+
+// bytes is the size of the whole output; 0 for queries
+void SetCounters(benchmark::State& state, std::size_t samples, std::size_t bytes) {
+  state.counters["samples_per_second"] = benchmark::Counter(
+      static_cast<double>(state.iterations()) * static_cast<double>(samples), benchmark::Counter::kIsRate);
+  if (bytes > 0) {
+    state.counters["bytes_per_sample"] = static_cast<double>(bytes) / static_cast<double>(samples);
+  }
+}
+
+void BM_WriteColumns(benchmark::State& state) {
+  const StoreInput& input = Input();
+  for (auto _ : state) {
+    std::ostringstream out;
+    ColumnWriter writer(out, input.dbc_file);
+    for (const Sample& sample : input.samples) {
+      writer.Add(sample.signal_id, sample.timestamp_ns, sample.value);
+    }
+    benchmark::DoNotOptimize(writer.Finish());
+  }
+  SetCounters(state, input.samples.size(), input.columns.size());
+}
+BENCHMARK(BM_WriteColumns)->Unit(benchmark::kMillisecond);
+
+void BM_WriteCsv(benchmark::State& state) {
+  const StoreInput& input = Input();
+  for (auto _ : state) {
+    std::string csv;
+    for (const Sample& sample : input.samples) {
+      AppendCsv(csv, input.dbc_file, sample);
+    }
+    benchmark::DoNotOptimize(csv.data());
+  }
+  SetCounters(state, input.samples.size(), input.csv.size());
+}
+BENCHMARK(BM_WriteCsv)->Unit(benchmark::kMillisecond);
+
+void BM_ScanSignalColumns(benchmark::State& state) {
+  const StoreInput& input = Input();
+  const auto reader = ColumnReader::Open(input.columns);
+  std::size_t samples = 0;
+  for (auto _ : state) {
+    double sum = 0;
+    samples = reader
+                  ->Scan(3,
+                         [&sum](const std::int64_t*, const double* values, std::size_t count) {
+                           for (std::size_t i = 0; i < count; ++i) {
+                             sum += values[i];
+                           }
+                         })
+                  .value_or(0);
+    benchmark::DoNotOptimize(sum);
+  }
+  SetCounters(state, samples, 0);
+}
+BENCHMARK(BM_ScanSignalColumns)->Unit(benchmark::kMillisecond);
+
+void BM_ScanSignalCsv(benchmark::State& state) {
+  const StoreInput& input = Input();
+  const std::string_view csv = input.csv;
+  std::size_t samples = 0;
+  for (auto _ : state) {
+    double sum = 0;
+    samples = 0;
+    for (std::size_t begin = 0; begin < csv.size();) {
+      const std::size_t end = csv.find('\n', begin);
+      const std::string_view line = csv.substr(begin, end - begin);
+      const std::size_t name = line.find(',') + 1;
+      const std::size_t value = line.find(',', name);
+      if (line.substr(name, value - name) == "Signal3") {
+        sum += std::strtod(line.data() + value + 1, nullptr);
+        ++samples;
+      }
+      begin = end + 1;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  SetCounters(state, samples, 0);
+}
+BENCHMARK(BM_ScanSignalCsv)->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace bench
+}  // namespace dbc_parser
+
+BENCHMARK_MAIN();
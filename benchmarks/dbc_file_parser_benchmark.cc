@@ -0,0 +1,136 @@
+// End-to-end DbcFileParser::Parse throughput on small, medium and huge files,
+// and on generated files with the statement mix of production databases.
+
+#include <cstdint>
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "benchmarks/allocation_counter.h"
+#include "benchmarks/benchmark_inputs.h"
+#include "benchmarks/benchmark_util.h"
+#include "src/dbc_parser/parser/dbc_file_parser.h"
+#include "src/dbc_parser/parser/parse_stats.h"
+#include "tools/dbc_generator.h"
+
+namespace dbc_parser {
+namespace bench {
+namespace {
+
+using parser::DbcFileParser;
+using parser::ParseStats;
+using parser::StatementKind;
+
+std::uint64_t AllocationCount() noexcept {
+  return CurrentAllocations().allocations;
+}
+
+// Generated file with the vendor mix, scaled to the given number of messages.
+tools::GeneratedDbc GenerateScaled(int messages) {
+  tools::GeneratorConfig config = tools::DbcGenerator::VendorScaleConfig();
+  const double scale = static_cast<double>(messages) / config.num_messages;
+  config.num_messages = messages;
+  config.num_comments = static_cast<int>(config.num_comments * scale);
+  config.num_attribute_values = static_cast<int>(config.num_attribute_values * scale);
+  config.num_signal_groups = static_cast<int>(config.num_signal_groups * scale);
+  return tools::DbcGenerator::Generate(config);
+}
+
+// Parses text once per iteration after checking that it parses at all.
+void RunFileBenchmark(benchmark::State& state, const std::string& text, std::size_t statements) {
+  DbcFileParser dbc_parser;
+  if (!dbc_parser.Parse(text)) {
+    state.SkipWithError("generated DBC file failed to parse");
+    return;
+  }
+
+  AllocationStats total;
+  for (auto _ : state) {
+    AllocationScope scope;
+    auto dbc = dbc_parser.Parse(text);
+    const AllocationStats delta = scope.Delta();
+    benchmark::DoNotOptimize(dbc);
+    total.allocations += delta.allocations;
+    total.bytes += delta.bytes;
+    // The same every pass; live_bytes is what the returned DbcFile holds
+    total.live_bytes = delta.live_bytes;
+    total.peak_live_bytes = delta.peak_live_bytes;
+  }
+  const auto passes = static_cast<std::int64_t>(state.iterations());
+  ReportParseCounters(state, passes * static_cast<std::int64_t>(text.size()),
+                      passes * static_cast<std::int64_t>(statements), total);
+  state.counters["file_bytes"] = static_cast<double>(text.size());
+  state.counters["retained_bytes"] = static_cast<double>(total.live_bytes);
+  state.counters["peak_bytes"] = static_cast<double>(total.peak_live_bytes);
+}
+
+void BM_DbcFileParser(benchmark::State& state) {
+  const DbcText input = MakeDbcText(static_cast<int>(state.range(0)), static_cast<int>(state.range(1)));
+  RunFileBenchmark(state, input.text, input.statements);
+}
+
+// Argument: number of messages. The rest of the mix (comments, attributes,
+// multiplexing, extended IDs, CAN FD) follows the vendor preset, scaled with
+// the message count.
+void BM_DbcFileParserGenerated(benchmark::State& state) {
+  const tools::GeneratedDbc input = GenerateScaled(static_cast<int>(state.range(0)));
+  RunFileBenchmark(state, input.text, input.counts.Total());
+  state.counters["signals"] = static_cast<double>(input.counts.signals);
+}
+
+// Same input as generated_medium with a ParseStats attached, to measure the
+// cost of profiling. The per-statement share of parse time is reported for the
+// statement types that dominate vendor files.
+void BM_DbcFileParserProfiled(benchmark::State& state) {
+  const tools::GeneratedDbc input = GenerateScaled(static_cast<int>(state.range(0)));
+  DbcFileParser dbc_parser;
+  ParseStats stats;
+  stats.allocation_counter = &AllocationCount;
+  for (auto _ : state) {
+    auto dbc = dbc_parser.Parse(input.text, &stats);
+    benchmark::DoNotOptimize(dbc);
+  }
+  const double total = static_cast<double>(stats.total_nanoseconds);
+  for (StatementKind kind : {StatementKind::kMessage, StatementKind::kComment, StatementKind::kAttributeValue}) {
+    const std::string keyword(ParseStats::KeywordOf(kind));
+    state.counters["time_share_" + keyword] = total > 0 ? stats[kind].nanoseconds / total : 0.0;
+  }
+  state.counters["unknown_lines"] = static_cast<double>(stats.UnknownLines());
+  state.SetBytesProcessed(static_cast<std::int64_t>(stats.input_bytes));
+}
+
+// Arguments: number of messages, signals per message.
+BENCHMARK(BM_DbcFileParser)
+    ->Name("BM_DbcFileParser/small")
+    ->Args({20, 8})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DbcFileParser)
+    ->Name("BM_DbcFileParser/medium")
+    ->Args({500, 16})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DbcFileParser)
+    ->Name("BM_DbcFileParser/huge")
+    ->Args({10000, 25})
+    ->Unit(benchmark::kMillisecond)
+    ->Iterations(3);
+
+// Argument: number of messages; 10000 is the full vendor preset (~50 MB,
+// 250k signals, 50k CM_, 100k BA_).
+BENCHMARK(BM_DbcFileParserGenerated)
+    ->Name("BM_DbcFileParser/generated_medium")
+    ->Arg(500)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DbcFileParserGenerated)
+    ->Name("BM_DbcFileParser/generated_vendor")
+    ->Arg(10000)
+    ->Unit(benchmark::kMillisecond)
+    ->Iterations(3);
+BENCHMARK(BM_DbcFileParserProfiled)
+    ->Name("BM_DbcFileParser/generated_medium_profiled")
+    ->Arg(500)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace bench
+}  // namespace dbc_parser
+
+BENCHMARK_MAIN();
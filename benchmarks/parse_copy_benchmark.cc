@@ -0,0 +1,186 @@
+// Measures heap traffic per parsed signal on the way from the sub-parsers into
+// the DbcFile model. The *Copy variants reproduce the old copy-based assembly
+// of a message so the saving of the move-based path can be read off directly.
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "benchmarks/allocation_counter.h"
+#include "src/dbc_parser/common/common_types.h"
+#include "src/dbc_parser/parser/dbc_file_parser.h"
+#include "src/dbc_parser/parser/message/message_parser.h"
+
+namespace dbc_parser {
+namespace bench {
+namespace {
+
+using parser::DbcFile;
+using parser::DbcFileParser;
+using parser::Message;
+using parser::MessageParser;
+using parser::Signal;
+using parser::SignalInfo;
+using parser::SignalLayout;
+using parser::TypeConverter;
+
+std::string MakeMessageText(int message_index, int num_signals) {
+  std::string text = "BO_ " + std::to_string(100 + message_index) + " EngineData" +
+                     std::to_string(message_index) + ": 8 EngineControlUnit\n";
+  for (int s = 0; s < num_signals; ++s) {
+    text += " SG_ EngineSignal_" + std::to_string(s) + " : " + std::to_string((s * 8) % 64) +
+            "|8@1+ (0.25,-40) [-40|215] \"degC\" InstrumentCluster,GatewayModule\n";
+  }
+  return text;
+}
+
+std::string MakeDbcText(int num_messages, int signals_per_message) {
+  std::string text = "VERSION \"1.0\"\n\nBU_: EngineControlUnit InstrumentCluster GatewayModule\n\n";
+  for (int m = 0; m < num_messages; ++m) {
+    text += MakeMessageText(m, signals_per_message);
+    text += "\n";
+  }
+  return text;
+}
+
+// Publishes allocation totals as per-signal averages.
+void ReportPerSignal(benchmark::State& state, const AllocationStats& total,
+                     std::int64_t signals) {
+  const double per = signals > 0 ? 1.0 / static_cast<double>(signals) : 0.0;
+  state.counters["allocs_per_signal"] = static_cast<double>(total.allocations) * per;
+  state.counters["bytes_per_signal"] = static_cast<double>(total.bytes) * per;
+  state.counters["signals"] = benchmark::Counter(static_cast<double>(signals),
+                                                 benchmark::Counter::kIsRate);
+}
+
+void BM_MessageParserParse(benchmark::State& state) {
+  const int num_signals = static_cast<int>(state.range(0));
+  const std::string text = MakeMessageText(0, num_signals);
+  AllocationStats total;
+  std::int64_t signals = 0;
+  for (auto _ : state) {
+    AllocationScope scope;
+    auto message = MessageParser::Parse(text);
+    AllocationStats delta = scope.Delta();
+    benchmark::DoNotOptimize(message);
+    total.allocations += delta.allocations;
+    total.bytes += delta.bytes;
+    signals += num_signals;
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) *
+                          static_cast<std::int64_t>(text.size()));
+  ReportPerSignal(state, total, signals);
+}
+BENCHMARK(BM_MessageParserParse)->Arg(4)->Arg(16)->Arg(64);
+
+// Output of assembling one message: the message definition plus the flat
+// signal tables it indexes into.
+struct AssembledModel {
+  std::map<int, DbcFile::MessageDef> messages;
+  std::vector<SignalLayout> layouts;
+  std::vector<SignalInfo> infos;
+};
+
+// Assembles a message by copying every string out of the parse result, which
+// is what DbcFileParser did before results were moved.
+void AssembleByCopy(const Message& message, AssembledModel& out) {
+  DbcFile::MessageDef msg_def;
+  msg_def.id = message.id;
+  msg_def.name = message.name;
+  msg_def.size = message.dlc;
+  msg_def.transmitter = message.sender;
+  msg_def.first_signal = static_cast<std::uint32_t>(out.layouts.size());
+  msg_def.signal_count = static_cast<std::uint32_t>(message.signals.size());
+  for (const Signal& signal : message.signals) {
+    out.layouts.push_back(TypeConverter::ToSignalLayout(signal));
+    out.infos.push_back(TypeConverter::ToSignalInfo(Signal(signal), message.id));
+  }
+  out.messages[message.id] = msg_def;
+}
+
+// Assembles a message the way DbcFileParser does now: every field is moved
+// out of the parse result exactly once.
+void AssembleByMove(Message&& message, AssembledModel& out) {
+  DbcFile::MessageDef msg_def;
+  msg_def.id = message.id;
+  msg_def.name = std::move(message.name);
+  msg_def.size = message.dlc;
+  msg_def.transmitter = std::move(message.sender);
+  msg_def.first_signal = static_cast<std::uint32_t>(out.layouts.size());
+  msg_def.signal_count = static_cast<std::uint32_t>(message.signals.size());
+  for (Signal& signal : message.signals) {
+    out.layouts.push_back(TypeConverter::ToSignalLayout(signal));
+    out.infos.push_back(TypeConverter::ToSignalInfo(std::move(signal), message.id));
+  }
+  out.messages.insert_or_assign(msg_def.id, std::move(msg_def));
+}
+
+template <bool kMove>
+void BM_AssembleMessageDef(benchmark::State& state) {
+  const int num_signals = static_cast<int>(state.range(0));
+  const std::string text = MakeMessageText(0, num_signals);
+  const Message prototype = *MessageParser::Parse(text);
+  AllocationStats total;
+  std::int64_t signals = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    Message message = prototype;
+    AssembledModel model;
+    model.layouts.reserve(prototype.signals.size());
+    model.infos.reserve(prototype.signals.size());
+    state.ResumeTiming();
+
+    AllocationScope scope;
+    if constexpr (kMove) {
+      AssembleByMove(std::move(message), model);
+    } else {
+      AssembleByCopy(message, model);
+    }
+    AllocationStats delta = scope.Delta();
+    benchmark::DoNotOptimize(model);
+    total.allocations += delta.allocations;
+    total.bytes += delta.bytes;
+    signals += num_signals;
+
+    state.PauseTiming();
+    model = AssembledModel();
+    state.ResumeTiming();
+  }
+  ReportPerSignal(state, total, signals);
+}
+BENCHMARK_TEMPLATE(BM_AssembleMessageDef, false)->Name("BM_AssembleMessageDefCopy")->Arg(16)->Arg(64);
+BENCHMARK_TEMPLATE(BM_AssembleMessageDef, true)->Name("BM_AssembleMessageDefMove")->Arg(16)->Arg(64);
+
+void BM_DbcFileParserParse(benchmark::State& state) {
+  const int num_messages = static_cast<int>(state.range(0));
+  constexpr int kSignalsPerMessage = 8;
+  const std::string text = MakeDbcText(num_messages, kSignalsPerMessage);
+  DbcFileParser dbc_parser;
+  AllocationStats total;
+  std::int64_t signals = 0;
+  for (auto _ : state) {
+    AllocationScope scope;
+    auto dbc = dbc_parser.Parse(text);
+    AllocationStats delta = scope.Delta();
+    benchmark::DoNotOptimize(dbc);
+    total.allocations += delta.allocations;
+    total.bytes += delta.bytes;
+    signals += static_cast<std::int64_t>(num_messages) * kSignalsPerMessage;
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) *
+                          static_cast<std::int64_t>(text.size()));
+  ReportPerSignal(state, total, signals);
+  // Resident size of one signal on the decode path versus the full parse record
+  state.counters["hot_bytes_per_signal"] = static_cast<double>(sizeof(SignalLayout));
+  state.counters["parsed_bytes_per_signal"] = static_cast<double>(sizeof(Signal));
+}
+BENCHMARK(BM_DbcFileParserParse)->Arg(10)->Arg(100);
+
+}  // namespace
+}  // namespace bench
+}  // namespace dbc_parser
+
+BENCHMARK_MAIN();
@@ -0,0 +1,207 @@
+// Alert rules over decoded signals: the cost of one compiled rule by shape,
+// and RuleEngine::OnFrame with thousands of rules indexed by CAN ID against
+// evaluating every rule on every frame.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "src/dbc_parser/decoder/can_frame.h"
+#include "src/dbc_parser/decoder/frame_decoder.h"
+#include "src/dbc_parser/parser/dbc_file_parser.h"
+#include "src/dbc_parser/rules/rule_compiler.h"
+#include "src/dbc_parser/rules/rule_engine.h"
+
+namespace dbc_parser {
+namespace bench {
+namespace {
+
+using decoder::CanFrame;
+using decoder::FrameDecoder;
+using parser::DbcFile;
+using parser::Signal;
+using parser::TypeConverter;
+using rules::CompiledRule;
+using rules::RuleCompiler;
+using rules::RuleEngine;
+
+constexpr int kMessages = 200;
+constexpr int kSignals = 8;
+constexpr int kFrames = 100000;
+
+std::string SignalName(int message, int signal) {
+  return "M" + std::to_string(message) + "_S" + std::to_string(signal);
+}
+
+// kMessages messages of kSignals byte signals; the last signal of each is a
+// gear-like enum with VAL_ 0 "P" 1 "R" 2 "N" 3 "D"
+DbcFile MakeFile() {
+  DbcFile dbc_file;
+  for (int m = 0; m < kMessages; ++m) {
+    const int id = 0x100 + m;
+    DbcFile::MessageDef& message = dbc_file.messages_detailed[id];
+    message.id = id;
+    message.name = "Message" + std::to_string(m);
+    message.size = 8;
+    message.first_signal = static_cast<std::uint32_t>(dbc_file.signal_layouts.size());
+    message.signal_count = kSignals;
+    for (int s = 0; s < kSignals; ++s) {
+      Signal signal;
+      signal.name = SignalName(m, s);
+      signal.start_bit = 8 * s;
+      signal.length = s == kSignals - 1 ? 2 : 8;
+      signal.factor = s % 2 == 0 ? 1.0 : 0.5;
+      dbc_file.signal_layouts.push_back(TypeConverter::ToSignalLayout(signal));
+      dbc_file.signal_infos.push_back(TypeConverter::ToSignalInfo(std::move(signal), id));
+    }
+    DbcFile::ValueDescription gear;
+    gear.message_id = id;
+    gear.signal_name = SignalName(m, kSignals - 1);
+    gear.values = {{0, "P"}, {1, "R"}, {2, "N"}, {3, "D"}};
+    dbc_file.value_descriptions.push_back(std::move(gear));
+  }
+  return dbc_file;
+}
+
+// Rule i reads two messages, like "M12_S3 > 200 && M57_S7 == 'R'"
+std::vector<std::string> MakeRules(int count) {
+  std::mt19937 rng(50);
+  std::vector<std::string> rules;
+  for (int i = 0; i < count; ++i) {
+    const int a = static_cast<int>(rng() % kMessages);
+    const int b = static_cast<int>(rng() % kMessages);
+    rules.push_back(SignalName(a, static_cast<int>(rng() % (kSignals - 1))) + " > " + std::to_string(rng() % 256) +
+                    " && " + SignalName(b, kSignals - 1) + " == '" + "PRND"[rng() % 4] + "'");
+  }
+  return rules;
+}
+
+// Frames of random messages with random payloads
+std::vector<CanFrame> MakeFrames() {
+  std::mt19937 rng(51);
+  std::vector<CanFrame> frames(kFrames);
+  for (int i = 0; i < kFrames; ++i) {
+    CanFrame& frame = frames[i];
+    frame.timestamp_ns = i * std::int64_t{100'000};
+    frame.id = 0x100 + static_cast<std::uint32_t>(rng() % kMessages);
+    frame.size = 8;
+    for (int byte = 0; byte < 8; ++byte) {
+      frame.data[byte] = static_cast<std::uint8_t>(rng());
+    }
+  }
+  return frames;
+}
+
+// Argument: rule shape
+void BM_EvaluateRule(benchmark::State& state) {
+  static const char* const kShapes[] = {
+      "M1_S0 > 100",
+      "M1_S0 > 100 && M2_S7 == 'R'",
+      "(M1_S0 + M1_S2) / 2 > 100 || !(M1_S1 < 20) && M2_S7 != 'D'",
+      "M1_S0 * 0.5 - M1_S1 > 10 && M1_S2 >= 5 && M1_S3 <= 120 && M1_S4 != 7 && M2_S7 == 'N' || M2_S0 == 255",
+  };
+  const DbcFile dbc_file = MakeFile();
+  const auto rule = RuleCompiler(dbc_file).Compile(kShapes[state.range(0)]);
+  if (!rule) {
+    state.SkipWithError("rule did not compile");
+    return;
+  }
+  // Random values, so the rule's branches are not predictable
+  std::mt19937 rng(52);
+  constexpr std::size_t kValueSets = 1024;
+  std::vector<std::vector<double>> value_sets(kValueSets, std::vector<double>(dbc_file.signal_layouts.size()));
+  for (std::vector<double>& values : value_sets) {
+    for (double& value : values) {
+      value = static_cast<double>(rng() % 256);
+    }
+    for (int m = 0; m < kMessages; ++m) {
+      values[static_cast<std::size_t>(m * kSignals + kSignals - 1)] = static_cast<double>(rng() % 4);
+    }
+  }
+  std::vector<double> stack(rule->max_stack);
+
+  std::size_t held = 0;
+  std::size_t set = 0;
+  for (auto _ : state) {
+    held += rule->Evaluate(value_sets[set].data(), stack.data()) ? 1 : 0;
+    set = (set + 1) % kValueSets;
+  }
+  benchmark::DoNotOptimize(held);
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+  state.counters["instructions"] = static_cast<double>(rule->code.size());
+}
+
+// Argument: number of rules
+void BM_RuleEngineOnFrame(benchmark::State& state) {
+  const DbcFile dbc_file = MakeFile();
+  const FrameDecoder decoder(dbc_file);
+  const std::vector<CanFrame> frames = MakeFrames();
+  RuleEngine engine(decoder, dbc_file, nullptr);
+  for (const std::string& text : MakeRules(static_cast<int>(state.range(0)))) {
+    if (!engine.AddRule(text)) {
+      state.SkipWithError("rule did not compile");
+      return;
+    }
+  }
+
+  for (auto _ : state) {
+    for (const CanFrame& frame : frames) {
+      engine.OnFrame(frame);
+    }
+  }
+  const double frames_seen = static_cast<double>(kFrames) * static_cast<double>(state.iterations());
+  state.SetItemsProcessed(static_cast<std::int64_t>(frames_seen));
+  // Fan-out: rules a frame evaluates on average
+  state.counters["rules_per_frame"] = static_cast<double>(engine.evaluated()) / frames_seen;
+  state.counters["triggers_per_frame"] = static_cast<double>(engine.triggered()) / frames_seen;
+}
+
+// Without the index: every frame is decoded and evaluates every rule
+void BM_EvaluateEveryRule(benchmark::State& state) {
+  const DbcFile dbc_file = MakeFile();
+  const FrameDecoder decoder(dbc_file);
+  const std::vector<CanFrame> frames = MakeFrames();
+  const RuleCompiler compiler(dbc_file);
+  std::vector<CompiledRule> compiled;
+  std::size_t max_stack = 1;
+  for (const std::string& text : MakeRules(static_cast<int>(state.range(0)))) {
+    compiled.push_back(*compiler.Compile(text));
+    max_stack = std::max(max_stack, compiled.back().max_stack);
+  }
+  std::vector<double> values(dbc_file.signal_layouts.size(), 0.0);
+  std::vector<double> decoded(decoder.MaxSignalCount());
+  std::vector<double> stack(max_stack);
+
+  std::size_t held = 0;
+  for (auto _ : state) {
+    for (const CanFrame& frame : frames) {
+      const FrameDecoder::MessageEntry* message = decoder.Find(frame.dbc_id());
+      if (message == nullptr || !decoder.Decode(frame, decoded.data())) {
+        continue;
+      }
+      std::copy(decoded.begin(), decoded.begin() + message->signal_count,
+                values.begin() + message->message->first_signal);
+      for (const CompiledRule& rule : compiled) {
+        held += rule.Evaluate(values.data(), stack.data()) ? 1 : 0;
+      }
+    }
+  }
+  benchmark::DoNotOptimize(held);
+  state.SetItemsProcessed(static_cast<std::int64_t>(kFrames) * static_cast<std::int64_t>(state.iterations()));
+  state.counters["rules_per_frame"] = static_cast<double>(compiled.size());
+}
+
+BENCHMARK(BM_EvaluateRule)->DenseRange(0, 3);
+BENCHMARK(BM_RuleEngineOnFrame)->Arg(100)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_EvaluateEveryRule)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace bench
+}  // namespace dbc_parser
+
+BENCHMARK_MAIN();
@@ -0,0 +1,73 @@
+// Throughput of each section parser on realistic statements. Every benchmark
+// parses the same 256 distinct statements per iteration.
+
+#include <string_view>
+
+#include "benchmark/benchmark.h"
+#include "benchmarks/benchmark_inputs.h"
+#include "benchmarks/benchmark_util.h"
+#include "src/dbc_parser/parser/attribute/attribute_definition_default_parser.h"
+#include "src/dbc_parser/parser/attribute/attribute_definition_parser.h"
+#include "src/dbc_parser/parser/attribute/attribute_value_parser.h"
+#include "src/dbc_parser/parser/base/bit_timing_parser.h"
+#include "src/dbc_parser/parser/base/new_symbols_parser.h"
+#include "src/dbc_parser/parser/base/nodes_parser.h"
+#include "src/dbc_parser/parser/base/version_parser.h"
+#include "src/dbc_parser/parser/comment/comment_parser.h"
+#include "src/dbc_parser/parser/environment/environment_variable_data_parser.h"
+#include "src/dbc_parser/parser/environment/environment_variable_parser.h"
+#include "src/dbc_parser/parser/message/message_parser.h"
+#include "src/dbc_parser/parser/message/message_transmitters_parser.h"
+#include "src/dbc_parser/parser/message/signal_group_parser.h"
+#include "src/dbc_parser/parser/message/signal_parser.h"
+#include "src/dbc_parser/parser/message/signal_type_def_parser.h"
+#include "src/dbc_parser/parser/message/signal_value_type_parser.h"
+#include "src/dbc_parser/parser/value/value_description_parser.h"
+#include "src/dbc_parser/parser/value/value_table_parser.h"
+
+namespace dbc_parser {
+namespace bench {
+namespace {
+
+constexpr int kStatementsPerPass = 256;
+
+template <typename Parser>
+void RunSectionParser(benchmark::State& state, StatementKind kind) {
+  const auto statements = MakeStatements(kind, kStatementsPerPass);
+  RunStatementBenchmark(state, statements,
+                        [](std::string_view input) { return Parser::Parse(input); });
+}
+
+// Defines and registers BM_<Parser> for one section parser.
+#define DBC_SECTION_PARSER_BENCHMARK(Parser, kind)    \
+  void BM_##Parser(benchmark::State& state) {         \
+    RunSectionParser<parser::Parser>(state, kind);    \
+  }                                                   \
+  BENCHMARK(BM_##Parser)
+
+DBC_SECTION_PARSER_BENCHMARK(VersionParser, StatementKind::kVersion);
+DBC_SECTION_PARSER_BENCHMARK(NewSymbolsParser, StatementKind::kNewSymbols);
+DBC_SECTION_PARSER_BENCHMARK(BitTimingParser, StatementKind::kBitTiming);
+DBC_SECTION_PARSER_BENCHMARK(NodesParser, StatementKind::kNodes);
+DBC_SECTION_PARSER_BENCHMARK(MessageParser, StatementKind::kMessage);
+DBC_SECTION_PARSER_BENCHMARK(SignalParser, StatementKind::kSignal);
+DBC_SECTION_PARSER_BENCHMARK(MessageTransmittersParser, StatementKind::kMessageTransmitters);
+DBC_SECTION_PARSER_BENCHMARK(SignalGroupParser, StatementKind::kSignalGroup);
+DBC_SECTION_PARSER_BENCHMARK(SignalTypeDefParser, StatementKind::kSignalTypeDef);
+DBC_SECTION_PARSER_BENCHMARK(SignalValueTypeParser, StatementKind::kSignalValueType);
+DBC_SECTION_PARSER_BENCHMARK(CommentParser, StatementKind::kComment);
+DBC_SECTION_PARSER_BENCHMARK(AttributeDefinitionParser, StatementKind::kAttributeDefinition);
+DBC_SECTION_PARSER_BENCHMARK(AttributeDefinitionDefaultParser, StatementKind::kAttributeDefinitionDefault);
+DBC_SECTION_PARSER_BENCHMARK(AttributeValueParser, StatementKind::kAttributeValue);
+DBC_SECTION_PARSER_BENCHMARK(ValueTableParser, StatementKind::kValueTable);
+DBC_SECTION_PARSER_BENCHMARK(ValueDescriptionParser, StatementKind::kValueDescription);
+DBC_SECTION_PARSER_BENCHMARK(EnvironmentVariableParser, StatementKind::kEnvironmentVariable);
+DBC_SECTION_PARSER_BENCHMARK(EnvironmentVariableDataParser, StatementKind::kEnvironmentVariableData);
+
+#undef DBC_SECTION_PARSER_BENCHMARK
+
+}  // namespace
+}  // namespace bench
+}  // namespace dbc_parser
+
+BENCHMARK_MAIN();
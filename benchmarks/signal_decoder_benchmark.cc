@@ -0,0 +1,179 @@
+// Decoding whole messages of classic CAN (8 bytes) and CAN FD (64 bytes)
+// payloads: SignalDecoder::DecodeMessage with precomputed ExtractionPlans,
+// with plans computed per call, and a byte-at-a-time extraction loop.
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "src/dbc_parser/common/common_types.h"
+#include "src/dbc_parser/decoder/extraction_plan.h"
+#include "src/dbc_parser/decoder/signal_decoder.h"
+#include "src/dbc_parser/decoder/signal_encoder.h"
+
+namespace dbc_parser {
+namespace bench {
+namespace {
+
+using decoder::ExtractionPlan;
+using decoder::SignalDecoder;
+using decoder::SignalEncoder;
+using parser::SignalLayout;
+
+constexpr int kPayloads = 1024;
+
+// Signals of 4 to 20 bits packed back to back, alternating byte order, and
+// payloads with random content
+struct MessageInput {
+  std::vector<SignalLayout> layouts;
+  std::vector<ExtractionPlan> plans;
+  std::vector<std::uint8_t> payloads;
+  std::size_t size = 0;
+};
+
+MessageInput MakeInput(std::size_t size) {
+  MessageInput input;
+  input.size = size;
+  std::mt19937 rng(44);
+  for (unsigned bit = 0;;) {
+    SignalLayout layout;
+    layout.length = static_cast<std::uint8_t>(4 + rng() % 17);
+    if (bit + layout.length > size * 8) {
+      break;
+    }
+    if (input.layouts.size() % 2 == 0) {
+      layout.flags = SignalLayout::kLittleEndian;
+      layout.start_bit = static_cast<std::uint16_t>(bit);
+    } else {
+      // Motorola start bit of the signal's most significant bit
+      layout.start_bit = static_cast<std::uint16_t>(bit / 8 * 8 + 7 - bit % 8);
+    }
+    layout.factor = 0.25;
+    input.layouts.push_back(layout);
+    input.plans.push_back(ExtractionPlan::For(layout));
+    bit += layout.length;
+  }
+  input.payloads.resize(size * kPayloads);
+  for (std::uint8_t& byte : input.payloads) {
+    byte = static_cast<std::uint8_t>(rng());
+  }
+  return input;
+}
+
+const MessageInput& Input(std::size_t size) {
+  static const MessageInput classic = MakeInput(8);
+  static const MessageInput fd = MakeInput(64);
+  return size == 8 ? classic : fd;
+}
+
+// The classic approach: walk the signal a byte at a time
+double ByteLoopDecode(const SignalLayout& layout, const std::uint8_t* data, std::size_t size) {
+  std::uint64_t raw = 0;
+  unsigned remaining = layout.length;
+  if (layout.is_little_endian()) {
+    unsigned bit = layout.start_bit;
+    unsigned written = 0;
+    while (written < remaining) {
+      if (bit / 8 >= size) {
+        return std::numeric_limits<double>::quiet_NaN();
+      }
+      const unsigned shift = bit % 8;
+      const unsigned take = std::min(8 - shift, remaining - written);
+      raw |= static_cast<std::uint64_t>((data[bit / 8] >> shift) & ((1u << take) - 1)) << written;
+      written += take;
+      bit += take;
+    }
+  } else {
+    std::size_t byte = layout.start_bit / 8;
+    unsigned msb = layout.start_bit % 8;
+    while (remaining > 0) {
+      if (byte >= size) {
+        return std::numeric_limits<double>::quiet_NaN();
+      }
+      const unsigned take = std::min(msb + 1, remaining);
+      raw = (raw << take) | ((data[byte] >> (msb + 1 - take)) & ((1u << take) - 1));
+      remaining -= take;
+      ++byte;
+      msb = 7;
+    }
+  }
+  return static_cast<double>(raw) * layout.factor + layout.offset;
+}
+
+void SetCounters(benchmark::State& state, const MessageInput& input) {
+  state.counters["signals"] = static_cast<double>(input.layouts.size());
+  state.counters["frames_per_second"] =
+      benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * input.size));
+}
+
+void BM_DecodeMessagePlanned(benchmark::State& state) {
+  const MessageInput& input = Input(static_cast<std::size_t>(state.range(0)));
+  std::vector<double> values(input.layouts.size());
+  std::size_t frame = 0;
+  for (auto _ : state) {
+    const std::uint8_t* data = input.payloads.data() + frame * input.size;
+    benchmark::DoNotOptimize(SignalDecoder::DecodeMessage(input.layouts.data(), input.plans.data(),
+                                                          input.layouts.size(), data, input.size, values.data()));
+    benchmark::ClobberMemory();
+    frame = (frame + 1) % kPayloads;
+  }
+  SetCounters(state, input);
+}
+BENCHMARK(BM_DecodeMessagePlanned)->Arg(8)->Arg(64);
+
+void BM_DecodeMessageUnplanned(benchmark::State& state) {
+  const MessageInput& input = Input(static_cast<std::size_t>(state.range(0)));
+  std::vector<double> values(input.layouts.size());
+  std::size_t frame = 0;
+  for (auto _ : state) {
+    const std::uint8_t* data = input.payloads.data() + frame * input.size;
+    benchmark::DoNotOptimize(
+        SignalDecoder::DecodeMessage(input.layouts.data(), input.layouts.size(), data, input.size, values.data()));
+    benchmark::ClobberMemory();
+    frame = (frame + 1) % kPayloads;
+  }
+  SetCounters(state, input);
+}
+BENCHMARK(BM_DecodeMessageUnplanned)->Arg(8)->Arg(64);
+
+void BM_DecodeMessageByteLoop(benchmark::State& state) {
+  const MessageInput& input = Input(static_cast<std::size_t>(state.range(0)));
+  std::vector<double> values(input.layouts.size());
+  std::size_t frame = 0;
+  for (auto _ : state) {
+    const std::uint8_t* data = input.payloads.data() + frame * input.size;
+    for (std::size_t i = 0; i < input.layouts.size(); ++i) {
+      values[i] = ByteLoopDecode(input.layouts[i], data, input.size);
+    }
+    benchmark::ClobberMemory();
+    frame = (frame + 1) % kPayloads;
+  }
+  SetCounters(state, input);
+}
+BENCHMARK(BM_DecodeMessageByteLoop)->Arg(8)->Arg(64);
+
+void BM_EncodeMessagePlanned(benchmark::State& state) {
+  const MessageInput& input = Input(static_cast<std::size_t>(state.range(0)));
+  std::vector<double> values(input.layouts.size());
+  SignalDecoder::DecodeMessage(input.layouts.data(), input.layouts.size(), input.payloads.data(), input.size,
+                               values.data());
+  std::vector<std::uint8_t> payload(input.size);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(SignalEncoder::EncodeMessage(input.layouts.data(), input.plans.data(),
+                                                          input.layouts.size(), values.data(), payload.data(),
+                                                          payload.size()));
+    benchmark::ClobberMemory();
+  }
+  SetCounters(state, input);
+}
+BENCHMARK(BM_EncodeMessagePlanned)->Arg(8)->Arg(64);
+
+}  // namespace
+}  // namespace bench
+}  // namespace dbc_parser
+
+BENCHMARK_MAIN();
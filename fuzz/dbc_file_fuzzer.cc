@@ -0,0 +1,17 @@
+// Fuzz target for DbcFileParser::Parse with the default ParseLimits.
+
+#include <string_view>
+
+#include "fuzz/fuzz_harness.h"
+#include "src/dbc_parser/parser/dbc_file_parser.h"
+
+namespace {
+
+void ParseDbcFile(std::string_view input) {
+  dbc_parser::parser::DbcFileParser dbc_parser;
+  static_cast<void>(dbc_parser.Parse(input));
+}
+
+}  // namespace
+
+DBC_FUZZ_TARGET(ParseDbcFile)
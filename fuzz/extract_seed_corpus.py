@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+"""Rebuilds fuzz/corpus/ from the input strings of the parser unit tests.
+
+Every string literal assigned to `input` or `kInput` in a parser test becomes
+one seed file for the fuzz target of that parser. Run from the repository
+root after adding test cases:
+
+    python3 fuzz/extract_seed_corpus.py
+"""
+
+import hashlib
+import pathlib
+import re
+import shutil
+
+TEST_ROOT = pathlib.Path("tests/dbc_parser/parser")
+CORPUS_ROOT = pathlib.Path("fuzz/corpus")
+
+# Test file (relative to TEST_ROOT) -> fuzz target
+TARGETS = {
+    "attribute/attribute_definition_default_parser_test.cc": "attribute_definition_default",
+    "attribute/attribute_definition_parser_test.cc": "attribute_definition",
+    "attribute/attribute_value_parser_test.cc": "attribute_value",
+    "base/bit_timing_parser_test.cc": "bit_timing",
+    "base/new_symbols_parser_test.cc": "new_symbols",
+    "base/nodes_parser_test.cc": "nodes",
+    "base/version_parser_test.cc": "version",
+    "comment/comment_parser_test.cc": "comment",
+    "environment/environment_variable_data_parser_test.cc": "environment_variable_data",
+    "environment/environment_variable_parser_test.cc": "environment_variable",
+    "message/message_parser_test.cc": "message",
+    "message/message_transmitters_parser_test.cc": "message_transmitters",
+    "message/signal_group_parser_test.cc": "signal_group",
+    "message/signal_parser_test.cc": "signal",
+    "message/signal_type_def_parser_test.cc": "signal_type_def",
+    "message/signal_value_type_parser_test.cc": "signal_value_type",
+    "value/value_description_parser_test.cc": "value_description",
+    "value/value_table_parser_test.cc": "value_table",
+    "integration/dbc_file_parser_test.cc": "dbc_file",
+}
+
+ASSIGNMENT = re.compile(r"\b(?:input|kInput)\s*(?:\[\])?\s*=\s*")
+RAW_LITERAL = re.compile(r'R"([^(]*)\((.*?)\)\1"', re.S)
+LITERAL = re.compile(r'"((?:[^"\\\n]|\\.)*)"')
+ESCAPES = {"n": "\n", "t": "\t", "r": "\r", "\\": "\\", '"': '"', "'": "'", "0": "\0"}
+
+
+def unescape(text):
+    return re.sub(r"\\(.)", lambda m: ESCAPES.get(m.group(1), m.group(1)), text)
+
+
+def literals_after(source, pos):
+    """Concatenates the adjacent string literals starting at pos."""
+    parts = []
+    while True:
+        while pos < len(source) and source[pos] in " \t\r\n":
+            pos += 1
+        if source.startswith("//", pos):
+            pos = source.index("\n", pos)
+            continue
+        raw = RAW_LITERAL.match(source, pos)
+        if raw:
+            parts.append(raw.group(2))
+            pos = raw.end()
+            continue
+        cooked = LITERAL.match(source, pos)
+        if cooked:
+            parts.append(unescape(cooked.group(1)))
+            pos = cooked.end()
+            continue
+        return "".join(parts) if parts else None
+
+
+def main():
+    for test_file, target in sorted(TARGETS.items()):
+        source = (TEST_ROOT / test_file).read_text()
+        seeds = set()
+        for match in ASSIGNMENT.finditer(source):
+            text = literals_after(source, match.end())
+            if text:
+                seeds.add(text)
+        directory = CORPUS_ROOT / target
+        shutil.rmtree(directory, ignore_errors=True)
+        directory.mkdir(parents=True)
+        for text in seeds:
+            data = text.encode()
+            name = hashlib.sha1(data).hexdigest()[:16]
+            (directory / name).write_bytes(data)
+        print(f"{target}: {len(seeds)} seeds")
+
+
+if __name__ == "__main__":
+    main()
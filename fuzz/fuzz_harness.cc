@@ -0,0 +1,119 @@
+#include "fuzz/fuzz_harness.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+
+namespace dbc_parser {
+namespace fuzz {
+namespace {
+
+// Extra runs of an input that was over budget on the first try
+constexpr int kRetries = 2;
+
+std::uint64_t ParseOnce(ParseFunction parse, std::string_view input) {
+  const auto start = std::chrono::steady_clock::now();
+  parse(input);
+  return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+const SlowInputPolicy& EnvironmentPolicy() {
+  static const SlowInputPolicy policy = SlowInputPolicy::FromEnvironment();
+  return policy;
+}
+
+// Writes the input to the policy's directory; returns the path, or "" if none
+std::string RecordSlowInput(std::string_view input, std::uint64_t nanoseconds, const SlowInputPolicy& policy) {
+  if (policy.directory.empty()) {
+    return "";
+  }
+  const std::uint64_t ns_per_byte = nanoseconds / std::max<std::size_t>(input.size(), 1);
+  char name[64];
+  std::snprintf(name, sizeof(name), "slow-%llu-%016zx", static_cast<unsigned long long>(ns_per_byte),
+                std::hash<std::string_view>{}(input));
+  const std::string path = policy.directory + "/" + name;
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file.write(input.data(), static_cast<std::streamsize>(input.size()));
+  return file ? path : "";
+}
+
+}  // namespace
+
+SlowInputPolicy SlowInputPolicy::FromEnvironment() {
+  SlowInputPolicy policy;
+  if (const char* value = std::getenv("DBC_FUZZ_NS_PER_BYTE")) {
+    policy.ns_per_byte = std::strtod(value, nullptr);
+  }
+  if (const char* value = std::getenv("DBC_FUZZ_BASE_NS")) {
+    policy.base_ns = std::strtoull(value, nullptr, 10);
+  }
+  if (const char* value = std::getenv("DBC_FUZZ_SLOW_DIR")) {
+    policy.directory = value;
+  }
+  if (const char* value = std::getenv("DBC_FUZZ_SLOW_ABORT")) {
+    policy.abort_on_slow = std::string_view(value) == "1";
+  }
+  return policy;
+}
+
+std::uint64_t SlowInputPolicy::BudgetNanoseconds(std::size_t size) const noexcept {
+  return base_ns + static_cast<std::uint64_t>(ns_per_byte * static_cast<double>(size));
+}
+
+std::uint64_t TimeParse(ParseFunction parse, std::string_view input, const SlowInputPolicy& policy) {
+  const std::uint64_t budget = policy.BudgetNanoseconds(input.size());
+  std::uint64_t fastest = ParseOnce(parse, input);
+  for (int retry = 0; retry < kRetries && fastest > budget; ++retry) {
+    fastest = std::min(fastest, ParseOnce(parse, input));
+  }
+  return fastest;
+}
+
+bool IsSlow(ParseFunction parse, std::string_view input, const SlowInputPolicy& policy) {
+  return TimeParse(parse, input, policy) > policy.BudgetNanoseconds(input.size());
+}
+
+int RunFuzzInput(ParseFunction parse, const std::uint8_t* data, std::size_t size) {
+  const SlowInputPolicy& policy = EnvironmentPolicy();
+  const std::string_view input(reinterpret_cast<const char*>(data), size);
+  const std::uint64_t nanoseconds = TimeParse(parse, input, policy);
+  if (nanoseconds <= policy.BudgetNanoseconds(size)) {
+    return 0;
+  }
+
+  const std::string path = RecordSlowInput(input, nanoseconds, policy);
+  std::fprintf(stderr, "==dbc_fuzz== slow input: %zu bytes parsed in %llu ns (budget %llu ns)%s%s\n", size,
+               static_cast<unsigned long long>(nanoseconds),
+               static_cast<unsigned long long>(policy.BudgetNanoseconds(size)), path.empty() ? "" : ", saved to ",
+               path.c_str());
+  if (policy.abort_on_slow) {
+    std::abort();
+  }
+  return 0;
+}
+
+std::string MinimizeSlowInput(ParseFunction parse, std::string input, const SlowInputPolicy& policy) {
+  for (std::size_t chunk = std::max<std::size_t>(input.size() / 2, 1);; chunk /= 2) {
+    std::size_t start = 0;
+    while (start < input.size()) {
+      std::string candidate = input.substr(0, start);
+      candidate.append(input, std::min(start + chunk, input.size()), std::string::npos);
+      if (!candidate.empty() && IsSlow(parse, candidate, policy)) {
+        input = std::move(candidate);
+      } else {
+        start += chunk;
+      }
+    }
+    if (chunk == 1) {
+      break;
+    }
+  }
+  return input;
+}
+
+}  // namespace fuzz
+}  // namespace dbc_parser
@@ -0,0 +1,100 @@
+#ifndef DBC_PARSER_FUZZ_FUZZ_HARNESS_H_
+#define DBC_PARSER_FUZZ_FUZZ_HARNESS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace dbc_parser {
+namespace fuzz {
+
+/**
+ * @brief Parses one input; the result is discarded.
+ */
+using ParseFunction = void (*)(std::string_view input);
+
+/**
+ * @brief When a parse counts as slow, and what happens to a slow input.
+ *
+ * A parse is slow if it takes longer than base_ns + ns_per_byte * size. The
+ * fixed allowance keeps tiny inputs from tripping on timer noise; the per-byte
+ * part catches inputs that make the parser super-linear.
+ */
+struct SlowInputPolicy {
+  double ns_per_byte = 2000.0;         ///< DBC_FUZZ_NS_PER_BYTE
+  std::uint64_t base_ns = 20000000;    ///< DBC_FUZZ_BASE_NS
+  std::string directory;               ///< DBC_FUZZ_SLOW_DIR: slow inputs are written here
+  bool abort_on_slow = false;          ///< DBC_FUZZ_SLOW_ABORT=1: report slow inputs as crashes
+
+  /**
+   * @brief Reads the policy from the DBC_FUZZ_* environment variables.
+   */
+  [[nodiscard]] static SlowInputPolicy FromEnvironment();
+
+  /**
+   * @brief Time allowed for an input of the given size.
+   */
+  [[nodiscard]] std::uint64_t BudgetNanoseconds(std::size_t size) const noexcept;
+};
+
+/**
+ * @brief Parses an input and returns the time taken in nanoseconds.
+ *
+ * A parse over budget is repeated twice and the fastest run counts, so that
+ * a preempted run is not reported as slow.
+ */
+[[nodiscard]] std::uint64_t TimeParse(ParseFunction parse, std::string_view input, const SlowInputPolicy& policy);
+
+/**
+ * @brief Returns whether parsing the input exceeds the policy's budget.
+ */
+[[nodiscard]] bool IsSlow(ParseFunction parse, std::string_view input, const SlowInputPolicy& policy);
+
+/**
+ * @brief Body of LLVMFuzzerTestOneInput.
+ *
+ * Parses the input under the policy from the environment. A slow input is
+ * reported on stderr, written to the slow-input directory and, with
+ * abort_on_slow, turned into a crash so that libFuzzer or AFL++ keeps it and
+ * can minimize it (libFuzzer: -minimize_crash=1).
+ *
+ * @return 0, as libFuzzer requires
+ */
+int RunFuzzInput(ParseFunction parse, const std::uint8_t* data, std::size_t size);
+
+/**
+ * @brief Shrinks a slow input while it stays slow.
+ *
+ * Removes chunks of halving size, keeping every removal after which the input
+ * is still over budget. Deterministic apart from timing.
+ *
+ * @param parse Parse function of the target
+ * @param input A slow input
+ * @param policy Budget the result still exceeds
+ * @return The smallest slow input found
+ */
+[[nodiscard]] std::string MinimizeSlowInput(ParseFunction parse, std::string input, const SlowInputPolicy& policy);
+
+/**
+ * @brief Parse function of the target linked into this binary.
+ *
+ * Defined by DBC_FUZZ_TARGET; used by the standalone driver.
+ */
+ParseFunction TargetParseFunction();
+
+}  // namespace fuzz
+}  // namespace dbc_parser
+
+// Defines the libFuzzer / AFL++ entry point of a fuzz target:
+//   DBC_FUZZ_TARGET(ParseSomething)
+// where ParseSomething is a dbc_parser::fuzz::ParseFunction.
+#define DBC_FUZZ_TARGET(parse_function)                                                  \
+  dbc_parser::fuzz::ParseFunction dbc_parser::fuzz::TargetParseFunction() {              \
+    return parse_function;                                                               \
+  }                                                                                      \
+  extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size) {    \
+    return ::dbc_parser::fuzz::RunFuzzInput(parse_function, data, size);                 \
+  }
+
+#endif  // DBC_PARSER_FUZZ_FUZZ_HARNESS_H_
@@ -0,0 +1,115 @@
+// Driver for fuzz targets built without libFuzzer (plain or sanitizer builds,
+// GCC). Replays corpus files and directories through LLVMFuzzerTestOneInput,
+// accepting and ignoring libFuzzer flags such as -runs=0, and minimizes slow
+// inputs:
+//
+//   <target> [-flags...] <file or directory>...
+//   <target> --minimize_slow=<output> <slow input>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "fuzz/fuzz_harness.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size);
+
+namespace dbc_parser {
+namespace fuzz {
+namespace {
+
+constexpr std::string_view kMinimizeFlag = "--minimize_slow=";
+
+bool ReadFile(const std::filesystem::path& path, std::string& contents) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  return true;
+}
+
+// Regular files under each argument, in a stable order
+std::vector<std::filesystem::path> CollectInputs(const std::vector<std::string>& arguments) {
+  std::vector<std::filesystem::path> inputs;
+  for (const std::string& argument : arguments) {
+    if (std::filesystem::is_directory(argument)) {
+      std::vector<std::filesystem::path> files;
+      for (const auto& entry : std::filesystem::recursive_directory_iterator(argument)) {
+        if (entry.is_regular_file()) {
+          files.push_back(entry.path());
+        }
+      }
+      std::sort(files.begin(), files.end());
+      inputs.insert(inputs.end(), files.begin(), files.end());
+    } else {
+      inputs.emplace_back(argument);
+    }
+  }
+  return inputs;
+}
+
+int Replay(const std::vector<std::string>& arguments) {
+  const std::vector<std::filesystem::path> inputs = CollectInputs(arguments);
+  std::string contents;
+  for (const auto& path : inputs) {
+    if (!ReadFile(path, contents)) {
+      std::fprintf(stderr, "cannot read %s\n", path.c_str());
+      return 1;
+    }
+    LLVMFuzzerTestOneInput(reinterpret_cast<const std::uint8_t*>(contents.data()), contents.size());
+  }
+  std::fprintf(stderr, "replayed %zu inputs\n", inputs.size());
+  return 0;
+}
+
+int Minimize(const std::string& output, const std::vector<std::string>& arguments) {
+  std::string input;
+  if (arguments.size() != 1 || !ReadFile(arguments.front(), input)) {
+    std::fprintf(stderr, "--minimize_slow needs exactly one readable input file\n");
+    return 1;
+  }
+  const SlowInputPolicy policy = SlowInputPolicy::FromEnvironment();
+  if (!IsSlow(TargetParseFunction(), input, policy)) {
+    std::fprintf(stderr, "input is not slow under the current policy\n");
+    return 1;
+  }
+
+  const std::string minimized = MinimizeSlowInput(TargetParseFunction(), std::move(input), policy);
+  std::ofstream file(output, std::ios::binary | std::ios::trunc);
+  file.write(minimized.data(), static_cast<std::streamsize>(minimized.size()));
+  if (!file) {
+    std::fprintf(stderr, "cannot write %s\n", output.c_str());
+    return 1;
+  }
+  std::fprintf(stderr, "minimized slow input to %zu bytes: %s\n", minimized.size(), output.c_str());
+  return 0;
+}
+
+}  // namespace
+}  // namespace fuzz
+}  // namespace dbc_parser
+
+int main(int argc, char** argv) {
+  std::string minimize_output;
+  std::vector<std::string> arguments;
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view argument = argv[i];
+    if (argument.substr(0, dbc_parser::fuzz::kMinimizeFlag.size()) == dbc_parser::fuzz::kMinimizeFlag) {
+      minimize_output = std::string(argument.substr(dbc_parser::fuzz::kMinimizeFlag.size()));
+    } else if (argument.empty() || argument.front() != '-') {
+      arguments.emplace_back(argument);
+    }
+  }
+
+  if (!minimize_output.empty()) {
+    return dbc_parser::fuzz::Minimize(minimize_output, arguments);
+  }
+  return dbc_parser::fuzz::Replay(arguments);
+}
@@ -0,0 +1,39 @@
+// Fuzz target for one section parser. fuzz/BUILD compiles this file once per
+// parser and names the class with DBC_FUZZ_PARSER, e.g.
+// -DDBC_FUZZ_PARSER=MessageParser.
+
+#include <string_view>
+
+#include "fuzz/fuzz_harness.h"
+#include "src/dbc_parser/parser/attribute/attribute_definition_default_parser.h"
+#include "src/dbc_parser/parser/attribute/attribute_definition_parser.h"
+#include "src/dbc_parser/parser/attribute/attribute_value_parser.h"
+#include "src/dbc_parser/parser/base/bit_timing_parser.h"
+#include "src/dbc_parser/parser/base/new_symbols_parser.h"
+#include "src/dbc_parser/parser/base/nodes_parser.h"
+#include "src/dbc_parser/parser/base/version_parser.h"
+#include "src/dbc_parser/parser/comment/comment_parser.h"
+#include "src/dbc_parser/parser/environment/environment_variable_data_parser.h"
+#include "src/dbc_parser/parser/environment/environment_variable_parser.h"
+#include "src/dbc_parser/parser/message/message_parser.h"
+#include "src/dbc_parser/parser/message/message_transmitters_parser.h"
+#include "src/dbc_parser/parser/message/signal_group_parser.h"
+#include "src/dbc_parser/parser/message/signal_parser.h"
+#include "src/dbc_parser/parser/message/signal_type_def_parser.h"
+#include "src/dbc_parser/parser/message/signal_value_type_parser.h"
+#include "src/dbc_parser/parser/value/value_description_parser.h"
+#include "src/dbc_parser/parser/value/value_table_parser.h"
+
+#ifndef DBC_FUZZ_PARSER
+#error "DBC_FUZZ_PARSER must name the section parser class to fuzz"
+#endif
+
+namespace {
+
+void ParseSection(std::string_view input) {
+  static_cast<void>(dbc_parser::parser::DBC_FUZZ_PARSER::Parse(input));
+}
+
+}  // namespace
+
+DBC_FUZZ_TARGET(ParseSection)
@@ -1,9 +1,12 @@
 #ifndef DBC_PARSER_PARSER_COMMON_TYPES_H_
 #define DBC_PARSER_PARSER_COMMON_TYPES_H_
 
+#include <cstdint>
 #include <map>
 #include <optional>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <variant>
 
@@ -16,6 +19,10 @@ namespace parser {
  * This file defines all the common types used throughout the DBC parser library.
  * These include enumerations for different object types and data structures to
  * hold parsed information.
+ *
+ * The structures declare their destructors, which would suppress the implicit
+ * move operations; they therefore default their copy and move operations
+ * explicitly so that parse results are moved, not copied, into the final model.
  */
 
 /**
@@ -26,7 +33,8 @@ namespace parser {
 enum class MultiplexType {
   kNone = 0,       ///< Not multiplexed (regular signal)
   kMultiplexor,    ///< This signal is the multiplexor (selector)
-  kMultiplexed     ///< This signal is multiplexed (depends on multiplexor value)
+  kMultiplexed,    ///< This signal is multiplexed (depends on multiplexor value)
+  kMultiplexedMultiplexor  ///< Multiplexed and itself a multiplexor (mXM, extended multiplexing)
 };
 
 /**
@@ -79,21 +87,33 @@ enum class AttributeValueType {
   ENUM             ///< Enumeration value
 };
 
+/**
+ * @brief Frame format of a message.
+ *
+ * Taken from the VFrameFormat message attribute; messages without it are
+ * classic CAN frames, extended if their ID has bit 31 set.
+ */
+enum class FrameFormat : std::uint8_t {
+  kStandardCan = 0,  ///< Classic CAN, 11-bit ID, up to 8 bytes
+  kExtendedCan,      ///< Classic CAN, 29-bit ID, up to 8 bytes
+  kJ1939,            ///< J1939 parameter group, 29-bit ID
+  kStandardCanFd,    ///< CAN FD, 11-bit ID, up to 64 bytes
+  kExtendedCanFd     ///< CAN FD, 29-bit ID, up to 64 bytes
+};
+
 /**
  * @brief Basic signal structure used across the parser.
  *
  * Represents a CAN signal with all its properties as defined in a DBC file.
  * This structure is used to store the parsed signal information and is included
- * in the Message structure.
+ * in the Message structure. Each fact is stored exactly once; DbcFile splits it
+ * into a SignalLayout and a SignalInfo when the file is assembled.
  */
 struct Signal {
   std::string name;                   ///< Signal name
   int start_bit = 0;                  ///< Start bit position
-  int signal_size = 0;                ///< Size in bits (same as 'length')
   int length = 0;                     ///< Length in bits
   int byte_order = 1;                 ///< Byte order (1=little endian, 0=big endian)
-  bool is_little_endian = true;       ///< Internal flag for byte order
-  bool is_signed = false;             ///< Sign (+ or -)
   SignType sign = SignType::kUnsigned; ///< Sign type
   double factor = 1.0;                ///< Scaling factor
   double offset = 0.0;                ///< Offset
@@ -101,13 +121,68 @@ struct Signal {
   double maximum = 0.0;               ///< Maximum value
   std::string unit;                   ///< Unit (e.g., "km/h")
   std::vector<std::string> receivers; ///< Receiving nodes
-  bool is_multiplexer = false;        ///< Whether signal is a multiplexer switch
-  std::optional<int> multiplex_value; ///< Multiplexer value if signal is multiplexed
   MultiplexType multiplex_type = MultiplexType::kNone; ///< Multiplexing type
-  int multiplex_value_int = -1;       ///< Integer representation of multiplex_value
+  std::optional<int> multiplex_value; ///< Multiplexer value if signal is multiplexed
 
   Signal() noexcept = default;
   ~Signal() noexcept = default;
+  Signal(const Signal&) = default;
+  Signal& operator=(const Signal&) = default;
+  Signal(Signal&&) = default;
+  Signal& operator=(Signal&&) = default;
+};
+
+/**
+ * @brief Decode-critical part of a signal, packed into 40 bytes.
+ *
+ * Holds exactly what is needed to turn payload bits into a physical value, so
+ * the layouts of a whole message sit in a handful of cache lines. Names, units
+ * and receivers live in the matching SignalInfo. The struct is deliberately a
+ * plain aggregate: it is trivially copyable and can be stored in flat arrays.
+ */
+struct SignalLayout {
+  static constexpr std::uint8_t kLittleEndian = 1u << 0;  ///< Intel byte order (@1)
+  static constexpr std::uint8_t kSigned = 1u << 1;        ///< Two's complement raw value (-)
+  static constexpr std::uint8_t kMultiplexor = 1u << 2;   ///< Selects the active multiplexed signals (M)
+  static constexpr std::uint8_t kMultiplexed = 1u << 3;   ///< Valid only for multiplex_value (mX)
+  static constexpr std::uint8_t kFloat32 = 1u << 4;       ///< Raw bits are an IEEE float (SIG_VALTYPE_ 1)
+  static constexpr std::uint8_t kFloat64 = 1u << 5;       ///< Raw bits are an IEEE double (SIG_VALTYPE_ 2)
+
+  double factor = 1.0;                ///< Scaling factor
+  double offset = 0.0;                ///< Offset
+  double minimum = 0.0;               ///< Minimum physical value
+  double maximum = 0.0;               ///< Maximum physical value
+  std::int32_t multiplex_value = -1;  ///< Selector value (kMultiplexed only)
+  std::uint16_t start_bit = 0;        ///< Start bit position as written in the DBC file
+  std::uint8_t length = 0;            ///< Length in bits
+  std::uint8_t flags = 0;             ///< Combination of the k* flag bits above
+
+  [[nodiscard]] bool is_little_endian() const noexcept { return (flags & kLittleEndian) != 0; }
+  [[nodiscard]] bool is_signed() const noexcept { return (flags & kSigned) != 0; }
+  [[nodiscard]] bool is_multiplexor() const noexcept { return (flags & kMultiplexor) != 0; }
+  [[nodiscard]] bool is_multiplexed() const noexcept { return (flags & kMultiplexed) != 0; }
+};
+
+static_assert(sizeof(SignalLayout) == 40, "SignalLayout must stay packed");
+static_assert(std::is_trivially_copyable_v<SignalLayout>, "SignalLayout must be trivially copyable");
+
+/**
+ * @brief Descriptive, rarely accessed part of a signal.
+ *
+ * Stored in a table parallel to the SignalLayout table, at the same index.
+ */
+struct SignalInfo {
+  std::string name;                   ///< Signal name
+  std::string unit;                   ///< Unit (e.g., "km/h")
+  std::vector<std::string> receivers; ///< Receiving nodes
+  int message_id = 0;                 ///< ID of the message that carries the signal
+
+  SignalInfo() noexcept = default;
+  ~SignalInfo() noexcept = default;
+  SignalInfo(const SignalInfo&) = default;
+  SignalInfo& operator=(const SignalInfo&) = default;
+  SignalInfo(SignalInfo&&) = default;
+  SignalInfo& operator=(SignalInfo&&) = default;
 };
 
 /**
@@ -119,12 +194,16 @@ struct Signal {
 struct Message {
   int id = 0;                 ///< Message ID
   std::string name;           ///< Message name
-  int dlc = 0;                ///< Data Length Code (size in bytes)
+  int dlc = 0;                ///< Payload size in bytes as written in BO_, up to 64 for CAN FD
   std::string sender;         ///< Sender node
   std::vector<Signal> signals;///< Signals in the message
 
   Message() noexcept = default;
   ~Message() noexcept = default;
+  Message(const Message&) = default;
+  Message& operator=(const Message&) = default;
+  Message(Message&&) = default;
+  Message& operator=(Message&&) = default;
 };
 
 /**
@@ -146,6 +225,10 @@ struct EnvironmentVariable {
 
   EnvironmentVariable() noexcept = default;
   ~EnvironmentVariable() noexcept = default;
+  EnvironmentVariable(const EnvironmentVariable&) = default;
+  EnvironmentVariable& operator=(const EnvironmentVariable&) = default;
+  EnvironmentVariable(EnvironmentVariable&&) = default;
+  EnvironmentVariable& operator=(EnvironmentVariable&&) = default;
 };
 
 /**
@@ -159,6 +242,10 @@ struct EnvironmentVariableData {
 
   EnvironmentVariableData() noexcept = default;
   ~EnvironmentVariableData() noexcept = default;
+  EnvironmentVariableData(const EnvironmentVariableData&) = default;
+  EnvironmentVariableData& operator=(const EnvironmentVariableData&) = default;
+  EnvironmentVariableData(EnvironmentVariableData&&) = default;
+  EnvironmentVariableData& operator=(EnvironmentVariableData&&) = default;
 };
 
 /**
@@ -179,6 +266,10 @@ struct Comment {
 
   Comment() noexcept = default;
   ~Comment() noexcept = default;
+  Comment(const Comment&) = default;
+  Comment& operator=(const Comment&) = default;
+  Comment(Comment&&) = default;
+  Comment& operator=(Comment&&) = default;
 };
 
 /**
@@ -191,6 +282,10 @@ struct Node {
 
   Node() noexcept = default;
   ~Node() noexcept = default;
+  Node(const Node&) = default;
+  Node& operator=(const Node&) = default;
+  Node(Node&&) = default;
+  Node& operator=(Node&&) = default;
 };
 
 /**
@@ -204,6 +299,10 @@ struct BitTiming {
 
   BitTiming() noexcept = default;
   ~BitTiming() noexcept = default;
+  BitTiming(const BitTiming&) = default;
+  BitTiming& operator=(const BitTiming&) = default;
+  BitTiming(BitTiming&&) = default;
+  BitTiming& operator=(BitTiming&&) = default;
 };
 
 /**
@@ -226,6 +325,10 @@ struct ValueTable {
 
   ValueTable() noexcept = default;
   ~ValueTable() noexcept = default;
+  ValueTable(const ValueTable&) = default;
+  ValueTable& operator=(const ValueTable&) = default;
+  ValueTable(ValueTable&&) = default;
+  ValueTable& operator=(ValueTable&&) = default;
 };
 
 /**
@@ -254,7 +357,58 @@ public:
   TypeConverter(TypeConverter&&) = delete;
   TypeConverter& operator=(TypeConverter&&) = delete;
 
-  // Add methods as needed for conversions between equivalent types
+  /**
+   * @brief Extracts the decode-critical fields of a parsed signal.
+   *
+   * Start bits and lengths outside the packed field widths are clamped, which
+   * makes the decoder reject the signal instead of reading wrong bits.
+   *
+   * @param signal The parsed signal
+   * @return SignalLayout The packed layout
+   */
+  [[nodiscard]] static SignalLayout ToSignalLayout(const Signal& signal) noexcept {
+    SignalLayout layout;
+    layout.factor = signal.factor;
+    layout.offset = signal.offset;
+    layout.minimum = signal.minimum;
+    layout.maximum = signal.maximum;
+    layout.start_bit = static_cast<std::uint16_t>(signal.start_bit < 0 ? 0xFFFF
+                       : signal.start_bit > 0xFFFF ? 0xFFFF : signal.start_bit);
+    layout.length = static_cast<std::uint8_t>(signal.length < 0 ? 0
+                    : signal.length > 0xFF ? 0xFF : signal.length);
+    if (signal.byte_order == 1) {
+      layout.flags |= SignalLayout::kLittleEndian;
+    }
+    if (signal.sign == SignType::kSigned) {
+      layout.flags |= SignalLayout::kSigned;
+    }
+    if (signal.multiplex_type == MultiplexType::kMultiplexor) {
+      layout.flags |= SignalLayout::kMultiplexor;
+    } else if (signal.multiplex_type == MultiplexType::kMultiplexed) {
+      layout.flags |= SignalLayout::kMultiplexed;
+      layout.multiplex_value = signal.multiplex_value.value_or(0);
+    } else if (signal.multiplex_type == MultiplexType::kMultiplexedMultiplexor) {
+      layout.flags |= SignalLayout::kMultiplexor | SignalLayout::kMultiplexed;
+      layout.multiplex_value = signal.multiplex_value.value_or(0);
+    }
+    return layout;
+  }
+
+  /**
+   * @brief Moves the descriptive fields of a parsed signal into a SignalInfo.
+   *
+   * @param signal The parsed signal; its strings are moved from
+   * @param message_id ID of the message that carries the signal
+   * @return SignalInfo The cold signal data
+   */
+  [[nodiscard]] static SignalInfo ToSignalInfo(Signal&& signal, int message_id) noexcept {
+    SignalInfo info;
+    info.name = std::move(signal.name);
+    info.unit = std::move(signal.unit);
+    info.receivers = std::move(signal.receivers);
+    info.message_id = message_id;
+    return info;
+  }
 };
 
 }  // namespace parser
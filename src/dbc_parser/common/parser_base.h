@@ -1,9 +1,13 @@
 #ifndef DBC_PARSER_PARSER_PARSER_BASE_H_
 #define DBC_PARSER_PARSER_PARSER_BASE_H_
 
+#include <charconv>
+#include <cstdint>
+#include <cstring>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <tao/pegtl.hpp>
 
 namespace dbc_parser {
@@ -11,6 +15,67 @@ namespace parser {
 
 namespace pegtl = tao::pegtl;
 
+/**
+ * @brief Content of a quoted DBC string, borrowed from the source when possible.
+ *
+ * Most quoted strings in DBC files (units, comments, enum labels) contain no
+ * escape sequences. For those, QuotedText is just a view into the parser input
+ * and no allocation or copy takes place; only strings containing backslashes
+ * are unescaped into an owned buffer. A borrowed QuotedText is valid only as
+ * long as the input it was created from.
+ */
+class QuotedText {
+ public:
+  QuotedText() noexcept = default;
+
+  /**
+   * @brief Creates a QuotedText that refers to text owned by someone else.
+   */
+  [[nodiscard]] static QuotedText Borrowed(std::string_view text) noexcept {
+    QuotedText result;
+    result.view_ = text;
+    return result;
+  }
+
+  /**
+   * @brief Creates a QuotedText that owns its (already unescaped) text.
+   */
+  [[nodiscard]] static QuotedText Owned(std::string text) noexcept {
+    QuotedText result;
+    result.owned_ = std::move(text);
+    result.is_owned_ = true;
+    return result;
+  }
+
+  /**
+   * @brief Returns the unescaped text.
+   */
+  [[nodiscard]] std::string_view view() const noexcept {
+    return is_owned_ ? std::string_view(owned_) : view_;
+  }
+
+  /**
+   * @brief Returns true if the text points into the source rather than an owned buffer.
+   */
+  [[nodiscard]] bool is_borrowed() const noexcept { return !is_owned_; }
+
+  [[nodiscard]] bool empty() const noexcept { return view().empty(); }
+
+  /**
+   * @brief Materializes the text as a std::string, copying only if it was borrowed.
+   */
+  [[nodiscard]] std::string str() && {
+    return is_owned_ ? std::move(owned_) : std::string(view_);
+  }
+
+  [[nodiscard]] std::string str() const& { return std::string(view()); }
+
+ private:
+  std::string_view view_;   ///< Borrowed text (when !is_owned_)
+  std::string owned_;       ///< Unescaped text (when is_owned_)
+  bool is_owned_ = false;
+};
+
 /**
  * @brief Base class for all DBC file parsers.
  *
@@ -31,16 +96,40 @@ class ParserBase {
    * @return std::string The unescaped string content without quotes
    */
   [[nodiscard]] static std::string UnescapeString(std::string_view quoted) noexcept {
-    if (quoted.size() < 2) return "";
+    return UnescapeQuoted(quoted).str();
+  }
+
+  /**
+   * @brief Unescapes a quoted string without copying when it contains no escapes.
+   *
+   * Behaves like UnescapeString, but when the content has no backslash (checked
+   * with a single memchr scan) the result borrows from @p quoted instead of
+   * allocating. The result must not outlive the memory @p quoted refers to.
+   *
+   * @param quoted The quoted string to unescape (including quotes)
+   * @return QuotedText The unescaped content without quotes
+   */
+  [[nodiscard]] static QuotedText UnescapeQuoted(std::string_view quoted) noexcept {
+    if (quoted.size() < 2) return QuotedText();
     
     // Remove surrounding quotes
     std::string_view content = quoted.substr(1, quoted.size() - 2);
     
+    const void* first_escape = content.empty()
+        ? nullptr
+        : std::memchr(content.data(), '\\', content.size());
+    if (first_escape == nullptr) {
+      return QuotedText::Borrowed(content);
+    }
+    
+    // Copy the escape-free prefix in one go, then unescape the remainder
+    const size_t prefix = static_cast<size_t>(static_cast<const char*>(first_escape) - content.data());
     std::string result;
     result.reserve(content.size());
+    result.append(content.data(), prefix);
     
     bool escaped = false;
-    for (char c : content) {
+    for (char c : content.substr(prefix)) {
       if (escaped) {
         result.push_back(c);
         escaped = false;
@@ -51,7 +140,36 @@ class ParserBase {
       }
     }
     
-    return result;
+    return QuotedText::Owned(std::move(result));
+  }
+
+  /**
+   * @brief Parses a decimal CAN message ID as written in a DBC file.
+   *
+   * Extended (29-bit) IDs are written with bit 31 set, i.e. as values up to
+   * 4294967295, which do not fit an int. Such values are stored with their bit
+   * pattern preserved, so `static_cast<uint32_t>(id)` recovers the DBC value
+   * and `id & 0x1FFFFFFF` the frame ID. Negative values are passed through.
+   *
+   * -1 (written as -1 or 4294967295) is rejected: DbcFile uses it to mark
+   * value descriptions of environment variables, and it is not a valid CAN ID.
+   *
+   * @param text Decimal digits with an optional leading minus sign
+   * @return std::optional<int> The ID, or std::nullopt if @p text is not a
+   *         number in [INT_MIN, UINT32_MAX] or denotes -1
+   */
+  [[nodiscard]] static std::optional<int> ParseMessageId(std::string_view text) noexcept {
+    std::int64_t value = 0;
+    const char* end = text.data() + text.size();
+    auto [ptr, ec] = std::from_chars(text.data(), end, value);
+    if (ec != std::errc() || ptr != end || value < INT32_MIN || value > UINT32_MAX) {
+      return std::nullopt;
+    }
+    const int id = static_cast<int>(static_cast<std::uint32_t>(value));
+    if (id == -1) {
+      return std::nullopt;
+    }
+    return id;
   }
 
  protected:
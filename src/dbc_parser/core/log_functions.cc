@@ -0,0 +1,26 @@
+#include "dbc_parser/core/log_macros.h"
+
+namespace dbc_parser {
+namespace core {
+namespace log {
+
+void Write(LogLevel level, std::string_view message) {
+  if (Logger::AdmitRepeated(level, message)) {
+    Logger::Write(level, message);
+  }
+}
+
+void VWrite(LogLevel level, fmt::string_view format, fmt::format_args args) {
+  // Repeats are detected by format string, before anything is formatted
+  if (!Logger::AdmitRepeated(level, std::string_view(format.data(), format.size()))) {
+    return;
+  }
+  // Small messages are formatted on the stack
+  fmt::memory_buffer buffer;
+  fmt::vformat_to(fmt::appender(buffer), format, args);
+  Logger::Write(level, std::string_view(buffer.data(), buffer.size()));
+}
+
+}  // namespace log
+}  // namespace core
+}  // namespace dbc_parser
@@ -1,47 +1,126 @@
 #ifndef DBC_PARSER_CORE_LOG_MACROS_H_
 #define DBC_PARSER_CORE_LOG_MACROS_H_
 
+#include <string_view>
+
+#include "fmt/format.h"
 #include "dbc_parser/core/logger.h"
 
-// Declare non-templated logging functions to avoid direct method calls on incomplete types
+// Compile-time levels, in the order of dbc_parser::core::LogLevel
+#define DBC_LOG_LEVEL_TRACE 0
+#define DBC_LOG_LEVEL_DEBUG 1
+#define DBC_LOG_LEVEL_INFO 2
+#define DBC_LOG_LEVEL_WARN 3
+#define DBC_LOG_LEVEL_ERROR 4
+#define DBC_LOG_LEVEL_CRITICAL 5
+#define DBC_LOG_LEVEL_OFF 6
+
+// Log statements below this level are removed by the preprocessor, arguments
+// included. Build with e.g. --copt=-DDBC_LOG_ACTIVE_LEVEL=DBC_LOG_LEVEL_TRACE
+// to keep debug and trace output.
+#ifndef DBC_LOG_ACTIVE_LEVEL
+#define DBC_LOG_ACTIVE_LEVEL DBC_LOG_LEVEL_INFO
+#endif
+
 namespace dbc_parser {
 namespace core {
 namespace log {
 
-// Basic logging functions with common format
-void trace(const char* fmt, ...);
-void debug(const char* fmt, ...);
-void info(const char* fmt, ...);
-void warn(const char* fmt, ...);
-void error(const char* fmt, ...);
-void critical(const char* fmt, ...);
-
-// Simple string logging functions
-void trace_str(const std::string& msg);
-void debug_str(const std::string& msg);
-void info_str(const std::string& msg);
-void warn_str(const std::string& msg);
-void error_str(const std::string& msg);
-void critical_str(const std::string& msg);
-
-} // namespace log
-} // namespace core
-} // namespace dbc_parser
-
-// Define convenience macros for logging
-#define DBC_LOG_TRACE(...) ::dbc_parser::core::log::trace(__VA_ARGS__)
-#define DBC_LOG_DEBUG(...) ::dbc_parser::core::log::debug(__VA_ARGS__)
-#define DBC_LOG_INFO(...) ::dbc_parser::core::log::info(__VA_ARGS__)
-#define DBC_LOG_WARN(...) ::dbc_parser::core::log::warn(__VA_ARGS__)
-#define DBC_LOG_ERROR(...) ::dbc_parser::core::log::error(__VA_ARGS__)
-#define DBC_LOG_CRITICAL(...) ::dbc_parser::core::log::critical(__VA_ARGS__)
-
-// String-only versions for simple messages
-#define DBC_LOG_TRACE_STR(msg) ::dbc_parser::core::log::trace_str(msg)
-#define DBC_LOG_DEBUG_STR(msg) ::dbc_parser::core::log::debug_str(msg)
-#define DBC_LOG_INFO_STR(msg) ::dbc_parser::core::log::info_str(msg)
-#define DBC_LOG_WARN_STR(msg) ::dbc_parser::core::log::warn_str(msg)
-#define DBC_LOG_ERROR_STR(msg) ::dbc_parser::core::log::error_str(msg)
-#define DBC_LOG_CRITICAL_STR(msg) ::dbc_parser::core::log::critical_str(msg)
-
-#endif  // DBC_PARSER_CORE_LOG_MACROS_H_ 
\ No newline at end of file
+/**
+ * @brief Writes an already formatted message.
+ *
+ * Called by the DBC_LOG_* macros after Logger::ShouldLog(level) succeeded.
+ * Subject to the repeat limit of LoggerOptions.
+ */
+void Write(LogLevel level, std::string_view message);
+
+/**
+ * @brief Formats and writes a message; the formatting is done out of line.
+ */
+void VWrite(LogLevel level, fmt::string_view format, fmt::format_args args);
+
+/**
+ * @brief Formats a message with fmt syntax and writes it.
+ *
+ * The format string is checked at compile time.
+ */
+template <typename... Args>
+void Format(LogLevel level, fmt::format_string<Args...> format, Args&&... args) {
+  VWrite(level, format, fmt::make_format_args(args...));
+}
+
+}  // namespace log
+}  // namespace core
+}  // namespace dbc_parser
+
+// Evaluates the arguments only if the level is enabled at run time
+#define DBC_LOG_AT_(level, ...)                                          \
+  do {                                                                   \
+    if (::dbc_parser::core::Logger::ShouldLog(level)) {                  \
+      ::dbc_parser::core::log::Format(level, __VA_ARGS__);               \
+    }                                                                    \
+  } while (false)
+
+#define DBC_LOG_STR_AT_(level, msg)                                      \
+  do {                                                                   \
+    if (::dbc_parser::core::Logger::ShouldLog(level)) {                  \
+      ::dbc_parser::core::log::Write(level, msg);                        \
+    }                                                                    \
+  } while (false)
+
+// Compiled-out statement: its arguments are neither compiled nor evaluated
+#define DBC_LOG_DISABLED_(...) \
+  do {                         \
+  } while (false)
+
+// fmt-style logging: DBC_LOG_INFO("Parsed {} messages", count)
+// String-only versions for simple messages: DBC_LOG_INFO_STR(msg)
+#if DBC_LOG_ACTIVE_LEVEL <= DBC_LOG_LEVEL_TRACE
+#define DBC_LOG_TRACE(...) DBC_LOG_AT_(::dbc_parser::core::LogLevel::kTrace, __VA_ARGS__)
+#define DBC_LOG_TRACE_STR(msg) DBC_LOG_STR_AT_(::dbc_parser::core::LogLevel::kTrace, msg)
+#else
+#define DBC_LOG_TRACE(...) DBC_LOG_DISABLED_(__VA_ARGS__)
+#define DBC_LOG_TRACE_STR(msg) DBC_LOG_DISABLED_(msg)
+#endif
+
+#if DBC_LOG_ACTIVE_LEVEL <= DBC_LOG_LEVEL_DEBUG
+#define DBC_LOG_DEBUG(...) DBC_LOG_AT_(::dbc_parser::core::LogLevel::kDebug, __VA_ARGS__)
+#define DBC_LOG_DEBUG_STR(msg) DBC_LOG_STR_AT_(::dbc_parser::core::LogLevel::kDebug, msg)
+#else
+#define DBC_LOG_DEBUG(...) DBC_LOG_DISABLED_(__VA_ARGS__)
+#define DBC_LOG_DEBUG_STR(msg) DBC_LOG_DISABLED_(msg)
+#endif
+
+#if DBC_LOG_ACTIVE_LEVEL <= DBC_LOG_LEVEL_INFO
+#define DBC_LOG_INFO(...) DBC_LOG_AT_(::dbc_parser::core::LogLevel::kInfo, __VA_ARGS__)
+#define DBC_LOG_INFO_STR(msg) DBC_LOG_STR_AT_(::dbc_parser::core::LogLevel::kInfo, msg)
+#else
+#define DBC_LOG_INFO(...) DBC_LOG_DISABLED_(__VA_ARGS__)
+#define DBC_LOG_INFO_STR(msg) DBC_LOG_DISABLED_(msg)
+#endif
+
+#if DBC_LOG_ACTIVE_LEVEL <= DBC_LOG_LEVEL_WARN
+#define DBC_LOG_WARN(...) DBC_LOG_AT_(::dbc_parser::core::LogLevel::kWarn, __VA_ARGS__)
+#define DBC_LOG_WARN_STR(msg) DBC_LOG_STR_AT_(::dbc_parser::core::LogLevel::kWarn, msg)
+#else
+#define DBC_LOG_WARN(...) DBC_LOG_DISABLED_(__VA_ARGS__)
+#define DBC_LOG_WARN_STR(msg) DBC_LOG_DISABLED_(msg)
+#endif
+
+#if DBC_LOG_ACTIVE_LEVEL <= DBC_LOG_LEVEL_ERROR
+#define DBC_LOG_ERROR(...) DBC_LOG_AT_(::dbc_parser::core::LogLevel::kError, __VA_ARGS__)
+#define DBC_LOG_ERROR_STR(msg) DBC_LOG_STR_AT_(::dbc_parser::core::LogLevel::kError, msg)
+#else
+#define DBC_LOG_ERROR(...) DBC_LOG_DISABLED_(__VA_ARGS__)
+#define DBC_LOG_ERROR_STR(msg) DBC_LOG_DISABLED_(msg)
+#endif
+
+#if DBC_LOG_ACTIVE_LEVEL <= DBC_LOG_LEVEL_CRITICAL
+#define DBC_LOG_CRITICAL(...) DBC_LOG_AT_(::dbc_parser::core::LogLevel::kCritical, __VA_ARGS__)
+#define DBC_LOG_CRITICAL_STR(msg) DBC_LOG_STR_AT_(::dbc_parser::core::LogLevel::kCritical, msg)
+#else
+#define DBC_LOG_CRITICAL(...) DBC_LOG_DISABLED_(__VA_ARGS__)
+#define DBC_LOG_CRITICAL_STR(msg) DBC_LOG_DISABLED_(msg)
+#endif
+
+#endif  // DBC_PARSER_CORE_LOG_MACROS_H_
@@ -1,65 +1,294 @@
 #include "dbc_parser/core/logger.h"
 
+#include <functional>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "spdlog/spdlog.h"
+#include "spdlog/async.h"
+#include "spdlog/async_logger.h"
+#include "spdlog/sinks/basic_file_sink.h"
+#include "spdlog/sinks/rotating_file_sink.h"
 #include "spdlog/sinks/stdout_color_sinks.h"
 
 namespace dbc_parser {
 namespace core {
 
 std::shared_ptr<spdlog::logger> Logger::logger_ = nullptr;
+std::atomic<int> Logger::level_{static_cast<int>(LogLevel::kOff)};
+std::atomic<int> Logger::repeat_limit_{0};
 
-// Convert string log level to spdlog::level::level_enum
-spdlog::level::level_enum StringToLogLevel(const std::string& level) {
-  if (level == "trace") return spdlog::level::trace;
-  if (level == "debug") return spdlog::level::debug;
-  if (level == "info") return spdlog::level::info;
-  if (level == "warn") return spdlog::level::warn;
-  if (level == "error") return spdlog::level::err;
-  if (level == "critical") return spdlog::level::critical;
-  if (level == "off") return spdlog::level::off;
-  
-  // Default to info level
+namespace {
+
+constexpr const char* kLoggerName = "dbc_parser";
+constexpr const char* kPattern = "[%Y-%m-%d %H:%M:%S.%e] [%n] [%^%l%$] %v";
+
+// Beyond this many distinct patterns the repeat table is reported and cleared
+constexpr std::size_t kMaxRepeatPatterns = 4096;
+
+// Convert LogLevel to spdlog::level::level_enum
+spdlog::level::level_enum ToSpdlogLevel(LogLevel level) {
+  switch (level) {
+    case LogLevel::kTrace: return spdlog::level::trace;
+    case LogLevel::kDebug: return spdlog::level::debug;
+    case LogLevel::kInfo: return spdlog::level::info;
+    case LogLevel::kWarn: return spdlog::level::warn;
+    case LogLevel::kError: return spdlog::level::err;
+    case LogLevel::kCritical: return spdlog::level::critical;
+    case LogLevel::kOff: return spdlog::level::off;
+  }
   return spdlog::level::info;
 }
 
+// Background thread and queue of the async logger. The async logger only
+// holds a weak reference, so the pool is owned here.
+std::shared_ptr<spdlog::details::thread_pool> g_thread_pool;
+
+// Messages of one pattern within the current repeat window
+struct RepeatEntry {
+  std::chrono::steady_clock::time_point window_start;
+  int admitted = 0;
+  std::uint64_t suppressed = 0;
+  LogLevel level = LogLevel::kInfo;
+  std::string pattern;
+};
+
+// A "suppressed N similar messages" line still to be written
+struct SuppressedReport {
+  LogLevel level;
+  std::string text;
+};
+
+struct RepeatTable {
+  std::mutex mutex;
+  std::chrono::milliseconds window{10000};
+  // Keyed by the hash of the pattern; a collision merely merges two patterns
+  std::unordered_map<std::size_t, RepeatEntry> entries;
+};
+
+RepeatTable& Repeats() {
+  static RepeatTable table;
+  return table;
+}
+
+SuppressedReport MakeReport(const RepeatEntry& entry) {
+  return {entry.level, fmt::format("Suppressed {} similar messages: {}", entry.suppressed, entry.pattern)};
+}
+
+// Takes the reports of all entries with suppressed messages and clears the table
+std::vector<SuppressedReport> TakeAllReports(RepeatTable& table) {
+  std::vector<SuppressedReport> reports;
+  for (const auto& [hash, entry] : table.entries) {
+    if (entry.suppressed > 0) {
+      reports.push_back(MakeReport(entry));
+    }
+  }
+  table.entries.clear();
+  return reports;
+}
+
+}  // namespace
+
+LogLevel Logger::ParseLevel(const std::string& level) noexcept {
+  if (level == "trace") return LogLevel::kTrace;
+  if (level == "debug") return LogLevel::kDebug;
+  if (level == "info") return LogLevel::kInfo;
+  if (level == "warn") return LogLevel::kWarn;
+  if (level == "error") return LogLevel::kError;
+  if (level == "critical") return LogLevel::kCritical;
+  if (level == "off") return LogLevel::kOff;
+
+  // Default to info level
+  return LogLevel::kInfo;
+}
+
 bool Logger::Initialize(const std::string& log_level) {
+  LoggerOptions options;
+  options.level = log_level;
+  return Initialize(options);
+}
+
+bool Logger::Initialize(const LoggerOptions& options) {
+  Shutdown();
+
   try {
-    // Create a color console sink
-    auto console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
-    console_sink->set_level(StringToLogLevel(log_level));
-    console_sink->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%n] [%^%l%$] %v");
-    
-    // Create logger with sink
-    logger_ = std::make_shared<spdlog::logger>("dbc_parser", console_sink);
-    logger_->set_level(StringToLogLevel(log_level));
-    
+    const LogLevel level = ParseLevel(options.level);
+
+    std::vector<spdlog::sink_ptr> sinks;
+    if (options.console) {
+      sinks.push_back(std::make_shared<spdlog::sinks::stdout_color_sink_mt>());
+    }
+    if (!options.file_path.empty()) {
+      if (options.max_file_size > 0) {
+        sinks.push_back(std::make_shared<spdlog::sinks::rotating_file_sink_mt>(
+            options.file_path, options.max_file_size, options.max_files));
+      } else {
+        sinks.push_back(std::make_shared<spdlog::sinks::basic_file_sink_mt>(options.file_path));
+      }
+    }
+    for (const auto& sink : sinks) {
+      sink->set_level(ToSpdlogLevel(level));
+      sink->set_pattern(kPattern);
+    }
+
+    std::shared_ptr<spdlog::logger> logger;
+    if (options.async) {
+      auto thread_pool = std::make_shared<spdlog::details::thread_pool>(options.queue_size, 1);
+      std::atomic_store(&g_thread_pool, thread_pool);
+      const auto policy = options.overflow == OverflowPolicy::kBlock
+                              ? spdlog::async_overflow_policy::block
+                              : spdlog::async_overflow_policy::overrun_oldest;
+      logger = std::make_shared<spdlog::async_logger>(kLoggerName, sinks.begin(), sinks.end(),
+                                                      thread_pool, policy);
+    } else {
+      logger = std::make_shared<spdlog::logger>(kLoggerName, sinks.begin(), sinks.end());
+    }
+    logger->set_level(ToSpdlogLevel(level));
+    logger->flush_on(spdlog::level::err);
+
     // Register logger
-    spdlog::register_logger(logger_);
-    
+    spdlog::register_logger(logger);
+    if (options.flush_interval.count() > 0) {
+      spdlog::flush_every(options.flush_interval);
+    }
+
+    {
+      RepeatTable& repeats = Repeats();
+      std::lock_guard<std::mutex> lock(repeats.mutex);
+      repeats.window = options.repeat_window;
+      repeats.entries.clear();
+    }
+    repeat_limit_.store(options.repeat_limit, std::memory_order_relaxed);
+
+    std::atomic_store(&logger_, logger);
+    level_.store(static_cast<int>(level), std::memory_order_relaxed);
+
     // Log initialization
-    logger_->info("Logger initialized with level: {}", log_level);
-    
+    logger->info("Logger initialized with level: {}{}", options.level, options.async ? " (async)" : "");
+
     return true;
   } catch (const spdlog::spdlog_ex& ex) {
     std::cerr << "Logger initialization failed: " << ex.what() << std::endl;
+    Shutdown();
     return false;
   }
 }
 
 void Logger::Shutdown() {
-  if (logger_) {
-    logger_->flush();
+  level_.store(static_cast<int>(LogLevel::kOff), std::memory_order_relaxed);
+  repeat_limit_.store(0, std::memory_order_relaxed);
+
+  // Report what the repeat limit held back before the sinks go away
+  std::vector<SuppressedReport> reports;
+  {
+    RepeatTable& repeats = Repeats();
+    std::lock_guard<std::mutex> lock(repeats.mutex);
+    reports = TakeAllReports(repeats);
+  }
+  for (const SuppressedReport& report : reports) {
+    Write(report.level, report.text);
+  }
+
+  std::shared_ptr<spdlog::logger> logger = std::atomic_exchange(&logger_, std::shared_ptr<spdlog::logger>());
+  if (logger) {
+    // The flush below goes through the queue with the logger's overflow
+    // policy; on a full drop-oldest queue it would overwrite the newest
+    // pending message, so let the worker drain the queue first
+    if (std::shared_ptr<spdlog::details::thread_pool> thread_pool = std::atomic_load(&g_thread_pool)) {
+      while (thread_pool->queue_size() > 0) {
+        std::this_thread::yield();
+      }
+    }
+    logger->flush();
     spdlog::shutdown();
-    logger_ = nullptr;
+    logger.reset();
   }
+  // Destroying the pool drains the queue and joins the background thread
+  std::shared_ptr<spdlog::details::thread_pool> thread_pool =
+      std::atomic_exchange(&g_thread_pool, std::shared_ptr<spdlog::details::thread_pool>());
+  thread_pool.reset();
 }
 
 std::shared_ptr<spdlog::logger> Logger::GetLogger() {
-  return logger_;
+  return std::atomic_load(&logger_);
+}
+
+void Logger::Write(LogLevel level, std::string_view message) {
+  // Copy the pointer so that a concurrent Shutdown() cannot free the logger
+  std::shared_ptr<spdlog::logger> logger = std::atomic_load(&logger_);
+  if (logger) {
+    logger->log(ToSpdlogLevel(level), "{}", message);
+  }
+}
+
+bool Logger::AdmitRepeated(LogLevel level, std::string_view pattern) {
+  const int limit = repeat_limit_.load(std::memory_order_relaxed);
+  if (limit <= 0) {
+    return true;
+  }
+
+  std::vector<SuppressedReport> reports;
+  bool admit = false;
+  {
+    RepeatTable& repeats = Repeats();
+    std::lock_guard<std::mutex> lock(repeats.mutex);
+    const auto now = std::chrono::steady_clock::now();
+    const std::size_t key = std::hash<std::string_view>{}(pattern);
+
+    if (repeats.entries.size() >= kMaxRepeatPatterns && repeats.entries.count(key) == 0) {
+      reports = TakeAllReports(repeats);
+    }
+    auto [it, inserted] = repeats.entries.try_emplace(key);
+    RepeatEntry& entry = it->second;
+    if (inserted) {
+      entry.window_start = now;
+      entry.level = level;
+      entry.pattern = std::string(pattern);
+    } else if (now - entry.window_start >= repeats.window) {
+      if (entry.suppressed > 0) {
+        reports.push_back(MakeReport(entry));
+      }
+      entry.window_start = now;
+      entry.admitted = 0;
+      entry.suppressed = 0;
+    }
+
+    if (entry.admitted < limit) {
+      ++entry.admitted;
+      admit = true;
+    } else {
+      ++entry.suppressed;
+    }
+  }
+
+  for (const SuppressedReport& report : reports) {
+    Write(report.level, report.text);
+  }
+  return admit;
+}
+
+std::uint64_t Logger::DroppedMessages() {
+  // Copy the pointer so that a concurrent Shutdown() cannot free the pool
+  std::shared_ptr<spdlog::details::thread_pool> thread_pool = std::atomic_load(&g_thread_pool);
+  return thread_pool ? static_cast<std::uint64_t>(thread_pool->overrun_counter()) : 0;
+}
+
+void Logger::SetLevel(LogLevel level) {
+  std::shared_ptr<spdlog::logger> logger = std::atomic_load(&logger_);
+  if (!logger) {
+    return;
+  }
+  for (const auto& sink : logger->sinks()) {
+    sink->set_level(ToSpdlogLevel(level));
+  }
+  logger->set_level(ToSpdlogLevel(level));
+  level_.store(static_cast<int>(level), std::memory_order_relaxed);
 }
 
 }  // namespace core
-}  // namespace dbc_parser 
\ No newline at end of file
+}  // namespace dbc_parser
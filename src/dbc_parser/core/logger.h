@@ -1,8 +1,13 @@
 #ifndef DBC_PARSER_CORE_LOGGER_H_
 #define DBC_PARSER_CORE_LOGGER_H_
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <string_view>
 
 // Forward declare spdlog classes to avoid inclusion in header
 namespace spdlog {
@@ -12,44 +17,176 @@ class logger;
 namespace dbc_parser {
 namespace core {
 
+/**
+ * @brief Severity of a log message, in increasing order.
+ *
+ * The values match the DBC_LOG_LEVEL_* constants in log_macros.h.
+ */
+enum class LogLevel : int {
+  kTrace = 0,
+  kDebug = 1,
+  kInfo = 2,
+  kWarn = 3,
+  kError = 4,
+  kCritical = 5,
+  kOff = 6,
+};
+
+/**
+ * @brief What an asynchronous logger does when its queue is full.
+ */
+enum class OverflowPolicy {
+  kDropOldest,  ///< Overwrite the oldest queued message; logging never blocks
+  kBlock,       ///< Wait for the background thread to make room
+};
+
+/**
+ * @brief Configuration for Logger::Initialize.
+ *
+ * The defaults give the synchronous console logger that
+ * Logger::Initialize(level) sets up.
+ */
+struct LoggerOptions {
+  std::string level = "info";       ///< Minimum level ("trace" ... "critical", "off")
+  bool console = true;              ///< Write to stdout
+  std::string file_path;            ///< Also write to this file if not empty
+  std::size_t max_file_size = 0;    ///< Rotate the file at this size; 0 never rotates
+  std::size_t max_files = 3;        ///< Rotated files kept besides the current one
+
+  bool async = false;               ///< Format and write on a background thread
+  std::size_t queue_size = 8192;    ///< Messages the async queue holds
+  OverflowPolicy overflow = OverflowPolicy::kDropOldest;  ///< Full-queue behaviour
+  std::chrono::seconds flush_interval{1};  ///< Background flush period; 0 disables it
+
+  /// Messages per repeat_window with the same format string; more are counted
+  /// and reported as one "Suppressed N similar messages" line when the next
+  /// window starts or at Shutdown(). 0 disables the limit.
+  int repeat_limit = 0;
+  std::chrono::milliseconds repeat_window{10000};  ///< Window for repeat_limit
+};
+
 /**
  * @brief Logger class providing centralized logging functionality for the DBC parser.
  *
  * This class provides a thin wrapper around spdlog to standardize logging
  * throughout the DBC parser codebase.
+ *
+ * The library never initializes the logger itself: until the application
+ * calls Initialize(), every log statement is dropped after a single relaxed
+ * atomic load, without formatting its message.
+ *
+ * Services that parse untrusted vendor files should use an asynchronous
+ * logger with a repeat limit (see LoggerOptions), so that a file with
+ * thousands of malformed lines neither blocks the parse on console writes
+ * nor floods the log.
  */
 class Logger {
  public:
   /**
    * @brief Initializes the logger system.
-   * 
+   *
    * Must be called before any logging operations to configure the logging system.
    * Sets up console logging with the specified log level.
    *
-   * @param log_level Minimum log level for output ("trace", "debug", "info", "warn", "error", "critical")
+   * @param log_level Minimum log level for output ("trace", "debug", "info", "warn", "error", "critical", "off")
    * @return true if initialization successful, false otherwise
    */
   static bool Initialize(const std::string& log_level = "info");
 
+  /**
+   * @brief Initializes the logger system with console, file and async options.
+   *
+   * Replaces a logger set up by an earlier call.
+   *
+   * @param options Sinks, queueing and rate limiting
+   * @return true if initialization successful, false otherwise
+   */
+  static bool Initialize(const LoggerOptions& options);
+
   /**
    * @brief Shuts down the logging system.
-   * 
-   * Flushes all pending logs and cleans up resources.
+   *
+   * Reports pending suppressed-message counts, drains the async queue,
+   * flushes all pending logs and cleans up resources. Later log statements
+   * are dropped until the next Initialize().
    */
   static void Shutdown();
 
   /**
    * @brief Gets the underlying spdlog logger.
-   * 
-   * @return The spdlog logger instance
+   *
+   * @return The spdlog logger instance, or nullptr before Initialize()
    */
   static std::shared_ptr<spdlog::logger> GetLogger();
 
+  /**
+   * @brief Changes the runtime log level of an initialized logger.
+   *
+   * @param level Minimum level that is written
+   */
+  static void SetLevel(LogLevel level);
+
+  /**
+   * @brief Writes a message through the installed logger, if any.
+   *
+   * Prefer the DBC_LOG_* macros, which skip disabled levels before building
+   * the message.
+   *
+   * @param level Level of the message
+   * @param message Formatted message
+   */
+  static void Write(LogLevel level, std::string_view message);
+
+  /**
+   * @brief Applies the repeat limit to a message about to be logged.
+   *
+   * Messages count as similar if their format string (or, for plain string
+   * messages, their text) is equal. Called by the DBC_LOG_* macros before
+   * formatting, so suppressed messages are never formatted.
+   *
+   * @param level Level of the message
+   * @param pattern Format string or message text
+   * @return true if the message should be written
+   */
+  [[nodiscard]] static bool AdmitRepeated(LogLevel level, std::string_view pattern);
+
+  /**
+   * @brief Number of queued messages the async logger overwrote because its
+   * queue was full (OverflowPolicy::kDropOldest).
+   */
+  [[nodiscard]] static std::uint64_t DroppedMessages();
+
+  /**
+   * @brief Returns whether a message of the given level would be written.
+   *
+   * This is the check the DBC_LOG_* macros make before formatting anything.
+   *
+   * @param level Level of the message
+   * @return true if the logger is initialized and level is enabled
+   */
+  [[nodiscard]] static bool ShouldLog(LogLevel level) noexcept {
+    return static_cast<int>(level) >= level_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Converts a level name such as "debug" to a LogLevel.
+   *
+   * @param log_level Level name; unknown names map to LogLevel::kInfo
+   * @return LogLevel The level
+   */
+  [[nodiscard]] static LogLevel ParseLevel(const std::string& log_level) noexcept;
+
  private:
   static std::shared_ptr<spdlog::logger> logger_;
+
+  // Minimum enabled level as an int; kOff while no logger is installed
+  static std::atomic<int> level_;
+
+  // LoggerOptions::repeat_limit of the installed logger; 0 when disabled
+  static std::atomic<int> repeat_limit_;
 };
 
 }  // namespace core
 }  // namespace dbc_parser
 
-#endif  // DBC_PARSER_CORE_LOGGER_H_ 
\ No newline at end of file
+#endif  // DBC_PARSER_CORE_LOGGER_H_
@@ -1,6 +1,5 @@
 #include <iostream>
 #include <string>
-#include <sstream>
 
 #include "dbc_parser/core/logger.h"
 #include "dbc_parser/core/log_macros.h"
@@ -8,27 +7,19 @@
 using dbc_parser::core::Logger;
 
 void demonstrate_logging() {
-  // Create formatted strings manually for now
-  std::stringstream trace_msg;
-  trace_msg << "This is a trace message with a parameter: " << 42;
-  DBC_LOG_TRACE_STR(trace_msg.str());
-  
-  std::stringstream debug_msg;
-  debug_msg << "This is a debug message with multiple parameters: string and " << 3.14;
-  DBC_LOG_DEBUG_STR(debug_msg.str());
+  // Arguments are only evaluated and formatted if the level is enabled
+  DBC_LOG_TRACE("This is a trace message with a parameter: {}", 42);
+  DBC_LOG_DEBUG("This is a debug message with multiple parameters: {} and {}", "string", 3.14);
   
   DBC_LOG_INFO_STR("This is an info message");
   DBC_LOG_WARN_STR("This is a warning message");
   
-  std::stringstream error_msg;
-  error_msg << "This is an error message about file: missing.dbc";
-  DBC_LOG_ERROR_STR(error_msg.str());
-  
-  std::stringstream critical_msg;
-  critical_msg << "This is a critical message about error: Out of memory";
-  DBC_LOG_CRITICAL_STR(critical_msg.str());
+  DBC_LOG_ERROR("This is an error message about file: {}", "missing.dbc");
+  DBC_LOG_CRITICAL("This is a critical message about error: {}", "Out of memory");
 }
 
+// Trace and debug output also needs a build with
+//   --copt=-DDBC_LOG_ACTIVE_LEVEL=DBC_LOG_LEVEL_TRACE
 int main(int argc, char* argv[]) {
   std::string log_level = "debug";
   
@@ -58,4 +49,4 @@ int main(int argc, char* argv[]) {
   Logger::Shutdown();
   
   return 0;
-} 
\ No newline at end of file
+}
@@ -0,0 +1,61 @@
+#ifndef DBC_PARSER_CORE_MAPPED_FILE_H_
+#define DBC_PARSER_CORE_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace dbc_parser {
+namespace core {
+
+/**
+ * @brief A whole file mapped read-only into memory.
+ *
+ * Log files of many gigabytes are read through the page cache instead of
+ * being copied into a string; readers hand out string_views into the mapping.
+ * Move-only; the mapping is released by the destructor, which invalidates all
+ * views into it.
+ */
+class MappedFile {
+ public:
+  /**
+   * @brief Maps a file.
+   *
+   * @param path File to map
+   * @return std::optional<MappedFile> The mapping, or std::nullopt if the file
+   *         cannot be opened or mapped. An empty file maps to empty contents.
+   */
+  [[nodiscard]] static std::optional<MappedFile> Open(const std::string& path);
+
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+
+  /**
+   * @brief The file's bytes.
+   */
+  [[nodiscard]] std::string_view contents() const noexcept {
+    return std::string_view(static_cast<const char*>(data_), size_);
+  }
+
+  /**
+   * @brief Tells the kernel that the mapping will be read front to back, so
+   *        it reads ahead aggressively.
+   */
+  void AdviseSequential() const noexcept;
+
+ private:
+  MappedFile(void* data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+  void* data_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+}  // namespace core
+}  // namespace dbc_parser
+
+#endif  // DBC_PARSER_CORE_MAPPED_FILE_H_
@@ -4,21 +4,83 @@
 #include <cctype>
 #include <charconv>
 #include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace dbc_parser {
 namespace core {
 
+namespace {
+
+// Validates one multi-byte UTF-8 sequence starting at bytes[i] (bytes[i] >= 0x80).
+// Returns the sequence length, or 0 if the sequence is invalid.
+size_t ValidateUtf8Sequence(const unsigned char* bytes, size_t i, size_t length) {
+  int num_bytes;
+  unsigned char first_byte_mask;
+  unsigned int min_value;
+
+  if ((bytes[i] & 0xE0) == 0xC0) {
+    num_bytes = 2;
+    first_byte_mask = 0x1F;
+    min_value = 0x80;  // Minimum value for 2-byte sequence
+  } else if ((bytes[i] & 0xF0) == 0xE0) {
+    num_bytes = 3;
+    first_byte_mask = 0x0F;
+    min_value = 0x800;  // Minimum value for 3-byte sequence
+  } else if ((bytes[i] & 0xF8) == 0xF0) {
+    num_bytes = 4;
+    first_byte_mask = 0x07;
+    min_value = 0x10000;  // Minimum value for 4-byte sequence
+  } else {
+    return 0;  // Invalid first byte
+  }
+
+  // Check if we have enough bytes
+  if (i + num_bytes > length) {
+    return 0;
+  }
+
+  // Calculate the value to check for overlong encoding
+  unsigned int value = bytes[i] & first_byte_mask;
+
+  // Check continuation bytes
+  for (int j = 1; j < num_bytes; ++j) {
+    if ((bytes[i + j] & 0xC0) != 0x80) {
+      return 0;  // Not a continuation byte
+    }
+    value = (value << 6) | (bytes[i + j] & 0x3F);
+  }
+
+  // Reject overlong encodings, UTF-16 surrogate halves and values past U+10FFFF
+  if (value < min_value || (value >= 0xD800 && value <= 0xDFFF) || value > 0x10FFFF) {
+    return 0;
+  }
+
+  return static_cast<size_t>(num_bytes);
+}
+
+}  // namespace
+
 std::string StringUtils::Trim(std::string_view str) {
+  return std::string(TrimView(str));
+}
+
+std::string_view StringUtils::TrimView(std::string_view str) noexcept {
   auto start = str.find_first_not_of(" \t\r\n");
   if (start == std::string_view::npos) {
-    return "";
+    return std::string_view();
   }
   auto end = str.find_last_not_of(" \t\r\n");
-  return std::string(str.substr(start, end - start + 1));
+  return str.substr(start, end - start + 1);
 }
 
 std::vector<std::string> StringUtils::Split(std::string_view str, char delimiter) {
@@ -36,6 +98,14 @@ std::vector<std::string> StringUtils::Split(std::string_view str, char delimiter
   return result;
 }
 
+std::vector<std::string_view> StringUtils::SplitView(std::string_view str, char delimiter) {
+  std::vector<std::string_view> result;
+  for (std::string_view token : SplitLazy(str, delimiter)) {
+    result.push_back(token);
+  }
+  return result;
+}
+
 std::vector<std::string> StringUtils::SplitByAny(std::string_view str, 
                                                 std::string_view delimiters) {
   std::vector<std::string> result;
@@ -56,75 +126,105 @@ std::vector<std::string> StringUtils::SplitByAny(std::string_view str,
   return result;
 }
 
-bool StringUtils::IsValidUtf8(std::string_view str) {
-  const unsigned char* bytes = reinterpret_cast<const unsigned char*>(str.data());
-  size_t length = str.length();
-  
-  for (size_t i = 0; i < length;) {
-    if (bytes[i] <= 0x7F) {
-      // Single byte character (ASCII)
-      ++i;
-      continue;
-    }
-    
-    // Multi-byte character
-    int num_bytes;
-    unsigned char first_byte_mask;
-    unsigned int min_value;
-    
-    if ((bytes[i] & 0xE0) == 0xC0) {
-      num_bytes = 2;
-      first_byte_mask = 0x1F;
-      min_value = 0x80;  // Minimum value for 2-byte sequence
-    } else if ((bytes[i] & 0xF0) == 0xE0) {
-      num_bytes = 3;
-      first_byte_mask = 0x0F;
-      min_value = 0x800;  // Minimum value for 3-byte sequence
-    } else if ((bytes[i] & 0xF8) == 0xF0) {
-      num_bytes = 4;
-      first_byte_mask = 0x07;
-      min_value = 0x10000;  // Minimum value for 4-byte sequence
-    } else {
-      return false;  // Invalid first byte
-    }
-    
-    // Check if we have enough bytes
-    if (i + num_bytes > length) {
-      return false;
+std::vector<std::string_view> StringUtils::SplitViewByAny(std::string_view str,
+                                                          std::string_view delimiters) {
+  std::vector<std::string_view> result;
+  size_t start = 0;
+  size_t end = str.find_first_of(delimiters);
+
+  while (end != std::string_view::npos) {
+    if (end > start) {  // Skip empty parts
+      result.push_back(str.substr(start, end - start));
     }
-    
-    // Calculate the value to check for overlong encoding
-    unsigned int value = bytes[i] & first_byte_mask;
-    
-    // Check continuation bytes
-    for (int j = 1; j < num_bytes; ++j) {
-      if ((bytes[i + j] & 0xC0) != 0x80) {
-        return false;  // Not a continuation byte
-      }
-      value = (value << 6) | (bytes[i + j] & 0x3F);
+    start = end + 1;
+    end = str.find_first_of(delimiters, start);
+  }
+
+  if (start < str.length()) {
+    result.push_back(str.substr(start));
+  }
+  return result;
+}
+
+size_t StringUtils::AsciiPrefixLength(std::string_view str) noexcept {
+  const unsigned char* bytes = reinterpret_cast<const unsigned char*>(str.data());
+  const size_t length = str.length();
+  size_t i = 0;
+
+#if defined(__SSE2__)
+  // 16 bytes per step: movemask collects the high bit of every byte.
+  for (; i + 16 <= length; i += 16) {
+    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i));
+    const int mask = _mm_movemask_epi8(chunk);
+    if (mask != 0) {
+      return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
     }
-    
-    // Check for overlong encoding
-    if (value < min_value) {
-      return false;
+  }
+#endif
+
+  // 8 bytes per step on targets without SSE2, and for the SSE2 tail.
+  constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+  for (; i + 8 <= length; i += 8) {
+    uint64_t word;
+    std::memcpy(&word, bytes + i, sizeof(word));
+    if ((word & kHighBits) != 0) {
+      break;
     }
-    
-    // Check for UTF-16 surrogate halves
-    if (value >= 0xD800 && value <= 0xDFFF) {
-      return false;
+  }
+
+  while (i < length && bytes[i] <= 0x7F) {
+    ++i;
+  }
+  return i;
+}
+
+bool StringUtils::IsValidUtf8(std::string_view str) {
+  const unsigned char* bytes = reinterpret_cast<const unsigned char*>(str.data());
+  const size_t length = str.length();
+
+  size_t i = 0;
+  while (i < length) {
+    // Skip the ASCII run in bulk, then decode the multi-byte sequence after it
+    i += AsciiPrefixLength(str.substr(i));
+    if (i >= length) {
+      break;
     }
-    
-    // Check for maximum value
-    if (value > 0x10FFFF) {
+    const size_t sequence_length = ValidateUtf8Sequence(bytes, i, length);
+    if (sequence_length == 0) {
       return false;
     }
-    
-    i += num_bytes;
+    i += sequence_length;
   }
-  
+
   return true;
 }
 
+std::string StringUtils::Latin1ToUtf8(std::string_view str) {
+  std::string result;
+  result.reserve(str.size() + str.size() / 8);
+
+  size_t i = 0;
+  while (i < str.size()) {
+    const size_t ascii = AsciiPrefixLength(str.substr(i));
+    result.append(str.data() + i, ascii);
+    i += ascii;
+    // Every Latin-1 code point >= 0x80 maps to a 2-byte UTF-8 sequence
+    for (; i < str.size() && static_cast<unsigned char>(str[i]) > 0x7F; ++i) {
+      const unsigned char c = static_cast<unsigned char>(str[i]);
+      result.push_back(static_cast<char>(0xC0 | (c >> 6)));
+      result.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+    }
+  }
+  return result;
+}
+
+std::string StringUtils::ToUtf8(std::string str) {
+  if (IsValidUtf8(str)) {
+    return str;
+  }
+  return Latin1ToUtf8(str);
+}
+
 std::string StringUtils::ToUpper(std::string_view str) {
   std::string result(str);
   std::transform(result.begin(), result.end(), result.begin(),
@@ -141,7 +241,7 @@ std::string StringUtils::ToLower(std::string_view str) {
 
 std::optional<std::string> StringUtils::ExtractQuoted(std::string_view str) {
   // Trim whitespace and check for basic quote structure
-  str = Trim(str);
+  str = TrimView(str);
   if (str.size() < 2 || str.front() != '"' || str.back() != '"') {
     return std::nullopt;
   }
@@ -179,7 +279,7 @@ std::optional<std::string> StringUtils::ExtractQuoted(std::string_view str) {
 }
 
 std::optional<int64_t> StringUtils::ParseInt(std::string_view str) {
-  str = Trim(str);
+  str = TrimView(str);
   if (str.empty()) {
     return std::nullopt;
   }
@@ -194,15 +294,28 @@ std::optional<int64_t> StringUtils::ParseInt(std::string_view str) {
 }
 
 std::optional<double> StringUtils::ParseDouble(std::string_view str) {
-  str = Trim(str);
+  str = TrimView(str);
   if (str.empty()) {
     return std::nullopt;
   }
 
+  // strtod needs a terminated buffer; a view may run into adjacent text
+  char buffer[64];
+  std::string heap_buffer;
+  const char* terminated;
+  if (str.size() < sizeof(buffer)) {
+    std::memcpy(buffer, str.data(), str.size());
+    buffer[str.size()] = '\0';
+    terminated = buffer;
+  } else {
+    heap_buffer.assign(str);
+    terminated = heap_buffer.c_str();
+  }
+
   char* end;
-  double result = std::strtod(str.data(), &end);
+  double result = std::strtod(terminated, &end);
   
-  if (end == str.data() + str.length() && !std::isnan(result) && !std::isinf(result)) {
+  if (end == terminated + str.length() && !std::isnan(result) && !std::isinf(result)) {
     return result;
   }
   return std::nullopt;
@@ -219,7 +332,7 @@ bool StringUtils::EndsWith(std::string_view str, std::string_view suffix) {
 }
 
 std::string StringUtils::StripQuotes(std::string_view str) {
-  str = Trim(str);
+  str = TrimView(str);
   if (str.length() >= 2 && str.front() == '"' && str.back() == '"') {
     // Check if the last quote is escaped
     bool is_escaped = false;
@@ -1,6 +1,9 @@
 #ifndef DBC_PARSER_CORE_STRING_UTILS_H_
 #define DBC_PARSER_CORE_STRING_UTILS_H_
 
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -9,6 +12,98 @@
 namespace dbc_parser {
 namespace core {
 
+/**
+ * @brief Lazy, non-allocating range over the tokens of a delimited string.
+ *
+ * Yields std::string_view tokens that point into the original input, so the
+ * input must outlive the range. Semantics match StringUtils::Split: adjacent
+ * delimiters produce empty tokens and an empty input yields one empty token.
+ *
+ * Example:
+ * @code
+ * for (std::string_view token : StringUtils::SplitLazy("a,b,c", ',')) { ... }
+ * @endcode
+ */
+class SplitRange {
+ public:
+  /**
+   * @brief Forward iterator producing one token per step.
+   */
+  class iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::string_view;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const std::string_view*;
+    using reference = const std::string_view&;
+
+    iterator() noexcept = default;
+
+    reference operator*() const noexcept { return token_; }
+    pointer operator->() const noexcept { return &token_; }
+
+    iterator& operator++() noexcept {
+      if (next_ == std::string_view::npos) {
+        done_ = true;
+      } else {
+        Advance(next_);
+      }
+      return *this;
+    }
+
+    iterator operator++(int) noexcept {
+      iterator copy = *this;
+      ++*this;
+      return copy;
+    }
+
+    friend bool operator==(const iterator& a, const iterator& b) noexcept {
+      if (a.done_ || b.done_) {
+        return a.done_ == b.done_;
+      }
+      return a.token_.data() == b.token_.data();
+    }
+    friend bool operator!=(const iterator& a, const iterator& b) noexcept { return !(a == b); }
+
+   private:
+    friend class SplitRange;
+
+    iterator(std::string_view str, char delimiter) noexcept : str_(str), delimiter_(delimiter) {
+      Advance(0);
+    }
+
+    void Advance(size_t start) noexcept {
+      const size_t end = str_.find(delimiter_, start);
+      if (end == std::string_view::npos) {
+        token_ = str_.substr(start);
+        next_ = std::string_view::npos;
+      } else {
+        token_ = str_.substr(start, end - start);
+        next_ = end + 1;
+      }
+    }
+
+    std::string_view str_;
+    std::string_view token_;
+    size_t next_ = std::string_view::npos;
+    char delimiter_ = '\0';
+    bool done_ = true;
+  };
+
+  SplitRange(std::string_view str, char delimiter) noexcept : str_(str), delimiter_(delimiter) {}
+
+  [[nodiscard]] iterator begin() const noexcept {
+    iterator it(str_, delimiter_);
+    it.done_ = false;
+    return it;
+  }
+  [[nodiscard]] iterator end() const noexcept { return iterator(); }
+
+ private:
+  std::string_view str_;
+  char delimiter_;
+};
+
 /**
  * @brief Utility class for string manipulation operations.
  *
@@ -26,6 +121,14 @@ class StringUtils {
    */
   [[nodiscard]] static std::string Trim(std::string_view str);
 
+  /**
+   * @brief Trims whitespace from both ends without copying.
+   *
+   * @param str The input string to trim
+   * @return std::string_view A view into @p str with leading and trailing whitespace removed
+   */
+  [[nodiscard]] static std::string_view TrimView(std::string_view str) noexcept;
+
   /**
    * @brief Splits a string by the given delimiter character.
    *
@@ -35,6 +138,26 @@ class StringUtils {
    */
   [[nodiscard]] static std::vector<std::string> Split(std::string_view str, char delimiter);
 
+  /**
+   * @brief Splits a string by the given delimiter character without copying tokens.
+   *
+   * @param str The input string to split (must outlive the returned views)
+   * @param delimiter The character to split on
+   * @return std::vector<std::string_view> Views into @p str, one per token
+   */
+  [[nodiscard]] static std::vector<std::string_view> SplitView(std::string_view str, char delimiter);
+
+  /**
+   * @brief Returns a lazy range over the tokens of a string; performs no allocation.
+   *
+   * @param str The input string to split (must outlive the range)
+   * @param delimiter The character to split on
+   * @return SplitRange A range yielding std::string_view tokens
+   */
+  [[nodiscard]] static SplitRange SplitLazy(std::string_view str, char delimiter) noexcept {
+    return SplitRange(str, delimiter);
+  }
+
   /**
    * @brief Splits a string by any of the provided delimiter characters.
    *
@@ -44,14 +167,57 @@ class StringUtils {
    */
   [[nodiscard]] static std::vector<std::string> SplitByAny(std::string_view str, std::string_view delimiters);
 
+  /**
+   * @brief Splits a string by any of the delimiter characters without copying tokens.
+   *
+   * Empty tokens are skipped, as in SplitByAny.
+   *
+   * @param str The input string to split (must outlive the returned views)
+   * @param delimiters String containing all possible delimiter characters
+   * @return std::vector<std::string_view> Views into @p str, one per non-empty token
+   */
+  [[nodiscard]] static std::vector<std::string_view> SplitViewByAny(std::string_view str,
+                                                                    std::string_view delimiters);
+
   /**
    * @brief Checks if a string contains valid UTF-8 characters.
    *
+   * Pure-ASCII runs are skipped a block at a time (SSE2 where available,
+   * otherwise 8-byte words); only non-ASCII sequences are decoded bytewise.
+   *
    * @param str The input string to validate
    * @return bool True if the string is valid UTF-8, false otherwise
    */
   [[nodiscard]] static bool IsValidUtf8(std::string_view str);
 
+  /**
+   * @brief Returns the length of the leading pure-ASCII prefix of a string.
+   *
+   * @param str The input string to scan
+   * @return size_t Index of the first byte >= 0x80, or str.size() if there is none
+   */
+  [[nodiscard]] static size_t AsciiPrefixLength(std::string_view str) noexcept;
+
+  /**
+   * @brief Transcodes ISO-8859-1 (Latin-1) text to UTF-8.
+   *
+   * @param str The Latin-1 encoded input
+   * @return std::string The UTF-8 encoded equivalent
+   */
+  [[nodiscard]] static std::string Latin1ToUtf8(std::string_view str);
+
+  /**
+   * @brief Returns the input as UTF-8, transcoding from Latin-1 only if it is not valid UTF-8.
+   *
+   * Vendor DBC files are mostly ASCII with occasional Latin-1 comments; this is the
+   * normalization step applied to CM_, VAL_ and VAL_TABLE_ text before it is stored.
+   * Takes the string by value so valid input is moved through without a copy.
+   *
+   * @param str The input text
+   * @return std::string The input unchanged if valid UTF-8, otherwise its Latin-1 transcoding
+   */
+  [[nodiscard]] static std::string ToUtf8(std::string str);
+
   /**
    * @brief Converts a string to uppercase.
    *
@@ -0,0 +1,273 @@
+#include "dbc_parser/core/trace.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace dbc_parser {
+namespace core {
+
+std::atomic<bool> Tracer::enabled_{false};
+
+namespace {
+
+struct TraceEvent {
+  const char* category;
+  const char* name;
+  char phase;                // 'X' span, 'C' counter
+  std::uint64_t start_ns;
+  std::uint64_t duration_ns;
+  std::int64_t count;        // Spans: items covered, -1 for none
+  double value;              // Counters: the value
+};
+
+// Written only by its own thread; read by the dumping thread up to `size`
+struct ThreadBuffer {
+  ThreadBuffer(std::size_t capacity, std::uint32_t thread_id)
+      : events(new TraceEvent[capacity]), capacity(capacity), thread_id(thread_id) {}
+
+  std::unique_ptr<TraceEvent[]> events;
+  const std::size_t capacity;
+  const std::uint32_t thread_id;
+  std::atomic<std::size_t> size{0};
+  std::atomic<std::uint64_t> dropped{0};
+};
+
+struct Registry {
+  std::mutex mutex;
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  // Buffers of exited threads, handed to the next threads that register, so
+  // that short-lived workers do not add a buffer each
+  std::vector<std::shared_ptr<ThreadBuffer>> free_buffers;
+  std::size_t capacity = Tracer::kDefaultEventsPerThread;
+  std::uint32_t next_thread_id = 1;
+  // Bumped by Enable() and Clear(); threads holding an older buffer register a new one
+  std::atomic<std::uint64_t> generation{1};
+};
+
+Registry& GetRegistry() {
+  static Registry registry;
+  return registry;
+}
+
+struct ThreadSlot {
+  ThreadSlot() = default;
+  ThreadSlot(const ThreadSlot&) = delete;
+  ThreadSlot& operator=(const ThreadSlot&) = delete;
+
+  // Returns the buffer to the registry when the thread exits, unless Enable()
+  // or Clear() discarded it in the meantime
+  ~ThreadSlot() {
+    if (buffer == nullptr) {
+      return;
+    }
+    Registry& registry = GetRegistry();
+    try {
+      std::lock_guard<std::mutex> lock(registry.mutex);
+      if (generation == registry.generation.load(std::memory_order_relaxed)) {
+        registry.free_buffers.push_back(std::move(buffer));
+      }
+    } catch (...) {
+    }
+  }
+
+  std::uint64_t generation = 0;
+  std::shared_ptr<ThreadBuffer> buffer;
+};
+
+thread_local ThreadSlot t_slot;
+
+// Returns this thread's buffer, registering one on first use in a generation.
+// A thread that takes over the buffer of an exited one continues its track.
+ThreadBuffer* CurrentBuffer() noexcept {
+  Registry& registry = GetRegistry();
+  const std::uint64_t generation = registry.generation.load(std::memory_order_acquire);
+  if (t_slot.generation != generation) {
+    try {
+      std::lock_guard<std::mutex> lock(registry.mutex);
+      if (!registry.free_buffers.empty()) {
+        t_slot.buffer = std::move(registry.free_buffers.back());
+        registry.free_buffers.pop_back();
+      } else {
+        auto buffer = std::make_shared<ThreadBuffer>(registry.capacity, registry.next_thread_id++);
+        registry.buffers.push_back(buffer);
+        t_slot.buffer = std::move(buffer);
+      }
+      t_slot.generation = registry.generation.load(std::memory_order_relaxed);
+    } catch (...) {
+      return nullptr;
+    }
+  }
+  return t_slot.buffer.get();
+}
+
+void Append(const TraceEvent& event) noexcept {
+  ThreadBuffer* buffer = CurrentBuffer();
+  if (buffer == nullptr) {
+    return;
+  }
+  const std::size_t size = buffer->size.load(std::memory_order_relaxed);
+  if (size >= buffer->capacity) {
+    buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  buffer->events[size] = event;
+  buffer->size.store(size + 1, std::memory_order_release);
+}
+
+// Names are expected to be plain identifiers, but never emit broken JSON
+void AppendJsonString(std::string& out, const char* text) {
+  out += '"';
+  for (const char* p = text; *p != '\0'; ++p) {
+    const char c = *p;
+    if (c == '"' || c == '\\') {
+      out += '\\';
+      out += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char escaped[8];
+      std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+      out += escaped;
+    } else {
+      out += c;
+    }
+  }
+  out += '"';
+}
+
+// Chrome trace timestamps are microseconds
+void AppendMicroseconds(std::string& out, std::uint64_t ns) {
+  char text[32];
+  std::snprintf(text, sizeof(text), "%llu.%03llu", static_cast<unsigned long long>(ns / 1000),
+                static_cast<unsigned long long>(ns % 1000));
+  out += text;
+}
+
+void AppendEvent(std::string& out, const TraceEvent& event, std::uint32_t thread_id) {
+  out += "{\"name\":";
+  AppendJsonString(out, event.name);
+  out += ",\"cat\":";
+  AppendJsonString(out, event.category);
+  out += ",\"ph\":\"";
+  out += event.phase;
+  out += "\",\"ts\":";
+  AppendMicroseconds(out, event.start_ns);
+  if (event.phase == 'X') {
+    out += ",\"dur\":";
+    AppendMicroseconds(out, event.duration_ns);
+  }
+  out += ",\"pid\":1,\"tid\":";
+  out += std::to_string(thread_id);
+  if (event.phase == 'C') {
+    char value[32];
+    std::snprintf(value, sizeof(value), "%.17g", event.value);
+    out += ",\"args\":{\"value\":";
+    out += value;
+    out += '}';
+  } else if (event.count >= 0) {
+    out += ",\"args\":{\"count\":";
+    out += std::to_string(event.count);
+    out += '}';
+  }
+  out += '}';
+}
+
+}  // namespace
+
+void Tracer::Enable(std::size_t events_per_thread) {
+  Registry& registry = GetRegistry();
+  {
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.capacity = events_per_thread;
+    registry.buffers.clear();
+    registry.free_buffers.clear();
+    registry.next_thread_id = 1;
+    registry.generation.fetch_add(1, std::memory_order_release);
+  }
+  enabled_.store(true, std::memory_order_relaxed);
+}
+
+void Tracer::Disable() noexcept {
+  enabled_.store(false, std::memory_order_relaxed);
+}
+
+void Tracer::Clear() {
+  Registry& registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.buffers.clear();
+  registry.free_buffers.clear();
+  registry.next_thread_id = 1;
+  registry.generation.fetch_add(1, std::memory_order_release);
+}
+
+std::uint64_t Tracer::NowNanoseconds() noexcept {
+  // Relative to the first call, so that timestamps are small and never 0
+  static const auto epoch = std::chrono::steady_clock::now() - std::chrono::nanoseconds(1);
+  return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+}
+
+void Tracer::RecordSpan(const char* category, const char* name, std::uint64_t start_ns, std::uint64_t end_ns,
+                        std::int64_t count) noexcept {
+  if (!IsEnabled()) {
+    return;
+  }
+  const std::uint64_t duration = end_ns > start_ns ? end_ns - start_ns : 0;
+  Append(TraceEvent{category, name, 'X', start_ns, duration, count, 0.0});
+}
+
+void Tracer::RecordCounter(const char* category, const char* name, double value) noexcept {
+  if (!IsEnabled()) {
+    return;
+  }
+  Append(TraceEvent{category, name, 'C', NowNanoseconds(), 0, -1, value});
+}
+
+std::uint64_t Tracer::DroppedEvents() {
+  Registry& registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  std::uint64_t dropped = 0;
+  for (const auto& buffer : registry.buffers) {
+    dropped += buffer->dropped.load(std::memory_order_relaxed);
+  }
+  return dropped;
+}
+
+std::string Tracer::ToChromeTraceJson() {
+  Registry& registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  std::string out = "{\"traceEvents\":[";
+  bool first = true;
+  std::uint64_t dropped = 0;
+  for (const auto& buffer : registry.buffers) {
+    const std::size_t size = buffer->size.load(std::memory_order_acquire);
+    for (std::size_t i = 0; i < size; ++i) {
+      if (!first) {
+        out += ",\n";
+      }
+      first = false;
+      AppendEvent(out, buffer->events[i], buffer->thread_id);
+    }
+    dropped += buffer->dropped.load(std::memory_order_relaxed);
+  }
+  out += "],\"displayTimeUnit\":\"ns\",\"otherData\":{\"dropped_events\":";
+  out += std::to_string(dropped);
+  out += "}}\n";
+  return out;
+}
+
+bool Tracer::WriteChromeTrace(const std::string& path) {
+  const std::string json = ToChromeTraceJson();
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    return false;
+  }
+  file.write(json.data(), static_cast<std::streamsize>(json.size()));
+  return static_cast<bool>(file);
+}
+
+}  // namespace core
+}  // namespace dbc_parser
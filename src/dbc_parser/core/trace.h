@@ -0,0 +1,155 @@
+#ifndef DBC_PARSER_CORE_TRACE_H_
+#define DBC_PARSER_CORE_TRACE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace dbc_parser {
+namespace core {
+
+/**
+ * @brief Process-wide recorder of trace spans and counters.
+ *
+ * Records are kept in per-thread buffers that only their own thread writes,
+ * so recording takes no lock: after a thread's first event it is a relaxed
+ * load, a store into the buffer and a release store of the new size. A full
+ * buffer drops further events of that thread and counts them.
+ *
+ * The buffer of an exited thread, with its events, passes to the next thread
+ * that starts recording, so memory is bounded by the number of threads alive
+ * at once rather than by the number ever started. Such threads share a track
+ * in the dump.
+ *
+ * Tracing is off by default; while it is off every span costs one relaxed
+ * atomic load. ToChromeTraceJson() produces the Chrome trace event format,
+ * which chrome://tracing and https://ui.perfetto.dev open directly.
+ *
+ * Span and counter names are not copied: they must be string literals or
+ * otherwise outlive the dump.
+ */
+class Tracer {
+ public:
+  Tracer() = delete;
+
+  /// Default capacity of each thread's event buffer.
+  static constexpr std::size_t kDefaultEventsPerThread = 1 << 16;
+
+  /**
+   * @brief Discards recorded events and starts recording.
+   *
+   * @param events_per_thread Capacity of each thread's event buffer
+   */
+  static void Enable(std::size_t events_per_thread = kDefaultEventsPerThread);
+
+  /**
+   * @brief Stops recording. Recorded events are kept for ToChromeTraceJson().
+   */
+  static void Disable() noexcept;
+
+  /**
+   * @brief Returns whether spans and counters are being recorded.
+   */
+  [[nodiscard]] static bool IsEnabled() noexcept { return enabled_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Discards all recorded events without changing IsEnabled().
+   */
+  static void Clear();
+
+  /**
+   * @brief Monotonic clock used for all trace timestamps, in nanoseconds.
+   */
+  [[nodiscard]] static std::uint64_t NowNanoseconds() noexcept;
+
+  /**
+   * @brief Records a finished span.
+   *
+   * @param category Span category, e.g. "parse"
+   * @param name Span name
+   * @param start_ns Start time from NowNanoseconds()
+   * @param end_ns End time from NowNanoseconds()
+   * @param count Number of items the span covered, or -1 for none
+   */
+  static void RecordSpan(const char* category, const char* name, std::uint64_t start_ns,
+                         std::uint64_t end_ns, std::int64_t count = -1) noexcept;
+
+  /**
+   * @brief Records the current value of a counter track.
+   *
+   * @param category Counter category
+   * @param name Counter name
+   * @param value Counter value
+   */
+  static void RecordCounter(const char* category, const char* name, double value) noexcept;
+
+  /**
+   * @brief Number of events dropped because a thread's buffer was full.
+   */
+  [[nodiscard]] static std::uint64_t DroppedEvents();
+
+  /**
+   * @brief Returns all recorded events as Chrome trace JSON.
+   *
+   * Safe to call while other threads are recording; events recorded during
+   * the call may or may not be included.
+   */
+  [[nodiscard]] static std::string ToChromeTraceJson();
+
+  /**
+   * @brief Writes ToChromeTraceJson() to a file.
+   *
+   * @param path Output file
+   * @return true if the file was written
+   */
+  static bool WriteChromeTrace(const std::string& path);
+
+ private:
+  static std::atomic<bool> enabled_;
+};
+
+/**
+ * @brief Records the lifetime of a scope as a trace span.
+ *
+ * Whether the span is recorded is decided once, at construction.
+ */
+class TraceSpan {
+ public:
+  TraceSpan(const char* category, const char* name) noexcept
+      : category_(category), name_(name), start_ns_(Tracer::IsEnabled() ? Tracer::NowNanoseconds() : 0) {}
+
+  ~TraceSpan() {
+    if (start_ns_ != 0) {
+      Tracer::RecordSpan(category_, name_, start_ns_, Tracer::NowNanoseconds(), count_);
+    }
+  }
+
+  TraceSpan(const TraceSpan&) = delete;
+  TraceSpan& operator=(const TraceSpan&) = delete;
+  TraceSpan(TraceSpan&&) = delete;
+  TraceSpan& operator=(TraceSpan&&) = delete;
+
+  /**
+   * @brief Attaches the number of processed items to the span.
+   */
+  void SetCount(std::int64_t count) noexcept { count_ = count; }
+
+ private:
+  const char* category_;
+  const char* name_;
+  std::uint64_t start_ns_;
+  std::int64_t count_ = -1;
+};
+
+}  // namespace core
+}  // namespace dbc_parser
+
+#define DBC_TRACE_CONCAT_INNER_(a, b) a##b
+#define DBC_TRACE_CONCAT_(a, b) DBC_TRACE_CONCAT_INNER_(a, b)
+
+// Traces the rest of the enclosing scope: DBC_TRACE_SPAN("parse", "grammar");
+#define DBC_TRACE_SPAN(category, name) \
+  ::dbc_parser::core::TraceSpan DBC_TRACE_CONCAT_(dbc_trace_span_, __LINE__)(category, name)
+
+#endif  // DBC_PARSER_CORE_TRACE_H_
@@ -0,0 +1,330 @@
+#include "dbc_parser/decoder/asc_parser.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+#include "dbc_parser/decoder/civil_time.h"
+
+namespace dbc_parser {
+namespace decoder {
+namespace {
+
+constexpr int kNotDigit = -1;
+
+// Digit values up to base 16 by character
+constexpr std::array<std::int8_t, 256> MakeDigitTable() noexcept {
+  std::array<std::int8_t, 256> table{};
+  for (int c = 0; c < 256; ++c) {
+    table[c] = kNotDigit;
+  }
+  for (int c = '0'; c <= '9'; ++c) {
+    table[c] = static_cast<std::int8_t>(c - '0');
+  }
+  for (int c = 'A'; c <= 'F'; ++c) {
+    table[c] = static_cast<std::int8_t>(c - 'A' + 10);
+    table[c + ('a' - 'A')] = static_cast<std::int8_t>(c - 'A' + 10);
+  }
+  return table;
+}
+
+constexpr std::array<std::int8_t, 256> kDigitTable = MakeDigitTable();
+
+// Nanoseconds per unit of a fraction with the given number of digits
+constexpr std::int64_t kFractionScale[] = {0, 100000000, 10000000, 1000000, 100000, 10000, 1000, 100, 10, 1};
+
+constexpr bool IsBlank(char c) noexcept { return c == ' ' || c == '\t'; }
+
+// The whole token as a number in base, or std::nullopt
+std::optional<std::uint32_t> ParseNumber(std::string_view token, unsigned base) noexcept {
+  // Up to 0xFFFFFFFF or 999999999, enough for any 29-bit ID
+  if (token.empty() || token.size() > (base == 16 ? 8u : 9u)) {
+    return std::nullopt;
+  }
+  std::uint32_t value = 0;
+  for (const char c : token) {
+    const int digit = kDigitTable[static_cast<unsigned char>(c)];
+    if (digit == kNotDigit || static_cast<unsigned>(digit) >= base) {
+      return std::nullopt;
+    }
+    value = value * base + static_cast<std::uint32_t>(digit);
+  }
+  return value;
+}
+
+// "seconds.fraction" with up to 9 fraction digits kept
+std::optional<std::int64_t> ParseSeconds(std::string_view token) noexcept {
+  const std::size_t dot = token.find('.');
+  if (dot == 0 || dot == std::string_view::npos || dot > 10 || dot + 1 == token.size()) {
+    return std::nullopt;
+  }
+  std::int64_t seconds = 0;
+  for (std::size_t i = 0; i < dot; ++i) {
+    const int digit = kDigitTable[static_cast<unsigned char>(token[i])];
+    if (digit == kNotDigit || digit > 9) {
+      return std::nullopt;
+    }
+    seconds = seconds * 10 + digit;
+  }
+  std::int64_t fraction = 0;
+  const std::size_t digits = token.size() - dot - 1;
+  for (std::size_t i = dot + 1; i < token.size(); ++i) {
+    const int digit = kDigitTable[static_cast<unsigned char>(token[i])];
+    if (digit == kNotDigit || digit > 9) {
+      return std::nullopt;
+    }
+    if (i - dot <= 9) {
+      fraction = fraction * 10 + digit;
+    }
+  }
+  return seconds * 1000000000 + fraction * kFractionScale[std::min<std::size_t>(digits, 9)];
+}
+
+// Splits a line into blank-separated tokens
+class Tokenizer {
+ public:
+  explicit Tokenizer(std::string_view line) noexcept : line_(line) {}
+
+  // The next token, empty at the end of the line
+  std::string_view Next() noexcept {
+    while (pos_ < line_.size() && IsBlank(line_[pos_])) {
+      ++pos_;
+    }
+    const std::size_t start = pos_;
+    while (pos_ < line_.size() && !IsBlank(line_[pos_])) {
+      ++pos_;
+    }
+    return line_.substr(start, pos_ - start);
+  }
+
+ private:
+  std::string_view line_;
+  std::size_t pos_ = 0;
+};
+
+std::string_view TrimNewline(std::string_view line) noexcept {
+  while (!line.empty() && (line.back() == '\n' || line.back() == '\r')) {
+    line.remove_suffix(1);
+  }
+  return line;
+}
+
+// Hex or decimal ID with an 'x' suffix for extended frames
+bool ParseId(std::string_view token, unsigned base, CanFrame& frame) noexcept {
+  const bool extended = !token.empty() && (token.back() == 'x' || token.back() == 'X');
+  if (extended) {
+    token.remove_suffix(1);
+  }
+  const std::optional<std::uint32_t> id = ParseNumber(token, base);
+  if (!id || *id > (extended ? 0x1FFFFFFFu : 0x7FFu)) {
+    return false;
+  }
+  frame.id = *id;
+  if (extended) {
+    frame.flags |= CanFrame::kExtended;
+  }
+  return true;
+}
+
+// "Rx" or "Tx"; TxRq and the rest are not frames on the bus
+bool ParseDirection(std::string_view token, CanFrame& frame) noexcept {
+  if (token == "Tx") {
+    frame.flags |= CanFrame::kTransmitted;
+    return true;
+  }
+  return token == "Rx";
+}
+
+bool ParsePayload(Tokenizer& tokens, unsigned base, std::size_t size, CanFrame& frame) noexcept {
+  for (std::size_t i = 0; i < size; ++i) {
+    const std::optional<std::uint32_t> byte = ParseNumber(tokens.Next(), base);
+    if (!byte || *byte > 0xFF) {
+      return false;
+    }
+    frame.data[i] = static_cast<std::uint8_t>(*byte);
+  }
+  frame.size = static_cast<std::uint8_t>(size);
+  return true;
+}
+
+// After "<time> CANFD": channel dir id [name] brs esi dlc length data...
+bool ParseFdFrame(Tokenizer& tokens, unsigned base, CanFrame& frame) noexcept {
+  const std::optional<std::uint32_t> channel = ParseNumber(tokens.Next(), 10);
+  if (!channel || *channel > 0xFFFF || !ParseDirection(tokens.Next(), frame) ||
+      !ParseId(tokens.Next(), base, frame)) {
+    return false;
+  }
+  frame.channel = static_cast<std::uint16_t>(*channel);
+  frame.flags |= CanFrame::kFd;
+
+  std::string_view brs = tokens.Next();
+  if (brs != "0" && brs != "1") {
+    // The optional symbolic message name
+    brs = tokens.Next();
+  }
+  const std::string_view esi = tokens.Next();
+  if ((brs != "0" && brs != "1") || (esi != "0" && esi != "1")) {
+    return false;
+  }
+  if (brs == "1") {
+    frame.flags |= CanFrame::kBitRateSwitch;
+  }
+  if (esi == "1") {
+    frame.flags |= CanFrame::kErrorStateIndicator;
+  }
+
+  const std::optional<std::uint32_t> dlc = ParseNumber(tokens.Next(), 16);
+  const std::optional<std::uint32_t> length = ParseNumber(tokens.Next(), 10);
+  if (!dlc || *dlc > 0xF || !length || !CanFrame::IsFdSize(*length)) {
+    return false;
+  }
+  return ParsePayload(tokens, base, *length, frame);
+}
+
+// After "<time>": channel id dir (d dlc data... | r [dlc])
+bool ParseClassicFrame(std::string_view channel_token, Tokenizer& tokens, unsigned base, CanFrame& frame) noexcept {
+  const std::optional<std::uint32_t> channel = ParseNumber(channel_token, 10);
+  if (!channel || *channel > 0xFFFF || !ParseId(tokens.Next(), base, frame) ||
+      !ParseDirection(tokens.Next(), frame)) {
+    return false;
+  }
+  frame.channel = static_cast<std::uint16_t>(*channel);
+
+  const std::string_view type = tokens.Next();
+  if (type == "r") {
+    frame.flags |= CanFrame::kRemote;
+    if (const std::optional<std::uint32_t> dlc = ParseNumber(tokens.Next(), 16)) {
+      frame.size = static_cast<std::uint8_t>(std::min<std::uint32_t>(*dlc, 8));
+    }
+    return true;
+  }
+  if (type != "d") {
+    return false;
+  }
+  const std::optional<std::uint32_t> dlc = ParseNumber(tokens.Next(), 16);
+  if (!dlc || *dlc > 0xF) {
+    return false;
+  }
+  // Classic DLCs 9..15 still carry 8 bytes
+  return ParsePayload(tokens, base, std::min<std::uint32_t>(*dlc, 8), frame);
+}
+
+template <unsigned kBase>
+std::optional<CanFrame> ParseFrameLine(std::string_view line) noexcept {
+  Tokenizer tokens(TrimNewline(line));
+  CanFrame frame;
+  const std::optional<std::int64_t> timestamp = ParseSeconds(tokens.Next());
+  if (!timestamp) {
+    return std::nullopt;
+  }
+  frame.timestamp_ns = *timestamp;
+  const std::string_view next = tokens.Next();
+  const bool parsed =
+      next == "CANFD" ? ParseFdFrame(tokens, kBase, frame) : ParseClassicFrame(next, tokens, kBase, frame);
+  if (!parsed) {
+    return std::nullopt;
+  }
+  return frame;
+}
+
+bool StartsWith(std::string_view text, std::string_view prefix) noexcept {
+  return text.substr(0, prefix.size()) == prefix;
+}
+
+// "Mon Sep 16 10:03:02.123 am 2019" or "Mon Sep 16 10:03:02 2019"
+std::optional<std::int64_t> ParseDate(std::string_view date) noexcept {
+  static constexpr std::string_view kMonths[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun",
+                                                 "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+  Tokenizer tokens(date);
+  tokens.Next();  // Weekday
+  const std::string_view month_name = tokens.Next();
+  const auto month = std::find(std::begin(kMonths), std::end(kMonths), month_name);
+  const std::optional<std::uint32_t> day = ParseNumber(tokens.Next(), 10);
+  const std::string_view time = tokens.Next();
+  if (month == std::end(kMonths) || !day || *day < 1 || *day > 31 || time.size() < 8 || time[2] != ':' ||
+      time[5] != ':') {
+    return std::nullopt;
+  }
+  const std::optional<std::uint32_t> hours = ParseNumber(time.substr(0, 2), 10);
+  const std::optional<std::uint32_t> minutes = ParseNumber(time.substr(3, 2), 10);
+  std::optional<std::int64_t> seconds;
+  if (time.size() == 8) {
+    if (const std::optional<std::uint32_t> whole = ParseNumber(time.substr(6), 10)) {
+      seconds = std::int64_t{*whole} * 1000000000;
+    }
+  } else {
+    seconds = ParseSeconds(time.substr(6));
+  }
+  if (!hours || *hours > 23 || !minutes || *minutes > 59 || !seconds || *seconds >= std::int64_t{61} * 1000000000) {
+    return std::nullopt;
+  }
+
+  std::uint32_t hour = *hours;
+  std::string_view year_token = tokens.Next();
+  if (year_token == "am" || year_token == "pm") {
+    if (hour < 1 || hour > 12) {
+      return std::nullopt;
+    }
+    hour = hour % 12 + (year_token == "pm" ? 12 : 0);
+    year_token = tokens.Next();
+  }
+  const std::optional<std::uint32_t> year = ParseNumber(year_token, 10);
+  if (!year || year_token.size() != 4) {
+    return std::nullopt;
+  }
+  return UtcNanoseconds(*year, static_cast<unsigned>(month - std::begin(kMonths)) + 1, *day, hour, *minutes, *seconds);
+}
+
+}  // namespace
+
+AscHeader AscParser::ParseHeader(std::string_view text) {
+  AscHeader header;
+  std::size_t pos = 0;
+  while (pos < text.size()) {
+    const std::size_t end = text.find('\n', pos);
+    const std::size_t next = end == std::string_view::npos ? text.size() : end + 1;
+    std::string_view line = TrimNewline(text.substr(pos, next - pos));
+    while (!line.empty() && IsBlank(line.front())) {
+      line.remove_prefix(1);
+    }
+
+    Tokenizer tokens(line);
+    const std::string_view keyword = tokens.Next();
+    if (keyword == "date") {
+      std::string_view date = line.substr(keyword.size());
+      while (!date.empty() && IsBlank(date.front())) {
+        date.remove_prefix(1);
+      }
+      header.date = std::string(date);
+      header.start_ns = ParseDate(header.date);
+    } else if (keyword == "base") {
+      header.hex_base = tokens.Next() != "dec";
+      if (tokens.Next() == "timestamps") {
+        header.relative_timestamps = tokens.Next() == "relative";
+      }
+    } else if (!(line.empty() || StartsWith(line, "//") || StartsWith(line, "internal events logged") ||
+                 StartsWith(line, "no internal events logged") || StartsWith(line, "Begin Triggerblock"))) {
+      break;
+    }
+    pos = next;
+  }
+  header.size = pos;
+  return header;
+}
+
+std::optional<CanFrame> AscParser::ParseLineHex(std::string_view line) noexcept {
+  return ParseFrameLine<16>(line);
+}
+
+std::optional<CanFrame> AscParser::ParseLineDec(std::string_view line) noexcept {
+  return ParseFrameLine<10>(line);
+}
+
+std::optional<std::int64_t> AscParser::ParseTimestamp(std::string_view line) noexcept {
+  return ParseSeconds(Tokenizer(line).Next());
+}
+
+}  // namespace decoder
+}  // namespace dbc_parser
@@ -0,0 +1,86 @@
+#ifndef DBC_PARSER_DECODER_ASC_PARSER_H_
+#define DBC_PARSER_DECODER_ASC_PARSER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "dbc_parser/decoder/can_frame.h"
+
+namespace dbc_parser {
+namespace decoder {
+
+/**
+ * @brief The header of a Vector ASC trace, the lines before the first event.
+ */
+struct AscHeader {
+  std::string date;                      ///< Text of the "date" line, e.g. "Mon Sep 16 10:03:02.123 am 2019"
+  std::optional<std::int64_t> start_ns;  ///< date as nanoseconds since the Unix epoch, taken as UTC
+  bool hex_base = true;                  ///< "base hex" or "base dec": radix of IDs and payload bytes
+  bool relative_timestamps = false;      ///< "timestamps relative": each line's time is a delta
+  std::size_t size = 0;                  ///< Bytes of header, where the events start
+};
+
+/**
+ * @brief Parses Vector ASC (ASCII trace) files written by CANoe and CANalyzer.
+ *
+ * Accepted event lines, after the timestamp in seconds:
+ * - `1  123  Rx   d 8 01 02 03 04 05 06 07 08  Length = ...` classic frame on
+ *   channel 1; an `x` suffix marks extended IDs (`18FEF100x`), `Tx` frames
+ *   sent by the logger, and anything after the payload is ignored
+ * - `1  123  Rx   r` or `r 4` remote frame, optional DLC
+ * - `CANFD   1 Rx  123  EngineData  1 0 d 12 01 02 ...` CAN FD frame with
+ *   optional message name, BRS, ESI, DLC and data length
+ *
+ * Other lines, such as error frames, TxRq, statistics and trigger block
+ * markers, are events without a frame. Hand-written like CandumpParser.
+ */
+class AscParser {
+ public:
+  AscParser() = delete;
+
+  /**
+   * @brief Reads the header lines at the start of a trace.
+   *
+   * The header ends before the first line that is not a "date", "base",
+   * "internal events logged", "Begin Triggerblock", comment or blank line.
+   *
+   * @param text The trace, or at least its beginning
+   * @return AscHeader Settings from the header; defaults for missing lines
+   */
+  [[nodiscard]] static AscHeader ParseHeader(std::string_view text);
+
+  /**
+   * @brief Parses one event line of a "base hex" trace.
+   *
+   * @param line The line, with or without its trailing newline
+   * @return std::optional<CanFrame> The frame, or std::nullopt if the line
+   *         holds no frame
+   */
+  [[nodiscard]] static std::optional<CanFrame> ParseLineHex(std::string_view line) noexcept;
+
+  /**
+   * @brief Parses one event line of a "base dec" trace.
+   *
+   * @param line The line, with or without its trailing newline
+   * @return std::optional<CanFrame> The frame, or std::nullopt if the line
+   *         holds no frame
+   */
+  [[nodiscard]] static std::optional<CanFrame> ParseLineDec(std::string_view line) noexcept;
+
+  /**
+   * @brief Reads the timestamp that starts any event line.
+   *
+   * @param line The line
+   * @return std::optional<std::int64_t> Nanoseconds, or std::nullopt if the
+   *         line does not start with a timestamp
+   */
+  [[nodiscard]] static std::optional<std::int64_t> ParseTimestamp(std::string_view line) noexcept;
+};
+
+}  // namespace decoder
+}  // namespace dbc_parser
+
+#endif  // DBC_PARSER_DECODER_ASC_PARSER_H_
@@ -0,0 +1,48 @@
+#include "dbc_parser/decoder/asc_reader.h"
+
+#include <utility>
+
+#include "dbc_parser/core/mapped_file.h"
+#include "dbc_parser/core/trace.h"
+
+namespace dbc_parser {
+namespace decoder {
+
+LogDecodeStats AscReader::Decode(std::string_view asc, const LogDecoder::FrameCallback& on_frame,
+                                 AscHeader* header) const {
+  DBC_TRACE_SPAN("decoder", "AscReader::Decode");
+  AscHeader parsed = AscParser::ParseHeader(asc);
+  LogDecodeOptions options = options_;
+  if (parsed.relative_timestamps) {
+    options.relative_timestamps = &AscParser::ParseTimestamp;
+  }
+  if (options_.on_chunk) {
+    // Chunk offsets count from the start of the trace, header included
+    options.on_chunk = [this, header_size = parsed.size](const LogChunk& chunk) {
+      LogChunk shifted = chunk;
+      shifted.offset += header_size;
+      options_.on_chunk(shifted);
+    };
+  }
+  const LogDecoder log_decoder(decoder_, parsed.hex_base ? &AscParser::ParseLineHex : &AscParser::ParseLineDec,
+                               options);
+  LogDecodeStats stats = log_decoder.Decode(asc.substr(parsed.size), on_frame);
+  stats.bytes += parsed.size;
+  if (header != nullptr) {
+    *header = std::move(parsed);
+  }
+  return stats;
+}
+
+std::optional<LogDecodeStats> AscReader::DecodeFile(const std::string& path, const LogDecoder::FrameCallback& on_frame,
+                                                    AscHeader* header) const {
+  std::optional<core::MappedFile> file = core::MappedFile::Open(path);
+  if (!file) {
+    return std::nullopt;
+  }
+  file->AdviseSequential();
+  return Decode(file->contents(), on_frame, header);
+}
+
+}  // namespace decoder
+}  // namespace dbc_parser
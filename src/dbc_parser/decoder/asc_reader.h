@@ -0,0 +1,68 @@
+#ifndef DBC_PARSER_DECODER_ASC_READER_H_
+#define DBC_PARSER_DECODER_ASC_READER_H_
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "dbc_parser/decoder/asc_parser.h"
+#include "dbc_parser/decoder/frame_decoder.h"
+#include "dbc_parser/decoder/log_decoder.h"
+
+namespace dbc_parser {
+namespace decoder {
+
+/**
+ * @brief Decodes Vector ASC traces through a FrameDecoder.
+ *
+ * Reads the header, picks the line parser for its number base and hands the
+ * events to LogDecoder, so ASC traces get the same chunked, multi-threaded
+ * and timestamp-ordered decoding as candump logs. Relative timestamps are
+ * accumulated per chunk; see LogDecodeOptions::relative_timestamps.
+ * Timestamps stay relative to the start of the measurement, like in the file;
+ * AscHeader::start_ns gives the wall-clock start.
+ */
+class AscReader {
+ public:
+  /**
+   * @brief Creates a reader.
+   *
+   * @param decoder Message index; must outlive this object
+   * @param options Threads and chunking
+   */
+  explicit AscReader(const FrameDecoder& decoder, LogDecodeOptions options = {}) noexcept
+      : decoder_(decoder), options_(options) {}
+
+  /**
+   * @brief Decodes a trace held in memory.
+   *
+   * @param asc Trace text, header included
+   * @param on_frame Optional receiver of the decoded frames
+   * @param header Optional output of the trace's header
+   * @return LogDecodeStats Counters and timing; bytes includes the header
+   */
+  LogDecodeStats Decode(std::string_view asc, const LogDecoder::FrameCallback& on_frame = nullptr,
+                        AscHeader* header = nullptr) const;
+
+  /**
+   * @brief Memory-maps a trace file and decodes it.
+   *
+   * @param path Trace file
+   * @param on_frame Optional receiver of the decoded frames
+   * @param header Optional output of the trace's header
+   * @return std::optional<LogDecodeStats> Counters and timing, or std::nullopt
+   *         if the file cannot be mapped
+   */
+  [[nodiscard]] std::optional<LogDecodeStats> DecodeFile(const std::string& path,
+                                                         const LogDecoder::FrameCallback& on_frame = nullptr,
+                                                         AscHeader* header = nullptr) const;
+
+ private:
+  const FrameDecoder& decoder_;
+  LogDecodeOptions options_;
+};
+
+}  // namespace decoder
+}  // namespace dbc_parser
+
+#endif  // DBC_PARSER_DECODER_ASC_READER_H_
@@ -0,0 +1,602 @@
+#include "dbc_parser/decoder/blf_reader.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "dbc_parser/core/mapped_file.h"
+#include "dbc_parser/core/trace.h"
+#include "dbc_parser/decoder/chunk_pipeline.h"
+#include "dbc_parser/decoder/civil_time.h"
+
+namespace dbc_parser {
+namespace decoder {
+namespace {
+
+constexpr const char* kTraceCategory = "decoder";
+
+constexpr std::string_view kFileSignature = "LOGG";
+constexpr std::string_view kObjectSignature = "LOBJ";
+constexpr std::size_t kFileHeaderSize = 72;        ///< Fields read from the file header
+constexpr std::size_t kObjectHeaderBaseSize = 16;  ///< Signature, sizes, version and type
+constexpr std::size_t kObjectHeaderSize = 32;      ///< Base plus flags and timestamp; version 2 is longer
+constexpr std::size_t kMaxObjectHeaderSize = 64;
+constexpr std::size_t kContainerHeaderSize = 16;   ///< Compression method and uncompressed size
+/// Deflate expands at most about 1032:1, so a larger uncompressed size is corrupt
+constexpr std::uint64_t kMaxCompressionRatio = 1032;
+/// Writers use containers of about 128 KiB; larger ones are not decompressed
+constexpr std::uint32_t kMaxContainerBytes = 64 << 20;
+/// Writers pad objects; the next signature starts within this many bytes
+constexpr std::size_t kMaxPadding = 8;
+
+constexpr std::uint32_t kCanMessage = 1;
+constexpr std::uint32_t kLogContainer = 10;
+constexpr std::uint32_t kCanMessage2 = 86;
+constexpr std::uint32_t kCanFdMessage = 100;
+constexpr std::uint32_t kCanFdMessage64 = 101;
+
+constexpr std::uint16_t kNoCompression = 0;
+constexpr std::uint16_t kZlibCompression = 2;
+constexpr std::uint32_t kTimeTenMicroseconds = 1;  ///< Object timestamp unit flag; otherwise nanoseconds
+
+constexpr std::uint32_t kExtendedIdFlag = 0x80000000u;
+constexpr std::uint8_t kCanTransmitted = 0x01;
+constexpr std::uint8_t kCanRemote = 0x80;
+constexpr std::uint8_t kCanFdExtendedDataLength = 0x01;
+constexpr std::uint8_t kCanFdBitRateSwitch = 0x02;
+constexpr std::uint8_t kCanFdErrorState = 0x04;
+constexpr std::uint32_t kCanFd64Remote = 0x0010;
+constexpr std::uint32_t kCanFd64ExtendedDataLength = 0x1000;
+constexpr std::uint32_t kCanFd64BitRateSwitch = 0x2000;
+constexpr std::uint32_t kCanFd64ErrorState = 0x4000;
+
+// BLF is little-endian
+std::uint16_t Load16(std::string_view data, std::size_t pos) noexcept {
+  const auto* bytes = reinterpret_cast<const unsigned char*>(data.data() + pos);
+  return static_cast<std::uint16_t>(bytes[0] | (bytes[1] << 8));
+}
+
+std::uint32_t Load32(std::string_view data, std::size_t pos) noexcept {
+  return Load16(data, pos) | (static_cast<std::uint32_t>(Load16(data, pos + 2)) << 16);
+}
+
+std::uint64_t Load64(std::string_view data, std::size_t pos) noexcept {
+  return Load32(data, pos) | (static_cast<std::uint64_t>(Load32(data, pos + 4)) << 32);
+}
+
+struct ObjectHeader {
+  std::size_t header_size = 0;
+  std::size_t size = 0;  ///< Header and body, without padding
+  std::uint32_t type = 0;
+};
+
+// The header of the object at pos, or std::nullopt if none starts there
+std::optional<ObjectHeader> ReadObjectHeader(std::string_view data, std::size_t pos) noexcept {
+  if (pos > data.size() || data.size() - pos < kObjectHeaderBaseSize ||
+      data.compare(pos, kObjectSignature.size(), kObjectSignature) != 0) {
+    return std::nullopt;
+  }
+  ObjectHeader header;
+  header.header_size = Load16(data, pos + 4);
+  header.size = Load32(data, pos + 8);
+  header.type = Load32(data, pos + 12);
+  if (header.header_size < kObjectHeaderBaseSize || header.header_size > kMaxObjectHeaderSize ||
+      header.size < header.header_size) {
+    return std::nullopt;
+  }
+  return header;
+}
+
+// The first plausible object header at or after pos, for corrupt data and
+// for starting in the middle of a file
+std::size_t Resync(std::string_view data, std::size_t pos) noexcept {
+  while ((pos = data.find(kObjectSignature, pos)) != std::string_view::npos) {
+    if (ReadObjectHeader(data, pos)) {
+      return pos;
+    }
+    ++pos;
+  }
+  return std::string_view::npos;
+}
+
+// The signature of the object after the padding at pos, or npos if it is not
+// within kMaxPadding bytes
+std::size_t FindObjectAfterPadding(std::string_view data, std::size_t pos) noexcept {
+  for (std::size_t q = pos; q < pos + kMaxPadding && q + kObjectSignature.size() <= data.size(); ++q) {
+    if (data.compare(q, kObjectSignature.size(), kObjectSignature) == 0) {
+      return q;
+    }
+  }
+  return std::string_view::npos;
+}
+
+// Calls visit for every complete object from pos on. Returns where the
+// incomplete rest starts, i.e. the part that continues in the next container.
+template <typename Visit>
+std::size_t WalkObjects(std::string_view data, std::size_t pos, Visit&& visit) {
+  while (pos < data.size()) {
+    std::size_t start = FindObjectAfterPadding(data, pos);
+    if (start == std::string_view::npos) {
+      if (data.size() - pos < kMaxPadding + kObjectSignature.size()) {
+        return pos;
+      }
+      // Corrupt data: skip to the next object
+      start = Resync(data, pos);
+      if (start == std::string_view::npos) {
+        return data.size();
+      }
+    }
+    if (data.size() - start < kObjectHeaderBaseSize) {
+      return pos;
+    }
+    const std::optional<ObjectHeader> header = ReadObjectHeader(data, start);
+    if (!header) {
+      pos = start + 1;
+      continue;
+    }
+    if (header->size > data.size() - start) {
+      return pos;
+    }
+    visit(data.substr(start, header->size));
+    pos = start + header->size;
+  }
+  return pos;
+}
+
+std::int64_t ObjectTimestamp(std::string_view object) noexcept {
+  if (object.size() < kObjectHeaderSize) {
+    return 0;
+  }
+  const auto timestamp = static_cast<std::int64_t>(Load64(object, 24));
+  return Load32(object, 16) == kTimeTenMicroseconds ? timestamp * 10000 : timestamp;
+}
+
+void SetId(std::uint32_t blf_id, CanFrame& frame) noexcept {
+  frame.id = blf_id & ~kExtendedIdFlag;
+  if (blf_id & kExtendedIdFlag) {
+    frame.flags |= CanFrame::kExtended;
+  }
+}
+
+// The frame of a CAN message object, or std::nullopt for other objects
+std::optional<CanFrame> ParseFrameObject(std::string_view object) noexcept {
+  const std::optional<ObjectHeader> header = ReadObjectHeader(object, 0);
+  if (!header || object.size() < kObjectHeaderSize) {
+    return std::nullopt;
+  }
+  const std::string_view body = object.substr(header->header_size);
+  CanFrame frame;
+  frame.timestamp_ns = ObjectTimestamp(object);
+
+  switch (header->type) {
+    case kCanMessage:
+    case kCanMessage2: {
+      // channel:16 flags:8 dlc:8 id:32 data[8]
+      if (body.size() < 16) {
+        return std::nullopt;
+      }
+      frame.channel = Load16(body, 0);
+      const auto flags = static_cast<std::uint8_t>(body[2]);
+      SetId(Load32(body, 4), frame);
+      frame.size = static_cast<std::uint8_t>(std::min(static_cast<std::uint8_t>(body[3]), std::uint8_t{8}));
+      if (flags & kCanRemote) {
+        frame.flags |= CanFrame::kRemote;
+      } else {
+        std::copy_n(body.data() + 8, frame.size, reinterpret_cast<char*>(frame.data));
+      }
+      if (flags & kCanTransmitted) {
+        frame.flags |= CanFrame::kTransmitted;
+      }
+      return frame;
+    }
+    case kCanFdMessage: {
+      // channel:16 flags:8 dlc:8 id:32 frame_length:32 bit_count:8 fd_flags:8
+      // valid_bytes:8 reserved[5] data[64]
+      if (body.size() < 84) {
+        return std::nullopt;
+      }
+      frame.channel = Load16(body, 0);
+      const auto flags = static_cast<std::uint8_t>(body[2]);
+      const auto fd_flags = static_cast<std::uint8_t>(body[13]);
+      const auto size = static_cast<std::uint8_t>(body[14]);
+      if (size > CanFrame::kMaxPayload) {
+        return std::nullopt;
+      }
+      SetId(Load32(body, 4), frame);
+      frame.size = size;
+      std::copy_n(body.data() + 20, frame.size, reinterpret_cast<char*>(frame.data));
+      if (flags & kCanRemote) {
+        frame.flags |= CanFrame::kRemote;
+      }
+      if (flags & kCanTransmitted) {
+        frame.flags |= CanFrame::kTransmitted;
+      }
+      if (fd_flags & kCanFdExtendedDataLength) {
+        frame.flags |= CanFrame::kFd;
+      }
+      if (fd_flags & kCanFdBitRateSwitch) {
+        frame.flags |= CanFrame::kBitRateSwitch;
+      }
+      if (fd_flags & kCanFdErrorState) {
+        frame.flags |= CanFrame::kErrorStateIndicator;
+      }
+      return frame;
+    }
+    case kCanFdMessage64: {
+      // channel:8 dlc:8 valid_bytes:8 tx_count:8 id:32 frame_length:32
+      // flags:32 btr_arb:32 btr_data:32 brs_offset:32 crc_offset:32
+      // bit_count:16 dir:8 ext_data_offset:8 crc:32 data[valid_bytes]
+      if (body.size() < 40) {
+        return std::nullopt;
+      }
+      const auto size = static_cast<std::uint8_t>(body[2]);
+      if (size > CanFrame::kMaxPayload || body.size() < 40u + size) {
+        return std::nullopt;
+      }
+      frame.channel = static_cast<std::uint8_t>(body[0]);
+      SetId(Load32(body, 4), frame);
+      frame.size = size;
+      std::copy_n(body.data() + 40, frame.size, reinterpret_cast<char*>(frame.data));
+      const std::uint32_t flags = Load32(body, 12);
+      if (flags & kCanFd64Remote) {
+        frame.flags |= CanFrame::kRemote;
+      }
+      if (flags & kCanFd64ExtendedDataLength) {
+        frame.flags |= CanFrame::kFd;
+      }
+      if (flags & kCanFd64BitRateSwitch) {
+        frame.flags |= CanFrame::kBitRateSwitch;
+      }
+      if (flags & kCanFd64ErrorState) {
+        frame.flags |= CanFrame::kErrorStateIndicator;
+      }
+      if (body[34] != 0) {
+        frame.flags |= CanFrame::kTransmitted;
+      }
+      return frame;
+    }
+    default:
+      return std::nullopt;
+  }
+}
+
+// The next top-level object at or after pos, usually a LOG_CONTAINER
+std::optional<std::string_view> NextTopLevelObject(std::string_view blf, std::size_t& pos) noexcept {
+  std::size_t start = FindObjectAfterPadding(blf, pos);
+  if (start == std::string_view::npos) {
+    start = Resync(blf, pos);
+  }
+  const std::optional<ObjectHeader> header =
+      start == std::string_view::npos ? std::nullopt : ReadObjectHeader(blf, start);
+  if (!header || header->size > blf.size() - start) {
+    pos = blf.size();
+    return std::nullopt;
+  }
+  pos = start + header->size;
+  return blf.substr(start, header->size);
+}
+
+// The object stream slice a top-level object holds: the decompressed body of
+// a container, or the object itself. Empty if the container is broken,
+// including an uncompressed size no valid payload can have, which is checked
+// before the buffer is allocated.
+std::string_view ContainerData(std::string_view object, std::string& buffer) {
+  const std::optional<ObjectHeader> header = ReadObjectHeader(object, 0);
+  if (header->type != kLogContainer) {
+    return object;
+  }
+  const std::string_view body = object.substr(header->header_size);
+  if (body.size() < kContainerHeaderSize) {
+    return {};
+  }
+  const std::uint16_t method = Load16(body, 0);
+  const std::uint32_t uncompressed_size = Load32(body, 8);
+  const std::string_view payload = body.substr(kContainerHeaderSize);
+  if (method == kNoCompression) {
+    return payload;
+  }
+  if (method != kZlibCompression || uncompressed_size > kMaxContainerBytes ||
+      uncompressed_size > kMaxCompressionRatio * payload.size()) {
+    return {};
+  }
+  buffer.resize(uncompressed_size);
+  uLongf size = uncompressed_size;
+  if (uncompress(reinterpret_cast<Bytef*>(buffer.data()), &size, reinterpret_cast<const Bytef*>(payload.data()),
+                 static_cast<uLong>(payload.size())) != Z_OK ||
+      size != uncompressed_size) {
+    return {};
+  }
+  return buffer;
+}
+
+std::optional<std::int64_t> FirstTimestamp(std::string_view object) {
+  std::string buffer;
+  const std::string_view data = ContainerData(object, buffer);
+  const std::size_t start = Resync(data, 0);
+  if (start == std::string_view::npos || data.size() - start < kObjectHeaderSize) {
+    return std::nullopt;
+  }
+  return ObjectTimestamp(data.substr(start));
+}
+
+std::optional<std::int64_t> SystemTimeNanoseconds(std::string_view header, std::size_t pos) noexcept {
+  // year, month, day of week, day, hour, minute, second, milliseconds
+  const std::uint16_t year = Load16(header, pos);
+  const std::uint16_t month = Load16(header, pos + 2);
+  const std::uint16_t day = Load16(header, pos + 6);
+  const std::uint16_t hour = Load16(header, pos + 8);
+  const std::uint16_t minute = Load16(header, pos + 10);
+  const std::uint16_t second = Load16(header, pos + 12);
+  const std::uint16_t millisecond = Load16(header, pos + 14);
+  if (year == 0 || month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59 || second > 60 ||
+      millisecond > 999) {
+    return std::nullopt;
+  }
+  return UtcNanoseconds(year, month, day, hour, minute,
+                        (std::int64_t{second} * 1000 + millisecond) * 1000000);
+}
+
+// What a container leaves to the next one: the bytes after its last complete
+// object, or that the next container has to search for its first object
+struct Continuation {
+  std::string pending;
+  bool resync = false;
+};
+
+// Hands each container's Continuation to the worker of the next container
+class ContinuationChain {
+ public:
+  void Put(std::size_t index, Continuation continuation) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      continuations_[index] = std::move(continuation);
+    }
+    put_.notify_all();
+  }
+
+  Continuation Take(std::size_t index) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    put_.wait(lock, [&] { return continuations_.count(index) != 0; });
+    Continuation continuation = std::move(continuations_[index]);
+    continuations_.erase(index);
+    return continuation;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable put_;
+  std::map<std::size_t, Continuation> continuations_;
+};
+
+struct ContainerTask {
+  std::size_t index = 0;
+  std::string_view object;
+};
+
+}  // namespace
+
+std::optional<BlfHeader> BlfReader::ParseHeader(std::string_view blf) noexcept {
+  if (blf.size() < kFileHeaderSize || blf.substr(0, kFileSignature.size()) != kFileSignature) {
+    return std::nullopt;
+  }
+  BlfHeader header;
+  header.size = Load32(blf, 4);
+  if (header.size < kFileHeaderSize || header.size > blf.size()) {
+    return std::nullopt;
+  }
+  header.application_id = static_cast<std::uint8_t>(blf[8]);
+  header.file_size = Load64(blf, 16);
+  header.uncompressed_size = Load64(blf, 24);
+  header.object_count = Load32(blf, 32);
+  header.start_ns = SystemTimeNanoseconds(blf, 40);
+  header.stop_ns = SystemTimeNanoseconds(blf, 56);
+  return header;
+}
+
+std::optional<LogDecodeStats> BlfReader::Decode(std::string_view blf, const LogDecoder::FrameCallback& on_frame,
+                                                BlfHeader* header, std::int64_t from_ns) const {
+  DBC_TRACE_SPAN(kTraceCategory, "BlfReader::Decode");
+  const auto start = std::chrono::steady_clock::now();
+  const std::optional<BlfHeader> file_header = ParseHeader(blf);
+  if (!file_header) {
+    return std::nullopt;
+  }
+  if (header != nullptr) {
+    *header = *file_header;
+  }
+
+  // Seeking: the last container whose first object is before from_ns. Only
+  // the headers of the top-level objects are read to list the containers.
+  std::size_t cursor = file_header->size;
+  bool resync = false;
+  if (from_ns != kFromStart) {
+    DBC_TRACE_SPAN(kTraceCategory, "BlfReader::Seek");
+    std::vector<std::string_view> objects;
+    for (std::size_t pos = cursor; const auto object = NextTopLevelObject(blf, pos);) {
+      objects.push_back(*object);
+    }
+    std::size_t low = 0;
+    std::size_t high = objects.size();
+    while (high - low > 1) {
+      const std::size_t middle = low + (high - low) / 2;
+      if (FirstTimestamp(objects[middle]).value_or(kFromStart) < from_ns) {
+        low = middle;
+      } else {
+        high = middle;
+      }
+    }
+    if (low > 0) {
+      cursor = static_cast<std::size_t>(objects[low].data() - blf.data());
+      resync = true;
+    }
+  }
+  return DecodeObjects(blf, cursor, blf.size(), resync, from_ns, on_frame, start);
+}
+
+std::optional<LogDecodeStats> BlfReader::DecodeRange(std::string_view blf, std::size_t begin, std::size_t end,
+                                                     const LogDecoder::FrameCallback& on_frame) const {
+  DBC_TRACE_SPAN(kTraceCategory, "BlfReader::DecodeRange");
+  const auto start = std::chrono::steady_clock::now();
+  const std::optional<BlfHeader> file_header = ParseHeader(blf);
+  if (!file_header) {
+    return std::nullopt;
+  }
+  const std::size_t cursor = std::max(begin, file_header->size);
+  return DecodeObjects(blf, cursor, std::min(std::max(end, cursor), blf.size()), cursor > file_header->size,
+                       kFromStart, on_frame, start);
+}
+
+std::optional<LogDecodeStats> BlfReader::DecodeObjects(std::string_view blf, std::size_t cursor, std::size_t end,
+                                                       bool resync, std::int64_t from_ns,
+                                                       const LogDecoder::FrameCallback& on_frame,
+                                                       std::chrono::steady_clock::time_point start) const {
+  const bool keep_frames = on_frame || options_.on_chunk;
+  const std::size_t threads = options_.MaxThreads();
+  const std::size_t max_in_flight = keep_frames
+                                        ? std::max<std::size_t>(1, options_.chunks_in_flight_per_thread) * threads
+                                        : std::numeric_limits<std::size_t>::max() / 2;
+
+  LogDecodeStats total;
+  total.bytes = end - cursor;
+  total.threads = threads;
+
+  ContinuationChain chain;
+  Continuation first;
+  first.resync = resync;
+  chain.Put(0, std::move(first));
+
+  const auto decode_container = [&](ContainerTask& task, std::size_t worker) {
+    core::TraceSpan span(kTraceCategory, "decode container");
+    auto chunk = std::make_unique<DecodedChunk>();
+    chunk->offset = static_cast<std::size_t>(task.object.data() - blf.data());
+    chunk->size = task.object.size();
+    std::vector<double> scratch(std::max<std::size_t>(decoder_.MaxSignalCount(), 1));
+    std::string buffer;
+    const std::string_view data = ContainerData(task.object, buffer);
+    Continuation in = chain.Take(task.index);
+
+    // Where this container's own objects start, and the object that
+    // continues into it from earlier containers
+    std::string straddling;
+    std::size_t pos = 0;
+    if (data.empty()) {
+      ++chunk->stats.malformed_lines;
+      chain.Put(task.index + 1, Continuation{{}, true});
+      return chunk;
+    }
+    if (in.resync) {
+      pos = Resync(data, 0);
+      if (pos == std::string_view::npos) {
+        chain.Put(task.index + 1, Continuation{{}, true});
+        return chunk;
+      }
+    } else if (!in.pending.empty()) {
+      std::string head = in.pending;
+      head.append(data.substr(0, kMaxPadding + kObjectHeaderBaseSize));
+      const std::size_t object_start = FindObjectAfterPadding(head, 0);
+      const std::optional<ObjectHeader> object_header =
+          object_start == std::string_view::npos ? std::nullopt : ReadObjectHeader(head, object_start);
+      const std::size_t available = in.pending.size() + data.size();
+      if (!object_header) {
+        if (head.size() >= kMaxPadding + kObjectHeaderBaseSize) {
+          // Corrupt; drop the pending bytes
+          pos = Resync(data, 0);
+        } else {
+          in.pending.append(data);
+          chain.Put(task.index + 1, std::move(in));
+          return chunk;
+        }
+      } else if (object_start + object_header->size > available) {
+        // The object goes on into the next container
+        in.pending.append(data);
+        chain.Put(task.index + 1, std::move(in));
+        return chunk;
+      } else if (object_start >= in.pending.size()) {
+        pos = object_start - in.pending.size();
+      } else {
+        pos = object_start + object_header->size - in.pending.size();
+        straddling = in.pending.substr(object_start);
+        straddling.append(data.substr(0, pos));
+      }
+      if (pos == std::string_view::npos) {
+        chain.Put(task.index + 1, Continuation{{}, true});
+        return chunk;
+      }
+    }
+    const std::size_t rest = WalkObjects(data, pos, [](std::string_view) {});
+    chain.Put(task.index + 1, Continuation{std::string(data.substr(rest)), false});
+
+    const auto decode_object = [&](std::string_view object) {
+      if (ObjectTimestamp(object) < from_ns) {
+        return;
+      }
+      ++chunk->stats.lines;
+      if (const std::optional<CanFrame> frame = ParseFrameObject(object)) {
+        const DecodedFrame decoded = chunk->Add(*frame, decoder_, keep_frames, scratch);
+        if (options_.on_worker_frame) {
+          options_.on_worker_frame(worker, decoded);
+        }
+      } else {
+        ++chunk->stats.malformed_lines;
+      }
+    };
+    if (!straddling.empty()) {
+      decode_object(straddling);
+    }
+    WalkObjects(data, pos, decode_object);
+    if (keep_frames) {
+      chunk->SortByTime();
+    }
+    span.SetCount(static_cast<std::int64_t>(chunk->stats.frames));
+    return chunk;
+  };
+
+  ChunkMerger merger(on_frame);
+  std::size_t next_index = 0;
+  RunChunkPipeline<ContainerTask, DecodedChunk>(
+      threads, max_in_flight,
+      [&]() -> std::optional<ContainerTask> {
+        const std::optional<std::string_view> object =
+            cursor < end ? NextTopLevelObject(blf, cursor) : std::nullopt;
+        if (!object || static_cast<std::size_t>(object->data() - blf.data()) >= end) {
+          return std::nullopt;
+        }
+        return ContainerTask{next_index++, *object};
+      },
+      decode_container,
+      [&](std::unique_ptr<DecodedChunk> chunk) {
+        AddCounts(total, chunk->stats);
+        chunk->Report(options_, total.chunks++, 0);
+        if (on_frame) {
+          merger.Add(std::move(chunk));
+        }
+      });
+  if (on_frame) {
+    merger.Finish();
+  }
+
+  total.late_frames = merger.late_frames();
+  total.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  core::Tracer::RecordCounter(kTraceCategory, "frames", static_cast<double>(total.frames));
+  return total;
+}
+
+std::optional<LogDecodeStats> BlfReader::DecodeFile(const std::string& path, const LogDecoder::FrameCallback& on_frame,
+                                                    BlfHeader* header, std::int64_t from_ns) const {
+  std::optional<core::MappedFile> file = core::MappedFile::Open(path);
+  if (!file) {
+    return std::nullopt;
+  }
+  file->AdviseSequential();
+  return Decode(file->contents(), on_frame, header, from_ns);
+}
+
+}  // namespace decoder
+}  // namespace dbc_parser
@@ -0,0 +1,136 @@
+#ifndef DBC_PARSER_DECODER_BLF_READER_H_
+#define DBC_PARSER_DECODER_BLF_READER_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "dbc_parser/decoder/can_frame.h"
+#include "dbc_parser/decoder/frame_decoder.h"
+#include "dbc_parser/decoder/log_decoder.h"
+
+namespace dbc_parser {
+namespace decoder {
+
+/**
+ * @brief The file header of a Vector BLF (binary logging format) file.
+ */
+struct BlfHeader {
+  std::uint8_t application_id = 0;       ///< Writer, e.g. 1 for CANalyzer
+  std::uint64_t file_size = 0;           ///< File size recorded by the writer
+  std::uint64_t uncompressed_size = 0;   ///< Size of all objects uncompressed
+  std::uint32_t object_count = 0;        ///< Objects recorded by the writer
+  std::optional<std::int64_t> start_ns;  ///< Measurement start, nanoseconds since the Unix epoch, as UTC
+  std::optional<std::int64_t> stop_ns;   ///< Measurement end, like start_ns
+  std::size_t size = 0;                  ///< Bytes of header, where the objects start
+};
+
+/**
+ * @brief Decodes Vector BLF files through a FrameDecoder.
+ *
+ * A BLF file is a sequence of LOG_CONTAINER objects, each holding a
+ * zlib-compressed slice of the stream of log objects. Containers are
+ * decompressed and decoded on a worker pool and merged in timestamp order
+ * like LogDecoder chunks; the decoded frames arrive through the same
+ * LogDecoder::FrameCallback. Objects may continue from one container into
+ * the next: each worker finds where its first object starts from the
+ * container before it, which only takes a walk over the object headers, and
+ * then decodes its objects in parallel with the others.
+ *
+ * CAN_MESSAGE, CAN_MESSAGE2, CAN_FD_MESSAGE and CAN_FD_MESSAGE_64 objects
+ * become frames; other objects count as malformed_lines, and containers as
+ * chunks. Frame timestamps are the object timestamps, relative to
+ * BlfHeader::start_ns. LogDecodeOptions::chunk_bytes does not apply, the
+ * writer chose the container size.
+ */
+class BlfReader {
+ public:
+  /// Decode from the first object
+  static constexpr std::int64_t kFromStart = std::numeric_limits<std::int64_t>::min();
+
+  /**
+   * @brief Creates a reader.
+   *
+   * @param decoder Message index; must outlive this object
+   * @param options Threads and containers in flight
+   */
+  explicit BlfReader(const FrameDecoder& decoder, LogDecodeOptions options = {}) noexcept
+      : decoder_(decoder), options_(options) {}
+
+  /**
+   * @brief Reads the file header.
+   *
+   * @param blf The file, or at least its first 144 bytes
+   * @return std::optional<BlfHeader> The header, or std::nullopt if the data
+   *         does not start with a BLF header
+   */
+  [[nodiscard]] static std::optional<BlfHeader> ParseHeader(std::string_view blf) noexcept;
+
+  /**
+   * @brief Decodes a BLF file held in memory.
+   *
+   * With from_ns, the reader binary-searches the containers for the one that
+   * holds from_ns and starts there, decompressing only O(log containers) of
+   * the earlier ones; frames before from_ns are skipped and not counted.
+   *
+   * @param blf File contents
+   * @param on_frame Optional receiver of the decoded frames
+   * @param header Optional output of the file header
+   * @param from_ns First timestamp to decode
+   * @return std::optional<LogDecodeStats> Counters and timing, or
+   *         std::nullopt if blf is not a BLF file
+   */
+  [[nodiscard]] std::optional<LogDecodeStats> Decode(std::string_view blf,
+                                                     const LogDecoder::FrameCallback& on_frame = nullptr,
+                                                     BlfHeader* header = nullptr,
+                                                     std::int64_t from_ns = kFromStart) const;
+
+  /**
+   * @brief Memory-maps a BLF file and decodes it; see Decode.
+   *
+   * @return std::optional<LogDecodeStats> Counters and timing, or
+   *         std::nullopt if the file cannot be mapped or is not a BLF file
+   */
+  [[nodiscard]] std::optional<LogDecodeStats> DecodeFile(const std::string& path,
+                                                         const LogDecoder::FrameCallback& on_frame = nullptr,
+                                                         BlfHeader* header = nullptr,
+                                                         std::int64_t from_ns = kFromStart) const;
+
+  /**
+   * @brief Decodes the top-level objects that start in [begin, end) of a BLF
+   *        file held in memory, e.g. containers picked from a LogChunk index.
+   *
+   * Past the file header, decoding starts at the first object found in the
+   * container at begin, so an object continued from the container before is
+   * skipped, and an object that continues beyond end is dropped. Each
+   * LogChunk of a full decode holds the objects that end in its container,
+   * so decoding from one container before a run of chunks yields all of
+   * their frames.
+   *
+   * @param blf File contents
+   * @param begin Offset of the first top-level object to decode
+   * @param end Offset after the last one
+   * @param on_frame Optional receiver of the decoded frames
+   * @return std::optional<LogDecodeStats> Counters and timing, or
+   *         std::nullopt if blf is not a BLF file
+   */
+  [[nodiscard]] std::optional<LogDecodeStats> DecodeRange(std::string_view blf, std::size_t begin, std::size_t end,
+                                                          const LogDecoder::FrameCallback& on_frame = nullptr) const;
+
+ private:
+  std::optional<LogDecodeStats> DecodeObjects(std::string_view blf, std::size_t cursor, std::size_t end, bool resync,
+                                              std::int64_t from_ns, const LogDecoder::FrameCallback& on_frame,
+                                              std::chrono::steady_clock::time_point start) const;
+
+  const FrameDecoder& decoder_;
+  LogDecodeOptions options_;
+};
+
+}  // namespace decoder
+}  // namespace dbc_parser
+
+#endif  // DBC_PARSER_DECODER_BLF_READER_H_
@@ -0,0 +1,72 @@
+#ifndef DBC_PARSER_DECODER_CAN_FRAME_H_
+#define DBC_PARSER_DECODER_CAN_FRAME_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dbc_parser {
+namespace decoder {
+
+/**
+ * @brief One recorded CAN or CAN FD frame, as read from a log.
+ *
+ * A plain aggregate with the payload stored inline, so batches of frames are
+ * flat arrays without per-frame allocations.
+ */
+struct CanFrame {
+  static constexpr std::uint8_t kExtended = 1u << 0;             ///< 29-bit identifier
+  static constexpr std::uint8_t kRemote = 1u << 1;               ///< Remote transmission request
+  static constexpr std::uint8_t kFd = 1u << 2;                   ///< CAN FD frame
+  static constexpr std::uint8_t kBitRateSwitch = 1u << 3;        ///< CAN FD BRS bit
+  static constexpr std::uint8_t kErrorStateIndicator = 1u << 4;  ///< CAN FD ESI bit
+  static constexpr std::uint8_t kTransmitted = 1u << 5;          ///< Sent by the logging node (Tx)
+
+  /// Largest payload, a CAN FD frame
+  static constexpr std::size_t kMaxPayload = 64;
+  /// Bit 31 marks extended IDs in DBC files; see ParserBase::ParseMessageId
+  static constexpr std::uint32_t kDbcExtendedIdFlag = 0x80000000u;
+
+  std::int64_t timestamp_ns = 0;  ///< Capture time in nanoseconds
+  std::uint32_t id = 0;           ///< 11- or 29-bit identifier, without flag bits
+  std::uint16_t channel = 0;      ///< Bus the frame was recorded on
+  std::uint8_t size = 0;          ///< Payload bytes in data
+  std::uint8_t flags = 0;         ///< Combination of the k* flag bits above
+  std::uint8_t data[kMaxPayload] = {};  ///< Payload; bytes past size are zero
+
+  /**
+   * @brief Whether a CAN FD frame can carry exactly size bytes: 0..8, 12,
+   *        16, 20, 24, 32, 48 or 64.
+   */
+  [[nodiscard]] static constexpr bool IsFdSize(std::size_t size) noexcept {
+    return size <= 8 || size == 12 || size == 16 || size == 20 || size == 24 || size == 32 || size == 48 ||
+           size == 64;
+  }
+
+  /**
+   * @brief The smallest CAN FD payload size that holds size bytes, at most
+   *        kMaxPayload.
+   */
+  [[nodiscard]] static constexpr std::uint8_t FdSizeFor(std::size_t size) noexcept {
+    return size <= 8 ? static_cast<std::uint8_t>(size)
+           : size <= 24 ? static_cast<std::uint8_t>((size + 3) / 4 * 4)
+           : size <= 32 ? 32
+           : size <= 48 ? 48
+                        : 64;
+  }
+
+  [[nodiscard]] bool is_extended() const noexcept { return (flags & kExtended) != 0; }
+  [[nodiscard]] bool is_fd() const noexcept { return (flags & kFd) != 0; }
+
+  /**
+   * @brief The message ID as written in a DBC file, i.e. with bit 31 set for
+   *        extended frames.
+   */
+  [[nodiscard]] std::uint32_t dbc_id() const noexcept {
+    return is_extended() ? (id | kDbcExtendedIdFlag) : id;
+  }
+};
+
+}  // namespace decoder
+}  // namespace dbc_parser
+
+#endif  // DBC_PARSER_DECODER_CAN_FRAME_H_
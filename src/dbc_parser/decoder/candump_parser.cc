@@ -0,0 +1,238 @@
+#include "dbc_parser/decoder/candump_parser.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace dbc_parser {
+namespace decoder {
+namespace {
+
+constexpr int kNotHex = -1;
+
+// Hex digit values by character; a table instead of range checks, because
+// payload digits mix 0-9 and A-F unpredictably
+constexpr std::array<std::int8_t, 256> MakeHexTable() noexcept {
+  std::array<std::int8_t, 256> table{};
+  for (int c = 0; c < 256; ++c) {
+    table[c] = kNotHex;
+  }
+  for (int c = '0'; c <= '9'; ++c) {
+    table[c] = static_cast<std::int8_t>(c - '0');
+  }
+  for (int c = 'A'; c <= 'F'; ++c) {
+    table[c] = static_cast<std::int8_t>(c - 'A' + 10);
+    table[c + ('a' - 'A')] = static_cast<std::int8_t>(c - 'A' + 10);
+  }
+  return table;
+}
+
+constexpr std::array<std::int8_t, 256> kHexTable = MakeHexTable();
+
+inline int HexValue(char c) noexcept { return kHexTable[static_cast<unsigned char>(c)]; }
+
+// Nanoseconds per unit of a fraction with the given number of digits
+constexpr std::int64_t kFractionScale[] = {0, 100000000, 10000000, 1000000, 100000, 10000, 1000, 100, 10, 1};
+
+// Largest seconds value whose nanoseconds fit int64 with any fraction, in
+// the year 2262
+constexpr std::int64_t kMaxSeconds = (INT64_MAX - 999999999) / 1000000000;
+
+constexpr bool IsDigit(char c) noexcept { return c >= '0' && c <= '9'; }
+
+constexpr bool IsBlank(char c) noexcept { return c == ' ' || c == '\t'; }
+
+// Cursor over one line; every Parse* returns false on malformed input
+class LineReader {
+ public:
+  explicit LineReader(std::string_view line) noexcept : line_(line) {}
+
+  [[nodiscard]] bool AtEnd() const noexcept { return pos_ >= line_.size(); }
+  [[nodiscard]] char Peek() const noexcept { return AtEnd() ? '\0' : line_[pos_]; }
+
+  bool Consume(char c) noexcept {
+    if (Peek() != c) {
+      return false;
+    }
+    ++pos_;
+    return true;
+  }
+
+  // At least one blank
+  bool SkipBlanks() noexcept {
+    const std::size_t start = pos_;
+    while (!AtEnd() && IsBlank(line_[pos_])) {
+      ++pos_;
+    }
+    return pos_ > start;
+  }
+
+  // "(seconds.fraction)" with up to 9 fraction digits kept; seconds past
+  // kMaxSeconds would overflow the nanosecond count
+  bool ParseTimestamp(std::int64_t& nanoseconds) noexcept {
+    if (!Consume('(')) {
+      return false;
+    }
+    std::int64_t seconds = 0;
+    std::size_t digits = 0;
+    for (; IsDigit(Peek()); ++pos_, ++digits) {
+      if (digits == 10) {
+        return false;
+      }
+      seconds = seconds * 10 + (line_[pos_] - '0');
+    }
+    if (digits == 0 || seconds > kMaxSeconds || !Consume('.')) {
+      return false;
+    }
+    std::int64_t fraction = 0;
+    for (digits = 0; IsDigit(Peek()); ++pos_, ++digits) {
+      if (digits < 9) {
+        fraction = fraction * 10 + (line_[pos_] - '0');
+      }
+    }
+    if (digits == 0 || !Consume(')')) {
+      return false;
+    }
+    nanoseconds = seconds * 1000000000 + fraction * kFractionScale[std::min<std::size_t>(digits, 9)];
+    return true;
+  }
+
+  // Interface name up to the next blank; the channel is its trailing number
+  bool ParseInterface(std::uint16_t& channel) noexcept {
+    const std::size_t start = pos_;
+    while (!AtEnd() && !IsBlank(line_[pos_])) {
+      ++pos_;
+    }
+    if (pos_ == start) {
+      return false;
+    }
+    std::size_t digits_start = pos_;
+    while (digits_start > start && IsDigit(line_[digits_start - 1])) {
+      --digits_start;
+    }
+    unsigned value = 0;
+    for (std::size_t i = digits_start; i < pos_ && i < digits_start + 5; ++i) {
+      value = value * 10 + static_cast<unsigned>(line_[i] - '0');
+    }
+    channel = static_cast<std::uint16_t>(value > 0xFFFF ? 0xFFFF : value);
+    return true;
+  }
+
+  // 3 hex digits for a standard, 8 for an extended identifier
+  bool ParseIdentifier(CanFrame& frame) noexcept {
+    std::uint32_t id = 0;
+    std::size_t digits = 0;
+    for (int value; (value = HexValue(Peek())) != kNotHex; ++pos_, ++digits) {
+      if (digits == 8) {
+        return false;
+      }
+      id = (id << 4) | static_cast<std::uint32_t>(value);
+    }
+    if (digits == 3 && id <= 0x7FF) {
+      frame.id = id;
+    } else if (digits == 8 && id <= 0x1FFFFFFF) {
+      frame.id = id;
+      frame.flags |= CanFrame::kExtended;
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+  // Hex byte pairs, optionally separated by '.'
+  bool ParsePayload(CanFrame& frame, std::size_t max_size) noexcept {
+    std::size_t size = 0;
+    while (true) {
+      Consume('.');
+      const int high = HexValue(Peek());
+      if (high == kNotHex) {
+        break;
+      }
+      ++pos_;
+      const int low = HexValue(Peek());
+      if (low == kNotHex || size == max_size) {
+        return false;
+      }
+      ++pos_;
+      frame.data[size++] = static_cast<std::uint8_t>((high << 4) | low);
+    }
+    frame.size = static_cast<std::uint8_t>(size);
+    return true;
+  }
+
+  // Only blanks may follow the frame
+  [[nodiscard]] bool AtEndOfFrame() noexcept {
+    SkipBlanks();
+    return AtEnd();
+  }
+
+  // "_<dlc>" after an 8-byte classic payload, the raw DLC of 9..15
+  void SkipRawDlc() noexcept {
+    if (Peek() == '_' && pos_ + 1 < line_.size() && HexValue(line_[pos_ + 1]) != kNotHex) {
+      pos_ += 2;
+    }
+  }
+
+ private:
+  std::string_view line_;
+  std::size_t pos_ = 0;
+};
+
+}  // namespace
+
+std::optional<CanFrame> CandumpParser::ParseLine(std::string_view line) noexcept {
+  while (!line.empty() && (line.back() == '\n' || line.back() == '\r')) {
+    line.remove_suffix(1);
+  }
+
+  CanFrame frame;
+  LineReader reader(line);
+  if (!reader.ParseTimestamp(frame.timestamp_ns) || !reader.SkipBlanks() ||
+      !reader.ParseInterface(frame.channel) || !reader.SkipBlanks() || !reader.ParseIdentifier(frame) ||
+      !reader.Consume('#')) {
+    return std::nullopt;
+  }
+
+  if (reader.Consume('#')) {
+    const int fd_flags = HexValue(reader.Peek());
+    if (fd_flags == kNotHex || !reader.Consume(reader.Peek())) {
+      return std::nullopt;
+    }
+    frame.flags |= CanFrame::kFd;
+    if (fd_flags & 0x1) {
+      frame.flags |= CanFrame::kBitRateSwitch;
+    }
+    if (fd_flags & 0x2) {
+      frame.flags |= CanFrame::kErrorStateIndicator;
+    }
+    if (!reader.ParsePayload(frame, CanFrame::kMaxPayload) || !CanFrame::IsFdSize(frame.size)) {
+      return std::nullopt;
+    }
+  } else if (reader.Consume('R')) {
+    frame.flags |= CanFrame::kRemote;
+    if (IsDigit(reader.Peek())) {
+      const int dlc = reader.Peek() - '0';
+      if (dlc > 8) {
+        return std::nullopt;
+      }
+      reader.Consume(reader.Peek());
+      frame.size = static_cast<std::uint8_t>(dlc);
+    }
+  } else {
+    if (!reader.ParsePayload(frame, 8)) {
+      return std::nullopt;
+    }
+    if (frame.size == 8) {
+      reader.SkipRawDlc();
+    }
+  }
+
+  if (!reader.AtEndOfFrame()) {
+    return std::nullopt;
+  }
+  return frame;
+}
+
+}  // namespace decoder
+}  // namespace dbc_parser
@@ -0,0 +1,43 @@
+#ifndef DBC_PARSER_DECODER_CANDUMP_PARSER_H_
+#define DBC_PARSER_DECODER_CANDUMP_PARSER_H_
+
+#include <optional>
+#include <string_view>
+
+#include "dbc_parser/decoder/can_frame.h"
+
+namespace dbc_parser {
+namespace decoder {
+
+/**
+ * @brief Parses lines of Linux `candump -L` logs.
+ *
+ * Accepted forms, as written by can-utils:
+ * - `(1436509052.249713) can0 123#DEADBEEF` classic frame, 3 hex digits for
+ *   standard and 8 for extended IDs
+ * - `(1436509052.249713) can0 123#R` or `123#R5` remote frame, optional DLC
+ * - `(1436509052.249713) can1 1F334455##1112233` CAN FD frame; the digit after
+ *   `##` holds the BRS (1) and ESI (2) flags
+ *
+ * The channel is the number at the end of the interface name (can1 -> 1).
+ * Hand-written rather than a PEGTL grammar: logs have billions of lines in a
+ * fixed format.
+ */
+class CandumpParser {
+ public:
+  CandumpParser() = delete;
+
+  /**
+   * @brief Parses one log line.
+   *
+   * @param line The line, with or without its trailing newline
+   * @return std::optional<CanFrame> The frame, or std::nullopt if the line is
+   *         not a well-formed frame
+   */
+  [[nodiscard]] static std::optional<CanFrame> ParseLine(std::string_view line) noexcept;
+};
+
+}  // namespace decoder
+}  // namespace dbc_parser
+
+#endif  // DBC_PARSER_DECODER_CANDUMP_PARSER_H_
@@ -0,0 +1,116 @@
+#include "dbc_parser/decoder/chunk_pipeline.h"
+
+#include <iterator>
+
+#include "dbc_parser/decoder/signal_decoder.h"
+
+namespace dbc_parser {
+namespace decoder {
+
+DecodedFrame DecodedChunk::Add(const CanFrame& frame, const FrameDecoder& decoder, bool keep_frames,
+                               std::vector<double>& scratch) {
+  ++stats.frames;
+  const FrameDecoder::MessageEntry* message = decoder.Find(frame.dbc_id());
+  double* out = scratch.data();
+  const CanFrame* kept = &frame;
+  if (keep_frames) {
+    value_offsets.push_back(static_cast<std::uint32_t>(values.size()));
+    if (message != nullptr) {
+      values.resize(values.size() + message->signal_count);
+      out = values.data() + value_offsets.back();
+    }
+    frames.push_back(frame);
+    kept = &frames.back();
+    messages.push_back(message);
+    newest_ns = std::max(newest_ns, frame.timestamp_ns);
+  }
+  if (message == nullptr) {
+    ++stats.unknown_frames;
+    return {kept, nullptr, nullptr};
+  }
+  stats.signals += SignalDecoder::DecodeMessage(message->layouts, message->plans, message->signal_count, frame.data,
+                                               frame.size, out);
+  return {kept, message, out};
+}
+
+void DecodedChunk::SortByTime() {
+  order.resize(frames.size());
+  for (std::uint32_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  const auto by_time = [this](std::uint32_t a, std::uint32_t b) {
+    return frames[a].timestamp_ns < frames[b].timestamp_ns;
+  };
+  if (!std::is_sorted(order.begin(), order.end(), by_time)) {
+    std::stable_sort(order.begin(), order.end(), by_time);
+  }
+}
+
+void DecodedChunk::Report(const LogDecodeOptions& options, std::size_t index, std::int64_t base_ns) const {
+  if (!options.on_chunk) {
+    return;
+  }
+  LogChunk chunk;
+  chunk.index = index;
+  chunk.offset = offset;
+  chunk.size = size;
+  chunk.base_ns = base_ns;
+  chunk.frames = frames.data();
+  chunk.frame_count = frames.size();
+  options.on_chunk(chunk);
+}
+
+void AddCounts(LogDecodeStats& total, const LogDecodeStats& chunk) noexcept {
+  total.lines += chunk.lines;
+  total.frames += chunk.frames;
+  total.malformed_lines += chunk.malformed_lines;
+  total.unknown_frames += chunk.unknown_frames;
+  total.signals += chunk.signals;
+}
+
+void ChunkMerger::Add(std::unique_ptr<DecodedChunk> chunk) {
+  incoming_.clear();
+  incoming_.reserve(chunk->order.size());
+  for (const std::uint32_t index : chunk->order) {
+    const FrameDecoder::MessageEntry* message = chunk->messages[index];
+    const double* values = message != nullptr ? chunk->values.data() + chunk->value_offsets[index] : nullptr;
+    incoming_.push_back({chunk->frames[index].timestamp_ns, {&chunk->frames[index], message, values}});
+  }
+
+  merged_.clear();
+  std::merge(pending_.begin(), pending_.end(), incoming_.begin(), incoming_.end(), std::back_inserter(merged_),
+             [](const PendingFrame& a, const PendingFrame& b) { return a.timestamp_ns < b.timestamp_ns; });
+
+  // Frames up to the newest timestamp of the earlier chunks cannot be
+  // preceded by anything in later chunks
+  pending_.clear();
+  for (const PendingFrame& frame : merged_) {
+    if (frame.timestamp_ns <= watermark_ns_) {
+      Emit(frame);
+    } else {
+      pending_.push_back(frame);
+    }
+  }
+  watermark_ns_ = std::max(watermark_ns_, chunk->newest_ns);
+  // pending_ now only refers to this chunk's frames
+  current_ = std::move(chunk);
+}
+
+void ChunkMerger::Finish() {
+  for (const PendingFrame& frame : pending_) {
+    Emit(frame);
+  }
+  pending_.clear();
+  current_.reset();
+}
+
+void ChunkMerger::Emit(const PendingFrame& frame) {
+  if (frame.timestamp_ns < last_emitted_ns_) {
+    ++late_frames_;
+  }
+  last_emitted_ns_ = std::max(last_emitted_ns_, frame.timestamp_ns);
+  on_frame_(frame.decoded);
+}
+
+}  // namespace decoder
+}  // namespace dbc_parser
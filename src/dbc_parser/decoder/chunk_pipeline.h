@@ -0,0 +1,193 @@
+#ifndef DBC_PARSER_DECODER_CHUNK_PIPELINE_H_
+#define DBC_PARSER_DECODER_CHUNK_PIPELINE_H_
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "dbc_parser/decoder/can_frame.h"
+#include "dbc_parser/decoder/frame_decoder.h"
+#include "dbc_parser/decoder/log_decoder.h"
+
+namespace dbc_parser {
+namespace decoder {
+
+/**
+ * @brief Frames and values of one decoded chunk of a log, kept until the
+ *        merge has emitted them.
+ *
+ * Internal to the log readers; see LogDecoder.
+ */
+struct DecodedChunk {
+  std::vector<CanFrame> frames;
+  std::vector<const FrameDecoder::MessageEntry*> messages;
+  std::vector<std::uint32_t> value_offsets;
+  std::vector<double> values;
+  std::vector<std::uint32_t> order;  ///< Frame indices by timestamp
+  std::int64_t newest_ns = std::numeric_limits<std::int64_t>::min();
+  std::int64_t elapsed_ns = 0;  ///< Sum of the chunk's deltas, for relative timestamps
+  std::size_t offset = 0;       ///< First byte of the chunk in the log
+  std::size_t size = 0;         ///< Bytes of the chunk
+  LogDecodeStats stats;
+
+  /**
+   * @brief Counts a frame and decodes its signals; keeps both if keep_frames.
+   *
+   * @param frame The frame
+   * @param decoder Message index
+   * @param keep_frames Whether the frame goes to the merge
+   * @param scratch Values of frames that are not kept, MaxSignalCount() long
+   * @return DecodedFrame The frame and its values, valid until the next Add
+   */
+  DecodedFrame Add(const CanFrame& frame, const FrameDecoder& decoder, bool keep_frames, std::vector<double>& scratch);
+
+  /**
+   * @brief Fills order; call once after the last Add.
+   */
+  void SortByTime();
+
+  /**
+   * @brief Hands the chunk to LogDecodeOptions::on_chunk, if set.
+   *
+   * @param options Options of the reader
+   * @param index Position of the chunk in the log
+   * @param base_ns Time the chunk's relative timestamps start from
+   */
+  void Report(const LogDecodeOptions& options, std::size_t index, std::int64_t base_ns) const;
+};
+
+/**
+ * @brief Sums the counters of a chunk into a total.
+ */
+void AddCounts(LogDecodeStats& total, const LogDecodeStats& chunk) noexcept;
+
+/**
+ * @brief Emits frames in timestamp order across consecutive chunks.
+ *
+ * A frame is held back until every chunk that could still hold an older frame
+ * has been seen; frames older than an emitted one count as late_frames.
+ */
+class ChunkMerger {
+ public:
+  explicit ChunkMerger(const LogDecoder::FrameCallback& on_frame) : on_frame_(on_frame) {}
+
+  void Add(std::unique_ptr<DecodedChunk> chunk);
+  void Finish();
+
+  [[nodiscard]] std::uint64_t late_frames() const noexcept { return late_frames_; }
+
+ private:
+  struct PendingFrame {
+    std::int64_t timestamp_ns;
+    DecodedFrame decoded;
+  };
+
+  void Emit(const PendingFrame& frame);
+
+  const LogDecoder::FrameCallback& on_frame_;
+  std::unique_ptr<DecodedChunk> current_;
+  std::vector<PendingFrame> pending_;
+  std::vector<PendingFrame> incoming_;
+  std::vector<PendingFrame> merged_;
+  std::int64_t watermark_ns_ = std::numeric_limits<std::int64_t>::min();
+  std::int64_t last_emitted_ns_ = std::numeric_limits<std::int64_t>::min();
+  std::uint64_t late_frames_ = 0;
+};
+
+/**
+ * @brief Processes tasks on worker threads and consumes the results in task
+ *        order on the calling thread.
+ *
+ * next_task is called under a lock, so it may advance a sequential cursor;
+ * it returns std::nullopt when there is no more work. Workers pause before
+ * claiming a task while max_in_flight results wait to be consumed.
+ *
+ * @param threads Worker threads, at least 1
+ * @param max_in_flight Results waiting for consume before workers pause
+ * @param next_task Returns the next task, in order
+ * @param process Turns a task into a result, on the worker numbered by its
+ *        second argument, from 0
+ * @param consume Receives the results in task order
+ */
+template <typename Task, typename Result>
+void RunChunkPipeline(std::size_t threads, std::size_t max_in_flight,
+                      const std::function<std::optional<Task>()>& next_task,
+                      const std::function<std::unique_ptr<Result>(Task&, std::size_t)>& process,
+                      const std::function<void(std::unique_ptr<Result>)>& consume) {
+  std::mutex mutex;
+  std::condition_variable result_ready;
+  std::condition_variable result_consumed;
+  std::size_t claimed = 0;
+  std::size_t consumed = 0;
+  bool exhausted = false;
+  std::map<std::size_t, std::unique_ptr<Result>> results;
+
+  const auto worker = [&](std::size_t worker_index) {
+    while (true) {
+      std::optional<Task> task;
+      std::size_t index;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        result_consumed.wait(lock, [&] { return exhausted || claimed < consumed + max_in_flight; });
+        if (!exhausted) {
+          task = next_task();
+          exhausted = !task.has_value();
+        }
+        if (exhausted) {
+          lock.unlock();
+          result_ready.notify_all();
+          result_consumed.notify_all();
+          return;
+        }
+        index = claimed++;
+      }
+      std::unique_ptr<Result> result = process(*task, worker_index);
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        results[index] = std::move(result);
+      }
+      result_ready.notify_all();
+    }
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(threads);
+  for (std::size_t i = 0; i < std::max<std::size_t>(threads, 1); ++i) {
+    workers.emplace_back(worker, i);
+  }
+
+  for (std::size_t index = 0;; ++index) {
+    std::unique_ptr<Result> result;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      result_ready.wait(lock, [&] { return results.count(index) != 0 || (exhausted && claimed == index); });
+      const auto found = results.find(index);
+      if (found == results.end()) {
+        break;
+      }
+      result = std::move(found->second);
+      results.erase(found);
+      consumed = index + 1;
+    }
+    result_consumed.notify_all();
+    consume(std::move(result));
+  }
+  for (std::thread& thread : workers) {
+    thread.join();
+  }
+}
+
+}  // namespace decoder
+}  // namespace dbc_parser
+
+#endif  // DBC_PARSER_DECODER_CHUNK_PIPELINE_H_
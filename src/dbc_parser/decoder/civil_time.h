@@ -0,0 +1,39 @@
+#ifndef DBC_PARSER_DECODER_CIVIL_TIME_H_
+#define DBC_PARSER_DECODER_CIVIL_TIME_H_
+
+#include <cstdint>
+
+namespace dbc_parser {
+namespace decoder {
+
+/**
+ * @brief Nanoseconds since the Unix epoch of a UTC date and time.
+ *
+ * Log headers store the wall-clock start of a measurement without a time
+ * zone; readers report it as if it were UTC.
+ *
+ * @param year Year, e.g. 2019
+ * @param month Month, 1..12
+ * @param day Day of the month, 1..31
+ * @param hour Hour, 0..23
+ * @param minute Minute, 0..59
+ * @param second_ns Nanoseconds into the minute
+ * @return std::int64_t Nanoseconds since 1970-01-01 00:00 UTC
+ */
+constexpr std::int64_t UtcNanoseconds(std::int64_t year, unsigned month, unsigned day, unsigned hour,
+                                      unsigned minute, std::int64_t second_ns) noexcept {
+  // Days since 1970-01-01 of the proleptic Gregorian date, counted in eras
+  // of 400 years that start on March 1st
+  year -= month <= 2;
+  const std::int64_t era = (year >= 0 ? year : year - 399) / 400;
+  const auto year_of_era = static_cast<unsigned>(year - era * 400);
+  const unsigned day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+  const unsigned day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+  const std::int64_t days = era * 146097 + static_cast<std::int64_t>(day_of_era) - 719468;
+  return ((days * 24 + hour) * 60 + minute) * 60 * 1000000000 + second_ns;
+}
+
+}  // namespace decoder
+}  // namespace dbc_parser
+
+#endif  // DBC_PARSER_DECODER_CIVIL_TIME_H_
@@ -0,0 +1,40 @@
+#include "dbc_parser/decoder/extraction_plan.h"
+
+namespace dbc_parser {
+namespace decoder {
+
+ExtractionPlan ExtractionPlan::For(const SignalLayout& layout) noexcept {
+  ExtractionPlan plan;
+  const unsigned length = layout.length;
+  if (length == 0 || length > 64) {
+    return plan;
+  }
+  // Bits are counted from the most significant bit of the first byte for
+  // Motorola signals, from the least significant one for Intel signals, so
+  // that in both cases the signal covers [shift, shift + length) past
+  // word_offset
+  const unsigned first_byte = layout.start_bit / 8u;
+  const unsigned bit = layout.start_bit % 8u;
+  const unsigned shift = layout.is_little_endian() ? bit : 7u - bit;
+  const unsigned required_size = first_byte + (shift + length + 7u) / 8u;
+  if (required_size > CanFrame::kMaxPayload) {
+    return plan;
+  }
+  plan.required_size = static_cast<std::uint16_t>(required_size);
+  plan.word_offset = static_cast<std::uint8_t>(first_byte);
+  plan.shift = static_cast<std::uint8_t>(shift);
+  plan.length = static_cast<std::uint8_t>(length);
+  if (layout.is_little_endian()) {
+    plan.flags |= kLittleEndian;
+  }
+  if (layout.is_signed()) {
+    plan.flags |= kSigned;
+  }
+  if (shift + length > 64u) {
+    plan.flags |= kSpansNineBytes;
+  }
+  return plan;
+}
+
+}  // namespace decoder
+}  // namespace dbc_parser
@@ -0,0 +1,179 @@
+#ifndef DBC_PARSER_DECODER_EXTRACTION_PLAN_H_
+#define DBC_PARSER_DECODER_EXTRACTION_PLAN_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "dbc_parser/common/common_types.h"
+#include "dbc_parser/decoder/can_frame.h"
+
+namespace dbc_parser {
+namespace decoder {
+
+using parser::SignalLayout;
+
+/**
+ * @brief A payload copied into a zero-padded buffer.
+ *
+ * Plans load and store whole 64-bit words, so the buffer extends eight bytes
+ * past the largest CAN FD payload: a word can start at any byte a signal
+ * starts in.
+ */
+struct PaddedPayload {
+  static constexpr std::size_t kCapacity = CanFrame::kMaxPayload + 8;
+
+  std::uint8_t bytes[kCapacity];
+  std::size_t size;  ///< Payload bytes, at most CanFrame::kMaxPayload
+
+  /**
+   * @brief Copies a payload; bytes past CanFrame::kMaxPayload are dropped.
+   */
+  PaddedPayload(const std::uint8_t* data, std::size_t data_size) noexcept
+      : size(data_size < CanFrame::kMaxPayload ? data_size : CanFrame::kMaxPayload) {
+    std::memcpy(bytes, data, size);
+    std::memset(bytes + size, 0, kCapacity - size);
+  }
+};
+
+/**
+ * @brief How to move one signal's bits in and out of a payload, precomputed
+ *        from its SignalLayout.
+ *
+ * A signal of up to 64 bits spans at most nine bytes. The plan loads the
+ * 64-bit word at the signal's first byte, shifts the signal into place and,
+ * for the rare signal that spans nine bytes, merges the ninth byte; there is
+ * no loop over bytes, so the cost does not depend on where in a 64-byte
+ * CAN FD payload the signal sits. Plans index a PaddedPayload and check the
+ * payload size with FitsIn first.
+ */
+struct ExtractionPlan {
+  static constexpr std::uint16_t kNeverFits = 0xFFFF;      ///< required_size of unusable signals
+  static constexpr std::uint8_t kLittleEndian = 1u << 0;   ///< Intel byte order
+  static constexpr std::uint8_t kSigned = 1u << 1;         ///< Sign-extend the raw value
+  static constexpr std::uint8_t kSpansNineBytes = 1u << 2;  ///< Merge the byte after the word
+
+  std::uint16_t required_size = kNeverFits;  ///< Payload bytes the signal needs
+  std::uint8_t word_offset = 0;              ///< First byte of the loaded word
+  std::uint8_t shift = 0;                    ///< Intel: right shift of the word; Motorola: left shift
+  std::uint8_t length = 0;                   ///< Length in bits
+  std::uint8_t flags = 0;                    ///< Combination of the k* flag bits above
+
+  /**
+   * @brief Computes the plan of a signal.
+   *
+   * Signals with a length outside 1..64 bits or any bit past the 64th
+   * payload byte get required_size kNeverFits.
+   */
+  [[nodiscard]] static ExtractionPlan For(const SignalLayout& layout) noexcept;
+
+  [[nodiscard]] bool FitsIn(std::size_t payload_size) const noexcept { return required_size <= payload_size; }
+
+  /**
+   * @brief Reads the raw value, sign-extended for signed signals.
+   *
+   * @param payload A payload the signal fits in
+   */
+  [[nodiscard]] std::uint64_t Extract(const PaddedPayload& payload) const noexcept {
+    const std::uint8_t* word = payload.bytes + word_offset;
+    const unsigned unused = 64u - length;
+    std::uint64_t raw;
+    if (flags & kLittleEndian) {
+      raw = LoadLittleEndian(word) >> shift;
+      if (flags & kSpansNineBytes) {
+        raw |= std::uint64_t{word[8]} << (64u - shift);
+      }
+      raw <<= unused;
+    } else {
+      raw = LoadBigEndian(word) << shift;
+      if (flags & kSpansNineBytes) {
+        raw |= word[8] >> (8u - shift);
+      }
+    }
+    // The signal now fills the top length bits
+    if (flags & kSigned) {
+      return static_cast<std::uint64_t>(static_cast<std::int64_t>(raw) >> unused);
+    }
+    return raw >> unused;
+  }
+
+  /**
+   * @brief Writes the low length bits of raw, leaving the other bits of the
+   *        payload unchanged.
+   *
+   * @param raw Raw value; higher bits are ignored
+   * @param payload A payload the signal fits in
+   */
+  void Insert(std::uint64_t raw, PaddedPayload& payload) const noexcept {
+    std::uint8_t* word = payload.bytes + word_offset;
+    const std::uint64_t mask = ~std::uint64_t{0} >> (64u - length);
+    raw &= mask;
+    if (flags & kLittleEndian) {
+      StoreLittleEndian(word, (LoadLittleEndian(word) & ~(mask << shift)) | (raw << shift));
+      if (flags & kSpansNineBytes) {
+        const unsigned low_bits = 64u - shift;
+        word[8] = static_cast<std::uint8_t>((word[8] & ~(mask >> low_bits)) | (raw >> low_bits));
+      }
+    } else if (flags & kSpansNineBytes) {
+      // The signal's top bits end the word, its last spill bits start the
+      // ninth byte
+      const unsigned spill = shift + length - 64u;
+      StoreBigEndian(word, (LoadBigEndian(word) & ~(mask >> spill)) | (raw >> spill));
+      const unsigned spill_mask = (1u << spill) - 1u;
+      word[8] = static_cast<std::uint8_t>((word[8] & ~(spill_mask << (8u - spill))) |
+                                          ((raw & spill_mask) << (8u - spill)));
+    } else {
+      const unsigned low = 64u - shift - length;
+      StoreBigEndian(word, (LoadBigEndian(word) & ~(mask << low)) | (raw << low));
+    }
+  }
+
+ private:
+  static std::uint64_t ByteSwap(std::uint64_t word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_bswap64(word);
+#else
+    std::uint64_t swapped = 0;
+    for (int i = 0; i < 8; ++i) {
+      swapped = (swapped << 8) | ((word >> (8 * i)) & 0xFF);
+    }
+    return swapped;
+#endif
+  }
+
+  static constexpr bool kHostIsLittleEndian =
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+      false;
+#else
+      true;
+#endif
+
+  static std::uint64_t LoadLittleEndian(const std::uint8_t* bytes) noexcept {
+    std::uint64_t word;
+    std::memcpy(&word, bytes, sizeof(word));
+    return kHostIsLittleEndian ? word : ByteSwap(word);
+  }
+
+  static std::uint64_t LoadBigEndian(const std::uint8_t* bytes) noexcept {
+    std::uint64_t word;
+    std::memcpy(&word, bytes, sizeof(word));
+    return kHostIsLittleEndian ? ByteSwap(word) : word;
+  }
+
+  static void StoreLittleEndian(std::uint8_t* bytes, std::uint64_t word) noexcept {
+    word = kHostIsLittleEndian ? word : ByteSwap(word);
+    std::memcpy(bytes, &word, sizeof(word));
+  }
+
+  static void StoreBigEndian(std::uint8_t* bytes, std::uint64_t word) noexcept {
+    word = kHostIsLittleEndian ? ByteSwap(word) : word;
+    std::memcpy(bytes, &word, sizeof(word));
+  }
+};
+
+static_assert(sizeof(ExtractionPlan) == 6, "ExtractionPlan must stay packed");
+
+}  // namespace decoder
+}  // namespace dbc_parser
+
+#endif  // DBC_PARSER_DECODER_EXTRACTION_PLAN_H_
@@ -0,0 +1,95 @@
+#include "dbc_parser/decoder/frame_decoder.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "dbc_parser/decoder/j1939_id.h"
+#include "dbc_parser/decoder/signal_decoder.h"
+#include "dbc_parser/decoder/signal_encoder.h"
+
+namespace dbc_parser {
+namespace decoder {
+
+FrameDecoder::FrameDecoder(const parser::DbcFile& dbc_file, FrameDecoderOptions options) {
+  standard_index_.fill(kNoEntry);
+  plans_.reserve(dbc_file.signal_layouts.size());
+  for (const parser::SignalLayout& layout : dbc_file.signal_layouts) {
+    plans_.push_back(ExtractionPlan::For(layout));
+  }
+  entries_.reserve(dbc_file.messages_detailed.size());
+  for (const auto& [id, message] : dbc_file.messages_detailed) {
+    MessageEntry entry;
+    entry.message = &message;
+    entry.layouts = dbc_file.SignalLayoutsOf(message);
+    entry.plans = plans_.data() + message.first_signal;
+    entry.signal_count = message.signal_count;
+
+    const auto index = static_cast<std::int32_t>(entries_.size());
+    const auto dbc_id = static_cast<std::uint32_t>(id);
+    if (dbc_id < kStandardIds) {
+      standard_index_[dbc_id] = index;
+    } else {
+      other_index_.emplace(dbc_id, index);
+    }
+    // messages_detailed is ordered by ID, so each PGN keeps its lowest ID
+    const bool extended = (dbc_id & CanFrame::kDbcExtendedIdFlag) != 0;
+    if (extended && (message.frame_format == parser::FrameFormat::kJ1939 || options.j1939_all_extended)) {
+      pgn_index_.emplace(J1939Id::Pgn(dbc_id & ~CanFrame::kDbcExtendedIdFlag), index);
+    }
+    max_signal_count_ = std::max<std::size_t>(max_signal_count_, message.signal_count);
+    entries_.push_back(entry);
+  }
+}
+
+const FrameDecoder::MessageEntry* FrameDecoder::Find(std::uint32_t dbc_id) const noexcept {
+  std::int32_t index = kNoEntry;
+  if (dbc_id < kStandardIds) {
+    index = standard_index_[dbc_id];
+  } else if (auto it = other_index_.find(dbc_id); it != other_index_.end()) {
+    index = it->second;
+  } else if ((dbc_id & CanFrame::kDbcExtendedIdFlag) != 0 && !pgn_index_.empty()) {
+    return FindPgn(J1939Id::Pgn(dbc_id & ~CanFrame::kDbcExtendedIdFlag));
+  }
+  return index == kNoEntry ? nullptr : &entries_[static_cast<std::size_t>(index)];
+}
+
+const FrameDecoder::MessageEntry* FrameDecoder::FindPgn(std::uint32_t pgn) const noexcept {
+  auto it = pgn_index_.find(pgn);
+  return it == pgn_index_.end() ? nullptr : &entries_[static_cast<std::size_t>(it->second)];
+}
+
+std::optional<std::size_t> FrameDecoder::Decode(const CanFrame& frame, double* out) const noexcept {
+  const MessageEntry* entry = Find(frame.dbc_id());
+  if (entry == nullptr) {
+    return std::nullopt;
+  }
+  return SignalDecoder::DecodeMessage(entry->layouts, entry->plans, entry->signal_count, frame.data, frame.size,
+                                      out);
+}
+
+std::optional<std::size_t> FrameDecoder::Encode(std::uint32_t dbc_id, const double* values,
+                                                CanFrame& frame) const noexcept {
+  const MessageEntry* entry = Find(dbc_id);
+  if (entry == nullptr) {
+    return std::nullopt;
+  }
+  const parser::DbcFile::MessageDef& message = *entry->message;
+  frame.id = dbc_id & ~CanFrame::kDbcExtendedIdFlag;
+  frame.flags = (dbc_id & CanFrame::kDbcExtendedIdFlag) != 0 ? CanFrame::kExtended : 0;
+  const auto size = static_cast<std::size_t>(std::clamp(message.size, 0, static_cast<int>(CanFrame::kMaxPayload)));
+  if (message.is_fd()) {
+    frame.flags |= CanFrame::kFd;
+    if (message.bit_rate_switch) {
+      frame.flags |= CanFrame::kBitRateSwitch;
+    }
+    frame.size = CanFrame::FdSizeFor(size);
+  } else {
+    frame.size = static_cast<std::uint8_t>(std::min<std::size_t>(size, 8));
+  }
+  std::fill(std::begin(frame.data), std::end(frame.data), std::uint8_t{0});
+  return SignalEncoder::EncodeMessage(entry->layouts, entry->plans, entry->signal_count, values, frame.data,
+                                      frame.size);
+}
+
+}  // namespace decoder
+}  // namespace dbc_parser
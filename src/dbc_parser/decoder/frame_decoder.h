@@ -0,0 +1,135 @@
+#ifndef DBC_PARSER_DECODER_FRAME_DECODER_H_
+#define DBC_PARSER_DECODER_FRAME_DECODER_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "dbc_parser/decoder/can_frame.h"
+#include "dbc_parser/decoder/extraction_plan.h"
+#include "dbc_parser/parser/dbc_file_parser.h"
+
+namespace dbc_parser {
+namespace decoder {
+
+/**
+ * @brief Tuning of FrameDecoder.
+ */
+struct FrameDecoderOptions {
+  /// Index every extended message by PGN, not only J1939PG messages; for
+  /// J1939 files that set neither VFrameFormat nor ProtocolType
+  bool j1939_all_extended = false;
+};
+
+/**
+ * @brief Decodes recorded frames through the messages of a parsed DbcFile.
+ *
+ * Builds an ID index and the ExtractionPlan of every signal once; standard
+ * IDs are looked up in a flat table, extended IDs in a hash map. Decoding is
+ * const and keeps no state, so one FrameDecoder can be shared by any number
+ * of threads. The DbcFile must outlive the decoder.
+ *
+ * J1939 messages are also indexed by PGN. The same parameter group arrives
+ * from any source address and with any priority, so an extended ID without
+ * an exact match is looked up again by its PGN.
+ */
+class FrameDecoder {
+ public:
+  /**
+   * @brief A message of the DbcFile, as needed for decoding.
+   */
+  struct MessageEntry {
+    const parser::DbcFile::MessageDef* message = nullptr;  ///< Message definition
+    const parser::SignalLayout* layouts = nullptr;         ///< signal_count contiguous layouts
+    const ExtractionPlan* plans = nullptr;                 ///< The plans of layouts
+    std::uint32_t signal_count = 0;                        ///< Number of signals
+  };
+
+  /**
+   * @brief Indexes the messages of a parsed file.
+   *
+   * @param dbc_file Parsed file; must outlive the decoder
+   * @param options Which messages to index by PGN
+   */
+  explicit FrameDecoder(const parser::DbcFile& dbc_file, FrameDecoderOptions options = {});
+
+  // Entries point into plans_, which a copy would not share
+  FrameDecoder(const FrameDecoder&) = delete;
+  FrameDecoder& operator=(const FrameDecoder&) = delete;
+  FrameDecoder(FrameDecoder&&) = default;
+  FrameDecoder& operator=(FrameDecoder&&) = default;
+
+  /**
+   * @brief Looks up a message by its DBC ID (bit 31 set for extended IDs),
+   *        falling back to the PGN of extended IDs; see FindPgn.
+   *
+   * @return const MessageEntry* The message, or nullptr if the file does not
+   *         define it
+   */
+  [[nodiscard]] const MessageEntry* Find(std::uint32_t dbc_id) const noexcept;
+
+  /**
+   * @brief Looks up a J1939 message by its PGN, see J1939Id::Pgn.
+   *
+   * @return const MessageEntry* The message with the lowest ID among the
+   *         J1939 messages of the PGN, or nullptr if there is none
+   */
+  [[nodiscard]] const MessageEntry* FindPgn(std::uint32_t pgn) const noexcept;
+
+  /**
+   * @brief Decodes all signals of a frame's message.
+   *
+   * @param frame Recorded frame
+   * @param out Output array of at least MaxSignalCount() values; see
+   *        SignalDecoder::DecodeMessage
+   * @return std::optional<std::size_t> Number of signals that produced a value,
+   *         or std::nullopt if the frame's ID is not in the file
+   */
+  [[nodiscard]] std::optional<std::size_t> Decode(const CanFrame& frame, double* out) const noexcept;
+
+  /**
+   * @brief Builds a frame of a message from signal values.
+   *
+   * Sets the ID and the extended, CAN FD and bit rate switch flags from the
+   * message definition, and the payload size to the message size, rounded up
+   * to a CAN FD size for CAN FD messages; see SignalEncoder::EncodeMessage
+   * for the values. timestamp_ns and channel are left unchanged.
+   *
+   * @param dbc_id DBC ID of the message (bit 31 set for extended IDs)
+   * @param values Physical values, one per signal of the message
+   * @param frame Output frame
+   * @return std::optional<std::size_t> Number of signals written, or
+   *         std::nullopt if the ID is not in the file
+   */
+  [[nodiscard]] std::optional<std::size_t> Encode(std::uint32_t dbc_id, const double* values,
+                                                  CanFrame& frame) const noexcept;
+
+  /**
+   * @brief Largest number of signals in one message.
+   */
+  [[nodiscard]] std::size_t MaxSignalCount() const noexcept { return max_signal_count_; }
+
+  /**
+   * @brief Number of indexed messages.
+   */
+  [[nodiscard]] std::size_t MessageCount() const noexcept { return entries_.size(); }
+
+ private:
+  static constexpr std::uint32_t kStandardIds = 0x800;
+  static constexpr std::int32_t kNoEntry = -1;
+
+  std::vector<MessageEntry> entries_;
+  std::vector<ExtractionPlan> plans_;  ///< Indexed by signal ID, like DbcFile::signal_layouts
+  std::array<std::int32_t, kStandardIds> standard_index_;
+  std::unordered_map<std::uint32_t, std::int32_t> other_index_;
+  std::unordered_map<std::uint32_t, std::int32_t> pgn_index_;
+  std::size_t max_signal_count_ = 0;
+};
+
+}  // namespace decoder
+}  // namespace dbc_parser
+
+#endif  // DBC_PARSER_DECODER_FRAME_DECODER_H_
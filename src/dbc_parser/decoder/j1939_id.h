@@ -0,0 +1,51 @@
+#ifndef DBC_PARSER_DECODER_J1939_ID_H_
+#define DBC_PARSER_DECODER_J1939_ID_H_
+
+#include <cstdint>
+
+namespace dbc_parser {
+namespace decoder {
+
+/**
+ * @brief Fields of a 29-bit J1939 identifier.
+ *
+ * Bits 26-28 hold the priority, bits 8-25 the parameter group number (PGN)
+ * and bits 0-7 the source address. For PDU1 groups (PDU format below 240)
+ * the low PGN byte is the destination address instead and not part of the
+ * PGN.
+ */
+struct J1939Id {
+  static constexpr std::uint32_t kTpConnectionManagementPgn = 0xEC00;  ///< TP.CM
+  static constexpr std::uint32_t kTpDataTransferPgn = 0xEB00;          ///< TP.DT
+  static constexpr std::uint8_t kGlobalAddress = 0xFF;                 ///< Destination of broadcasts
+
+  [[nodiscard]] static constexpr std::uint8_t Priority(std::uint32_t id) noexcept {
+    return static_cast<std::uint8_t>((id >> 26) & 0x7);
+  }
+
+  [[nodiscard]] static constexpr std::uint8_t SourceAddress(std::uint32_t id) noexcept {
+    return static_cast<std::uint8_t>(id & 0xFF);
+  }
+
+  [[nodiscard]] static constexpr bool IsPdu1(std::uint32_t id) noexcept { return ((id >> 16) & 0xFF) < 240; }
+
+  /**
+   * @brief The PGN, with the destination address of PDU1 groups cleared.
+   */
+  [[nodiscard]] static constexpr std::uint32_t Pgn(std::uint32_t id) noexcept {
+    const std::uint32_t pgn = (id >> 8) & 0x3FFFF;
+    return IsPdu1(id) ? (pgn & ~std::uint32_t{0xFF}) : pgn;
+  }
+
+  /**
+   * @brief The destination address of PDU1 groups, kGlobalAddress for PDU2.
+   */
+  [[nodiscard]] static constexpr std::uint8_t DestinationAddress(std::uint32_t id) noexcept {
+    return IsPdu1(id) ? static_cast<std::uint8_t>((id >> 8) & 0xFF) : kGlobalAddress;
+  }
+};
+
+}  // namespace decoder
+}  // namespace dbc_parser
+
+#endif  // DBC_PARSER_DECODER_J1939_ID_H_
@@ -0,0 +1,161 @@
+#include "dbc_parser/decoder/j1939_reassembler.h"
+
+#include <cstring>
+#include <utility>
+
+#include "dbc_parser/decoder/signal_decoder.h"
+
+namespace dbc_parser {
+namespace decoder {
+namespace {
+
+// TP.CM control bytes
+constexpr std::uint8_t kRequestToSend = 16;
+constexpr std::uint8_t kBroadcastAnnounce = 32;
+constexpr std::uint8_t kAbort = 255;
+
+constexpr std::size_t kPacketBytes = 7;
+
+}  // namespace
+
+J1939Reassembler::J1939Reassembler(const FrameDecoder& decoder, TransferCallback on_transfer,
+                                   J1939ReassemblyOptions options)
+    : decoder_(decoder),
+      on_transfer_(std::move(on_transfer)),
+      options_(options),
+      values_(decoder.MaxSignalCount()) {}
+
+bool J1939Reassembler::Add(const CanFrame& frame) {
+  if (!frame.is_extended()) {
+    return false;
+  }
+  const std::uint32_t pgn = J1939Id::Pgn(frame.id);
+  if (pgn != J1939Id::kTpConnectionManagementPgn && pgn != J1939Id::kTpDataTransferPgn) {
+    return false;
+  }
+  if (frame.size < 8) {
+    ++stats_.malformed;
+  } else if (pgn == J1939Id::kTpConnectionManagementPgn) {
+    OnConnectionManagement(frame);
+  } else {
+    OnDataTransfer(frame);
+  }
+  return true;
+}
+
+void J1939Reassembler::OnConnectionManagement(const CanFrame& frame) {
+  const std::uint8_t* data = frame.data;
+  const std::uint8_t source = J1939Id::SourceAddress(frame.id);
+  const std::uint8_t destination = J1939Id::DestinationAddress(frame.id);
+  const std::uint32_t pgn = data[5] | (std::uint32_t{data[6]} << 8) | (std::uint32_t{data[7]} << 16);
+
+  if (data[0] == kRequestToSend || data[0] == kBroadcastAnnounce) {
+    const bool broadcast = data[0] == kBroadcastAnnounce;
+    const std::size_t size = data[1] | (std::size_t{data[2]} << 8);
+    const std::uint8_t packets = data[3];
+    // Single-frame groups are never sent with TP
+    if (broadcast != (destination == J1939Id::kGlobalAddress) || size <= 8 || size > kMaxTransferSize ||
+        packets != (size + kPacketBytes - 1) / kPacketBytes) {
+      ++stats_.malformed;
+      return;
+    }
+    Session& session = SessionFor(frame.channel, source, destination);
+    if (session.active) {
+      ++stats_.aborted;
+    }
+    session.active = true;
+    session.last_ns = frame.timestamp_ns;
+    session.pgn = pgn;
+    session.size = static_cast<std::uint16_t>(size);
+    session.packets = packets;
+    session.received = 0;
+    session.priority = J1939Id::Priority(frame.id);
+    session.seen = {};
+  } else if (data[0] == kAbort) {
+    // Either side of a connection may abort it
+    for (Session* session : {FindSession(frame.channel, source, destination),
+                             FindSession(frame.channel, destination, source)}) {
+      if (session != nullptr && session->active && session->pgn == pgn) {
+        session->active = false;
+        ++stats_.aborted;
+      }
+    }
+  }
+  // CTS and the end of message acknowledgement only steer the sender
+}
+
+void J1939Reassembler::OnDataTransfer(const CanFrame& frame) {
+  const std::uint8_t source = J1939Id::SourceAddress(frame.id);
+  const std::uint8_t destination = J1939Id::DestinationAddress(frame.id);
+  Session* session = FindSession(frame.channel, source, destination);
+  if (session == nullptr || !session->active) {
+    ++stats_.orphan_packets;
+    return;
+  }
+  if (frame.timestamp_ns - session->last_ns > options_.timeout_ns) {
+    session->active = false;
+    ++stats_.timed_out;
+    ++stats_.orphan_packets;
+    return;
+  }
+  const std::uint8_t sequence = frame.data[0];
+  if (sequence == 0 || sequence > session->packets) {
+    ++stats_.malformed;
+    return;
+  }
+  session->last_ns = frame.timestamp_ns;
+  const std::size_t packet = sequence - 1u;
+  std::memcpy(session->data.data() + packet * kPacketBytes, frame.data + 1, kPacketBytes);
+  std::uint64_t& seen = session->seen[packet / 64];
+  const std::uint64_t bit = std::uint64_t{1} << (packet % 64);
+  if ((seen & bit) == 0) {
+    seen |= bit;
+    ++session->received;
+  }
+  if (session->received < session->packets) {
+    return;
+  }
+
+  session->active = false;
+  J1939Transfer transfer;
+  transfer.timestamp_ns = frame.timestamp_ns;
+  transfer.pgn = session->pgn;
+  transfer.channel = frame.channel;
+  transfer.priority = session->priority;
+  transfer.source_address = source;
+  transfer.destination_address = destination;
+  transfer.data = session->data.data();
+  transfer.size = session->size;
+  transfer.message = decoder_.FindPgn(session->pgn);
+  if (transfer.message != nullptr) {
+    SignalDecoder::DecodeMessage(transfer.message->layouts, transfer.message->plans, transfer.message->signal_count,
+                                 transfer.data, transfer.size, values_.data());
+    transfer.values = values_.data();
+  }
+  ++stats_.transfers;
+  on_transfer_(transfer);
+}
+
+J1939Reassembler::Session& J1939Reassembler::SessionFor(std::uint16_t channel, std::uint8_t source,
+                                                        std::uint8_t destination) {
+  const std::uint32_t key = (std::uint32_t{channel} << 16) | (std::uint32_t{source} << 8) | destination;
+  auto [it, inserted] = sessions_.try_emplace(key, nullptr);
+  if (inserted) {
+    if (used_sessions_ == slabs_.size() * kSlabSessions) {
+      slabs_.push_back(std::make_unique<Slab>());
+    }
+    it->second = &(*slabs_.back())[used_sessions_ % kSlabSessions];
+    ++used_sessions_;
+  }
+  return *it->second;
+}
+
+J1939Reassembler::Session* J1939Reassembler::FindSession(std::uint16_t channel, std::uint8_t source,
+                                                         std::uint8_t destination) noexcept {
+  const std::uint32_t key = (std::uint32_t{channel} << 16) | (std::uint32_t{source} << 8) | destination;
+  auto it = sessions_.find(key);
+  return it == sessions_.end() ? nullptr : it->second;
+}
+
+}  // namespace decoder
+}  // namespace dbc_parser
@@ -0,0 +1,146 @@
+#ifndef DBC_PARSER_DECODER_J1939_REASSEMBLER_H_
+#define DBC_PARSER_DECODER_J1939_REASSEMBLER_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "dbc_parser/decoder/can_frame.h"
+#include "dbc_parser/decoder/frame_decoder.h"
+#include "dbc_parser/decoder/j1939_id.h"
+
+namespace dbc_parser {
+namespace decoder {
+
+/**
+ * @brief One parameter group sent with the J1939 transport protocol, with
+ *        its decoded signals.
+ *
+ * Points into buffers owned by the J1939Reassembler; valid only during the
+ * callback.
+ */
+struct J1939Transfer {
+  std::int64_t timestamp_ns = 0;         ///< Time of the last TP.DT packet
+  std::uint32_t pgn = 0;                 ///< Transferred parameter group
+  std::uint16_t channel = 0;             ///< Bus the transfer was recorded on
+  std::uint8_t priority = 0;             ///< Priority of the TP.CM announcement
+  std::uint8_t source_address = 0;       ///< Sender
+  std::uint8_t destination_address = 0;  ///< Receiver, J1939Id::kGlobalAddress for BAM
+  const std::uint8_t* data = nullptr;    ///< Reassembled payload
+  std::size_t size = 0;                  ///< Payload bytes, as announced by TP.CM
+  const FrameDecoder::MessageEntry* message = nullptr;  ///< FrameDecoder::FindPgn(pgn), or nullptr
+  const double* values = nullptr;  ///< message->signal_count values, see SignalDecoder::DecodeMessage
+
+  [[nodiscard]] bool is_broadcast() const noexcept { return destination_address == J1939Id::kGlobalAddress; }
+};
+
+/**
+ * @brief Tuning of J1939Reassembler.
+ */
+struct J1939ReassemblyOptions {
+  /// Longest gap between the packets of one transfer before it is dropped,
+  /// J1939-21 T1 plus margin by default
+  std::int64_t timeout_ns = 1'250'000'000;
+};
+
+/**
+ * @brief Counters of one J1939Reassembler.
+ */
+struct J1939ReassemblyStats {
+  std::uint64_t transfers = 0;       ///< Transfers completed and delivered
+  std::uint64_t aborted = 0;         ///< Transfers ended by TP.CM Abort or replaced by a new announcement
+  std::uint64_t timed_out = 0;       ///< Transfers dropped after a gap longer than timeout_ns
+  std::uint64_t orphan_packets = 0;  ///< TP.DT packets without a transfer in progress
+  std::uint64_t malformed = 0;       ///< TP.CM and TP.DT frames that break J1939-21
+};
+
+/**
+ * @brief Reassembles J1939 multi-packet transfers (TP.CM and TP.DT, both BAM
+ *        and RTS/CTS) from frames in timestamp order and decodes them
+ *        through a FrameDecoder.
+ *
+ * The reassembler only listens: RTS and BAM announcements open a transfer,
+ * data packets fill it in any order, retransmitted packets overwrite their
+ * slot, and the transfer is delivered once every packet arrived, without
+ * waiting for the receiver's acknowledgement. CTS and acknowledgements are
+ * consumed without effect.
+ *
+ * Each (channel, source, destination) pair carries at most one transfer at
+ * a time, as J1939-21 requires. Its state, including the 1785-byte buffer,
+ * lives in slabs that are allocated when a pair is first seen and reused by
+ * every later transfer of the pair, so steady-state reassembly does not
+ * allocate. Transfers decode through the message plans like single frames;
+ * signals past the 64th byte of a larger transfer yield NaN.
+ *
+ * Not thread-safe; use one reassembler per stream of frames, e.g. inside
+ * the LogDecoder::FrameCallback.
+ */
+class J1939Reassembler {
+ public:
+  /// Largest transfer, 255 packets of 7 bytes
+  static constexpr std::size_t kMaxTransferSize = 1785;
+  /// Receives completed transfers
+  using TransferCallback = std::function<void(const J1939Transfer&)>;
+
+  /**
+   * @brief Creates a reassembler.
+   *
+   * @param decoder Message index; must outlive this object
+   * @param on_transfer Receiver of the completed transfers
+   * @param options Timeout between packets
+   */
+  J1939Reassembler(const FrameDecoder& decoder, TransferCallback on_transfer, J1939ReassemblyOptions options = {});
+
+  /**
+   * @brief Feeds one frame.
+   *
+   * @param frame Recorded frame, in timestamp order within its channel
+   * @return true if the frame was a TP.CM or TP.DT frame and is consumed,
+   *         false for every other frame
+   */
+  bool Add(const CanFrame& frame);
+
+  [[nodiscard]] const J1939ReassemblyStats& stats() const noexcept { return stats_; }
+
+ private:
+  struct Session {
+    std::int64_t last_ns = 0;
+    std::uint32_t pgn = 0;
+    std::uint16_t size = 0;
+    std::uint8_t packets = 0;
+    std::uint8_t received = 0;
+    std::uint8_t priority = 0;
+    bool active = false;
+    std::array<std::uint64_t, 4> seen = {};  ///< Bit n - 1 for packet n
+    std::array<std::uint8_t, kMaxTransferSize> data = {};
+  };
+
+  static constexpr std::size_t kSlabSessions = 16;
+  using Slab = std::array<Session, kSlabSessions>;
+
+  // The session of a pair, created on first use
+  Session& SessionFor(std::uint16_t channel, std::uint8_t source, std::uint8_t destination);
+  // The session of a pair, or nullptr if the pair never had one
+  Session* FindSession(std::uint16_t channel, std::uint8_t source, std::uint8_t destination) noexcept;
+
+  void OnConnectionManagement(const CanFrame& frame);
+  void OnDataTransfer(const CanFrame& frame);
+
+  const FrameDecoder& decoder_;
+  TransferCallback on_transfer_;
+  J1939ReassemblyOptions options_;
+  J1939ReassemblyStats stats_;
+  std::vector<std::unique_ptr<Slab>> slabs_;
+  std::size_t used_sessions_ = 0;
+  std::unordered_map<std::uint32_t, Session*> sessions_;  ///< By channel << 16 | source << 8 | destination
+  std::vector<double> values_;
+};
+
+}  // namespace decoder
+}  // namespace dbc_parser
+
+#endif  // DBC_PARSER_DECODER_J1939_REASSEMBLER_H_
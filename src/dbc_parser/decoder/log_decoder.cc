@@ -0,0 +1,151 @@
+#include "dbc_parser/decoder/log_decoder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "dbc_parser/core/mapped_file.h"
+#include "dbc_parser/core/trace.h"
+#include "dbc_parser/decoder/chunk_pipeline.h"
+
+namespace dbc_parser {
+namespace decoder {
+namespace {
+
+constexpr const char* kTraceCategory = "decoder";
+
+// Splits text into chunks of about chunk_bytes that end after a newline
+std::vector<std::string_view> SplitLines(std::string_view text, std::size_t chunk_bytes) {
+  std::vector<std::string_view> chunks;
+  chunk_bytes = std::max<std::size_t>(chunk_bytes, 1);
+  while (!text.empty()) {
+    std::size_t end = std::min(chunk_bytes, text.size());
+    end = text.find('\n', end - 1);
+    end = end == std::string_view::npos ? text.size() : end + 1;
+    chunks.push_back(text.substr(0, end));
+    text.remove_prefix(end);
+  }
+  return chunks;
+}
+
+// Parses and decodes every line of a chunk on a worker; keeps the frames if
+// keep_frames
+std::unique_ptr<DecodedChunk> DecodeChunk(std::string_view chunk, const FrameDecoder& decoder,
+                                          LogDecoder::LineParser parse_line, const LogDecodeOptions& options,
+                                          std::size_t worker, bool keep_frames) {
+  core::TraceSpan span(kTraceCategory, "decode chunk");
+  auto result = std::make_unique<DecodedChunk>();
+  std::vector<double> scratch(std::max<std::size_t>(decoder.MaxSignalCount(), 1));
+
+  while (!chunk.empty()) {
+    const std::size_t end = chunk.find('\n');
+    std::string_view line = chunk.substr(0, end);
+    chunk.remove_prefix(end == std::string_view::npos ? chunk.size() : end + 1);
+    if (!line.empty() && line.back() == '\r') {
+      line.remove_suffix(1);
+    }
+    if (line.empty()) {
+      continue;
+    }
+    ++result->stats.lines;
+    std::optional<CanFrame> frame = parse_line(line);
+    if (keep_frames && options.relative_timestamps != nullptr) {
+      result->elapsed_ns += frame ? frame->timestamp_ns : options.relative_timestamps(line).value_or(0);
+      if (frame) {
+        frame->timestamp_ns = result->elapsed_ns;
+      }
+    }
+    if (!frame) {
+      ++result->stats.malformed_lines;
+      continue;
+    }
+    const DecodedFrame decoded = result->Add(*frame, decoder, keep_frames, scratch);
+    if (options.on_worker_frame) {
+      options.on_worker_frame(worker, decoded);
+    }
+  }
+
+  if (keep_frames) {
+    result->SortByTime();
+  }
+  span.SetCount(static_cast<std::int64_t>(result->stats.frames));
+  return result;
+}
+
+}  // namespace
+
+LogDecodeStats LogDecoder::Decode(std::string_view log, const FrameCallback& on_frame) const {
+  DBC_TRACE_SPAN(kTraceCategory, "LogDecoder::Decode");
+  const auto start = std::chrono::steady_clock::now();
+  const std::vector<std::string_view> chunks = SplitLines(log, options_.chunk_bytes);
+  const bool keep_frames = on_frame || options_.on_chunk;
+
+  const std::size_t threads = std::max<std::size_t>(1, std::min(options_.MaxThreads(), chunks.size()));
+  const std::size_t max_in_flight =
+      keep_frames ? std::max<std::size_t>(1, options_.chunks_in_flight_per_thread) * threads : chunks.size() + 1;
+
+  LogDecodeStats total;
+  total.bytes = log.size();
+  total.chunks = chunks.size();
+  total.threads = chunks.empty() ? 0 : threads;
+
+  ChunkMerger merger(on_frame);
+  std::size_t next_chunk = 0;
+  std::size_t next_report = 0;
+  std::int64_t elapsed_ns = 0;
+  RunChunkPipeline<std::string_view, DecodedChunk>(
+      threads, max_in_flight,
+      [&]() -> std::optional<std::string_view> {
+        if (next_chunk == chunks.size()) {
+          return std::nullopt;
+        }
+        return chunks[next_chunk++];
+      },
+      [&](std::string_view& chunk, std::size_t worker) {
+        auto result = DecodeChunk(chunk, decoder_, parse_line_, options_, worker, keep_frames);
+        result->offset = static_cast<std::size_t>(chunk.data() - log.data());
+        result->size = chunk.size();
+        return result;
+      },
+      [&](std::unique_ptr<DecodedChunk> result) {
+        AddCounts(total, result->stats);
+        if (!keep_frames) {
+          return;
+        }
+        const std::int64_t base_ns = elapsed_ns;
+        if (options_.relative_timestamps != nullptr) {
+          for (CanFrame& frame : result->frames) {
+            frame.timestamp_ns += elapsed_ns;
+          }
+          if (!result->frames.empty()) {
+            result->newest_ns += elapsed_ns;
+          }
+          elapsed_ns += result->elapsed_ns;
+        }
+        result->Report(options_, next_report++, base_ns);
+        if (on_frame) {
+          merger.Add(std::move(result));
+        }
+      });
+  if (on_frame) {
+    merger.Finish();
+  }
+
+  total.late_frames = merger.late_frames();
+  total.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  core::Tracer::RecordCounter(kTraceCategory, "frames", static_cast<double>(total.frames));
+  return total;
+}
+
+std::optional<LogDecodeStats> LogDecoder::DecodeFile(const std::string& path, const FrameCallback& on_frame) const {
+  std::optional<core::MappedFile> file = core::MappedFile::Open(path);
+  if (!file) {
+    return std::nullopt;
+  }
+  file->AdviseSequential();
+  return Decode(file->contents(), on_frame);
+}
+
+}  // namespace decoder
+}  // namespace dbc_parser
@@ -0,0 +1,166 @@
+#ifndef DBC_PARSER_DECODER_LOG_DECODER_H_
+#define DBC_PARSER_DECODER_LOG_DECODER_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "dbc_parser/decoder/can_frame.h"
+#include "dbc_parser/decoder/frame_decoder.h"
+
+namespace dbc_parser {
+namespace decoder {
+
+/**
+ * @brief One frame of a log with its decoded signals.
+ *
+ * Points into buffers owned by the LogDecoder; valid only during the callback.
+ */
+struct DecodedFrame {
+  const CanFrame* frame = nullptr;                      ///< The recorded frame
+  const FrameDecoder::MessageEntry* message = nullptr;  ///< Its message, or nullptr if unknown
+  const double* values = nullptr;  ///< message->signal_count values, see SignalDecoder::DecodeMessage
+};
+
+/**
+ * @brief The frames of one chunk of a log, as read.
+ *
+ * Points into buffers owned by the reader; valid only during the callback.
+ */
+struct LogChunk {
+  std::size_t index = 0;             ///< Position among the chunks of the log, from 0
+  std::size_t offset = 0;            ///< First byte of the chunk in the log
+  std::size_t size = 0;              ///< Bytes of the chunk
+  std::int64_t base_ns = 0;          ///< Time the chunk's relative timestamps start from, else 0
+  const CanFrame* frames = nullptr;  ///< Frames in log order, timestamps final
+  std::size_t frame_count = 0;       ///< Number of frames
+};
+
+/**
+ * @brief Tuning of LogDecoder.
+ */
+struct LogDecodeOptions {
+  /// Reads the timestamp of any line, with or without a frame
+  using TimestampParser = std::optional<std::int64_t> (*)(std::string_view line) noexcept;
+
+  /// Worker threads; 0 uses one per hardware thread
+  std::size_t threads = 0;
+  /// Target size of the newline-aligned chunks handed to the workers
+  std::size_t chunk_bytes = std::size_t{4} << 20;
+  /// Decoded chunks waiting for the merge, per worker, before workers pause
+  std::size_t chunks_in_flight_per_thread = 2;
+  /// Set for logs whose timestamps are deltas to the previous line, like
+  /// ASC with "timestamps relative". Every line's delta counts, including
+  /// lines without a frame, and frames are given the accumulated time.
+  TimestampParser relative_timestamps = nullptr;
+  /// Receives every chunk with its frames, in log order on the calling
+  /// thread and before on_frame sees them; for indexing a log by chunk
+  std::function<void(const LogChunk&)> on_chunk;
+  /// Receives every decoded frame on the worker that decoded it, numbered
+  /// below MaxThreads(), in no particular order and, with relative
+  /// timestamps, at chunk-local times; for per-worker accumulators that
+  /// need no locks
+  std::function<void(std::size_t worker, const DecodedFrame&)> on_worker_frame;
+
+  /**
+   * @brief The most worker threads a reader starts with these options.
+   */
+  [[nodiscard]] std::size_t MaxThreads() const noexcept {
+    return std::max<std::size_t>(1, threads != 0 ? threads : std::thread::hardware_concurrency());
+  }
+};
+
+/**
+ * @brief Counters and timing of one LogDecoder run.
+ */
+struct LogDecodeStats {
+  std::uint64_t bytes = 0;            ///< Log bytes read
+  std::uint64_t chunks = 0;           ///< Chunks the log was split into
+  std::uint64_t lines = 0;            ///< Non-empty lines
+  std::uint64_t frames = 0;           ///< Lines that held a frame
+  std::uint64_t malformed_lines = 0;  ///< Non-empty lines without a frame, e.g. ASC events
+  std::uint64_t unknown_frames = 0;   ///< Frames whose ID is not in the DbcFile
+  std::uint64_t signals = 0;          ///< Signal values decoded
+  std::uint64_t late_frames = 0;      ///< Frames delivered after a later timestamp; see LogDecoder
+  std::size_t threads = 0;            ///< Worker threads used
+  double seconds = 0.0;               ///< Wall time of the run
+
+  /**
+   * @brief Throughput of the run.
+   */
+  [[nodiscard]] double FramesPerSecond() const noexcept {
+    return seconds > 0.0 ? static_cast<double>(frames) / seconds : 0.0;
+  }
+};
+
+/**
+ * @brief Decodes line-based CAN logs through a FrameDecoder on a worker pool.
+ *
+ * The log is split into newline-aligned chunks of about chunk_bytes. Workers
+ * parse and decode chunks independently; without a callback they only count.
+ * With a callback, each chunk's frames are sorted by timestamp and the
+ * calling thread merges consecutive chunks, so frames arrive in timestamp
+ * order as long as no frame is older than the newest frame two chunks
+ * earlier. Logs are written in time order, so this only has to absorb the
+ * jitter between interleaved buses; frames beyond it are still delivered and
+ * counted as late_frames.
+ *
+ * Workers pause when chunks_in_flight_per_thread * threads decoded chunks
+ * wait for the merge, which bounds memory for logs of any size.
+ *
+ * Relative timestamps stay parallel: each chunk sums its deltas from zero and
+ * the merge shifts it by the total of all earlier chunks. They only matter to
+ * the callback, so count-only runs skip them.
+ */
+class LogDecoder {
+ public:
+  /// Parses one line of the log format, without its newline
+  using LineParser = std::optional<CanFrame> (*)(std::string_view line) noexcept;
+  /// Receives frames in timestamp order, on the thread that called Decode
+  using FrameCallback = std::function<void(const DecodedFrame&)>;
+
+  /**
+   * @brief Creates a decoder for one log format.
+   *
+   * @param decoder Message index; must outlive this object
+   * @param parse_line Line parser of the log format, e.g. CandumpParser::ParseLine
+   * @param options Threads and chunking
+   */
+  LogDecoder(const FrameDecoder& decoder, LineParser parse_line, LogDecodeOptions options = {}) noexcept
+      : decoder_(decoder), parse_line_(parse_line), options_(options) {}
+
+  /**
+   * @brief Decodes a log held in memory.
+   *
+   * @param log Log text
+   * @param on_frame Optional receiver of the decoded frames
+   * @return LogDecodeStats Counters and timing
+   */
+  LogDecodeStats Decode(std::string_view log, const FrameCallback& on_frame = nullptr) const;
+
+  /**
+   * @brief Memory-maps a log file and decodes it.
+   *
+   * @param path Log file
+   * @param on_frame Optional receiver of the decoded frames
+   * @return std::optional<LogDecodeStats> Counters and timing, or std::nullopt
+   *         if the file cannot be mapped
+   */
+  [[nodiscard]] std::optional<LogDecodeStats> DecodeFile(const std::string& path,
+                                                         const FrameCallback& on_frame = nullptr) const;
+
+ private:
+  const FrameDecoder& decoder_;
+  LineParser parse_line_;
+  LogDecodeOptions options_;
+};
+
+}  // namespace decoder
+}  // namespace dbc_parser
+
+#endif  // DBC_PARSER_DECODER_LOG_DECODER_H_
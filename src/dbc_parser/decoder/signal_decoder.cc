@@ -0,0 +1,108 @@
+#include "dbc_parser/decoder/signal_decoder.h"
+
+#include <cstring>
+#include <limits>
+
+namespace dbc_parser {
+namespace decoder {
+namespace {
+
+double ToPhysical(const SignalLayout& layout, std::uint64_t raw) noexcept {
+  double value;
+  if ((layout.flags & SignalLayout::kFloat32) && layout.length == 32) {
+    const auto bits = static_cast<std::uint32_t>(raw);
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    value = f;
+  } else if ((layout.flags & SignalLayout::kFloat64) && layout.length == 64) {
+    std::memcpy(&value, &raw, sizeof(value));
+  } else if (layout.is_signed()) {
+    value = static_cast<double>(static_cast<std::int64_t>(raw));
+  } else {
+    value = static_cast<double>(raw);
+  }
+  return value * layout.factor + layout.offset;
+}
+
+// plan_of(i) returns the plan of layouts[i], precomputed or not
+template <typename PlanOf>
+std::size_t DecodeSignals(const SignalLayout* layouts, const PlanOf& plan_of, std::size_t count,
+                          const PaddedPayload& payload, double* out) noexcept {
+  // Find the multiplexor value first so multiplexed signals can be filtered.
+  // Nested multiplexors (mXM) are themselves multiplexed and never the root.
+  std::optional<std::int64_t> selector;
+  bool root_found = false;
+  bool has_nested = false;
+  for (std::size_t i = 0; i < count; ++i) {
+    if (!layouts[i].is_multiplexor()) {
+      continue;
+    }
+    if (layouts[i].is_multiplexed()) {
+      has_nested = true;
+    } else if (!root_found) {
+      root_found = true;
+      const ExtractionPlan plan = plan_of(i);
+      if (plan.FitsIn(payload.size)) {
+        selector = static_cast<std::int64_t>(plan.Extract(payload));
+      }
+    }
+  }
+  // With extended multiplexing, which multiplexor a signal depends on is given
+  // by SG_MUL_VAL_, which is not modelled; such signals are not decoded rather
+  // than being matched against the wrong selector.
+  if (has_nested) {
+    selector.reset();
+  }
+
+  std::size_t decoded = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    const SignalLayout& layout = layouts[i];
+    const ExtractionPlan plan = plan_of(i);
+    if (!plan.FitsIn(payload.size) ||
+        (layout.is_multiplexed() && (!selector || *selector != layout.multiplex_value))) {
+      out[i] = std::numeric_limits<double>::quiet_NaN();
+      continue;
+    }
+    out[i] = ToPhysical(layout, plan.Extract(payload));
+    ++decoded;
+  }
+  return decoded;
+}
+
+}  // namespace
+
+std::optional<std::uint64_t> SignalDecoder::ExtractRaw(const SignalLayout& layout,
+                                                       const std::uint8_t* data,
+                                                       std::size_t size) noexcept {
+  const ExtractionPlan plan = ExtractionPlan::For(layout);
+  if (!plan.FitsIn(size)) {
+    return std::nullopt;
+  }
+  return plan.Extract(PaddedPayload(data, size));
+}
+
+std::optional<double> SignalDecoder::Decode(const SignalLayout& layout, const std::uint8_t* data,
+                                            std::size_t size) noexcept {
+  auto raw = ExtractRaw(layout, data, size);
+  if (!raw) {
+    return std::nullopt;
+  }
+  return ToPhysical(layout, *raw);
+}
+
+std::size_t SignalDecoder::DecodeMessage(const SignalLayout* layouts, std::size_t count,
+                                         const std::uint8_t* data, std::size_t size,
+                                         double* out) noexcept {
+  const auto plan_of = [layouts](std::size_t i) { return ExtractionPlan::For(layouts[i]); };
+  return DecodeSignals(layouts, plan_of, count, PaddedPayload(data, size), out);
+}
+
+std::size_t SignalDecoder::DecodeMessage(const SignalLayout* layouts, const ExtractionPlan* plans,
+                                         std::size_t count, const std::uint8_t* data, std::size_t size,
+                                         double* out) noexcept {
+  const auto plan_of = [plans](std::size_t i) -> const ExtractionPlan& { return plans[i]; };
+  return DecodeSignals(layouts, plan_of, count, PaddedPayload(data, size), out);
+}
+
+}  // namespace decoder
+}  // namespace dbc_parser
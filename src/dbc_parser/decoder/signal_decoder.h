@@ -0,0 +1,98 @@
+#ifndef DBC_PARSER_DECODER_SIGNAL_DECODER_H_
+#define DBC_PARSER_DECODER_SIGNAL_DECODER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "dbc_parser/common/common_types.h"
+#include "dbc_parser/decoder/extraction_plan.h"
+
+namespace dbc_parser {
+namespace decoder {
+
+using parser::SignalLayout;
+
+/**
+ * @brief Decodes CAN and CAN FD payload bytes into signal values.
+ *
+ * Works purely on SignalLayout, the packed decode-critical signal data, so a
+ * message's layouts can be decoded without touching names or units. Bits are
+ * read through ExtractionPlan word loads; callers that decode many frames
+ * precompute the plans once, see FrameDecoder. Payloads are at most
+ * CanFrame::kMaxPayload (64) bytes; bytes past that are ignored.
+ *
+ * Bit numbering follows the DBC convention: for little endian (Intel) signals
+ * start_bit is the least significant bit, counted LSB-first across bytes; for
+ * big endian (Motorola) signals start_bit is the most significant bit, and the
+ * signal continues towards bit 0 of the same byte and then into bit 7 of the
+ * next byte.
+ */
+class SignalDecoder {
+ public:
+  SignalDecoder() = delete;
+
+  /**
+   * @brief Extracts the raw, unscaled bits of a signal.
+   *
+   * @param layout Signal layout
+   * @param data Payload bytes
+   * @param size Number of payload bytes
+   * @return std::optional<std::uint64_t> The raw value, sign-extended for signed
+   *         signals, or std::nullopt if the signal does not fit in the payload
+   */
+  [[nodiscard]] static std::optional<std::uint64_t> ExtractRaw(const SignalLayout& layout,
+                                                               const std::uint8_t* data,
+                                                               std::size_t size) noexcept;
+
+  /**
+   * @brief Decodes the physical value of a signal.
+   *
+   * Applies IEEE float interpretation if the layout says so, then
+   * physical = raw * factor + offset.
+   *
+   * @param layout Signal layout
+   * @param data Payload bytes
+   * @param size Number of payload bytes
+   * @return std::optional<double> The physical value, or std::nullopt if the
+   *         signal does not fit in the payload
+   */
+  [[nodiscard]] static std::optional<double> Decode(const SignalLayout& layout,
+                                                    const std::uint8_t* data,
+                                                    std::size_t size) noexcept;
+
+  /**
+   * @brief Decodes all signals of a message in one pass.
+   *
+   * Multiplexed signals whose multiplex_value does not match the multiplexor
+   * in this frame, and signals that do not fit in the payload, produce NaN.
+   * In a message with a nested multiplexor (mXM) every multiplexed signal
+   * produces NaN, since its parent multiplexor is not known.
+   *
+   * @param layouts Contiguous layouts of the message's signals
+   * @param count Number of layouts
+   * @param data Payload bytes
+   * @param size Number of payload bytes
+   * @param out Output array of at least count values
+   * @return std::size_t Number of signals that produced a value
+   */
+  static std::size_t DecodeMessage(const SignalLayout* layouts, std::size_t count,
+                                   const std::uint8_t* data, std::size_t size,
+                                   double* out) noexcept;
+
+  /**
+   * @brief Decodes all signals of a message with precomputed plans.
+   *
+   * Same as the overload above without computing a plan per signal.
+   *
+   * @param plans ExtractionPlan::For(layouts[i]) for each layout
+   */
+  static std::size_t DecodeMessage(const SignalLayout* layouts, const ExtractionPlan* plans,
+                                   std::size_t count, const std::uint8_t* data, std::size_t size,
+                                   double* out) noexcept;
+};
+
+}  // namespace decoder
+}  // namespace dbc_parser
+
+#endif  // DBC_PARSER_DECODER_SIGNAL_DECODER_H_
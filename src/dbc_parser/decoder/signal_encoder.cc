@@ -0,0 +1,108 @@
+#include "dbc_parser/decoder/signal_encoder.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace dbc_parser {
+namespace decoder {
+namespace {
+
+// plan_of(i) returns the plan of layouts[i], precomputed or not
+template <typename PlanOf>
+std::size_t EncodeSignals(const SignalLayout* layouts, const PlanOf& plan_of, std::size_t count,
+                          const double* values, std::uint8_t* data, std::size_t size) noexcept {
+  std::optional<std::int64_t> selector;
+  for (std::size_t i = 0; i < count; ++i) {
+    if (layouts[i].is_multiplexor() && !layouts[i].is_multiplexed()) {
+      if (auto raw = SignalEncoder::ToRaw(layouts[i], values[i])) {
+        // The value as it reads back, e.g. after saturation
+        const unsigned unused = 64u - layouts[i].length;
+        selector = layouts[i].is_signed() ? static_cast<std::int64_t>(*raw << unused) >> unused
+                                          : static_cast<std::int64_t>(*raw);
+      }
+      break;
+    }
+  }
+
+  PaddedPayload payload(data, size);
+  std::size_t encoded = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    const SignalLayout& layout = layouts[i];
+    const ExtractionPlan plan = plan_of(i);
+    if (!plan.FitsIn(payload.size) ||
+        (layout.is_multiplexed() && (!selector || *selector != layout.multiplex_value))) {
+      continue;
+    }
+    if (auto raw = SignalEncoder::ToRaw(layout, values[i])) {
+      plan.Insert(*raw, payload);
+      ++encoded;
+    }
+  }
+  std::memcpy(data, payload.bytes, payload.size);
+  return encoded;
+}
+
+}  // namespace
+
+std::optional<std::uint64_t> SignalEncoder::ToRaw(const SignalLayout& layout, double physical) noexcept {
+  if (std::isnan(physical) || layout.factor == 0.0 || layout.length == 0 || layout.length > 64) {
+    return std::nullopt;
+  }
+  const double scaled = (physical - layout.offset) / layout.factor;
+  if ((layout.flags & SignalLayout::kFloat32) && layout.length == 32) {
+    const auto value = static_cast<float>(scaled);
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+  }
+  if ((layout.flags & SignalLayout::kFloat64) && layout.length == 64) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &scaled, sizeof(bits));
+    return bits;
+  }
+
+  const double rounded = std::round(scaled);
+  const int length = layout.length;
+  if (layout.is_signed()) {
+    const auto max = static_cast<std::int64_t>((std::uint64_t{1} << (length - 1)) - 1);
+    const double limit = std::ldexp(1.0, length - 1);  // max + 1, exact as a double
+    const std::int64_t value = rounded >= limit ? max : rounded < -limit ? -max - 1 : static_cast<std::int64_t>(rounded);
+    return static_cast<std::uint64_t>(value);
+  }
+  if (rounded <= 0.0) {
+    return 0;
+  }
+  if (rounded >= std::ldexp(1.0, length)) {
+    return ~std::uint64_t{0} >> (64 - length);
+  }
+  return static_cast<std::uint64_t>(rounded);
+}
+
+bool SignalEncoder::Encode(const SignalLayout& layout, double physical, std::uint8_t* data,
+                           std::size_t size) noexcept {
+  const ExtractionPlan plan = ExtractionPlan::For(layout);
+  const auto raw = ToRaw(layout, physical);
+  if (!plan.FitsIn(size) || !raw) {
+    return false;
+  }
+  PaddedPayload payload(data, size);
+  plan.Insert(*raw, payload);
+  std::memcpy(data, payload.bytes, payload.size);
+  return true;
+}
+
+std::size_t SignalEncoder::EncodeMessage(const SignalLayout* layouts, std::size_t count, const double* values,
+                                         std::uint8_t* data, std::size_t size) noexcept {
+  const auto plan_of = [layouts](std::size_t i) { return ExtractionPlan::For(layouts[i]); };
+  return EncodeSignals(layouts, plan_of, count, values, data, size);
+}
+
+std::size_t SignalEncoder::EncodeMessage(const SignalLayout* layouts, const ExtractionPlan* plans,
+                                         std::size_t count, const double* values, std::uint8_t* data,
+                                         std::size_t size) noexcept {
+  const auto plan_of = [plans](std::size_t i) -> const ExtractionPlan& { return plans[i]; };
+  return EncodeSignals(layouts, plan_of, count, values, data, size);
+}
+
+}  // namespace decoder
+}  // namespace dbc_parser
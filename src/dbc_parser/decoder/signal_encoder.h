@@ -0,0 +1,78 @@
+#ifndef DBC_PARSER_DECODER_SIGNAL_ENCODER_H_
+#define DBC_PARSER_DECODER_SIGNAL_ENCODER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "dbc_parser/common/common_types.h"
+#include "dbc_parser/decoder/extraction_plan.h"
+
+namespace dbc_parser {
+namespace decoder {
+
+/**
+ * @brief Encodes signal values into CAN and CAN FD payload bytes.
+ *
+ * The inverse of SignalDecoder, with the same bit numbering and the same
+ * ExtractionPlan word stores. Bits outside the encoded signals keep their
+ * value, so a payload can be built up signal by signal.
+ */
+class SignalEncoder {
+ public:
+  SignalEncoder() = delete;
+
+  /**
+   * @brief Converts a physical value to the raw value of a signal.
+   *
+   * raw = round((physical - offset) / factor), saturated to the range of the
+   * signal's length and sign; IEEE float signals store the bits of the
+   * unrounded value.
+   *
+   * @return std::optional<std::uint64_t> The raw value, or std::nullopt for NaN
+   *         or a zero factor
+   */
+  [[nodiscard]] static std::optional<std::uint64_t> ToRaw(const SignalLayout& layout, double physical) noexcept;
+
+  /**
+   * @brief Encodes one signal.
+   *
+   * @param layout Signal layout
+   * @param physical Physical value
+   * @param data Payload bytes to update
+   * @param size Number of payload bytes
+   * @return bool Whether the signal fits in the payload and the value was written
+   */
+  static bool Encode(const SignalLayout& layout, double physical, std::uint8_t* data, std::size_t size) noexcept;
+
+  /**
+   * @brief Encodes all signals of a message in one pass.
+   *
+   * Signals whose value is NaN are skipped, as are multiplexed signals whose
+   * multiplex_value does not match the value given for the multiplexor, so
+   * the output of SignalDecoder::DecodeMessage encodes back to the same
+   * payload.
+   *
+   * @param layouts Contiguous layouts of the message's signals
+   * @param count Number of layouts
+   * @param values Physical values, one per layout
+   * @param data Payload bytes to update
+   * @param size Number of payload bytes
+   * @return std::size_t Number of signals written
+   */
+  static std::size_t EncodeMessage(const SignalLayout* layouts, std::size_t count, const double* values,
+                                   std::uint8_t* data, std::size_t size) noexcept;
+
+  /**
+   * @brief Encodes all signals of a message with precomputed plans.
+   *
+   * @param plans ExtractionPlan::For(layouts[i]) for each layout
+   */
+  static std::size_t EncodeMessage(const SignalLayout* layouts, const ExtractionPlan* plans, std::size_t count,
+                                   const double* values, std::uint8_t* data, std::size_t size) noexcept;
+};
+
+}  // namespace decoder
+}  // namespace dbc_parser
+
+#endif  // DBC_PARSER_DECODER_SIGNAL_ENCODER_H_
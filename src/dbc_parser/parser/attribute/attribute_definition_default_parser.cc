@@ -3,6 +3,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <variant>
 
 #include "tao/pegtl.hpp"
@@ -129,7 +130,7 @@ std::optional<AttributeDefinitionDefault> AttributeDefinitionDefaultParser::Pars
     
     // Parse input using our grammar and actions
     if (pegtl::parse<grammar::ba_def_def_rule, action>(in, state)) {
-      return state.attribute_definition_default;
+      return std::move(state.attribute_definition_default);
     }
   } catch (const pegtl::parse_error&) {
     // Parse error - return nullopt
@@ -4,6 +4,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 #include <variant>
 
@@ -277,7 +278,7 @@ std::optional<AttributeDefinition> AttributeDefinitionParser::Parse(std::string_
         state.attribute_definition.default_value = std::string("");
       }
       
-      return state.attribute_definition;
+      return std::move(state.attribute_definition);
     }
   } catch (const pegtl::parse_error&) {
     // Parse error - return nullopt
@@ -162,7 +162,7 @@ template<>
 struct action<grammar::attr_name> {
   template<typename ActionInput>
   static void apply(const ActionInput& in, attribute_value_state& state) {
-    state.attr_name = ParserBase::UnescapeString(in.string());
+    state.attr_name = ParserBase::UnescapeQuoted(in.string_view()).str();
     state.attr_value.name = state.attr_name;
   }
 };
@@ -172,7 +172,7 @@ template<>
 struct action<grammar::node_name> {
   template<typename ActionInput>
   static void apply(const ActionInput& in, attribute_value_state& state) {
-    state.node_name = ParserBase::UnescapeString(in.string());
+    state.node_name = ParserBase::UnescapeQuoted(in.string_view()).str();
   }
 };
 
@@ -181,7 +181,7 @@ template<>
 struct action<grammar::signal_name> {
   template<typename ActionInput>
   static void apply(const ActionInput& in, attribute_value_state& state) {
-    state.signal_name = ParserBase::UnescapeString(in.string());
+    state.signal_name = ParserBase::UnescapeQuoted(in.string_view()).str();
   }
 };
 
@@ -190,7 +190,7 @@ template<>
 struct action<grammar::env_var_name> {
   template<typename ActionInput>
   static void apply(const ActionInput& in, attribute_value_state& state) {
-    state.env_var_name = ParserBase::UnescapeString(in.string());
+    state.env_var_name = ParserBase::UnescapeQuoted(in.string_view()).str();
   }
 };
 
@@ -200,7 +200,7 @@ struct action<grammar::string_value> {
   template<typename ActionInput>
   static void apply(const ActionInput& in, attribute_value_state& state) {
     state.has_string_value = true;
-    state.attr_value.value = ParserBase::UnescapeString(in.string());
+    state.attr_value.value = ParserBase::UnescapeQuoted(in.string_view()).str();
   }
 };
 
@@ -264,7 +264,11 @@ template<>
 struct action<grammar::message_id> {
   template<typename ActionInput>
   static void apply(const ActionInput& in, attribute_value_state& state) {
-    state.message_id = std::stoi(in.string());
+    const std::optional<int> id = ParserBase::ParseMessageId(in.string_view());
+    if (!id) {
+      throw pegtl::parse_error("invalid message ID", in);
+    }
+    state.message_id = *id;
   }
 };
 
@@ -308,7 +312,7 @@ std::optional<AttributeValue> AttributeValueParser::Parse(std::string_view input
     
     // Parse input using our grammar and actions
     if (pegtl::parse<grammar::grammar, action>(in, state)) {
-      return state.attr_value;
+      return std::move(state.attr_value);
     }
   } catch (const pegtl::parse_error&) {
     // Parse error - return nullopt
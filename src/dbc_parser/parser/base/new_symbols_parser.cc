@@ -3,6 +3,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 #include <iostream>
 #include <sstream>
@@ -25,11 +26,8 @@ using ws = common_grammar::ws;
 using ns_keyword = common_grammar::ns_keyword;
 using colon = common_grammar::colon;
 
-// A symbol (e.g., CM_, BA_, SG_, etc.)
-struct symbol : pegtl::seq<
-                  pegtl::plus<pegtl::alpha>,
-                  pegtl::one<'_'>
-                > {};
+// A symbol (e.g., CM_, BA_DEF_DEF_REL_, FILTER)
+struct symbol : pegtl::identifier {};
 
 // Multiple symbols separated by whitespace
 struct symbols : pegtl::star<
@@ -86,7 +84,7 @@ std::optional<NewSymbols> NewSymbolsParser::Parse(std::string_view input) {
     // Parse input using our grammar and actions
     if (pegtl::parse<grammar::ns_rule, symbols_action>(in, state)) {
       NewSymbols new_symbols;
-      new_symbols.symbols = state.symbols;
+      new_symbols.symbols = std::move(state.symbols);
       return new_symbols;
     }
   } catch (const pegtl::parse_error&) {
@@ -3,6 +3,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include "tao/pegtl.hpp"
@@ -85,7 +86,7 @@ std::optional<std::vector<Node>> NodesParser::Parse(std::string_view input) {
   try {
     // Parse input using our grammar and actions
     if (pegtl::parse<grammar::bu_rule, action>(in, state)) {
-      return state.nodes;
+      return std::move(state.nodes);
     }
   } catch (const pegtl::parse_error&) {
     // Parse error - return nullopt
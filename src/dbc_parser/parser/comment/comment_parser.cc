@@ -12,6 +12,7 @@
 #include <tao/pegtl/contrib/parse_tree.hpp>
 
 #include "dbc_parser/common/common_grammar.h"
+#include "dbc_parser/core/string_utils.h"
 
 namespace dbc_parser {
 namespace parser {
@@ -90,7 +91,7 @@ struct CommentState {
     int,                           // MESSAGE
     std::pair<int, std::string>    // SIGNAL
   > identifier;
-  std::string text;
+  QuotedText text;  ///< Borrows from the parser input until Parse() materializes it
   
   // Helper methods for state validation
   bool HasValidIdentifier() const {
@@ -123,10 +124,9 @@ template<>
 struct action<common_grammar::quoted_string> {
   template<typename ActionInput>
   static void apply(const ActionInput& in, CommentState& state) noexcept {
-    std::string unescaped = ParserBase::UnescapeString(in.string());
-    
-    // For all types, the quoted string is the comment text
-    state.text = unescaped;
+    // For all types, the quoted string is the comment text. Kept as a view into
+    // the input: this action can fire several times while alternatives backtrack.
+    state.text = ParserBase::UnescapeQuoted(in.string_view());
   }
 };
 
@@ -169,26 +169,21 @@ struct action<grammar::ev_type> {
 template<>
 struct action<common_grammar::message_id> {
   template<typename ActionInput>
-  static void apply(const ActionInput& in, CommentState& state) noexcept {
-    try {
-      int id = std::stoi(in.string());
-      
-      if (state.type == CommentType::MESSAGE) {
-        state.identifier = id;
-      } else if (state.type == CommentType::SIGNAL && 
-                 std::holds_alternative<std::pair<int, std::string>>(state.identifier)) {
-        auto& pair = std::get<std::pair<int, std::string>>(state.identifier);
-        pair.first = id;
-      }
-    } catch (const std::exception&) {
-      // Invalid message ID - we'll set a default value
-      if (state.type == CommentType::MESSAGE) {
-        state.identifier = 0;
-      } else if (state.type == CommentType::SIGNAL && 
-                 std::holds_alternative<std::pair<int, std::string>>(state.identifier)) {
-        auto& pair = std::get<std::pair<int, std::string>>(state.identifier);
-        pair.first = 0;
-      }
+  static void apply(const ActionInput& in, CommentState& state) {
+    // An ID that does not convert rejects the comment rather than attaching
+    // it to message 0
+    const std::optional<int> converted = ParserBase::ParseMessageId(in.string_view());
+    if (!converted) {
+      throw pegtl::parse_error("invalid message ID", in);
+    }
+    const int id = *converted;
+
+    if (state.type == CommentType::MESSAGE) {
+      state.identifier = id;
+    } else if (state.type == CommentType::SIGNAL &&
+               std::holds_alternative<std::pair<int, std::string>>(state.identifier)) {
+      auto& pair = std::get<std::pair<int, std::string>>(state.identifier);
+      pair.first = id;
     }
   }
 };
@@ -197,17 +192,17 @@ template<>
 struct action<common_grammar::quoted_identifier> {
   template<typename ActionInput>
   static void apply(const ActionInput& in, CommentState& state) noexcept {
-    std::string unescaped = ParserBase::UnescapeString(in.string());
+    std::string unescaped = ParserBase::UnescapeQuoted(in.string_view()).str();
     
     // Store the unquoted string based on the comment type
     if (state.type == CommentType::NODE) {
-      state.identifier = unescaped;
+      state.identifier = std::move(unescaped);
     } else if (state.type == CommentType::ENV_VAR) {
-      state.identifier = unescaped;
+      state.identifier = std::move(unescaped);
     } else if (state.type == CommentType::SIGNAL && 
                std::holds_alternative<std::pair<int, std::string>>(state.identifier)) {
       auto& pair = std::get<std::pair<int, std::string>>(state.identifier);
-      pair.second = unescaped;
+      pair.second = std::move(unescaped);
     }
   }
 };
@@ -252,8 +247,9 @@ std::optional<Comment> CommentParser::Parse(std::string_view input) {
 
   Comment result;
   result.type = state.type;
-  result.identifier = state.identifier;
-  result.text = state.text;
+  result.identifier = std::move(state.identifier);
+  // The only copy of the comment text; Latin-1 vendor comments are stored as UTF-8
+  result.text = core::StringUtils::ToUtf8(std::move(state.text).str());
 
   return result;
 }
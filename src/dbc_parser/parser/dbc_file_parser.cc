@@ -1,6 +1,9 @@
 #include "dbc_parser/parser/dbc_file_parser.h"
 
-#include <iostream>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <string_view>
 #include <memory>
@@ -8,8 +11,6 @@
 #include <map>
 #include <utility>
 #include <variant>
-#include <sstream>
-#include <regex>
 
 #include <tao/pegtl.hpp>
 #include <tao/pegtl/contrib/analyze.hpp>
@@ -17,6 +18,7 @@
 #include "dbc_parser/core/string_utils.h"
 #include "dbc_parser/core/logger.h"
 #include "dbc_parser/core/log_macros.h"
+#include "dbc_parser/core/trace.h"
 #include "dbc_parser/parser/base/version_parser.h"
 #include "dbc_parser/parser/base/new_symbols_parser.h"
 #include "dbc_parser/parser/base/nodes_parser.h"
@@ -33,6 +35,7 @@
 #include "dbc_parser/parser/attribute/attribute_definition_default_parser.h"
 #include "dbc_parser/parser/attribute/attribute_value_parser.h"
 #include "dbc_parser/parser/value/value_description_parser.h"
+#include "dbc_parser/parser/parse_stats.h"
 
 
 // Only include parsers that are actually used in this file
@@ -45,7 +48,6 @@ namespace pegtl = tao::pegtl;
 
 // Use string utilities from the core namespace
 using dbc_parser::core::StringUtils;
-using dbc_parser::core::Logger;
 
 // Helper for string operations
 class StringUtilities {
@@ -60,46 +62,47 @@ public:
   StringUtilities(StringUtilities&&) = delete;
   StringUtilities& operator=(StringUtilities&&) = delete;
 
-  // Split a string by a delimiter character and return a vector of trimmed tokens
-  [[nodiscard]] static std::vector<std::string> SplitTrimmed(const std::string& str, char delimiter) noexcept {
-    std::vector<std::string> tokens = StringUtils::Split(str, delimiter);
-    for (auto& token : tokens) {
-      token = StringUtils::Trim(token);
+  // Split a string by a delimiter character and return a vector of trimmed tokens.
+  // Tokens are sliced as views and copied once, after trimming.
+  [[nodiscard]] static std::vector<std::string> SplitTrimmed(std::string_view str, char delimiter) noexcept {
+    std::vector<std::string> tokens;
+    for (std::string_view token : StringUtils::SplitLazy(str, delimiter)) {
+      tokens.emplace_back(StringUtils::TrimView(token));
     }
     return tokens;
   }
   
   // Split a string by multiple delimiters and return a vector of trimmed tokens
-  [[nodiscard]] static std::vector<std::string> SplitTrimmedByAny(const std::string& str, const std::string& delimiters) noexcept {
-    std::vector<std::string> tokens = StringUtils::SplitByAny(str, delimiters);
-    for (auto& token : tokens) {
-      token = StringUtils::Trim(token);
+  [[nodiscard]] static std::vector<std::string> SplitTrimmedByAny(std::string_view str, std::string_view delimiters) noexcept {
+    std::vector<std::string> tokens;
+    for (std::string_view token : StringUtils::SplitViewByAny(str, delimiters)) {
+      tokens.emplace_back(StringUtils::TrimView(token));
     }
     return tokens;
   }
   
-  // Trim whitespace from start and end of string
-  [[nodiscard]] static std::string Trim(const std::string& str) noexcept {
-    return StringUtils::Trim(str);
+  // Trim whitespace from start and end of string, returning a view into it
+  [[nodiscard]] static std::string_view Trim(std::string_view str) noexcept {
+    return StringUtils::TrimView(str);
   }
   
   // Extract string content between quotes
-  [[nodiscard]] static std::optional<std::string> ExtractQuoted(const std::string& str) noexcept {
+  [[nodiscard]] static std::optional<std::string> ExtractQuoted(std::string_view str) noexcept {
     return StringUtils::ExtractQuoted(str);
   }
   
   // Remove quotes from a string if present
-  [[nodiscard]] static std::string StripQuotes(const std::string& str) noexcept {
+  [[nodiscard]] static std::string StripQuotes(std::string_view str) noexcept {
     return StringUtils::StripQuotes(str);
   }
   
   // Parse a string as an integer
-  [[nodiscard]] static std::optional<int64_t> ParseInt(const std::string& str) noexcept {
+  [[nodiscard]] static std::optional<int64_t> ParseInt(std::string_view str) noexcept {
     return StringUtils::ParseInt(str);
   }
   
   // Parse a string as a double
-  [[nodiscard]] static std::optional<double> ParseDouble(const std::string& str) noexcept {
+  [[nodiscard]] static std::optional<double> ParseDouble(std::string_view str) noexcept {
     return StringUtils::ParseDouble(str);
   }
   
@@ -140,18 +143,25 @@ struct sig_val_type_key : pegtl::string<'S', 'I', 'G', '_', 'V', 'A', 'L', 'T',
 struct sig_group_key : pegtl::string<'S', 'I', 'G', '_', 'G', 'R', 'O', 'U', 'P', '_'> {};
 struct sig_mul_val_key : pegtl::string<'S', 'G', '_', 'M', 'U', 'L', '_', 'V', 'A', 'L', '_'> {};
 
+// Every rule below stops at the end of its line: a rule that could run on
+// past it (an unterminated quote, a missing ';') would rescan the rest of the
+// input for every line it is tried on, which makes parsing quadratic.
+struct line_char : pegtl::not_one<'\r', '\n'> {};
+
 // Rules for capturing line content
 struct line_content : pegtl::until<pegtl::eol> {};
-struct indented_line : pegtl::seq<pegtl::opt<ws>, pegtl::plus<space>, pegtl::not_at<pegtl::eol>, pegtl::until<pegtl::eol>> {};
+// Leading whitespace must be consumed by plus<space> itself: an opt<ws> in front
+// of it would eat every blank and leave plus<space> with nothing to match
+struct indented_line : pegtl::seq<pegtl::plus<space>, pegtl::not_at<pegtl::eol>, pegtl::until<pegtl::eol>> {};
 
 // Version-specific rules
-struct quoted_string : pegtl::seq<pegtl::one<'"'>, pegtl::until<pegtl::one<'"'>>, pegtl::opt<ws>> {};
+struct quoted_string : pegtl::seq<pegtl::one<'"'>, pegtl::until<pegtl::one<'"'>, line_char>, pegtl::opt<ws>> {};
 struct version_content : pegtl::seq<version_key, ws, quoted_string, pegtl::until<pegtl::eol>> {};
 struct invalid_version_content : pegtl::seq<version_key, ws, pegtl::not_at<pegtl::one<'"'>>, line_content> {};
 
 // Enhanced rules for parsing specific data
 struct message_id : pegtl::plus<pegtl::digit> {};
-struct node_list : pegtl::list<pegtl::identifier, pegtl::one<','>, pegtl::space> {};
+struct node_list : pegtl::list<pegtl::identifier, pegtl::one<','>, space> {};
 
 // Section rules with content capturing
 struct version_section : pegtl::sor<version_content, invalid_version_content> {};
@@ -258,7 +268,7 @@ struct attr_def_def_rule : pegtl::seq<
                             ws, 
                             attr_def_def_key, 
                             ws, 
-                            pegtl::plus<pegtl::not_at<pegtl::one<';'>>, pegtl::any>, 
+                            pegtl::plus<pegtl::not_one<';', '\r', '\n'>>,
                             pegtl::one<';'>, 
                             ws, 
                             pegtl::eol> {};
@@ -266,7 +276,7 @@ struct attr_def_def_rule : pegtl::seq<
 // Add a new rule that captures only the attr_def_def_key at the start of a line
 struct direct_attr_def_def_line : pegtl::seq<
                              pegtl::at<attr_def_def_key>,  // Look ahead for the key
-                             pegtl::plus<pegtl::any>,  // Capture the rest of the line
+                             pegtl::plus<line_char>,  // Capture the rest of the line
                              pegtl::eol> {};
 
 // Main grammar rule
@@ -282,6 +292,7 @@ struct dbc_file : pegtl::until<pegtl::eof,
                     env_var_section,
                     env_var_data_section,
                     comment_section,
+                    sig_mul_val_section,  // before signal_key, which would take its "SG_" prefix
                     signal_key,
                     attr_def_section,
                     attr_def_def_rule,
@@ -290,17 +301,155 @@ struct dbc_file : pegtl::until<pegtl::eof,
                     value_desc_section,
                     sig_val_type_section,
                     sig_group_section,
-                    sig_mul_val_section,
                     ignored,
                     any_line>> {};
 
 } // namespace grammar
 
+// Trace category of all parser spans
+constexpr const char* kTraceCategory = "dbc_parser";
+
+// Traces runs of consecutive statements of one kind as a single span named
+// after their keyword, e.g. 2000 adjacent CM_ lines become one "CM_" span
+// with count=2000. A span per statement would fill the trace buffers on
+// large files and cost more than the statements themselves.
+class StatementTraceRun {
+ public:
+  StatementTraceRun() noexcept : enabled_(core::Tracer::IsEnabled()) {}
+  ~StatementTraceRun() { Flush(); }
+
+  StatementTraceRun(const StatementTraceRun&) = delete;
+  StatementTraceRun& operator=(const StatementTraceRun&) = delete;
+
+  void Note(StatementKind kind) noexcept {
+    if (!enabled_) {
+      return;
+    }
+    if (count_ > 0 && kind == kind_) {
+      ++count_;
+      return;
+    }
+    Flush();
+    kind_ = kind;
+    start_ns_ = core::Tracer::NowNanoseconds();
+    count_ = 1;
+  }
+
+  // Ends the current run, e.g. when the grammar pass is over
+  void Flush() noexcept {
+    if (count_ == 0) {
+      return;
+    }
+    // KeywordOf() returns views of string literals, so data() is terminated
+    core::Tracer::RecordSpan(kTraceCategory, ParseStats::KeywordOf(kind_).data(), start_ns_,
+                             core::Tracer::NowNanoseconds(), static_cast<std::int64_t>(count_));
+    count_ = 0;
+  }
+
+ private:
+  bool enabled_;  // Sampled once per parse
+  StatementKind kind_ = StatementKind::kUnknown;
+  std::uint64_t start_ns_ = 0;
+  std::uint64_t count_ = 0;
+};
+
+// What a parse measures besides its result: the optional ParseStats of the
+// caller and the trace spans of statement runs
+struct ParseProfile {
+  ParseStats* stats = nullptr;
+  StatementTraceRun trace;
+};
+
+// Measures one statement for ParseStats and records it when it goes out of
+// scope. A probe made without stats does nothing, so a parse without stats
+// pays one null test per statement.
+class StatementProbe {
+ public:
+  StatementProbe() noexcept = default;
+
+  StatementProbe(ParseStats* stats, StatementKind kind, std::uint64_t bytes,
+                 std::uint64_t offset, std::uint64_t line) noexcept
+      : stats_(stats), kind_(kind), bytes_(bytes), offset_(offset), line_(line) {
+    if (stats_->allocation_counter != nullptr) {
+      allocations_ = stats_->allocation_counter();
+    }
+    start_ = std::chrono::steady_clock::now();
+  }
+
+  // Probe for a statement matched by the grammar; the iterator gives its
+  // position without building a pegtl::position and its source string
+  template<typename ActionInput>
+  [[nodiscard]] static StatementProbe Start(ParseProfile& profile, StatementKind kind, const ActionInput& in) noexcept {
+    profile.trace.Note(kind);
+    if (profile.stats == nullptr) {
+      return StatementProbe();
+    }
+    return StatementProbe(profile.stats, kind, in.size(), in.iterator().byte, in.iterator().line);
+  }
+
+  // Probe for a line of input handled outside the grammar
+  [[nodiscard]] static StatementProbe ForLine(ParseStats* stats, StatementKind kind, std::string_view input,
+                                              std::string_view line, std::uint64_t line_number) noexcept {
+    if (stats == nullptr) {
+      return StatementProbe();
+    }
+    return StatementProbe(stats, kind, line.size(), static_cast<std::uint64_t>(line.data() - input.data()),
+                          line_number);
+  }
+
+  ~StatementProbe() {
+    if (stats_ == nullptr) {
+      return;
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start_;
+    const std::uint64_t allocations =
+        stats_->allocation_counter != nullptr ? stats_->allocation_counter() - allocations_ : 0;
+    stats_->Record(kind_, bytes_, offset_, line_,
+                   static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+                   allocations, failed_);
+  }
+
+  StatementProbe(const StatementProbe&) = delete;
+  StatementProbe& operator=(const StatementProbe&) = delete;
+  StatementProbe(StatementProbe&&) = delete;
+  StatementProbe& operator=(StatementProbe&&) = delete;
+
+  // Marks the statement as accepted by its section parser
+  void Succeeded() noexcept { failed_ = false; }
+
+ private:
+  ParseStats* stats_ = nullptr;
+  StatementKind kind_ = StatementKind::kUnknown;
+  std::uint64_t bytes_ = 0;
+  std::uint64_t offset_ = 0;
+  std::uint64_t line_ = 0;
+  std::uint64_t allocations_ = 0;
+  bool failed_ = true;
+  std::chrono::steady_clock::time_point start_;
+};
+
+// True if the line begins with the given statement keyword as a whole word,
+// so BA_DEF_DEF_REL_ is not taken for BA_DEF_DEF_. Indented lines never
+// match: they continue a statement, like the symbol list under NS_.
+[[nodiscard]] static bool StartsWithKeyword(std::string_view line, std::string_view keyword) noexcept {
+  if (line.substr(0, keyword.size()) != keyword) {
+    return false;
+  }
+  if (line.size() == keyword.size()) {
+    return true;
+  }
+  const char next = line[keyword.size()];
+  return next == ' ' || next == '\t' || next == ':' || next == '\r';
+}
+
 // State for parsing
 struct dbc_state {
   DbcFile dbc_file;
   bool found_valid_section = false;
   
+  // Optional ParseStats and trace spans of the statements
+  ParseProfile profile;
+  
   // Track version validity for invalid version format test
   bool invalid_version_format = false;
   
@@ -330,6 +479,10 @@ struct dbc_state {
   
   // Track current message ID for signal association
   int current_message_id = -1;
+
+  // ParseLimits::max_statement_bytes, and the size of the statement being read
+  std::size_t max_statement_bytes = SIZE_MAX;
+  std::size_t statement_bytes = 0;
   
   // Buffers for accumulating section content
   std::string version_content;
@@ -566,15 +719,38 @@ struct dbc_state {
   }
 };
 
+// Fails the parse if a statement is over ParseLimits::max_statement_bytes.
+// Called before the statement is copied into a section buffer.
+template<typename ActionInput>
+static void EnforceStatementLimit(const dbc_state& state, std::size_t statement_bytes, const ActionInput& in) {
+  if (statement_bytes > state.max_statement_bytes) {
+    throw pegtl::parse_error("statement exceeds the limit of " + std::to_string(state.max_statement_bytes) +
+                                 " bytes",
+                             in);
+  }
+}
+
 // Actions for grammar rules
 template <typename Rule>
 struct action : pegtl::nothing<Rule> {};
 
+// First line of a statement; continuation lines are added in indented_line
+template<>
+struct action<grammar::line_content> {
+  template<typename ActionInput>
+  static void apply(const ActionInput& in, dbc_state& state) {
+    state.statement_bytes = in.size();
+    EnforceStatementLimit(state, state.statement_bytes, in);
+  }
+};
+
 // Version actions
 template<>
 struct action<grammar::version_content> {
   template<typename ActionInput>
   static void apply(const ActionInput& in, dbc_state& state) {
+    EnforceStatementLimit(state, in.size(), in);
+    StatementProbe probe = StatementProbe::Start(state.profile, StatementKind::kVersion, in);
     state.set_version_content(in.string());
     
     // Process immediately to capture the version
@@ -582,6 +758,7 @@ struct action<grammar::version_content> {
     if (version_result) {
       state.dbc_file.version = version_result->version;
       state.found_valid_section = true;
+      probe.Succeeded();
     }
   }
 };
@@ -606,12 +783,14 @@ struct action<grammar::new_symbols_line> {
 template<>
 struct action<grammar::new_symbols_section> {
   template<typename ActionInput>
-  static void apply(const ActionInput&, dbc_state& state) {
+  static void apply(const ActionInput& in, dbc_state& state) {
+    StatementProbe probe = StatementProbe::Start(state.profile, StatementKind::kNewSymbols, in);
     if (!state.new_symbols_content.empty()) {
       auto symbols_result = NewSymbolsParser::Parse(state.new_symbols_content);
       if (symbols_result) {
         state.dbc_file.new_symbols = symbols_result->symbols;
         state.found_valid_section = true;
+        probe.Succeeded();
       }
     }
   }
@@ -629,15 +808,17 @@ struct action<grammar::nodes_line> {
 template<>
 struct action<grammar::nodes_section> {
   template<typename ActionInput>
-  static void apply(const ActionInput&, dbc_state& state) {
+  static void apply(const ActionInput& in, dbc_state& state) {
+    StatementProbe probe = StatementProbe::Start(state.profile, StatementKind::kNodes, in);
     if (!state.nodes_content.empty()) {
       auto nodes_result = NodesParser::Parse(state.nodes_content);
       if (nodes_result) {
         state.dbc_file.nodes.clear();
-        for (const auto& node : *nodes_result) {
-          state.dbc_file.nodes.push_back(node.name);
+        for (auto& node : *nodes_result) {
+          state.dbc_file.nodes.push_back(std::move(node.name));
         }
         state.found_valid_section = true;
+        probe.Succeeded();
       }
     }
   }
@@ -655,29 +836,48 @@ struct action<grammar::message_line> {
 template<>
 struct action<grammar::message_section> {
   template<typename ActionInput>
-  static void apply(const ActionInput&, dbc_state& state) {
+  static void apply(const ActionInput& in, dbc_state& state) {
+    // BO_TX_BU_ shares the BO_ prefix; those lines are parsed (and profiled)
+    // by the transmitter pass in Parse
+    if (StartsWithKeyword(state.message_content, "BO_TX_BU_")) {
+      return;
+    }
+    StatementProbe probe = StatementProbe::Start(state.profile, StatementKind::kMessage, in);
     if (!state.message_content.empty()) {
       auto message_result = MessageParser::Parse(state.message_content);
-      if (message_result) {
+      if (message_result && state.dbc_file.messages_detailed.count(message_result->id) != 0) {
+        // A repeated ID is rejected before its signals are appended, so the
+        // signal tables only ever hold rows of the message that owns them
+        DBC_LOG_WARN("Ignoring duplicate definition of message {}", message_result->id);
+      } else if (message_result) {
         // Store basic message info in the 'messages' map
         state.dbc_file.messages[message_result->id] = message_result->name;
         
-        // Create a detailed message definition
+        // Create a detailed message definition; the parse result is discarded
+        // afterwards, so its strings are moved rather than copied
         DbcFile::MessageDef msg_def;
         msg_def.id = message_result->id;
-        msg_def.name = message_result->name;
+        msg_def.name = std::move(message_result->name);
         msg_def.size = message_result->dlc;  // DLC corresponds to size
-        msg_def.transmitter = message_result->sender;  // Sender corresponds to transmitter
+        msg_def.transmitter = std::move(message_result->sender);  // Sender corresponds to transmitter
         
-        // Copy signals from the parsed message
-        msg_def.signals = message_result->signals;
+        // Split the signals into the hot layout table and the cold info table
+        auto& layouts = state.dbc_file.signal_layouts;
+        auto& infos = state.dbc_file.signal_infos;
+        msg_def.first_signal = static_cast<std::uint32_t>(layouts.size());
+        msg_def.signal_count = static_cast<std::uint32_t>(message_result->signals.size());
+        for (Signal& signal : message_result->signals) {
+          layouts.push_back(TypeConverter::ToSignalLayout(signal));
+          infos.push_back(TypeConverter::ToSignalInfo(std::move(signal), msg_def.id));
+        }
         
         // Store the detailed message in the messages_detailed map
-        state.dbc_file.messages_detailed[message_result->id] = msg_def;
+        state.dbc_file.messages_detailed.emplace(msg_def.id, std::move(msg_def));
         
         // Update current message ID for signal association
         state.current_message_id = message_result->id;
         state.found_valid_section = true;
+        probe.Succeeded();
       }
     }
   }
@@ -688,13 +888,14 @@ template<>
 struct action<grammar::message_transmitters_content> {
   template<typename ActionInput>
   static void apply(const ActionInput& in, dbc_state& state) {
+    EnforceStatementLimit(state, in.size(), in);
     std::string content = in.string();
     
     // Parse the message transmitters directly through the dedicated parser
     auto transmitters_result = MessageTransmittersParser::Parse(content);
     if (transmitters_result) {
       state.dbc_file.message_transmitters[transmitters_result->message_id] = 
-          transmitters_result->transmitters;
+          std::move(transmitters_result->transmitters);
       state.found_valid_section = true;
     }
   }
@@ -712,8 +913,13 @@ struct action<grammar::bit_timing_line> {
 template<>
 struct action<grammar::bit_timing_section> {
   template<typename ActionInput>
-  static void apply(const ActionInput&, dbc_state& state) {
-    if (!state.bit_timing_content.empty()) {
+  static void apply(const ActionInput& in, dbc_state& state) {
+    StatementProbe probe = StatementProbe::Start(state.profile, StatementKind::kBitTiming, in);
+    // Most files carry an empty "BS_:", which declares no bit timing
+    const std::string_view content = state.bit_timing_content;
+    if (content.size() >= 3 && StringUtils::TrimView(content.substr(3)) == ":") {
+      probe.Succeeded();
+    } else if (!state.bit_timing_content.empty()) {
       auto bit_timing_result = BitTimingParser::Parse(state.bit_timing_content);
       if (bit_timing_result) {
         // Set the bit timing data in the DbcFile
@@ -729,6 +935,7 @@ struct action<grammar::bit_timing_section> {
         
         state.dbc_file.bit_timing = bit_timing;
         state.found_valid_section = true;
+        probe.Succeeded();
       }
     }
   }
@@ -746,19 +953,21 @@ struct action<grammar::value_table_line> {
 template<>
 struct action<grammar::value_table_section> {
   template<typename ActionInput>
-  static void apply(const ActionInput&, dbc_state& state) {
+  static void apply(const ActionInput& in, dbc_state& state) {
+    StatementProbe probe = StatementProbe::Start(state.profile, StatementKind::kValueTable, in);
     if (!state.value_table_content.empty()) {
       auto value_table_result = ValueTableParser::Parse(state.value_table_content);
       if (value_table_result) {
         // Convert from unordered_map to map
         std::map<int, std::string> values_map;
-        for (const auto& [key, value] : value_table_result->values) {
-          values_map[key] = value;
+        for (auto& [key, value] : value_table_result->values) {
+          values_map.emplace(key, std::move(value));
         }
         
         // Add the value table to the map
-        state.dbc_file.value_tables[value_table_result->name] = values_map;
+        state.dbc_file.value_tables[std::move(value_table_result->name)] = std::move(values_map);
         state.found_valid_section = true;
+        probe.Succeeded();
       }
     }
   }
@@ -800,19 +1009,21 @@ struct action<grammar::sig_val_type_line> {
 template<>
 struct action<grammar::sig_val_type_section> {
   template<typename ActionInput>
-  static void apply(const ActionInput&, dbc_state& state) {
+  static void apply(const ActionInput& in, dbc_state& state) {
+    StatementProbe probe = StatementProbe::Start(state.profile, StatementKind::kSignalValueType, in);
     if (!state.sig_val_type_content.empty()) {
       auto sig_val_type_result = SignalValueTypeParser::Parse(state.sig_val_type_content);
       if (sig_val_type_result) {
         // Create a new signal value type definition
         DbcFile::SignalValueType sig_val_type;
         sig_val_type.message_id = sig_val_type_result->message_id;
-        sig_val_type.signal_name = sig_val_type_result->signal_name;
+        sig_val_type.signal_name = std::move(sig_val_type_result->signal_name);
         sig_val_type.value_type = sig_val_type_result->type;
         
         // Add the signal value type to the list
-        state.dbc_file.signal_value_types.push_back(sig_val_type);
+        state.dbc_file.signal_value_types.push_back(std::move(sig_val_type));
         state.found_valid_section = true;
+        probe.Succeeded();
       }
     }
   }
@@ -830,23 +1041,25 @@ struct action<grammar::sig_group_line> {
 template<>
 struct action<grammar::sig_group_section> {
   template<typename ActionInput>
-  static void apply(const ActionInput&, dbc_state& state) {
+  static void apply(const ActionInput& in, dbc_state& state) {
+    StatementProbe probe = StatementProbe::Start(state.profile, StatementKind::kSignalGroup, in);
     if (!state.sig_group_content.empty()) {
       // Trim any trailing newlines and whitespace
-      std::string content = StringUtilities::Trim(state.sig_group_content);
+      std::string_view content = StringUtilities::Trim(state.sig_group_content);
       
       auto sig_group_result = SignalGroupParser::Parse(content);
       if (sig_group_result) {
         // Create a new signal group definition
         DbcFile::SignalGroupDef sig_group;
         sig_group.message_id = sig_group_result->message_id;
-        sig_group.name = sig_group_result->group_name;
+        sig_group.name = std::move(sig_group_result->group_name);
         sig_group.repetitions = sig_group_result->repetitions;
-        sig_group.signal_names = sig_group_result->signals;
+        sig_group.signal_names = std::move(sig_group_result->signals);
         
         // Add the signal group to the list
-        state.dbc_file.signal_groups.push_back(sig_group);
+        state.dbc_file.signal_groups.push_back(std::move(sig_group));
         state.found_valid_section = true;
+        probe.Succeeded();
       }
     }
   }
@@ -864,16 +1077,23 @@ struct action<grammar::attr_def_line> {
 template<>
 struct action<grammar::attr_def_section> {
   template<typename ActionInput>
-  static void apply(const ActionInput&, dbc_state& state) {
+  static void apply(const ActionInput& in, dbc_state& state) {
+    // BA_DEF_DEF_ shares the BA_DEF_ prefix; those lines are parsed (and
+    // profiled) by the attribute default pass in Parse. The prefix test also
+    // leaves out BA_DEF_DEF_REL_, which that pass does not count either.
+    if (std::string_view(state.attr_def_content).substr(0, 11) == "BA_DEF_DEF_") {
+      return;
+    }
+    StatementProbe probe = StatementProbe::Start(state.profile, StatementKind::kAttributeDefinition, in);
     if (!state.attr_def_content.empty()) {
       // Trim any trailing newlines and whitespace
-      std::string content = StringUtilities::Trim(state.attr_def_content);
+      std::string_view content = StringUtilities::Trim(state.attr_def_content);
       
       auto attr_def_result = AttributeDefinitionParser::Parse(content);
       if (attr_def_result) {
         // Create a new attribute definition
         DbcFile::AttributeDef attr_def;
-        attr_def.name = attr_def_result->name;
+        attr_def.name = std::move(attr_def_result->name);
         
         // Map the object type
         switch (attr_def_result->object_type) {
@@ -917,8 +1137,8 @@ struct action<grammar::attr_def_section> {
             break;
         }
         
-        // Copy enum values if present
-        attr_def.enum_values = attr_def_result->enum_values;
+        // Take over enum values if present
+        attr_def.enum_values = std::move(attr_def_result->enum_values);
         
         // Set min/max values if present
         if (attr_def_result->min_value.has_value()) {
@@ -930,8 +1150,9 @@ struct action<grammar::attr_def_section> {
         }
         
         // Add the attribute definition to the list
-        state.dbc_file.attribute_definitions.push_back(attr_def);
+        state.dbc_file.attribute_definitions.push_back(std::move(attr_def));
         state.found_valid_section = true;
+        probe.Succeeded();
       }
     }
   }
@@ -952,7 +1173,7 @@ struct action<grammar::attr_def_def_section> {
   static void apply(const ActionInput&, dbc_state& state) {
     if (!state.attr_def_def_content.empty()) {
       // Trim any trailing newlines and whitespace
-      std::string content = StringUtilities::Trim(state.attr_def_def_content);
+      std::string_view content = StringUtilities::Trim(state.attr_def_def_content);
       
       auto attr_def_def_result = AttributeDefinitionDefaultParser::Parse(content);
       if (attr_def_def_result) {
@@ -969,7 +1190,7 @@ struct action<grammar::attr_def_def_section> {
         }
         
         // Add the attribute default to the map
-        state.dbc_file.attribute_defaults[attr_def_def_result->name] = default_value_str;
+        state.dbc_file.attribute_defaults[attr_def_def_result->name] = std::move(default_value_str);
         state.found_valid_section = true;
       }
     }
@@ -988,10 +1209,11 @@ struct action<grammar::comment_line> {
 template<>
 struct action<grammar::comment_section> {
   template<typename ActionInput>
-  static void apply(const ActionInput&, dbc_state& state) {
+  static void apply(const ActionInput& in, dbc_state& state) {
+    StatementProbe probe = StatementProbe::Start(state.profile, StatementKind::kComment, in);
     if (!state.comment_content.empty()) {
       // Trim any trailing newlines and whitespace
-      std::string content = StringUtilities::Trim(state.comment_content);
+      std::string_view content = StringUtilities::Trim(state.comment_content);
       
       // Use the existing CommentParser
       auto comment_result = CommentParser::Parse(content);
@@ -1001,7 +1223,7 @@ struct action<grammar::comment_section> {
         DbcFile::CommentDef comment_def;
         
         // Set the comment text
-        comment_def.text = comment_result->text;
+        comment_def.text = std::move(comment_result->text);
         
         // Set the comment type and associated object based on the comment type
         if (comment_result->type == CommentType::NETWORK) {
@@ -1009,7 +1231,7 @@ struct action<grammar::comment_section> {
         } else if (comment_result->type == CommentType::NODE) {
           comment_def.type = CommentType::NODE;
           if (std::holds_alternative<std::string>(comment_result->identifier)) {
-            comment_def.object_name = std::get<std::string>(comment_result->identifier);
+            comment_def.object_name = std::move(std::get<std::string>(comment_result->identifier));
           }
         } else if (comment_result->type == CommentType::MESSAGE) {
           comment_def.type = CommentType::MESSAGE;
@@ -1019,31 +1241,46 @@ struct action<grammar::comment_section> {
         } else if (comment_result->type == CommentType::SIGNAL) {
           comment_def.type = CommentType::SIGNAL;
           if (std::holds_alternative<std::pair<int, std::string>>(comment_result->identifier)) {
-            const auto& id_pair = std::get<std::pair<int, std::string>>(comment_result->identifier);
+            auto& id_pair = std::get<std::pair<int, std::string>>(comment_result->identifier);
             comment_def.object_id = id_pair.first;
             comment_def.signal_index = 0;  // We don't have signal indices yet, set to 0
-            comment_def.object_name = id_pair.second;  // Store signal name in object_name
+            comment_def.object_name = std::move(id_pair.second);  // Store signal name in object_name
           }
         } else if (comment_result->type == CommentType::ENV_VAR) {
           comment_def.type = CommentType::ENV_VAR;
           if (std::holds_alternative<std::string>(comment_result->identifier)) {
-            comment_def.object_name = std::get<std::string>(comment_result->identifier);
+            comment_def.object_name = std::move(std::get<std::string>(comment_result->identifier));
           }
         }
         
         // Add the comment to the list
-        state.dbc_file.comments.push_back(comment_def);
+        state.dbc_file.comments.push_back(std::move(comment_def));
         state.found_valid_section = true;
+        probe.Succeeded();
       }
     }
   }
 };
 
+// SG_MUL_VAL_ is not modelled yet; it is only counted for ParseStats. Without
+// it the parent of a signal under a nested multiplexor is unknown, so
+// SignalDecoder does not decode multiplexed signals of such messages.
+template<>
+struct action<grammar::sig_mul_val_section> {
+  template<typename ActionInput>
+  static void apply(const ActionInput& in, dbc_state& state) {
+    StatementProbe probe = StatementProbe::Start(state.profile, StatementKind::kSignalMultiplexValues, in);
+    probe.Succeeded();
+  }
+};
+
 // Continuation line handling based on current section
 template<>
 struct action<grammar::indented_line> {
   template<typename ActionInput>
   static void apply(const ActionInput& in, dbc_state& state) {
+    state.statement_bytes += in.size();
+    EnforceStatementLimit(state, state.statement_bytes, in);
     std::string content = in.string();
     
     // Handle continuation lines based on current section
@@ -1124,10 +1361,11 @@ struct action<grammar::env_var_data_line> {
 template<>
 struct action<grammar::env_var_data_section> {
   template<typename ActionInput>
-  static void apply(const ActionInput&, dbc_state& state) {
+  static void apply(const ActionInput& in, dbc_state& state) {
+    StatementProbe probe = StatementProbe::Start(state.profile, StatementKind::kEnvironmentVariableData, in);
     if (!state.env_var_data_content.empty()) {
       // Trim any trailing newlines and whitespace
-      std::string content = StringUtilities::Trim(state.env_var_data_content);
+      std::string_view content = StringUtilities::Trim(state.env_var_data_content);
       
       // Use the existing EnvironmentVariableDataParser
       auto env_var_data_result = EnvironmentVariableDataParser::Parse(content);
@@ -1135,73 +1373,254 @@ struct action<grammar::env_var_data_section> {
       if (env_var_data_result) {
         // Create a new environment variable data entry
         DbcFile::EnvVarData env_var_data;
-        env_var_data.data_name = env_var_data_result->name;
+        env_var_data.data_name = std::move(env_var_data_result->name);
         
         // Store in the environment_variable_data map with name as the key
-        state.dbc_file.environment_variable_data[env_var_data.data_name] = env_var_data;
+        std::string key = env_var_data.data_name;
+        state.dbc_file.environment_variable_data.insert_or_assign(std::move(key), std::move(env_var_data));
         state.found_valid_section = true;
+        probe.Succeeded();
       }
     }
   }
 };
 
+std::optional<std::uint32_t> DbcFile::FindSignal(int message_id,
+                                                 std::string_view signal_name) const noexcept {
+  auto it = messages_detailed.find(message_id);
+  if (it == messages_detailed.end()) {
+    return std::nullopt;
+  }
+  const MessageDef& message = it->second;
+  for (std::uint32_t id = message.first_signal; id < message.first_signal + message.signal_count; ++id) {
+    if (signal_infos[id].name == signal_name) {
+      return id;
+    }
+  }
+  return std::nullopt;
+}
+
+// Marks IEEE float/double signals in the layout table. SIG_VALTYPE_ usually
+// follows the BO_ blocks, so this runs once the whole file has been seen.
+static void ApplySignalValueTypes(DbcFile& dbc_file) noexcept {
+  for (const auto& value_type : dbc_file.signal_value_types) {
+    auto id = dbc_file.FindSignal(value_type.message_id, value_type.signal_name);
+    if (!id) {
+      continue;
+    }
+    SignalLayout& layout = dbc_file.signal_layouts[*id];
+    layout.flags &= static_cast<std::uint8_t>(~(SignalLayout::kFloat32 | SignalLayout::kFloat64));
+    if (value_type.value_type == 1) {
+      layout.flags |= SignalLayout::kFloat32;
+    } else if (value_type.value_type == 2) {
+      layout.flags |= SignalLayout::kFloat64;
+    }
+  }
+}
+
+// Value names of an ENUM attribute, from its BA_DEF_ or, if the file does
+// not define it, the given list
+static const std::vector<std::string>& EnumValues(const DbcFile& dbc_file, std::string_view attribute,
+                                                  const std::vector<std::string>& fallback) noexcept {
+  for (const auto& definition : dbc_file.attribute_definitions) {
+    if (definition.name == attribute && definition.value_type == AttributeValueType::ENUM) {
+      return definition.enum_values;
+    }
+  }
+  return fallback;
+}
+
+// BA_ writes an ENUM value as an index into the value names; defaults and
+// some tools write the name itself
+static std::optional<std::string_view> EnumName(const std::vector<std::string>& names,
+                                                std::string_view value) noexcept {
+  std::size_t index = 0;
+  const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), index);
+  if (error != std::errc() || end != value.data() + value.size()) {
+    return value;
+  }
+  if (index >= names.size()) {
+    return std::nullopt;
+  }
+  return names[index];
+}
+
+static std::optional<FrameFormat> ToFrameFormat(std::optional<std::string_view> name) noexcept {
+  if (name == "StandardCAN") {
+    return FrameFormat::kStandardCan;
+  }
+  if (name == "ExtendedCAN") {
+    return FrameFormat::kExtendedCan;
+  }
+  if (name == "J1939PG") {
+    return FrameFormat::kJ1939;
+  }
+  if (name == "StandardCAN_FD") {
+    return FrameFormat::kStandardCanFd;
+  }
+  if (name == "ExtendedCAN_FD") {
+    return FrameFormat::kExtendedCanFd;
+  }
+  return std::nullopt;
+}
+
+// Whether the network's ProtocolType, from BA_ or BA_DEF_DEF_, is J1939
+static bool IsJ1939Network(const DbcFile& dbc_file) noexcept {
+  for (const auto& value : dbc_file.attribute_values) {
+    if (value.attr_name == "ProtocolType" && value.node_name.empty() && value.message_id == 0 &&
+        value.signal_name.empty() && value.env_var_name.empty()) {
+      return value.value == "J1939";
+    }
+  }
+  auto it = dbc_file.attribute_defaults.find("ProtocolType");
+  return it != dbc_file.attribute_defaults.end() && it->second == "J1939";
+}
+
+// Sets MessageDef::frame_format and bit_rate_switch from the VFrameFormat
+// and CANFD_BRS attributes. The attribute decides between classic CAN,
+// J1939 and CAN FD; the ID decides between standard and extended, so a
+// StandardCAN default does not contradict an extended ID. Without a
+// VFrameFormat default, extended messages of a J1939 network are J1939PG.
+static void ApplyFrameFormats(DbcFile& dbc_file) {
+  // The value lists CANdb++ writes, for files that assign the attributes
+  // without defining them
+  static const std::vector<std::string> kFrameFormatNames = {
+      "StandardCAN", "ExtendedCAN", "reserved", "J1939PG",  "reserved",       "reserved",
+      "reserved",    "reserved",    "reserved", "reserved", "reserved",       "reserved",
+      "reserved",    "reserved",    "StandardCAN_FD",       "ExtendedCAN_FD"};
+  static const std::vector<std::string> kBitRateSwitchNames = {"0", "1"};
+  const auto& format_names = EnumValues(dbc_file, "VFrameFormat", kFrameFormatNames);
+  const auto& brs_names = EnumValues(dbc_file, "CANFD_BRS", kBitRateSwitchNames);
+
+  std::optional<FrameFormat> default_format;
+  if (auto it = dbc_file.attribute_defaults.find("VFrameFormat"); it != dbc_file.attribute_defaults.end()) {
+    default_format = ToFrameFormat(EnumName(format_names, it->second));
+  }
+  bool default_brs = false;
+  if (auto it = dbc_file.attribute_defaults.find("CANFD_BRS"); it != dbc_file.attribute_defaults.end()) {
+    default_brs = EnumName(brs_names, it->second) == "1";
+  }
+  const bool j1939_network = IsJ1939Network(dbc_file);
+  for (auto& [id, message] : dbc_file.messages_detailed) {
+    const bool extended = (static_cast<std::uint32_t>(id) & 0x80000000u) != 0;
+    message.frame_format =
+        default_format.value_or(j1939_network && extended ? FrameFormat::kJ1939 : FrameFormat::kStandardCan);
+    message.bit_rate_switch = default_brs;
+  }
+
+  for (const auto& value : dbc_file.attribute_values) {
+    const bool is_format = value.attr_name == "VFrameFormat";
+    if ((!is_format && value.attr_name != "CANFD_BRS") || !value.signal_name.empty()) {
+      continue;
+    }
+    auto it = dbc_file.messages_detailed.find(value.message_id);
+    if (it == dbc_file.messages_detailed.end()) {
+      continue;
+    }
+    if (is_format) {
+      it->second.frame_format = ToFrameFormat(EnumName(format_names, value.value)).value_or(it->second.frame_format);
+    } else {
+      it->second.bit_rate_switch = EnumName(brs_names, value.value) == "1";
+    }
+  }
+
+  for (auto& [id, message] : dbc_file.messages_detailed) {
+    const bool extended = (static_cast<std::uint32_t>(id) & 0x80000000u) != 0;
+    if (message.is_fd()) {
+      message.frame_format = extended ? FrameFormat::kExtendedCanFd : FrameFormat::kStandardCanFd;
+    } else if (message.frame_format != FrameFormat::kJ1939) {
+      message.frame_format = extended ? FrameFormat::kExtendedCan : FrameFormat::kStandardCan;
+    }
+    message.bit_rate_switch = message.bit_rate_switch && message.is_fd();
+  }
+}
+
 // Main parser implementation
-std::optional<DbcFile> DbcFileParser::Parse(std::string_view input) {
-  // Initialize logger if not already initialized
-  if (!Logger::GetLogger()) {
-    Logger::Initialize("info");
-    DBC_LOG_INFO_STR("DBC Parser initialized");
+std::optional<DbcFile> DbcFileParser::Parse(std::string_view input, ParseStats* stats) {
+  // Counts the whole call, grammar and post-processing included, on every
+  // return path
+  struct TotalTimer {
+    ParseStats* stats;
+    std::chrono::steady_clock::time_point start;
+    ~TotalTimer() {
+      if (stats != nullptr) {
+        stats->total_nanoseconds += static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+      }
+    }
+  };
+  TotalTimer total_timer{stats, stats != nullptr ? std::chrono::steady_clock::now()
+                                                 : std::chrono::steady_clock::time_point()};
+  if (stats != nullptr) {
+    stats->input_bytes += input.size();
   }
+  DBC_TRACE_SPAN(kTraceCategory, "DbcFileParser::Parse");
 
   // Empty input check
   if (input.empty()) {
     DBC_LOG_ERROR_STR("Empty input provided to DBC parser");
     return std::nullopt;
   }
+  if (input.size() > limits_.max_input_bytes) {
+    DBC_LOG_ERROR("Input of {} bytes exceeds the limit of {} bytes", input.size(), limits_.max_input_bytes);
+    return std::nullopt;
+  }
   
-  std::stringstream debug_msg;
-  debug_msg << "Starting to parse DBC file of size: " << input.size();
-  DBC_LOG_DEBUG_STR(debug_msg.str());
+  DBC_LOG_DEBUG("Starting to parse DBC file of size: {}", input.size());
   
-  // Analyze grammar for potential issues
-  if (const std::size_t issues = pegtl::analyze<grammar::dbc_file>()) {
+  // Analyze grammar for potential issues; the grammar is fixed, so once per
+  // process is enough
+  static const std::size_t grammar_issues = pegtl::analyze<grammar::dbc_file>();
+  if (grammar_issues != 0) {
     // We can still try to parse even if analysis shows issues
-    std::stringstream warn_msg;
-    warn_msg << "Grammar analysis found " << issues << " issues";
-    DBC_LOG_WARN_STR(warn_msg.str());
+    DBC_LOG_WARN("Grammar analysis found {} issues", grammar_issues);
   }
 
   try {
     // Initialize parsing state
     dbc_state state;
+    state.profile.stats = stats;
+    state.max_statement_bytes = limits_.max_statement_bytes;
     
     // Parse input using PEGTL
     pegtl::memory_input in(input.data(), input.size(), "DBC file");
-    if (pegtl::parse<grammar::dbc_file, action>(in, state)) {
+    bool parsed = false;
+    {
+      DBC_TRACE_SPAN(kTraceCategory, "grammar");
+      parsed = pegtl::parse<grammar::dbc_file, action>(in, state);
+      state.profile.trace.Flush();
+    }
+    if (parsed) {
       // Handle invalid version format test
       if (state.invalid_version_format) {
         DBC_LOG_ERROR_STR("Invalid VERSION format detected");
         return std::nullopt;
       }
       
-      // Direct processing of message transmitters
-      std::string input_str(input);
-      std::istringstream iss(input_str);
-      std::string line;
-      
-      while (std::getline(iss, line)) {
-        if (line.find("BO_TX_BU_") != std::string::npos) {
+      // Direct processing of message transmitters; lines are views into the
+      // caller's buffer, so the input is not copied for this pass
+      const std::uint64_t scan_start_ns = core::Tracer::IsEnabled() ? core::Tracer::NowNanoseconds() : 0;
+      std::uint64_t line_number = 0;
+      for (std::string_view line : StringUtils::SplitLazy(input, '\n')) {
+        ++line_number;
+        if (line.find("BO_TX_BU_") != std::string_view::npos) {
+          // Only statements are profiled, not mentions of the keyword elsewhere
+          StatementProbe probe = StatementProbe::ForLine(StartsWithKeyword(line, "BO_TX_BU_") ? stats : nullptr,
+                                                         StatementKind::kMessageTransmitters, input, line, line_number);
           // Process this line directly
           auto transmitters_result = MessageTransmittersParser::Parse(line);
           if (transmitters_result) {
             state.dbc_file.message_transmitters[transmitters_result->message_id] = 
-                transmitters_result->transmitters;
+                std::move(transmitters_result->transmitters);
             state.found_valid_section = true;
+            probe.Succeeded();
           }
         }
         
         // Special handling for attribute definition defaults which may not be matched by our grammar
-        if (line.find("BA_DEF_DEF_") != std::string::npos) {
+        if (line.find("BA_DEF_DEF_") != std::string_view::npos) {
+          StatementProbe probe = StatementProbe::ForLine(StartsWithKeyword(line, "BA_DEF_DEF_") ? stats : nullptr,
+                                                         StatementKind::kAttributeDefault, input, line, line_number);
           // Try to parse using the dedicated parser
           auto attr_def_def_result = AttributeDefinitionDefaultParser::Parse(line);
           if (attr_def_def_result) {
@@ -1214,17 +1633,18 @@ std::optional<DbcFile> DbcFileParser::Parse(std::string_view input) {
             } else if (std::holds_alternative<double>(attr_def_def_result->default_value)) {
               default_value_str = std::to_string(std::get<double>(attr_def_def_result->default_value));
             } else if (std::holds_alternative<std::string>(attr_def_def_result->default_value)) {
-              default_value_str = std::get<std::string>(attr_def_def_result->default_value);
+              default_value_str = std::move(std::get<std::string>(attr_def_def_result->default_value));
             }
             
             // Add the attribute default to the map
-            state.dbc_file.attribute_defaults[attr_def_def_result->name] = default_value_str;
+            state.dbc_file.attribute_defaults[attr_def_def_result->name] = std::move(default_value_str);
             state.found_valid_section = true;
+            probe.Succeeded();
           }
         }
 
         // Direct processing of node definitions (BU_)
-        if (line.find("BU_:") != std::string::npos || line.find("BU_: ") != std::string::npos) {
+        if (line.find("BU_:") != std::string_view::npos || line.find("BU_: ") != std::string_view::npos) {
           // Try to parse using the dedicated parser
           auto nodes_result = NodesParser::Parse(line);
           if (nodes_result) {
@@ -1232,28 +1652,37 @@ std::optional<DbcFile> DbcFileParser::Parse(std::string_view input) {
             state.dbc_file.nodes.clear();
             
             // Add all nodes to the result
-            for (const auto& node : *nodes_result) {
-              state.dbc_file.nodes.push_back(node.name);
+            for (auto& node : *nodes_result) {
+              state.dbc_file.nodes.push_back(std::move(node.name));
             }
             
             state.found_valid_section = true;
           }
         }
       }
+      if (scan_start_ns != 0) {
+        core::Tracer::RecordSpan(kTraceCategory, "line scan", scan_start_ns, core::Tracer::NowNanoseconds(),
+                                 static_cast<std::int64_t>(line_number));
+      }
+      
+      {
+        DBC_TRACE_SPAN(kTraceCategory, "model assembly");
+        ApplySignalValueTypes(state.dbc_file);
+        ApplyFrameFormats(state.dbc_file);
+      }
+      core::Tracer::RecordCounter(kTraceCategory, "messages", static_cast<double>(state.dbc_file.messages.size()));
+      core::Tracer::RecordCounter(kTraceCategory, "signals",
+                                  static_cast<double>(state.dbc_file.signal_layouts.size()));
       
       // Return result if we found at least one valid section
       if (state.found_valid_section) {
-        std::stringstream info_msg;
-        info_msg << "Successfully parsed DBC file with " << state.dbc_file.messages.size() << " messages";
-        DBC_LOG_INFO_STR(info_msg.str());
-        return state.dbc_file;
+        DBC_LOG_DEBUG("Successfully parsed DBC file with {} messages", state.dbc_file.messages.size());
+        return std::move(state.dbc_file);
       }
     }
   } catch (const pegtl::parse_error& e) {
     // Handle parsing errors with detailed information
-    std::stringstream error_msg;
-    error_msg << "Parse error: " << e.what();
-    DBC_LOG_ERROR_STR(error_msg.str());
+    DBC_LOG_ERROR("Parse error: {}", e.what());
     return std::nullopt;
   }
 
@@ -1264,10 +1693,11 @@ std::optional<DbcFile> DbcFileParser::Parse(std::string_view input) {
 template<>
 struct action<grammar::env_var_section> {
   template<typename ActionInput>
-  static void apply(const ActionInput&, dbc_state& state) {
+  static void apply(const ActionInput& in, dbc_state& state) {
+    StatementProbe probe = StatementProbe::Start(state.profile, StatementKind::kEnvironmentVariable, in);
     if (!state.env_var_content.empty()) {
       // Trim any trailing newlines and whitespace
-      std::string content = StringUtilities::Trim(state.env_var_content);
+      std::string_view content = StringUtilities::Trim(state.env_var_content);
       
       // Use the existing EnvironmentVariableParser
       auto env_var_result = EnvironmentVariableParser::Parse(content);
@@ -1275,44 +1705,38 @@ struct action<grammar::env_var_section> {
       if (env_var_result) {
         // Create a new environment variable entry
         DbcFile::EnvVar env_var;
-        env_var.name = env_var_result->name;
+        env_var.name = std::move(env_var_result->name);
         env_var.type = env_var_result->var_type;
         env_var.min_value = env_var_result->minimum;
         env_var.max_value = env_var_result->maximum;
-        env_var.unit = env_var_result->unit;
+        env_var.unit = std::move(env_var_result->unit);
         env_var.initial_value = env_var_result->initial_value;
         env_var.ev_id = env_var_result->ev_id;
-        env_var.access_type = env_var_result->access_type;
+        env_var.access_type = std::move(env_var_result->access_type);
         
         // Convert access_nodes string to vector using the utility class
         env_var.access_nodes = StringUtilities::SplitTrimmed(env_var_result->access_nodes, ',');
         
         // Store in the environment_variables map with name as the key
-        state.dbc_file.environment_variables[env_var.name] = env_var;
+        std::string key = env_var.name;
+        state.dbc_file.environment_variables.insert_or_assign(std::move(key), std::move(env_var));
         state.found_valid_section = true;
+        probe.Succeeded();
       }
     }
   }
 };
 
-// Debug function to print a line from the parser
+// Lines without a known keyword are skipped; they are only counted for
+// ParseStats and, when trace logging is compiled in, logged
 template<>
 struct action<grammar::any_line> {
   template<typename ActionInput>
   static void apply(const ActionInput& in, dbc_state& state) {
-    std::string line = in.string();
-    if (line.find("BA_DEF_DEF_") != std::string::npos) {
-      // Detailed grammar rule debug
-      bool starts_with_ws = std::regex_match(line, std::regex("^\\s+.*"));
-      bool has_semicolon = line.find(';') != std::string::npos;
-      bool ends_with_eol = line.find('\n') != std::string::npos || line.find('\r') != std::string::npos;
-      
-      std::stringstream debug_grammar_msg;
-      debug_grammar_msg << "Grammar debug - starts_with_ws: " << starts_with_ws 
-                << ", has_semicolon: " << has_semicolon 
-                << ", ends_with_eol: " << ends_with_eol;
-      DBC_LOG_DEBUG_STR(debug_grammar_msg.str());
-    }
+    EnforceStatementLimit(state, in.size(), in);
+    StatementProbe probe = StatementProbe::Start(state.profile, StatementKind::kUnknown, in);
+    probe.Succeeded();
+    DBC_LOG_TRACE("Skipping unknown line {}: {}", in.iterator().line, StringUtils::TrimView(in.string_view()));
   }
 };
 
@@ -1338,7 +1762,7 @@ struct action<grammar::direct_attr_def_def_line> {
       }
       
       // Add the attribute default to the map
-      state.dbc_file.attribute_defaults[attr_def_def_result->name] = default_value_str;
+      state.dbc_file.attribute_defaults[attr_def_def_result->name] = std::move(default_value_str);
       state.found_valid_section = true;
     }
   }
@@ -1356,10 +1780,11 @@ struct action<grammar::attr_line> {
 template<>
 struct action<grammar::attr_section> {
   template<typename ActionInput>
-  static void apply(const ActionInput&, dbc_state& state) {
+  static void apply(const ActionInput& in, dbc_state& state) {
+    StatementProbe probe = StatementProbe::Start(state.profile, StatementKind::kAttributeValue, in);
     if (!state.attr_content.empty()) {
       // Trim any trailing newlines and whitespace
-      std::string content = StringUtilities::Trim(state.attr_content);
+      std::string_view content = StringUtilities::Trim(state.attr_content);
       
       // Use the AttributeValueParser to parse the attribute value
       auto attr_value_result = AttributeValueParser::Parse(content);
@@ -1382,7 +1807,7 @@ struct action<grammar::attr_section> {
             
           case AttributeObjectType::NODE:
             if (std::holds_alternative<std::string>(attr_value_result->object_id)) {
-              attr_value.node_name = std::get<std::string>(attr_value_result->object_id);
+              attr_value.node_name = std::move(std::get<std::string>(attr_value_result->object_id));
             }
             break;
             
@@ -1394,15 +1819,15 @@ struct action<grammar::attr_section> {
             
           case AttributeObjectType::SIGNAL:
             if (std::holds_alternative<std::pair<int, std::string>>(attr_value_result->object_id)) {
-              const auto& id_pair = std::get<std::pair<int, std::string>>(attr_value_result->object_id);
+              auto& id_pair = std::get<std::pair<int, std::string>>(attr_value_result->object_id);
               attr_value.message_id = id_pair.first;
-              attr_value.signal_name = id_pair.second;
+              attr_value.signal_name = std::move(id_pair.second);
             }
             break;
             
           case AttributeObjectType::ENV_VAR:
             if (std::holds_alternative<std::string>(attr_value_result->object_id)) {
-              attr_value.env_var_name = std::get<std::string>(attr_value_result->object_id);
+              attr_value.env_var_name = std::move(std::get<std::string>(attr_value_result->object_id));
             }
             break;
         }
@@ -1413,12 +1838,13 @@ struct action<grammar::attr_section> {
         } else if (std::holds_alternative<double>(attr_value_result->value)) {
           attr_value.value = std::to_string(std::get<double>(attr_value_result->value));
         } else if (std::holds_alternative<std::string>(attr_value_result->value)) {
-          attr_value.value = std::get<std::string>(attr_value_result->value);
+          attr_value.value = std::move(std::get<std::string>(attr_value_result->value));
         }
         
         // Add the attribute value to the list
-        state.dbc_file.attribute_values.push_back(attr_value);
+        state.dbc_file.attribute_values.push_back(std::move(attr_value));
         state.found_valid_section = true;
+        probe.Succeeded();
       }
     }
   }
@@ -1436,10 +1862,11 @@ struct action<grammar::value_desc_line> {
 template<>
 struct action<grammar::value_desc_section> {
   template<typename ActionInput>
-  static void apply(const ActionInput&, dbc_state& state) {
+  static void apply(const ActionInput& in, dbc_state& state) {
+    StatementProbe probe = StatementProbe::Start(state.profile, StatementKind::kValueDescription, in);
     if (!state.value_desc_content.empty()) {
       // Trim any trailing newlines and whitespace
-      std::string content = StringUtilities::Trim(state.value_desc_content);
+      std::string_view content = StringUtilities::Trim(state.value_desc_content);
       
       // Use the ValueDescriptionParser to parse the value description
       auto value_desc_result = ValueDescriptionParser::Parse(content);
@@ -1452,42 +1879,45 @@ struct action<grammar::value_desc_section> {
         if (std::holds_alternative<std::pair<int, std::string>>(value_desc_result->identifier)) {
           // For signal value descriptions, we need message ID and signal name
           // These are stored in the identifier pair from ValueDescriptionParser
-          const auto& id_pair = std::get<std::pair<int, std::string>>(value_desc_result->identifier);
+          auto& id_pair = std::get<std::pair<int, std::string>>(value_desc_result->identifier);
           value_desc.message_id = id_pair.first;
-          value_desc.signal_name = id_pair.second;
+          value_desc.signal_name = std::move(id_pair.second);
           
-          // Copy the value descriptions map to values
-          for (const auto& [val, desc] : value_desc_result->value_descriptions) {
-            value_desc.values[val] = desc;
+          // Move the value descriptions map into values
+          for (auto& [val, desc] : value_desc_result->value_descriptions) {
+            value_desc.values[val] = std::move(desc);
           }
           
           // Add to the DBC file
-          state.dbc_file.value_descriptions.push_back(value_desc);
+          state.dbc_file.value_descriptions.push_back(std::move(value_desc));
           state.found_valid_section = true;
+          probe.Succeeded();
         } else if (std::holds_alternative<std::string>(value_desc_result->identifier)) {
           // For environment variable value descriptions, the identifier
           // from ValueDescriptionParser contains just the environment variable name
-          const auto& env_var_name = std::get<std::string>(value_desc_result->identifier);
+          auto& env_var_name = std::get<std::string>(value_desc_result->identifier);
           
           // Create a value description for environment variable
           DbcFile::ValueDescription env_var_value_desc;
           
           // Store env_var_name in the signal_name field
-          env_var_value_desc.signal_name = env_var_name;
+          env_var_value_desc.type = ValueDescriptionType::ENV_VAR;
+          env_var_value_desc.signal_name = std::move(env_var_name);
           
           // Use special message_id (-1) to indicate this is for an environment variable
           // This allows us to distinguish between signal and environment variable value descriptions
           // while using the same ValueDescription structure
           env_var_value_desc.message_id = -1;
           
-          // Copy the value descriptions map
-          for (const auto& [val, desc] : value_desc_result->value_descriptions) {
-            env_var_value_desc.values[val] = desc;
+          // Move the value descriptions map
+          for (auto& [val, desc] : value_desc_result->value_descriptions) {
+            env_var_value_desc.values[val] = std::move(desc);
           }
           
           // Add to the same list as signal value descriptions
-          state.dbc_file.value_descriptions.push_back(env_var_value_desc);
+          state.dbc_file.value_descriptions.push_back(std::move(env_var_value_desc));
           state.found_valid_section = true;
+          probe.Succeeded();
         }
       }
     }
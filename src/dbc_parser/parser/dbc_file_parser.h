@@ -1,6 +1,8 @@
 #ifndef DBC_PARSER_PARSER_DBC_FILE_PARSER_H_
 #define DBC_PARSER_PARSER_DBC_FILE_PARSER_H_
 
+#include <cstddef>
+#include <cstdint>
 #include <map>
 #include <optional>
 #include <string>
@@ -10,6 +12,7 @@
 
 #include "dbc_parser/common/common_types.h"
 #include "dbc_parser/parser/message/message_parser.h"
+#include "dbc_parser/parser/parse_stats.h"
 
 namespace dbc_parser {
 namespace parser {
@@ -63,6 +66,10 @@ struct DbcFile {
 
     BitTiming() noexcept = default;
     ~BitTiming() noexcept = default;
+    BitTiming(const BitTiming&) = default;
+    BitTiming& operator=(const BitTiming&) = default;
+    BitTiming(BitTiming&&) = default;
+    BitTiming& operator=(BitTiming&&) = default;
   };
   
   /**
@@ -87,26 +94,58 @@ struct DbcFile {
   /**
    * @brief Internal structure for detailed message information.
    *
-   * Represents a CAN message with its signals from the BO_ and SG_ sections.
+   * Represents a CAN message from the BO_ section. Its SG_ signals occupy the
+   * contiguous ID range [first_signal, first_signal + signal_count) of
+   * signal_layouts and signal_infos.
+   *
+   * frame_format and bit_rate_switch come from the VFrameFormat and CANFD_BRS
+   * attributes, resolved once the whole file has been parsed.
    */
   struct MessageDef {
     int id = 0;                  ///< Message ID
     std::string name;            ///< Message name
-    int size = 0;                ///< Message size in bytes
+    int size = 0;                ///< Payload size in bytes: 0..8, or up to 64 for CAN FD
     std::string transmitter;     ///< Transmitting node
-    std::vector<Signal> signals; ///< Signals contained in the message
+    std::uint32_t first_signal = 0;  ///< ID of the first signal of this message
+    std::uint32_t signal_count = 0;  ///< Number of signals in this message
+    FrameFormat frame_format = FrameFormat::kStandardCan;  ///< Classic CAN or CAN FD
+    bool bit_rate_switch = false;  ///< CAN FD data phase at the higher bit rate (BRS)
+
+    [[nodiscard]] bool is_fd() const noexcept {
+      return frame_format == FrameFormat::kStandardCanFd || frame_format == FrameFormat::kExtendedCanFd;
+    }
 
     MessageDef() noexcept = default;
     ~MessageDef() noexcept = default;
+    MessageDef(const MessageDef&) = default;
+    MessageDef& operator=(const MessageDef&) = default;
+    MessageDef(MessageDef&&) = default;
+    MessageDef& operator=(MessageDef&&) = default;
   };
   
   /**
    * @brief Map of message IDs to detailed message definitions.
    *
-   * Contains all BO_ message definitions with their SG_ signals.
+   * Contains all BO_ message definitions with their SG_ signals. If an ID is
+   * defined more than once, the first definition is kept and later ones are
+   * ignored.
    */
   std::map<int, MessageDef> messages_detailed;
   
+  /**
+   * @brief Decode-critical signal data, indexed by signal ID.
+   *
+   * Signals of one message are stored contiguously; see MessageDef::first_signal.
+   */
+  std::vector<SignalLayout> signal_layouts;
+
+  /**
+   * @brief Names, units and receivers of all signals, indexed by signal ID.
+   *
+   * Parallel to signal_layouts.
+   */
+  std::vector<SignalInfo> signal_infos;
+
   /**
    * @brief Map of message IDs to message names.
    *
@@ -139,6 +178,10 @@ struct DbcFile {
 
     EnvVar() noexcept = default;
     ~EnvVar() noexcept = default;
+    EnvVar(const EnvVar&) = default;
+    EnvVar& operator=(const EnvVar&) = default;
+    EnvVar(EnvVar&&) = default;
+    EnvVar& operator=(EnvVar&&) = default;
   };
   
   /**
@@ -158,6 +201,10 @@ struct DbcFile {
 
     EnvVarData() noexcept = default;
     ~EnvVarData() noexcept = default;
+    EnvVarData(const EnvVarData&) = default;
+    EnvVarData& operator=(const EnvVarData&) = default;
+    EnvVarData(EnvVarData&&) = default;
+    EnvVarData& operator=(EnvVarData&&) = default;
   };
   
   /**
@@ -181,6 +228,10 @@ struct DbcFile {
 
     CommentDef() noexcept = default;
     ~CommentDef() noexcept = default;
+    CommentDef(const CommentDef&) = default;
+    CommentDef& operator=(const CommentDef&) = default;
+    CommentDef(CommentDef&&) = default;
+    CommentDef& operator=(CommentDef&&) = default;
   };
   
   /**
@@ -205,6 +256,10 @@ struct DbcFile {
 
     AttributeDef() noexcept = default;
     ~AttributeDef() noexcept = default;
+    AttributeDef(const AttributeDef&) = default;
+    AttributeDef& operator=(const AttributeDef&) = default;
+    AttributeDef(AttributeDef&&) = default;
+    AttributeDef& operator=(AttributeDef&&) = default;
   };
   
   /**
@@ -236,6 +291,10 @@ struct DbcFile {
 
     AttributeValue() noexcept = default;
     ~AttributeValue() noexcept = default;
+    AttributeValue(const AttributeValue&) = default;
+    AttributeValue& operator=(const AttributeValue&) = default;
+    AttributeValue(AttributeValue&&) = default;
+    AttributeValue& operator=(AttributeValue&&) = default;
   };
   
   /**
@@ -268,6 +327,10 @@ struct DbcFile {
 
     ValueDescription() noexcept = default;
     ~ValueDescription() noexcept = default;
+    ValueDescription(const ValueDescription&) = default;
+    ValueDescription& operator=(const ValueDescription&) = default;
+    ValueDescription(ValueDescription&&) = default;
+    ValueDescription& operator=(ValueDescription&&) = default;
   };
   
   /**
@@ -290,6 +353,10 @@ struct DbcFile {
 
     MultiplexedSignal() noexcept = default;
     ~MultiplexedSignal() noexcept = default;
+    MultiplexedSignal(const MultiplexedSignal&) = default;
+    MultiplexedSignal& operator=(const MultiplexedSignal&) = default;
+    MultiplexedSignal(MultiplexedSignal&&) = default;
+    MultiplexedSignal& operator=(MultiplexedSignal&&) = default;
   };
   
   /**
@@ -312,6 +379,10 @@ struct DbcFile {
 
     SignalGroupDef() noexcept = default;
     ~SignalGroupDef() noexcept = default;
+    SignalGroupDef(const SignalGroupDef&) = default;
+    SignalGroupDef& operator=(const SignalGroupDef&) = default;
+    SignalGroupDef(SignalGroupDef&&) = default;
+    SignalGroupDef& operator=(SignalGroupDef&&) = default;
   };
   
   /**
@@ -333,6 +404,10 @@ struct DbcFile {
 
     SignalValueType() noexcept = default;
     ~SignalValueType() noexcept = default;
+    SignalValueType(const SignalValueType&) = default;
+    SignalValueType& operator=(const SignalValueType&) = default;
+    SignalValueType(SignalValueType&&) = default;
+    SignalValueType& operator=(SignalValueType&&) = default;
   };
   
   /**
@@ -342,6 +417,26 @@ struct DbcFile {
    */
   std::vector<SignalValueType> signal_value_types;
 
+  /**
+   * @brief Returns the layouts of a message's signals.
+   *
+   * @param message A message of this file
+   * @return const SignalLayout* Pointer to message.signal_count contiguous layouts
+   */
+  [[nodiscard]] const SignalLayout* SignalLayoutsOf(const MessageDef& message) const noexcept {
+    return signal_layouts.data() + message.first_signal;
+  }
+
+  /**
+   * @brief Looks up a signal by message ID and name.
+   *
+   * @param message_id ID of the message carrying the signal
+   * @param signal_name Name of the signal
+   * @return std::optional<std::uint32_t> The signal ID, or std::nullopt if not found
+   */
+  [[nodiscard]] std::optional<std::uint32_t> FindSignal(int message_id,
+                                                        std::string_view signal_name) const noexcept;
+
   /**
    * @brief Default constructor.
    */
@@ -351,6 +446,14 @@ struct DbcFile {
    * @brief Default destructor.
    */
   ~DbcFile() noexcept = default;
+  
+  /**
+   * @brief DbcFile is copyable, but the parser only ever moves it.
+   */
+  DbcFile(const DbcFile&) = default;
+  DbcFile& operator=(const DbcFile&) = default;
+  DbcFile(DbcFile&&) = default;
+  DbcFile& operator=(DbcFile&&) = default;
 };
 
 /**
@@ -360,12 +463,36 @@ struct DbcFile {
  * a DbcFile object that represents all the data contained in the file.
  * It orchestrates the parsing of different sections using specialized parsers.
  */
+/**
+ * @brief Hard limits on the input DbcFileParser::Parse accepts.
+ *
+ * Parsing takes time and memory linear in the input size, and every grammar
+ * rule stops at the end of its line, so a malformed line cannot make the
+ * parser rescan the rest of the file. The limits additionally bound the work
+ * for untrusted files: input over a limit fails the parse as soon as it is
+ * seen, before any section parser copies it.
+ */
+struct ParseLimits {
+  /// Size of the whole input
+  std::size_t max_input_bytes = std::size_t{1} << 30;
+  /// Size of one statement including its continuation lines, or of one
+  /// unrecognized line
+  std::size_t max_statement_bytes = std::size_t{4} << 20;
+};
+
 class DbcFileParser {
  public:
   /**
    * @brief Default constructor.
    */
   DbcFileParser() noexcept = default;
+
+  /**
+   * @brief Constructs a parser that enforces the given limits.
+   *
+   * @param limits Input and statement size limits
+   */
+  explicit DbcFileParser(const ParseLimits& limits) noexcept : limits_(limits) {}
   
   /**
    * @brief Default destructor.
@@ -385,10 +512,19 @@ class DbcFileParser {
    * The parser validates the syntax and extracts all the information from the different
    * sections of the DBC file.
    *
+   * If stats is given, per-statement counts, sizes, timings and failures are
+   * added to it; see ParseStats. Passing nullptr disables all measurements.
+   *
+   * Input larger than the ParseLimits of this parser is rejected.
+   *
    * @param input String view containing the DBC file content to parse
+   * @param stats Optional profile to accumulate into
    * @return std::optional<DbcFile> A DbcFile object if parsing succeeds, std::nullopt otherwise
    */
-  [[nodiscard]] std::optional<DbcFile> Parse(std::string_view input);
+  [[nodiscard]] std::optional<DbcFile> Parse(std::string_view input, ParseStats* stats = nullptr);
+
+ private:
+  ParseLimits limits_;
 };
 
 }  // namespace parser
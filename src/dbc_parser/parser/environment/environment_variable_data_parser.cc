@@ -3,6 +3,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 
 #include "tao/pegtl.hpp"
 #include "tao/pegtl/contrib/parse_tree.hpp"
@@ -101,8 +102,8 @@ std::optional<EnvironmentVariableData> EnvironmentVariableDataParser::Parse(std:
     
     // Create and return EnvironmentVariableData object if parsing succeeded
     EnvironmentVariableData env_var_data;
-    env_var_data.name = state.name;
-    env_var_data.data = input.data(); // Store the full input as data
+    env_var_data.name = std::move(state.name);
+    env_var_data.data = std::string(input);  // Store the full input as data
     
     return env_var_data;
   } catch (const pegtl::parse_error&) {
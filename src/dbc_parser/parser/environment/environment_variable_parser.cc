@@ -1,9 +1,9 @@
 #include "dbc_parser/parser/environment/environment_variable_parser.h"
 
 #include <optional>
-#include <sstream>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include "dbc_parser/core/string_utils.h"
@@ -137,28 +137,23 @@ struct environment_variable_state {
 
 // Helper function to trim whitespace and process node list
 std::string ProcessNodeList(const std::string& input) {
-  std::vector<std::string> nodes;
-  std::istringstream iss(input);
-  std::string node;
+  std::string result;
+  result.reserve(input.size());
   
-  while (std::getline(iss, node, ',')) {
+  for (std::string_view node : core::StringUtils::SplitLazy(input, ',')) {
     // Trim leading/trailing whitespace
-    node = core::StringUtils::Trim(node);
-    if (!node.empty()) {
-      nodes.push_back(node);
+    node = core::StringUtils::TrimView(node);
+    if (node.empty()) {
+      continue;
     }
-  }
-  
-  // Combine nodes with commas (no spaces)
-  std::ostringstream oss;
-  for (size_t i = 0; i < nodes.size(); ++i) {
-    if (i > 0) {
-      oss << ",";
+    // Combine nodes with commas (no spaces)
+    if (!result.empty()) {
+      result.push_back(',');
     }
-    oss << nodes[i];
+    result.append(node);
   }
   
-  return oss.str();
+  return result;
 }
 
 // PEGTL actions
@@ -305,14 +300,14 @@ std::optional<EnvironmentVariable> EnvironmentVariableParser::Parse(std::string_
     
     // Create and return EnvironmentVariable object if parsing succeeded
     EnvironmentVariable env_var;
-    env_var.name = state.name;
+    env_var.name = std::move(state.name);
     env_var.var_type = state.var_type;
     env_var.minimum = state.minimum;
     env_var.maximum = state.maximum;
-    env_var.unit = state.unit;
+    env_var.unit = std::move(state.unit);
     env_var.initial_value = state.initial_value;
     env_var.ev_id = state.ev_id;
-    env_var.access_type = state.access_type;
+    env_var.access_type = std::move(state.access_type);
     
     // Process access_nodes to handle whitespace correctly
     if (state.access_nodes_set && !state.access_nodes.empty()) {
@@ -4,6 +4,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include "tao/pegtl.hpp"
@@ -75,9 +76,11 @@ struct message_header : pegtl::seq<
 // Multiplexor indicator 'M' or multiplexed indicator 'mX'
 struct multiplexor : pegtl::string<'M'> {};
 
+// A trailing 'M' (mXM) marks a nested multiplexor in extended multiplexing
 struct multiplexed : pegtl::seq<
                        pegtl::string<'m'>,
-                       pegtl::plus<pegtl::digit>
+                       pegtl::plus<pegtl::digit>,
+                       pegtl::opt<pegtl::one<'M'>>
                      > {};
 
 struct multiplex_indicator : pegtl::sor<
@@ -166,11 +169,15 @@ struct bo_rule : pegtl::seq<
 } // namespace grammar
 
 // Data structure to collect parsing results
+// All per-parse bookkeeping lives here (never in function-local statics) so that
+// concurrent MessageParser::Parse calls on different inputs cannot interfere.
 struct message_state {
   Message message;
   Signal current_signal;
   bool in_signal = false;
   std::string current_multiplex;
+  int header_int_field = 0;  ///< Next integer in the BO_ header: 0 = ID, 1 = DLC
+  int signal_int_field = 0;  ///< Next integer inside SG_: 0 = start bit, 1 = length
 };
 
 // PEGTL actions
@@ -181,26 +188,37 @@ struct action : pegtl::nothing<Rule> {};
 template<>
 struct action<grammar::integer> {
   template<typename ActionInput>
-  static void apply(const ActionInput& in, message_state& state) noexcept {
+  static void apply(const ActionInput& in, message_state& state) {
+    // An ID that does not convert rejects the message rather than storing it
+    // as message 0
+    if (!state.in_signal && state.header_int_field == 0) {
+      const std::optional<int> id = ParserBase::ParseMessageId(in.string_view());
+      if (!id) {
+        throw pegtl::parse_error("invalid message ID", in);
+      }
+      state.message.id = *id;
+      state.header_int_field = 1;
+      return;
+    }
+
     // Determine where to store the integer value based on context
     try {
       if (!state.in_signal) {
-        // We're in the message header, potential targets: ID, DLC
-        if (state.message.id == 0) {
-          state.message.id = std::stoi(in.string());
-        } else if (state.message.dlc == 0) {
+        // We're in the message header after the ID; the next integer is the
+        // DLC. A slot counter is used rather than testing for 0, since 0 is a
+        // valid ID.
+        if (state.header_int_field == 1) {
           state.message.dlc = std::stoi(in.string());
+          state.header_int_field = 2;
         }
       } else {
-        // We're in a signal definition, potential targets: start_bit, length, etc.
-        static int signal_int_field = 0;
-        
-        if (signal_int_field == 0) { // Start bit
+        // We're in a signal definition, potential targets: start_bit, length
+        if (state.signal_int_field == 0) { // Start bit
           state.current_signal.start_bit = std::stoi(in.string());
-          signal_int_field = 1;
-        } else if (signal_int_field == 1) { // Length
+          state.signal_int_field = 1;
+        } else if (state.signal_int_field == 1) { // Length
           state.current_signal.length = std::stoi(in.string());
-          signal_int_field = 0;
+          state.signal_int_field = 0;
         }
       }
     } catch (const std::exception&) {
@@ -241,6 +259,7 @@ struct action<grammar::signal_name> {
   template<typename ActionInput>
   static void apply(const ActionInput& in, message_state& state) noexcept {
     state.in_signal = true;
+    state.signal_int_field = 0;
     state.current_signal = Signal();
     state.current_signal.name = in.string();
   }
@@ -261,7 +280,9 @@ template<>
 struct action<grammar::multiplexed> {
   template<typename ActionInput>
   static void apply(const ActionInput& in, message_state& state) noexcept {
-    state.current_signal.multiplex_type = MultiplexType::kMultiplexed;
+    state.current_signal.multiplex_type = in.string_view().back() == 'M' ?
+                                          MultiplexType::kMultiplexedMultiplexor :
+                                          MultiplexType::kMultiplexed;
     try {
       std::string value = in.string().substr(1); // Skip 'm'
       state.current_signal.multiplex_value = std::stoi(value);
@@ -347,8 +368,8 @@ template<>
 struct action<common_grammar::quoted_string> {
   template<typename ActionInput>
   static void apply(const ActionInput& in, message_state& state) noexcept {
-    // Use ParserBase method to unescape string
-    state.current_signal.unit = ParserBase::UnescapeString(in.string());
+    // Use ParserBase method to unescape string straight from the input view
+    state.current_signal.unit = ParserBase::UnescapeQuoted(in.string_view()).str();
   }
 };
 
@@ -358,10 +379,11 @@ struct action<grammar::signal_def> {
   template<typename ActionInput>
   static void apply(const ActionInput& in, message_state& state) noexcept {
     // Add the completed signal to the message
-    state.message.signals.push_back(state.current_signal);
+    state.message.signals.push_back(std::move(state.current_signal));
     
     // Reset signal state
     state.in_signal = false;
+    state.signal_int_field = 0;
     state.current_signal = Signal();
     state.current_multiplex.clear();
   }
@@ -382,7 +404,7 @@ std::optional<Message> MessageParser::Parse(std::string_view input) {
   try {
     // Parse input using our grammar and actions
     if (pegtl::parse<grammar::bo_rule, action>(in, state)) {
-      return state.message;
+      return std::move(state.message);
     }
   } catch (const pegtl::parse_error&) {
     // Parse error - return nullopt
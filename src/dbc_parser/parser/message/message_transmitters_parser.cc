@@ -4,6 +4,7 @@
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include "tao/pegtl.hpp"
@@ -78,7 +79,11 @@ template<>
 struct action<grammar::integer> {
   template<typename ActionInput>
   static void apply(const ActionInput& in, transmitters_state& state) {
-    state.transmitters.message_id = std::stoi(in.string());
+    const std::optional<int> id = ParserBase::ParseMessageId(in.string_view());
+    if (!id) {
+      throw pegtl::parse_error("invalid message ID", in);
+    }
+    state.transmitters.message_id = *id;
   }
 };
 
@@ -106,7 +111,7 @@ std::optional<MessageTransmitters> MessageTransmittersParser::Parse(std::string_
   try {
     // Parse input using our grammar and actions
     if (pegtl::parse<grammar::bo_tx_bu_rule, action>(in, state)) {
-      return state.transmitters;
+      return std::move(state.transmitters);
     }
   } catch (const pegtl::parse_error&) {
     // Parse error - return nullopt
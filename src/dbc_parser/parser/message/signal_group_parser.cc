@@ -72,11 +72,8 @@ struct action<grammar::message_id> {
   template<typename ActionInput>
   static void apply(const ActionInput& in, signal_group_state& state) {
     if (!state.message_id.has_value()) {
-      try {
-        state.message_id = std::stoi(in.string());
-      } catch (const std::exception& e) {
-        // Error in conversion, leave as nullopt.
-      }
+      // Leaves nullopt if the conversion fails.
+      state.message_id = ParserBase::ParseMessageId(in.string_view());
     }
   }
 };
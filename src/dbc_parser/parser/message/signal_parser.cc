@@ -4,6 +4,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include <tao/pegtl.hpp>
@@ -31,7 +32,9 @@ struct signal_name : pegtl::identifier {};
 
 // Multiplexer options
 struct multiplexer : pegtl::one<'M'> {};
-struct multiplexed_by : pegtl::seq<pegtl::one<'m'>, pegtl::plus<pegtl::digit>> {};
+// A trailing 'M' (mXM) marks a nested multiplexor in extended multiplexing
+struct multiplexed_by : pegtl::seq<pegtl::one<'m'>, pegtl::plus<pegtl::digit>,
+                                   pegtl::opt<pegtl::one<'M'>>> {};
 struct multiplexer_info : pegtl::sor<multiplexer, multiplexed_by, pegtl::success> {};
 
 // Signal bit position and size
@@ -156,7 +159,8 @@ struct action<grammar::multiplexed_by> {
   template<typename ActionInput>
   static void apply(const ActionInput& in, signal_state& state) {
     std::string value = in.string();
-    // Skip the 'm' prefix
+    state.is_multiplexer = value.back() == 'M';
+    // Skip the 'm' prefix; std::stoi stops at a trailing 'M'
     try {
       state.multiplex_value = std::stoi(value.substr(1));
     } catch (const std::exception& e) {
@@ -313,29 +317,27 @@ std::optional<Signal> SignalParser::Parse(std::string_view input) {
   }
 
   Signal result;
-  result.name = *state.name;
+  result.name = std::move(*state.name);
   result.start_bit = *state.start_bit;
-  result.signal_size = *state.signal_size;
-  result.length = *state.signal_size;  // Set both length and signal_size
-  result.is_little_endian = *state.is_little_endian;
-  result.byte_order = *state.is_little_endian ? 1 : 0;  // Set byte_order based on little endian flag
-  result.is_signed = *state.is_signed;
-  result.sign = *state.is_signed ? SignType::kSigned : SignType::kUnsigned;  // Set the enum value
+  result.length = *state.signal_size;
+  result.byte_order = *state.is_little_endian ? 1 : 0;
+  result.sign = *state.is_signed ? SignType::kSigned : SignType::kUnsigned;
   result.factor = *state.factor;
   result.offset = *state.offset;
   result.minimum = *state.minimum;
   result.maximum = *state.maximum;
-  result.unit = *state.unit;
+  result.unit = std::move(*state.unit);
   result.receivers = std::move(state.receivers);
-  result.is_multiplexer = state.is_multiplexer;
   
-  // Update the multiplex value fields
-  if (state.is_multiplexer) {
+  // Update the multiplex fields
+  if (state.is_multiplexer && state.multiplex_value.has_value()) {
+    result.multiplex_type = MultiplexType::kMultiplexedMultiplexor;
+    result.multiplex_value = state.multiplex_value;
+  } else if (state.is_multiplexer) {
     result.multiplex_type = MultiplexType::kMultiplexor;
   } else if (state.multiplex_value.has_value()) {
     result.multiplex_type = MultiplexType::kMultiplexed;
     result.multiplex_value = state.multiplex_value;
-    result.multiplex_value_int = *state.multiplex_value;
   } else {
     result.multiplex_type = MultiplexType::kNone;
   }
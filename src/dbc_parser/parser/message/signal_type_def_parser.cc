@@ -4,6 +4,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 
 #include "tao/pegtl.hpp"
 #include "tao/pegtl/contrib/parse_tree.hpp"
@@ -243,7 +244,7 @@ std::optional<SignalTypeDef> SignalTypeDefParser::Parse(std::string_view input)
     
     // Create and return SignalTypeDef object if parsing succeeded
     SignalTypeDef sig_type_def;
-    sig_type_def.name = state.name;
+    sig_type_def.name = std::move(state.name);
     sig_type_def.size = state.size;
     sig_type_def.byte_order = state.byte_order;
     sig_type_def.value_type = state.value_type;
@@ -251,9 +252,9 @@ std::optional<SignalTypeDef> SignalTypeDefParser::Parse(std::string_view input)
     sig_type_def.offset = state.offset;
     sig_type_def.minimum = state.minimum;
     sig_type_def.maximum = state.maximum;
-    sig_type_def.unit = state.unit;
+    sig_type_def.unit = std::move(state.unit);
     sig_type_def.default_value = state.default_value;
-    sig_type_def.value_table = state.value_table;
+    sig_type_def.value_table = std::move(state.value_table);
     
     return sig_type_def;
   } catch (const pegtl::parse_error&) {
@@ -3,6 +3,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 
 #include "tao/pegtl.hpp"
 #include "tao/pegtl/contrib/parse_tree.hpp"
@@ -67,7 +68,11 @@ struct signal_value_type_action<grammar::message_id> {
   template<typename ActionInput>
   static void apply(const ActionInput& in, signal_value_type_state& state) {
     if (!state.message_id_set) {
-      state.message_id = std::stoi(in.string());
+      const std::optional<int> id = ParserBase::ParseMessageId(in.string_view());
+      if (!id) {
+        throw pegtl::parse_error("invalid message ID", in);
+      }
+      state.message_id = *id;
       state.message_id_set = true;
     }
   }
@@ -128,7 +133,7 @@ std::optional<SignalValueType> SignalValueTypeParser::Parse(std::string_view inp
     // Create and return SignalValueType object if parsing succeeded
     SignalValueType signal_value_type;
     signal_value_type.message_id = state.message_id;
-    signal_value_type.signal_name = state.signal_name;
+    signal_value_type.signal_name = std::move(state.signal_name);
     signal_value_type.type = state.type;
     
     return signal_value_type;
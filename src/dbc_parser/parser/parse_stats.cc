@@ -0,0 +1,106 @@
+#include "dbc_parser/parser/parse_stats.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace dbc_parser {
+namespace parser {
+
+void ParseStats::Record(StatementKind kind, std::uint64_t bytes, std::uint64_t offset,
+                        std::uint64_t line, std::uint64_t nanoseconds, std::uint64_t allocations,
+                        bool failed) {
+  StatementStats& stats = statements[static_cast<std::size_t>(kind)];
+  ++stats.count;
+  stats.failures += failed ? 1 : 0;
+  stats.bytes += bytes;
+  stats.nanoseconds += nanoseconds;
+  stats.allocations += allocations;
+  stats.largest = std::max(stats.largest, bytes);
+
+  // Keep largest sorted by size, biggest first, and at most largest_limit long
+  if (largest_limit == 0 || (largest.size() == largest_limit && bytes <= largest.back().bytes)) {
+    return;
+  }
+  auto pos = std::upper_bound(largest.begin(), largest.end(), bytes,
+                              [](std::uint64_t size, const LargestStatement& entry) {
+                                return size > entry.bytes;
+                              });
+  largest.insert(pos, LargestStatement{kind, bytes, offset, line});
+  if (largest.size() > largest_limit) {
+    largest.pop_back();
+  }
+}
+
+void ParseStats::Reset() noexcept {
+  statements = {};
+  largest.clear();
+  input_bytes = 0;
+  total_nanoseconds = 0;
+}
+
+std::string ParseStats::ToString() const {
+  std::string out;
+  char buffer[256];
+
+  std::snprintf(buffer, sizeof(buffer), "total bytes=%llu ns=%llu unknown_lines=%llu\n",
+                static_cast<unsigned long long>(input_bytes),
+                static_cast<unsigned long long>(total_nanoseconds),
+                static_cast<unsigned long long>(UnknownLines()));
+  out += buffer;
+
+  for (std::size_t i = 0; i < kStatementKindCount; ++i) {
+    const StatementStats& stats = statements[i];
+    if (stats.count == 0) {
+      continue;
+    }
+    std::snprintf(buffer, sizeof(buffer),
+                  "statement kind=%.*s count=%llu failures=%llu bytes=%llu ns=%llu "
+                  "allocations=%llu largest=%llu\n",
+                  static_cast<int>(KeywordOf(static_cast<StatementKind>(i)).size()),
+                  KeywordOf(static_cast<StatementKind>(i)).data(),
+                  static_cast<unsigned long long>(stats.count),
+                  static_cast<unsigned long long>(stats.failures),
+                  static_cast<unsigned long long>(stats.bytes),
+                  static_cast<unsigned long long>(stats.nanoseconds),
+                  static_cast<unsigned long long>(stats.allocations),
+                  static_cast<unsigned long long>(stats.largest));
+    out += buffer;
+  }
+
+  for (const LargestStatement& entry : largest) {
+    std::snprintf(buffer, sizeof(buffer), "largest kind=%.*s bytes=%llu offset=%llu line=%llu\n",
+                  static_cast<int>(KeywordOf(entry.kind).size()), KeywordOf(entry.kind).data(),
+                  static_cast<unsigned long long>(entry.bytes),
+                  static_cast<unsigned long long>(entry.offset),
+                  static_cast<unsigned long long>(entry.line));
+    out += buffer;
+  }
+  return out;
+}
+
+std::string_view ParseStats::KeywordOf(StatementKind kind) noexcept {
+  switch (kind) {
+    case StatementKind::kVersion: return "VERSION";
+    case StatementKind::kNewSymbols: return "NS_";
+    case StatementKind::kBitTiming: return "BS_";
+    case StatementKind::kNodes: return "BU_";
+    case StatementKind::kValueTable: return "VAL_TABLE_";
+    case StatementKind::kMessage: return "BO_";
+    case StatementKind::kMessageTransmitters: return "BO_TX_BU_";
+    case StatementKind::kEnvironmentVariable: return "EV_";
+    case StatementKind::kEnvironmentVariableData: return "ENVVAR_DATA_";
+    case StatementKind::kComment: return "CM_";
+    case StatementKind::kAttributeDefinition: return "BA_DEF_";
+    case StatementKind::kAttributeDefault: return "BA_DEF_DEF_";
+    case StatementKind::kAttributeValue: return "BA_";
+    case StatementKind::kValueDescription: return "VAL_";
+    case StatementKind::kSignalValueType: return "SIG_VALTYPE_";
+    case StatementKind::kSignalGroup: return "SIG_GROUP_";
+    case StatementKind::kSignalMultiplexValues: return "SG_MUL_VAL_";
+    case StatementKind::kUnknown: return "unknown";
+  }
+  return "unknown";
+}
+
+}  // namespace parser
+}  // namespace dbc_parser
@@ -0,0 +1,143 @@
+#ifndef DBC_PARSER_PARSER_PARSE_STATS_H_
+#define DBC_PARSER_PARSER_PARSE_STATS_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace dbc_parser {
+namespace parser {
+
+/**
+ * @brief Statement types distinguished by ParseStats.
+ *
+ * A BO_ statement includes its SG_ lines. kUnknown covers non-blank lines that
+ * match no statement keyword.
+ */
+enum class StatementKind : std::uint8_t {
+  kVersion,              ///< VERSION
+  kNewSymbols,           ///< NS_
+  kBitTiming,            ///< BS_
+  kNodes,                ///< BU_
+  kValueTable,           ///< VAL_TABLE_
+  kMessage,              ///< BO_ with its SG_ lines
+  kMessageTransmitters,  ///< BO_TX_BU_
+  kEnvironmentVariable,  ///< EV_
+  kEnvironmentVariableData,  ///< ENVVAR_DATA_
+  kComment,              ///< CM_
+  kAttributeDefinition,  ///< BA_DEF_
+  kAttributeDefault,     ///< BA_DEF_DEF_
+  kAttributeValue,       ///< BA_
+  kValueDescription,     ///< VAL_
+  kSignalValueType,      ///< SIG_VALTYPE_
+  kSignalGroup,          ///< SIG_GROUP_
+  kSignalMultiplexValues,  ///< SG_MUL_VAL_ (counted, not parsed)
+  kUnknown,              ///< Lines without a recognized keyword
+};
+
+/// Number of StatementKind values.
+inline constexpr std::size_t kStatementKindCount = static_cast<std::size_t>(StatementKind::kUnknown) + 1;
+
+/**
+ * @brief Totals for one statement type.
+ */
+struct StatementStats {
+  std::uint64_t count = 0;        ///< Statements seen
+  std::uint64_t failures = 0;     ///< Statements whose section parser rejected them
+  std::uint64_t bytes = 0;        ///< Input bytes covered by these statements
+  std::uint64_t nanoseconds = 0;  ///< Time spent in the section parser and model update
+  std::uint64_t allocations = 0;  ///< Heap allocations, if ParseStats::allocation_counter is set
+  std::uint64_t largest = 0;      ///< Size in bytes of the largest statement
+};
+
+/**
+ * @brief One of the largest statements of a file.
+ */
+struct LargestStatement {
+  StatementKind kind = StatementKind::kUnknown;  ///< Statement type
+  std::uint64_t bytes = 0;   ///< Size of the statement, including continuation lines
+  std::uint64_t offset = 0;  ///< Byte offset of the statement in the input
+  std::uint64_t line = 0;    ///< 1-based line number of the statement
+};
+
+/**
+ * @brief Per-statement-type profile of one DbcFileParser::Parse call.
+ *
+ * Pass a ParseStats to DbcFileParser::Parse to find out where the time of a
+ * slow file goes, e.g. CM_ versus BO_/SG_ versus BA_. Without one, the parser
+ * skips all measurements: each statement costs a single null-pointer test.
+ *
+ * The library does not track heap usage itself. Set allocation_counter to a
+ * function returning a monotonic allocation count (for example from a
+ * replaced operator new) to fill StatementStats::allocations.
+ *
+ * A ParseStats accumulates over several Parse calls until Reset().
+ */
+struct ParseStats {
+  /// Returns the process-wide number of heap allocations so far.
+  using AllocationCounter = std::uint64_t (*)() noexcept;
+
+  /// Default number of entries kept in largest.
+  static constexpr std::size_t kDefaultLargestLimit = 10;
+
+  std::array<StatementStats, kStatementKindCount> statements{};  ///< Indexed by StatementKind
+  std::vector<LargestStatement> largest;  ///< Largest statements, biggest first
+  std::size_t largest_limit = kDefaultLargestLimit;  ///< Capacity of largest
+  std::uint64_t input_bytes = 0;          ///< Bytes of input parsed
+  std::uint64_t total_nanoseconds = 0;    ///< Wall time of the Parse calls
+  AllocationCounter allocation_counter = nullptr;  ///< Optional heap allocation source
+
+  /**
+   * @brief Returns the totals of one statement type.
+   */
+  [[nodiscard]] const StatementStats& operator[](StatementKind kind) const noexcept {
+    return statements[static_cast<std::size_t>(kind)];
+  }
+
+  /**
+   * @brief Number of lines that matched no statement keyword.
+   */
+  [[nodiscard]] std::uint64_t UnknownLines() const noexcept {
+    return (*this)[StatementKind::kUnknown].count;
+  }
+
+  /**
+   * @brief Adds one statement to the totals.
+   *
+   * @param kind Statement type
+   * @param bytes Size of the statement
+   * @param offset Byte offset of the statement in the input
+   * @param line 1-based line number of the statement
+   * @param nanoseconds Time spent on the statement
+   * @param allocations Heap allocations made for the statement
+   * @param failed Whether the section parser rejected the statement
+   */
+  void Record(StatementKind kind, std::uint64_t bytes, std::uint64_t offset, std::uint64_t line,
+              std::uint64_t nanoseconds, std::uint64_t allocations, bool failed);
+
+  /**
+   * @brief Clears all totals, keeping largest_limit and allocation_counter.
+   */
+  void Reset() noexcept;
+
+  /**
+   * @brief Formats the totals as text, one "key=value" record per line.
+   *
+   * Only statement types that occurred are listed. The format is stable so
+   * that it can be scraped from production logs.
+   */
+  [[nodiscard]] std::string ToString() const;
+
+  /**
+   * @brief Returns the DBC keyword of a statement type, e.g. "CM_".
+   */
+  [[nodiscard]] static std::string_view KeywordOf(StatementKind kind) noexcept;
+};
+
+}  // namespace parser
+}  // namespace dbc_parser
+
+#endif  // DBC_PARSER_PARSER_PARSE_STATS_H_
@@ -10,6 +10,7 @@
 
 #include "tao/pegtl.hpp"
 #include "dbc_parser/common/common_grammar.h"
+#include "dbc_parser/core/string_utils.h"
 
 namespace dbc_parser {
 namespace parser {
@@ -97,17 +98,17 @@ struct action : pegtl::nothing<Rule> {};
 template<>
 struct action<grammar::message_id> {
   template<typename ActionInput>
-  static void apply(const ActionInput& in, value_description_state& state) noexcept {
+  static void apply(const ActionInput& in, value_description_state& state) {
     state.parsing_signal = true;
     state.result.type = ValueDescriptionType::SIGNAL;
     
-    // Store message ID in state
-    try {
-      state.temp_message_id = std::stoi(in.string());
-    } catch (const std::exception&) {
-      // Default to 0 if conversion fails
-      state.temp_message_id = 0;
+    // Store message ID in state; an ID that does not convert rejects the
+    // statement rather than attaching it to message 0
+    const std::optional<int> id = ParserBase::ParseMessageId(in.string_view());
+    if (!id) {
+      throw pegtl::parse_error("invalid message ID", in);
     }
+    state.temp_message_id = *id;
   }
 };
 
@@ -135,17 +136,16 @@ struct action<grammar::quoted_string> {
   template<typename ActionInput>
   static void apply(const ActionInput& in, value_description_state& state) noexcept {
     if (state.in_value_pair) {
-      // This is a quoted string in a value-description pair
-      std::string quoted = in.string();
-      // Use ParserBase::UnescapeString to properly handle escaped quotes
-      state.result.value_descriptions[state.current_value] = ParserBase::UnescapeString(quoted);
+      // This is a quoted string in a value-description pair; unescaping straight
+      // from the input view leaves a single copy of the label
+      state.result.value_descriptions[state.current_value] =
+          core::StringUtils::ToUtf8(ParserBase::UnescapeQuoted(in.string_view()).str());
       state.in_value_pair = false;
     } else if (state.parsing_signal) {
       // This is a quoted signal name
       // Extract the content without quotes and store it
-      std::string quoted = in.string();
-      std::string name = ParserBase::UnescapeString(quoted);
-      state.result.identifier = std::make_pair(state.temp_message_id, name);
+      std::string name = ParserBase::UnescapeQuoted(in.string_view()).str();
+      state.result.identifier = std::make_pair(state.temp_message_id, std::move(name));
     }
   }
 };
@@ -188,7 +188,7 @@ std::optional<ValueDescription> ValueDescriptionParser::Parse(std::string_view i
     
     if (success && !state.result.value_descriptions.empty()) {
       // Parsing succeeded and we have at least one value description
-      return state.result;
+      return std::move(state.result);
     }
   } catch (const pegtl::parse_error& e) {
     // Parse error - return nullopt
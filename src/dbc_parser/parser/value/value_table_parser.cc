@@ -4,11 +4,13 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 
 #include "tao/pegtl.hpp"
 #include "tao/pegtl/contrib/analyze.hpp"
 
 #include "dbc_parser/common/common_grammar.h"
+#include "dbc_parser/core/string_utils.h"
 
 namespace dbc_parser {
 namespace parser {
@@ -104,7 +106,7 @@ struct action<common_grammar::quoted_string> {
   template<typename ActionInput>
   static void apply(const ActionInput& in, value_table_state& state) {
     // Extract string without quotes using ParserBase method
-    state.current_description = ParserBase::UnescapeString(in.string());
+    state.current_description = core::StringUtils::ToUtf8(ParserBase::UnescapeString(in.string()));
     
     // Add the current value-description pair to the map
     state.value_table.values[state.current_value] = state.current_description;
@@ -126,7 +128,7 @@ std::optional<ValueTable> ValueTableParser::Parse(std::string_view input) {
   try {
     // Parse input using our grammar and actions
     if (pegtl::parse<grammar::val_table_rule, action>(in, state)) {
-      return state.value_table;
+      return std::move(state.value_table);
     }
   } catch (const pegtl::parse_error&) {
     // Parse error - return nullopt
@@ -0,0 +1,584 @@
+#include "dbc_parser/rules/rule_compiler.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <utility>
+
+namespace dbc_parser {
+namespace rules {
+namespace {
+
+// by_name value of a signal name used in several messages
+constexpr std::uint32_t kAmbiguous = 0xFFFFFFFFu;
+
+bool Truth(double value) noexcept { return value < 0.0 || value > 0.0; }
+
+// Binary operators and comparisons; the fused signal comparisons map to the
+// plain ones
+double Apply(OpCode op, double a, double b) noexcept {
+  switch (op) {
+    case OpCode::kAdd:
+      return a + b;
+    case OpCode::kSubtract:
+      return a - b;
+    case OpCode::kMultiply:
+      return a * b;
+    case OpCode::kDivide:
+      return a / b;
+    case OpCode::kLess:
+    case OpCode::kSignalLess:
+      return a < b ? 1.0 : 0.0;
+    case OpCode::kLessEqual:
+    case OpCode::kSignalLessEqual:
+      return a <= b ? 1.0 : 0.0;
+    case OpCode::kGreater:
+    case OpCode::kSignalGreater:
+      return a > b ? 1.0 : 0.0;
+    case OpCode::kGreaterEqual:
+    case OpCode::kSignalGreaterEqual:
+      return a >= b ? 1.0 : 0.0;
+    case OpCode::kEqual:
+    case OpCode::kSignalEqual:
+      return a == b ? 1.0 : 0.0;
+    case OpCode::kNotEqual:
+    case OpCode::kSignalNotEqual:
+      // Not !(a == b), which NaN would make true
+      return a < b || a > b ? 1.0 : 0.0;
+    default:
+      return 0.0;
+  }
+}
+
+bool IsComparison(OpCode op) noexcept { return op >= OpCode::kLess && op <= OpCode::kNotEqual; }
+
+// The comparison with its operands swapped
+OpCode Mirror(OpCode op) noexcept {
+  switch (op) {
+    case OpCode::kLess:
+      return OpCode::kGreater;
+    case OpCode::kLessEqual:
+      return OpCode::kGreaterEqual;
+    case OpCode::kGreater:
+      return OpCode::kLess;
+    case OpCode::kGreaterEqual:
+      return OpCode::kLessEqual;
+    default:
+      return op;
+  }
+}
+
+OpCode Fused(OpCode comparison) noexcept {
+  return static_cast<OpCode>(static_cast<int>(comparison) - static_cast<int>(OpCode::kLess) +
+                             static_cast<int>(OpCode::kSignalLess));
+}
+
+// Syntax tree of a rule. && and || are kJumpIfFalse and kJumpIfTrue, the
+// instructions they compile to.
+struct Node {
+  enum Kind : std::uint8_t { kNumber, kSignal, kString, kUnary, kBinary };
+
+  Kind kind = kNumber;
+  OpCode op = OpCode::kConstant;
+  bool boolean = false;  ///< Yields 1.0 or 0.0
+  double value = 0.0;
+  std::uint32_t signal = 0;
+  std::string_view text;  ///< kString contents
+  std::size_t position = 0;
+  int left = -1;
+  int right = -1;
+};
+
+class Parser {
+ public:
+  Parser(std::string_view text, const parser::DbcFile& dbc_file,
+         const std::unordered_map<std::string, std::uint32_t>& by_name,
+         const std::unordered_map<std::string, std::uint32_t>& by_full_name,
+         const std::unordered_map<std::uint32_t, const parser::DbcFile::ValueDescription*>& descriptions)
+      : text_(text),
+        dbc_file_(dbc_file),
+        by_name_(by_name),
+        by_full_name_(by_full_name),
+        descriptions_(descriptions) {}
+
+  // Index of the root node, or -1 with error() set
+  int Parse() {
+    const int root = ParseOr();
+    SkipSpace();
+    if (root >= 0 && pos_ != text_.size()) {
+      return Fail(pos_, "unexpected '" + std::string(1, text_[pos_]) + "'");
+    }
+    return root >= 0 && RequireValue(root) ? root : -1;
+  }
+
+  [[nodiscard]] const std::vector<Node>& nodes() const noexcept { return nodes_; }
+  [[nodiscard]] const std::string& error() const noexcept { return error_; }
+
+ private:
+  int Fail(std::size_t position, std::string message) {
+    if (error_.empty()) {
+      error_ = "column " + std::to_string(position + 1) + ": " + std::move(message);
+    }
+    return -1;
+  }
+
+  void SkipSpace() {
+    while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+      ++pos_;
+    }
+  }
+
+  bool Accept(std::string_view token) {
+    SkipSpace();
+    if (text_.substr(pos_, token.size()) != token) {
+      return false;
+    }
+    pos_ += token.size();
+    return true;
+  }
+
+  // String literals only stand for enum values in comparisons
+  bool RequireValue(int node) {
+    if (nodes_[node].kind == Node::kString) {
+      Fail(nodes_[node].position, "'" + std::string(nodes_[node].text) + "' is not compared with a signal");
+      return false;
+    }
+    return true;
+  }
+
+  int Add(Node node) {
+    nodes_.push_back(node);
+    return static_cast<int>(nodes_.size() - 1);
+  }
+
+  int MakeUnary(OpCode op, int operand, std::size_t position) {
+    if (operand < 0 || !RequireValue(operand)) {
+      return -1;
+    }
+    Node node;
+    node.op = op;
+    node.position = position;
+    node.boolean = op == OpCode::kNot;
+    if (nodes_[operand].kind == Node::kNumber) {
+      const double value = nodes_[operand].value;
+      node.value = op == OpCode::kNot ? (Truth(value) ? 0.0 : 1.0) : -value;
+      return Add(node);
+    }
+    node.kind = Node::kUnary;
+    node.left = operand;
+    return Add(node);
+  }
+
+  int MakeBinary(OpCode op, int left, int right, std::size_t position) {
+    if (left < 0 || right < 0) {
+      return -1;
+    }
+    if (IsComparison(op) && !ResolveEnum(op, left, right)) {
+      return -1;
+    }
+    if (!RequireValue(left) || !RequireValue(right)) {
+      return -1;
+    }
+    Node node;
+    node.op = op;
+    node.position = position;
+    node.boolean = IsComparison(op) || op == OpCode::kJumpIfFalse || op == OpCode::kJumpIfTrue;
+    if (nodes_[left].kind == Node::kNumber && nodes_[right].kind == Node::kNumber) {
+      const double a = nodes_[left].value;
+      const double b = nodes_[right].value;
+      node.value = op == OpCode::kJumpIfFalse  ? (Truth(a) && Truth(b) ? 1.0 : 0.0)
+                   : op == OpCode::kJumpIfTrue ? (Truth(a) || Truth(b) ? 1.0 : 0.0)
+                                               : Apply(op, a, b);
+      return Add(node);
+    }
+    node.kind = Node::kBinary;
+    node.left = left;
+    node.right = right;
+    return Add(node);
+  }
+
+  // Replaces a string literal compared with a signal by the physical value
+  // of the signal's VAL_ entry of that text
+  bool ResolveEnum(OpCode op, int left, int right) {
+    const bool left_string = nodes_[left].kind == Node::kString;
+    if (!left_string && nodes_[right].kind != Node::kString) {
+      return true;
+    }
+    Node& literal = nodes_[left_string ? left : right];
+    const Node& other = nodes_[left_string ? right : left];
+    if (op != OpCode::kEqual && op != OpCode::kNotEqual) {
+      Fail(literal.position, "'" + std::string(literal.text) + "' is only compared with == or !=");
+      return false;
+    }
+    if (other.kind != Node::kSignal) {
+      Fail(literal.position, "'" + std::string(literal.text) + "' is not compared with a signal");
+      return false;
+    }
+    const std::string& name = dbc_file_.signal_infos[other.signal].name;
+    const auto description = descriptions_.find(other.signal);
+    if (description == descriptions_.end()) {
+      Fail(literal.position, "signal " + name + " has no VAL_ descriptions");
+      return false;
+    }
+    for (const auto& [raw, text] : description->second->values) {
+      if (text == literal.text) {
+        const parser::SignalLayout& layout = dbc_file_.signal_layouts[other.signal];
+        literal.kind = Node::kNumber;
+        literal.value = static_cast<double>(raw) * layout.factor + layout.offset;
+        return true;
+      }
+    }
+    Fail(literal.position, "signal " + name + " has no value '" + std::string(literal.text) + "'");
+    return false;
+  }
+
+  int ParseOr() {
+    int left = ParseAnd();
+    while (left >= 0) {
+      SkipSpace();
+      const std::size_t position = pos_;
+      if (!Accept("||")) {
+        break;
+      }
+      left = MakeBinary(OpCode::kJumpIfTrue, left, ParseAnd(), position);
+    }
+    return left;
+  }
+
+  int ParseAnd() {
+    int left = ParseComparison();
+    while (left >= 0) {
+      SkipSpace();
+      const std::size_t position = pos_;
+      if (!Accept("&&")) {
+        break;
+      }
+      left = MakeBinary(OpCode::kJumpIfFalse, left, ParseComparison(), position);
+    }
+    return left;
+  }
+
+  // Comparisons do not chain: a < b < c is an error
+  int ParseComparison() {
+    const int left = ParseSum();
+    if (left < 0) {
+      return -1;
+    }
+    static constexpr std::pair<std::string_view, OpCode> kComparisons[] = {
+        {"<=", OpCode::kLessEqual}, {">=", OpCode::kGreaterEqual}, {"==", OpCode::kEqual},
+        {"!=", OpCode::kNotEqual},  {"<", OpCode::kLess},          {">", OpCode::kGreater},
+    };
+    SkipSpace();
+    const std::size_t position = pos_;
+    for (const auto& [token, op] : kComparisons) {
+      if (Accept(token)) {
+        return MakeBinary(op, left, ParseSum(), position);
+      }
+    }
+    return left;
+  }
+
+  int ParseSum() {
+    int left = ParseProduct();
+    while (left >= 0) {
+      SkipSpace();
+      const std::size_t position = pos_;
+      if (Accept("+")) {
+        left = MakeBinary(OpCode::kAdd, left, ParseProduct(), position);
+      } else if (Accept("-")) {
+        left = MakeBinary(OpCode::kSubtract, left, ParseProduct(), position);
+      } else {
+        break;
+      }
+    }
+    return left;
+  }
+
+  int ParseProduct() {
+    int left = ParseUnary();
+    while (left >= 0) {
+      SkipSpace();
+      const std::size_t position = pos_;
+      if (Accept("*")) {
+        left = MakeBinary(OpCode::kMultiply, left, ParseUnary(), position);
+      } else if (Accept("/")) {
+        left = MakeBinary(OpCode::kDivide, left, ParseUnary(), position);
+      } else {
+        break;
+      }
+    }
+    return left;
+  }
+
+  int ParseUnary() {
+    SkipSpace();
+    const std::size_t position = pos_;
+    // Not the start of !=, which ParseComparison handles
+    if (text_.substr(pos_, 2) != "!=" && Accept("!")) {
+      return MakeUnary(OpCode::kNot, ParseUnary(), position);
+    }
+    if (Accept("-")) {
+      return MakeUnary(OpCode::kNegate, ParseUnary(), position);
+    }
+    return ParsePrimary();
+  }
+
+  int ParsePrimary() {
+    SkipSpace();
+    const std::size_t position = pos_;
+    if (pos_ == text_.size()) {
+      return Fail(position, "expected a value");
+    }
+    const char c = text_[pos_];
+    if (c == '(') {
+      ++pos_;
+      const int inner = ParseOr();
+      if (inner >= 0 && !Accept(")")) {
+        return Fail(pos_, "expected ')'");
+      }
+      return inner;
+    }
+    if (c == '\'' || c == '"') {
+      const std::size_t end = text_.find(c, pos_ + 1);
+      if (end == std::string_view::npos) {
+        return Fail(position, "unterminated string");
+      }
+      Node node;
+      node.kind = Node::kString;
+      node.text = text_.substr(pos_ + 1, end - pos_ - 1);
+      node.position = position;
+      pos_ = end + 1;
+      return Add(node);
+    }
+    if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+      const std::string rest(text_.substr(pos_));
+      char* end = nullptr;
+      Node node;
+      node.value = std::strtod(rest.c_str(), &end);
+      if (end == rest.c_str()) {
+        return Fail(position, "bad number");
+      }
+      node.position = position;
+      pos_ += static_cast<std::size_t>(end - rest.c_str());
+      return Add(node);
+    }
+    if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+      return ParseName();
+    }
+    return Fail(position, "unexpected '" + std::string(1, c) + "'");
+  }
+
+  // Signal or Message.Signal
+  int ParseName() {
+    const std::size_t position = pos_;
+    const auto is_name = [](char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_'; };
+    while (pos_ < text_.size() && (is_name(text_[pos_]) ||
+                                   (text_[pos_] == '.' && pos_ + 1 < text_.size() && is_name(text_[pos_ + 1])))) {
+      ++pos_;
+    }
+    const std::string name(text_.substr(position, pos_ - position));
+    const bool qualified = name.find('.') != std::string::npos;
+    const auto& index = qualified ? by_full_name_ : by_name_;
+    const auto found = index.find(name);
+    if (found == index.end()) {
+      return Fail(position, "unknown signal " + name);
+    }
+    if (found->second == kAmbiguous) {
+      return Fail(position, "signal " + name + " is in several messages; write Message." + name);
+    }
+    Node node;
+    node.kind = Node::kSignal;
+    node.signal = found->second;
+    node.position = position;
+    return Add(node);
+  }
+
+  std::string_view text_;
+  std::size_t pos_ = 0;
+  const parser::DbcFile& dbc_file_;
+  const std::unordered_map<std::string, std::uint32_t>& by_name_;
+  const std::unordered_map<std::string, std::uint32_t>& by_full_name_;
+  const std::unordered_map<std::uint32_t, const parser::DbcFile::ValueDescription*>& descriptions_;
+  std::vector<Node> nodes_;
+  std::string error_;
+};
+
+// Emits the bytecode of a syntax tree, tracking the stack depth
+class Emitter {
+ public:
+  Emitter(const std::vector<Node>& nodes, CompiledRule& rule) : nodes_(nodes), rule_(rule) {}
+
+  // as_bool turns a number into 1.0 or 0.0, as && and || need
+  void Emit(int index, bool as_bool) {
+    const Node& node = nodes_[index];
+    switch (node.kind) {
+      case Node::kNumber:
+        Push({OpCode::kConstant, 0, node.value});
+        break;
+      case Node::kSignal:
+        rule_.signals.push_back(node.signal);
+        Push({OpCode::kSignal, node.signal, 0.0});
+        break;
+      case Node::kUnary:
+        Emit(node.left, node.op == OpCode::kNot);
+        rule_.code.push_back({node.op, 0, 0.0});
+        break;
+      case Node::kBinary:
+        EmitBinary(node);
+        break;
+      case Node::kString:
+        break;
+    }
+    if (as_bool && !node.boolean) {
+      rule_.code.push_back({OpCode::kTruth, 0, 0.0});
+    }
+  }
+
+  void Finish() {
+    std::sort(rule_.signals.begin(), rule_.signals.end());
+    rule_.signals.erase(std::unique(rule_.signals.begin(), rule_.signals.end()), rule_.signals.end());
+    rule_.max_stack = std::max<std::size_t>(max_depth_, 1);
+  }
+
+ private:
+  void Push(Instruction instruction) {
+    rule_.code.push_back(instruction);
+    max_depth_ = std::max(max_depth_, ++depth_);
+  }
+
+  void EmitBinary(const Node& node) {
+    const Node& left = nodes_[node.left];
+    const Node& right = nodes_[node.right];
+    if (node.op == OpCode::kJumpIfFalse || node.op == OpCode::kJumpIfTrue) {
+      Emit(node.left, true);
+      const std::size_t jump = rule_.code.size();
+      rule_.code.push_back({node.op, 0, 0.0});
+      --depth_;
+      Emit(node.right, true);
+      rule_.code[jump].arg = static_cast<std::uint32_t>(rule_.code.size());
+      return;
+    }
+    if (IsComparison(node.op) && left.kind == Node::kSignal && right.kind == Node::kNumber) {
+      rule_.signals.push_back(left.signal);
+      Push({Fused(node.op), left.signal, right.value});
+      return;
+    }
+    if (IsComparison(node.op) && left.kind == Node::kNumber && right.kind == Node::kSignal) {
+      rule_.signals.push_back(right.signal);
+      Push({Fused(Mirror(node.op)), right.signal, left.value});
+      return;
+    }
+    Emit(node.left, false);
+    Emit(node.right, false);
+    rule_.code.push_back({node.op, 0, 0.0});
+    --depth_;
+  }
+
+  const std::vector<Node>& nodes_;
+  CompiledRule& rule_;
+  std::size_t depth_ = 0;
+  std::size_t max_depth_ = 0;
+};
+
+}  // namespace
+
+bool CompiledRule::Evaluate(const double* signal_values, double* stack) const noexcept {
+  double* top = stack;  // One past the top value
+  const Instruction* const begin = code.data();
+  const Instruction* const end = begin + code.size();
+  for (const Instruction* instruction = begin; instruction != end;) {
+    switch (instruction->op) {
+      case OpCode::kConstant:
+        *top++ = instruction->value;
+        break;
+      case OpCode::kSignal:
+        *top++ = signal_values[instruction->arg];
+        break;
+      case OpCode::kNegate:
+        top[-1] = -top[-1];
+        break;
+      case OpCode::kNot:
+        top[-1] = Truth(top[-1]) ? 0.0 : 1.0;
+        break;
+      case OpCode::kTruth:
+        top[-1] = Truth(top[-1]) ? 1.0 : 0.0;
+        break;
+      case OpCode::kSignalLess:
+      case OpCode::kSignalLessEqual:
+      case OpCode::kSignalGreater:
+      case OpCode::kSignalGreaterEqual:
+      case OpCode::kSignalEqual:
+      case OpCode::kSignalNotEqual:
+        *top++ = Apply(instruction->op, signal_values[instruction->arg], instruction->value);
+        break;
+      case OpCode::kJumpIfFalse:
+        if (top[-1] == 0.0) {
+          instruction = begin + instruction->arg;
+          continue;
+        }
+        --top;
+        break;
+      case OpCode::kJumpIfTrue:
+        if (top[-1] != 0.0) {
+          instruction = begin + instruction->arg;
+          continue;
+        }
+        --top;
+        break;
+      default:
+        --top;
+        top[-1] = Apply(instruction->op, top[-1], *top);
+        break;
+    }
+    ++instruction;
+  }
+  return Truth(stack[0]);
+}
+
+RuleCompiler::RuleCompiler(const parser::DbcFile& dbc_file) : dbc_file_(dbc_file) {
+  for (const auto& [id, message] : dbc_file.messages_detailed) {
+    for (std::uint32_t signal = message.first_signal; signal < message.first_signal + message.signal_count;
+         ++signal) {
+      const std::string& name = dbc_file.signal_infos[signal].name;
+      by_full_name_.emplace(message.name + "." + name, signal);
+      const auto [it, inserted] = by_name_.emplace(name, signal);
+      if (!inserted) {
+        it->second = kAmbiguous;
+      }
+    }
+  }
+  for (const auto& description : dbc_file.value_descriptions) {
+    if (description.type != parser::ValueDescriptionType::SIGNAL) {
+      continue;
+    }
+    if (const auto signal = dbc_file.FindSignal(description.message_id, description.signal_name)) {
+      descriptions_.emplace(*signal, &description);
+    }
+  }
+}
+
+std::optional<CompiledRule> RuleCompiler::Compile(std::string_view text, std::string* error) const {
+  Parser parser(text, dbc_file_, by_name_, by_full_name_, descriptions_);
+  const int root = parser.Parse();
+  if (root < 0) {
+    if (error != nullptr) {
+      *error = parser.error();
+    }
+    return std::nullopt;
+  }
+
+  CompiledRule rule;
+  rule.text = std::string(text);
+  Emitter emitter(parser.nodes(), rule);
+  emitter.Emit(root, true);
+  emitter.Finish();
+  for (const std::uint32_t signal : rule.signals) {
+    rule.message_ids.push_back(dbc_file_.signal_infos[signal].message_id);
+  }
+  std::sort(rule.message_ids.begin(), rule.message_ids.end());
+  rule.message_ids.erase(std::unique(rule.message_ids.begin(), rule.message_ids.end()), rule.message_ids.end());
+  return rule;
+}
+
+}  // namespace rules
+}  // namespace dbc_parser
@@ -0,0 +1,126 @@
+#ifndef DBC_PARSER_RULES_RULE_COMPILER_H_
+#define DBC_PARSER_RULES_RULE_COMPILER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "dbc_parser/parser/dbc_file_parser.h"
+
+namespace dbc_parser {
+namespace rules {
+
+/**
+ * @brief Operations of the rule bytecode, a stack machine over doubles.
+ *
+ * Booleans are 1.0 and 0.0. Comparisons with NaN are false, != included.
+ */
+enum class OpCode : std::uint8_t {
+  kConstant,      ///< Push value
+  kSignal,        ///< Push the value of signal arg
+  kNegate,        ///< -a
+  kNot,           ///< !a
+  kTruth,         ///< a as a boolean: neither 0 nor NaN
+  kAdd,           ///< a + b
+  kSubtract,      ///< a - b
+  kMultiply,      ///< a * b
+  kDivide,        ///< a / b
+  kLess,          ///< a < b
+  kLessEqual,     ///< a <= b
+  kGreater,       ///< a > b
+  kGreaterEqual,  ///< a >= b
+  kEqual,         ///< a == b
+  kNotEqual,      ///< a != b
+  // Signal arg compared with value, the usual shape of a rule's terms
+  kSignalLess,
+  kSignalLessEqual,
+  kSignalGreater,
+  kSignalGreaterEqual,
+  kSignalEqual,
+  kSignalNotEqual,
+  kJumpIfFalse,  ///< If a is false jump to arg and keep it, else pop it
+  kJumpIfTrue,   ///< If a is true jump to arg and keep it, else pop it
+};
+
+/**
+ * @brief One bytecode instruction.
+ */
+struct Instruction {
+  OpCode op = OpCode::kConstant;
+  std::uint32_t arg = 0;  ///< Signal ID or jump target
+  double value = 0.0;     ///< Constant
+};
+
+/**
+ * @brief A rule compiled against one DbcFile.
+ */
+struct CompiledRule {
+  std::string text;                    ///< Source of the rule
+  std::vector<Instruction> code;       ///< Bytecode; leaves one value on the stack
+  std::vector<std::uint32_t> signals;  ///< Signal IDs read, ascending
+  std::vector<int> message_ids;        ///< DBC IDs of the messages of signals, ascending
+  std::size_t max_stack = 0;           ///< Stack slots Evaluate needs
+
+  /**
+   * @brief Runs the rule.
+   *
+   * @param signal_values Current value of every signal, by signal ID
+   * @param stack Scratch space of at least max_stack values
+   * @return bool Whether the rule holds
+   */
+  [[nodiscard]] bool Evaluate(const double* signal_values, double* stack) const noexcept;
+};
+
+/**
+ * @brief Compiles alert rules over the signals of a DbcFile.
+ *
+ * A rule is an expression such as
+ *
+ *     EngineSpeed > 6000 && GearPos == 'R'
+ *
+ * with, by falling precedence, `!` and unary `-`; `*` and `/`; `+` and `-`;
+ * the comparisons `<`, `<=`, `>`, `>=`, `==` and `!=`; `&&`; and `||`.
+ * Operands are numbers, parentheses, signals named `Signal` or, where a name
+ * is not unique, `Message.Signal`, and string literals in single or double
+ * quotes. A string literal is compared with `==` or `!=` against a signal
+ * and stands for the physical value of the signal's VAL_ entry of that text.
+ * Numbers used as conditions are true unless 0 or NaN.
+ *
+ * Names and enum literals are resolved at compile time and constant terms
+ * folded, so the bytecode only refers to signals by ID.
+ */
+class RuleCompiler {
+ public:
+  /**
+   * @brief Indexes the signal names and value descriptions of a file.
+   *
+   * @param dbc_file Parsed file; must outlive the compiler
+   */
+  explicit RuleCompiler(const parser::DbcFile& dbc_file);
+
+  /**
+   * @brief Compiles one rule.
+   *
+   * @param text The rule
+   * @param error Receives what is wrong with the rule and where, if not null
+   * @return std::optional<CompiledRule> The rule, or std::nullopt on a syntax
+   *         error, an unknown or ambiguous signal or an unknown enum literal
+   */
+  [[nodiscard]] std::optional<CompiledRule> Compile(std::string_view text, std::string* error = nullptr) const;
+
+ private:
+  const parser::DbcFile& dbc_file_;
+  std::unordered_map<std::string, std::uint32_t> by_name_;       ///< Signal name; all ones if not unique
+  std::unordered_map<std::string, std::uint32_t> by_full_name_;  ///< "Message.Signal"
+  /// Signal ID to its VAL_ entries
+  std::unordered_map<std::uint32_t, const parser::DbcFile::ValueDescription*> descriptions_;
+};
+
+}  // namespace rules
+}  // namespace dbc_parser
+
+#endif  // DBC_PARSER_RULES_RULE_COMPILER_H_
@@ -0,0 +1,101 @@
+#include "dbc_parser/rules/rule_engine.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "dbc_parser/decoder/signal_decoder.h"
+
+namespace dbc_parser {
+namespace rules {
+
+RuleEngine::RuleEngine(const decoder::FrameDecoder& decoder, const parser::DbcFile& dbc_file,
+                       TriggerCallback on_trigger)
+    : decoder_(decoder),
+      dbc_file_(dbc_file),
+      compiler_(dbc_file),
+      on_trigger_(std::move(on_trigger)),
+      rules_by_message_(dbc_file.signal_layouts.size()),
+      values_(dbc_file.signal_layouts.size(), std::numeric_limits<double>::quiet_NaN()),
+      stack_(1),
+      decoded_(std::max<std::size_t>(decoder.MaxSignalCount(), 1)) {}
+
+std::optional<std::uint32_t> RuleEngine::AddRule(std::string_view text, std::string* error) {
+  std::optional<CompiledRule> rule = compiler_.Compile(text, error);
+  if (!rule) {
+    return std::nullopt;
+  }
+  if (rule->signals.empty()) {
+    if (error != nullptr) {
+      *error = "the rule reads no signal";
+    }
+    return std::nullopt;
+  }
+  const auto rule_id = static_cast<std::uint32_t>(rules_.size());
+  for (const int message_id : rule->message_ids) {
+    rules_by_message_[dbc_file_.messages_detailed.at(message_id).first_signal].push_back(rule_id);
+  }
+  stack_.resize(std::max(stack_.size(), rule->max_stack));
+  rules_.push_back(std::move(*rule));
+  states_.push_back(kWaiting);
+  return rule_id;
+}
+
+void RuleEngine::OnFrame(const decoder::CanFrame& frame) {
+  const decoder::FrameDecoder::MessageEntry* message = decoder_.Find(frame.dbc_id());
+  if (message == nullptr || RulesOf(*message).empty()) {
+    return;
+  }
+  decoder::SignalDecoder::DecodeMessage(message->layouts, message->plans, message->signal_count, frame.data,
+                                        frame.size, decoded_.data());
+  AddMessage(*message, frame.timestamp_ns, decoded_.data());
+}
+
+void RuleEngine::AddMessage(const decoder::FrameDecoder::MessageEntry& message, std::int64_t timestamp_ns,
+                            const double* values) {
+  const std::vector<std::uint32_t>& rule_ids = RulesOf(message);
+  if (rule_ids.empty()) {
+    return;
+  }
+  double* latest = values_.data() + message.message->first_signal;
+  for (std::uint32_t i = 0; i < message.signal_count; ++i) {
+    if (!std::isnan(values[i])) {
+      latest[i] = values[i];
+    }
+  }
+
+  for (const std::uint32_t rule_id : rule_ids) {
+    const CompiledRule& rule = rules_[rule_id];
+    State& state = states_[rule_id];
+    if (state == kWaiting) {
+      if (std::any_of(rule.signals.begin(), rule.signals.end(),
+                      [this](std::uint32_t signal) { return std::isnan(values_[signal]); })) {
+        continue;
+      }
+      state = kInactive;
+    }
+    ++evaluated_;
+    const bool holds = rule.Evaluate(values_.data(), stack_.data());
+    if (holds && state == kInactive) {
+      ++triggered_;
+      if (on_trigger_) {
+        on_trigger_(rule_id, timestamp_ns);
+      }
+    }
+    state = holds ? kActive : kInactive;
+  }
+}
+
+const std::vector<std::uint32_t>& RuleEngine::RulesOf(
+    const decoder::FrameDecoder::MessageEntry& message) const noexcept {
+  // A message without signals shares its first signal ID with the next one
+  static const std::vector<std::uint32_t> kNone;
+  if (message.signal_count == 0) {
+    return kNone;
+  }
+  return rules_by_message_[message.message->first_signal];
+}
+
+}  // namespace rules
+}  // namespace dbc_parser
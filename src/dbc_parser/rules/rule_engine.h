@@ -0,0 +1,117 @@
+#ifndef DBC_PARSER_RULES_RULE_ENGINE_H_
+#define DBC_PARSER_RULES_RULE_ENGINE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "dbc_parser/decoder/can_frame.h"
+#include "dbc_parser/decoder/frame_decoder.h"
+#include "dbc_parser/parser/dbc_file_parser.h"
+#include "dbc_parser/rules/rule_compiler.h"
+
+namespace dbc_parser {
+namespace rules {
+
+/**
+ * @brief Evaluates compiled rules on live traffic and reports those that
+ *        start to hold.
+ *
+ * Every rule is indexed by the messages whose signals it reads, so a frame
+ * only evaluates the rules that depend on its CAN ID, and frames of messages
+ * no rule reads are not even decoded. The latest value of every signal is
+ * kept in a flat array by signal ID; a rule that reads several messages
+ * sees the latest value of each. NaN values, such as those of inactive
+ * multiplexed signals, keep the previous value.
+ *
+ * A rule is evaluated once all of its signals have had a value, and
+ * triggers when it changes from false to true.
+ *
+ * Not thread-safe; feed frames in timestamp order from one thread, e.g.
+ * from the ordered LogDecoder callback.
+ */
+class RuleEngine {
+ public:
+  /// Receives a rule that started to hold, and the time of the frame
+  using TriggerCallback = std::function<void(std::uint32_t rule_id, std::int64_t timestamp_ns)>;
+
+  /**
+   * @brief Creates an engine without rules.
+   *
+   * @param decoder Decoder of dbc_file; must outlive the engine
+   * @param dbc_file File rules are compiled against; must outlive the engine
+   * @param on_trigger Receiver of triggered rules
+   */
+  RuleEngine(const decoder::FrameDecoder& decoder, const parser::DbcFile& dbc_file, TriggerCallback on_trigger);
+
+  /**
+   * @brief Compiles a rule and indexes it by the messages it reads.
+   *
+   * @param text The rule, see RuleCompiler
+   * @param error Receives why the rule was rejected, if not null
+   * @return std::optional<std::uint32_t> The rule ID, counting from 0 in the
+   *         order rules were added, or std::nullopt if the rule does not
+   *         compile or reads no signal
+   */
+  std::optional<std::uint32_t> AddRule(std::string_view text, std::string* error = nullptr);
+
+  /**
+   * @brief Decodes a frame if any rule reads its message, and evaluates
+   *        those rules.
+   */
+  void OnFrame(const decoder::CanFrame& frame);
+
+  /**
+   * @brief Evaluates the rules that read an already decoded message.
+   *
+   * @param message The message, as found by FrameDecoder
+   * @param timestamp_ns Time of the frame
+   * @param values message.signal_count values, as decoded by SignalDecoder
+   */
+  void AddMessage(const decoder::FrameDecoder::MessageEntry& message, std::int64_t timestamp_ns,
+                  const double* values);
+
+  /**
+   * @brief IDs of the rules that read a message, i.e. the rules one of its
+   *        frames evaluates.
+   */
+  [[nodiscard]] const std::vector<std::uint32_t>& RulesOf(
+      const decoder::FrameDecoder::MessageEntry& message) const noexcept;
+
+  [[nodiscard]] std::size_t rule_count() const noexcept { return rules_.size(); }
+  [[nodiscard]] const CompiledRule& rule(std::uint32_t rule_id) const noexcept { return rules_[rule_id]; }
+  /// Whether a rule held at its latest evaluation
+  [[nodiscard]] bool active(std::uint32_t rule_id) const noexcept { return states_[rule_id] == kActive; }
+  /// Latest value of a signal that some rule reads, NaN before the first
+  [[nodiscard]] double value(std::uint32_t signal_id) const noexcept { return values_[signal_id]; }
+  /// Rule evaluations so far
+  [[nodiscard]] std::uint64_t evaluated() const noexcept { return evaluated_; }
+  /// Triggers so far
+  [[nodiscard]] std::uint64_t triggered() const noexcept { return triggered_; }
+
+ private:
+  enum State : std::uint8_t { kWaiting, kInactive, kActive };
+
+  const decoder::FrameDecoder& decoder_;
+  const parser::DbcFile& dbc_file_;
+  RuleCompiler compiler_;
+  TriggerCallback on_trigger_;
+  std::vector<CompiledRule> rules_;
+  std::vector<State> states_;  ///< By rule ID; kWaiting until all signals had a value
+  /// Rule IDs by the first signal ID of the messages they read
+  std::vector<std::vector<std::uint32_t>> rules_by_message_;
+  std::vector<double> values_;   ///< By signal ID
+  std::vector<double> stack_;    ///< Evaluation stack of the deepest rule
+  std::vector<double> decoded_;  ///< Signal values of the frame in OnFrame
+  std::uint64_t evaluated_ = 0;
+  std::uint64_t triggered_ = 0;
+};
+
+}  // namespace rules
+}  // namespace dbc_parser
+
+#endif  // DBC_PARSER_RULES_RULE_ENGINE_H_
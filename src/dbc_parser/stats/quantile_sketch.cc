@@ -0,0 +1,126 @@
+#include "dbc_parser/stats/quantile_sketch.h"
+
+#include <algorithm>
+
+namespace dbc_parser {
+namespace stats {
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+// The largest cumulative fraction a centroid that starts at q may reach: one
+// unit further on the arcsine scale k(q) = compression / (2 pi) * asin(2q - 1)
+double CentroidLimit(double q, double compression) {
+  const double k = compression / (2 * kPi) * std::asin(2 * q - 1) + 1;
+  if (k >= compression / 4) {
+    return 1.0;
+  }
+  return (std::sin(k * 2 * kPi / compression) + 1) / 2;
+}
+
+}  // namespace
+
+QuantileSketch::QuantileSketch(double compression) noexcept
+    : compression_(std::max(compression, 10.0)),
+      buffer_limit_(static_cast<std::size_t>(4 * compression_)) {}
+
+void QuantileSketch::Merge(const QuantileSketch& other) {
+  if (other.count_ == 0) {
+    return;
+  }
+  for (const std::vector<Centroid>* centroids : {&other.centroids_, &other.buffer_}) {
+    for (const Centroid& centroid : *centroids) {
+      if (buffer_.size() >= buffer_limit_) {
+        Compress();
+      }
+      buffer_.push_back(centroid);
+    }
+  }
+  count_ += other.count_;
+  min_ = std::min(min_, other.min_);
+  max_ = std::max(max_, other.max_);
+}
+
+void QuantileSketch::Compress() {
+  if (buffer_.empty()) {
+    return;
+  }
+  buffer_.insert(buffer_.end(), centroids_.begin(), centroids_.end());
+  std::sort(buffer_.begin(), buffer_.end(), [](const Centroid& a, const Centroid& b) { return a.mean < b.mean; });
+  double total = 0.0;
+  for (const Centroid& centroid : buffer_) {
+    total += centroid.weight;
+  }
+
+  centroids_.clear();
+  Centroid current = buffer_.front();
+  double weight_before = 0.0;
+  double limit = total * CentroidLimit(0.0, compression_);
+  for (std::size_t i = 1; i < buffer_.size(); ++i) {
+    const Centroid& next = buffer_[i];
+    if (weight_before + current.weight + next.weight <= limit) {
+      current.weight += next.weight;
+      current.mean += (next.mean - current.mean) * next.weight / current.weight;
+    } else {
+      weight_before += current.weight;
+      centroids_.push_back(current);
+      limit = total * CentroidLimit(weight_before / total, compression_);
+      current = next;
+    }
+  }
+  centroids_.push_back(current);
+  buffer_.clear();
+}
+
+double QuantileSketch::Quantile(double q) const {
+  if (count_ == 0) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  if (!buffer_.empty()) {
+    QuantileSketch compressed = *this;
+    compressed.Compress();
+    return compressed.Quantile(q);
+  }
+  if (q <= 0.0) {
+    return min_;
+  }
+  if (q >= 1.0) {
+    return max_;
+  }
+
+  const double rank = q * static_cast<double>(count_);
+  const Centroid& first = centroids_.front();
+  if (rank < first.weight / 2) {
+    // Between the minimum and the centre of the first centroid
+    return first.weight <= 1.0 ? first.mean : min_ + (first.mean - min_) * rank / (first.weight / 2);
+  }
+  double center = first.weight / 2;
+  for (std::size_t i = 0; i + 1 < centroids_.size(); ++i) {
+    const Centroid& left = centroids_[i];
+    const Centroid& right = centroids_[i + 1];
+    const double gap = (left.weight + right.weight) / 2;
+    if (center + gap > rank) {
+      // A centroid of one value is that value, not a range around it
+      if (left.weight == 1.0 && rank - center < 0.5) {
+        return left.mean;
+      }
+      if (right.weight == 1.0 && center + gap - rank <= 0.5) {
+        return right.mean;
+      }
+      const double to_left = rank - center;
+      const double to_right = center + gap - rank;
+      return (left.mean * to_right + right.mean * to_left) / gap;
+    }
+    center += gap;
+  }
+  // Between the centre of the last centroid and the maximum
+  const Centroid& last = centroids_.back();
+  if (last.weight <= 1.0) {
+    return last.mean;
+  }
+  const double to_max = std::min(rank - center, last.weight / 2);
+  return last.mean + (max_ - last.mean) * to_max / (last.weight / 2);
+}
+
+}  // namespace stats
+}  // namespace dbc_parser
@@ -0,0 +1,105 @@
+#ifndef DBC_PARSER_STATS_QUANTILE_SKETCH_H_
+#define DBC_PARSER_STATS_QUANTILE_SKETCH_H_
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace dbc_parser {
+namespace stats {
+
+/**
+ * @brief A mergeable t-digest: approximate quantiles of a stream in bounded
+ *        memory.
+ *
+ * Values are buffered and periodically merged into at most about
+ * compression centroids, each the mean and weight of a run of neighbouring
+ * values. The arcsine scale function keeps centroids near the median wide
+ * and those near the tails small, so the rank error of Quantile(q) shrinks
+ * with q * (1 - q): roughly 1 / compression at the median and far less at
+ * p99 and p999. The minimum and maximum are exact.
+ *
+ * Merging two sketches gives the same accuracy as one sketch of both
+ * streams, so streams can be summarized in parts, e.g. per thread, and
+ * merged at the end. Not thread-safe.
+ */
+class QuantileSketch {
+ public:
+  /// A run of values by its mean and count
+  struct Centroid {
+    double mean = 0.0;
+    double weight = 0.0;
+  };
+
+  /**
+   * @brief Creates an empty sketch.
+   *
+   * @param compression Bound on the centroids kept; higher is more accurate
+   *        and larger, at 16 bytes per centroid plus a buffer of four times
+   *        as many
+   */
+  explicit QuantileSketch(double compression = 200.0) noexcept;
+
+  /**
+   * @brief Adds a value; NaN is ignored.
+   */
+  void Add(double value) {
+    if (std::isnan(value)) {
+      return;
+    }
+    if (buffer_.size() >= buffer_limit_) {
+      Compress();
+    }
+    buffer_.push_back({value, 1.0});
+    ++count_;
+    min_ = value < min_ ? value : min_;
+    max_ = value > max_ ? value : max_;
+  }
+
+  /**
+   * @brief Adds every value summarized by another sketch.
+   */
+  void Merge(const QuantileSketch& other);
+
+  /**
+   * @brief Merges the buffered values into the centroids.
+   *
+   * Called by Add when the buffer is full; call it once more before reading
+   * centroids().
+   */
+  void Compress();
+
+  /**
+   * @brief Estimates the value below which a fraction q of the values lie.
+   *
+   * Interpolates between the centres of neighbouring centroids, and between
+   * the outer centroids and the minimum and maximum.
+   *
+   * @param q Fraction in [0, 1]; 0 gives the minimum and 1 the maximum
+   * @return double The estimate, or NaN if the sketch is empty
+   */
+  [[nodiscard]] double Quantile(double q) const;
+
+  [[nodiscard]] std::uint64_t count() const noexcept { return count_; }
+  [[nodiscard]] double min() const noexcept { return min_; }
+  [[nodiscard]] double max() const noexcept { return max_; }
+  [[nodiscard]] double compression() const noexcept { return compression_; }
+  /// The merged centroids in ascending order of mean, without the buffer
+  [[nodiscard]] const std::vector<Centroid>& centroids() const noexcept { return centroids_; }
+
+ private:
+  double compression_;
+  std::size_t buffer_limit_;
+  std::vector<Centroid> centroids_;
+  std::vector<Centroid> buffer_;
+  std::uint64_t count_ = 0;
+  double min_ = std::numeric_limits<double>::infinity();
+  double max_ = -std::numeric_limits<double>::infinity();
+};
+
+}  // namespace stats
+}  // namespace dbc_parser
+
+#endif  // DBC_PARSER_STATS_QUANTILE_SKETCH_H_
@@ -0,0 +1,63 @@
+#include "dbc_parser/stats/signal_stats.h"
+
+#include <algorithm>
+
+namespace dbc_parser {
+namespace stats {
+
+void SignalMoments::Merge(const SignalMoments& other) noexcept {
+  if (other.count == 0) {
+    return;
+  }
+  const double total = static_cast<double>(count + other.count);
+  const double delta = other.mean - mean;
+  mean += delta * static_cast<double>(other.count) / total;
+  m2 += other.m2 + delta * delta * static_cast<double>(count) * static_cast<double>(other.count) / total;
+  count += other.count;
+  min = std::min(min, other.min);
+  max = std::max(max, other.max);
+  below_minimum += other.below_minimum;
+  above_maximum += other.above_maximum;
+}
+
+SignalStats::SignalStats(const parser::DbcFile& dbc_file, SignalStatsOptions options)
+    : layouts_(dbc_file.signal_layouts),
+      moments_(dbc_file.signal_layouts.size()),
+      sketches_(dbc_file.signal_layouts.size(), QuantileSketch(options.compression)) {}
+
+void SignalStats::Merge(const SignalStats& other) {
+  const std::size_t count = std::min(moments_.size(), other.moments_.size());
+  for (std::size_t i = 0; i < count; ++i) {
+    moments_[i].Merge(other.moments_[i]);
+    sketches_[i].Merge(other.sketches_[i]);
+  }
+}
+
+SignalStatsCollector::SignalStatsCollector(const parser::DbcFile& dbc_file, decoder::LogDecodeOptions& options,
+                                           SignalStatsOptions stats_options)
+    : dbc_file_(dbc_file), stats_options_(stats_options), workers_(options.MaxThreads()) {
+  options.on_worker_frame = [this](std::size_t worker, const decoder::DecodedFrame& decoded) {
+    if (decoded.message == nullptr) {
+      return;
+    }
+    std::optional<SignalStats>& stats = workers_[worker];
+    if (!stats) {
+      stats.emplace(dbc_file_, stats_options_);
+    }
+    stats->AddMessage(*decoded.message, decoded.values);
+  };
+}
+
+SignalStats SignalStatsCollector::Finish() {
+  SignalStats total(dbc_file_, stats_options_);
+  for (std::optional<SignalStats>& stats : workers_) {
+    if (stats) {
+      total.Merge(*stats);
+      stats.reset();
+    }
+  }
+  return total;
+}
+
+}  // namespace stats
+}  // namespace dbc_parser
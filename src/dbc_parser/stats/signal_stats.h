@@ -0,0 +1,176 @@
+#ifndef DBC_PARSER_STATS_SIGNAL_STATS_H_
+#define DBC_PARSER_STATS_SIGNAL_STATS_H_
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "dbc_parser/decoder/frame_decoder.h"
+#include "dbc_parser/decoder/log_decoder.h"
+#include "dbc_parser/parser/dbc_file_parser.h"
+#include "dbc_parser/stats/quantile_sketch.h"
+
+namespace dbc_parser {
+namespace stats {
+
+/**
+ * @brief Tuning of SignalStats.
+ */
+struct SignalStatsOptions {
+  /// Compression of every signal's QuantileSketch
+  double compression = 200.0;
+};
+
+/**
+ * @brief Streaming moments and range checks of one signal.
+ *
+ * The mean and variance use Welford's update, which stays accurate over
+ * billions of samples, and merge with the parallel form of Chan et al.
+ */
+struct SignalMoments {
+  std::uint64_t count = 0;                                ///< Samples
+  double mean = 0.0;                                      ///< Mean of the samples
+  double m2 = 0.0;                                        ///< Sum of squared deviations from the mean
+  double min = std::numeric_limits<double>::infinity();   ///< Smallest sample
+  double max = -std::numeric_limits<double>::infinity();  ///< Largest sample
+  std::uint64_t below_minimum = 0;                        ///< Samples below the signal's minimum
+  std::uint64_t above_maximum = 0;                        ///< Samples above the signal's maximum
+
+  void Add(double value) noexcept {
+    ++count;
+    const double delta = value - mean;
+    mean += delta / static_cast<double>(count);
+    m2 += delta * (value - mean);
+    min = value < min ? value : min;
+    max = value > max ? value : max;
+  }
+
+  void Merge(const SignalMoments& other) noexcept;
+
+  /// Population variance; 0 without samples
+  [[nodiscard]] double Variance() const noexcept { return count > 0 ? m2 / static_cast<double>(count) : 0.0; }
+  [[nodiscard]] double StandardDeviation() const noexcept { return std::sqrt(Variance()); }
+};
+
+/**
+ * @brief Per-signal statistics of decoded samples: moments, out-of-range
+ *        counts and quantiles.
+ *
+ * Moments and sketches are flat arrays indexed by signal ID, the position of
+ * a signal in DbcFile::signal_layouts, so a message's samples update
+ * neighbouring entries. A sample counts as out of range against the
+ * signal's minimum and maximum unless both are equal, which DBC files write
+ * as [0|0] for "no range". NaN, the value of signals a frame does not carry,
+ * is skipped.
+ *
+ * Not thread-safe; give each thread its own and Merge them, or use
+ * SignalStatsCollector.
+ */
+class SignalStats {
+ public:
+  /**
+   * @brief Creates empty statistics for every signal of a file.
+   *
+   * @param dbc_file File the samples are decoded with; must outlive this object
+   * @param options Sketch compression
+   */
+  explicit SignalStats(const parser::DbcFile& dbc_file, SignalStatsOptions options = {});
+
+  /**
+   * @brief Adds one sample of a signal.
+   */
+  void Add(std::uint32_t signal_id, double value) {
+    if (std::isnan(value)) {
+      return;
+    }
+    SignalMoments& moments = moments_[signal_id];
+    moments.Add(value);
+    const parser::SignalLayout& layout = layouts_[signal_id];
+    if (layout.minimum != layout.maximum) {
+      moments.below_minimum += value < layout.minimum ? 1 : 0;
+      moments.above_maximum += value > layout.maximum ? 1 : 0;
+    }
+    sketches_[signal_id].Add(value);
+  }
+
+  /**
+   * @brief Adds the signal values of one decoded message.
+   *
+   * @param message The message, as found by FrameDecoder
+   * @param values message.signal_count values, as decoded by SignalDecoder
+   */
+  void AddMessage(const decoder::FrameDecoder::MessageEntry& message, const double* values) {
+    for (std::uint32_t i = 0; i < message.signal_count; ++i) {
+      Add(message.message->first_signal + i, values[i]);
+    }
+  }
+
+  /**
+   * @brief Adds every sample of statistics of the same DbcFile.
+   */
+  void Merge(const SignalStats& other);
+
+  [[nodiscard]] std::size_t signal_count() const noexcept { return moments_.size(); }
+  [[nodiscard]] const SignalMoments& moments(std::uint32_t signal_id) const noexcept { return moments_[signal_id]; }
+  [[nodiscard]] const QuantileSketch& sketch(std::uint32_t signal_id) const noexcept {
+    return sketches_[signal_id];
+  }
+
+  /**
+   * @brief Estimates a quantile of a signal, see QuantileSketch::Quantile.
+   */
+  [[nodiscard]] double Quantile(std::uint32_t signal_id, double q) const { return sketches_[signal_id].Quantile(q); }
+
+ private:
+  const std::vector<parser::SignalLayout>& layouts_;
+  std::vector<SignalMoments> moments_;
+  std::vector<QuantileSketch> sketches_;
+};
+
+/**
+ * @brief Collects SignalStats on the worker threads of a log reader.
+ *
+ * Attaches to LogDecodeOptions::on_worker_frame, so every worker adds the
+ * frames it decodes to its own SignalStats without locks or a callback
+ * on the merging thread, and Finish merges them. Each worker's statistics
+ * are created by the worker on its first frame. Frames that are only
+ * parts of a J1939 transport protocol transfer are not reassembled here.
+ *
+ *   SignalStatsCollector collector(dbc_file, options);
+ *   LogDecoder(decoder, &CandumpParser::ParseLine, options).Decode(log);
+ *   const SignalStats stats = collector.Finish();
+ */
+class SignalStatsCollector {
+ public:
+  /**
+   * @brief Creates the collector and sets options.on_worker_frame.
+   *
+   * @param dbc_file File the decoder was built from; must outlive this object
+   * @param options Reader options to attach to; their threads must not
+   *        change before the decode
+   * @param stats_options Sketch compression
+   */
+  SignalStatsCollector(const parser::DbcFile& dbc_file, decoder::LogDecodeOptions& options,
+                       SignalStatsOptions stats_options = {});
+
+  SignalStatsCollector(const SignalStatsCollector&) = delete;
+  SignalStatsCollector& operator=(const SignalStatsCollector&) = delete;
+
+  /**
+   * @brief Merges the statistics of all workers; call after the decode.
+   */
+  [[nodiscard]] SignalStats Finish();
+
+ private:
+  const parser::DbcFile& dbc_file_;
+  SignalStatsOptions stats_options_;
+  std::vector<std::optional<SignalStats>> workers_;
+};
+
+}  // namespace stats
+}  // namespace dbc_parser
+
+#endif  // DBC_PARSER_STATS_SIGNAL_STATS_H_
@@ -0,0 +1,153 @@
+#include "dbc_parser/stats/window_aggregator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace dbc_parser {
+namespace stats {
+namespace {
+
+// Start of the window of width resolution_ns that holds timestamp_ns
+std::int64_t WindowStart(std::int64_t timestamp_ns, std::int64_t resolution_ns) {
+  const std::int64_t remainder = timestamp_ns % resolution_ns;
+  return timestamp_ns - (remainder < 0 ? remainder + resolution_ns : remainder);
+}
+
+}  // namespace
+
+WindowAggregator::WindowAggregator(const parser::DbcFile& dbc_file, WindowCallback on_windows,
+                                   WindowAggregatorOptions options)
+    : on_windows_(std::move(on_windows)), options_(std::move(options)) {
+  for (std::int64_t& resolution_ns : options_.resolutions_ns) {
+    resolution_ns = std::max<std::int64_t>(resolution_ns, 1);
+  }
+  options_.batch_windows = std::max<std::size_t>(options_.batch_windows, 1);
+  const std::size_t signal_count = dbc_file.signal_layouts.size();
+  const std::size_t resolutions = options_.resolutions_ns.size();
+  windows_.resize(signal_count * resolutions);
+  enum_ranges_.resize(signal_count);
+
+  for (const auto& description : dbc_file.value_descriptions) {
+    if (description.type != parser::ValueDescriptionType::SIGNAL || description.values.empty()) {
+      continue;
+    }
+    const auto signal_id = dbc_file.FindSignal(description.message_id, description.signal_name);
+    if (!signal_id || *signal_id >= signal_count || enum_ranges_[*signal_id].size != 0) {
+      continue;
+    }
+    // Descriptions are of raw values; samples arrive scaled
+    const parser::SignalLayout& layout = dbc_file.signal_layouts[*signal_id];
+    EnumRange& range = enum_ranges_[*signal_id];
+    range.values = static_cast<std::uint32_t>(enum_values_.size());
+    for (const auto& [raw, text] : description.values) {
+      enum_values_.push_back(static_cast<double>(raw) * layout.factor + layout.offset);
+    }
+    std::sort(enum_values_.begin() + range.values, enum_values_.end());
+    enum_values_.erase(std::unique(enum_values_.begin() + range.values, enum_values_.end()), enum_values_.end());
+    range.size = static_cast<std::uint32_t>(enum_values_.size() - range.values);
+    range.counts = static_cast<std::uint32_t>(enum_counts_.size());
+    enum_counts_.resize(enum_counts_.size() + range.size * resolutions);
+  }
+}
+
+void WindowAggregator::Add(std::uint32_t signal_id, std::int64_t timestamp_ns, double value) {
+  if (std::isnan(value)) {
+    return;
+  }
+  const EnumRange& range = enum_ranges_[signal_id];
+  std::uint32_t* counts = nullptr;
+  if (range.size != 0) {
+    const double* values = enum_values_.data() + range.values;
+    const double* found = std::lower_bound(values, values + range.size, value);
+    if (found != values + range.size && *found == value) {
+      counts = enum_counts_.data() + range.counts + (found - values);
+    }
+  }
+
+  const std::size_t resolutions = options_.resolutions_ns.size();
+  OpenWindow* window = windows_.data() + signal_id * resolutions;
+  for (std::uint32_t resolution = 0; resolution < resolutions; ++resolution, ++window) {
+    if (window->count != 0 && timestamp_ns >= window->end_ns) {
+      Close(signal_id, resolution);
+    }
+    if (window->count == 0) {
+      window->start_ns = WindowStart(timestamp_ns, options_.resolutions_ns[resolution]);
+      window->end_ns = window->start_ns + options_.resolutions_ns[resolution];
+      window->first = value;
+      window->min = value;
+      window->max = value;
+      window->sum = 0.0;
+    }
+    ++window->count;
+    window->last = value;
+    window->min = std::min(window->min, value);
+    window->max = std::max(window->max, value);
+    window->sum += value;
+    if (counts != nullptr) {
+      ++counts[resolution * range.size];
+    }
+  }
+  if (closed_.size() >= options_.batch_windows) {
+    Emit();
+  }
+}
+
+void WindowAggregator::Close(std::uint32_t signal_id, std::uint32_t resolution) {
+  OpenWindow& window = windows_[signal_id * options_.resolutions_ns.size() + resolution];
+  SignalWindow& closed = closed_.emplace_back();
+  closed.signal_id = signal_id;
+  closed.resolution = resolution;
+  closed.start_ns = window.start_ns;
+  closed.count = window.count;
+  closed.first = window.first;
+  closed.last = window.last;
+  closed.min = window.min;
+  closed.max = window.max;
+
+  const EnumRange& range = enum_ranges_[signal_id];
+  if (range.size == 0) {
+    closed.mean = window.sum / static_cast<double>(window.count);
+    closed.mode = std::numeric_limits<double>::quiet_NaN();
+  } else {
+    closed.mean = std::numeric_limits<double>::quiet_NaN();
+    closed.mode = window.last;
+    std::uint32_t* counts = enum_counts_.data() + range.counts + resolution * range.size;
+    std::uint32_t best = 0;
+    for (std::uint32_t i = 0; i < range.size; ++i) {
+      if (counts[i] > best) {
+        best = counts[i];
+        closed.mode = enum_values_[range.values + i];
+      }
+      counts[i] = 0;
+    }
+  }
+  window.count = 0;
+}
+
+void WindowAggregator::Emit() {
+  if (closed_.empty()) {
+    return;
+  }
+  if (on_windows_) {
+    on_windows_(closed_.data(), closed_.size());
+  }
+  emitted_ += closed_.size();
+  closed_.clear();
+}
+
+void WindowAggregator::CloseBefore(std::int64_t timestamp_ns) {
+  const std::size_t resolutions = options_.resolutions_ns.size();
+  for (std::size_t i = 0; i < windows_.size(); ++i) {
+    if (windows_[i].count != 0 && windows_[i].end_ns <= timestamp_ns) {
+      Close(static_cast<std::uint32_t>(i / resolutions), static_cast<std::uint32_t>(i % resolutions));
+    }
+  }
+  Emit();
+}
+
+void WindowAggregator::Finish() { CloseBefore(std::numeric_limits<std::int64_t>::max()); }
+
+}  // namespace stats
+}  // namespace dbc_parser
@@ -0,0 +1,155 @@
+#ifndef DBC_PARSER_STATS_WINDOW_AGGREGATOR_H_
+#define DBC_PARSER_STATS_WINDOW_AGGREGATOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "dbc_parser/decoder/frame_decoder.h"
+#include "dbc_parser/parser/dbc_file_parser.h"
+
+namespace dbc_parser {
+namespace stats {
+
+/**
+ * @brief Tuning of WindowAggregator.
+ */
+struct WindowAggregatorOptions {
+  /// Window widths, each aggregated at the same time; windows of width w
+  /// start at multiples of w
+  std::vector<std::int64_t> resolutions_ns = {1'000'000'000, 10'000'000'000, 60'000'000'000};
+  /// Closed windows collected before they are emitted together
+  std::size_t batch_windows = 4096;
+};
+
+/**
+ * @brief The aggregate of one signal over one closed window.
+ *
+ * Enum signals, those with VAL_ descriptions, have a mode instead of a mean:
+ * averaging gear positions or states yields values no frame ever carried.
+ */
+struct SignalWindow {
+  std::uint32_t signal_id = 0;   ///< Signal ID in the DbcFile
+  std::uint32_t resolution = 0;  ///< Index into WindowAggregatorOptions::resolutions_ns
+  std::int64_t start_ns = 0;     ///< Start of the window; it ends before start_ns plus the resolution
+  std::uint64_t count = 0;       ///< Samples in the window, at least 1
+  double first = 0.0;            ///< Earliest sample
+  double last = 0.0;             ///< Latest sample
+  double min = 0.0;              ///< Smallest sample
+  double max = 0.0;              ///< Largest sample
+  double mean = 0.0;             ///< Mean of the samples; NaN for enum signals
+  /// Enum signals: the described value seen most often, the smallest of a
+  /// tie, or last if no sample had a description; NaN for other signals
+  double mode = 0.0;
+};
+
+/**
+ * @brief Downsamples decoded signals into tumbling windows of several
+ *        resolutions at once.
+ *
+ * The open window of every signal and resolution lives in one contiguous
+ * array indexed by signal ID and resolution, so a message's samples update
+ * neighbouring state. Enum signals, found from the VAL_ descriptions of the
+ * DbcFile, also count the samples of each described value in a second flat
+ * array.
+ *
+ * A window closes when a sample of its signal reaches the next window, or
+ * on CloseBefore and Finish; closed windows are collected and handed to the
+ * callback batch_windows at a time. Samples are expected in timestamp order,
+ * as LogDecoder delivers them; a sample older than its signal's open window
+ * is added to that window.
+ *
+ * Not thread-safe.
+ */
+class WindowAggregator {
+ public:
+  /// Receives closed windows, in the order they closed
+  using WindowCallback = std::function<void(const SignalWindow* windows, std::size_t count)>;
+
+  /**
+   * @brief Creates the windows of every signal of a file.
+   *
+   * @param dbc_file File the samples are decoded with
+   * @param on_windows Receiver of the closed windows
+   * @param options Resolutions and batch size
+   */
+  WindowAggregator(const parser::DbcFile& dbc_file, WindowCallback on_windows, WindowAggregatorOptions options = {});
+
+  /**
+   * @brief Adds one sample of a signal; NaN is ignored.
+   */
+  void Add(std::uint32_t signal_id, std::int64_t timestamp_ns, double value);
+
+  /**
+   * @brief Adds the signal values of one decoded message.
+   *
+   * @param message The message, as found by FrameDecoder
+   * @param timestamp_ns Time of the frame
+   * @param values message.signal_count values, as decoded by SignalDecoder
+   */
+  void AddMessage(const decoder::FrameDecoder::MessageEntry& message, std::int64_t timestamp_ns,
+                  const double* values) {
+    for (std::uint32_t i = 0; i < message.signal_count; ++i) {
+      Add(message.message->first_signal + i, timestamp_ns, values[i]);
+    }
+  }
+
+  /**
+   * @brief Closes every window that ends at or before timestamp_ns, e.g.
+   *        the time of the latest frame, and emits the closed windows.
+   *
+   * Signals that stopped sending otherwise keep their last window open.
+   */
+  void CloseBefore(std::int64_t timestamp_ns);
+
+  /**
+   * @brief Closes all windows and emits them.
+   */
+  void Finish();
+
+  [[nodiscard]] const std::vector<std::int64_t>& resolutions_ns() const noexcept { return options_.resolutions_ns; }
+  /// Whether a signal is aggregated with a mode
+  [[nodiscard]] bool is_enum(std::uint32_t signal_id) const noexcept {
+    return enum_ranges_[signal_id].size != 0;
+  }
+  /// Windows emitted so far
+  [[nodiscard]] std::uint64_t emitted() const noexcept { return emitted_; }
+
+ private:
+  struct OpenWindow {
+    std::int64_t start_ns = 0;
+    std::int64_t end_ns = 0;
+    std::uint64_t count = 0;  ///< 0 while no window is open
+    double first = 0.0;
+    double last = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+    double sum = 0.0;
+  };
+
+  /// The described values of an enum signal in enum_values_, and its
+  /// per-resolution counts in enum_counts_
+  struct EnumRange {
+    std::uint32_t values = 0;  ///< First described value
+    std::uint32_t size = 0;    ///< Number of described values, 0 for other signals
+    std::uint32_t counts = 0;  ///< First count of resolution 0
+  };
+
+  void Close(std::uint32_t signal_id, std::uint32_t resolution);
+  void Emit();
+
+  WindowCallback on_windows_;
+  WindowAggregatorOptions options_;
+  std::vector<OpenWindow> windows_;     ///< By signal ID, then resolution
+  std::vector<EnumRange> enum_ranges_;  ///< By signal ID
+  std::vector<double> enum_values_;     ///< Physical values, ascending per signal
+  std::vector<std::uint32_t> enum_counts_;
+  std::vector<SignalWindow> closed_;
+  std::uint64_t emitted_ = 0;
+};
+
+}  // namespace stats
+}  // namespace dbc_parser
+
+#endif  // DBC_PARSER_STATS_WINDOW_AGGREGATOR_H_
@@ -0,0 +1,140 @@
+#ifndef DBC_PARSER_STORAGE_BIT_STREAM_H_
+#define DBC_PARSER_STORAGE_BIT_STREAM_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace dbc_parser {
+namespace storage {
+
+/**
+ * @brief Appends bit fields, most significant bit first, to a byte buffer.
+ *
+ * Clear keeps the buffer's capacity, so a writer reused for every chunk of a
+ * column stops allocating once it has held its largest chunk.
+ */
+class BitWriter {
+ public:
+  /**
+   * @brief Appends the low count bits of bits.
+   *
+   * @param bits Field value; bits above count are ignored
+   * @param count Field width, 0..64
+   */
+  void Write(std::uint64_t bits, unsigned count) {
+    if (count > 32) {
+      Write(bits >> 32, count - 32);
+      bits &= 0xFFFFFFFFu;
+      count = 32;
+    }
+    if (count == 0) {
+      return;
+    }
+    // At most 7 + 32 bits are buffered here
+    buffer_ = (buffer_ << count) | (bits & (~std::uint64_t{0} >> (64 - count)));
+    buffered_ += count;
+    while (buffered_ >= 8) {
+      buffered_ -= 8;
+      bytes_.push_back(static_cast<std::uint8_t>(buffer_ >> buffered_));
+    }
+  }
+
+  /**
+   * @brief Pads the last byte with zero bits; call once after the last Write.
+   */
+  void Finish() {
+    if (buffered_ > 0) {
+      bytes_.push_back(static_cast<std::uint8_t>(buffer_ << (8 - buffered_)));
+      buffered_ = 0;
+    }
+  }
+
+  /**
+   * @brief Empties the writer, keeping its capacity.
+   */
+  void Clear() noexcept {
+    bytes_.clear();
+    buffer_ = 0;
+    buffered_ = 0;
+  }
+
+  /**
+   * @brief The written bytes; complete only after Finish.
+   */
+  [[nodiscard]] const std::vector<std::uint8_t>& bytes() const noexcept { return bytes_; }
+
+  /**
+   * @brief Bytes the written fields occupy, including a partial last byte.
+   */
+  [[nodiscard]] std::size_t size() const noexcept { return bytes_.size() + (buffered_ > 0 ? 1 : 0); }
+
+ private:
+  std::vector<std::uint8_t> bytes_;
+  std::uint64_t buffer_ = 0;
+  unsigned buffered_ = 0;
+};
+
+/**
+ * @brief Reads the bit fields of a BitWriter back.
+ *
+ * Reads past the end return zero bits and set overrun(), so decoders check
+ * once after a chunk instead of before every field.
+ */
+class BitReader {
+ public:
+  BitReader(const std::uint8_t* data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+  /**
+   * @brief Reads a field of count bits.
+   *
+   * @param count Field width, 0..64
+   */
+  std::uint64_t Read(unsigned count) noexcept {
+    if (count > 56) {
+      const std::uint64_t high = Read(count - 32);
+      return (high << 32) | Read(32);
+    }
+    if (count == 0) {
+      return 0;
+    }
+    const std::uint64_t word = Load(position_ >> 3) << (position_ & 7);
+    position_ += count;
+    if (position_ > size_ * 8) {
+      overrun_ = true;
+    }
+    return word >> (64 - count);
+  }
+
+  bool ReadBit() noexcept { return Read(1) != 0; }
+
+  /**
+   * @brief Whether a read went past the end of the data.
+   */
+  [[nodiscard]] bool overrun() const noexcept { return overrun_; }
+
+ private:
+  // The 8 bytes at byte, big-endian, zero past the end
+  std::uint64_t Load(std::size_t byte) const noexcept {
+    std::uint8_t bytes[8] = {};
+    if (byte < size_) {
+      std::memcpy(bytes, data_ + byte, size_ - byte < 8 ? size_ - byte : 8);
+    }
+    std::uint64_t word = 0;
+    for (const std::uint8_t b : bytes) {
+      word = (word << 8) | b;
+    }
+    return word;
+  }
+
+  const std::uint8_t* data_;
+  std::size_t size_;
+  std::size_t position_ = 0;
+  bool overrun_ = false;
+};
+
+}  // namespace storage
+}  // namespace dbc_parser
+
+#endif  // DBC_PARSER_STORAGE_BIT_STREAM_H_
@@ -0,0 +1,151 @@
+#include "dbc_parser/storage/column_codec.h"
+
+#include <cstring>
+
+namespace dbc_parser {
+namespace storage {
+namespace {
+
+// x != 0
+unsigned CountLeadingZeros(std::uint64_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<unsigned>(__builtin_clzll(x));
+#else
+  unsigned count = 0;
+  for (std::uint64_t bit = std::uint64_t{1} << 63; (x & bit) == 0; bit >>= 1) {
+    ++count;
+  }
+  return count;
+#endif
+}
+
+// x != 0
+unsigned CountTrailingZeros(std::uint64_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<unsigned>(__builtin_ctzll(x));
+#else
+  unsigned count = 0;
+  for (; (x & 1) == 0; x >>= 1) {
+    ++count;
+  }
+  return count;
+#endif
+}
+
+// Differences wrap instead of overflowing, the decoder wraps them back
+std::int64_t Subtract(std::int64_t a, std::int64_t b) noexcept {
+  return static_cast<std::int64_t>(static_cast<std::uint64_t>(a) - static_cast<std::uint64_t>(b));
+}
+
+std::int64_t Add(std::int64_t a, std::int64_t b) noexcept {
+  return static_cast<std::int64_t>(static_cast<std::uint64_t>(a) + static_cast<std::uint64_t>(b));
+}
+
+std::uint64_t ZigZag(std::int64_t value) noexcept {
+  return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+std::int64_t UnZigZag(std::uint64_t value) noexcept {
+  return static_cast<std::int64_t>((value >> 1) ^ (~(value & 1) + 1));
+}
+
+// Leading zeros beyond this are stored as meaningful bits, so the count
+// fits 5 bits
+constexpr unsigned kMaxLeading = 31;
+
+}  // namespace
+
+void TimestampEncoder::Add(std::int64_t timestamp_ns, BitWriter& out) {
+  const std::int64_t delta = Subtract(timestamp_ns, previous_ns_);
+  const std::uint64_t zigzag = ZigZag(Subtract(delta, previous_delta_));
+  previous_ns_ = timestamp_ns;
+  previous_delta_ = delta;
+  if (zigzag == 0) {
+    out.Write(0b0, 1);
+  } else if (zigzag < (std::uint64_t{1} << 14)) {
+    out.Write(0b10, 2);
+    out.Write(zigzag, 14);
+  } else if (zigzag < (std::uint64_t{1} << 20)) {
+    out.Write(0b110, 3);
+    out.Write(zigzag, 20);
+  } else if (zigzag < (std::uint64_t{1} << 32)) {
+    out.Write(0b1110, 4);
+    out.Write(zigzag, 32);
+  } else {
+    out.Write(0b1111, 4);
+    out.Write(zigzag, 64);
+  }
+}
+
+std::int64_t TimestampDecoder::Next(BitReader& in) noexcept {
+  unsigned width = 0;
+  if (in.ReadBit()) {
+    if (!in.ReadBit()) {
+      width = 14;
+    } else if (!in.ReadBit()) {
+      width = 20;
+    } else {
+      width = in.ReadBit() ? 64 : 32;
+    }
+  }
+  previous_delta_ = Add(previous_delta_, UnZigZag(in.Read(width)));
+  previous_ns_ = Add(previous_ns_, previous_delta_);
+  return previous_ns_;
+}
+
+void ValueEncoder::Add(double value, BitWriter& out) {
+  std::uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  if (!started_) {
+    started_ = true;
+    previous_bits_ = bits;
+    out.Write(bits, 64);
+    return;
+  }
+  const std::uint64_t xored = bits ^ previous_bits_;
+  previous_bits_ = bits;
+  if (xored == 0) {
+    out.Write(0b0, 1);
+    return;
+  }
+  unsigned leading = CountLeadingZeros(xored);
+  const unsigned trailing = CountTrailingZeros(xored);
+  if (leading > kMaxLeading) {
+    leading = kMaxLeading;
+  }
+  if (has_window_ && leading >= leading_ && trailing >= trailing_) {
+    out.Write(0b10, 2);
+    out.Write(xored >> trailing_, 64 - leading_ - trailing_);
+    return;
+  }
+  has_window_ = true;
+  leading_ = leading;
+  trailing_ = trailing;
+  const unsigned meaningful = 64 - leading - trailing;
+  out.Write(0b11, 2);
+  out.Write(leading, 5);
+  out.Write(meaningful - 1, 6);
+  out.Write(xored >> trailing, meaningful);
+}
+
+double ValueDecoder::Next(BitReader& in) noexcept {
+  if (!started_) {
+    started_ = true;
+    previous_bits_ = in.Read(64);
+  } else if (in.ReadBit()) {
+    if (in.ReadBit()) {
+      leading_ = static_cast<unsigned>(in.Read(5));
+      const unsigned meaningful = static_cast<unsigned>(in.Read(6)) + 1;
+      // A corrupt window would shift by 64 or more
+      trailing_ = meaningful + leading_ <= 64 ? 64 - leading_ - meaningful : 0;
+    }
+    const unsigned meaningful = 64 - leading_ - trailing_;
+    previous_bits_ ^= in.Read(meaningful) << trailing_;
+  }
+  double value;
+  std::memcpy(&value, &previous_bits_, sizeof(value));
+  return value;
+}
+
+}  // namespace storage
+}  // namespace dbc_parser
@@ -0,0 +1,102 @@
+#ifndef DBC_PARSER_STORAGE_COLUMN_CODEC_H_
+#define DBC_PARSER_STORAGE_COLUMN_CODEC_H_
+
+#include <cstdint>
+
+#include "dbc_parser/storage/bit_stream.h"
+
+namespace dbc_parser {
+namespace storage {
+
+/**
+ * @brief Delta-of-delta encoding of a timestamp column.
+ *
+ * The first timestamp of a chunk is kept in the chunk index, not in the
+ * column. Each later timestamp is written as the change of the delta to its
+ * predecessor, zigzag-encoded, with a prefix that selects the width:
+ *
+ *     0                  unchanged delta
+ *     10   + 14 bits     within 8 us of the previous delta
+ *     110  + 20 bits     within 0.5 ms
+ *     1110 + 32 bits     within 2 s
+ *     1111 + 64 bits     anything else
+ *
+ * The widths suit nanosecond timestamps of periodic messages: a fixed cycle
+ * costs one bit, the microsecond jitter of a real bus up to 23.
+ */
+class TimestampEncoder {
+ public:
+  /**
+   * @brief Starts a chunk at its first timestamp, which is not written.
+   */
+  void Start(std::int64_t first_ns) noexcept {
+    previous_ns_ = first_ns;
+    previous_delta_ = 0;
+  }
+
+  void Add(std::int64_t timestamp_ns, BitWriter& out);
+
+ private:
+  std::int64_t previous_ns_ = 0;
+  std::int64_t previous_delta_ = 0;
+};
+
+/**
+ * @brief Reads a column of TimestampEncoder.
+ */
+class TimestampDecoder {
+ public:
+  explicit TimestampDecoder(std::int64_t first_ns) noexcept : previous_ns_(first_ns) {}
+
+  std::int64_t Next(BitReader& in) noexcept;
+
+ private:
+  std::int64_t previous_ns_;
+  std::int64_t previous_delta_ = 0;
+};
+
+/**
+ * @brief Gorilla XOR encoding of a column of doubles.
+ *
+ * The first value is written as its 64 bits. Each later value is XORed with
+ * its predecessor: an equal value costs one bit, '0'. Otherwise '10' writes
+ * the meaningful bits of the XOR inside the window of leading and trailing
+ * zeros of the last '11', and '11' opens a new window with 5 bits of leading
+ * zeros and 6 bits of length. Signals scaled from small integers repeat
+ * values and change few bits, so most samples take 1 to 20 bits.
+ */
+class ValueEncoder {
+ public:
+  void Add(double value, BitWriter& out);
+
+  /**
+   * @brief Starts a new chunk.
+   */
+  void Reset() noexcept { *this = ValueEncoder(); }
+
+ private:
+  std::uint64_t previous_bits_ = 0;
+  unsigned leading_ = 0;
+  unsigned trailing_ = 0;
+  bool started_ = false;
+  bool has_window_ = false;
+};
+
+/**
+ * @brief Reads a column of ValueEncoder.
+ */
+class ValueDecoder {
+ public:
+  double Next(BitReader& in) noexcept;
+
+ private:
+  std::uint64_t previous_bits_ = 0;
+  unsigned leading_ = 0;
+  unsigned trailing_ = 0;
+  bool started_ = false;
+};
+
+}  // namespace storage
+}  // namespace dbc_parser
+
+#endif  // DBC_PARSER_STORAGE_COLUMN_CODEC_H_
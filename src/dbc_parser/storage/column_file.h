@@ -0,0 +1,76 @@
+#ifndef DBC_PARSER_STORAGE_COLUMN_FILE_H_
+#define DBC_PARSER_STORAGE_COLUMN_FILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace dbc_parser {
+namespace storage {
+
+/**
+ * @brief Layout of a column file, the columnar store of decoded signals.
+ *
+ * All integers are little-endian, strings are a u32 length and the bytes.
+ *
+ *     magic                      "DBCCOLS1"
+ *     chunk bodies               timestamp column, then value column
+ *     footer
+ *       u32 signal count, per signal:
+ *         u32 signal ID, u32 message ID, name, unit,
+ *         f64 factor, offset, minimum, maximum,
+ *         u32 value description count, per description: i64 value, text
+ *       u64 chunk count, per chunk:
+ *         u64 offset, u32 signal ID, u32 sample count,
+ *         i64 first, min and max timestamp, f64 min and max value,
+ *         u32 timestamp column bytes, u32 value column bytes
+ *     u64 footer offset
+ *     magic                      "DBCCOLS1"
+ *
+ * A chunk holds consecutive samples of one signal; see TimestampEncoder and
+ * ValueEncoder for its columns. The footer lists the chunks of each signal
+ * in write order, so a reader finds every chunk of one signal without
+ * touching the bodies of the others.
+ */
+struct ColumnFile {
+  static constexpr char kMagic[8] = {'D', 'B', 'C', 'C', 'O', 'L', 'S', '1'};
+  static constexpr std::size_t kMagicSize = sizeof(kMagic);
+};
+
+/**
+ * @brief A signal stored in a column file, with the metadata of its DBC
+ *        definition.
+ */
+struct ColumnSignal {
+  std::uint32_t signal_id = 0;   ///< Signal ID in the DbcFile the file was written with
+  std::uint32_t message_id = 0;  ///< DBC ID of its message (bit 31 set for extended IDs)
+  std::string name;              ///< Signal name
+  std::string unit;              ///< Unit
+  double factor = 1.0;           ///< Scaling factor of the raw value
+  double offset = 0.0;           ///< Offset of the raw value
+  double minimum = 0.0;          ///< Minimum physical value
+  double maximum = 0.0;          ///< Maximum physical value
+  std::map<std::int64_t, std::string> value_descriptions;  ///< VAL_ texts by raw value
+};
+
+/**
+ * @brief Index entry of one chunk.
+ */
+struct ColumnChunk {
+  std::uint64_t offset = 0;           ///< File offset of the timestamp column
+  std::uint32_t signal_id = 0;        ///< Signal of the samples
+  std::uint32_t count = 0;            ///< Samples in the chunk
+  std::int64_t first_ns = 0;          ///< Timestamp of the first sample
+  std::int64_t min_ns = 0;            ///< Earliest timestamp
+  std::int64_t max_ns = 0;            ///< Latest timestamp
+  double min_value = 0.0;             ///< Smallest value, NaN if all values are NaN
+  double max_value = 0.0;             ///< Largest value, NaN if all values are NaN
+  std::uint32_t timestamp_bytes = 0;  ///< Size of the timestamp column
+  std::uint32_t value_bytes = 0;      ///< Size of the value column, which follows it
+};
+
+}  // namespace storage
+}  // namespace dbc_parser
+
+#endif  // DBC_PARSER_STORAGE_COLUMN_FILE_H_
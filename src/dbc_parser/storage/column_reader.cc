@@ -0,0 +1,246 @@
+#include "dbc_parser/storage/column_reader.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "dbc_parser/storage/bit_stream.h"
+#include "dbc_parser/storage/column_codec.h"
+
+namespace dbc_parser {
+namespace storage {
+namespace {
+
+// Bounds-checked little-endian reads of the footer; a read past the end
+// clears ok and returns zero
+struct Cursor {
+  const char* data;
+  std::size_t size;
+  std::size_t position = 0;
+  bool ok = true;
+
+  std::uint64_t Read(std::size_t bytes) {
+    if (!ok || size - position < bytes) {
+      ok = false;
+      return 0;
+    }
+    std::uint64_t value = 0;
+    for (std::size_t i = 0; i < bytes; ++i) {
+      value |= std::uint64_t{static_cast<std::uint8_t>(data[position + i])} << (8 * i);
+    }
+    position += bytes;
+    return value;
+  }
+
+  std::uint32_t U32() { return static_cast<std::uint32_t>(Read(4)); }
+  std::uint64_t U64() { return Read(8); }
+  std::int64_t I64() { return static_cast<std::int64_t>(Read(8)); }
+
+  double F64() {
+    const std::uint64_t bits = Read(8);
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  std::string String() {
+    const std::uint32_t length = U32();
+    if (!ok || size - position < length) {
+      ok = false;
+      return {};
+    }
+    std::string value(data + position, length);
+    position += length;
+    return value;
+  }
+
+  [[nodiscard]] std::size_t remaining() const noexcept { return size - position; }
+};
+
+// Smallest encodings, to bound counts before reserving
+constexpr std::size_t kMinSignalBytes = 4 + 4 + 4 + 4 + 4 * 8 + 4;
+constexpr std::size_t kChunkBytes = 8 + 4 + 4 + 3 * 8 + 2 * 8 + 4 + 4;
+
+}  // namespace
+
+std::optional<ColumnReader> ColumnReader::Open(std::string_view contents) {
+  ColumnReader reader;
+  reader.contents_ = contents;
+  if (!reader.ParseFooter()) {
+    return std::nullopt;
+  }
+  return reader;
+}
+
+std::optional<ColumnReader> ColumnReader::OpenFile(const std::string& path) {
+  auto file = core::MappedFile::Open(path);
+  if (!file) {
+    return std::nullopt;
+  }
+  ColumnReader reader;
+  reader.file_ = std::move(file);
+  // The mapping does not move with the MappedFile
+  reader.contents_ = reader.file_->contents();
+  if (!reader.ParseFooter()) {
+    return std::nullopt;
+  }
+  return reader;
+}
+
+bool ColumnReader::ParseFooter() {
+  constexpr std::size_t kMagicSize = ColumnFile::kMagicSize;
+  if (contents_.size() < 2 * kMagicSize + 8 || contents_.compare(0, kMagicSize, ColumnFile::kMagic, kMagicSize) != 0 ||
+      contents_.compare(contents_.size() - kMagicSize, kMagicSize, ColumnFile::kMagic, kMagicSize) != 0) {
+    return false;
+  }
+  const std::size_t footer_end = contents_.size() - kMagicSize - 8;
+  Cursor trailer{contents_.data() + footer_end, 8};
+  const std::uint64_t footer_offset = trailer.U64();
+  if (footer_offset < kMagicSize || footer_offset > footer_end) {
+    return false;
+  }
+
+  Cursor footer{contents_.data() + footer_offset, footer_end - footer_offset};
+  const std::uint32_t signal_count = footer.U32();
+  if (signal_count > footer.remaining() / kMinSignalBytes) {
+    return false;
+  }
+  signals_.resize(signal_count);
+  for (ColumnSignal& signal : signals_) {
+    signal.signal_id = footer.U32();
+    signal.message_id = footer.U32();
+    signal.name = footer.String();
+    signal.unit = footer.String();
+    signal.factor = footer.F64();
+    signal.offset = footer.F64();
+    signal.minimum = footer.F64();
+    signal.maximum = footer.F64();
+    const std::uint32_t description_count = footer.U32();
+    for (std::uint32_t i = 0; i < description_count && footer.ok; ++i) {
+      const std::int64_t value = footer.I64();
+      signal.value_descriptions[value] = footer.String();
+    }
+  }
+  std::sort(signals_.begin(), signals_.end(),
+            [](const ColumnSignal& a, const ColumnSignal& b) { return a.signal_id < b.signal_id; });
+
+  const std::uint64_t chunk_count = footer.U64();
+  if (!footer.ok || chunk_count > footer.remaining() / kChunkBytes) {
+    return false;
+  }
+  chunks_.resize(chunk_count);
+  for (ColumnChunk& chunk : chunks_) {
+    chunk.offset = footer.U64();
+    chunk.signal_id = footer.U32();
+    chunk.count = footer.U32();
+    chunk.first_ns = footer.I64();
+    chunk.min_ns = footer.I64();
+    chunk.max_ns = footer.I64();
+    chunk.min_value = footer.F64();
+    chunk.max_value = footer.F64();
+    chunk.timestamp_bytes = footer.U32();
+    chunk.value_bytes = footer.U32();
+    if (chunk.count == 0 || chunk.offset < kMagicSize || chunk.offset > footer_offset ||
+        footer_offset - chunk.offset < std::uint64_t{chunk.timestamp_bytes} + chunk.value_bytes) {
+      return false;
+    }
+    // Every sample after the first takes at least one bit of each column,
+    // and the first value 64 bits; Scan sizes its buffers by count
+    if (chunk.count - 1 > std::uint64_t{8} * chunk.timestamp_bytes ||
+        std::uint64_t{64} + (chunk.count - 1) > std::uint64_t{8} * chunk.value_bytes) {
+      return false;
+    }
+  }
+  if (!footer.ok) {
+    return false;
+  }
+
+  std::stable_sort(chunks_.begin(), chunks_.end(),
+                   [](const ColumnChunk& a, const ColumnChunk& b) { return a.signal_id < b.signal_id; });
+  for (std::size_t begin = 0; begin < chunks_.size();) {
+    std::size_t end = begin;
+    while (end < chunks_.size() && chunks_[end].signal_id == chunks_[begin].signal_id) {
+      ++end;
+    }
+    chunk_ranges_.emplace(chunks_[begin].signal_id, std::make_pair(begin, end));
+    begin = end;
+  }
+  return true;
+}
+
+const ColumnSignal* ColumnReader::FindSignal(std::uint32_t signal_id) const noexcept {
+  auto it = std::lower_bound(signals_.begin(), signals_.end(), signal_id,
+                             [](const ColumnSignal& signal, std::uint32_t id) { return signal.signal_id < id; });
+  return it != signals_.end() && it->signal_id == signal_id ? &*it : nullptr;
+}
+
+const ColumnSignal* ColumnReader::FindSignal(std::string_view name,
+                                             std::optional<std::uint32_t> message_id) const noexcept {
+  for (const ColumnSignal& signal : signals_) {
+    if (signal.name == name && (!message_id || signal.message_id == *message_id)) {
+      return &signal;
+    }
+  }
+  return nullptr;
+}
+
+std::vector<ColumnChunk> ColumnReader::ChunksOf(std::uint32_t signal_id) const {
+  auto it = chunk_ranges_.find(signal_id);
+  if (it == chunk_ranges_.end()) {
+    return {};
+  }
+  return std::vector<ColumnChunk>(chunks_.begin() + static_cast<std::ptrdiff_t>(it->second.first),
+                                  chunks_.begin() + static_cast<std::ptrdiff_t>(it->second.second));
+}
+
+std::optional<std::size_t> ColumnReader::Scan(std::uint32_t signal_id, const SampleCallback& on_samples,
+                                              std::int64_t from_ns, std::int64_t to_ns) const {
+  auto it = chunk_ranges_.find(signal_id);
+  if (it == chunk_ranges_.end()) {
+    return 0;
+  }
+  std::vector<std::int64_t> timestamps;
+  std::vector<double> values;
+  std::size_t delivered = 0;
+  for (std::size_t index = it->second.first; index < it->second.second; ++index) {
+    const ColumnChunk& chunk = chunks_[index];
+    if (chunk.max_ns < from_ns || chunk.min_ns > to_ns) {
+      continue;
+    }
+    const auto* base = reinterpret_cast<const std::uint8_t*>(contents_.data()) + chunk.offset;
+    BitReader timestamp_bits(base, chunk.timestamp_bytes);
+    BitReader value_bits(base + chunk.timestamp_bytes, chunk.value_bytes);
+    TimestampDecoder timestamp_decoder(chunk.first_ns);
+    ValueDecoder value_decoder;
+    timestamps.resize(chunk.count);
+    values.resize(chunk.count);
+    timestamps[0] = chunk.first_ns;
+    values[0] = value_decoder.Next(value_bits);
+    for (std::size_t i = 1; i < chunk.count; ++i) {
+      timestamps[i] = timestamp_decoder.Next(timestamp_bits);
+      values[i] = value_decoder.Next(value_bits);
+    }
+    if (timestamp_bits.overrun() || value_bits.overrun()) {
+      return std::nullopt;
+    }
+
+    std::size_t count = chunk.count;
+    if (chunk.min_ns < from_ns || chunk.max_ns > to_ns) {
+      count = 0;
+      for (std::size_t i = 0; i < chunk.count; ++i) {
+        if (timestamps[i] >= from_ns && timestamps[i] <= to_ns) {
+          timestamps[count] = timestamps[i];
+          values[count] = values[i];
+          ++count;
+        }
+      }
+    }
+    if (count > 0) {
+      on_samples(timestamps.data(), values.data(), count);
+      delivered += count;
+    }
+  }
+  return delivered;
+}
+
+}  // namespace storage
+}  // namespace dbc_parser
@@ -0,0 +1,110 @@
+#ifndef DBC_PARSER_STORAGE_COLUMN_READER_H_
+#define DBC_PARSER_STORAGE_COLUMN_READER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "dbc_parser/core/mapped_file.h"
+#include "dbc_parser/storage/column_file.h"
+
+namespace dbc_parser {
+namespace storage {
+
+/**
+ * @brief Reads a column file written by ColumnWriter.
+ *
+ * Opening reads the footer only. Scan decodes the chunks of one signal
+ * that overlap a time range and never touches the bytes of other signals or
+ * of chunks outside the range, so with a memory-mapped file the pages of
+ * everything else are never read. Scanning is const and may run from any
+ * number of threads.
+ */
+class ColumnReader {
+ public:
+  /// Receives a batch of samples in file order, valid during the call
+  using SampleCallback = std::function<void(const std::int64_t* timestamps_ns, const double* values,
+                                            std::size_t count)>;
+
+  /**
+   * @brief Opens a column file held in memory.
+   *
+   * @param contents The file; must outlive the reader
+   * @return std::optional<ColumnReader> The reader, or std::nullopt if the
+   *         contents are not a complete column file
+   */
+  [[nodiscard]] static std::optional<ColumnReader> Open(std::string_view contents);
+
+  /**
+   * @brief Memory-maps a column file and opens it.
+   *
+   * @return std::optional<ColumnReader> The reader, or std::nullopt if the
+   *         file cannot be mapped or is not a complete column file
+   */
+  [[nodiscard]] static std::optional<ColumnReader> OpenFile(const std::string& path);
+
+  /**
+   * @brief The signals that have samples, in signal ID order.
+   */
+  [[nodiscard]] const std::vector<ColumnSignal>& signals() const noexcept { return signals_; }
+
+  /**
+   * @brief Looks up a signal by its signal ID.
+   *
+   * @return const ColumnSignal* The signal, or nullptr if it has no samples
+   */
+  [[nodiscard]] const ColumnSignal* FindSignal(std::uint32_t signal_id) const noexcept;
+
+  /**
+   * @brief Looks up a signal by name.
+   *
+   * @param name Signal name
+   * @param message_id DBC ID of its message, for names that several messages
+   *        use; std::nullopt takes the first signal of that name
+   * @return const ColumnSignal* The signal, or nullptr if there is none
+   */
+  [[nodiscard]] const ColumnSignal* FindSignal(std::string_view name,
+                                               std::optional<std::uint32_t> message_id = std::nullopt) const noexcept;
+
+  /**
+   * @brief The index entries of one signal's chunks, in write order.
+   */
+  [[nodiscard]] std::vector<ColumnChunk> ChunksOf(std::uint32_t signal_id) const;
+
+  /**
+   * @brief Decodes the samples of one signal with from_ns <= time <= to_ns.
+   *
+   * @param signal_id Signal ID
+   * @param on_samples Receiver of the samples, one call per chunk that has any
+   * @param from_ns Start of the range
+   * @param to_ns End of the range
+   * @return std::optional<std::size_t> Samples delivered, or std::nullopt
+   *         if a chunk is corrupt; the samples before it were delivered
+   */
+  [[nodiscard]] std::optional<std::size_t> Scan(std::uint32_t signal_id, const SampleCallback& on_samples,
+                                                std::int64_t from_ns = std::numeric_limits<std::int64_t>::min(),
+                                                std::int64_t to_ns = std::numeric_limits<std::int64_t>::max()) const;
+
+ private:
+  ColumnReader() = default;
+
+  bool ParseFooter();
+
+  std::optional<core::MappedFile> file_;
+  std::string_view contents_;
+  std::vector<ColumnSignal> signals_;
+  std::vector<ColumnChunk> chunks_;  ///< Grouped by signal, in write order within each
+  std::unordered_map<std::uint32_t, std::pair<std::size_t, std::size_t>> chunk_ranges_;  ///< Signal ID to [begin, end)
+};
+
+}  // namespace storage
+}  // namespace dbc_parser
+
+#endif  // DBC_PARSER_STORAGE_COLUMN_READER_H_
@@ -0,0 +1,182 @@
+#include "dbc_parser/storage/column_writer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <string>
+#include <unordered_map>
+
+namespace dbc_parser {
+namespace storage {
+namespace {
+
+void PutU32(std::string& out, std::uint32_t value) {
+  for (int i = 0; i < 4; ++i) {
+    out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+  }
+}
+
+void PutU64(std::string& out, std::uint64_t value) {
+  for (int i = 0; i < 8; ++i) {
+    out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+  }
+}
+
+void PutI64(std::string& out, std::int64_t value) { PutU64(out, static_cast<std::uint64_t>(value)); }
+
+void PutF64(std::string& out, double value) {
+  std::uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  PutU64(out, bits);
+}
+
+void PutString(std::string& out, const std::string& value) {
+  PutU32(out, static_cast<std::uint32_t>(value.size()));
+  out += value;
+}
+
+}  // namespace
+
+ColumnWriter::ColumnWriter(std::ostream& out, const parser::DbcFile& dbc_file, ColumnWriterOptions options)
+    : out_(out), dbc_file_(dbc_file), options_(options), columns_(dbc_file.signal_layouts.size()) {
+  if (options_.chunk_samples == 0) {
+    options_.chunk_samples = 1;
+  }
+  Write(ColumnFile::kMagic, ColumnFile::kMagicSize);
+}
+
+void ColumnWriter::Add(std::uint32_t signal_id, std::int64_t timestamp_ns, double value) {
+  if (signal_id >= columns_.size() || finished_) {
+    return;
+  }
+  Column& column = columns_[signal_id];
+  ColumnChunk& chunk = column.chunk;
+  if (chunk.count == 0) {
+    chunk.first_ns = chunk.min_ns = chunk.max_ns = timestamp_ns;
+    chunk.min_value = chunk.max_value = std::numeric_limits<double>::quiet_NaN();
+    column.timestamp_encoder.Start(timestamp_ns);
+  } else {
+    column.timestamp_encoder.Add(timestamp_ns, column.timestamps);
+    chunk.min_ns = std::min(chunk.min_ns, timestamp_ns);
+    chunk.max_ns = std::max(chunk.max_ns, timestamp_ns);
+  }
+  column.value_encoder.Add(value, column.values);
+  // fmin and fmax skip NaN
+  chunk.min_value = std::fmin(chunk.min_value, value);
+  chunk.max_value = std::fmax(chunk.max_value, value);
+  ++stats_.samples;
+  if (++chunk.count == options_.chunk_samples) {
+    Flush(signal_id, column);
+  }
+}
+
+void ColumnWriter::AddMessage(const decoder::FrameDecoder::MessageEntry& message, std::int64_t timestamp_ns,
+                              const double* values) {
+  const std::uint32_t first_signal = message.message->first_signal;
+  for (std::uint32_t i = 0; i < message.signal_count; ++i) {
+    if (!std::isnan(values[i])) {
+      Add(first_signal + i, timestamp_ns, values[i]);
+    }
+  }
+}
+
+void ColumnWriter::Flush(std::uint32_t signal_id, Column& column) {
+  column.timestamps.Finish();
+  column.values.Finish();
+  ColumnChunk& chunk = column.chunk;
+  chunk.offset = stats_.bytes;
+  chunk.signal_id = signal_id;
+  chunk.timestamp_bytes = static_cast<std::uint32_t>(column.timestamps.bytes().size());
+  chunk.value_bytes = static_cast<std::uint32_t>(column.values.bytes().size());
+  Write(reinterpret_cast<const char*>(column.timestamps.bytes().data()), chunk.timestamp_bytes);
+  Write(reinterpret_cast<const char*>(column.values.bytes().data()), chunk.value_bytes);
+  chunks_.push_back(chunk);
+  ++stats_.chunks;
+
+  column.written = true;
+  column.timestamps.Clear();
+  column.values.Clear();
+  column.value_encoder.Reset();
+  chunk = ColumnChunk();
+}
+
+bool ColumnWriter::Finish() {
+  if (finished_) {
+    return static_cast<bool>(out_);
+  }
+  for (std::uint32_t signal_id = 0; signal_id < columns_.size(); ++signal_id) {
+    if (columns_[signal_id].chunk.count > 0) {
+      Flush(signal_id, columns_[signal_id]);
+    }
+  }
+  finished_ = true;
+
+  std::unordered_map<std::uint32_t, const std::map<int, std::string>*> descriptions;
+  for (const auto& description : dbc_file_.value_descriptions) {
+    if (description.type != parser::ValueDescriptionType::SIGNAL) {
+      continue;
+    }
+    const auto signal_id = dbc_file_.FindSignal(description.message_id, description.signal_name);
+    if (signal_id && *signal_id < columns_.size() && columns_[*signal_id].written) {
+      descriptions.emplace(*signal_id, &description.values);
+    }
+  }
+
+  std::string footer;
+  std::uint32_t signal_count = 0;
+  for (const Column& column : columns_) {
+    signal_count += column.written ? 1 : 0;
+  }
+  PutU32(footer, signal_count);
+  for (std::uint32_t signal_id = 0; signal_id < columns_.size(); ++signal_id) {
+    if (!columns_[signal_id].written) {
+      continue;
+    }
+    const parser::SignalLayout& layout = dbc_file_.signal_layouts[signal_id];
+    const parser::SignalInfo& info = dbc_file_.signal_infos[signal_id];
+    PutU32(footer, signal_id);
+    PutU32(footer, static_cast<std::uint32_t>(info.message_id));
+    PutString(footer, info.name);
+    PutString(footer, info.unit);
+    PutF64(footer, layout.factor);
+    PutF64(footer, layout.offset);
+    PutF64(footer, layout.minimum);
+    PutF64(footer, layout.maximum);
+    auto it = descriptions.find(signal_id);
+    PutU32(footer, it == descriptions.end() ? 0 : static_cast<std::uint32_t>(it->second->size()));
+    if (it != descriptions.end()) {
+      for (const auto& [value, text] : *it->second) {
+        PutI64(footer, value);
+        PutString(footer, text);
+      }
+    }
+  }
+  PutU64(footer, chunks_.size());
+  for (const ColumnChunk& chunk : chunks_) {
+    PutU64(footer, chunk.offset);
+    PutU32(footer, chunk.signal_id);
+    PutU32(footer, chunk.count);
+    PutI64(footer, chunk.first_ns);
+    PutI64(footer, chunk.min_ns);
+    PutI64(footer, chunk.max_ns);
+    PutF64(footer, chunk.min_value);
+    PutF64(footer, chunk.max_value);
+    PutU32(footer, chunk.timestamp_bytes);
+    PutU32(footer, chunk.value_bytes);
+  }
+  PutU64(footer, stats_.bytes);
+  footer.append(ColumnFile::kMagic, ColumnFile::kMagicSize);
+  Write(footer.data(), footer.size());
+  out_.flush();
+  return static_cast<bool>(out_);
+}
+
+void ColumnWriter::Write(const char* data, std::size_t size) {
+  out_.write(data, static_cast<std::streamsize>(size));
+  stats_.bytes += size;
+}
+
+}  // namespace storage
+}  // namespace dbc_parser
@@ -0,0 +1,118 @@
+#ifndef DBC_PARSER_STORAGE_COLUMN_WRITER_H_
+#define DBC_PARSER_STORAGE_COLUMN_WRITER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "dbc_parser/decoder/frame_decoder.h"
+#include "dbc_parser/parser/dbc_file_parser.h"
+#include "dbc_parser/storage/bit_stream.h"
+#include "dbc_parser/storage/column_codec.h"
+#include "dbc_parser/storage/column_file.h"
+
+namespace dbc_parser {
+namespace storage {
+
+/**
+ * @brief Tuning of ColumnWriter.
+ */
+struct ColumnWriterOptions {
+  /// Samples per chunk. Smaller chunks let time range scans skip more,
+  /// larger ones shrink the footer.
+  std::uint32_t chunk_samples = 8192;
+};
+
+/**
+ * @brief Counters of one ColumnWriter.
+ */
+struct ColumnWriteStats {
+  std::uint64_t samples = 0;  ///< Samples added
+  std::uint64_t chunks = 0;   ///< Chunks written
+  std::uint64_t bytes = 0;    ///< Bytes written, footer included once finished
+};
+
+/**
+ * @brief Writes decoded samples to a column file; see ColumnFile.
+ *
+ * Every signal of the DbcFile has an open chunk, encoded as samples arrive,
+ * so the writer holds a few compressed bytes per sample of the open chunks
+ * and nothing of the chunks already written. A chunk is written when it
+ * reaches chunk_samples; Finish writes the rest and the footer, with the
+ * name, unit, scaling, range and value descriptions of every signal that
+ * has samples.
+ *
+ * Not thread-safe. Samples of one signal should arrive in timestamp order,
+ * as LogDecoder delivers them; out-of-order samples are stored, just less
+ * compactly.
+ */
+class ColumnWriter {
+ public:
+  /**
+   * @brief Starts a column file.
+   *
+   * @param out Binary output stream; must outlive the writer
+   * @param dbc_file File the samples were decoded with; must outlive the writer
+   * @param options Chunk size
+   */
+  ColumnWriter(std::ostream& out, const parser::DbcFile& dbc_file, ColumnWriterOptions options = {});
+
+  ColumnWriter(const ColumnWriter&) = delete;
+  ColumnWriter& operator=(const ColumnWriter&) = delete;
+
+  /**
+   * @brief Adds one sample.
+   *
+   * @param signal_id Signal ID in the DbcFile
+   * @param timestamp_ns Sample time
+   * @param value Physical value
+   */
+  void Add(std::uint32_t signal_id, std::int64_t timestamp_ns, double value);
+
+  /**
+   * @brief Adds the values of a decoded message, skipping NaN (signals that
+   *        did not produce a value).
+   *
+   * @param message The message, e.g. DecodedFrame::message
+   * @param timestamp_ns Frame time
+   * @param values message.signal_count values
+   */
+  void AddMessage(const decoder::FrameDecoder::MessageEntry& message, std::int64_t timestamp_ns,
+                  const double* values);
+
+  /**
+   * @brief Writes the open chunks and the footer.
+   *
+   * @return bool false if writing to the stream failed at any point
+   */
+  bool Finish();
+
+  [[nodiscard]] const ColumnWriteStats& stats() const noexcept { return stats_; }
+
+ private:
+  struct Column {
+    BitWriter timestamps;
+    BitWriter values;
+    TimestampEncoder timestamp_encoder;
+    ValueEncoder value_encoder;
+    ColumnChunk chunk;
+    bool written = false;  ///< Has samples in the file
+  };
+
+  void Flush(std::uint32_t signal_id, Column& column);
+  void Write(const char* data, std::size_t size);
+
+  std::ostream& out_;
+  const parser::DbcFile& dbc_file_;
+  ColumnWriterOptions options_;
+  std::vector<Column> columns_;  ///< Indexed by signal ID
+  std::vector<ColumnChunk> chunks_;
+  ColumnWriteStats stats_;
+  bool finished_ = false;
+};
+
+}  // namespace storage
+}  // namespace dbc_parser
+
+#endif  // DBC_PARSER_STORAGE_COLUMN_WRITER_H_
@@ -0,0 +1,559 @@
+#include "dbc_parser/storage/log_index.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <unordered_map>
+
+#include "dbc_parser/core/trace.h"
+#include "dbc_parser/decoder/asc_parser.h"
+#include "dbc_parser/decoder/asc_reader.h"
+#include "dbc_parser/decoder/blf_reader.h"
+#include "dbc_parser/decoder/candump_parser.h"
+
+namespace dbc_parser {
+namespace storage {
+namespace {
+
+using decoder::CanFrame;
+using decoder::DecodedFrame;
+using decoder::FrameDecoder;
+using decoder::LogChunk;
+using decoder::LogDecodeOptions;
+using decoder::LogDecodeStats;
+
+constexpr const char* kTraceCategory = "storage";
+
+constexpr std::size_t kHeaderSize = 64;
+constexpr std::size_t kBlockSize = 48;
+constexpr std::size_t kBucketSize = 16;
+constexpr std::uint32_t kNoOrdinal = 0xFFFFFFFFu;
+constexpr std::uint32_t kStandardIds = 0x800;
+
+std::uint64_t Load(const char* data, std::size_t bytes) noexcept {
+  std::uint64_t value = 0;
+  for (std::size_t i = 0; i < bytes; ++i) {
+    value |= std::uint64_t{static_cast<std::uint8_t>(data[i])} << (8 * i);
+  }
+  return value;
+}
+
+std::uint32_t LoadU32(const char* data) noexcept { return static_cast<std::uint32_t>(Load(data, 4)); }
+std::uint64_t LoadU64(const char* data) noexcept { return Load(data, 8); }
+std::int64_t LoadI64(const char* data) noexcept { return static_cast<std::int64_t>(Load(data, 8)); }
+
+void Put(std::string& out, std::uint64_t value, std::size_t bytes) {
+  for (std::size_t i = 0; i < bytes; ++i) {
+    out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+  }
+}
+
+std::size_t PaddedIdBytes(std::size_t id_count) noexcept { return (id_count * 4 + 7) / 8 * 8; }
+
+// Rounds towards negative infinity, so buckets before the epoch or the
+// start of a measurement are as wide as the others
+std::int64_t FloorDiv(std::int64_t value, std::int64_t divisor) noexcept {
+  const std::int64_t quotient = value / divisor;
+  return quotient * divisor > value ? quotient - 1 : quotient;
+}
+
+// Collects blocks, buckets and IDs from the chunks of a full decode
+class IndexBuilder {
+ public:
+  explicit IndexBuilder(std::int64_t bucket_ns) : bucket_ns_(bucket_ns), standard_ordinals_(kStandardIds, kNoOrdinal) {}
+
+  void Add(const LogChunk& chunk) {
+    LogBlock block;
+    block.offset = chunk.offset;
+    block.size = chunk.size;
+    block.base_ns = chunk.base_ns;
+    block.min_ns = std::numeric_limits<std::int64_t>::max();
+    block.max_ns = std::numeric_limits<std::int64_t>::min();
+    block.frames = chunk.frame_count;
+    const auto block_index = static_cast<std::uint32_t>(blocks_.size());
+
+    // Frames of a block mostly fall into one or two buckets
+    std::int64_t bucket_number = 0;
+    Bucket* bucket = nullptr;
+    for (std::size_t i = 0; i < chunk.frame_count; ++i) {
+      const CanFrame& frame = chunk.frames[i];
+      block.min_ns = std::min(block.min_ns, frame.timestamp_ns);
+      block.max_ns = std::max(block.max_ns, frame.timestamp_ns);
+      const std::int64_t number = FloorDiv(frame.timestamp_ns, bucket_ns_);
+      if (bucket == nullptr || number != bucket_number) {
+        const auto [it, inserted] = buckets_.try_emplace(number);
+        bucket = &it->second;
+        bucket_number = number;
+        if (inserted) {
+          bucket->first_block = block_index;
+        }
+        bucket->first_block = std::min(bucket->first_block, block_index);
+        bucket->last_block = std::max(bucket->last_block, block_index);
+      }
+      const std::uint32_t ordinal = OrdinalOf(frame.dbc_id());
+      if (bucket->bits.size() <= ordinal / 64) {
+        bucket->bits.resize(ordinal / 64 + 1);
+      }
+      bucket->bits[ordinal / 64] |= std::uint64_t{1} << (ordinal % 64);
+    }
+    frame_count_ += chunk.frame_count;
+    blocks_.push_back(block);
+  }
+
+  std::string Finish(LogFormat format, std::size_t log_size) const {
+    // Bitmap bits in ascending ID order
+    std::vector<std::uint32_t> sorted_ids = ids_;
+    std::sort(sorted_ids.begin(), sorted_ids.end());
+    std::vector<std::uint32_t> position(ids_.size());
+    for (std::uint32_t ordinal = 0; ordinal < ids_.size(); ++ordinal) {
+      position[ordinal] = static_cast<std::uint32_t>(
+          std::lower_bound(sorted_ids.begin(), sorted_ids.end(), ids_[ordinal]) - sorted_ids.begin());
+    }
+    const std::size_t words = (ids_.size() + 63) / 64;
+
+    std::string out;
+    out.reserve(kHeaderSize + PaddedIdBytes(ids_.size()) + blocks_.size() * kBlockSize +
+                buckets_.size() * (kBucketSize + words * 8));
+    out.append(LogIndex::kMagic, LogIndex::kMagicSize);
+    Put(out, static_cast<std::uint32_t>(format), 4);
+    Put(out, ids_.size(), 4);
+    Put(out, log_size, 8);
+    Put(out, static_cast<std::uint64_t>(bucket_ns_), 8);
+    Put(out, blocks_.size(), 8);
+    Put(out, buckets_.size(), 8);
+    Put(out, frame_count_, 8);
+    Put(out, words, 4);
+    Put(out, 0, 4);
+    for (const std::uint32_t id : sorted_ids) {
+      Put(out, id, 4);
+    }
+    out.resize(kHeaderSize + PaddedIdBytes(ids_.size()), '\0');
+    for (const LogBlock& block : blocks_) {
+      Put(out, block.offset, 8);
+      Put(out, block.size, 8);
+      Put(out, static_cast<std::uint64_t>(block.base_ns), 8);
+      Put(out, static_cast<std::uint64_t>(block.min_ns), 8);
+      Put(out, static_cast<std::uint64_t>(block.max_ns), 8);
+      Put(out, block.frames, 8);
+    }
+    for (const auto& [number, bucket] : buckets_) {
+      Put(out, static_cast<std::uint64_t>(number * bucket_ns_), 8);
+      Put(out, bucket.first_block, 4);
+      Put(out, bucket.last_block, 4);
+    }
+    std::vector<std::uint64_t> bits(words);
+    for (const auto& entry : buckets_) {
+      const Bucket& bucket = entry.second;
+      std::fill(bits.begin(), bits.end(), 0);
+      for (std::size_t word = 0; word < bucket.bits.size(); ++word) {
+        for (std::uint64_t rest = bucket.bits[word]; rest != 0; rest &= rest - 1) {
+          const std::uint32_t ordinal = static_cast<std::uint32_t>(word * 64) + CountTrailingZeros(rest);
+          bits[position[ordinal] / 64] |= std::uint64_t{1} << (position[ordinal] % 64);
+        }
+      }
+      for (const std::uint64_t word : bits) {
+        Put(out, word, 8);
+      }
+    }
+    return out;
+  }
+
+ private:
+  struct Bucket {
+    std::uint32_t first_block = 0;
+    std::uint32_t last_block = 0;
+    std::vector<std::uint64_t> bits;  ///< By ordinal
+  };
+
+  static std::uint32_t CountTrailingZeros(std::uint64_t value) noexcept {
+    std::uint32_t count = 0;
+    for (; (value & 1) == 0; value >>= 1) {
+      ++count;
+    }
+    return count;
+  }
+
+  // IDs get ordinals in order of appearance; standard IDs through a table
+  std::uint32_t OrdinalOf(std::uint32_t dbc_id) {
+    if (dbc_id < kStandardIds) {
+      std::uint32_t& ordinal = standard_ordinals_[dbc_id];
+      if (ordinal == kNoOrdinal) {
+        ordinal = static_cast<std::uint32_t>(ids_.size());
+        ids_.push_back(dbc_id);
+      }
+      return ordinal;
+    }
+    const auto [it, inserted] = other_ordinals_.try_emplace(dbc_id, static_cast<std::uint32_t>(ids_.size()));
+    if (inserted) {
+      ids_.push_back(dbc_id);
+    }
+    return it->second;
+  }
+
+  std::int64_t bucket_ns_;
+  std::vector<LogBlock> blocks_;
+  std::map<std::int64_t, Bucket> buckets_;  ///< By bucket number, start_ns / bucket_ns
+  std::vector<std::uint32_t> ids_;          ///< By ordinal
+  std::vector<std::uint32_t> standard_ordinals_;
+  std::unordered_map<std::uint32_t, std::uint32_t> other_ordinals_;
+  std::uint64_t frame_count_ = 0;
+};
+
+void AddRun(LogDecodeStats& total, const LogDecodeStats& run) noexcept {
+  total.bytes += run.bytes;
+  total.chunks += run.chunks;
+  total.lines += run.lines;
+  total.frames += run.frames;
+  total.malformed_lines += run.malformed_lines;
+  total.unknown_frames += run.unknown_frames;
+  total.signals += run.signals;
+  total.late_frames += run.late_frames;
+  total.threads = std::max(total.threads, run.threads);
+}
+
+}  // namespace
+
+LogFormat LogFormatOf(std::string_view path) noexcept {
+  const auto has_extension = [path](std::string_view extension) {
+    return path.size() >= extension.size() &&
+           path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+  };
+  if (has_extension(".blf")) {
+    return LogFormat::kBlf;
+  }
+  if (has_extension(".asc")) {
+    return LogFormat::kAsc;
+  }
+  return LogFormat::kCandump;
+}
+
+std::optional<std::string> LogIndex::Build(std::string_view log, LogFormat format, const LogIndexOptions& options) {
+  DBC_TRACE_SPAN(kTraceCategory, "LogIndex::Build");
+  // Without messages the readers only parse; the index holds every ID
+  const parser::DbcFile no_messages{};
+  const FrameDecoder decoder(no_messages);
+  IndexBuilder builder(std::max<std::int64_t>(options.bucket_ns, 1));
+  LogDecodeOptions decode_options;
+  decode_options.threads = options.threads;
+  decode_options.chunk_bytes = options.block_bytes;
+  decode_options.on_chunk = [&builder](const LogChunk& chunk) { builder.Add(chunk); };
+
+  switch (format) {
+    case LogFormat::kCandump:
+      (void)decoder::LogDecoder(decoder, &decoder::CandumpParser::ParseLine, decode_options).Decode(log);
+      break;
+    case LogFormat::kAsc:
+      (void)decoder::AscReader(decoder, decode_options).Decode(log);
+      break;
+    case LogFormat::kBlf:
+      if (!decoder::BlfReader(decoder, decode_options).Decode(log)) {
+        return std::nullopt;
+      }
+      break;
+  }
+  return builder.Finish(format, log.size());
+}
+
+bool LogIndex::BuildFile(const std::string& log_path, const std::string& index_path, const LogIndexOptions& options) {
+  std::optional<core::MappedFile> log = core::MappedFile::Open(log_path);
+  if (!log) {
+    return false;
+  }
+  log->AdviseSequential();
+  const std::optional<std::string> index = Build(log->contents(), LogFormatOf(log_path), options);
+  if (!index) {
+    return false;
+  }
+  std::ofstream out(index_path, std::ios::binary | std::ios::trunc);
+  out.write(index->data(), static_cast<std::streamsize>(index->size()));
+  out.flush();
+  return static_cast<bool>(out);
+}
+
+std::optional<LogIndex> LogIndex::Open(std::string_view index, std::string_view log) {
+  LogIndex result;
+  result.index_ = index;
+  result.log_ = log;
+  if (!result.Parse()) {
+    return std::nullopt;
+  }
+  return result;
+}
+
+std::optional<LogIndex> LogIndex::OpenFile(const std::string& index_path, const std::string& log_path) {
+  auto index_file = core::MappedFile::Open(index_path);
+  auto log_file = core::MappedFile::Open(log_path);
+  if (!index_file || !log_file) {
+    return std::nullopt;
+  }
+  LogIndex result;
+  result.index_file_ = std::move(index_file);
+  result.log_file_ = std::move(log_file);
+  // The mappings do not move with the MappedFiles
+  result.index_ = result.index_file_->contents();
+  result.log_ = result.log_file_->contents();
+  if (!result.Parse()) {
+    return std::nullopt;
+  }
+  return result;
+}
+
+bool LogIndex::Parse() {
+  if (index_.size() < kHeaderSize || index_.compare(0, kMagicSize, kMagic, kMagicSize) != 0) {
+    return false;
+  }
+  const char* header = index_.data();
+  const std::uint32_t format = LoadU32(header + 8);
+  id_count_ = LoadU32(header + 12);
+  const std::uint64_t log_size = LoadU64(header + 16);
+  bucket_ns_ = LoadI64(header + 24);
+  const std::uint64_t block_count = LoadU64(header + 32);
+  const std::uint64_t bucket_count = LoadU64(header + 40);
+  frame_count_ = LoadU64(header + 48);
+  bitmap_words_ = LoadU32(header + 56);
+  if (format > static_cast<std::uint32_t>(LogFormat::kBlf) || log_size != log_.size() || bucket_ns_ <= 0 ||
+      bitmap_words_ != (id_count_ + 63) / 64) {
+    return false;
+  }
+  format_ = static_cast<LogFormat>(format);
+
+  // Section sizes, bounded by the index size before they are multiplied
+  std::size_t remaining = index_.size() - kHeaderSize;
+  if (PaddedIdBytes(id_count_) > remaining) {
+    return false;
+  }
+  remaining -= PaddedIdBytes(id_count_);
+  if (block_count > remaining / kBlockSize) {
+    return false;
+  }
+  remaining -= block_count * kBlockSize;
+  const std::size_t bucket_bytes = kBucketSize + bitmap_words_ * 8;
+  if (bucket_count > remaining / bucket_bytes || remaining != bucket_count * bucket_bytes) {
+    return false;
+  }
+  block_count_ = block_count;
+  bucket_count_ = bucket_count;
+  ids_ = header + kHeaderSize;
+  blocks_ = ids_ + PaddedIdBytes(id_count_);
+  buckets_ = blocks_ + block_count_ * kBlockSize;
+  bitmaps_ = buckets_ + bucket_count_ * kBucketSize;
+
+  for (std::size_t i = 1; i < id_count_; ++i) {
+    if (id(i - 1) >= id(i)) {
+      return false;
+    }
+  }
+  for (std::size_t i = 0; i < block_count_; ++i) {
+    const LogBlock entry = block(i);
+    if (entry.offset > log_.size() || entry.size > log_.size() - entry.offset) {
+      return false;
+    }
+  }
+  for (std::size_t i = 0; i < bucket_count_; ++i) {
+    const char* bucket = buckets_ + i * kBucketSize;
+    if ((i > 0 && LoadI64(bucket - kBucketSize) >= LoadI64(bucket)) || LoadU32(bucket + 8) > LoadU32(bucket + 12) ||
+        LoadU32(bucket + 12) >= block_count_) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::uint32_t LogIndex::id(std::size_t i) const noexcept { return LoadU32(ids_ + i * 4); }
+
+LogBlock LogIndex::block(std::size_t i) const noexcept {
+  const char* data = blocks_ + i * kBlockSize;
+  LogBlock block;
+  block.offset = LoadU64(data);
+  block.size = LoadU64(data + 8);
+  block.base_ns = LoadI64(data + 16);
+  block.min_ns = LoadI64(data + 24);
+  block.max_ns = LoadI64(data + 32);
+  block.frames = LoadU64(data + 40);
+  return block;
+}
+
+std::optional<std::vector<std::uint32_t>> LogIndex::MessageIdsOf(const parser::DbcFile& dbc_file,
+                                                                 const std::vector<std::string>& signal_names) {
+  std::vector<std::uint32_t> ids;
+  for (const std::string& qualified : signal_names) {
+    const std::size_t dot = qualified.find('.');
+    const std::string_view message_name =
+        dot == std::string::npos ? std::string_view() : std::string_view(qualified).substr(0, dot);
+    const std::string_view signal_name =
+        dot == std::string::npos ? std::string_view(qualified) : std::string_view(qualified).substr(dot + 1);
+    bool found = false;
+    for (const parser::SignalInfo& info : dbc_file.signal_infos) {
+      if (info.name != signal_name) {
+        continue;
+      }
+      if (dot != std::string::npos) {
+        const auto message = dbc_file.messages_detailed.find(info.message_id);
+        if (message == dbc_file.messages_detailed.end() || message->second.name != message_name) {
+          continue;
+        }
+      }
+      ids.push_back(static_cast<std::uint32_t>(info.message_id));
+      found = true;
+    }
+    if (!found) {
+      return std::nullopt;
+    }
+  }
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+  return ids;
+}
+
+std::vector<std::pair<std::size_t, std::size_t>> LogIndex::SelectBlocks(const FrameDecoder& decoder,
+                                                                       const LogQuery& query) const {
+  // Bitmap of the indexed IDs whose message the query reads
+  std::vector<std::uint64_t> wanted(bitmap_words_);
+  bool any = false;
+  for (std::size_t i = 0; i < id_count_; ++i) {
+    bool match = query.message_ids.empty();
+    if (!match) {
+      const FrameDecoder::MessageEntry* entry = decoder.Find(id(i));
+      match = entry != nullptr && std::binary_search(query.message_ids.begin(), query.message_ids.end(),
+                                                     static_cast<std::uint32_t>(entry->message->id));
+    }
+    if (match) {
+      wanted[i / 64] |= std::uint64_t{1} << (i % 64);
+      any = true;
+    }
+  }
+  std::vector<std::pair<std::size_t, std::size_t>> runs;
+  if (!any || query.from_ns > query.to_ns) {
+    return runs;
+  }
+
+  // The first bucket that ends after from_ns
+  std::size_t low = 0;
+  std::size_t high = bucket_count_;
+  while (low < high) {
+    const std::size_t middle = low + (high - low) / 2;
+    const std::int64_t start_ns = LoadI64(buckets_ + middle * kBucketSize);
+    if (start_ns <= query.from_ns &&
+        static_cast<std::uint64_t>(query.from_ns) - static_cast<std::uint64_t>(start_ns) >=
+            static_cast<std::uint64_t>(bucket_ns_)) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+
+  std::vector<std::pair<std::size_t, std::size_t>> ranges;
+  for (std::size_t i = low; i < bucket_count_; ++i) {
+    const char* bucket = buckets_ + i * kBucketSize;
+    if (LoadI64(bucket) > query.to_ns) {
+      break;
+    }
+    const char* bits = bitmaps_ + i * bitmap_words_ * 8;
+    for (std::size_t word = 0; word < bitmap_words_; ++word) {
+      if ((LoadU64(bits + word * 8) & wanted[word]) != 0) {
+        ranges.emplace_back(LoadU32(bucket + 8), std::size_t{LoadU32(bucket + 12)} + 1);
+        break;
+      }
+    }
+  }
+  std::sort(ranges.begin(), ranges.end());
+
+  // Blocks of the ranges that overlap the time range, as runs
+  std::size_t next = 0;
+  for (const auto& [first, last] : ranges) {
+    for (std::size_t i = std::max(first, next); i < last; ++i) {
+      const LogBlock entry = block(i);
+      if (entry.frames == 0 || entry.max_ns < query.from_ns || entry.min_ns > query.to_ns) {
+        continue;
+      }
+      if (!runs.empty() && runs.back().second == i) {
+        runs.back().second = i + 1;
+      } else {
+        runs.emplace_back(i, i + 1);
+      }
+    }
+    next = std::max(next, last);
+  }
+  return runs;
+}
+
+std::optional<LogDecodeStats> LogIndex::Decode(const FrameDecoder& decoder, const LogQuery& query,
+                                               const decoder::LogDecoder::FrameCallback& on_frame,
+                                               LogDecodeOptions options) const {
+  DBC_TRACE_SPAN(kTraceCategory, "LogIndex::Decode");
+  const auto start = std::chrono::steady_clock::now();
+  const std::vector<std::pair<std::size_t, std::size_t>> runs = SelectBlocks(decoder, query);
+  options.on_chunk = nullptr;
+
+  // Relative ASC timestamps start from the block's base time; the readers
+  // start every run from zero
+  std::int64_t base_ns = 0;
+  const auto filter = [&](const DecodedFrame& decoded) {
+    CanFrame shifted;
+    DecodedFrame delivered = decoded;
+    if (base_ns != 0) {
+      shifted = *decoded.frame;
+      shifted.timestamp_ns += base_ns;
+      delivered.frame = &shifted;
+    }
+    const std::int64_t timestamp_ns = delivered.frame->timestamp_ns;
+    if (timestamp_ns < query.from_ns || timestamp_ns > query.to_ns) {
+      return;
+    }
+    if (!query.message_ids.empty() &&
+        (decoded.message == nullptr ||
+         !std::binary_search(query.message_ids.begin(), query.message_ids.end(),
+                             static_cast<std::uint32_t>(decoded.message->message->id)))) {
+      return;
+    }
+    on_frame(delivered);
+  };
+
+  LogDecodeStats total;
+  std::optional<decoder::AscHeader> asc_header;
+  for (const auto& [first, last] : runs) {
+    const LogBlock first_block = block(first);
+    const LogBlock last_block = block(last - 1);
+    const std::size_t begin = first_block.offset;
+    const std::size_t end = last_block.offset + last_block.size;
+    std::optional<LogDecodeStats> run;
+    switch (format_) {
+      case LogFormat::kCandump:
+        run = decoder::LogDecoder(decoder, &decoder::CandumpParser::ParseLine, options)
+                  .Decode(log_.substr(begin, end - begin), filter);
+        break;
+      case LogFormat::kAsc: {
+        if (!asc_header) {
+          asc_header = decoder::AscParser::ParseHeader(log_);
+        }
+        LogDecodeOptions asc_options = options;
+        if (asc_header->relative_timestamps) {
+          asc_options.relative_timestamps = &decoder::AscParser::ParseTimestamp;
+          base_ns = first_block.base_ns;
+        }
+        run = decoder::LogDecoder(decoder,
+                                  asc_header->hex_base ? &decoder::AscParser::ParseLineHex
+                                                       : &decoder::AscParser::ParseLineDec,
+                                  asc_options)
+                  .Decode(log_.substr(begin, end - begin), filter);
+        break;
+      }
+      case LogFormat::kBlf:
+        // Objects continued into the first block start in the one before
+        run = decoder::BlfReader(decoder, options)
+                  .DecodeRange(log_, first > 0 ? block(first - 1).offset : begin, end, filter);
+        break;
+    }
+    if (!run) {
+      return std::nullopt;
+    }
+    AddRun(total, *run);
+  }
+  total.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return total;
+}
+
+}  // namespace storage
+}  // namespace dbc_parser
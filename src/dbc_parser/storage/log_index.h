@@ -0,0 +1,230 @@
+#ifndef DBC_PARSER_STORAGE_LOG_INDEX_H_
+#define DBC_PARSER_STORAGE_LOG_INDEX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "dbc_parser/core/mapped_file.h"
+#include "dbc_parser/decoder/frame_decoder.h"
+#include "dbc_parser/decoder/log_decoder.h"
+#include "dbc_parser/parser/dbc_file_parser.h"
+
+namespace dbc_parser {
+namespace storage {
+
+/**
+ * @brief The log formats a LogIndex can index.
+ */
+enum class LogFormat : std::uint32_t {
+  kCandump = 0,  ///< candump -l text, read by LogDecoder with CandumpParser
+  kAsc = 1,      ///< Vector ASC text, read by AscReader
+  kBlf = 2,      ///< Vector BLF, read by BlfReader
+};
+
+/**
+ * @brief The format of a log file by its extension: .asc, .blf, else candump.
+ */
+[[nodiscard]] LogFormat LogFormatOf(std::string_view path) noexcept;
+
+/**
+ * @brief Tuning of LogIndex::Build.
+ */
+struct LogIndexOptions {
+  /// Width of the time buckets
+  std::int64_t bucket_ns = 1'000'000'000;
+  /// Target size of the blocks of text logs; the blocks of BLF files are
+  /// their containers
+  std::size_t block_bytes = std::size_t{1} << 20;
+  /// Worker threads; 0 uses one per hardware thread
+  std::size_t threads = 0;
+};
+
+/**
+ * @brief The frames a LogIndex query reads.
+ */
+struct LogQuery {
+  /// DBC IDs of the messages to read, see LogIndex::MessageIdsOf; empty
+  /// reads every frame
+  std::vector<std::uint32_t> message_ids;
+  std::int64_t from_ns = std::numeric_limits<std::int64_t>::min();  ///< Earliest timestamp
+  std::int64_t to_ns = std::numeric_limits<std::int64_t>::max();    ///< Latest timestamp
+};
+
+/**
+ * @brief One block of an indexed log: a chunk of a text log or a BLF
+ *        container, see decoder::LogChunk.
+ */
+struct LogBlock {
+  std::uint64_t offset = 0;  ///< First byte in the log
+  std::uint64_t size = 0;    ///< Bytes
+  std::int64_t base_ns = 0;  ///< Time relative timestamps of the block start from
+  std::int64_t min_ns = 0;   ///< Earliest frame; max() if the block has no frames
+  std::int64_t max_ns = 0;   ///< Latest frame; min() if the block has no frames
+  std::uint64_t frames = 0;  ///< Frames in the block
+};
+
+/**
+ * @brief A sidecar index of a CAN log for reading time ranges and messages
+ *        without a full scan.
+ *
+ * Build makes one pass over the log with the log's reader on its worker pool
+ * and records, per block, the byte range and time range, and per time bucket
+ * that holds frames, the range of blocks with frames of the bucket and a
+ * bitmap of the CAN IDs that occur in it. The index does not depend on a DBC
+ * file; queries resolve their messages through a FrameDecoder, so J1939
+ * messages match by PGN like in a full decode.
+ *
+ * The file is a flat little-endian layout of fixed-size records, read in
+ * place from a memory mapping:
+ *
+ *   header   magic "DBCIDX01", format, ID count, log size, bucket width,
+ *            block count, bucket count, frame count, bitmap words per bucket
+ *   IDs      u32 DBC IDs in ascending order; bit i of a bitmap is IDs[i]
+ *   blocks   offset, size, base_ns, min_ns, max_ns, frames
+ *   buckets  start_ns, first block, last block, by start_ns
+ *   bitmaps  u64 words per bucket
+ *
+ * Frames of one bucket may spread over blocks that hold none of its IDs, and
+ * a block may be read for a bucket it shares with another ID, so a query
+ * reads a superset of the frames it needs and filters them.
+ */
+class LogIndex {
+ public:
+  static constexpr char kMagic[8] = {'D', 'B', 'C', 'I', 'D', 'X', '0', '1'};
+  static constexpr std::size_t kMagicSize = sizeof(kMagic);
+
+  /**
+   * @brief Indexes a log held in memory.
+   *
+   * @param log Log contents
+   * @param format Format of the log
+   * @param options Bucket width, block size and threads
+   * @return std::optional<std::string> The index file contents, or
+   *         std::nullopt if a BLF log has no valid header
+   */
+  [[nodiscard]] static std::optional<std::string> Build(std::string_view log, LogFormat format,
+                                                        const LogIndexOptions& options = {});
+
+  /**
+   * @brief Memory-maps a log, indexes it and writes the index.
+   *
+   * @param log_path Log file; its format is LogFormatOf(log_path)
+   * @param index_path Index file to write, usually SidecarPath(log_path)
+   * @param options Bucket width, block size and threads
+   * @return bool False if the log cannot be read or the index not written
+   */
+  static bool BuildFile(const std::string& log_path, const std::string& index_path,
+                        const LogIndexOptions& options = {});
+
+  /**
+   * @brief The default index path of a log: the log path plus ".dbcidx".
+   */
+  [[nodiscard]] static std::string SidecarPath(const std::string& log_path) { return log_path + ".dbcidx"; }
+
+  /**
+   * @brief Opens an index held in memory.
+   *
+   * @param index Index contents; must outlive the LogIndex
+   * @param log The indexed log; must outlive the LogIndex
+   * @return std::optional<LogIndex> The index, or std::nullopt if it is
+   *         malformed or was built for a log of another size
+   */
+  [[nodiscard]] static std::optional<LogIndex> Open(std::string_view index, std::string_view log);
+
+  /**
+   * @brief Memory-maps an index and its log and opens them; see Open.
+   */
+  [[nodiscard]] static std::optional<LogIndex> OpenFile(const std::string& index_path, const std::string& log_path);
+
+  /**
+   * @brief Resolves signal names to the DBC IDs of the messages that carry
+   *        them.
+   *
+   * @param dbc_file Parsed file
+   * @param signal_names Signal names, optionally qualified as
+   *        "Message.Signal"; an unqualified name matches every message
+   *        with a signal of that name
+   * @return std::optional<std::vector<std::uint32_t>> Ascending unique IDs,
+   *         or std::nullopt if a name matches no signal
+   */
+  [[nodiscard]] static std::optional<std::vector<std::uint32_t>> MessageIdsOf(
+      const parser::DbcFile& dbc_file, const std::vector<std::string>& signal_names);
+
+  [[nodiscard]] LogFormat format() const noexcept { return format_; }
+  [[nodiscard]] std::int64_t bucket_ns() const noexcept { return bucket_ns_; }
+  [[nodiscard]] std::uint64_t frame_count() const noexcept { return frame_count_; }
+  [[nodiscard]] std::size_t block_count() const noexcept { return block_count_; }
+  [[nodiscard]] std::size_t bucket_count() const noexcept { return bucket_count_; }
+  [[nodiscard]] std::size_t id_count() const noexcept { return id_count_; }
+
+  /**
+   * @brief The DBC ID of the frames with bit i in a bucket bitmap.
+   */
+  [[nodiscard]] std::uint32_t id(std::size_t i) const noexcept;
+
+  /**
+   * @brief Block i, in log order.
+   */
+  [[nodiscard]] LogBlock block(std::size_t i) const noexcept;
+
+  /**
+   * @brief The blocks a query has to read.
+   *
+   * @param decoder Resolves the indexed IDs to messages
+   * @param query Messages and time range
+   * @return std::vector<std::pair<std::size_t, std::size_t>> Runs of
+   *         consecutive blocks as [first, last) in log order
+   */
+  [[nodiscard]] std::vector<std::pair<std::size_t, std::size_t>> SelectBlocks(const decoder::FrameDecoder& decoder,
+                                                                             const LogQuery& query) const;
+
+  /**
+   * @brief Reads and decodes the blocks of a query and delivers its frames.
+   *
+   * Each run of blocks is decoded by the log's reader with options, so frames
+   * arrive in timestamp order within a run and runs in log order.
+   *
+   * @param decoder Message index
+   * @param query Messages and time range; only their frames are delivered
+   * @param on_frame Receiver of the frames
+   * @param options Threads and chunking of the reader
+   * @return std::optional<decoder::LogDecodeStats> Counters of the blocks
+   *         read, or std::nullopt if the log cannot be decoded
+   */
+  [[nodiscard]] std::optional<decoder::LogDecodeStats> Decode(const decoder::FrameDecoder& decoder,
+                                                              const LogQuery& query,
+                                                              const decoder::LogDecoder::FrameCallback& on_frame,
+                                                              decoder::LogDecodeOptions options = {}) const;
+
+ private:
+  LogIndex() = default;
+
+  bool Parse();
+
+  std::optional<core::MappedFile> index_file_;
+  std::optional<core::MappedFile> log_file_;
+  std::string_view index_;
+  std::string_view log_;
+  LogFormat format_ = LogFormat::kCandump;
+  std::int64_t bucket_ns_ = 0;
+  std::uint64_t frame_count_ = 0;
+  std::size_t id_count_ = 0;
+  std::size_t block_count_ = 0;
+  std::size_t bucket_count_ = 0;
+  std::size_t bitmap_words_ = 0;
+  const char* ids_ = nullptr;
+  const char* blocks_ = nullptr;
+  const char* buckets_ = nullptr;
+  const char* bitmaps_ = nullptr;
+};
+
+}  // namespace storage
+}  // namespace dbc_parser
+
+#endif  // DBC_PARSER_STORAGE_LOG_INDEX_H_
@@ -0,0 +1,72 @@
+#include "src/dbc_parser/common/parser_base.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "gtest/gtest.h"
+
+namespace dbc_parser {
+namespace parser {
+namespace {
+
+TEST(ParserBaseTest, UnescapeQuotedBorrowsWhenNoEscapes) {
+  const std::string input = "\"Engine speed in rpm\"";
+  QuotedText text = ParserBase::UnescapeQuoted(input);
+  EXPECT_TRUE(text.is_borrowed());
+  EXPECT_EQ(text.view(), "Engine speed in rpm");
+  EXPECT_EQ(text.view().data(), input.data() + 1);
+}
+
+TEST(ParserBaseTest, UnescapeQuotedOwnsWhenEscaped) {
+  const std::string input = "\"say \\\"hi\\\" \\\\ bye\"";
+  QuotedText text = ParserBase::UnescapeQuoted(input);
+  EXPECT_FALSE(text.is_borrowed());
+  EXPECT_EQ(text.view(), "say \"hi\" \\ bye");
+}
+
+TEST(ParserBaseTest, UnescapeQuotedHandlesDegenerateInput) {
+  EXPECT_TRUE(ParserBase::UnescapeQuoted("").empty());
+  EXPECT_TRUE(ParserBase::UnescapeQuoted("\"").empty());
+  QuotedText empty = ParserBase::UnescapeQuoted("\"\"");
+  EXPECT_TRUE(empty.empty());
+  EXPECT_TRUE(empty.is_borrowed());
+}
+
+TEST(ParserBaseTest, QuotedTextSurvivesMoveWhenOwned) {
+  QuotedText owned = ParserBase::UnescapeQuoted("\"a\\\"b\"");
+  QuotedText moved = std::move(owned);
+  EXPECT_EQ(moved.view(), "a\"b");
+  EXPECT_EQ(std::move(moved).str(), "a\"b");
+}
+
+TEST(ParserBaseTest, UnescapeStringMatchesUnescapeQuoted) {
+  for (std::string_view input : {"\"plain\"", "\"tab\\tx\"", "\"\\\\\"", "\"\""}) {
+    EXPECT_EQ(ParserBase::UnescapeString(input), ParserBase::UnescapeQuoted(input).view());
+  }
+}
+
+TEST(ParserBaseTest, ParseMessageIdKeepsExtendedIdBits) {
+  EXPECT_EQ(ParserBase::ParseMessageId("0"), 0);
+  EXPECT_EQ(ParserBase::ParseMessageId("2047"), 2047);
+  EXPECT_EQ(ParserBase::ParseMessageId("-123"), -123);
+
+  auto extended = ParserBase::ParseMessageId("2566844926");
+  ASSERT_TRUE(extended.has_value());
+  EXPECT_EQ(static_cast<std::uint32_t>(*extended), 2566844926u);
+  EXPECT_EQ(static_cast<std::uint32_t>(*extended) & 0x1FFFFFFFu, 0x18FEF1FEu);
+
+  EXPECT_FALSE(ParserBase::ParseMessageId("4294967296").has_value());
+  EXPECT_FALSE(ParserBase::ParseMessageId("").has_value());
+  EXPECT_FALSE(ParserBase::ParseMessageId("12a").has_value());
+}
+
+TEST(ParserBaseTest, ParseMessageIdRejectsEnvironmentVariableSentinel) {
+  // -1 marks value descriptions of environment variables in DbcFile
+  EXPECT_FALSE(ParserBase::ParseMessageId("4294967295").has_value());
+  EXPECT_FALSE(ParserBase::ParseMessageId("-1").has_value());
+  EXPECT_EQ(ParserBase::ParseMessageId("4294967294"), -2);
+}
+
+}  // namespace
+}  // namespace parser
+}  // namespace dbc_parser
@@ -0,0 +1,86 @@
+#include "src/dbc_parser/core/log_macros.h"
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "spdlog/logger.h"
+#include "spdlog/sinks/ostream_sink.h"
+
+namespace dbc_parser {
+namespace core {
+namespace {
+
+// Counts how often a log argument is evaluated
+int Evaluate(int& evaluations) {
+  return ++evaluations;
+}
+
+class LogMacrosTest : public ::testing::Test {
+ protected:
+  void TearDown() override { Logger::Shutdown(); }
+
+  // Initializes the logger and sends its output to output_ as well
+  void InitializeCaptured(const std::string& level) {
+    ASSERT_TRUE(Logger::Initialize(level));
+    auto sink = std::make_shared<spdlog::sinks::ostream_sink_st>(output_);
+    sink->set_pattern("%l %v");
+    Logger::GetLogger()->sinks().push_back(sink);
+  }
+
+  std::ostringstream output_;
+};
+
+TEST_F(LogMacrosTest, DropsEverythingBeforeInitialize) {
+  int evaluations = 0;
+  EXPECT_FALSE(Logger::ShouldLog(LogLevel::kCritical));
+  DBC_LOG_ERROR("value {}", Evaluate(evaluations));
+  DBC_LOG_CRITICAL_STR(std::to_string(Evaluate(evaluations)));
+  EXPECT_EQ(evaluations, 0);
+}
+
+TEST_F(LogMacrosTest, FormatsEnabledLevelsLazily) {
+  InitializeCaptured("info");
+  int evaluations = 0;
+  DBC_LOG_INFO("parsed {} messages from {}", Evaluate(evaluations), "file.dbc");
+  DBC_LOG_WARN_STR("plain message");
+  EXPECT_EQ(evaluations, 1);
+  EXPECT_NE(output_.str().find("info parsed 1 messages from file.dbc"), std::string::npos);
+  EXPECT_NE(output_.str().find("warning plain message"), std::string::npos);
+
+  Logger::SetLevel(LogLevel::kError);
+  DBC_LOG_WARN("value {}", Evaluate(evaluations));
+  EXPECT_EQ(evaluations, 1);
+  EXPECT_EQ(output_.str().find("value"), std::string::npos);
+}
+
+#if DBC_LOG_ACTIVE_LEVEL > DBC_LOG_LEVEL_DEBUG
+TEST_F(LogMacrosTest, CompilesOutLevelsBelowActiveLevel) {
+  InitializeCaptured("trace");
+  int evaluations = 0;
+  EXPECT_TRUE(Logger::ShouldLog(LogLevel::kTrace));
+  DBC_LOG_TRACE("value {}", Evaluate(evaluations));
+  DBC_LOG_DEBUG_STR(std::to_string(Evaluate(evaluations)));
+  EXPECT_EQ(evaluations, 0);
+  EXPECT_EQ(output_.str().find("value"), std::string::npos);
+}
+#endif
+
+TEST_F(LogMacrosTest, ShutdownDisablesLogging) {
+  InitializeCaptured("trace");
+  Logger::Shutdown();
+  EXPECT_FALSE(Logger::ShouldLog(LogLevel::kCritical));
+  EXPECT_EQ(Logger::GetLogger(), nullptr);
+}
+
+TEST_F(LogMacrosTest, ParsesLevelNames) {
+  EXPECT_EQ(Logger::ParseLevel("trace"), LogLevel::kTrace);
+  EXPECT_EQ(Logger::ParseLevel("warn"), LogLevel::kWarn);
+  EXPECT_EQ(Logger::ParseLevel("off"), LogLevel::kOff);
+  EXPECT_EQ(Logger::ParseLevel("bogus"), LogLevel::kInfo);
+}
+
+}  // namespace
+}  // namespace core
+}  // namespace dbc_parser
@@ -0,0 +1,156 @@
+#include "src/dbc_parser/core/logger.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "src/dbc_parser/core/log_macros.h"
+
+namespace dbc_parser {
+namespace core {
+namespace {
+
+std::size_t CountOccurrences(const std::string& text, const std::string& needle) {
+  std::size_t count = 0;
+  for (std::size_t pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + 1)) {
+    ++count;
+  }
+  return count;
+}
+
+class LoggerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    path_ = ::testing::TempDir() + "logger_test_" +
+            ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".log";
+    std::remove(path_.c_str());
+  }
+
+  void TearDown() override {
+    Logger::Shutdown();
+    std::remove(path_.c_str());
+  }
+
+  // File-only logger options
+  LoggerOptions FileOptions() const {
+    LoggerOptions options;
+    options.console = false;
+    options.file_path = path_;
+    return options;
+  }
+
+  std::string ReadLog() const {
+    std::ifstream file(path_);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+  }
+
+  std::string path_;
+};
+
+TEST_F(LoggerTest, WritesToFile) {
+  ASSERT_TRUE(Logger::Initialize(FileOptions()));
+  DBC_LOG_WARN("malformed line {}", 17);
+  Logger::Shutdown();
+  EXPECT_NE(ReadLog().find("malformed line 17"), std::string::npos);
+}
+
+TEST_F(LoggerTest, AsyncLoggerDeliversEverythingWhenBlocking) {
+  LoggerOptions options = FileOptions();
+  options.async = true;
+  options.queue_size = 16;
+  options.overflow = OverflowPolicy::kBlock;
+  ASSERT_TRUE(Logger::Initialize(options));
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([t]() {
+      for (int i = 0; i < 500; ++i) {
+        DBC_LOG_WARN("thread {} message {}", t, i);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  Logger::Shutdown();
+
+  const std::string log = ReadLog();
+  EXPECT_EQ(CountOccurrences(log, " message "), 2000u);
+  EXPECT_NE(log.find("thread 3 message 499"), std::string::npos);
+}
+
+TEST_F(LoggerTest, AsyncLoggerDropsOldestWhenFull) {
+  LoggerOptions options = FileOptions();
+  options.async = true;
+  options.queue_size = 1;
+  options.overflow = OverflowPolicy::kDropOldest;
+  ASSERT_TRUE(Logger::Initialize(options));
+  for (int i = 0; i < 20000; ++i) {
+    DBC_LOG_WARN("message {}", i);
+  }
+  // Only enqueueing drops messages, so the count is final once logging stops
+  const std::uint64_t dropped = Logger::DroppedMessages();
+  Logger::Shutdown();
+
+  // Logging never waits, so a one-slot queue must overwrite messages. Every
+  // message, including the initialization line, is either written or dropped.
+  const std::size_t written = CountOccurrences(ReadLog(), "\n");
+  EXPECT_GT(dropped, 0u);
+  EXPECT_GT(written, 0u);
+  EXPECT_EQ(written + dropped, 20001u);
+}
+
+TEST_F(LoggerTest, SuppressesRepeatedMessages) {
+  LoggerOptions options = FileOptions();
+  options.repeat_limit = 3;
+  options.repeat_window = std::chrono::hours(1);
+  ASSERT_TRUE(Logger::Initialize(options));
+
+  for (int i = 0; i < 100; ++i) {
+    DBC_LOG_WARN("Invalid attribute on line {}", i);
+  }
+  DBC_LOG_ERROR_STR("unrelated");
+  Logger::Shutdown();
+
+  const std::string log = ReadLog();
+  EXPECT_EQ(CountOccurrences(log, "] Invalid attribute on line "), 3u);
+  EXPECT_NE(log.find("Suppressed 97 similar messages: Invalid attribute on line {}"), std::string::npos);
+  EXPECT_NE(log.find("unrelated"), std::string::npos);
+}
+
+TEST_F(LoggerTest, ReportsSuppressedMessagesWhenWindowRestarts) {
+  LoggerOptions options = FileOptions();
+  options.repeat_limit = 1;
+  options.repeat_window = std::chrono::milliseconds(1);
+  ASSERT_TRUE(Logger::Initialize(options));
+
+  DBC_LOG_WARN_STR("same");
+  DBC_LOG_WARN_STR("same");
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  DBC_LOG_WARN_STR("same");
+  Logger::Shutdown();
+
+  const std::string log = ReadLog();
+  EXPECT_NE(log.find("Suppressed 1 similar messages: same"), std::string::npos);
+  EXPECT_EQ(CountOccurrences(log, "] same"), 2u);
+}
+
+TEST_F(LoggerTest, FailsOnUnwritableFile) {
+  // A regular file cannot be used as a directory
+  std::ofstream(path_) << "not a directory";
+  LoggerOptions options;
+  options.console = false;
+  options.file_path = path_ + "/dbc.log";
+  EXPECT_FALSE(Logger::Initialize(options));
+  EXPECT_FALSE(Logger::ShouldLog(LogLevel::kCritical));
+}
+
+}  // namespace
+}  // namespace core
+}  // namespace dbc_parser
@@ -0,0 +1,54 @@
+#include "src/dbc_parser/core/mapped_file.h"
+
+#include <fstream>
+#include <string>
+#include <utility>
+
+#include "gtest/gtest.h"
+
+namespace dbc_parser {
+namespace core {
+namespace {
+
+std::string WriteFile(const std::string& name, const std::string& contents) {
+  const std::string path = ::testing::TempDir() + name;
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file << contents;
+  return path;
+}
+
+TEST(MappedFileTest, MapsFileContents) {
+  const std::string path = WriteFile("mapped_file_test.log", "(1.0) can0 123#00\n(2.0) can0 123#01\n");
+  auto file = MappedFile::Open(path);
+  ASSERT_TRUE(file.has_value());
+  file->AdviseSequential();
+  EXPECT_EQ(file->contents(), "(1.0) can0 123#00\n(2.0) can0 123#01\n");
+}
+
+TEST(MappedFileTest, EmptyFileHasEmptyContents) {
+  auto file = MappedFile::Open(WriteFile("mapped_file_test_empty.log", ""));
+  ASSERT_TRUE(file.has_value());
+  EXPECT_TRUE(file->contents().empty());
+}
+
+TEST(MappedFileTest, MissingFileOrDirectoryFails) {
+  EXPECT_FALSE(MappedFile::Open(::testing::TempDir() + "does_not_exist.log").has_value());
+  EXPECT_FALSE(MappedFile::Open(::testing::TempDir()).has_value());
+}
+
+TEST(MappedFileTest, MoveTransfersMapping) {
+  auto file = MappedFile::Open(WriteFile("mapped_file_test_move.log", "abc"));
+  ASSERT_TRUE(file.has_value());
+  MappedFile moved = std::move(*file);
+  EXPECT_EQ(moved.contents(), "abc");
+  EXPECT_TRUE(file->contents().empty());
+
+  auto other = MappedFile::Open(WriteFile("mapped_file_test_other.log", "xyz"));
+  ASSERT_TRUE(other.has_value());
+  moved = std::move(*other);
+  EXPECT_EQ(moved.contents(), "xyz");
+}
+
+}  // namespace
+}  // namespace core
+}  // namespace dbc_parser
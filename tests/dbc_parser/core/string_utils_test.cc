@@ -2,6 +2,7 @@
 
 #include <limits>
 #include <string>
+#include <string_view>
 #include <vector>
 #include "gtest/gtest.h"
 #include <iostream>
@@ -23,6 +24,15 @@ TEST(StringUtilsTest, TrimHandlesLeadingAndTrailingWhitespace) {
   EXPECT_EQ(StringUtils::Trim("\t\nhello world\r\n"), "hello world");
 }
 
+TEST(StringUtilsTest, TrimViewReturnsViewIntoInput) {
+  const std::string input = "  hello world \t\n";
+  std::string_view trimmed = StringUtils::TrimView(input);
+  EXPECT_EQ(trimmed, "hello world");
+  EXPECT_EQ(trimmed.data(), input.data() + 2);
+  EXPECT_TRUE(StringUtils::TrimView(" \t\r\n").empty());
+  EXPECT_TRUE(StringUtils::TrimView("").empty());
+}
+
 TEST(StringUtilsTest, SplitHandlesEmptyString) {
   std::vector<std::string> result = StringUtils::Split("", ',');
   ASSERT_EQ(result.size(), 1);
@@ -43,6 +53,42 @@ TEST(StringUtilsTest, SplitHandlesMultipleDelimiters) {
   EXPECT_EQ(result[2], "c");
 }
 
+TEST(StringUtilsTest, SplitViewMatchesSplit) {
+  for (std::string_view input : {"", "hello", "a,b,c", ",a,,b,", ","}) {
+    std::vector<std::string> owned = StringUtils::Split(input, ',');
+    std::vector<std::string_view> views = StringUtils::SplitView(input, ',');
+    ASSERT_EQ(owned.size(), views.size()) << input;
+    for (size_t i = 0; i < owned.size(); ++i) {
+      EXPECT_EQ(owned[i], views[i]) << input;
+    }
+  }
+}
+
+TEST(StringUtilsTest, SplitLazyYieldsViewsIntoInput) {
+  const std::string input = "ECU1, ECU2,,ECU3";
+  std::vector<std::string_view> tokens;
+  for (std::string_view token : StringUtils::SplitLazy(input, ',')) {
+    EXPECT_GE(token.data(), input.data());
+    EXPECT_LE(token.data() + token.size(), input.data() + input.size());
+    tokens.push_back(token);
+  }
+  ASSERT_EQ(tokens.size(), 4);
+  EXPECT_EQ(tokens[0], "ECU1");
+  EXPECT_EQ(tokens[1], " ECU2");
+  EXPECT_EQ(tokens[2], "");
+  EXPECT_EQ(tokens[3], "ECU3");
+}
+
+TEST(StringUtilsTest, SplitViewByAnySkipsEmptyTokens) {
+  std::vector<std::string_view> result = StringUtils::SplitViewByAny("  a b\tc\n\nd ", " \t\n");
+  ASSERT_EQ(result.size(), 4);
+  EXPECT_EQ(result[0], "a");
+  EXPECT_EQ(result[1], "b");
+  EXPECT_EQ(result[2], "c");
+  EXPECT_EQ(result[3], "d");
+  EXPECT_TRUE(StringUtils::SplitViewByAny("", " ").empty());
+}
+
 TEST(StringUtilsTest, SplitByAnyHandlesEmptyString) {
   std::vector<std::string> result = StringUtils::SplitByAny("", " \t\n");
   EXPECT_TRUE(result.empty());
@@ -71,6 +117,41 @@ TEST(StringUtilsTest, IsValidUtf8HandlesInvalidSequences) {
   EXPECT_FALSE(StringUtils::IsValidUtf8("\xC0\x80"));  // Overlong encoding
 }
 
+TEST(StringUtilsTest, IsValidUtf8HandlesLongMixedInput) {
+  // Long ASCII runs exercise the block-wise fast path on both sides of a
+  // multi-byte sequence, including sequences straddling a block boundary.
+  const std::string ascii(37, 'a');
+  for (size_t offset = 0; offset < 20; ++offset) {
+    std::string text = std::string(offset, 'x') + "\xC3\xA9" + ascii + "\xE2\x82\xAC" + ascii;
+    EXPECT_TRUE(StringUtils::IsValidUtf8(text)) << offset;
+    text[offset + 1] = 'x';  // Break the continuation byte of the first sequence
+    EXPECT_FALSE(StringUtils::IsValidUtf8(text)) << offset;
+  }
+  EXPECT_FALSE(StringUtils::IsValidUtf8(ascii + "\xED\xA0\x80"));  // Surrogate half
+  EXPECT_FALSE(StringUtils::IsValidUtf8(ascii + "\xF4\x90\x80\x80"));  // Past U+10FFFF
+  EXPECT_FALSE(StringUtils::IsValidUtf8(ascii + "\xE2\x82"));  // Truncated at end
+}
+
+TEST(StringUtilsTest, AsciiPrefixLengthFindsFirstHighByte) {
+  EXPECT_EQ(StringUtils::AsciiPrefixLength(""), 0);
+  EXPECT_EQ(StringUtils::AsciiPrefixLength("plain ascii text that is long enough"), 36);
+  const std::string text = std::string(23, 'a') + "\xFC" + "tail";
+  EXPECT_EQ(StringUtils::AsciiPrefixLength(text), 23);
+}
+
+TEST(StringUtilsTest, Latin1ToUtf8TranscodesHighBytes) {
+  // "Geschwindigkeit über Grenze" with a Latin-1 u-umlaut (0xFC)
+  EXPECT_EQ(StringUtils::Latin1ToUtf8("Geschwindigkeit \xFC" "ber Grenze"),
+            "Geschwindigkeit \xC3\xBC" "ber Grenze");
+  EXPECT_EQ(StringUtils::Latin1ToUtf8("\xB0" "C"), "\xC2\xB0" "C");  // Degree sign
+  EXPECT_EQ(StringUtils::Latin1ToUtf8("ascii only"), "ascii only");
+}
+
+TEST(StringUtilsTest, ToUtf8OnlyTranscodesInvalidInput) {
+  EXPECT_EQ(StringUtils::ToUtf8("\xC2\xB0" "C"), "\xC2\xB0" "C");  // Already UTF-8
+  EXPECT_EQ(StringUtils::ToUtf8("\xB0" "C"), "\xC2\xB0" "C");       // Latin-1 input
+}
+
 TEST(StringUtilsTest, ExtractQuotedHandlesValidString) {
   auto result = StringUtils::ExtractQuoted("\"hello world\"");
   ASSERT_TRUE(result.has_value());
@@ -138,6 +219,13 @@ TEST(StringUtilsTest, ParseDoubleHandlesValidNumbers) {
   EXPECT_DOUBLE_EQ(*result, -789.012);
 }
 
+TEST(StringUtilsTest, ParseDoubleStopsAtEndOfView) {
+  const std::string buffer = "12.5|99";
+  auto result = StringUtils::ParseDouble(std::string_view(buffer).substr(0, 4));
+  ASSERT_TRUE(result.has_value());
+  EXPECT_DOUBLE_EQ(*result, 12.5);
+}
+
 TEST(StringUtilsTest, ParseDoubleHandlesInvalidInput) {
   EXPECT_FALSE(StringUtils::ParseDouble("").has_value());
   EXPECT_FALSE(StringUtils::ParseDouble("abc").has_value());
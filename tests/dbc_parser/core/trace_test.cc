@@ -0,0 +1,177 @@
+#include "src/dbc_parser/core/trace.h"
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace dbc_parser {
+namespace core {
+namespace {
+
+std::size_t CountOccurrences(const std::string& text, const std::string& needle) {
+  std::size_t count = 0;
+  for (std::size_t pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + 1)) {
+    ++count;
+  }
+  return count;
+}
+
+class TraceTest : public ::testing::Test {
+ protected:
+  void TearDown() override {
+    Tracer::Disable();
+    Tracer::Clear();
+  }
+};
+
+TEST_F(TraceTest, RecordsNothingWhileDisabled) {
+  Tracer::Clear();
+  {
+    DBC_TRACE_SPAN("test", "disabled_span");
+  }
+  Tracer::RecordCounter("test", "disabled_counter", 1.0);
+
+  const std::string json = Tracer::ToChromeTraceJson();
+  EXPECT_EQ(json.find("disabled_span"), std::string::npos);
+  EXPECT_EQ(json.find("disabled_counter"), std::string::npos);
+}
+
+TEST_F(TraceTest, WritesSpansAndCountersAsChromeTraceEvents) {
+  Tracer::Enable();
+  {
+    TraceSpan span("parse", "outer");
+    span.SetCount(42);
+    DBC_TRACE_SPAN("parse", "inner");
+  }
+  Tracer::RecordCounter("parse", "messages", 7);
+
+  const std::string json = Tracer::ToChromeTraceJson();
+  EXPECT_EQ(json.rfind("{\"traceEvents\":[", 0), 0u);
+  EXPECT_NE(json.find("{\"name\":\"outer\",\"cat\":\"parse\",\"ph\":\"X\",\"ts\":"), std::string::npos);
+  EXPECT_NE(json.find("\"args\":{\"count\":42}"), std::string::npos);
+  EXPECT_NE(json.find("{\"name\":\"inner\",\"cat\":\"parse\",\"ph\":\"X\""), std::string::npos);
+  EXPECT_NE(json.find("{\"name\":\"messages\",\"cat\":\"parse\",\"ph\":\"C\""), std::string::npos);
+  EXPECT_NE(json.find("\"args\":{\"value\":7}"), std::string::npos);
+  EXPECT_NE(json.find("\"dropped_events\":0"), std::string::npos);
+
+  // Inner ends first, so it is recorded before outer
+  EXPECT_LT(json.find("\"inner\""), json.find("\"outer\""));
+}
+
+TEST_F(TraceTest, RecordsExplicitSpanTimes) {
+  Tracer::Enable();
+  Tracer::RecordSpan("decode", "batch", 1500, 4000, 3);
+
+  const std::string json = Tracer::ToChromeTraceJson();
+  EXPECT_NE(json.find("\"ts\":1.500,\"dur\":2.500,"), std::string::npos);
+}
+
+TEST_F(TraceTest, DropsAndCountsEventsBeyondCapacity) {
+  Tracer::Enable(4);
+  for (int i = 0; i < 10; ++i) {
+    DBC_TRACE_SPAN("test", "span");
+  }
+
+  EXPECT_EQ(Tracer::DroppedEvents(), 6u);
+  const std::string json = Tracer::ToChromeTraceJson();
+  EXPECT_EQ(CountOccurrences(json, "\"name\":\"span\""), 4u);
+  EXPECT_NE(json.find("\"dropped_events\":6"), std::string::npos);
+}
+
+TEST_F(TraceTest, EnableAndClearDiscardRecordedEvents) {
+  Tracer::Enable();
+  { DBC_TRACE_SPAN("test", "before_clear"); }
+  Tracer::Clear();
+  { DBC_TRACE_SPAN("test", "after_clear"); }
+
+  std::string json = Tracer::ToChromeTraceJson();
+  EXPECT_EQ(json.find("before_clear"), std::string::npos);
+  EXPECT_NE(json.find("after_clear"), std::string::npos);
+
+  Tracer::Enable();
+  json = Tracer::ToChromeTraceJson();
+  EXPECT_EQ(json.find("after_clear"), std::string::npos);
+}
+
+TEST_F(TraceTest, KeepsEventsAfterDisable) {
+  Tracer::Enable();
+  { DBC_TRACE_SPAN("test", "kept"); }
+  Tracer::Disable();
+  { DBC_TRACE_SPAN("test", "ignored"); }
+
+  const std::string json = Tracer::ToChromeTraceJson();
+  EXPECT_NE(json.find("\"kept\""), std::string::npos);
+  EXPECT_EQ(json.find("\"ignored\""), std::string::npos);
+}
+
+TEST_F(TraceTest, RecordsEachThreadOnItsOwnTrack) {
+  constexpr int kThreads = 4;
+  constexpr int kSpansPerThread = 1000;
+  Tracer::Enable();
+
+  // The workers stay alive until all have recorded: a thread that exits
+  // early would hand its buffer, and its track, to the next one
+  std::atomic<int> recorded{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&recorded] {
+      for (int i = 0; i < kSpansPerThread; ++i) {
+        DBC_TRACE_SPAN("test", "worker");
+      }
+      recorded.fetch_add(1);
+      while (recorded.load() < kThreads) {
+        std::this_thread::yield();
+      }
+    });
+  }
+  // Dumping while the workers record must be safe
+  const std::string partial = Tracer::ToChromeTraceJson();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  const std::string json = Tracer::ToChromeTraceJson();
+  EXPECT_EQ(CountOccurrences(json, "\"name\":\"worker\""), static_cast<std::size_t>(kThreads * kSpansPerThread));
+  for (int tid = 1; tid <= kThreads; ++tid) {
+    EXPECT_NE(json.find("\"tid\":" + std::to_string(tid) + "}"), std::string::npos) << tid;
+  }
+  EXPECT_LE(partial.size(), json.size());
+}
+
+TEST_F(TraceTest, ReusesBuffersOfExitedThreads) {
+  constexpr int kThreads = 50;
+  Tracer::Enable();
+
+  // One worker at a time, as a pipeline that starts new workers per batch
+  for (int t = 0; t < kThreads; ++t) {
+    std::thread([] { DBC_TRACE_SPAN("test", "short_lived"); }).join();
+  }
+
+  const std::string json = Tracer::ToChromeTraceJson();
+  EXPECT_EQ(CountOccurrences(json, "\"name\":\"short_lived\""), static_cast<std::size_t>(kThreads));
+  EXPECT_EQ(CountOccurrences(json, "\"tid\":1}"), static_cast<std::size_t>(kThreads));
+  EXPECT_EQ(json.find("\"tid\":2}"), std::string::npos);
+}
+
+TEST_F(TraceTest, WritesTraceFile) {
+  Tracer::Enable();
+  { DBC_TRACE_SPAN("test", "to_file"); }
+
+  const std::string path = ::testing::TempDir() + "trace_test.json";
+  ASSERT_TRUE(Tracer::WriteChromeTrace(path));
+  std::ifstream file(path);
+  std::stringstream contents;
+  contents << file.rdbuf();
+  EXPECT_EQ(contents.str(), Tracer::ToChromeTraceJson());
+  std::remove(path.c_str());
+}
+
+}  // namespace
+}  // namespace core
+}  // namespace dbc_parser
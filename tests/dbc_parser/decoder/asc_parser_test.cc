@@ -0,0 +1,122 @@
+#include "src/dbc_parser/decoder/asc_parser.h"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace dbc_parser {
+namespace decoder {
+namespace {
+
+TEST(AscParserTest, ParsesClassicFrame) {
+  const auto frame = AscParser::ParseLineHex(
+      "   1.234567 2  1A3             Rx   d 8 01 02 03 04 05 06 07 FF  Length = 0 BitCount = 0 ID = 419\r\n");
+  ASSERT_TRUE(frame.has_value());
+  EXPECT_EQ(frame->timestamp_ns, 1234567000);
+  EXPECT_EQ(frame->channel, 2);
+  EXPECT_EQ(frame->id, 0x1A3u);
+  EXPECT_FALSE(frame->is_extended());
+  EXPECT_FALSE(frame->is_fd());
+  EXPECT_FALSE(frame->flags & CanFrame::kTransmitted);
+  ASSERT_EQ(frame->size, 8);
+  EXPECT_EQ(frame->data[0], 0x01);
+  EXPECT_EQ(frame->data[7], 0xFF);
+}
+
+TEST(AscParserTest, ParsesExtendedTxFrame) {
+  const auto frame = AscParser::ParseLineHex("0.5 1 18FEF100x Tx d 3 AA BB CC");
+  ASSERT_TRUE(frame.has_value());
+  EXPECT_TRUE(frame->is_extended());
+  EXPECT_EQ(frame->id, 0x18FEF100u);
+  EXPECT_EQ(frame->dbc_id(), 0x98FEF100u);
+  EXPECT_TRUE(frame->flags & CanFrame::kTransmitted);
+  ASSERT_EQ(frame->size, 3);
+  EXPECT_EQ(frame->data[2], 0xCC);
+}
+
+TEST(AscParserTest, ParsesRemoteFrame) {
+  const auto frame = AscParser::ParseLineHex("0.010000 1  123  Rx   r 4");
+  ASSERT_TRUE(frame.has_value());
+  EXPECT_TRUE(frame->flags & CanFrame::kRemote);
+  EXPECT_EQ(frame->size, 4);
+  EXPECT_TRUE(AscParser::ParseLineHex("0.010000 1  123  Rx   r").has_value());
+}
+
+TEST(AscParserTest, ParsesFdFrameWithAndWithoutName) {
+  const auto named = AscParser::ParseLineHex(
+      "   2.000100 CANFD   3 Rx        1a0  EngineData  1 0 9 12 00 01 02 03 04 05 06 07 08 09 0a 0b   "
+      "130000  130 303000 c53e 4000 0 0 0");
+  ASSERT_TRUE(named.has_value());
+  EXPECT_TRUE(named->is_fd());
+  EXPECT_TRUE(named->flags & CanFrame::kBitRateSwitch);
+  EXPECT_FALSE(named->flags & CanFrame::kErrorStateIndicator);
+  EXPECT_EQ(named->channel, 3);
+  EXPECT_EQ(named->id, 0x1A0u);
+  ASSERT_EQ(named->size, 12);
+  EXPECT_EQ(named->data[11], 0x0B);
+
+  const auto unnamed = AscParser::ParseLineHex("2.0 CANFD 1 Tx 1FFFFFFFx 0 1 0 0");
+  ASSERT_TRUE(unnamed.has_value());
+  EXPECT_TRUE(unnamed->is_extended());
+  EXPECT_TRUE(unnamed->flags & CanFrame::kErrorStateIndicator);
+  EXPECT_EQ(unnamed->size, 0);
+}
+
+TEST(AscParserTest, ParsesDecimalBase) {
+  const auto frame = AscParser::ParseLineDec("1.0 1 2047 Rx d 2 255 16");
+  ASSERT_TRUE(frame.has_value());
+  EXPECT_EQ(frame->id, 2047u);
+  EXPECT_EQ(frame->data[0], 255);
+  EXPECT_EQ(frame->data[1], 16);
+  EXPECT_FALSE(AscParser::ParseLineDec("1.0 1 2048 Rx d 1 0").has_value());
+  EXPECT_FALSE(AscParser::ParseLineDec("1.0 1 100 Rx d 1 FF").has_value());
+}
+
+TEST(AscParserTest, RejectsEventsAndMalformedLines) {
+  for (const char* line : {
+           "   0.000000 Start of measurement",
+           "   1.000000 1  ErrorFrame",
+           "   1.000000 1  123  TxRq d 1 00",
+           "   1.000000 CAN 1 Status:chip status error active",
+           "End TriggerBlock",
+           "// version 9.0.0",
+           "1.0 1 800 Rx d 1 00",
+           "1.0 1 123 Rx d 4 00 01",
+           "1.0 1 123 Rx d 1 100",
+           "1.0 CANFD 1 Rx 123 1 0 a 13 00",
+           "1 1 123 Rx d 1 00",
+       }) {
+    EXPECT_FALSE(AscParser::ParseLineHex(line).has_value()) << line;
+  }
+  EXPECT_EQ(AscParser::ParseTimestamp("   1.000000 1  ErrorFrame"), std::optional<std::int64_t>(1000000000));
+  EXPECT_FALSE(AscParser::ParseTimestamp("End TriggerBlock").has_value());
+}
+
+TEST(AscParserTest, ParsesHeader) {
+  const std::string text =
+      "date Mon Sep 16 10:03:02.123 pm 2019\n"
+      "base dec  timestamps relative\r\n"
+      "internal events logged\n"
+      "// version 9.0.0\n"
+      "Begin Triggerblock Mon Sep 16 10:03:02.123 pm 2019\n"
+      "   0.000000 Start of measurement\n";
+  const AscHeader header = AscParser::ParseHeader(text);
+  EXPECT_EQ(header.date, "Mon Sep 16 10:03:02.123 pm 2019");
+  // 2019-09-16 22:03:02.123 UTC
+  EXPECT_EQ(header.start_ns, std::optional<std::int64_t>(1568671382123000000));
+  EXPECT_FALSE(header.hex_base);
+  EXPECT_TRUE(header.relative_timestamps);
+  EXPECT_EQ(text.substr(header.size), "   0.000000 Start of measurement\n");
+
+  const AscHeader defaults = AscParser::ParseHeader("date Mon Sep 16 10:03:02 2019\n0.1 1 123 Rx d 0\n");
+  EXPECT_EQ(defaults.start_ns, std::optional<std::int64_t>(1568628182000000000));
+  EXPECT_TRUE(defaults.hex_base);
+  EXPECT_FALSE(defaults.relative_timestamps);
+  EXPECT_EQ(defaults.size, 30u);
+}
+
+}  // namespace
+}  // namespace decoder
+}  // namespace dbc_parser
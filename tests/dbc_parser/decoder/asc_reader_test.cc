@@ -0,0 +1,141 @@
+#include "src/dbc_parser/decoder/asc_reader.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace dbc_parser {
+namespace decoder {
+namespace {
+
+using parser::DbcFile;
+using parser::Signal;
+using parser::TypeConverter;
+
+// BO_ 256 with Counter (byte 0) and Value (bytes 1-2)
+DbcFile MakeFile() {
+  DbcFile dbc_file;
+  DbcFile::MessageDef& message = dbc_file.messages_detailed[0x100];
+  message.id = 0x100;
+  message.name = "Status";
+  message.size = 8;
+  message.signal_count = 2;
+  for (auto [name, start_bit, length] : {std::tuple<const char*, int, int>{"Counter", 0, 8}, {"Value", 8, 16}}) {
+    Signal signal;
+    signal.name = name;
+    signal.start_bit = start_bit;
+    signal.length = length;
+    dbc_file.signal_layouts.push_back(TypeConverter::ToSignalLayout(signal));
+    dbc_file.signal_infos.push_back(TypeConverter::ToSignalInfo(std::move(signal), 0x100));
+  }
+  return dbc_file;
+}
+
+// count frames 1 ms apart, with a statistics event after every tenth frame
+std::string MakeTrace(int count, bool relative) {
+  std::string trace = "date Mon Sep 16 10:03:02.123 am 2019\n";
+  trace += relative ? "base hex  timestamps relative\n" : "base hex  timestamps absolute\n";
+  trace += "internal events logged\nBegin Triggerblock Mon Sep 16 10:03:02.123 am 2019\n";
+  trace += "   0.000000 Start of measurement\n";
+  for (int i = 0; i < count; ++i) {
+    char line[96];
+    const double seconds = relative ? (i == 0 ? 0.001 : (i % 10 == 0 ? 0.0005 : 0.001)) : 0.001 * (i + 1);
+    std::snprintf(line, sizeof(line), "%11.6f 1  100             Rx   d 3 %02X %02X %02X\n", seconds, i & 0xFF,
+                  (i * 3) & 0xFF, ((i * 3) >> 8) & 0xFF);
+    trace += line;
+    if (i % 10 == 9) {
+      // In relative traces, half of the next frame's delta
+      std::snprintf(line, sizeof(line), "%11.6f CAN 1 Status:chip status error active\n",
+                    relative ? 0.0005 : 0.001 * (i + 1));
+      trace += line;
+    }
+  }
+  return trace + "End TriggerBlock\n";
+}
+
+struct Collected {
+  std::vector<std::int64_t> timestamps;
+  std::vector<double> counters;
+};
+
+LogDecoder::FrameCallback Collect(Collected& collected) {
+  return [&collected](const DecodedFrame& decoded) {
+    collected.timestamps.push_back(decoded.frame->timestamp_ns);
+    ASSERT_NE(decoded.message, nullptr);
+    collected.counters.push_back(decoded.values[0]);
+  };
+}
+
+void ExpectFramesInOrder(const Collected& collected, int count) {
+  ASSERT_EQ(collected.timestamps.size(), static_cast<std::size_t>(count));
+  for (int i = 0; i < count; ++i) {
+    EXPECT_EQ(collected.timestamps[i], (i + 1) * 1000000) << i;
+    EXPECT_EQ(collected.counters[i], i & 0xFF) << i;
+  }
+}
+
+TEST(AscReaderTest, DecodesAbsoluteTraceAcrossChunks) {
+  const DbcFile dbc_file = MakeFile();
+  const FrameDecoder frame_decoder(dbc_file);
+  const std::string trace = MakeTrace(500, false);
+
+  LogDecodeOptions options;
+  options.threads = 3;
+  options.chunk_bytes = 200;
+  Collected collected;
+  AscHeader header;
+  const LogDecodeStats stats = AscReader(frame_decoder, options).Decode(trace, Collect(collected), &header);
+
+  EXPECT_EQ(stats.bytes, trace.size());
+  EXPECT_GT(stats.chunks, 10u);
+  EXPECT_EQ(stats.frames, 500u);
+  // Start of measurement, 50 statistics events, End TriggerBlock
+  EXPECT_EQ(stats.malformed_lines, 52u);
+  EXPECT_EQ(stats.signals, 1000u);
+  EXPECT_EQ(stats.late_frames, 0u);
+  EXPECT_TRUE(header.start_ns.has_value());
+  ExpectFramesInOrder(collected, 500);
+}
+
+TEST(AscReaderTest, AccumulatesRelativeTimestampsAcrossChunks) {
+  const DbcFile dbc_file = MakeFile();
+  const FrameDecoder frame_decoder(dbc_file);
+  const std::string trace = MakeTrace(500, true);
+
+  for (const std::size_t chunk_bytes : {std::size_t{64}, std::size_t{1000}, std::size_t{1} << 20}) {
+    LogDecodeOptions options;
+    options.threads = 4;
+    options.chunk_bytes = chunk_bytes;
+    Collected collected;
+    AscHeader header;
+    const LogDecodeStats stats = AscReader(frame_decoder, options).Decode(trace, Collect(collected), &header);
+    EXPECT_TRUE(header.relative_timestamps);
+    EXPECT_EQ(stats.frames, 500u);
+    ExpectFramesInOrder(collected, 500);
+  }
+}
+
+TEST(AscReaderTest, DecodesFile) {
+  const DbcFile dbc_file = MakeFile();
+  const FrameDecoder frame_decoder(dbc_file);
+  const std::string path = ::testing::TempDir() + "asc_reader_test.asc";
+  std::ofstream(path, std::ios::binary) << MakeTrace(100, false);
+
+  Collected collected;
+  const auto stats = AscReader(frame_decoder).DecodeFile(path, Collect(collected));
+  ASSERT_TRUE(stats.has_value());
+  EXPECT_EQ(stats->frames, 100u);
+  ExpectFramesInOrder(collected, 100);
+  EXPECT_FALSE(AscReader(frame_decoder).DecodeFile(path + ".missing").has_value());
+  std::remove(path.c_str());
+}
+
+}  // namespace
+}  // namespace decoder
+}  // namespace dbc_parser
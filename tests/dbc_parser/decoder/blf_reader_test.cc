@@ -0,0 +1,368 @@
+#include "src/dbc_parser/decoder/blf_reader.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace dbc_parser {
+namespace decoder {
+namespace {
+
+using parser::DbcFile;
+using parser::Signal;
+using parser::TypeConverter;
+
+// BO_ 256 with Counter (byte 0) and Value (bytes 1-2)
+DbcFile MakeFile() {
+  DbcFile dbc_file;
+  DbcFile::MessageDef& message = dbc_file.messages_detailed[0x100];
+  message.id = 0x100;
+  message.name = "Status";
+  message.size = 8;
+  message.signal_count = 2;
+  for (auto [name, start_bit, length] : {std::tuple<const char*, int, int>{"Counter", 0, 8}, {"Value", 8, 16}}) {
+    Signal signal;
+    signal.name = name;
+    signal.start_bit = start_bit;
+    signal.length = length;
+    dbc_file.signal_layouts.push_back(TypeConverter::ToSignalLayout(signal));
+    dbc_file.signal_infos.push_back(TypeConverter::ToSignalInfo(std::move(signal), 0x100));
+  }
+  return dbc_file;
+}
+
+void Put(std::string& out, std::uint64_t value, int bytes) {
+  for (int i = 0; i < bytes; ++i) {
+    out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+  }
+}
+
+// An object with a version 1 header and a nanosecond timestamp
+std::string Object(std::uint32_t type, std::int64_t timestamp_ns, const std::string& body) {
+  std::string object = "LOBJ";
+  Put(object, 32, 2);
+  Put(object, 1, 2);
+  Put(object, 32 + body.size(), 4);
+  Put(object, type, 4);
+  Put(object, 2, 4);
+  Put(object, 0, 4);
+  Put(object, static_cast<std::uint64_t>(timestamp_ns), 8);
+  return object + body;
+}
+
+std::string CanMessage(std::int64_t timestamp_ns, std::uint32_t id, const std::string& data, std::uint8_t flags = 0) {
+  std::string body;
+  Put(body, 1, 2);
+  Put(body, flags, 1);
+  Put(body, data.size(), 1);
+  Put(body, id, 4);
+  body += data;
+  body.resize(16, '\0');
+  return Object(1, timestamp_ns, body);
+}
+
+std::string CanFdMessage64(std::int64_t timestamp_ns, std::uint32_t id, const std::string& data, std::uint32_t flags,
+                           bool transmitted) {
+  std::string body;
+  Put(body, 2, 1);
+  Put(body, 0xD, 1);
+  Put(body, data.size(), 1);
+  Put(body, 0, 1);
+  Put(body, id, 4);
+  Put(body, 0, 4);
+  Put(body, flags, 4);
+  body.resize(34, '\0');
+  Put(body, transmitted ? 1 : 0, 1);
+  body.resize(40, '\0');
+  return Object(101, timestamp_ns, body + data);
+}
+
+std::string StatusFrame(int counter) {
+  return {static_cast<char>(counter & 0xFF), static_cast<char>((counter * 3) & 0xFF),
+          static_cast<char>(((counter * 3) >> 8) & 0xFF)};
+}
+
+// A file whose object stream is cut into containers of container_bytes, so
+// objects and even headers continue from one container into the next
+std::string MakeBlf(const std::vector<std::string>& objects, std::size_t container_bytes, bool compress = true) {
+  std::string stream;
+  for (const std::string& object : objects) {
+    stream += object;
+    stream.append(object.size() % 4, '\0');
+  }
+
+  std::string file = "LOGG";
+  Put(file, 144, 4);
+  Put(file, 5, 1);
+  file.resize(32, '\0');
+  Put(file, objects.size(), 4);
+  Put(file, 0, 4);
+  for (const int field : {2019, 9, 1, 16, 10, 3, 2, 123}) {
+    Put(file, static_cast<std::uint64_t>(field), 2);
+  }
+  file.resize(144, '\0');
+
+  for (std::size_t pos = 0; pos < stream.size(); pos += container_bytes) {
+    const std::string slice = stream.substr(pos, container_bytes);
+    std::string payload = slice;
+    if (compress) {
+      uLongf size = compressBound(static_cast<uLong>(slice.size()));
+      payload.resize(size);
+      compress2(reinterpret_cast<Bytef*>(payload.data()), &size, reinterpret_cast<const Bytef*>(slice.data()),
+                static_cast<uLong>(slice.size()), Z_DEFAULT_COMPRESSION);
+      payload.resize(size);
+    }
+    std::string body;
+    Put(body, compress ? 2 : 0, 2);
+    body.resize(8, '\0');
+    Put(body, slice.size(), 4);
+    body.resize(16, '\0');
+    const std::string container = Object(10, 0, body + payload);
+    file += container;
+    file.append(container.size() % 4, '\0');
+  }
+  return file;
+}
+
+// count Status frames 1 ms apart, with a non-CAN object after every tenth
+std::vector<std::string> MakeObjects(int count) {
+  std::vector<std::string> objects;
+  for (int i = 0; i < count; ++i) {
+    objects.push_back(CanMessage((i + 1) * std::int64_t{1000000}, 0x100, StatusFrame(i)));
+    if (i % 10 == 9) {
+      objects.push_back(Object(96, (i + 1) * std::int64_t{1000000}, std::string(13, 'm')));
+    }
+  }
+  return objects;
+}
+
+struct Collected {
+  std::vector<CanFrame> frames;
+  std::vector<double> counters;
+};
+
+LogDecoder::FrameCallback Collect(Collected& collected) {
+  return [&collected](const DecodedFrame& decoded) {
+    collected.frames.push_back(*decoded.frame);
+    collected.counters.push_back(decoded.message != nullptr ? decoded.values[0] : -1.0);
+  };
+}
+
+TEST(BlfReaderTest, DecodesObjectsSplitAcrossContainers) {
+  const DbcFile dbc_file = MakeFile();
+  const FrameDecoder frame_decoder(dbc_file);
+  const std::vector<std::string> objects = MakeObjects(1000);
+
+  for (const std::size_t container_bytes : {std::size_t{7}, std::size_t{37}, std::size_t{1000}, std::size_t{1} << 20}) {
+    SCOPED_TRACE(container_bytes);
+    LogDecodeOptions options;
+    options.threads = 3;
+    Collected collected;
+    const auto stats = BlfReader(frame_decoder, options).Decode(MakeBlf(objects, container_bytes), Collect(collected));
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats->lines, 1100u);
+    EXPECT_EQ(stats->frames, 1000u);
+    EXPECT_EQ(stats->malformed_lines, 100u);
+    EXPECT_EQ(stats->signals, 2000u);
+    EXPECT_EQ(stats->late_frames, 0u);
+    ASSERT_EQ(collected.frames.size(), 1000u);
+    for (int i = 0; i < 1000; ++i) {
+      EXPECT_EQ(collected.frames[i].timestamp_ns, (i + 1) * 1000000) << i;
+      EXPECT_EQ(collected.counters[i], i & 0xFF) << i;
+    }
+
+    // Counting alone takes the same path without the merge
+    const auto counted = BlfReader(frame_decoder, options).Decode(MakeBlf(objects, container_bytes));
+    ASSERT_TRUE(counted.has_value());
+    EXPECT_EQ(counted->frames, 1000u);
+    EXPECT_EQ(counted->chunks, stats->chunks);
+
+    // Workers see every frame they decode
+    std::vector<std::uint64_t> worker_frames(options.MaxThreads());
+    options.on_worker_frame = [&worker_frames](std::size_t worker, const DecodedFrame& decoded) {
+      EXPECT_NE(decoded.message, nullptr);
+      ++worker_frames[worker];
+    };
+    ASSERT_TRUE(BlfReader(frame_decoder, options).Decode(MakeBlf(objects, container_bytes)).has_value());
+    EXPECT_EQ(std::accumulate(worker_frames.begin(), worker_frames.end(), std::uint64_t{0}), 1000u);
+  }
+}
+
+// A container header claiming 4 GiB uncompressed is skipped as malformed
+// without allocating, and the next container decodes from its first object
+TEST(BlfReaderTest, SkipsContainerWithCorruptUncompressedSize) {
+  const DbcFile dbc_file = MakeFile();
+  const FrameDecoder frame_decoder(dbc_file);
+  const std::string second = MakeBlf(MakeObjects(10), std::size_t{1} << 20);
+  std::string blf = MakeBlf(MakeObjects(10), std::size_t{1} << 20) + second.substr(144);
+  // File header, container object header, then the uncompressed size at 8
+  const std::size_t uncompressed_size = 144 + 32 + 8;
+  blf.replace(uncompressed_size, 4, "\xFF\xFF\xFF\xFF");
+
+  for (const std::size_t threads : {std::size_t{1}, std::size_t{2}}) {
+    LogDecodeOptions options;
+    options.threads = threads;
+    Collected collected;
+    const auto stats = BlfReader(frame_decoder, options).Decode(blf, Collect(collected));
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats->chunks, 2u);
+    EXPECT_EQ(stats->frames, 10u);
+    // The broken container plus the non-CAN object of the other one
+    EXPECT_EQ(stats->malformed_lines, 2u);
+    ASSERT_EQ(collected.frames.size(), 10u);
+    EXPECT_EQ(collected.frames.front().timestamp_ns, 1000000);
+  }
+}
+
+TEST(BlfReaderTest, ParsesCanAndCanFdObjects) {
+  const DbcFile dbc_file = MakeFile();
+  const FrameDecoder frame_decoder(dbc_file);
+  const std::string fd_data(12, '\x5A');
+  const std::string blf = MakeBlf(
+      {
+          CanMessage(1000, 0x100, StatusFrame(7), 0x01),
+          CanMessage(2000, 0x98FEF100u, "", 0x80),
+          CanFdMessage64(3000, 0x123, fd_data, 0x1000 | 0x2000, true),
+          CanFdMessage64(4000, 0x80000123u, "\x01\x02", 0x4000, false),
+      },
+      64, false);
+
+  Collected collected;
+  const auto stats = BlfReader(frame_decoder).Decode(blf, Collect(collected));
+  ASSERT_TRUE(stats.has_value());
+  ASSERT_EQ(collected.frames.size(), 4u);
+
+  const CanFrame& classic = collected.frames[0];
+  EXPECT_EQ(classic.channel, 1);
+  EXPECT_EQ(classic.id, 0x100u);
+  EXPECT_TRUE(classic.flags & CanFrame::kTransmitted);
+  EXPECT_EQ(collected.counters[0], 7.0);
+
+  const CanFrame& remote = collected.frames[1];
+  EXPECT_TRUE(remote.is_extended());
+  EXPECT_EQ(remote.id, 0x18FEF100u);
+  EXPECT_TRUE(remote.flags & CanFrame::kRemote);
+
+  const CanFrame& fd = collected.frames[2];
+  EXPECT_EQ(fd.channel, 2);
+  EXPECT_TRUE(fd.is_fd());
+  EXPECT_TRUE(fd.flags & CanFrame::kBitRateSwitch);
+  EXPECT_TRUE(fd.flags & CanFrame::kTransmitted);
+  ASSERT_EQ(fd.size, 12);
+  EXPECT_EQ(fd.data[11], 0x5A);
+
+  const CanFrame& classic_on_fd = collected.frames[3];
+  EXPECT_FALSE(classic_on_fd.is_fd());
+  EXPECT_TRUE(classic_on_fd.is_extended());
+  EXPECT_TRUE(classic_on_fd.flags & CanFrame::kErrorStateIndicator);
+  EXPECT_EQ(classic_on_fd.size, 2);
+}
+
+TEST(BlfReaderTest, ReadsHeaderAndRejectsOtherFiles) {
+  const DbcFile dbc_file = MakeFile();
+  const FrameDecoder frame_decoder(dbc_file);
+  BlfHeader header;
+  ASSERT_TRUE(BlfReader(frame_decoder).Decode(MakeBlf(MakeObjects(10), 100), nullptr, &header).has_value());
+  EXPECT_EQ(header.application_id, 5);
+  EXPECT_EQ(header.object_count, 11u);
+  EXPECT_EQ(header.size, 144u);
+  // 2019-09-16 10:03:02.123 UTC
+  EXPECT_EQ(header.start_ns, std::optional<std::int64_t>(1568628182123000000));
+  EXPECT_FALSE(header.stop_ns.has_value());
+
+  EXPECT_FALSE(BlfReader(frame_decoder).Decode("(1.0) can0 123#00\n").has_value());
+}
+
+TEST(BlfReaderTest, SeeksToTimeOffset) {
+  const DbcFile dbc_file = MakeFile();
+  const FrameDecoder frame_decoder(dbc_file);
+  const std::string blf = MakeBlf(MakeObjects(2000), 256);
+  const auto all = BlfReader(frame_decoder).Decode(blf);
+  ASSERT_TRUE(all.has_value());
+
+  for (const std::size_t threads : {std::size_t{1}, std::size_t{4}}) {
+    LogDecodeOptions options;
+    options.threads = threads;
+    Collected collected;
+    const auto stats = BlfReader(frame_decoder, options).Decode(blf, Collect(collected), nullptr, 1500000000);
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats->frames, 501u);
+    ASSERT_EQ(collected.frames.size(), 501u);
+    EXPECT_EQ(collected.frames.front().timestamp_ns, 1500000000);
+    EXPECT_EQ(collected.frames.back().timestamp_ns, 2000000000);
+    EXPECT_LT(stats->chunks, all->chunks / 3);
+    EXPECT_LT(stats->bytes, all->bytes / 3);
+  }
+}
+
+TEST(BlfReaderTest, DecodesRangesOfContainers) {
+  const DbcFile dbc_file = MakeFile();
+  const FrameDecoder frame_decoder(dbc_file);
+  const std::string blf = MakeBlf(MakeObjects(500), 100);
+
+  LogDecodeOptions options;
+  options.threads = 2;
+  std::vector<LogChunk> chunks;
+  std::vector<std::vector<std::int64_t>> timestamps;
+  options.on_chunk = [&](const LogChunk& chunk) {
+    chunks.push_back(chunk);
+    timestamps.emplace_back();
+    for (std::size_t i = 0; i < chunk.frame_count; ++i) {
+      timestamps.back().push_back(chunk.frames[i].timestamp_ns);
+    }
+  };
+  const BlfReader reader(frame_decoder, options);
+  ASSERT_TRUE(reader.Decode(blf).has_value());
+  ASSERT_EQ(chunks.size(), 263u);
+  EXPECT_EQ(chunks.front().offset, 144u);
+  EXPECT_EQ(chunks.back().offset + chunks.back().size, blf.size());
+
+  // From the container before a run, every frame of the run is decoded once
+  for (const auto& [first, last] : {std::pair<std::size_t, std::size_t>{0, 10}, {17, 18}, {100, 263}}) {
+    SCOPED_TRACE(first);
+    const std::size_t begin = first == 0 ? 0 : chunks[first - 1].offset;
+    const std::size_t end = chunks[last - 1].offset + chunks[last - 1].size;
+    Collected collected;
+    ASSERT_TRUE(reader.DecodeRange(blf, begin, end, Collect(collected)).has_value());
+    std::vector<std::int64_t> expected;
+    for (std::size_t i = first; i < last; ++i) {
+      expected.insert(expected.end(), timestamps[i].begin(), timestamps[i].end());
+    }
+    // Plus the frames that start in the container before, if any
+    std::vector<std::int64_t> decoded;
+    for (const CanFrame& frame : collected.frames) {
+      decoded.push_back(frame.timestamp_ns);
+    }
+    const std::size_t extra = decoded.size() - std::min(decoded.size(), expected.size());
+    EXPECT_LE(extra, first == 0 ? 0 : timestamps[first - 1].size());
+    EXPECT_EQ(std::vector<std::int64_t>(decoded.begin() + extra, decoded.end()), expected);
+  }
+  EXPECT_FALSE(reader.DecodeRange("LOGG", 0, 4).has_value());
+}
+
+TEST(BlfReaderTest, DecodesFile) {
+  const DbcFile dbc_file = MakeFile();
+  const FrameDecoder frame_decoder(dbc_file);
+  const std::string path = ::testing::TempDir() + "blf_reader_test.blf";
+  std::ofstream(path, std::ios::binary) << MakeBlf(MakeObjects(100), 1000);
+
+  const auto stats = BlfReader(frame_decoder).DecodeFile(path);
+  ASSERT_TRUE(stats.has_value());
+  EXPECT_EQ(stats->frames, 100u);
+  EXPECT_FALSE(BlfReader(frame_decoder).DecodeFile(path + ".missing").has_value());
+  std::remove(path.c_str());
+}
+
+}  // namespace
+}  // namespace decoder
+}  // namespace dbc_parser
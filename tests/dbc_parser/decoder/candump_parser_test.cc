@@ -0,0 +1,90 @@
+#include "src/dbc_parser/decoder/candump_parser.h"
+
+#include <cstdint>
+#include <optional>
+
+#include "gtest/gtest.h"
+
+namespace dbc_parser {
+namespace decoder {
+namespace {
+
+TEST(CandumpParserTest, ParsesClassicFrame) {
+  const auto frame = CandumpParser::ParseLine("(1436509052.249713) can0 123#DEADBEEF\n");
+  ASSERT_TRUE(frame.has_value());
+  EXPECT_EQ(frame->timestamp_ns, 1436509052249713000);
+  EXPECT_EQ(frame->channel, 0);
+  EXPECT_EQ(frame->id, 0x123u);
+  EXPECT_EQ(frame->dbc_id(), 0x123u);
+  EXPECT_FALSE(frame->is_extended());
+  EXPECT_FALSE(frame->is_fd());
+  ASSERT_EQ(frame->size, 4);
+  EXPECT_EQ(frame->data[0], 0xDE);
+  EXPECT_EQ(frame->data[3], 0xEF);
+  EXPECT_EQ(frame->data[4], 0);
+}
+
+TEST(CandumpParserTest, ParsesExtendedFrameWithDbcIdFlag) {
+  const auto frame = CandumpParser::ParseLine("(0.5) vcan12 1F334455#1122334455667788\r\n");
+  ASSERT_TRUE(frame.has_value());
+  EXPECT_EQ(frame->timestamp_ns, 500000000);
+  EXPECT_EQ(frame->channel, 12);
+  EXPECT_TRUE(frame->is_extended());
+  EXPECT_EQ(frame->id, 0x1F334455u);
+  EXPECT_EQ(frame->dbc_id(), 0x9F334455u);
+  EXPECT_EQ(frame->size, 8);
+}
+
+TEST(CandumpParserTest, ParsesFdFrameWithFlags) {
+  const auto frame = CandumpParser::ParseLine("(1.000000) can1 0A0##3000102030405060708090A0B");
+  ASSERT_TRUE(frame.has_value());
+  EXPECT_TRUE(frame->is_fd());
+  EXPECT_TRUE(frame->flags & CanFrame::kBitRateSwitch);
+  EXPECT_TRUE(frame->flags & CanFrame::kErrorStateIndicator);
+  ASSERT_EQ(frame->size, 12);
+  EXPECT_EQ(frame->data[11], 0x0B);
+}
+
+TEST(CandumpParserTest, ParsesRemoteFrame) {
+  const auto frame = CandumpParser::ParseLine("(1.0) can0 123#R3");
+  ASSERT_TRUE(frame.has_value());
+  EXPECT_TRUE(frame->flags & CanFrame::kRemote);
+  EXPECT_EQ(frame->size, 3);
+}
+
+TEST(CandumpParserTest, AcceptsEmptyPayloadAndRawDlc) {
+  auto frame = CandumpParser::ParseLine("(1.0) can0 123#");
+  ASSERT_TRUE(frame.has_value());
+  EXPECT_EQ(frame->size, 0);
+
+  frame = CandumpParser::ParseLine("(1.0) can0 123#1122334455667788_C");
+  ASSERT_TRUE(frame.has_value());
+  EXPECT_EQ(frame->size, 8);
+}
+
+TEST(CandumpParserTest, RejectsMalformedLines) {
+  EXPECT_FALSE(CandumpParser::ParseLine("").has_value());
+  EXPECT_FALSE(CandumpParser::ParseLine("can0 123#00").has_value());
+  EXPECT_FALSE(CandumpParser::ParseLine("(1.0)can0 123#00").has_value());
+  EXPECT_FALSE(CandumpParser::ParseLine("(1.0) can0 1234#00").has_value());
+  EXPECT_FALSE(CandumpParser::ParseLine("(1.0) can0 800#00").has_value());
+  EXPECT_FALSE(CandumpParser::ParseLine("(1.0) can0 123#0").has_value());
+  EXPECT_FALSE(CandumpParser::ParseLine("(1.0) can0 123#001122334455667788").has_value());
+  EXPECT_FALSE(CandumpParser::ParseLine("(1.0) can0 123##0001020304050607080910").has_value());
+  EXPECT_FALSE(CandumpParser::ParseLine("(1.0) can0 123#00 trailing").has_value());
+}
+
+// Seconds up to 9223372035 fit int64 nanoseconds with any fraction; larger
+// ten-digit values would overflow
+TEST(CandumpParserTest, RejectsTimestampsThatOverflowNanoseconds) {
+  auto frame = CandumpParser::ParseLine("(9223372035.999999999) can0 123#00");
+  ASSERT_TRUE(frame.has_value());
+  EXPECT_EQ(frame->timestamp_ns, INT64_C(9223372035999999999));
+
+  EXPECT_FALSE(CandumpParser::ParseLine("(9223372036.000000000) can0 123#00").has_value());
+  EXPECT_FALSE(CandumpParser::ParseLine("(9999999999.999999) can0 123#00").has_value());
+}
+
+}  // namespace
+}  // namespace decoder
+}  // namespace dbc_parser
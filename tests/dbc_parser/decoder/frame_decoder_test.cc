@@ -0,0 +1,175 @@
+#include "src/dbc_parser/decoder/frame_decoder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace dbc_parser {
+namespace decoder {
+namespace {
+
+using parser::DbcFile;
+using parser::Signal;
+using parser::TypeConverter;
+
+Signal MakeSignal(std::string name, int start_bit, int length, double factor = 1.0) {
+  Signal signal;
+  signal.name = std::move(name);
+  signal.start_bit = start_bit;
+  signal.length = length;
+  signal.factor = factor;
+  return signal;
+}
+
+void AddMessage(DbcFile& dbc_file, std::uint32_t dbc_id, int size, std::vector<Signal> signals) {
+  const auto id = static_cast<int>(dbc_id);
+  DbcFile::MessageDef& message = dbc_file.messages_detailed[id];
+  message.id = id;
+  message.name = "Message" + std::to_string(dbc_id & 0xFFFF);
+  message.size = size;
+  message.first_signal = static_cast<std::uint32_t>(dbc_file.signal_layouts.size());
+  message.signal_count = static_cast<std::uint32_t>(signals.size());
+  for (Signal& signal : signals) {
+    dbc_file.signal_layouts.push_back(TypeConverter::ToSignalLayout(signal));
+    dbc_file.signal_infos.push_back(TypeConverter::ToSignalInfo(std::move(signal), id));
+  }
+}
+
+CanFrame MakeFrame(std::uint32_t id, bool extended, std::vector<std::uint8_t> payload) {
+  CanFrame frame;
+  frame.id = id;
+  frame.flags = extended ? CanFrame::kExtended : 0;
+  frame.size = static_cast<std::uint8_t>(payload.size());
+  std::copy(payload.begin(), payload.end(), frame.data);
+  return frame;
+}
+
+TEST(FrameDecoderTest, DecodesStandardAndExtendedFrames) {
+  DbcFile dbc_file;
+  AddMessage(dbc_file, 0x100, 8, {MakeSignal("Speed", 0, 16, 0.1), MakeSignal("Gear", 16, 4)});
+  AddMessage(dbc_file, 0x80000000u | 0x18FEF100u, 8, {MakeSignal("Rpm", 8, 16)});
+  const FrameDecoder decoder(dbc_file);
+  ASSERT_EQ(decoder.MessageCount(), 2u);
+  ASSERT_EQ(decoder.MaxSignalCount(), 2u);
+
+  double values[2];
+  auto decoded = decoder.Decode(MakeFrame(0x100, false, {0xE8, 0x03, 0x05, 0, 0, 0, 0, 0}), values);
+  ASSERT_TRUE(decoded.has_value());
+  EXPECT_EQ(*decoded, 2u);
+  EXPECT_DOUBLE_EQ(values[0], 100.0);
+  EXPECT_DOUBLE_EQ(values[1], 5.0);
+
+  decoded = decoder.Decode(MakeFrame(0x18FEF100u, true, {0, 0x34, 0x12, 0, 0, 0, 0, 0}), values);
+  ASSERT_TRUE(decoded.has_value());
+  EXPECT_EQ(*decoded, 1u);
+  EXPECT_DOUBLE_EQ(values[0], 0x1234);
+}
+
+TEST(FrameDecoderTest, UnknownIdsAreNotDecoded) {
+  DbcFile dbc_file;
+  AddMessage(dbc_file, 0x100, 8, {MakeSignal("Speed", 0, 16)});
+  const FrameDecoder decoder(dbc_file);
+
+  double value = 0.0;
+  EXPECT_FALSE(decoder.Decode(MakeFrame(0x101, false, {1, 2}), &value).has_value());
+  // Same number, but an extended frame is a different message
+  EXPECT_FALSE(decoder.Decode(MakeFrame(0x100, true, {1, 2}), &value).has_value());
+  EXPECT_EQ(decoder.Find(0x7FF), nullptr);
+  ASSERT_NE(decoder.Find(0x100), nullptr);
+  EXPECT_EQ(decoder.Find(0x100)->message->name, "Message256");
+}
+
+TEST(FrameDecoderTest, ShortPayloadProducesNaN) {
+  DbcFile dbc_file;
+  AddMessage(dbc_file, 0x200, 8, {MakeSignal("Low", 0, 8), MakeSignal("High", 56, 8)});
+  const FrameDecoder decoder(dbc_file);
+
+  double values[2];
+  const auto decoded = decoder.Decode(MakeFrame(0x200, false, {7}), values);
+  ASSERT_TRUE(decoded.has_value());
+  EXPECT_EQ(*decoded, 1u);
+  EXPECT_DOUBLE_EQ(values[0], 7.0);
+  EXPECT_TRUE(std::isnan(values[1]));
+}
+
+TEST(FrameDecoderTest, EncodesAndDecodesCanFdFrames) {
+  DbcFile dbc_file;
+  AddMessage(dbc_file, 0x80000000u | 0x123u, 20,
+             {MakeSignal("Head", 0, 8), MakeSignal("Wide", 84, 64), MakeSignal("Tail", 152, 8, 0.5)});
+  DbcFile::MessageDef& message = dbc_file.messages_detailed.begin()->second;
+  message.frame_format = parser::FrameFormat::kExtendedCanFd;
+  message.bit_rate_switch = true;
+  AddMessage(dbc_file, 0x200, 8, {MakeSignal("Low", 0, 8)});
+  const FrameDecoder decoder(dbc_file);
+
+  const double values[3] = {7.0, 4096.0, 21.5};
+  CanFrame frame;
+  const auto encoded = decoder.Encode(0x80000123u, values, frame);
+  ASSERT_TRUE(encoded.has_value());
+  EXPECT_EQ(*encoded, 3u);
+  EXPECT_EQ(frame.id, 0x123u);
+  EXPECT_EQ(frame.flags, CanFrame::kExtended | CanFrame::kFd | CanFrame::kBitRateSwitch);
+  EXPECT_EQ(frame.size, 20u);
+  EXPECT_EQ(frame.data[19], 43);
+
+  double decoded[3];
+  ASSERT_EQ(decoder.Decode(frame, decoded), std::optional<std::size_t>(3));
+  EXPECT_DOUBLE_EQ(decoded[0], 7.0);
+  EXPECT_DOUBLE_EQ(decoded[1], 4096.0);
+  EXPECT_DOUBLE_EQ(decoded[2], 21.5);
+
+  // A CAN FD size that is not a DLC size is rounded up; classic frames stay classic
+  message.size = 18;
+  const FrameDecoder resized(dbc_file);
+  ASSERT_TRUE(resized.Encode(0x80000123u, values, frame).has_value());
+  EXPECT_EQ(frame.size, 20u);
+  ASSERT_TRUE(resized.Encode(0x200, values, frame).has_value());
+  EXPECT_EQ(frame.flags, 0);
+  EXPECT_EQ(frame.size, 8u);
+  EXPECT_FALSE(resized.Encode(0x201, values, frame).has_value());
+}
+
+TEST(FrameDecoderTest, FindsJ1939MessagesByPgn) {
+  DbcFile dbc_file;
+  // EEC1 (PGN 0xF004) from source 0x00, priority 3
+  AddMessage(dbc_file, 0x80000000u | 0x0CF00400u, 8, {MakeSignal("Rpm", 24, 16, 0.125)});
+  // A PDU1 group (PGN 0xEF00) to the global address
+  AddMessage(dbc_file, 0x80000000u | 0x18EFFF00u, 8, {MakeSignal("Command", 0, 8)});
+  // Classic extended CAN, not indexed by PGN
+  AddMessage(dbc_file, 0x80000000u | 0x18FEF100u, 8, {MakeSignal("Speed", 8, 16)});
+  dbc_file.messages_detailed.at(static_cast<int>(0x8CF00400u)).frame_format = parser::FrameFormat::kJ1939;
+  dbc_file.messages_detailed.at(static_cast<int>(0x98EFFF00u)).frame_format = parser::FrameFormat::kJ1939;
+  dbc_file.messages_detailed.at(static_cast<int>(0x98FEF100u)).frame_format = parser::FrameFormat::kExtendedCan;
+  const FrameDecoder decoder(dbc_file);
+
+  ASSERT_NE(decoder.FindPgn(0xF004), nullptr);
+  EXPECT_EQ(decoder.FindPgn(0xF004)->message->name, "Message1024");
+  EXPECT_EQ(decoder.FindPgn(0xFEF1), nullptr);
+
+  // Another source address and priority
+  double value = 0.0;
+  auto decoded = decoder.Decode(MakeFrame(0x18F00417u, true, {0, 0, 0, 0x40, 0x1F, 0, 0, 0}), &value);
+  ASSERT_TRUE(decoded.has_value());
+  EXPECT_DOUBLE_EQ(value, 1000.0);
+  // Another destination address of the PDU1 group
+  EXPECT_EQ(decoder.Find(0x80000000u | 0x18EF2131u), decoder.FindPgn(0xEF00));
+  // Standard IDs and non-J1939 messages still need the exact ID
+  EXPECT_EQ(decoder.Find(0x80000000u | 0x18FEF103u), nullptr);
+  EXPECT_NE(decoder.Find(0x80000000u | 0x18FEF100u), nullptr);
+  EXPECT_EQ(decoder.Find(0x404), nullptr);
+
+  FrameDecoderOptions options;
+  options.j1939_all_extended = true;
+  const FrameDecoder all_extended(dbc_file, options);
+  EXPECT_EQ(all_extended.Find(0x80000000u | 0x18FEF103u), all_extended.Find(0x80000000u | 0x18FEF100u));
+}
+
+}  // namespace
+}  // namespace decoder
+}  // namespace dbc_parser
@@ -0,0 +1,276 @@
+#include "src/dbc_parser/decoder/j1939_reassembler.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace dbc_parser {
+namespace decoder {
+namespace {
+
+using parser::DbcFile;
+using parser::Signal;
+using parser::TypeConverter;
+
+constexpr std::uint32_t kDm1Pgn = 0xFECA;
+constexpr std::uint32_t kComponentIdPgn = 0xFEEB;
+constexpr std::uint8_t kBam = 32;
+constexpr std::uint8_t kRts = 16;
+constexpr std::uint8_t kCts = 17;
+constexpr std::uint8_t kEndOfMessageAck = 19;
+constexpr std::uint8_t kAbort = 255;
+
+// DM1 from source 0x00 with the lamp byte, the first SPN and a signal in
+// the third packet
+DbcFile MakeFile() {
+  DbcFile dbc_file;
+  const auto id = static_cast<int>(0x80000000u | 0x18FECA00u);
+  DbcFile::MessageDef& message = dbc_file.messages_detailed[id];
+  message.id = id;
+  message.name = "DM1";
+  message.size = 20;
+  message.frame_format = parser::FrameFormat::kJ1939;
+  message.signal_count = 3;
+  for (auto [name, start_bit, length] : {std::tuple<const char*, int, int>{"Lamps", 0, 8}, {"Spn", 16, 19},
+                                         {"Tail", 136, 16}}) {
+    Signal signal;
+    signal.name = name;
+    signal.start_bit = start_bit;
+    signal.length = length;
+    dbc_file.signal_layouts.push_back(TypeConverter::ToSignalLayout(signal));
+    dbc_file.signal_infos.push_back(TypeConverter::ToSignalInfo(std::move(signal), id));
+  }
+  return dbc_file;
+}
+
+CanFrame Frame(std::int64_t timestamp_ns, std::uint32_t id, std::vector<std::uint8_t> data) {
+  CanFrame frame;
+  frame.timestamp_ns = timestamp_ns;
+  frame.id = id;
+  frame.flags = CanFrame::kExtended;
+  frame.size = static_cast<std::uint8_t>(data.size());
+  std::copy(data.begin(), data.end(), frame.data);
+  return frame;
+}
+
+std::uint32_t CmId(std::uint8_t source, std::uint8_t destination) {
+  return 0x1CEC0000u | (std::uint32_t{destination} << 8) | source;
+}
+
+std::uint32_t DtId(std::uint8_t source, std::uint8_t destination) {
+  return 0x1CEB0000u | (std::uint32_t{destination} << 8) | source;
+}
+
+// A BAM or RTS announcement of payload
+CanFrame Announce(std::int64_t timestamp_ns, std::uint8_t control, std::uint8_t source, std::uint8_t destination,
+                  std::size_t size, std::uint32_t pgn) {
+  const auto packets = static_cast<std::uint8_t>((size + 6) / 7);
+  return Frame(timestamp_ns, CmId(source, destination),
+               {control, static_cast<std::uint8_t>(size & 0xFF), static_cast<std::uint8_t>(size >> 8), packets,
+                control == kBam ? std::uint8_t{0xFF} : packets, static_cast<std::uint8_t>(pgn & 0xFF),
+                static_cast<std::uint8_t>((pgn >> 8) & 0xFF), static_cast<std::uint8_t>(pgn >> 16)});
+}
+
+// TP.DT packet sequence of payload, padded with 0xFF
+CanFrame Packet(std::int64_t timestamp_ns, std::uint8_t source, std::uint8_t destination,
+                const std::vector<std::uint8_t>& payload, std::uint8_t sequence) {
+  std::vector<std::uint8_t> data = {sequence};
+  for (std::size_t i = (sequence - 1u) * 7u; data.size() < 8; ++i) {
+    data.push_back(i < payload.size() ? payload[i] : 0xFF);
+  }
+  return Frame(timestamp_ns, DtId(source, destination), data);
+}
+
+std::vector<std::uint8_t> Dm1Payload(std::uint8_t seed) {
+  std::vector<std::uint8_t> payload(20);
+  for (std::size_t i = 0; i < payload.size(); ++i) {
+    payload[i] = static_cast<std::uint8_t>(seed + i * 11);
+  }
+  return payload;
+}
+
+struct Received {
+  J1939Transfer transfer;
+  std::vector<std::uint8_t> data;
+  std::vector<double> values;
+};
+
+J1939Reassembler::TransferCallback Collect(std::vector<Received>& received) {
+  return [&received](const J1939Transfer& transfer) {
+    Received copy{transfer, {transfer.data, transfer.data + transfer.size}, {}};
+    if (transfer.message != nullptr) {
+      copy.values.assign(transfer.values, transfer.values + transfer.message->signal_count);
+    }
+    received.push_back(std::move(copy));
+  };
+}
+
+TEST(J1939ReassemblerTest, ReassemblesAndDecodesBroadcasts) {
+  const DbcFile dbc_file = MakeFile();
+  const FrameDecoder decoder(dbc_file);
+  std::vector<Received> received;
+  J1939Reassembler reassembler(decoder, Collect(received));
+
+  // A DM1 from another source address than the DBC's
+  const std::vector<std::uint8_t> payload = Dm1Payload(3);
+  EXPECT_TRUE(reassembler.Add(Announce(1000, kBam, 0x17, 0xFF, payload.size(), kDm1Pgn)));
+  EXPECT_FALSE(reassembler.Add(Frame(1500, 0x0CF00417u, {0, 0, 0, 0, 0, 0, 0, 0})));
+  for (std::uint8_t sequence = 1; sequence <= 3; ++sequence) {
+    EXPECT_TRUE(reassembler.Add(Packet(2000 + sequence, 0x17, 0xFF, payload, sequence)));
+  }
+
+  ASSERT_EQ(received.size(), 1u);
+  const J1939Transfer& transfer = received[0].transfer;
+  EXPECT_EQ(transfer.timestamp_ns, 2003);
+  EXPECT_EQ(transfer.pgn, kDm1Pgn);
+  EXPECT_EQ(transfer.priority, 7);
+  EXPECT_EQ(transfer.source_address, 0x17);
+  EXPECT_TRUE(transfer.is_broadcast());
+  EXPECT_EQ(received[0].data, payload);
+  ASSERT_NE(transfer.message, nullptr);
+  EXPECT_EQ(transfer.message->message->name, "DM1");
+  ASSERT_EQ(received[0].values.size(), 3u);
+  EXPECT_EQ(received[0].values[0], payload[0]);
+  EXPECT_EQ(received[0].values[1], payload[2] | (payload[3] << 8) | ((payload[4] & 0x07) << 16));
+  EXPECT_EQ(received[0].values[2], payload[17] | (payload[18] << 8));
+  EXPECT_EQ(reassembler.stats().transfers, 1u);
+}
+
+TEST(J1939ReassemblerTest, FollowsConnectionsWithRetransmissions) {
+  const DbcFile dbc_file = MakeFile();
+  const FrameDecoder decoder(dbc_file);
+  std::vector<Received> received;
+  J1939Reassembler reassembler(decoder, Collect(received));
+
+  // Component ID from 0x00 to 0xF9, interleaved with a DM1 broadcast from
+  // the same sender
+  std::vector<std::uint8_t> component(30);
+  for (std::size_t i = 0; i < component.size(); ++i) {
+    component[i] = static_cast<std::uint8_t>('A' + i);
+  }
+  std::vector<std::uint8_t> corrupted = component;
+  corrupted[8] = 0;
+  const std::vector<std::uint8_t> dm1 = Dm1Payload(9);
+  const std::vector<CanFrame> frames = {
+      Announce(100, kRts, 0x00, 0xF9, component.size(), kComponentIdPgn),
+      Frame(110, CmId(0xF9, 0x00), {kCts, 2, 1, 0xFF, 0xFF, 0xEB, 0xFE, 0x00}),
+      Packet(120, 0x00, 0xF9, component, 1),
+      Announce(125, kBam, 0x00, 0xFF, dm1.size(), kDm1Pgn),
+      Packet(130, 0x00, 0xF9, corrupted, 2),
+      // The receiver asks for packet 2 again, then for the rest
+      Frame(140, CmId(0xF9, 0x00), {kCts, 3, 2, 0xFF, 0xFF, 0xEB, 0xFE, 0x00}),
+      Packet(150, 0x00, 0xF9, component, 2),
+      Packet(155, 0x00, 0xFF, dm1, 1),
+      Packet(160, 0x00, 0xF9, component, 3),
+      Packet(165, 0x00, 0xFF, dm1, 2),
+      Packet(170, 0x00, 0xF9, component, 4),
+      Packet(175, 0x00, 0xFF, dm1, 3),
+      Packet(180, 0x00, 0xF9, component, 5),
+      Frame(190, CmId(0xF9, 0x00), {kEndOfMessageAck, 30, 0, 5, 0xFF, 0xEB, 0xFE, 0x00}),
+  };
+  for (const CanFrame& frame : frames) {
+    EXPECT_TRUE(reassembler.Add(frame));
+  }
+
+  ASSERT_EQ(received.size(), 2u);
+  EXPECT_EQ(received[0].transfer.pgn, kDm1Pgn);
+  EXPECT_EQ(received[0].data, dm1);
+  EXPECT_EQ(received[1].transfer.pgn, kComponentIdPgn);
+  EXPECT_EQ(received[1].transfer.destination_address, 0xF9);
+  EXPECT_FALSE(received[1].transfer.is_broadcast());
+  EXPECT_EQ(received[1].data, component);
+  // Not in the DBC
+  EXPECT_EQ(received[1].transfer.message, nullptr);
+  EXPECT_EQ(received[1].transfer.values, nullptr);
+  EXPECT_EQ(reassembler.stats().transfers, 2u);
+  EXPECT_EQ(reassembler.stats().malformed, 0u);
+}
+
+TEST(J1939ReassemblerTest, DropsAbortedTimedOutAndMalformedTransfers) {
+  const DbcFile dbc_file = MakeFile();
+  const FrameDecoder decoder(dbc_file);
+  std::vector<Received> received;
+  J1939ReassemblyOptions options;
+  options.timeout_ns = 750'000'000;
+  J1939Reassembler reassembler(decoder, Collect(received), options);
+  const std::vector<std::uint8_t> payload = Dm1Payload(1);
+
+  // Aborted by the receiver
+  reassembler.Add(Announce(0, kRts, 0x00, 0xF9, payload.size(), kDm1Pgn));
+  reassembler.Add(Packet(10, 0x00, 0xF9, payload, 1));
+  reassembler.Add(Frame(20, CmId(0xF9, 0x00), {kAbort, 3, 0xFF, 0xFF, 0xFF, 0xCA, 0xFE, 0x00}));
+  reassembler.Add(Packet(30, 0x00, 0xF9, payload, 2));
+  EXPECT_EQ(reassembler.stats().aborted, 1u);
+  EXPECT_EQ(reassembler.stats().orphan_packets, 1u);
+
+  // Replaced by a new announcement, which then completes
+  reassembler.Add(Announce(100, kBam, 0x00, 0xFF, payload.size(), kDm1Pgn));
+  reassembler.Add(Packet(110, 0x00, 0xFF, payload, 1));
+  reassembler.Add(Announce(120, kBam, 0x00, 0xFF, payload.size(), kDm1Pgn));
+  EXPECT_EQ(reassembler.stats().aborted, 2u);
+  for (std::uint8_t sequence = 1; sequence <= 3; ++sequence) {
+    reassembler.Add(Packet(130 + sequence, 0x00, 0xFF, payload, sequence));
+  }
+  EXPECT_EQ(received.size(), 1u);
+
+  // A gap longer than the timeout
+  reassembler.Add(Announce(1000, kBam, 0x00, 0xFF, payload.size(), kDm1Pgn));
+  reassembler.Add(Packet(2000, 0x00, 0xFF, payload, 1));
+  reassembler.Add(Packet(1'000'002'000, 0x00, 0xFF, payload, 2));
+  EXPECT_EQ(reassembler.stats().timed_out, 1u);
+
+  // Sizes that do not match the packet count, BAM to a single receiver,
+  // sequence numbers past the end and short frames
+  reassembler.Add(Frame(2'000'000'000, CmId(0x00, 0xFF), {kBam, 20, 0, 4, 0xFF, 0xCA, 0xFE, 0x00}));
+  reassembler.Add(Announce(2'000'000'010, kBam, 0x00, 0xF9, payload.size(), kDm1Pgn));
+  reassembler.Add(Announce(2'000'000'020, kBam, 0x00, 0xFF, payload.size(), kDm1Pgn));
+  reassembler.Add(Packet(2'000'000'030, 0x00, 0xFF, payload, 4));
+  reassembler.Add(Frame(2'000'000'040, DtId(0x00, 0xFF), {1, 2, 3}));
+  EXPECT_EQ(reassembler.stats().malformed, 4u);
+  EXPECT_EQ(received.size(), 1u);
+  EXPECT_EQ(reassembler.stats().transfers, 1u);
+}
+
+TEST(J1939ReassemblerTest, InterleavesManySendersAndChannels) {
+  const DbcFile dbc_file = MakeFile();
+  const FrameDecoder decoder(dbc_file);
+  std::vector<Received> received;
+  J1939Reassembler reassembler(decoder, Collect(received));
+
+  // More pairs than one slab holds, over two rounds that reuse the sessions
+  constexpr int kSenders = 40;
+  for (int round = 0; round < 2; ++round) {
+    const std::int64_t start = round * 1000000;
+    for (int sender = 0; sender < kSenders; ++sender) {
+      CanFrame frame = Announce(start + sender, kBam, static_cast<std::uint8_t>(sender), 0xFF, 20, kDm1Pgn);
+      frame.channel = static_cast<std::uint16_t>(sender % 2);
+      reassembler.Add(frame);
+    }
+    for (std::uint8_t sequence = 1; sequence <= 3; ++sequence) {
+      for (int sender = 0; sender < kSenders; ++sender) {
+        CanFrame frame = Packet(start + sequence * 100 + sender, static_cast<std::uint8_t>(sender), 0xFF,
+                                Dm1Payload(static_cast<std::uint8_t>(sender + round)), sequence);
+        frame.channel = static_cast<std::uint16_t>(sender % 2);
+        reassembler.Add(frame);
+      }
+    }
+  }
+
+  ASSERT_EQ(received.size(), 2u * kSenders);
+  for (std::size_t i = 0; i < received.size(); ++i) {
+    const int round = static_cast<int>(i / kSenders);
+    const int sender = static_cast<int>(i % kSenders);
+    EXPECT_EQ(received[i].transfer.source_address, sender) << i;
+    EXPECT_EQ(received[i].transfer.channel, sender % 2) << i;
+    EXPECT_EQ(received[i].data, Dm1Payload(static_cast<std::uint8_t>(sender + round))) << i;
+  }
+  EXPECT_EQ(reassembler.stats().aborted, 0u);
+}
+
+}  // namespace
+}  // namespace decoder
+}  // namespace dbc_parser
@@ -0,0 +1,204 @@
+#include "src/dbc_parser/decoder/log_decoder.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "src/dbc_parser/decoder/candump_parser.h"
+
+namespace dbc_parser {
+namespace decoder {
+namespace {
+
+using parser::DbcFile;
+using parser::Signal;
+using parser::TypeConverter;
+
+// BO_ 256 with Counter (byte 0) and Value (bytes 1-2); 0x300 is not defined
+DbcFile MakeFile() {
+  DbcFile dbc_file;
+  DbcFile::MessageDef& message = dbc_file.messages_detailed[0x100];
+  message.id = 0x100;
+  message.name = "Status";
+  message.size = 8;
+  message.signal_count = 2;
+  for (auto [name, start_bit, length] : {std::tuple<const char*, int, int>{"Counter", 0, 8}, {"Value", 8, 16}}) {
+    Signal signal;
+    signal.name = name;
+    signal.start_bit = start_bit;
+    signal.length = length;
+    dbc_file.signal_layouts.push_back(TypeConverter::ToSignalLayout(signal));
+    dbc_file.signal_infos.push_back(TypeConverter::ToSignalInfo(std::move(signal), 0x100));
+  }
+  return dbc_file;
+}
+
+std::string FrameLine(std::int64_t microseconds, int counter) {
+  char line[64];
+  std::snprintf(line, sizeof(line), "(%lld.%06lld) can0 100#%02X%02X%02X\n",
+                static_cast<long long>(microseconds / 1000000), static_cast<long long>(microseconds % 1000000),
+                counter & 0xFF, (counter * 3) & 0xFF, ((counter * 3) >> 8) & 0xFF);
+  return line;
+}
+
+// Frames 0..count-1, 1 ms apart; every pair of neighbours swapped if jitter
+std::string MakeLog(int count, bool jitter) {
+  std::string log;
+  for (int i = 0; i < count; ++i) {
+    const int frame = jitter ? (i ^ 1) : i;
+    log += FrameLine(1000000 + frame * 1000, frame);
+  }
+  return log;
+}
+
+struct Collected {
+  std::vector<std::int64_t> timestamps;
+  std::vector<double> counters;
+  std::vector<double> values;
+};
+
+LogDecoder::FrameCallback Collect(Collected& collected) {
+  return [&collected](const DecodedFrame& decoded) {
+    collected.timestamps.push_back(decoded.frame->timestamp_ns);
+    if (decoded.message != nullptr) {
+      collected.counters.push_back(decoded.values[0]);
+      collected.values.push_back(decoded.values[1]);
+    }
+  };
+}
+
+TEST(LogDecoderTest, CountsFramesMalformedAndUnknownLines) {
+  const DbcFile dbc_file = MakeFile();
+  const FrameDecoder frame_decoder(dbc_file);
+  const std::string log = MakeLog(1000, false) + "garbage\n\n(5.0) can0 300#00\r\n(6.0) can0 100#01";
+
+  for (std::size_t threads : {1, 3, 8}) {
+    for (std::size_t chunk_bytes : {1, 100, 1 << 20}) {
+      LogDecodeOptions options;
+      options.threads = threads;
+      options.chunk_bytes = chunk_bytes;
+      const LogDecodeStats stats = LogDecoder(frame_decoder, &CandumpParser::ParseLine, options).Decode(log);
+      EXPECT_EQ(stats.bytes, log.size());
+      EXPECT_EQ(stats.lines, 1003u);
+      EXPECT_EQ(stats.frames, 1002u);
+      EXPECT_EQ(stats.malformed_lines, 1u);
+      EXPECT_EQ(stats.unknown_frames, 1u);
+      // The last frame has one byte, so only Counter fits
+      EXPECT_EQ(stats.signals, 2001u);
+      EXPECT_LE(stats.threads, threads);
+    }
+  }
+}
+
+TEST(LogDecoderTest, DeliversFramesInTimestampOrder) {
+  const DbcFile dbc_file = MakeFile();
+  const FrameDecoder frame_decoder(dbc_file);
+  const std::string log = MakeLog(2000, true);
+
+  LogDecodeOptions options;
+  options.threads = 4;
+  // A few lines per chunk, so neighbours are often swapped across chunks
+  options.chunk_bytes = 90;
+  options.chunks_in_flight_per_thread = 1;
+  Collected collected;
+  const LogDecodeStats stats =
+      LogDecoder(frame_decoder, &CandumpParser::ParseLine, options).Decode(log, Collect(collected));
+
+  EXPECT_EQ(stats.frames, 2000u);
+  EXPECT_EQ(stats.late_frames, 0u);
+  ASSERT_EQ(collected.timestamps.size(), 2000u);
+  for (int i = 0; i < 2000; ++i) {
+    EXPECT_EQ(collected.timestamps[i], 1000000000 + std::int64_t{i} * 1000000) << i;
+    EXPECT_EQ(collected.counters[i], i & 0xFF) << i;
+    EXPECT_EQ(collected.values[i], (i * 3) & 0xFFFF) << i;
+  }
+}
+
+TEST(LogDecoderTest, CountsFramesBeyondTheReorderWindowAsLate) {
+  const DbcFile dbc_file = MakeFile();
+  const FrameDecoder frame_decoder(dbc_file);
+  // The first frame is written last
+  const std::string log = MakeLog(200, false).substr(FrameLine(1000000, 0).size()) + FrameLine(1000000, 0);
+
+  LogDecodeOptions options;
+  options.threads = 2;
+  options.chunk_bytes = 100;
+  Collected collected;
+  const LogDecodeStats stats =
+      LogDecoder(frame_decoder, &CandumpParser::ParseLine, options).Decode(log, Collect(collected));
+
+  EXPECT_EQ(collected.timestamps.size(), 200u);
+  EXPECT_EQ(stats.late_frames, 1u);
+  // Delivered once it is seen, after frames it should have preceded
+  EXPECT_NE(collected.timestamps.front(), 1000000000);
+  EXPECT_EQ(std::count(collected.timestamps.begin(), collected.timestamps.end(), 1000000000), 1);
+}
+
+TEST(LogDecoderTest, ReportsChunksInLogOrder) {
+  const DbcFile dbc_file = MakeFile();
+  const FrameDecoder frame_decoder(dbc_file);
+  const std::string log = MakeLog(1000, true);
+
+  LogDecodeOptions options;
+  options.threads = 3;
+  options.chunk_bytes = 500;
+  std::vector<LogChunk> chunks;
+  std::uint64_t frames = 0;
+  options.on_chunk = [&](const LogChunk& chunk) {
+    chunks.push_back(chunk);
+    for (std::size_t i = 0; i < chunk.frame_count; ++i) {
+      EXPECT_EQ(chunk.frames[i].id, 0x100u);
+    }
+    frames += chunk.frame_count;
+  };
+  // Without on_frame the chunks still carry their frames
+  const LogDecodeStats stats = LogDecoder(frame_decoder, &CandumpParser::ParseLine, options).Decode(log);
+
+  ASSERT_EQ(chunks.size(), stats.chunks);
+  EXPECT_EQ(frames, 1000u);
+  std::size_t offset = 0;
+  for (std::size_t i = 0; i < chunks.size(); ++i) {
+    EXPECT_EQ(chunks[i].index, i);
+    EXPECT_EQ(chunks[i].offset, offset);
+    offset += chunks[i].size;
+  }
+  EXPECT_EQ(offset, log.size());
+}
+
+TEST(LogDecoderTest, DecodesMappedFile) {
+  const DbcFile dbc_file = MakeFile();
+  const FrameDecoder frame_decoder(dbc_file);
+  const std::string path = ::testing::TempDir() + "log_decoder_test.log";
+  {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << MakeLog(500, false);
+  }
+
+  const LogDecoder log_decoder(frame_decoder, &CandumpParser::ParseLine);
+  const auto stats = log_decoder.DecodeFile(path);
+  ASSERT_TRUE(stats.has_value());
+  EXPECT_EQ(stats->frames, 500u);
+  EXPECT_GT(stats->FramesPerSecond(), 0.0);
+  EXPECT_FALSE(log_decoder.DecodeFile(path + ".missing").has_value());
+}
+
+TEST(LogDecoderTest, EmptyLog) {
+  const DbcFile dbc_file = MakeFile();
+  const FrameDecoder frame_decoder(dbc_file);
+  Collected collected;
+  const LogDecodeStats stats = LogDecoder(frame_decoder, &CandumpParser::ParseLine).Decode("", Collect(collected));
+  EXPECT_EQ(stats.frames, 0u);
+  EXPECT_EQ(stats.chunks, 0u);
+  EXPECT_TRUE(collected.timestamps.empty());
+}
+
+}  // namespace
+}  // namespace decoder
+}  // namespace dbc_parser
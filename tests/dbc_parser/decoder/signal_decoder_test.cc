@@ -0,0 +1,254 @@
+#include "src/dbc_parser/decoder/signal_decoder.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+#include "gtest/gtest.h"
+
+namespace dbc_parser {
+namespace decoder {
+namespace {
+
+using parser::MultiplexType;
+using parser::Signal;
+using parser::SignType;
+using parser::TypeConverter;
+
+SignalLayout MakeLayout(int start_bit, int length, bool little_endian, bool is_signed,
+                        double factor = 1.0, double offset = 0.0) {
+  Signal signal;
+  signal.start_bit = start_bit;
+  signal.length = length;
+  signal.byte_order = little_endian ? 1 : 0;
+  signal.sign = is_signed ? SignType::kSigned : SignType::kUnsigned;
+  signal.factor = factor;
+  signal.offset = offset;
+  return TypeConverter::ToSignalLayout(signal);
+}
+
+TEST(SignalLayoutTest, PacksSignalIntoFortyBytes) {
+  EXPECT_EQ(sizeof(SignalLayout), 40u);
+
+  Signal signal;
+  signal.start_bit = 300;
+  signal.length = 12;
+  signal.byte_order = 0;
+  signal.sign = SignType::kSigned;
+  signal.multiplex_type = MultiplexType::kMultiplexed;
+  signal.multiplex_value = 7;
+  SignalLayout layout = TypeConverter::ToSignalLayout(signal);
+  EXPECT_EQ(layout.start_bit, 300);
+  EXPECT_EQ(layout.length, 12);
+  EXPECT_FALSE(layout.is_little_endian());
+  EXPECT_TRUE(layout.is_signed());
+  EXPECT_TRUE(layout.is_multiplexed());
+  EXPECT_FALSE(layout.is_multiplexor());
+  EXPECT_EQ(layout.multiplex_value, 7);
+}
+
+TEST(SignalLayoutTest, MovesColdFieldsIntoSignalInfo) {
+  Signal signal;
+  signal.name = "EngineSpeed";
+  signal.unit = "rpm";
+  signal.receivers = {"ECU1", "ECU2"};
+  auto info = TypeConverter::ToSignalInfo(std::move(signal), 0x123);
+  EXPECT_EQ(info.name, "EngineSpeed");
+  EXPECT_EQ(info.unit, "rpm");
+  EXPECT_EQ(info.receivers.size(), 2u);
+  EXPECT_EQ(info.message_id, 0x123);
+}
+
+TEST(SignalDecoderTest, DecodesLittleEndianAcrossBytes) {
+  const std::uint8_t data[8] = {0x00, 0x34, 0x12, 0, 0, 0, 0, 0};
+  auto raw = SignalDecoder::ExtractRaw(MakeLayout(8, 16, true, false), data, sizeof(data));
+  ASSERT_TRUE(raw.has_value());
+  EXPECT_EQ(*raw, 0x1234u);
+
+  // Unaligned: upper nibble of byte 1 followed by all of byte 2
+  raw = SignalDecoder::ExtractRaw(MakeLayout(12, 12, true, false), data, sizeof(data));
+  ASSERT_TRUE(raw.has_value());
+  EXPECT_EQ(*raw, 0x123u);
+}
+
+TEST(SignalDecoderTest, DecodesBigEndianAcrossBytes) {
+  // Motorola 16-bit signal with MSB at bit 7 of byte 0 spans bytes 0 and 1.
+  const std::uint8_t data[8] = {0x12, 0x34, 0, 0, 0, 0, 0, 0};
+  auto raw = SignalDecoder::ExtractRaw(MakeLayout(7, 16, false, false), data, sizeof(data));
+  ASSERT_TRUE(raw.has_value());
+  EXPECT_EQ(*raw, 0x1234u);
+
+  // 12 bits starting at bit 3 of byte 0: low nibble of 0x12, then all of 0x34.
+  raw = SignalDecoder::ExtractRaw(MakeLayout(3, 12, false, false), data, sizeof(data));
+  ASSERT_TRUE(raw.has_value());
+  EXPECT_EQ(*raw, 0x234u);
+}
+
+TEST(SignalDecoderTest, SignExtendsAndScales) {
+  const std::uint8_t data[8] = {0xFE, 0, 0, 0, 0, 0, 0, 0};
+  auto value = SignalDecoder::Decode(MakeLayout(0, 8, true, true, 0.5, 10.0), data, sizeof(data));
+  ASSERT_TRUE(value.has_value());
+  EXPECT_DOUBLE_EQ(*value, 9.0);  // -2 * 0.5 + 10
+
+  value = SignalDecoder::Decode(MakeLayout(0, 8, true, false, 0.5, 10.0), data, sizeof(data));
+  ASSERT_TRUE(value.has_value());
+  EXPECT_DOUBLE_EQ(*value, 137.0);  // 254 * 0.5 + 10
+}
+
+TEST(SignalDecoderTest, DecodesFullWidthAndFloatSignals) {
+  std::uint8_t data[8];
+  const std::uint64_t all_ones = ~std::uint64_t{0};
+  std::memcpy(data, &all_ones, sizeof(data));
+  auto raw = SignalDecoder::ExtractRaw(MakeLayout(0, 64, true, false), data, sizeof(data));
+  ASSERT_TRUE(raw.has_value());
+  EXPECT_EQ(*raw, all_ones);
+
+  const float f = 3.5f;
+  std::uint32_t bits;
+  std::memcpy(&bits, &f, sizeof(bits));
+  const std::uint8_t float_data[4] = {static_cast<std::uint8_t>(bits), static_cast<std::uint8_t>(bits >> 8),
+                                      static_cast<std::uint8_t>(bits >> 16),
+                                      static_cast<std::uint8_t>(bits >> 24)};
+  SignalLayout layout = MakeLayout(0, 32, true, false);
+  layout.flags |= SignalLayout::kFloat32;
+  auto value = SignalDecoder::Decode(layout, float_data, sizeof(float_data));
+  ASSERT_TRUE(value.has_value());
+  EXPECT_DOUBLE_EQ(*value, 3.5);
+}
+
+TEST(SignalDecoderTest, RejectsSignalsOutsidePayload) {
+  const std::uint8_t data[2] = {0xFF, 0xFF};
+  EXPECT_FALSE(SignalDecoder::ExtractRaw(MakeLayout(8, 16, true, false), data, sizeof(data)));
+  EXPECT_FALSE(SignalDecoder::ExtractRaw(MakeLayout(15, 16, false, false), data, sizeof(data)));
+  EXPECT_FALSE(SignalDecoder::ExtractRaw(MakeLayout(0, 0, true, false), data, sizeof(data)));
+}
+
+// One bit at a time, straight from the DBC bit numbering
+std::optional<std::uint64_t> ReferenceExtract(const SignalLayout& layout, const std::uint8_t* data,
+                                              std::size_t size) {
+  std::uint64_t raw = 0;
+  unsigned bit = layout.start_bit;
+  for (unsigned i = 0; i < layout.length; ++i) {
+    if (bit / 8 >= size) {
+      return std::nullopt;
+    }
+    const std::uint64_t value = (data[bit / 8] >> (bit % 8)) & 1u;
+    if (layout.is_little_endian()) {
+      raw |= value << i;
+      ++bit;
+    } else {
+      raw = (raw << 1) | value;
+      bit = bit % 8 == 0 ? bit + 15 : bit - 1;
+    }
+  }
+  const unsigned length = layout.length;
+  if (layout.is_signed() && length < 64 && ((raw >> (length - 1)) & 1u)) {
+    raw |= ~std::uint64_t{0} << length;
+  }
+  return raw;
+}
+
+TEST(SignalDecoderTest, DecodesSignalsAnywhereInCanFdPayload) {
+  std::mt19937_64 rng(44);
+  std::uint8_t data[64];
+  for (std::uint8_t& byte : data) {
+    byte = static_cast<std::uint8_t>(rng());
+  }
+  std::vector<SignalLayout> layouts;
+  for (int i = 0; i < 20000; ++i) {
+    layouts.push_back(MakeLayout(static_cast<int>(rng() % 512), static_cast<int>(1 + rng() % 64), rng() % 2 == 0,
+                                 rng() % 2 == 0));
+  }
+  // Every start bit with the widest signals, which span nine bytes when unaligned
+  for (int start_bit = 0; start_bit < 512; ++start_bit) {
+    layouts.push_back(MakeLayout(start_bit, 64, true, false));
+    layouts.push_back(MakeLayout(start_bit, 64, false, true));
+  }
+
+  for (const std::size_t size : {std::size_t{8}, std::size_t{12}, std::size_t{64}}) {
+    for (const SignalLayout& layout : layouts) {
+      const auto expected = ReferenceExtract(layout, data, size);
+      const auto raw = SignalDecoder::ExtractRaw(layout, data, size);
+      ASSERT_EQ(raw, expected) << "start_bit " << layout.start_bit << " length " << int{layout.length} << " size "
+                               << size << (layout.is_little_endian() ? " Intel" : " Motorola");
+    }
+  }
+
+  // Precomputed plans give the same values
+  std::vector<ExtractionPlan> plans;
+  for (const SignalLayout& layout : layouts) {
+    plans.push_back(ExtractionPlan::For(layout));
+  }
+  std::vector<double> with_plans(layouts.size());
+  std::vector<double> without_plans(layouts.size());
+  const std::size_t decoded =
+      SignalDecoder::DecodeMessage(layouts.data(), plans.data(), layouts.size(), data, 64, with_plans.data());
+  EXPECT_EQ(SignalDecoder::DecodeMessage(layouts.data(), layouts.size(), data, 64, without_plans.data()), decoded);
+  EXPECT_GT(decoded, layouts.size() / 2);
+  for (std::size_t i = 0; i < layouts.size(); ++i) {
+    ASSERT_EQ(std::isnan(with_plans[i]), std::isnan(without_plans[i])) << i;
+    if (!std::isnan(with_plans[i])) {
+      ASSERT_EQ(with_plans[i], without_plans[i]) << i;
+    }
+  }
+}
+
+TEST(SignalDecoderTest, RejectsSignalsPastCanFdPayload) {
+  std::uint8_t data[80] = {};
+  EXPECT_TRUE(SignalDecoder::ExtractRaw(MakeLayout(504, 8, true, false), data, 64).has_value());
+  EXPECT_FALSE(SignalDecoder::ExtractRaw(MakeLayout(505, 8, true, false), data, sizeof(data)).has_value());
+  EXPECT_FALSE(SignalDecoder::ExtractRaw(MakeLayout(512, 8, true, false), data, sizeof(data)).has_value());
+  EXPECT_EQ(ExtractionPlan::For(MakeLayout(0xFFFF, 8, false, false)).required_size, ExtractionPlan::kNeverFits);
+  EXPECT_EQ(ExtractionPlan::For(MakeLayout(0, 65, true, false)).required_size, ExtractionPlan::kNeverFits);
+
+  // A 64-bit signal starting mid-byte needs a ninth byte
+  const ExtractionPlan plan = ExtractionPlan::For(MakeLayout(4, 64, true, false));
+  EXPECT_EQ(plan.required_size, 9u);
+  EXPECT_TRUE(plan.flags & ExtractionPlan::kSpansNineBytes);
+}
+
+TEST(SignalDecoderTest, DecodesMessageWithMultiplexing) {
+  SignalLayout layouts[3] = {MakeLayout(0, 8, true, false), MakeLayout(8, 8, true, false),
+                             MakeLayout(8, 8, true, false, 2.0)};
+  layouts[0].flags |= SignalLayout::kMultiplexor;
+  layouts[1].flags |= SignalLayout::kMultiplexed;
+  layouts[1].multiplex_value = 1;
+  layouts[2].flags |= SignalLayout::kMultiplexed;
+  layouts[2].multiplex_value = 2;
+
+  const std::uint8_t data[8] = {2, 21, 0, 0, 0, 0, 0, 0};
+  double out[3];
+  EXPECT_EQ(SignalDecoder::DecodeMessage(layouts, 3, data, sizeof(data), out), 2u);
+  EXPECT_DOUBLE_EQ(out[0], 2.0);
+  EXPECT_TRUE(std::isnan(out[1]));
+  EXPECT_DOUBLE_EQ(out[2], 42.0);
+}
+
+TEST(SignalDecoderTest, LeavesSignalsUnderNestedMultiplexingUndecoded) {
+  // Root M, nested m2M, and a m9 child that could belong to either of them.
+  // The nested multiplexor comes last, so it must not win the root selector.
+  SignalLayout layouts[4] = {MakeLayout(0, 8, true, false), MakeLayout(16, 8, true, false),
+                             MakeLayout(24, 8, true, false), MakeLayout(8, 8, true, false)};
+  layouts[0].flags |= SignalLayout::kMultiplexor;
+  layouts[1].flags |= SignalLayout::kMultiplexed;
+  layouts[1].multiplex_value = 2;
+  layouts[2].flags |= SignalLayout::kMultiplexed;
+  layouts[2].multiplex_value = 9;
+  layouts[3].flags |= SignalLayout::kMultiplexor | SignalLayout::kMultiplexed;
+  layouts[3].multiplex_value = 2;
+
+  const std::uint8_t data[8] = {2, 9, 5, 7, 0, 0, 0, 0};
+  double out[4];
+  EXPECT_EQ(SignalDecoder::DecodeMessage(layouts, 4, data, sizeof(data), out), 1u);
+  EXPECT_DOUBLE_EQ(out[0], 2.0);
+  EXPECT_TRUE(std::isnan(out[1]));
+  EXPECT_TRUE(std::isnan(out[2]));
+  EXPECT_TRUE(std::isnan(out[3]));
+}
+
+}  // namespace
+}  // namespace decoder
+}  // namespace dbc_parser
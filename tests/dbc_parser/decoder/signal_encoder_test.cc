@@ -0,0 +1,129 @@
+#include "src/dbc_parser/decoder/signal_encoder.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "src/dbc_parser/decoder/signal_decoder.h"
+
+namespace dbc_parser {
+namespace decoder {
+namespace {
+
+using parser::Signal;
+using parser::SignType;
+using parser::TypeConverter;
+
+SignalLayout MakeLayout(int start_bit, int length, bool little_endian, bool is_signed,
+                        double factor = 1.0, double offset = 0.0) {
+  Signal signal;
+  signal.start_bit = start_bit;
+  signal.length = length;
+  signal.byte_order = little_endian ? 1 : 0;
+  signal.sign = is_signed ? SignType::kSigned : SignType::kUnsigned;
+  signal.factor = factor;
+  signal.offset = offset;
+  return TypeConverter::ToSignalLayout(signal);
+}
+
+TEST(SignalEncoderTest, WritesOnlyTheSignalBitsAnywhereInCanFdPayload) {
+  std::mt19937_64 rng(44);
+  for (int i = 0; i < 20000; ++i) {
+    const SignalLayout layout = MakeLayout(static_cast<int>(rng() % 512), static_cast<int>(1 + rng() % 64),
+                                           rng() % 2 == 0, false);
+    const ExtractionPlan plan = ExtractionPlan::For(layout);
+    if (!plan.FitsIn(64)) {
+      continue;
+    }
+    const std::uint64_t raw = rng() >> (64 - layout.length);
+
+    // The bits the signal owns: all ones written into zeros
+    std::uint8_t mask[64] = {};
+    ASSERT_TRUE(SignalEncoder::Encode(layout, std::ldexp(1.0, layout.length), mask, sizeof(mask)));
+
+    std::uint8_t before[64];
+    for (std::uint8_t& byte : before) {
+      byte = static_cast<std::uint8_t>(rng());
+    }
+    std::uint8_t after[64];
+    std::memcpy(after, before, sizeof(after));
+    PaddedPayload payload(after, sizeof(after));
+    plan.Insert(raw, payload);
+    std::memcpy(after, payload.bytes, sizeof(after));
+
+    ASSERT_EQ(SignalDecoder::ExtractRaw(layout, after, sizeof(after)), raw)
+        << "start_bit " << layout.start_bit << " length " << int{layout.length};
+    for (int b = 0; b < 64; ++b) {
+      ASSERT_EQ(after[b] & ~mask[b], before[b] & ~mask[b]) << "byte " << b << " start_bit " << layout.start_bit;
+    }
+  }
+}
+
+TEST(SignalEncoderTest, ScalesRoundsAndSaturates) {
+  const SignalLayout speed = MakeLayout(0, 16, true, false, 0.1, -10.0);
+  EXPECT_EQ(SignalEncoder::ToRaw(speed, 100.0), 1100u);
+  EXPECT_EQ(SignalEncoder::ToRaw(speed, 100.04), 1100u);
+  EXPECT_EQ(SignalEncoder::ToRaw(speed, -50.0), 0u);
+  EXPECT_EQ(SignalEncoder::ToRaw(speed, 1e9), 0xFFFFu);
+  EXPECT_FALSE(SignalEncoder::ToRaw(speed, std::numeric_limits<double>::quiet_NaN()).has_value());
+
+  const SignalLayout temperature = MakeLayout(7, 12, false, true);
+  EXPECT_EQ(SignalEncoder::ToRaw(temperature, -3.0), static_cast<std::uint64_t>(-3));
+  EXPECT_EQ(SignalEncoder::ToRaw(temperature, 5000.0), 2047u);
+  EXPECT_EQ(SignalEncoder::ToRaw(temperature, -5000.0), static_cast<std::uint64_t>(-2048));
+  EXPECT_EQ(SignalEncoder::ToRaw(MakeLayout(0, 64, true, true), 1e30),
+            static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()));
+  EXPECT_EQ(SignalEncoder::ToRaw(MakeLayout(0, 64, true, false), 1e30), ~std::uint64_t{0});
+
+  std::uint8_t data[8] = {};
+  ASSERT_TRUE(SignalEncoder::Encode(temperature, -3.0, data, sizeof(data)));
+  EXPECT_EQ(SignalDecoder::Decode(temperature, data, sizeof(data)), -3.0);
+  EXPECT_FALSE(SignalEncoder::Encode(MakeLayout(60, 8, true, false), 1.0, data, sizeof(data)));
+
+  SignalLayout real = MakeLayout(32, 32, true, false, 2.0);
+  real.flags |= SignalLayout::kFloat32;
+  ASSERT_TRUE(SignalEncoder::Encode(real, 7.0, data, sizeof(data)));
+  EXPECT_EQ(SignalDecoder::Decode(real, data, sizeof(data)), 7.0);
+}
+
+TEST(SignalEncoderTest, EncodesDecodedMessageBackToPayload) {
+  SignalLayout layouts[4] = {MakeLayout(0, 8, true, false), MakeLayout(8, 16, true, false),
+                             MakeLayout(8, 16, true, true, 0.5), MakeLayout(415, 40, false, false)};
+  layouts[0].flags |= SignalLayout::kMultiplexor;
+  layouts[1].flags |= SignalLayout::kMultiplexed;
+  layouts[1].multiplex_value = 1;
+  layouts[2].flags |= SignalLayout::kMultiplexed;
+  layouts[2].multiplex_value = 2;
+
+  std::uint8_t data[64] = {2, 0xFE, 0xFF};
+  for (int i = 51; i < 56; ++i) {
+    data[i] = static_cast<std::uint8_t>(i);
+  }
+  double values[4];
+  ASSERT_EQ(SignalDecoder::DecodeMessage(layouts, 4, data, sizeof(data), values), 3u);
+  EXPECT_EQ(values[2], -1.0);
+
+  std::uint8_t encoded[64] = {};
+  std::vector<ExtractionPlan> plans;
+  for (const SignalLayout& layout : layouts) {
+    plans.push_back(ExtractionPlan::For(layout));
+  }
+  EXPECT_EQ(SignalEncoder::EncodeMessage(layouts, plans.data(), 4, values, encoded, sizeof(encoded)), 3u);
+  EXPECT_EQ(std::memcmp(encoded, data, sizeof(data)), 0);
+
+  // The multiplexor selects which of the signals sharing bits is written
+  values[0] = 1.0;
+  values[1] = 0x1234;
+  EXPECT_EQ(SignalEncoder::EncodeMessage(layouts, 4, values, encoded, sizeof(encoded)), 3u);
+  EXPECT_EQ(encoded[0], 1);
+  EXPECT_EQ(encoded[1], 0x34);
+  EXPECT_EQ(encoded[2], 0x12);
+}
+
+}  // namespace
+}  // namespace decoder
+}  // namespace dbc_parser
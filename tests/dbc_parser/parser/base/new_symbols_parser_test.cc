@@ -45,6 +45,16 @@ TEST(NewSymbolsParserTest, HandlesWhitespace) {
   EXPECT_EQ(result->symbols[2], "VAL_");
 }
 
+TEST(NewSymbolsParserTest, ParsesIndentedSymbolList) {
+  // The list as CANdb++ writes it: one symbol per indented line, several of
+  // them with more than one underscore and one without any
+  const std::string input = "NS_ :\n\tNS_DESC_\n\tCM_\n\tBA_DEF_DEF_REL_\n\tFILTER\n\tSG_MUL_VAL_\n";
+  auto result = NewSymbolsParser::Parse(input);
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(result->symbols,
+            std::vector<std::string>({"NS_DESC_", "CM_", "BA_DEF_DEF_REL_", "FILTER", "SG_MUL_VAL_"}));
+}
+
 TEST(NewSymbolsParserTest, RejectsInvalidFormat) {
   // Missing colon
   EXPECT_FALSE(NewSymbolsParser::Parse("NS_ CM_ BA_").has_value());
@@ -1,5 +1,6 @@
 #include "src/dbc_parser/parser/comment/comment_parser.h"
 
+#include <cstdint>
 #include <string>
 #include <utility>
 #include <variant>
@@ -74,6 +75,16 @@ TEST_F(CommentParserTest, ParsesSignalComment) {
   EXPECT_EQ(id_pair.second, "SignalName");
 }
 
+TEST_F(CommentParserTest, KeepsExtendedMessageIdBits) {
+  const std::string kInput = "CM_ BO_ 2566844926 \"J1939 frame\";";
+
+  auto result = CommentParser::Parse(kInput);
+  ASSERT_TRUE(result.has_value());
+
+  ASSERT_TRUE(std::holds_alternative<int>(result->identifier));
+  EXPECT_EQ(static_cast<std::uint32_t>(std::get<int>(result->identifier)), 2566844926u);
+}
+
 TEST_F(CommentParserTest, ParsesEnvironmentVariableComment) {
   const std::string kInput = "CM_ EV_ EnvVarName \"Environment variable comment\";";
   
@@ -122,6 +133,27 @@ TEST_F(CommentParserTest, HandlesWhitespace) {
   EXPECT_EQ(std::get<std::string>(result->identifier), "NodeName");
 }
 
+TEST_F(CommentParserTest, StoresLatin1CommentAsUtf8) {
+  const std::string kInput = "CM_ BU_ NodeName \"Temperatur \xFC" "ber 80 \xB0" "C\";";
+
+  auto result = CommentParser::Parse(kInput);
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(result->text, "Temperatur \xC3\xBC" "ber 80 \xC2\xB0" "C");
+}
+
+TEST_F(CommentParserTest, KeepsUtf8CommentUnchanged) {
+  const std::string kInput = "CM_ BU_ NodeName \"80 \xC2\xB0" "C\";";
+
+  auto result = CommentParser::Parse(kInput);
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(result->text, "80 \xC2\xB0" "C");
+}
+
+TEST_F(CommentParserTest, RejectsMessageIdsThatDoNotConvert) {
+  EXPECT_FALSE(CommentParser::Parse("CM_ BO_ 4294967296 \"Too large\";").has_value());
+  EXPECT_FALSE(CommentParser::Parse("CM_ SG_ 4294967295 Speed \"Sentinel\";").has_value());
+}
+
 TEST_F(CommentParserTest, RejectsInvalidFormat) {
   const std::vector<std::string> kInvalidInputs = {
     // Missing CM_ prefix
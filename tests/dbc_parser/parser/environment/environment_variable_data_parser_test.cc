@@ -3,6 +3,7 @@
 #include <gtest/gtest.h>
 #include <optional>
 #include <string>
+#include <string_view>
 
 namespace dbc_parser {
 namespace parser {
@@ -38,6 +39,18 @@ TEST(EnvironmentVariableDataParserTest, HandlesNamesWithSpecialChars) {
   EXPECT_EQ(input, result->data);
 }
 
+TEST(EnvironmentVariableDataParserTest, CopiesOnlyTheGivenView) {
+  // The view ends inside a larger buffer, so nothing after it may be read
+  const std::string buffer = "ENVVAR_DATA_ EngineSpeed: 4;ENVVAR_DATA_ Other: 2;";
+  const std::string_view input(buffer.data(), buffer.find(';') + 1);
+
+  auto result = EnvironmentVariableDataParser::Parse(input);
+  ASSERT_TRUE(result.has_value());
+
+  EXPECT_EQ("EngineSpeed", result->name);
+  EXPECT_EQ(input, result->data);
+}
+
 TEST(EnvironmentVariableDataParserTest, RejectsInvalidFormat) {
   // Missing ENVVAR_DATA_ keyword
   EXPECT_FALSE(EnvironmentVariableDataParser::Parse("EngineSpeed: 4;").has_value());
@@ -0,0 +1,147 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "benchmarks/allocation_counter.h"
+#include "src/dbc_parser/parser/dbc_file_parser.h"
+#include "src/dbc_parser/parser/message/message_parser.h"
+#include "tools/dbc_generator.h"
+
+// Memory regression gates. The budgets are structural rather than measured
+// counts, so that they hold for any standard library and PEGTL version:
+// per-signal and per-statement costs must stay constant as inputs grow, and a
+// parse must not hold a copy of its input. A change that trips one makes some
+// cost grow with the input.
+
+namespace dbc_parser {
+namespace parser {
+namespace {
+
+using bench::AllocationScope;
+using bench::AllocationStats;
+
+constexpr std::uint64_t kMiB = 1024 * 1024;
+
+// A BO_ block whose names, units and receivers all fit the small-string
+// buffer, so only containers allocate.
+std::string MessageBlock(int signals) {
+  std::string text = "BO_ 100 EngineData: 8 ECU1\n";
+  for (int i = 0; i < signals; ++i) {
+    text += " SG_ Sig" + std::to_string(i) + " : " + std::to_string(i * 3) +
+            "|3@1+ (0.5,-40) [-40|87.5] \"degC\" ECU2\n";
+  }
+  return text;
+}
+
+// Calls operator new directly: the compiler may drop new-expressions whose
+// result is unused, but not explicit calls.
+TEST(AllocationCounterTest, CountsAllocationsLiveAndPeakBytes) {
+  AllocationScope scope;
+  void* big = ::operator new(4096);
+  void* small = ::operator new(100);
+  ::operator delete(big);
+  ::operator delete(small);
+  void* kept = ::operator new(1000);
+
+  const AllocationStats delta = scope.Delta();
+  ::operator delete(kept);
+  EXPECT_EQ(delta.allocations, 3u);
+  EXPECT_EQ(delta.bytes, 4096u + 100u + 1000u);
+  EXPECT_EQ(delta.live_bytes, 1000u);
+  EXPECT_EQ(delta.peak_live_bytes, 4096u + 100u);
+}
+
+TEST(AllocationCounterTest, NestedScopeKeepsOuterPeak) {
+  AllocationScope outer;
+  ::operator delete(::operator new(8192));
+  std::uint64_t inner_peak = 0;
+  {
+    AllocationScope inner;
+    ::operator delete(::operator new(1000));
+    inner_peak = inner.Delta().peak_live_bytes;
+  }
+  const std::uint64_t outer_peak = outer.Delta().peak_live_bytes;
+  EXPECT_EQ(inner_peak, 1000u);
+  EXPECT_EQ(outer_peak, 8192u);
+}
+
+AllocationStats ParseMessage(int signals) {
+  const std::string block = MessageBlock(signals);
+  AllocationScope scope;
+  auto message = MessageParser::Parse(block);
+  const AllocationStats delta = scope.Delta();
+  EXPECT_TRUE(message.has_value());
+  EXPECT_EQ(message ? message->signals.size() : 0u, static_cast<std::size_t>(signals));
+  return delta;
+}
+
+// Each signal costs one allocation, its receivers vector; Message::signals
+// adds a few growth steps on top. Doubling the signals from 20 to 40 may
+// therefore add 20 allocations plus the growth steps in between, which are
+// at most four for any growth factor of 1.5 or more.
+TEST(AllocationBudgetTest, MessageAllocatesOncePerSignal) {
+  constexpr int kSignals = 20;
+  constexpr std::uint64_t kGrowthSteps = 4;
+  const AllocationStats single = ParseMessage(kSignals);
+  const AllocationStats twice = ParseMessage(2 * kSignals);
+
+  ASSERT_GT(twice.allocations, single.allocations);
+  EXPECT_LE(twice.allocations - single.allocations, kSignals + kGrowthSteps);
+}
+
+// About 2 MB of text at full size: 400 messages with ~10,000 signals, 2,000
+// CM_ and 4,000 BA_ statements.
+tools::GeneratedDbc GenerateCorpus(int scale) {
+  tools::GeneratorConfig config = tools::DbcGenerator::VendorScaleConfig(1);
+  config.num_nodes = 20;
+  config.num_messages = 200 * scale;
+  config.num_value_tables = 10 * scale;
+  config.num_comments = 1000 * scale;
+  config.num_attribute_values = 2000 * scale;
+  config.num_signal_groups = 40 * scale;
+  config.num_env_vars = 5 * scale;
+  return tools::DbcGenerator::Generate(config);
+}
+
+AllocationStats ParseCorpus(const tools::GeneratedDbc& generated) {
+  DbcFileParser dbc_parser;
+  AllocationScope scope;
+  auto dbc = dbc_parser.Parse(generated.text);
+  const AllocationStats delta = scope.Delta();
+  EXPECT_TRUE(dbc.has_value());
+  EXPECT_EQ(dbc ? dbc->signal_layouts.size() : 0u, generated.counts.signals);
+  return delta;
+}
+
+// Allocations and retained bytes grow in proportion to the file: doubling the
+// corpus may at most double them, with 20% for container growth steps that
+// land differently at the two sizes.
+TEST(AllocationBudgetTest, GeneratedCorpusMemoryIsLinear) {
+  const tools::GeneratedDbc half = GenerateCorpus(1);
+  const tools::GeneratedDbc full = GenerateCorpus(2);
+  ASSERT_LT(full.text.size(), 3 * kMiB);
+  const double statements = static_cast<double>(full.counts.Total()) / half.counts.Total();
+
+  const AllocationStats small = ParseCorpus(half);
+  const AllocationStats large = ParseCorpus(full);
+
+  EXPECT_LE(large.allocations, 1.2 * statements * small.allocations);
+  EXPECT_LE(large.live_bytes, 1.2 * statements * small.live_bytes);
+}
+
+// Everything the parse needs on the way is small next to the input: the
+// grammar reads the caller's buffer and the post-pass walks views into it, so
+// a copy of the text would show up as a peak at least the size of the input.
+TEST(AllocationBudgetTest, GeneratedCorpusHoldsNoCopyOfInput) {
+  const tools::GeneratedDbc full = GenerateCorpus(2);
+  const AllocationStats used = ParseCorpus(full);
+
+  ASSERT_GE(used.peak_live_bytes, used.live_bytes);
+  EXPECT_LT(used.peak_live_bytes - used.live_bytes, full.text.size() / 4);
+}
+
+}  // namespace
+}  // namespace parser
+}  // namespace dbc_parser
@@ -0,0 +1,127 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "src/dbc_parser/parser/dbc_file_parser.h"
+#include "src/dbc_parser/parser/parse_stats.h"
+
+// Pathological inputs. ParseStats records the bytes each statement matched,
+// so these tests check without timing that every broken statement matches
+// exactly its own line (or its own continuation lines) rather than swallowing
+// the lines after it. They do not see how far a rule looked ahead before it
+// failed; dbc_file_parser_scaling_test covers that by timing 100 MB inputs.
+
+namespace dbc_parser {
+namespace parser {
+namespace {
+
+constexpr std::size_t kKiB = 1024;
+constexpr std::uint64_t kRepeats = 1000;
+
+const char kHeader[] = "VERSION \"1.0\"\nBU_: ECU1 ECU2\n";
+constexpr std::uint64_t kHeaderBytes = sizeof(kHeader) - 1;
+
+std::string RepeatLines(std::uint64_t repeats, const std::string& lines) {
+  std::string text = kHeader;
+  text.reserve(kHeaderBytes + repeats * lines.size());
+  for (std::uint64_t i = 0; i < repeats; ++i) {
+    text += lines;
+  }
+  return text;
+}
+
+// One CM_ statement continued over about the given number of bytes
+std::string DeepContinuation(std::size_t size) {
+  std::string text = std::string(kHeader) + "CM_ \"start";
+  text.reserve(size + 64);
+  while (text.size() < size) {
+    text += "\n  continued comment text, continued comment text, continued comment text";
+  }
+  text += "\n  end\";\n";
+  return text;
+}
+
+ParseStats ParseWithStats(const std::string& input, const ParseLimits& limits, bool expect_parsed) {
+  ParseStats stats;
+  EXPECT_EQ(DbcFileParser(limits).Parse(input, &stats).has_value(), expect_parsed);
+  EXPECT_EQ(stats.input_bytes, input.size());
+  return stats;
+}
+
+// Lines of 64 KiB without a known keyword are skipped one line at a time
+TEST(DbcFileParserAdversarialTest, LongLinesCoverOneLineEach) {
+  const std::string line = "GARBAGE " + std::string(64 * kKiB, 'x') + "\n";
+  const std::uint64_t repeats = 16;
+  const ParseStats stats = ParseWithStats(RepeatLines(repeats, line), ParseLimits(), true);
+
+  EXPECT_EQ(stats.UnknownLines(), repeats);
+  EXPECT_EQ(stats[StatementKind::kUnknown].bytes, repeats * line.size());
+  EXPECT_EQ(stats[StatementKind::kUnknown].largest, line.size());
+}
+
+// Statements whose quotes never close, including VERSION, whose grammar rule
+// once searched the rest of the file for the closing quote
+TEST(DbcFileParserAdversarialTest, UnterminatedQuotesCoverOneLineEach) {
+  const std::string version = "VERSION \"never closed\n";
+  const std::string comment = "CM_ BO_ 100 \"never closed\n";
+  const std::string attribute = "BA_ \"GenMsgCycleTime\" BO_ 100 \"open;\n";
+  // Matched by the line scan after the grammar, which sees lines without "\n"
+  const std::string attribute_default = "BA_DEF_DEF_ \"GenMsgCycleTime\" \"open";
+  const std::string transmitters = "BO_TX_BU_ 100 : ECU1 ,";
+  const std::string input = RepeatLines(
+      kRepeats, version + comment + attribute + attribute_default + "\n" + transmitters + "\n");
+  const ParseStats stats = ParseWithStats(input, ParseLimits(), true);
+
+  // The broken VERSION lines fall through to the unknown-line rule
+  EXPECT_EQ(stats[StatementKind::kVersion].count, 1u);
+  EXPECT_EQ(stats[StatementKind::kUnknown].count, kRepeats);
+  EXPECT_EQ(stats[StatementKind::kUnknown].bytes, kRepeats * version.size());
+
+  const struct {
+    StatementKind kind;
+    const std::string& line;
+  } kStatements[] = {
+      {StatementKind::kComment, comment},
+      {StatementKind::kAttributeValue, attribute},
+      {StatementKind::kAttributeDefault, attribute_default},
+      {StatementKind::kMessageTransmitters, transmitters},
+  };
+  for (const auto& statement : kStatements) {
+    SCOPED_TRACE(ParseStats::KeywordOf(statement.kind));
+    const StatementStats& totals = stats[statement.kind];
+    EXPECT_EQ(totals.count, kRepeats);
+    EXPECT_EQ(totals.failures, kRepeats);
+    EXPECT_EQ(totals.bytes, kRepeats * statement.line.size());
+    EXPECT_EQ(totals.largest, statement.line.size());
+  }
+}
+
+// A continuation over the statement limit fails the parse before the
+// statement is copied or handed to the comment parser
+TEST(DbcFileParserAdversarialTest, DeepContinuationIsRejected) {
+  ParseLimits limits;
+  limits.max_statement_bytes = 64 * kKiB;
+  const ParseStats stats = ParseWithStats(DeepContinuation(1024 * kKiB), limits, false);
+
+  EXPECT_EQ(stats[StatementKind::kComment].count, 0u);
+}
+
+// Without a limit, the continuation is one CM_ statement spanning the rest
+// of the input
+TEST(DbcFileParserAdversarialTest, DeepContinuationWithoutLimitIsOneStatement) {
+  ParseLimits unlimited;
+  unlimited.max_statement_bytes = SIZE_MAX;
+  const std::string input = DeepContinuation(1024 * kKiB);
+  const ParseStats stats = ParseWithStats(input, unlimited, true);
+
+  EXPECT_EQ(stats[StatementKind::kComment].count, 1u);
+  EXPECT_EQ(stats[StatementKind::kComment].failures, 0u);
+  EXPECT_EQ(stats[StatementKind::kComment].bytes, input.size() - kHeaderBytes);
+  EXPECT_EQ(stats.UnknownLines(), 0u);
+}
+
+}  // namespace
+}  // namespace parser
+}  // namespace dbc_parser
@@ -0,0 +1,122 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "src/dbc_parser/parser/dbc_file_parser.h"
+
+// Pathological inputs up to 100 MB. Each one is parsed at a quarter of the
+// size and at full size; with linear parsing the larger input takes about 4x
+// as long, while a quadratic path would take 16x. Unlike the ParseStats
+// checks in dbc_file_parser_adversarial_test, this also catches a rule that
+// looks ahead past its line and then fails. Timing needs an idle machine, so
+// the target is tagged manual.
+
+namespace dbc_parser {
+namespace parser {
+namespace {
+
+constexpr std::size_t kMiB = 1024 * 1024;
+constexpr std::size_t kFullSize = 100 * kMiB;
+
+// Allowed factor over linear scaling, for timer noise and cache effects
+constexpr double kSlack = 2.5;
+
+const char kHeader[] = "VERSION \"1.0\"\nBU_: ECU1 ECU2\n";
+
+using Builder = std::function<std::string(std::size_t)>;
+
+struct Timed {
+  bool parsed = false;
+  double seconds = 0.0;
+};
+
+Timed TimeParse(const std::string& input, const ParseLimits& limits) {
+  DbcFileParser dbc_parser(limits);
+  const auto start = std::chrono::steady_clock::now();
+  const bool parsed = dbc_parser.Parse(input).has_value();
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return {parsed, elapsed.count()};
+}
+
+// Parses build(kFullSize / 4) and build(kFullSize) and checks that the time
+// grows linearly
+void ExpectLinearTime(const Builder& build, const ParseLimits& limits, bool expect_parsed) {
+  Timed small;
+  {
+    const std::string input = build(kFullSize / 4);
+    small = TimeParse(input, limits);
+  }
+  Timed large;
+  {
+    const std::string input = build(kFullSize);
+    ASSERT_GE(input.size(), kFullSize);
+    large = TimeParse(input, limits);
+  }
+
+  EXPECT_EQ(small.parsed, expect_parsed);
+  EXPECT_EQ(large.parsed, expect_parsed);
+  EXPECT_LT(large.seconds, kSlack * 4 * small.seconds + 0.2)
+      << "small: " << small.seconds << " s, large: " << large.seconds << " s";
+}
+
+std::string RepeatLines(std::size_t size, const std::string& lines) {
+  std::string text = kHeader;
+  text.reserve(size + lines.size() + sizeof(kHeader));
+  while (text.size() < size) {
+    text += lines;
+  }
+  return text;
+}
+
+// Lines of 1 MB without a known keyword
+std::string LongLines(std::size_t size) {
+  return RepeatLines(size, "GARBAGE " + std::string(kMiB, 'x') + "\n");
+}
+
+// Statements whose quotes never close, including VERSION, whose grammar rule
+// once searched the rest of the file for the closing quote
+std::string UnterminatedQuotes(std::size_t size) {
+  return RepeatLines(size,
+                     "VERSION \"never closed\n"
+                     "CM_ BO_ 100 \"never closed\n"
+                     "BA_ \"GenMsgCycleTime\" BO_ 100 \"open;\n"
+                     "BA_DEF_DEF_ \"GenMsgCycleTime\" \"open\n"
+                     "BO_TX_BU_ 100 : ECU1 ,\n");
+}
+
+// One CM_ statement continued over the whole input
+std::string DeepContinuation(std::size_t size) {
+  std::string text = std::string(kHeader) + "CM_ \"start";
+  text.reserve(size + 64);
+  while (text.size() < size) {
+    text += "\n  continued comment text, continued comment text, continued comment text";
+  }
+  text += "\n  end\";\n";
+  return text;
+}
+
+TEST(DbcFileParserScalingTest, LongLinesTakeLinearTime) {
+  ExpectLinearTime(&LongLines, ParseLimits(), true);
+}
+
+TEST(DbcFileParserScalingTest, UnterminatedQuotesTakeLinearTime) {
+  ExpectLinearTime(&UnterminatedQuotes, ParseLimits(), true);
+}
+
+TEST(DbcFileParserScalingTest, DeepContinuationIsRejectedInLinearTime) {
+  ExpectLinearTime(&DeepContinuation, ParseLimits(), false);
+}
+
+TEST(DbcFileParserScalingTest, DeepContinuationWithoutLimitTakesLinearTime) {
+  ParseLimits unlimited;
+  unlimited.max_statement_bytes = SIZE_MAX;
+  ExpectLinearTime(&DeepContinuation, unlimited, true);
+}
+
+}  // namespace
+}  // namespace parser
+}  // namespace dbc_parser
@@ -0,0 +1,99 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "src/dbc_parser/common/common_types.h"
+#include "src/dbc_parser/parser/dbc_file_parser.h"
+#include "tools/dbc_generator.h"
+
+namespace dbc_parser {
+namespace parser {
+namespace {
+
+using tools::DbcGenerator;
+using tools::GeneratedDbc;
+using tools::GeneratorConfig;
+using tools::StatementCounts;
+
+// A scaled-down vendor mix: every knob is active, but the file stays small
+// enough for a unit test run.
+GeneratorConfig StressConfig(std::uint64_t seed) {
+  GeneratorConfig config = DbcGenerator::VendorScaleConfig(seed);
+  config.num_nodes = 20;
+  config.num_messages = 400;
+  config.num_value_tables = 20;
+  config.num_comments = 2000;
+  config.num_attribute_values = 4000;
+  config.num_signal_groups = 80;
+  config.num_env_vars = 10;
+  config.float_signal_ratio = 0.1;
+  return config;
+}
+
+std::size_t CountLayouts(const DbcFile& dbc, std::uint8_t flags) {
+  std::size_t count = 0;
+  for (const SignalLayout& layout : dbc.signal_layouts) {
+    count += (layout.flags & flags) == flags ? 1 : 0;
+  }
+  return count;
+}
+
+TEST(DbcFileParserStressTest, ParsesEveryGeneratedStatement) {
+  const GeneratedDbc generated = DbcGenerator::Generate(StressConfig(1));
+  const StatementCounts& counts = generated.counts;
+
+  DbcFileParser parser;
+  auto result = parser.Parse(generated.text);
+  ASSERT_TRUE(result.has_value());
+
+  EXPECT_EQ(result->nodes.size(), 20u);
+  EXPECT_EQ(result->value_tables.size(), counts.value_tables);
+  EXPECT_EQ(result->messages_detailed.size(), counts.messages);
+  EXPECT_EQ(result->signal_layouts.size(), counts.signals);
+  EXPECT_EQ(result->signal_infos.size(), counts.signals);
+  EXPECT_EQ(result->message_transmitters.size(), counts.message_transmitters);
+  EXPECT_EQ(result->environment_variables.size(), counts.environment_variables);
+  EXPECT_EQ(result->environment_variable_data.size(), counts.environment_variable_data);
+  EXPECT_EQ(result->comments.size(), counts.comments);
+  EXPECT_EQ(result->attribute_definitions.size(), counts.attribute_definitions);
+  EXPECT_EQ(result->attribute_defaults.size(), counts.attribute_defaults);
+  EXPECT_EQ(result->attribute_values.size(), counts.attribute_values);
+  EXPECT_EQ(result->value_descriptions.size(), counts.value_descriptions);
+  EXPECT_EQ(result->signal_value_types.size(), counts.signal_value_types);
+  EXPECT_EQ(result->signal_groups.size(), counts.signal_groups);
+
+  // Every SIG_VALTYPE_ resolved to a signal, nested multiplexors kept both
+  // roles, and extended IDs survived with bit 31 intact.
+  EXPECT_EQ(CountLayouts(*result, SignalLayout::kFloat32) +
+                CountLayouts(*result, SignalLayout::kFloat64),
+            counts.signal_value_types);
+  EXPECT_GT(CountLayouts(*result, SignalLayout::kMultiplexor | SignalLayout::kMultiplexed), 0u);
+  std::size_t extended = 0;
+  for (const auto& [id, message] : result->messages_detailed) {
+    extended += (static_cast<std::uint32_t>(id) & 0x80000000u) != 0 ? 1 : 0;
+  }
+  EXPECT_GT(extended, 0u);
+}
+
+TEST(DbcFileParserStressTest, ParsesMessagesAcrossSeeds) {
+  for (std::uint64_t seed = 2; seed < 6; ++seed) {
+    GeneratorConfig config = StressConfig(seed);
+    config.num_messages = 100;
+    config.num_comments = 200;
+    config.num_attribute_values = 200;
+    const GeneratedDbc generated = DbcGenerator::Generate(config);
+
+    DbcFileParser parser;
+    auto result = parser.Parse(generated.text);
+    ASSERT_TRUE(result.has_value()) << "seed " << seed;
+    EXPECT_EQ(result->messages_detailed.size(), generated.counts.messages) << "seed " << seed;
+    EXPECT_EQ(result->signal_layouts.size(), generated.counts.signals) << "seed " << seed;
+    EXPECT_EQ(result->comments.size(), generated.counts.comments) << "seed " << seed;
+  }
+}
+
+}  // namespace
+}  // namespace parser
+}  // namespace dbc_parser
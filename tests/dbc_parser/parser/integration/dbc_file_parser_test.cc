@@ -1,3 +1,4 @@
+#include <cstdint>
 #include <fstream>
 #include <sstream>
 #include <string>
@@ -9,7 +10,9 @@
 #include "gtest/gtest.h"
 
 #include "src/dbc_parser/common/common_types.h"
+#include "src/dbc_parser/core/trace.h"
 #include "src/dbc_parser/parser/dbc_file_parser.h"
+#include "src/dbc_parser/parser/parse_stats.h"
 
 namespace dbc_parser {
 namespace parser {
@@ -307,13 +310,78 @@ BO_ 123 TestMessage: 8 Node1
   ASSERT_EQ(1, result->messages.size());
   EXPECT_EQ("TestMessage", result->messages[123]);
   
-  // We can't test signal content yet since we only detect signals
-  // but don't parse them due to the Signal struct conflict
-  // This will be updated when full signal parsing is implemented
-  
-  // Verify that the parser processed the signal section (found_valid_section was true)
-  // This is checking that our basic signal detection is working
-  EXPECT_TRUE(result.has_value());
+  // The indented SG_ line is folded into the BO_ section and parsed with it
+  ASSERT_EQ(1, result->messages_detailed.count(123));
+  const auto& message = result->messages_detailed.at(123);
+  ASSERT_EQ(1u, message.signal_count);
+  ASSERT_EQ(1u, result->signal_layouts.size());
+  ASSERT_EQ(1u, result->signal_infos.size());
+
+  const SignalLayout& layout = result->SignalLayoutsOf(message)[0];
+  EXPECT_EQ(8, layout.start_bit);
+  EXPECT_EQ(16, layout.length);
+  EXPECT_TRUE(layout.is_little_endian());
+  EXPECT_FALSE(layout.is_signed());
+  EXPECT_DOUBLE_EQ(0.1, layout.factor);
+  EXPECT_DOUBLE_EQ(655.35, layout.maximum);
+
+  const SignalInfo& info = result->signal_infos[message.first_signal];
+  EXPECT_EQ("SignalName", info.name);
+  EXPECT_EQ("km/h", info.unit);
+  EXPECT_EQ(std::vector<std::string>({"ECU1", "ECU2"}), info.receivers);
+  EXPECT_EQ(123, info.message_id);
+  EXPECT_EQ(message.first_signal, result->FindSignal(123, "SignalName"));
+  EXPECT_FALSE(result->FindSignal(123, "Missing").has_value());
+}
+
+TEST_F(DbcFileParserTest, ParsesTabIndentedSignals) {
+  const std::string kInput =
+      "VERSION \"2.0\"\n"
+      "BO_ 200 Tabbed: 8 Node1\n"
+      "\tSG_ First : 0|8@1+ (1,0) [0|255] \"\" ECU1\n"
+      " \t SG_ Second : 8|8@1+ (1,0) [0|255] \"\" ECU1\n";
+
+  auto result = parser_->Parse(kInput);
+  ASSERT_TRUE(result.has_value());
+  ASSERT_EQ(1, result->messages_detailed.count(200));
+  const auto& message = result->messages_detailed.at(200);
+  ASSERT_EQ(2u, message.signal_count);
+  EXPECT_EQ("First", result->signal_infos[message.first_signal].name);
+  EXPECT_EQ("Second", result->signal_infos[message.first_signal + 1].name);
+  EXPECT_EQ(8, result->SignalLayoutsOf(message)[1].start_bit);
+}
+
+TEST_F(DbcFileParserTest, IgnoresDuplicateMessageId) {
+  const std::string kInput = R"(
+VERSION "2.0"
+BO_ 100 First: 8 Node1
+ SG_ A : 0|8@1+ (1,0) [0|255] "" ECU1
+ SG_ B : 8|8@1+ (1,0) [0|255] "" ECU1
+
+BO_ 100 Again: 8 Node1
+ SG_ C : 0|8@1+ (1,0) [0|255] "" ECU1
+
+BO_ 200 Other: 8 Node1
+ SG_ D : 0|8@1+ (1,0) [0|255] "" ECU1
+)";
+
+  auto result = parser_->Parse(kInput);
+  ASSERT_TRUE(result.has_value());
+  ASSERT_EQ(2, result->messages_detailed.size());
+  EXPECT_EQ("First", result->messages.at(100));
+  EXPECT_EQ("First", result->messages_detailed.at(100).name);
+
+  // The duplicate's signal is not appended, so every row belongs to a message
+  ASSERT_EQ(3u, result->signal_layouts.size());
+  ASSERT_EQ(3u, result->signal_infos.size());
+  std::uint32_t owned = 0;
+  for (const auto& [id, message] : result->messages_detailed) {
+    EXPECT_EQ(owned, message.first_signal);
+    owned += message.signal_count;
+  }
+  EXPECT_EQ(result->signal_layouts.size(), owned);
+  EXPECT_FALSE(result->FindSignal(100, "C").has_value());
+  EXPECT_TRUE(result->FindSignal(200, "D").has_value());
 }
 
 // Test parsing environment variables section
@@ -416,6 +484,27 @@ CM_ EV_ "EnvironmentVar" "EnvVar comment";
   EXPECT_TRUE(found_message_comment);
 }
 
+// SIG_VALTYPE_ after the BO_ block marks the signal's layout as IEEE float
+TEST_F(DbcFileParserTest, AppliesSignalValueTypesToLayouts) {
+  const std::string kInput = R"(
+VERSION "1.0"
+BO_ 123 EngineData: 8 ECU1
+ SG_ EngineSpeed : 0|32@1- (1,0) [0|0] "" Vector__XXX
+ SG_ EngineLoad : 32|8@1+ (1,0) [0|100] "%" Vector__XXX
+
+SIG_VALTYPE_ 123 EngineSpeed 1;
+)";
+
+  auto result = parser_->Parse(kInput);
+  ASSERT_TRUE(result.has_value());
+  auto speed = result->FindSignal(123, "EngineSpeed");
+  auto load = result->FindSignal(123, "EngineLoad");
+  ASSERT_TRUE(speed.has_value());
+  ASSERT_TRUE(load.has_value());
+  EXPECT_NE(0, result->signal_layouts[*speed].flags & SignalLayout::kFloat32);
+  EXPECT_EQ(0, result->signal_layouts[*load].flags & (SignalLayout::kFloat32 | SignalLayout::kFloat64));
+}
+
 // Test parsing signal value types
 TEST_F(DbcFileParserTest, ParsesSignalValueTypes) {
   const std::string kInput = R"(
@@ -692,6 +781,72 @@ BA_ "EnvVarAttr" EV_ "EnvVar1" 46;
   EXPECT_TRUE(found_env_var_attr);
 }
 
+TEST_F(DbcFileParserTest, ResolvesCanFdFrameFormats) {
+  const std::string kInput = R"(
+VERSION "1.0"
+BO_ 100 Classic: 8 ECU1
+ SG_ Speed : 0|16@1+ (1,0) [0|0] "" Vector__XXX
+BO_ 200 Fd: 64 ECU1
+ SG_ Tail : 504|8@1+ (1,0) [0|0] "" Vector__XXX
+BO_ 2147484160 FdExtended: 32 ECU1
+BO_ 2147484416 Extended: 8 ECU1
+BO_ 300 FdSlow: 12 ECU1
+BA_DEF_ BO_ "VFrameFormat" ENUM "StandardCAN","ExtendedCAN","reserved","J1939PG","reserved","reserved","reserved","reserved","reserved","reserved","reserved","reserved","reserved","reserved","StandardCAN_FD","ExtendedCAN_FD";
+BA_DEF_ BO_ "CANFD_BRS" ENUM "0","1";
+BA_DEF_DEF_ "VFrameFormat" "StandardCAN";
+BA_DEF_DEF_ "CANFD_BRS" "1";
+BA_ "VFrameFormat" BO_ 200 14;
+BA_ "VFrameFormat" BO_ 2147484160 15;
+BA_ "VFrameFormat" BO_ 300 14;
+BA_ "CANFD_BRS" BO_ 300 0;
+)";
+
+  auto result = parser_->Parse(kInput);
+  ASSERT_TRUE(result.has_value());
+  const auto& messages = result->messages_detailed;
+  const auto at = [&messages](std::uint32_t id) -> const DbcFile::MessageDef& {
+    return messages.at(static_cast<int>(id));
+  };
+  EXPECT_EQ(at(100).frame_format, FrameFormat::kStandardCan);
+  EXPECT_FALSE(at(100).bit_rate_switch);
+  EXPECT_EQ(at(200).frame_format, FrameFormat::kStandardCanFd);
+  EXPECT_EQ(at(200).size, 64);
+  EXPECT_TRUE(at(200).bit_rate_switch);
+  EXPECT_EQ(at(2147484160u).frame_format, FrameFormat::kExtendedCanFd);
+  EXPECT_TRUE(at(2147484160u).is_fd());
+  // The StandardCAN default with an extended ID
+  EXPECT_EQ(at(2147484416u).frame_format, FrameFormat::kExtendedCan);
+  EXPECT_FALSE(at(2147484416u).is_fd());
+  EXPECT_EQ(at(300).frame_format, FrameFormat::kStandardCanFd);
+  EXPECT_FALSE(at(300).bit_rate_switch);
+}
+
+TEST_F(DbcFileParserTest, ResolvesJ1939FrameFormats) {
+  const std::string kInput = R"(
+VERSION "1.0"
+BO_ 2364539902 EEC1: 8 Engine
+BO_ 2566844926 DM1: 32 Engine
+BO_ 2147484160 Proprietary: 8 Engine
+BO_ 100 Classic: 8 Engine
+BA_DEF_  "ProtocolType" STRING ;
+BA_DEF_DEF_ "ProtocolType" "";
+BA_ "ProtocolType" "J1939";
+BA_ "VFrameFormat" BO_ 2147484160 1;
+)";
+
+  auto result = parser_->Parse(kInput);
+  ASSERT_TRUE(result.has_value());
+  const auto& messages = result->messages_detailed;
+  const auto at = [&messages](std::uint32_t id) -> const DbcFile::MessageDef& {
+    return messages.at(static_cast<int>(id));
+  };
+  EXPECT_EQ(at(2364539902u).frame_format, FrameFormat::kJ1939);
+  EXPECT_EQ(at(2566844926u).frame_format, FrameFormat::kJ1939);
+  // An explicit ExtendedCAN and a standard ID stay classic CAN
+  EXPECT_EQ(at(2147484160u).frame_format, FrameFormat::kExtendedCan);
+  EXPECT_EQ(at(100).frame_format, FrameFormat::kStandardCan);
+}
+
 // Test parsing value descriptions
 TEST_F(DbcFileParserTest, ParsesValueDescriptions) {
   const std::string kInput = R"(
@@ -786,6 +941,228 @@ VAL_ VehicleMode 0 "Parked" 1 "Driving" 2 "Reverse" 3 "Neutral";
   EXPECT_TRUE(found_vehicle_mode);
 }
 
+// Message ID 4294967295 is -1 as an int, which marks environment variable
+// value descriptions, so a signal VAL_ with that ID must not pass for one
+TEST_F(DbcFileParserTest, RejectsValueDescriptionWithSentinelMessageId) {
+  const std::string kInput = R"(
+VERSION "1.0"
+VAL_ 4294967295 Spoofed 0 "Off" 1 "On";
+VAL_ EngineTemp 0 "Cold" 1 "Normal";
+)";
+
+  auto result = parser_->Parse(kInput);
+  ASSERT_TRUE(result.has_value());
+  ASSERT_EQ(result->value_descriptions.size(), 1);
+  EXPECT_EQ(result->value_descriptions[0].type, ValueDescriptionType::ENV_VAR);
+  EXPECT_EQ(result->value_descriptions[0].message_id, -1);
+  EXPECT_EQ(result->value_descriptions[0].signal_name, "EngineTemp");
+}
+
+// Stand-in for a replaced operator new: every query sees one more allocation,
+// so each profiled statement is charged exactly one
+std::uint64_t CountingAllocationCounter() noexcept {
+  static std::uint64_t count = 0;
+  return ++count;
+}
+
+TEST_F(DbcFileParserTest, CollectsParseStats) {
+  const std::string kInput =
+      "VERSION \"1.0\"\n"
+      "BU_: ECU1 ECU2\n"
+      "BO_ 100 EngineData: 8 ECU1\n"
+      " SG_ Rpm : 0|16@1+ (1,0) [0|8000] \"rpm\" ECU2\n"
+      " SG_ Temp : 16|8@1+ (1,-40) [-40|215] \"C\" ECU2\n"
+      "BO_TX_BU_ 100 : ECU1,ECU2;\n"
+      "CM_ BO_ 100 \"Engine data\";\n"
+      "CM_ SG_ 100 Rpm \"Engine speed\";\n"
+      "CM_ this is not a comment statement\n"
+      "BA_DEF_ BO_ \"GenMsgCycleTime\" INT 0 10000;\n"
+      "BA_DEF_DEF_ \"GenMsgCycleTime\" 100;\n"
+      "BA_ \"GenMsgCycleTime\" BO_ 100 20;\n"
+      "SG_MUL_VAL_ 100 Temp Rpm 0-0;\n"
+      "GARBAGE LINE\n";
+
+  ParseStats stats;
+  stats.allocation_counter = &CountingAllocationCounter;
+  auto result = parser_->Parse(kInput, &stats);
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(result->comments.size(), 2u);
+
+  EXPECT_EQ(stats[StatementKind::kVersion].count, 1u);
+  EXPECT_EQ(stats[StatementKind::kNodes].count, 1u);
+  EXPECT_EQ(stats[StatementKind::kMessage].count, 1u);
+  EXPECT_EQ(stats[StatementKind::kMessage].failures, 0u);
+  EXPECT_EQ(stats[StatementKind::kMessageTransmitters].count, 1u);
+  EXPECT_EQ(stats[StatementKind::kMessageTransmitters].failures, 0u);
+  EXPECT_EQ(stats[StatementKind::kComment].count, 3u);
+  EXPECT_EQ(stats[StatementKind::kComment].failures, 1u);
+  EXPECT_EQ(stats[StatementKind::kAttributeDefinition].count, 1u);
+  EXPECT_EQ(stats[StatementKind::kAttributeDefault].count, 1u);
+  EXPECT_EQ(stats[StatementKind::kAttributeValue].count, 1u);
+  EXPECT_EQ(stats[StatementKind::kSignalMultiplexValues].count, 1u);
+  EXPECT_EQ(stats.UnknownLines(), 1u);
+
+  // The BO_ statement covers its SG_ lines and is the largest one
+  EXPECT_GT(stats[StatementKind::kMessage].bytes, 100u);
+  ASSERT_FALSE(stats.largest.empty());
+  EXPECT_EQ(stats.largest.front().kind, StatementKind::kMessage);
+  EXPECT_EQ(stats.largest.front().line, 3u);
+  EXPECT_EQ(stats.largest.front().offset, kInput.find("BO_ 100"));
+
+  std::uint64_t statement_nanoseconds = 0;
+  for (const StatementStats& kind : stats.statements) {
+    EXPECT_EQ(kind.allocations, kind.count);
+    statement_nanoseconds += kind.nanoseconds;
+  }
+  EXPECT_EQ(stats.input_bytes, kInput.size());
+  EXPECT_GE(stats.total_nanoseconds, statement_nanoseconds);
+
+  // A second parse accumulates; the profile does not change the result
+  auto again = parser_->Parse(kInput, &stats);
+  ASSERT_TRUE(again.has_value());
+  EXPECT_EQ(stats[StatementKind::kComment].count, 6u);
+  EXPECT_EQ(stats.input_bytes, 2 * kInput.size());
+  auto plain = parser_->Parse(kInput);
+  ASSERT_TRUE(plain.has_value());
+  EXPECT_EQ(plain->comments.size(), again->comments.size());
+  EXPECT_EQ(plain->signal_layouts.size(), again->signal_layouts.size());
+}
+
+// The NS_ symbol list names the statement keywords on indented lines; they
+// are not statements and must not show up as failed ones. The NS_ list and
+// the empty BS_ are what CANdb++ writes into every file.
+TEST_F(DbcFileParserTest, ParseStatsReportsNoFailuresForStandardHeader) {
+  const std::string kInput =
+      "VERSION \"1.0\"\n"
+      "\n"
+      "NS_ :\n"
+      "\tNS_DESC_\n\tCM_\n\tBA_DEF_\n\tBA_\n\tVAL_\n\tCAT_DEF_\n\tCAT_\n\tFILTER\n"
+      "\tBA_DEF_DEF_\n\tEV_DATA_\n\tENVVAR_DATA_\n\tSGTYPE_\n\tSGTYPE_VAL_\n"
+      "\tBA_DEF_SGTYPE_\n\tBA_SGTYPE_\n\tSIG_TYPE_REF_\n\tVAL_TABLE_\n\tSIG_GROUP_\n"
+      "\tSIG_VALTYPE_\n\tSIGTYPE_VALTYPE_\n\tBO_TX_BU_\n\tBA_DEF_REL_\n\tBA_REL_\n"
+      "\tBA_DEF_DEF_REL_\n\tBU_SG_REL_\n\tBU_EV_REL_\n\tBU_BO_REL_\n\tSG_MUL_VAL_\n"
+      "\n"
+      "BS_:\n"
+      "\n"
+      "BU_: ECU1 ECU2\n"
+      "\n"
+      "BO_ 100 EngineData: 8 ECU1\n"
+      " SG_ Rpm : 0|16@1+ (1,0) [0|8000] \"rpm\" ECU2\n";
+
+  ParseStats stats;
+  auto result = parser_->Parse(kInput, &stats);
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(result->new_symbols.size(), 28u);
+  EXPECT_FALSE(result->bit_timing.has_value());
+
+  EXPECT_EQ(stats[StatementKind::kNewSymbols].count, 1u);
+  EXPECT_EQ(stats[StatementKind::kBitTiming].count, 1u);
+  EXPECT_EQ(stats[StatementKind::kMessageTransmitters].count, 0u);
+  EXPECT_EQ(stats[StatementKind::kAttributeDefault].count, 0u);
+  for (std::size_t kind = 0; kind < kStatementKindCount; ++kind) {
+    EXPECT_EQ(stats.statements[kind].failures, 0u)
+        << ParseStats::KeywordOf(static_cast<StatementKind>(kind));
+  }
+}
+
+// BA_DEF_DEF_REL_ starts with BA_DEF_DEF_ but is a different statement
+TEST_F(DbcFileParserTest, ParseStatsMatchesWholeKeywords) {
+  const std::string kInput =
+      "VERSION \"1.0\"\n"
+      "BU_: ECU1 ECU2\n"
+      "BA_DEF_DEF_REL_ \"GenSigTimeoutTime\" 0;\n"
+      "BA_DEF_DEF_ \"GenMsgCycleTime\" 100;\n";
+
+  ParseStats stats;
+  auto result = parser_->Parse(kInput, &stats);
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(stats[StatementKind::kAttributeDefault].count, 1u);
+  EXPECT_EQ(stats[StatementKind::kAttributeDefault].failures, 0u);
+  EXPECT_EQ(stats[StatementKind::kAttributeDefinition].count, 0u);
+}
+
+TEST_F(DbcFileParserTest, RejectsInputOverSizeLimit) {
+  const std::string kInput = "VERSION \"1.0\"\nBU_: ECU1 ECU2\n";
+  ParseLimits limits;
+  limits.max_input_bytes = kInput.size();
+  EXPECT_TRUE(DbcFileParser(limits).Parse(kInput).has_value());
+
+  limits.max_input_bytes = kInput.size() - 1;
+  EXPECT_FALSE(DbcFileParser(limits).Parse(kInput).has_value());
+}
+
+TEST_F(DbcFileParserTest, RejectsStatementOverSizeLimit) {
+  const std::string kInput =
+      "VERSION \"1.0\"\n"
+      "BO_ 100 EngineData: 8 ECU1\n"
+      " SG_ Rpm : 0|16@1+ (1,0) [0|8000] \"rpm\" ECU2\n"
+      " SG_ Temp : 16|8@1+ (1,-40) [-40|215] \"C\" ECU2\n";
+  const std::size_t message_bytes = kInput.size() - kInput.find("BO_");
+
+  // The BO_ statement with its SG_ continuation lines counts as one
+  ParseLimits limits;
+  limits.max_statement_bytes = message_bytes;
+  auto result = DbcFileParser(limits).Parse(kInput);
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(result->signal_layouts.size(), 2u);
+
+  limits.max_statement_bytes = message_bytes - 10;
+  EXPECT_FALSE(DbcFileParser(limits).Parse(kInput).has_value());
+
+  // Unrecognized lines are limited as well
+  limits.max_statement_bytes = 64;
+  EXPECT_FALSE(DbcFileParser(limits).Parse("VERSION \"1.0\"\n" + std::string(100, 'x') + "\n").has_value());
+}
+
+TEST_F(DbcFileParserTest, UnterminatedQuoteEndsAtLineEnd) {
+  // The VERSION rule must not search the following lines for the closing quote
+  const std::string kInput =
+      "VERSION \"1.0\n"
+      "BU_: ECU1 ECU2\n"
+      "BO_ 100 EngineData: 8 ECU1\n"
+      " SG_ Rpm : 0|16@1+ (1,0) [0|8000] \"rpm\" ECU2\n"
+      "CM_ BO_ 100 \"Engine data\";\n";
+
+  auto result = parser_->Parse(kInput);
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(result->messages_detailed.size(), 1u);
+  EXPECT_EQ(result->comments.size(), 1u);
+}
+
+TEST_F(DbcFileParserTest, RecordsTraceSpansWhenTracing) {
+  const std::string kInput =
+      "VERSION \"1.0\"\n"
+      "BO_ 100 EngineData: 8 ECU1\n"
+      " SG_ Rpm : 0|16@1+ (1,0) [0|8000] \"rpm\" ECU2\n"
+      "CM_ BO_ 100 \"Engine data\";\n"
+      "CM_ SG_ 100 Rpm \"Engine speed\";\n"
+      "CM_ BU_ ECU1 \"Engine ECU\";\n";
+
+  core::Tracer::Enable();
+  auto result = parser_->Parse(kInput);
+  core::Tracer::Disable();
+  ASSERT_TRUE(result.has_value());
+
+  const std::string json = core::Tracer::ToChromeTraceJson();
+  core::Tracer::Clear();
+  EXPECT_NE(json.find("\"name\":\"DbcFileParser::Parse\""), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"grammar\""), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"line scan\""), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"model assembly\""), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"BO_\""), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"signals\",\"cat\":\"dbc_parser\",\"ph\":\"C\""), std::string::npos);
+
+  // The three adjacent CM_ statements form one span
+  const std::size_t comments = json.find("\"name\":\"CM_\"");
+  ASSERT_NE(comments, std::string::npos);
+  EXPECT_EQ(json.find("\"name\":\"CM_\"", comments + 1), std::string::npos);
+  EXPECT_NE(json.find("\"args\":{\"count\":3}", comments), std::string::npos);
+
+  // Without tracing, nothing is recorded
+  ASSERT_TRUE(parser_->Parse(kInput).has_value());
+  EXPECT_EQ(core::Tracer::ToChromeTraceJson().find("\"grammar\""), std::string::npos);
+}
+
 }  // namespace
 }  // namespace parser
 }  // namespace dbc_parser 
\ No newline at end of file
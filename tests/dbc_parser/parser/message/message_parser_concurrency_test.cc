@@ -0,0 +1,101 @@
+#include "src/dbc_parser/parser/message/message_parser.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+
+namespace dbc_parser {
+namespace parser {
+namespace {
+
+constexpr int kNumMessages = 2000;
+constexpr int kNumThreads = 8;
+constexpr int kSignalsPerMessage = 4;
+
+// Builds a BO_ block whose signal start bits and lengths are unique functions of
+// the message index, so any cross-talk between parses shows up as a mismatch.
+std::string MakeMessageBlock(int index) {
+  std::string block = "BO_ " + std::to_string(index + 1) + " Msg" + std::to_string(index) +
+                      ": 8 Node" + std::to_string(index % 7) + "\n";
+  for (int s = 0; s < kSignalsPerMessage; ++s) {
+    const int start_bit = (index + s * 13) % 48;
+    const int length = 1 + (index + s) % 16;
+    block += " SG_ Sig" + std::to_string(s) + " : " + std::to_string(start_bit) + "|" +
+             std::to_string(length) + "@" + std::to_string((index + s) % 2) +
+             ((s % 2) ? "-" : "+") + " (0." + std::to_string(s + 1) + "," +
+             std::to_string(index % 50) + ") [0|" + std::to_string(index) + "] \"u" +
+             std::to_string(s) + "\" Rx" + std::to_string(s) + "\n";
+  }
+  return block;
+}
+
+bool SameMessage(const Message& a, const Message& b) {
+  if (a.id != b.id || a.name != b.name || a.dlc != b.dlc || a.sender != b.sender ||
+      a.signals.size() != b.signals.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.signals.size(); ++i) {
+    const Signal& x = a.signals[i];
+    const Signal& y = b.signals[i];
+    // Bit-exact comparison: both sides were produced from identical text.
+    if (x.name != y.name || x.start_bit != y.start_bit || x.length != y.length ||
+        x.byte_order != y.byte_order || x.sign != y.sign || x.factor != y.factor ||
+        x.offset != y.offset || x.minimum != y.minimum || x.maximum != y.maximum ||
+        x.unit != y.unit || x.receivers != y.receivers) {
+      return false;
+    }
+  }
+  return true;
+}
+
+TEST(MessageParserConcurrencyTest, ParsesInputsIndependentlyAcrossThreads) {
+  std::vector<std::string> blocks;
+  std::vector<Message> expected;
+  blocks.reserve(kNumMessages);
+  expected.reserve(kNumMessages);
+  for (int i = 0; i < kNumMessages; ++i) {
+    blocks.push_back(MakeMessageBlock(i));
+    auto reference = MessageParser::Parse(blocks.back());
+    ASSERT_TRUE(reference.has_value()) << blocks.back();
+    ASSERT_EQ(reference->signals.size(), static_cast<size_t>(kSignalsPerMessage));
+    expected.push_back(std::move(*reference));
+  }
+
+  // Spot-check that the reference itself is right, not just self-consistent.
+  EXPECT_EQ(expected[5].signals[1].start_bit, 18);
+  EXPECT_EQ(expected[5].signals[1].length, 7);
+
+  std::atomic<int> failures{0};
+  std::vector<std::thread> threads;
+  threads.reserve(kNumThreads);
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      // Each thread parses every block, in its own shuffled order, so that
+      // parses of different messages overlap in time.
+      std::vector<int> order(kNumMessages);
+      std::iota(order.begin(), order.end(), 0);
+      std::shuffle(order.begin(), order.end(), std::mt19937(static_cast<std::mt19937::result_type>(t + 1)));
+      for (const int i : order) {
+        auto result = MessageParser::Parse(blocks[i]);
+        if (!result.has_value() || !SameMessage(*result, expected[i])) {
+          failures.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(failures.load(), 0);
+}
+
+}  // namespace
+}  // namespace parser
+}  // namespace dbc_parser
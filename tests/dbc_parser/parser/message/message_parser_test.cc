@@ -1,5 +1,6 @@
 #include "src/dbc_parser/parser/message/message_parser.h"
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include "gtest/gtest.h"
@@ -107,6 +108,45 @@ TEST(MessageParserTest, ParsesMessageWithMultiplexedSignals) {
   EXPECT_EQ(rpm.multiplex_value.value(), 1);
 }
 
+TEST(MessageParserTest, ParsesExtendedMultiplexing) {
+  const std::string input =
+      "BO_ 124 DiagData: 8 Engine\n"
+      " SG_ Service M : 0|4@1+ (1,0) [0|15] \"\" Tester\n"
+      " SG_ SubFunction m2M : 4|4@1+ (1,0) [0|15] \"\" Tester\n"
+      " SG_ Counter m2 : 8|8@1+ (1,0) [0|255] \"\" Tester";
+  auto result = MessageParser::Parse(input);
+  ASSERT_TRUE(result.has_value());
+  ASSERT_EQ(result->signals.size(), 3);
+
+  const auto& sub = result->signals[1];
+  EXPECT_EQ(sub.name, "SubFunction");
+  EXPECT_EQ(sub.multiplex_type, MultiplexType::kMultiplexedMultiplexor);
+  ASSERT_TRUE(sub.multiplex_value.has_value());
+  EXPECT_EQ(sub.multiplex_value.value(), 2);
+  EXPECT_EQ(result->signals[2].multiplex_type, MultiplexType::kMultiplexed);
+}
+
+TEST(MessageParserTest, ParsesExtendedAndZeroIds) {
+  // Extended frames are written with bit 31 set and do not fit an int.
+  auto extended = MessageParser::Parse("BO_ 2566844926 J1939Frame: 8 Engine");
+  ASSERT_TRUE(extended.has_value());
+  EXPECT_EQ(static_cast<std::uint32_t>(extended->id), 2566844926u);
+  EXPECT_EQ(extended->dlc, 8);
+
+  // ID 0 is valid and must not shift the DLC into the ID slot.
+  auto zero = MessageParser::Parse("BO_ 0 First: 4 Engine");
+  ASSERT_TRUE(zero.has_value());
+  EXPECT_EQ(zero->id, 0);
+  EXPECT_EQ(zero->dlc, 4);
+}
+
+TEST(MessageParserTest, RejectsIdsThatDoNotConvert) {
+  // Out of range, and the -1 that marks environment variable VAL_ entries;
+  // neither may fall back to message 0.
+  EXPECT_FALSE(MessageParser::Parse("BO_ 4294967296 TooLarge: 8 Engine").has_value());
+  EXPECT_FALSE(MessageParser::Parse("BO_ 4294967295 Sentinel: 8 Engine").has_value());
+}
+
 TEST(MessageParserTest, HandlesSignedSignals) {
   const std::string input = 
       "BO_ 123 EngineData: 8 Engine\n"
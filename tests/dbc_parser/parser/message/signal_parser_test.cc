@@ -27,16 +27,16 @@ TEST_F(SignalParserTest, ParsesBasicSignal) {
   
   EXPECT_EQ(result->name, "SignalName");
   EXPECT_EQ(result->start_bit, 8);
-  EXPECT_EQ(result->signal_size, 16);
-  EXPECT_TRUE(result->is_little_endian);
-  EXPECT_TRUE(result->is_signed);
+  EXPECT_EQ(result->length, 16);
+  EXPECT_EQ(result->byte_order, 1);
+  EXPECT_EQ(result->sign, SignType::kSigned);
   EXPECT_DOUBLE_EQ(result->factor, 0.1);
   EXPECT_DOUBLE_EQ(result->offset, 0.0);
   EXPECT_DOUBLE_EQ(result->minimum, 0.0);
   EXPECT_DOUBLE_EQ(result->maximum, 655.35);
   EXPECT_EQ(result->unit, "km/h");
   EXPECT_THAT(result->receivers, ElementsAre("ECU1", "ECU2"));
-  EXPECT_FALSE(result->is_multiplexer);
+  EXPECT_NE(result->multiplex_type, MultiplexType::kMultiplexor);
   EXPECT_FALSE(result->multiplex_value.has_value());
 }
 
@@ -48,9 +48,9 @@ TEST_F(SignalParserTest, ParsesUnsignedSignal) {
   
   EXPECT_EQ(result->name, "EngineTemp");
   EXPECT_EQ(result->start_bit, 16);
-  EXPECT_EQ(result->signal_size, 8);
-  EXPECT_TRUE(result->is_little_endian);
-  EXPECT_FALSE(result->is_signed);
+  EXPECT_EQ(result->length, 8);
+  EXPECT_EQ(result->byte_order, 1);
+  EXPECT_EQ(result->sign, SignType::kUnsigned);
   EXPECT_DOUBLE_EQ(result->factor, 2.5);
   EXPECT_DOUBLE_EQ(result->offset, -40.0);
   EXPECT_DOUBLE_EQ(result->minimum, -40.0);
@@ -66,9 +66,9 @@ TEST_F(SignalParserTest, ParsesBigEndianSignal) {
   ASSERT_TRUE(result.has_value());
   
   EXPECT_EQ(result->start_bit, 24);
-  EXPECT_EQ(result->signal_size, 16);
-  EXPECT_FALSE(result->is_little_endian);
-  EXPECT_TRUE(result->is_signed);
+  EXPECT_EQ(result->length, 16);
+  EXPECT_EQ(result->byte_order, 0);
+  EXPECT_EQ(result->sign, SignType::kSigned);
 }
 
 TEST_F(SignalParserTest, ParsesMultiplexerSignal) {
@@ -78,7 +78,7 @@ TEST_F(SignalParserTest, ParsesMultiplexerSignal) {
   ASSERT_TRUE(result.has_value());
   
   EXPECT_EQ(result->name, "MuxSelector");
-  EXPECT_TRUE(result->is_multiplexer);
+  EXPECT_EQ(result->multiplex_type, MultiplexType::kMultiplexor);
   EXPECT_FALSE(result->multiplex_value.has_value());
 }
 
@@ -89,11 +89,23 @@ TEST_F(SignalParserTest, ParsesMultiplexedSignal) {
   ASSERT_TRUE(result.has_value());
   
   EXPECT_EQ(result->name, "Temperature");
-  EXPECT_FALSE(result->is_multiplexer);
+  EXPECT_NE(result->multiplex_type, MultiplexType::kMultiplexor);
   EXPECT_TRUE(result->multiplex_value.has_value());
   EXPECT_EQ(result->multiplex_value.value(), 2);
 }
 
+TEST_F(SignalParserTest, ParsesNestedMultiplexorSignal) {
+  const std::string kInput = "SG_ SubMux m3M : 8|4@1+ (1,0) [0|15] \"\" ECU1";
+
+  auto result = SignalParser::Parse(kInput);
+  ASSERT_TRUE(result.has_value());
+
+  EXPECT_EQ(result->name, "SubMux");
+  EXPECT_EQ(result->multiplex_type, MultiplexType::kMultiplexedMultiplexor);
+  ASSERT_TRUE(result->multiplex_value.has_value());
+  EXPECT_EQ(result->multiplex_value.value(), 3);
+}
+
 TEST_F(SignalParserTest, HandlesWhitespace) {
   const std::string kInput = "SG_  SignalName  :  8|16@1+  (0.1,0)  [0|655.35]  \"km/h\"  ECU1,ECU2";
   
@@ -0,0 +1,93 @@
+#include "src/dbc_parser/parser/parse_stats.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace dbc_parser {
+namespace parser {
+namespace {
+
+TEST(ParseStatsTest, RecordsTotalsPerKind) {
+  ParseStats stats;
+  stats.Record(StatementKind::kComment, 40, 0, 1, 100, 2, false);
+  stats.Record(StatementKind::kComment, 60, 40, 2, 300, 3, true);
+  stats.Record(StatementKind::kAttributeValue, 20, 100, 3, 50, 0, false);
+
+  const StatementStats& comments = stats[StatementKind::kComment];
+  EXPECT_EQ(comments.count, 2u);
+  EXPECT_EQ(comments.failures, 1u);
+  EXPECT_EQ(comments.bytes, 100u);
+  EXPECT_EQ(comments.nanoseconds, 400u);
+  EXPECT_EQ(comments.allocations, 5u);
+  EXPECT_EQ(comments.largest, 60u);
+  EXPECT_EQ(stats[StatementKind::kAttributeValue].count, 1u);
+  EXPECT_EQ(stats[StatementKind::kMessage].count, 0u);
+  EXPECT_EQ(stats.UnknownLines(), 0u);
+}
+
+TEST(ParseStatsTest, KeepsLargestStatementsBiggestFirst) {
+  ParseStats stats;
+  stats.largest_limit = 3;
+  const std::uint64_t sizes[] = {10, 50, 30, 5, 70, 40};
+  for (std::uint64_t i = 0; i < 6; ++i) {
+    stats.Record(StatementKind::kMessage, sizes[i], i * 100, i + 1, 0, 0, false);
+  }
+
+  ASSERT_EQ(stats.largest.size(), 3u);
+  EXPECT_EQ(stats.largest[0].bytes, 70u);
+  EXPECT_EQ(stats.largest[0].line, 5u);
+  EXPECT_EQ(stats.largest[0].offset, 400u);
+  EXPECT_EQ(stats.largest[1].bytes, 50u);
+  EXPECT_EQ(stats.largest[2].bytes, 40u);
+
+  stats.largest_limit = 0;
+  stats.Record(StatementKind::kMessage, 1000, 0, 1, 0, 0, false);
+  EXPECT_EQ(stats.largest.size(), 3u);
+}
+
+TEST(ParseStatsTest, ResetKeepsConfiguration) {
+  ParseStats stats;
+  stats.largest_limit = 2;
+  stats.allocation_counter = []() noexcept -> std::uint64_t { return 0; };
+  stats.input_bytes = 100;
+  stats.total_nanoseconds = 100;
+  stats.Record(StatementKind::kUnknown, 12, 0, 1, 0, 0, false);
+
+  stats.Reset();
+  EXPECT_EQ(stats.UnknownLines(), 0u);
+  EXPECT_TRUE(stats.largest.empty());
+  EXPECT_EQ(stats.input_bytes, 0u);
+  EXPECT_EQ(stats.total_nanoseconds, 0u);
+  EXPECT_EQ(stats.largest_limit, 2u);
+  EXPECT_NE(stats.allocation_counter, nullptr);
+}
+
+TEST(ParseStatsTest, FormatsOccurringKindsAsKeyValueLines) {
+  ParseStats stats;
+  stats.input_bytes = 500;
+  stats.total_nanoseconds = 9000;
+  stats.Record(StatementKind::kComment, 40, 7, 2, 100, 2, true);
+  stats.Record(StatementKind::kUnknown, 12, 60, 4, 5, 0, false);
+
+  const std::string text = stats.ToString();
+  EXPECT_NE(text.find("total bytes=500 ns=9000 unknown_lines=1\n"), std::string::npos);
+  EXPECT_NE(text.find("statement kind=CM_ count=1 failures=1 bytes=40 ns=100 allocations=2 largest=40\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("largest kind=CM_ bytes=40 offset=7 line=2\n"), std::string::npos);
+  EXPECT_EQ(text.find("kind=BO_ "), std::string::npos);
+}
+
+TEST(ParseStatsTest, NamesEveryKindByKeyword) {
+  EXPECT_EQ(ParseStats::KeywordOf(StatementKind::kMessage), "BO_");
+  EXPECT_EQ(ParseStats::KeywordOf(StatementKind::kAttributeDefault), "BA_DEF_DEF_");
+  EXPECT_EQ(ParseStats::KeywordOf(StatementKind::kSignalMultiplexValues), "SG_MUL_VAL_");
+  EXPECT_EQ(ParseStats::KeywordOf(StatementKind::kUnknown), "unknown");
+  for (std::size_t i = 0; i < kStatementKindCount; ++i) {
+    EXPECT_FALSE(ParseStats::KeywordOf(static_cast<StatementKind>(i)).empty());
+  }
+}
+
+}  // namespace
+}  // namespace parser
+}  // namespace dbc_parser
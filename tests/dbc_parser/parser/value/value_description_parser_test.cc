@@ -113,6 +113,18 @@ TEST_F(ValueDescriptionParserTest, HandlesEscapedQuotes) {
   ));
 }
 
+TEST_F(ValueDescriptionParserTest, StoresLatin1LabelsAsUtf8) {
+  const std::string kInput = "VAL_ 123 SignalName 0 \"\xDC" "berlast\" 1 \"Normal\";";
+
+  auto result = ValueDescriptionParser::Parse(kInput);
+  ASSERT_TRUE(result.has_value());
+
+  EXPECT_THAT(result->value_descriptions, UnorderedElementsAre(
+    Pair(0, "\xC3\x9C" "berlast"),
+    Pair(1, "Normal")
+  ));
+}
+
 TEST_F(ValueDescriptionParserTest, RejectsInvalidFormat) {
   const std::vector<std::string> kInvalidInputs = {
     // Missing VAL_ prefix
@@ -36,6 +36,15 @@ TEST(ValueTableParserTest, ParsesMultipleValues) {
   EXPECT_EQ(result->values.at(2), "Error");
 }
 
+TEST(ValueTableParserTest, StoresLatin1DescriptionsAsUtf8) {
+  const std::string input = "VAL_TABLE_ Gear 0 \"R\xFC" "ckw\xE4" "rts\" 1 \"Vorw\xE4" "rts\" ;";
+  auto result = ValueTableParser::Parse(input);
+  ASSERT_TRUE(result.has_value());
+  ASSERT_EQ(result->values.size(), 2);
+  EXPECT_EQ(result->values.at(0), "R\xC3\xBC" "ckw\xC3\xA4" "rts");
+  EXPECT_EQ(result->values.at(1), "Vorw\xC3\xA4" "rts");
+}
+
 TEST(ValueTableParserTest, HandlesWhitespace) {
   const std::string input = "  VAL_TABLE_  Engine_Status  0  \"Off\"   1  \"On\"  ;  ";
   auto result = ValueTableParser::Parse(input);
@@ -0,0 +1,160 @@
+#include "src/dbc_parser/rules/rule_compiler.h"
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace dbc_parser {
+namespace rules {
+namespace {
+
+using parser::DbcFile;
+using parser::Signal;
+using parser::TypeConverter;
+
+// BO_ 256 Engine with EngineSpeed (factor 0.25) and Status; BO_ 512
+// Transmission with GearPos, offset by -1, and Status;
+// VAL_ 512 GearPos 0 "R" 1 "N" 2 "D"
+DbcFile MakeFile() {
+  DbcFile dbc_file;
+  const std::tuple<int, const char*, std::vector<std::tuple<const char*, double, double>>> messages[] = {
+      {0x100, "Engine", {{"EngineSpeed", 0.25, 0.0}, {"Status", 1.0, 0.0}}},
+      {0x200, "Transmission", {{"GearPos", 1.0, -1.0}, {"Status", 1.0, 0.0}}},
+  };
+  for (const auto& [id, name, signals] : messages) {
+    DbcFile::MessageDef& message = dbc_file.messages_detailed[id];
+    message.id = id;
+    message.name = name;
+    message.size = 8;
+    message.first_signal = static_cast<std::uint32_t>(dbc_file.signal_layouts.size());
+    message.signal_count = static_cast<std::uint32_t>(signals.size());
+    int start_bit = 0;
+    for (const auto& [signal_name, factor, offset] : signals) {
+      Signal signal;
+      signal.name = signal_name;
+      signal.start_bit = start_bit;
+      signal.length = 16;
+      signal.factor = factor;
+      signal.offset = offset;
+      start_bit += 16;
+      dbc_file.signal_layouts.push_back(TypeConverter::ToSignalLayout(signal));
+      dbc_file.signal_infos.push_back(TypeConverter::ToSignalInfo(std::move(signal), id));
+    }
+  }
+  DbcFile::ValueDescription gear;
+  gear.message_id = 0x200;
+  gear.signal_name = "GearPos";
+  gear.values = {{0, "R"}, {1, "N"}, {2, "D"}};
+  dbc_file.value_descriptions.push_back(gear);
+  return dbc_file;
+}
+
+// Signal IDs of MakeFile
+constexpr std::uint32_t kEngineSpeed = 0;
+constexpr std::uint32_t kEngineStatus = 1;
+constexpr std::uint32_t kGearPos = 2;
+constexpr std::uint32_t kTransmissionStatus = 3;
+
+bool Holds(const CompiledRule& rule, const std::vector<double>& values) {
+  std::vector<double> stack(rule.max_stack);
+  return rule.Evaluate(values.data(), stack.data());
+}
+
+TEST(RuleCompilerTest, CompilesSignalsAndEnumLiterals) {
+  const DbcFile dbc_file = MakeFile();
+  const RuleCompiler compiler(dbc_file);
+  std::string error;
+  const auto rule = compiler.Compile("EngineSpeed > 6000 && GearPos == 'R'", &error);
+  ASSERT_TRUE(rule) << error;
+  EXPECT_EQ(rule->text, "EngineSpeed > 6000 && GearPos == 'R'");
+  EXPECT_EQ(rule->signals, (std::vector<std::uint32_t>{kEngineSpeed, kGearPos}));
+  EXPECT_EQ(rule->message_ids, (std::vector<int>{0x100, 0x200}));
+  // Two fused comparisons and the jump between them
+  ASSERT_EQ(rule->code.size(), 3u);
+  EXPECT_EQ(rule->code[0].op, OpCode::kSignalGreater);
+  EXPECT_EQ(rule->code[1].op, OpCode::kJumpIfFalse);
+  EXPECT_EQ(rule->code[2].op, OpCode::kSignalEqual);
+  // "R" is raw 0, physical -1
+  EXPECT_EQ(rule->code[2].value, -1.0);
+
+  EXPECT_TRUE(Holds(*rule, {6500, 0, -1, 0}));
+  EXPECT_FALSE(Holds(*rule, {6500, 0, 1, 0}));
+  EXPECT_FALSE(Holds(*rule, {5000, 0, -1, 0}));
+  EXPECT_FALSE(Holds(*rule, {std::nan(""), 0, -1, 0}));
+
+  // Literals on the left, double quotes and !=
+  const auto mirrored = compiler.Compile("6000 < EngineSpeed || \"D\" != GearPos");
+  ASSERT_TRUE(mirrored);
+  EXPECT_TRUE(Holds(*mirrored, {0, 0, 0, 0}));
+  EXPECT_FALSE(Holds(*mirrored, {0, 0, 1, 0}));
+  EXPECT_TRUE(Holds(*mirrored, {7000, 0, 1, 0}));
+  // != is false for NaN, like the other comparisons
+  EXPECT_FALSE(Holds(*mirrored, {0, 0, std::nan(""), 0}));
+
+  // A name in several messages is qualified by its message
+  const auto statuses = compiler.Compile("Engine.Status != Transmission.Status");
+  ASSERT_TRUE(statuses);
+  EXPECT_EQ(statuses->signals, (std::vector<std::uint32_t>{kEngineStatus, kTransmissionStatus}));
+}
+
+TEST(RuleCompilerTest, EvaluatesArithmeticWithPrecedence) {
+  const DbcFile dbc_file = MakeFile();
+  const RuleCompiler compiler(dbc_file);
+  const std::vector<double> values = {3000, 4, 1, 2};
+  for (const auto& [text, expected] : std::vector<std::pair<std::string, bool>>{
+           {"EngineSpeed / 1000 + Engine.Status * 2 == 11", true},
+           {"(EngineSpeed / 1000 + Engine.Status) * 2 == 14", true},
+           {"-Engine.Status < -3", true},
+           {"EngineSpeed - 1000 - 1000 == 1000", true},
+           {"!(EngineSpeed > 2000)", false},
+           {"!Transmission.Status || GearPos == 'N'", false},
+           {"Engine.Status - 4 || GearPos", true},
+           {"Engine.Status - 4 && GearPos", false},
+           {"Transmission.Status / 0 > 1e9", true},
+           {"EngineSpeed >= 0x0BB8 && EngineSpeed <= 3e3 && EngineSpeed != 2999.5", true},
+       }) {
+    std::string error;
+    const auto rule = compiler.Compile(text, &error);
+    ASSERT_TRUE(rule) << text << ": " << error;
+    EXPECT_EQ(Holds(*rule, values), expected) << text;
+  }
+
+  // Constant terms fold away
+  const auto folded = compiler.Compile("EngineSpeed > 60 * 100 + (2 > 1)");
+  ASSERT_TRUE(folded);
+  ASSERT_EQ(folded->code.size(), 1u);
+  EXPECT_EQ(folded->code[0].value, 6001.0);
+  EXPECT_EQ(folded->max_stack, 1u);
+}
+
+TEST(RuleCompilerTest, ReportsErrorsWithTheirColumn) {
+  const DbcFile dbc_file = MakeFile();
+  const RuleCompiler compiler(dbc_file);
+  for (const auto& [text, expected] : std::vector<std::pair<std::string, std::string>>{
+           {"Speed > 1", "column 1: unknown signal Speed"},
+           {"Status > 1", "column 1: signal Status is in several messages; write Message.Status"},
+           {"GearPos == 'P'", "column 12: signal GearPos has no value 'P'"},
+           {"EngineSpeed == 'R'", "column 16: signal EngineSpeed has no VAL_ descriptions"},
+           {"GearPos < 'R'", "column 11: 'R' is only compared with == or !="},
+           {"'R' && GearPos", "column 1: 'R' is not compared with a signal"},
+           {"EngineSpeed > ", "column 15: expected a value"},
+           {"(EngineSpeed > 1", "column 17: expected ')'"},
+           {"EngineSpeed > 1 > 0", "column 17: unexpected '>'"},
+           {"EngineSpeed & 1", "column 13: unexpected '&'"},
+           {"GearPos == 'R", "column 12: unterminated string"},
+       }) {
+    std::string error;
+    EXPECT_FALSE(compiler.Compile(text, &error)) << text;
+    EXPECT_EQ(error, expected) << text;
+  }
+  EXPECT_FALSE(compiler.Compile(""));
+}
+
+}  // namespace
+}  // namespace rules
+}  // namespace dbc_parser
@@ -0,0 +1,119 @@
+#include "src/dbc_parser/rules/rule_engine.h"
+
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace dbc_parser {
+namespace rules {
+namespace {
+
+using decoder::CanFrame;
+using decoder::FrameDecoder;
+using parser::DbcFile;
+using parser::Signal;
+using parser::TypeConverter;
+
+// BO_ 256 Engine with EngineSpeed (16 bits, factor 0.25); BO_ 512
+// Transmission with GearPos (byte 0) and VAL_ 512 GearPos 0 "P" 1 "R" 2 "D";
+// BO_ 768 Body, which no rule reads
+DbcFile MakeFile() {
+  DbcFile dbc_file;
+  for (const auto& [id, name, signal_name, length, factor] :
+       {std::tuple<int, const char*, const char*, int, double>{0x100, "Engine", "EngineSpeed", 16, 0.25},
+        {0x200, "Transmission", "GearPos", 8, 1.0},
+        {0x300, "Body", "DoorOpen", 1, 1.0}}) {
+    DbcFile::MessageDef& message = dbc_file.messages_detailed[id];
+    message.id = id;
+    message.name = name;
+    message.size = 8;
+    message.first_signal = static_cast<std::uint32_t>(dbc_file.signal_layouts.size());
+    message.signal_count = 1;
+    Signal signal;
+    signal.name = signal_name;
+    signal.length = length;
+    signal.factor = factor;
+    dbc_file.signal_layouts.push_back(TypeConverter::ToSignalLayout(signal));
+    dbc_file.signal_infos.push_back(TypeConverter::ToSignalInfo(std::move(signal), id));
+  }
+  DbcFile::ValueDescription gear;
+  gear.message_id = 0x200;
+  gear.signal_name = "GearPos";
+  gear.values = {{0, "P"}, {1, "R"}, {2, "D"}};
+  dbc_file.value_descriptions.push_back(gear);
+  return dbc_file;
+}
+
+CanFrame Frame(std::uint32_t id, std::int64_t timestamp_ns, std::uint16_t raw) {
+  CanFrame frame;
+  frame.id = id;
+  frame.timestamp_ns = timestamp_ns;
+  frame.size = 8;
+  frame.data[0] = static_cast<std::uint8_t>(raw);
+  frame.data[1] = static_cast<std::uint8_t>(raw >> 8);
+  return frame;
+}
+
+TEST(RuleEngineTest, TriggersWhenARuleStartsToHold) {
+  const DbcFile dbc_file = MakeFile();
+  const FrameDecoder decoder(dbc_file);
+  std::vector<std::pair<std::uint32_t, std::int64_t>> triggers;
+  RuleEngine engine(decoder, dbc_file, [&triggers](std::uint32_t rule_id, std::int64_t timestamp_ns) {
+    triggers.emplace_back(rule_id, timestamp_ns);
+  });
+  const auto reversing = engine.AddRule("EngineSpeed > 6000 && GearPos == 'R'");
+  const auto revving = engine.AddRule("EngineSpeed > 6000");
+  ASSERT_EQ(reversing, 0u);
+  ASSERT_EQ(revving, 1u);
+  EXPECT_EQ(engine.RulesOf(*decoder.Find(0x100)), (std::vector<std::uint32_t>{0, 1}));
+  EXPECT_EQ(engine.RulesOf(*decoder.Find(0x200)), (std::vector<std::uint32_t>{0}));
+  EXPECT_TRUE(engine.RulesOf(*decoder.Find(0x300)).empty());
+
+  // 7000 rpm before any gear: only the rule without GearPos runs
+  engine.OnFrame(Frame(0x100, 1, 28000));
+  EXPECT_EQ(engine.evaluated(), 1u);
+  EXPECT_EQ(engine.value(0), 7000.0);
+  engine.OnFrame(Frame(0x200, 2, 1));
+  engine.OnFrame(Frame(0x300, 3, 1));
+  // Still holding: no second trigger
+  engine.OnFrame(Frame(0x100, 4, 28000));
+  EXPECT_EQ(triggers, (std::vector<std::pair<std::uint32_t, std::int64_t>>{{1, 1}, {0, 2}}));
+  EXPECT_TRUE(engine.active(0));
+
+  // Drop below and come back in drive: only the speed rule again
+  engine.OnFrame(Frame(0x100, 5, 4000));
+  EXPECT_FALSE(engine.active(0));
+  EXPECT_FALSE(engine.active(1));
+  engine.OnFrame(Frame(0x200, 6, 2));
+  engine.OnFrame(Frame(0x100, 7, 28000));
+  EXPECT_EQ(triggers.back(), (std::pair<std::uint32_t, std::int64_t>{1, 7}));
+  EXPECT_EQ(engine.triggered(), 3u);
+  // Body frames were never decoded into a rule evaluation
+  EXPECT_EQ(engine.evaluated(), 1u + 1 + 2 + 2 + 1 + 2);
+}
+
+TEST(RuleEngineTest, RejectsRulesThatDoNotCompileOrReadNoSignal) {
+  const DbcFile dbc_file = MakeFile();
+  const FrameDecoder decoder(dbc_file);
+  RuleEngine engine(decoder, dbc_file, nullptr);
+  std::string error;
+  EXPECT_FALSE(engine.AddRule("GearPos == 'N'", &error));
+  EXPECT_EQ(error, "column 12: signal GearPos has no value 'N'");
+  EXPECT_FALSE(engine.AddRule("1 < 2", &error));
+  EXPECT_EQ(error, "the rule reads no signal");
+  EXPECT_EQ(engine.rule_count(), 0u);
+
+  ASSERT_TRUE(engine.AddRule("Body.DoorOpen"));
+  EXPECT_EQ(engine.rule(0).message_ids, (std::vector<int>{0x300}));
+  engine.OnFrame(Frame(0x300, 1, 1));
+  EXPECT_TRUE(engine.active(0));
+  EXPECT_EQ(engine.triggered(), 1u);
+}
+
+}  // namespace
+}  // namespace rules
+}  // namespace dbc_parser
@@ -0,0 +1,139 @@
+#include "src/dbc_parser/stats/quantile_sketch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace dbc_parser {
+namespace stats {
+namespace {
+
+// Fraction of sorted below value
+double RankOf(const std::vector<double>& sorted, double value) {
+  return static_cast<double>(std::lower_bound(sorted.begin(), sorted.end(), value) - sorted.begin()) /
+         static_cast<double>(sorted.size());
+}
+
+// Rank error bounds of the default compression, tighter towards the tails
+void ExpectAccurate(const QuantileSketch& sketch, std::vector<double> values) {
+  std::sort(values.begin(), values.end());
+  EXPECT_EQ(sketch.count(), values.size());
+  EXPECT_EQ(sketch.min(), values.front());
+  EXPECT_EQ(sketch.max(), values.back());
+  EXPECT_EQ(sketch.Quantile(0.0), values.front());
+  EXPECT_EQ(sketch.Quantile(1.0), values.back());
+  for (const auto& [q, bound] : {std::pair<double, double>{0.001, 2.5e-4},
+                                 {0.01, 5e-4},
+                                 {0.5, 1e-3},
+                                 {0.99, 5e-4},
+                                 {0.999, 2.5e-4},
+                                 {0.9999, 1e-4}}) {
+    EXPECT_NEAR(RankOf(values, sketch.Quantile(q)), q, bound) << "q=" << q;
+  }
+}
+
+std::vector<double> Draw(int distribution, std::size_t count) {
+  std::mt19937_64 rng(42 + distribution);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  std::normal_distribution<double> normal(50.0, 10.0);
+  std::exponential_distribution<double> exponential(1.0);
+  std::vector<double> values(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    switch (distribution) {
+      case 0:
+        values[i] = uniform(rng);
+        break;
+      case 1:
+        values[i] = normal(rng);
+        break;
+      case 2:
+        values[i] = exponential(rng);
+        break;
+      default:
+        // A ramp, as from a counter
+        values[i] = static_cast<double>(i);
+    }
+  }
+  return values;
+}
+
+TEST(QuantileSketchTest, EstimatesQuantilesWithinRankBounds) {
+  for (int distribution = 0; distribution < 4; ++distribution) {
+    SCOPED_TRACE(distribution);
+    const std::vector<double> values = Draw(distribution, 500000);
+    QuantileSketch sketch;
+    for (const double value : values) {
+      sketch.Add(value);
+    }
+    ExpectAccurate(sketch, values);
+    sketch.Compress();
+    EXPECT_LE(sketch.centroids().size(), 200u);
+  }
+}
+
+TEST(QuantileSketchTest, MergedSketchesAreAsAccurate) {
+  for (int distribution = 0; distribution < 4; ++distribution) {
+    SCOPED_TRACE(distribution);
+    const std::vector<double> values = Draw(distribution, 500000);
+    // Contiguous parts, so a ramp gives each part a disjoint range
+    std::vector<QuantileSketch> parts(7);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      parts[i * parts.size() / values.size()].Add(values[i]);
+    }
+    QuantileSketch merged;
+    for (const QuantileSketch& part : parts) {
+      merged.Merge(part);
+    }
+    ExpectAccurate(merged, values);
+
+    // A tree of merges ends in the same place
+    QuantileSketch left;
+    QuantileSketch right;
+    for (std::size_t i = 0; i < parts.size(); ++i) {
+      (i < 3 ? left : right).Merge(parts[i]);
+    }
+    right.Merge(left);
+    ExpectAccurate(right, values);
+  }
+}
+
+TEST(QuantileSketchTest, SmallAndDiscreteStreams) {
+  QuantileSketch sketch;
+  EXPECT_TRUE(std::isnan(sketch.Quantile(0.5)));
+  sketch.Add(std::nan(""));
+  EXPECT_EQ(sketch.count(), 0u);
+
+  sketch.Add(7.0);
+  EXPECT_EQ(sketch.Quantile(0.0), 7.0);
+  EXPECT_EQ(sketch.Quantile(0.5), 7.0);
+  EXPECT_EQ(sketch.Quantile(1.0), 7.0);
+
+  // Few values are kept exactly
+  QuantileSketch few;
+  for (const double value : {5.0, 1.0, 4.0, 2.0, 3.0}) {
+    few.Add(value);
+  }
+  EXPECT_EQ(few.Quantile(0.5), 3.0);
+  EXPECT_EQ(few.Quantile(0.1), 1.0);
+  EXPECT_EQ(few.Quantile(0.9), 5.0);
+
+  // An enum-like signal: estimates stay within the values around the rank
+  QuantileSketch gears;
+  for (int i = 0; i < 100000; ++i) {
+    gears.Add(static_cast<double>(i % 10 < 6 ? 3 : i % 10 < 9 ? 4 : 5));
+  }
+  EXPECT_GE(gears.Quantile(0.3), 3.0);
+  EXPECT_LE(gears.Quantile(0.3), 3.0 + 1e-9);
+  EXPECT_GE(gears.Quantile(0.75), 3.0);
+  EXPECT_LE(gears.Quantile(0.75), 4.0);
+  EXPECT_EQ(gears.Quantile(0.999), 5.0);
+}
+
+}  // namespace
+}  // namespace stats
+}  // namespace dbc_parser
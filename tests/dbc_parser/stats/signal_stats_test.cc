@@ -0,0 +1,149 @@
+#include "src/dbc_parser/stats/signal_stats.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "src/dbc_parser/decoder/candump_parser.h"
+
+namespace dbc_parser {
+namespace stats {
+namespace {
+
+using decoder::CandumpParser;
+using decoder::FrameDecoder;
+using decoder::LogDecodeOptions;
+using decoder::LogDecoder;
+using parser::DbcFile;
+using parser::Signal;
+using parser::TypeConverter;
+
+Signal MakeSignal(const char* name, int start_bit, int length, double minimum, double maximum) {
+  Signal signal;
+  signal.name = name;
+  signal.start_bit = start_bit;
+  signal.length = length;
+  signal.minimum = minimum;
+  signal.maximum = maximum;
+  return signal;
+}
+
+// BO_ 256 with Speed [0|200] (byte 0) and Load without a range (byte 1)
+DbcFile MakeFile() {
+  DbcFile dbc_file;
+  DbcFile::MessageDef& message = dbc_file.messages_detailed[0x100];
+  message.id = 0x100;
+  message.name = "Engine";
+  message.size = 8;
+  message.signal_count = 2;
+  for (Signal signal : {MakeSignal("Speed", 0, 8, 0, 200), MakeSignal("Load", 8, 8, 0, 0)}) {
+    dbc_file.signal_layouts.push_back(TypeConverter::ToSignalLayout(signal));
+    dbc_file.signal_infos.push_back(TypeConverter::ToSignalInfo(std::move(signal), 0x100));
+  }
+  return dbc_file;
+}
+
+TEST(SignalStatsTest, WelfordMomentsStayAccurateAndMerge) {
+  // A large offset defeats the sum-of-squares formula, not Welford's
+  SignalMoments all;
+  SignalMoments parts[3];
+  double sum = 0.0;
+  const int count = 300000;
+  for (int i = 0; i < count; ++i) {
+    const double value = 1e9 + (i % 100) * 0.01;
+    sum += (i % 100) * 0.01;
+    all.Add(value);
+    parts[i % 3].Add(value);
+  }
+  const double mean = 1e9 + sum / count;
+  // Variance of 0, 0.01, ..., 0.99
+  const double variance = (100.0 * 100.0 - 1.0) / 12.0 * 1e-4;
+  EXPECT_NEAR(all.mean, mean, 1e-6);
+  EXPECT_NEAR(all.Variance(), variance, 1e-6);
+  EXPECT_EQ(all.min, 1e9);
+  EXPECT_EQ(all.max, 1e9 + 0.99);
+
+  SignalMoments merged;
+  merged.Merge(SignalMoments());
+  for (const SignalMoments& part : parts) {
+    merged.Merge(part);
+  }
+  EXPECT_EQ(merged.count, all.count);
+  EXPECT_NEAR(merged.mean, all.mean, 1e-6);
+  EXPECT_NEAR(merged.Variance(), all.Variance(), 1e-6);
+  EXPECT_NEAR(merged.StandardDeviation(), std::sqrt(variance), 1e-6);
+  EXPECT_EQ(merged.min, all.min);
+  EXPECT_EQ(merged.max, all.max);
+  EXPECT_EQ(SignalMoments().Variance(), 0.0);
+}
+
+TEST(SignalStatsTest, CountsSamplesOutOfRange) {
+  const DbcFile dbc_file = MakeFile();
+  SignalStats stats(dbc_file);
+  ASSERT_EQ(stats.signal_count(), 2u);
+  for (const double value : {-1.0, 0.0, 100.0, 200.0, 250.0, 251.0, std::nan("")}) {
+    stats.Add(0, value);
+    stats.Add(1, value);
+  }
+  EXPECT_EQ(stats.moments(0).count, 6u);
+  EXPECT_EQ(stats.moments(0).below_minimum, 1u);
+  EXPECT_EQ(stats.moments(0).above_maximum, 2u);
+  // [0|0] is no range
+  EXPECT_EQ(stats.moments(1).below_minimum, 0u);
+  EXPECT_EQ(stats.moments(1).above_maximum, 0u);
+  EXPECT_EQ(stats.Quantile(0, 1.0), 251.0);
+  EXPECT_EQ(stats.sketch(1).count(), 6u);
+}
+
+TEST(SignalStatsTest, CollectsOnDecoderWorkers) {
+  const DbcFile dbc_file = MakeFile();
+  const FrameDecoder decoder(dbc_file);
+  std::string log;
+  SignalStats expected(dbc_file);
+  for (int i = 0; i < 20000; ++i) {
+    const int speed = (i * 7) % 256;
+    const int load = (i * 13) % 101;
+    char line[64];
+    std::snprintf(line, sizeof(line), "(%d.%06d) can0 100#%02X%02X\n", i / 1000, i % 1000 * 1000, speed, load);
+    log += line;
+    expected.Add(0, speed);
+    expected.Add(1, load);
+  }
+  log += "(30.000000) can0 200#00\n";
+
+  for (const std::size_t threads : {std::size_t{1}, std::size_t{4}}) {
+    SCOPED_TRACE(threads);
+    LogDecodeOptions options;
+    options.threads = threads;
+    options.chunk_bytes = 4096;
+    SignalStatsCollector collector(dbc_file, options);
+    const auto decoded = LogDecoder(decoder, &CandumpParser::ParseLine, options).Decode(log);
+    EXPECT_EQ(decoded.frames, 20001u);
+    const SignalStats stats = collector.Finish();
+
+    for (std::uint32_t signal = 0; signal < 2; ++signal) {
+      const SignalMoments& got = stats.moments(signal);
+      const SignalMoments& want = expected.moments(signal);
+      EXPECT_EQ(got.count, 20000u);
+      EXPECT_NEAR(got.mean, want.mean, 1e-9);
+      EXPECT_NEAR(got.Variance(), want.Variance(), 1e-6);
+      EXPECT_EQ(got.min, want.min);
+      EXPECT_EQ(got.max, want.max);
+      EXPECT_EQ(got.below_minimum, want.below_minimum);
+      EXPECT_EQ(got.above_maximum, want.above_maximum);
+      for (const double q : {0.5, 0.99, 0.999}) {
+        EXPECT_NEAR(stats.Quantile(signal, q), expected.Quantile(signal, q), 1.0) << q;
+      }
+    }
+    // Speeds of 201 to 255: 55 of every 256 frames, and 3 of the last 32
+    EXPECT_EQ(stats.moments(0).above_maximum, 78u * 55 + 3);
+  }
+}
+
+}  // namespace
+}  // namespace stats
+}  // namespace dbc_parser
@@ -0,0 +1,195 @@
+#include "src/dbc_parser/stats/window_aggregator.h"
+
+#include <cmath>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace dbc_parser {
+namespace stats {
+namespace {
+
+using decoder::FrameDecoder;
+using parser::DbcFile;
+using parser::Signal;
+using parser::TypeConverter;
+
+constexpr std::int64_t kSecond = 1'000'000'000;
+
+// BO_ 256 with Speed (byte 0, factor 0.5) and Gear (byte 1) with
+// VAL_ 256 Gear 0 "P" 1 "R" 2 "N" 3 "D"
+DbcFile MakeFile() {
+  DbcFile dbc_file;
+  DbcFile::MessageDef& message = dbc_file.messages_detailed[0x100];
+  message.id = 0x100;
+  message.name = "Drive";
+  message.size = 8;
+  message.signal_count = 2;
+  for (auto [name, start_bit, factor] : {std::tuple<const char*, int, double>{"Speed", 0, 0.5}, {"Gear", 8, 1.0}}) {
+    Signal signal;
+    signal.name = name;
+    signal.start_bit = start_bit;
+    signal.length = 8;
+    signal.factor = factor;
+    dbc_file.signal_layouts.push_back(TypeConverter::ToSignalLayout(signal));
+    dbc_file.signal_infos.push_back(TypeConverter::ToSignalInfo(std::move(signal), 0x100));
+  }
+  DbcFile::ValueDescription gear;
+  gear.message_id = 0x100;
+  gear.signal_name = "Gear";
+  gear.values = {{0, "P"}, {1, "R"}, {2, "N"}, {3, "D"}};
+  dbc_file.value_descriptions.push_back(gear);
+  return dbc_file;
+}
+
+struct Collected {
+  std::vector<SignalWindow> windows;
+  std::vector<std::size_t> batches;
+
+  WindowAggregator::WindowCallback Callback() {
+    return [this](const SignalWindow* windows, std::size_t count) {
+      this->windows.insert(this->windows.end(), windows, windows + count);
+      batches.push_back(count);
+    };
+  }
+
+  std::vector<SignalWindow> Of(std::uint32_t signal_id, std::uint32_t resolution) const {
+    std::vector<SignalWindow> found;
+    for (const SignalWindow& window : windows) {
+      if (window.signal_id == signal_id && window.resolution == resolution) {
+        found.push_back(window);
+      }
+    }
+    return found;
+  }
+};
+
+TEST(WindowAggregatorTest, AggregatesSeveralResolutionsAtOnce) {
+  const DbcFile dbc_file = MakeFile();
+  const FrameDecoder decoder(dbc_file);
+  WindowAggregatorOptions options;
+  options.resolutions_ns = {kSecond, 10 * kSecond};
+  options.batch_windows = 4;
+  Collected collected;
+  WindowAggregator aggregator(dbc_file, collected.Callback(), options);
+  EXPECT_FALSE(aggregator.is_enum(0));
+  EXPECT_TRUE(aggregator.is_enum(1));
+
+  // 100 Hz for 25 s; Speed ramps 0..99 every second
+  for (int i = 0; i < 2500; ++i) {
+    const double values[2] = {static_cast<double>(i % 100), 3.0};
+    aggregator.AddMessage(*decoder.Find(0x100), 5 * kSecond + i * (kSecond / 100), values);
+  }
+  // Nothing open is emitted before Finish
+  EXPECT_EQ(aggregator.emitted(), collected.windows.size());
+  aggregator.Finish();
+
+  const std::vector<SignalWindow> seconds = collected.Of(0, 0);
+  ASSERT_EQ(seconds.size(), 25u);
+  for (std::size_t i = 0; i < seconds.size(); ++i) {
+    EXPECT_EQ(seconds[i].start_ns, static_cast<std::int64_t>(5 + i) * kSecond);
+    EXPECT_EQ(seconds[i].count, 100u);
+    EXPECT_EQ(seconds[i].first, 0.0);
+    EXPECT_EQ(seconds[i].last, 99.0);
+    EXPECT_EQ(seconds[i].min, 0.0);
+    EXPECT_EQ(seconds[i].max, 99.0);
+    EXPECT_DOUBLE_EQ(seconds[i].mean, 49.5);
+    EXPECT_TRUE(std::isnan(seconds[i].mode));
+  }
+
+  // 10 s windows are aligned to multiples of 10 s, so the first is partial
+  const std::vector<SignalWindow> tens = collected.Of(0, 1);
+  ASSERT_EQ(tens.size(), 3u);
+  EXPECT_EQ(tens[0].start_ns, 0);
+  EXPECT_EQ(tens[0].count, 500u);
+  EXPECT_EQ(tens[1].start_ns, 10 * kSecond);
+  EXPECT_EQ(tens[1].count, 1000u);
+  EXPECT_EQ(tens[2].start_ns, 20 * kSecond);
+  EXPECT_EQ(tens[2].count, 1000u);
+
+  const std::vector<SignalWindow> gears = collected.Of(1, 0);
+  ASSERT_EQ(gears.size(), 25u);
+  EXPECT_TRUE(std::isnan(gears[0].mean));
+  EXPECT_EQ(gears[0].mode, 3.0);
+
+  EXPECT_EQ(aggregator.emitted(), 2 * (25u + 3u));
+  for (const std::size_t batch : collected.batches) {
+    EXPECT_LE(batch, 4u);
+  }
+  EXPECT_GT(collected.batches.size(), 10u);
+}
+
+TEST(WindowAggregatorTest, EnumSignalsTakeTheMode) {
+  const DbcFile dbc_file = MakeFile();
+  WindowAggregatorOptions options;
+  options.resolutions_ns = {kSecond};
+  Collected collected;
+  WindowAggregator aggregator(dbc_file, collected.Callback(), options);
+
+  // Mostly D with a short stop in N, ending in N
+  const std::vector<double> first = {3, 3, 3, 2, 2, 3, 3, 2};
+  // A tie between R and N goes to the smaller value
+  const std::vector<double> second = {2, 1, 1, 2};
+  // No described value at all keeps the last one
+  const std::vector<double> third = {7, 9, std::nan(""), 8};
+  for (const auto& [second_index, values] :
+       {std::pair<int, const std::vector<double>*>{0, &first}, {1, &second}, {2, &third}}) {
+    for (std::size_t i = 0; i < values->size(); ++i) {
+      aggregator.Add(1, second_index * kSecond + static_cast<std::int64_t>(i) * 1000, (*values)[i]);
+    }
+  }
+  aggregator.Finish();
+
+  const std::vector<SignalWindow> windows = collected.Of(1, 0);
+  ASSERT_EQ(windows.size(), 3u);
+  EXPECT_EQ(windows[0].mode, 3.0);
+  EXPECT_EQ(windows[0].last, 2.0);
+  EXPECT_EQ(windows[0].count, 8u);
+  EXPECT_EQ(windows[1].mode, 1.0);
+  EXPECT_EQ(windows[2].mode, 8.0);
+  EXPECT_EQ(windows[2].count, 3u);
+  EXPECT_EQ(windows[2].min, 7.0);
+  EXPECT_EQ(windows[2].max, 9.0);
+}
+
+TEST(WindowAggregatorTest, ClosesWindowsOfSilentSignals) {
+  const DbcFile dbc_file = MakeFile();
+  WindowAggregatorOptions options;
+  options.resolutions_ns = {kSecond, 60 * kSecond};
+  Collected collected;
+  WindowAggregator aggregator(dbc_file, collected.Callback(), options);
+
+  // Times before the epoch align downwards too
+  aggregator.Add(0, -kSecond / 2, 1.0);
+  aggregator.Add(0, 0, 2.0);
+  aggregator.Add(0, kSecond / 2, 4.0);
+  ASSERT_EQ(collected.windows.size(), 0u);
+
+  // Closed windows wait for a batch until CloseBefore
+  aggregator.CloseBefore(kSecond);
+  ASSERT_EQ(collected.windows.size(), 3u);
+  const std::vector<SignalWindow> seconds = collected.Of(0, 0);
+  ASSERT_EQ(seconds.size(), 2u);
+  EXPECT_EQ(seconds[0].start_ns, -kSecond);
+  EXPECT_EQ(seconds[0].count, 1u);
+  EXPECT_EQ(seconds[1].start_ns, 0);
+  EXPECT_DOUBLE_EQ(seconds[1].mean, 3.0);
+  ASSERT_EQ(collected.Of(0, 1).size(), 1u);
+  EXPECT_EQ(collected.Of(0, 1)[0].start_ns, -60 * kSecond);
+
+  // The minute from 0 stays open until it ends
+  aggregator.CloseBefore(59 * kSecond);
+  EXPECT_EQ(collected.windows.size(), 3u);
+  aggregator.Finish();
+  ASSERT_EQ(collected.windows.size(), 4u);
+  EXPECT_EQ(collected.windows.back().start_ns, 0);
+  EXPECT_EQ(collected.windows.back().count, 2u);
+  EXPECT_EQ(aggregator.emitted(), 4u);
+}
+
+}  // namespace
+}  // namespace stats
+}  // namespace dbc_parser
@@ -0,0 +1,132 @@
+#include "src/dbc_parser/storage/column_codec.h"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "src/dbc_parser/storage/bit_stream.h"
+
+namespace dbc_parser {
+namespace storage {
+namespace {
+
+std::uint64_t Bits(double value) {
+  std::uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+TEST(BitStreamTest, RoundTripsFieldsOfEveryWidth) {
+  std::mt19937_64 rng(46);
+  std::vector<std::pair<std::uint64_t, unsigned>> fields;
+  BitWriter writer;
+  for (int i = 0; i < 5000; ++i) {
+    const unsigned width = static_cast<unsigned>(rng() % 65);
+    const std::uint64_t value = width == 0 ? 0 : rng() >> (64 - width);
+    fields.emplace_back(value, width);
+    writer.Write(value | (width < 64 ? ~std::uint64_t{0} << width : 0), width);
+  }
+  writer.Finish();
+
+  BitReader reader(writer.bytes().data(), writer.bytes().size());
+  for (const auto& [value, width] : fields) {
+    ASSERT_EQ(reader.Read(width), value) << width;
+  }
+  EXPECT_FALSE(reader.overrun());
+  reader.Read(8);
+  EXPECT_TRUE(reader.overrun());
+}
+
+// Encodes both columns like ColumnWriter and decodes them back
+void ExpectRoundTrip(const std::vector<std::int64_t>& timestamps, const std::vector<double>& values,
+                     std::size_t* encoded_bytes = nullptr) {
+  BitWriter timestamp_bits;
+  BitWriter value_bits;
+  TimestampEncoder timestamp_encoder;
+  ValueEncoder value_encoder;
+  timestamp_encoder.Start(timestamps[0]);
+  for (std::size_t i = 0; i < timestamps.size(); ++i) {
+    if (i > 0) {
+      timestamp_encoder.Add(timestamps[i], timestamp_bits);
+    }
+    value_encoder.Add(values[i], value_bits);
+  }
+  timestamp_bits.Finish();
+  value_bits.Finish();
+  if (encoded_bytes != nullptr) {
+    *encoded_bytes = timestamp_bits.bytes().size() + value_bits.bytes().size();
+  }
+
+  BitReader timestamp_reader(timestamp_bits.bytes().data(), timestamp_bits.bytes().size());
+  BitReader value_reader(value_bits.bytes().data(), value_bits.bytes().size());
+  TimestampDecoder timestamp_decoder(timestamps[0]);
+  ValueDecoder value_decoder;
+  for (std::size_t i = 0; i < timestamps.size(); ++i) {
+    if (i > 0) {
+      ASSERT_EQ(timestamp_decoder.Next(timestamp_reader), timestamps[i]) << i;
+    }
+    // Bit-exact, NaN payloads and negative zero included
+    ASSERT_EQ(Bits(value_decoder.Next(value_reader)), Bits(values[i])) << i;
+  }
+  EXPECT_FALSE(timestamp_reader.overrun());
+  EXPECT_FALSE(value_reader.overrun());
+}
+
+TEST(ColumnCodecTest, CompressesPeriodicSignals) {
+  // A 10 ms message with a few microseconds of jitter, carrying a slowly
+  // changing speed scaled by 0.01
+  std::mt19937 rng(7);
+  std::vector<std::int64_t> timestamps;
+  std::vector<double> values;
+  std::int64_t raw = 5000;
+  for (int i = 0; i < 100000; ++i) {
+    timestamps.push_back(1'600'000'000'000'000'000 + i * std::int64_t{10'000'000} + rng() % 4000);
+    if (rng() % 8 == 0) {
+      raw += static_cast<int>(rng() % 5) - 2;
+    }
+    values.push_back(static_cast<double>(raw) * 0.01);
+  }
+  std::size_t encoded = 0;
+  ExpectRoundTrip(timestamps, values, &encoded);
+  // 16 bytes per sample as raw int64 and double
+  EXPECT_LT(encoded, timestamps.size() * 16 / 4);
+
+  // Constant cycle and value: one bit per column and sample, after the
+  // first value and delta
+  std::vector<std::int64_t> regular;
+  for (int i = 0; i < 1000; ++i) {
+    regular.push_back(i * std::int64_t{100'000'000});
+  }
+  ExpectRoundTrip(regular, std::vector<double>(regular.size(), 1.0), &encoded);
+  EXPECT_LE(encoded, 2 * 1000 / 8 + 16);
+}
+
+TEST(ColumnCodecTest, RoundTripsExtremes) {
+  const std::vector<std::int64_t> timestamps = {
+      0, 1, -5, std::numeric_limits<std::int64_t>::max(), std::numeric_limits<std::int64_t>::min(), 0, 3'000'000'000,
+      3'000'000'001, 42};
+  const std::vector<double> values = {
+      0.0, -0.0, std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::infinity(), 1e300,
+      std::numeric_limits<double>::denorm_min(), -1.5, -1.5, 3.0};
+  ExpectRoundTrip(timestamps, values);
+
+  std::mt19937_64 rng(11);
+  std::vector<std::int64_t> random_timestamps;
+  std::vector<double> random_values;
+  for (int i = 0; i < 10000; ++i) {
+    random_timestamps.push_back(static_cast<std::int64_t>(rng()));
+    const std::uint64_t bits = rng();
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    random_values.push_back(value);
+  }
+  ExpectRoundTrip(random_timestamps, random_values);
+}
+
+}  // namespace
+}  // namespace storage
+}  // namespace dbc_parser
@@ -0,0 +1,283 @@
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "src/dbc_parser/decoder/frame_decoder.h"
+#include "src/dbc_parser/storage/column_reader.h"
+#include "src/dbc_parser/storage/column_writer.h"
+
+namespace dbc_parser {
+namespace storage {
+namespace {
+
+using decoder::CanFrame;
+using decoder::FrameDecoder;
+using parser::DbcFile;
+using parser::Signal;
+using parser::TypeConverter;
+
+void AddMessage(DbcFile& dbc_file, int id, std::vector<Signal> signals) {
+  DbcFile::MessageDef& message = dbc_file.messages_detailed[id];
+  message.id = id;
+  message.size = 8;
+  message.first_signal = static_cast<std::uint32_t>(dbc_file.signal_layouts.size());
+  message.signal_count = static_cast<std::uint32_t>(signals.size());
+  for (Signal& signal : signals) {
+    dbc_file.signal_layouts.push_back(TypeConverter::ToSignalLayout(signal));
+    dbc_file.signal_infos.push_back(TypeConverter::ToSignalInfo(std::move(signal), id));
+  }
+}
+
+Signal MakeSignal(const char* name, int start_bit, int length, double factor, const char* unit = "") {
+  Signal signal;
+  signal.name = name;
+  signal.start_bit = start_bit;
+  signal.length = length;
+  signal.factor = factor;
+  signal.unit = unit;
+  signal.maximum = std::ldexp(1.0, length) * factor;
+  return signal;
+}
+
+// Engine (0x100): Speed, Gear with value descriptions; Brake (0x200): Pressure
+DbcFile MakeFile() {
+  DbcFile dbc_file;
+  AddMessage(dbc_file, 0x100, {MakeSignal("Speed", 0, 16, 0.01, "km/h"), MakeSignal("Gear", 16, 4, 1.0)});
+  AddMessage(dbc_file, 0x200, {MakeSignal("Pressure", 0, 16, 0.1, "bar")});
+  DbcFile::ValueDescription gear;
+  gear.message_id = 0x100;
+  gear.signal_name = "Gear";
+  gear.values = {{0, "N"}, {1, "D"}, {15, "R"}};
+  dbc_file.value_descriptions.push_back(gear);
+  return dbc_file;
+}
+
+struct Sample {
+  std::int64_t timestamp_ns;
+  double value;
+
+  bool operator==(const Sample& other) const {
+    return timestamp_ns == other.timestamp_ns && value == other.value;
+  }
+};
+
+// Engine every 10 ms for frames frames, Brake every 20 ms; returns the
+// expected samples by signal ID
+std::vector<std::vector<Sample>> WriteDrive(ColumnWriter& writer, const FrameDecoder& decoder, int frames) {
+  std::vector<std::vector<Sample>> expected(3);
+  double values[2];
+  for (int i = 0; i < frames; ++i) {
+    CanFrame frame;
+    frame.timestamp_ns = 1'000'000'000 + i * std::int64_t{10'000'000} + (i % 7) * 1000;
+    frame.size = 8;
+    const int speed = 5000 + (i / 10) % 300;
+    frame.id = 0x100;
+    frame.data[0] = static_cast<std::uint8_t>(speed & 0xFF);
+    frame.data[1] = static_cast<std::uint8_t>(speed >> 8);
+    frame.data[2] = static_cast<std::uint8_t>(i / 500 % 2 == 0 ? 1 : 15);
+    const FrameDecoder::MessageEntry* engine = decoder.Find(frame.dbc_id());
+    (void)decoder.Decode(frame, values);
+    writer.AddMessage(*engine, frame.timestamp_ns, values);
+    expected[0].push_back({frame.timestamp_ns, values[0]});
+    expected[1].push_back({frame.timestamp_ns, values[1]});
+    if (i % 2 == 0) {
+      frame.id = 0x200;
+      frame.data[0] = static_cast<std::uint8_t>(i % 251);
+      frame.data[1] = 0;
+      (void)decoder.Decode(frame, values);
+      writer.AddMessage(*decoder.Find(frame.dbc_id()), frame.timestamp_ns, values);
+      expected[2].push_back({frame.timestamp_ns, values[0]});
+    }
+  }
+  return expected;
+}
+
+std::vector<Sample> ScanAll(const ColumnReader& reader, std::uint32_t signal_id,
+                            std::int64_t from_ns = std::numeric_limits<std::int64_t>::min(),
+                            std::int64_t to_ns = std::numeric_limits<std::int64_t>::max()) {
+  std::vector<Sample> samples;
+  const auto count = reader.Scan(
+      signal_id,
+      [&samples](const std::int64_t* timestamps, const double* values, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+          samples.push_back({timestamps[i], values[i]});
+        }
+      },
+      from_ns, to_ns);
+  EXPECT_EQ(count, std::optional<std::size_t>(samples.size()));
+  return samples;
+}
+
+TEST(ColumnFileTest, WritesAndScansSignals) {
+  const DbcFile dbc_file = MakeFile();
+  const FrameDecoder decoder(dbc_file);
+  std::ostringstream out;
+  ColumnWriterOptions options;
+  options.chunk_samples = 1000;
+  ColumnWriter writer(out, dbc_file, options);
+  const auto expected = WriteDrive(writer, decoder, 20000);
+  ASSERT_TRUE(writer.Finish());
+  EXPECT_EQ(writer.stats().samples, 50000u);
+  EXPECT_EQ(writer.stats().chunks, 50u);
+  const std::string file = out.str();
+  EXPECT_EQ(writer.stats().bytes, file.size());
+  // Far below the 16 bytes of a raw timestamp and double
+  EXPECT_LT(file.size(), 50000u * 16 / 4);
+
+  const auto reader = ColumnReader::Open(file);
+  ASSERT_TRUE(reader.has_value());
+  ASSERT_EQ(reader->signals().size(), 3u);
+  const ColumnSignal* speed = reader->FindSignal("Speed");
+  ASSERT_NE(speed, nullptr);
+  EXPECT_EQ(speed->signal_id, 0u);
+  EXPECT_EQ(speed->message_id, 0x100u);
+  EXPECT_EQ(speed->unit, "km/h");
+  EXPECT_DOUBLE_EQ(speed->factor, 0.01);
+  EXPECT_DOUBLE_EQ(speed->maximum, 655.36);
+  const ColumnSignal* gear = reader->FindSignal("Gear", 0x100u);
+  ASSERT_NE(gear, nullptr);
+  EXPECT_EQ(gear->value_descriptions.size(), 3u);
+  EXPECT_EQ(gear->value_descriptions.at(15), "R");
+  EXPECT_EQ(reader->FindSignal("Gear", 0x200u), nullptr);
+  EXPECT_EQ(reader->FindSignal(2)->name, "Pressure");
+
+  for (std::uint32_t signal_id = 0; signal_id < 3; ++signal_id) {
+    EXPECT_EQ(ScanAll(*reader, signal_id), expected[signal_id]) << signal_id;
+  }
+
+  // A time range decodes only the chunks it overlaps
+  const std::vector<ColumnChunk> chunks = reader->ChunksOf(0);
+  ASSERT_EQ(chunks.size(), 20u);
+  EXPECT_EQ(chunks[3].count, 1000u);
+  EXPECT_EQ(chunks[3].first_ns, expected[0][3000].timestamp_ns);
+  EXPECT_EQ(chunks[3].max_ns, expected[0][3999].timestamp_ns);
+  const std::int64_t from_ns = expected[0][3500].timestamp_ns;
+  const std::int64_t to_ns = expected[0][4200].timestamp_ns;
+  const std::vector<Sample> range = ScanAll(*reader, 0, from_ns, to_ns);
+  EXPECT_EQ(range, std::vector<Sample>(expected[0].begin() + 3500, expected[0].begin() + 4201));
+}
+
+TEST(ColumnFileTest, ScansOneSignalWithoutTouchingOthers) {
+  const DbcFile dbc_file = MakeFile();
+  const FrameDecoder decoder(dbc_file);
+  std::ostringstream out;
+  ColumnWriterOptions options;
+  options.chunk_samples = 500;
+  ColumnWriter writer(out, dbc_file, options);
+  const auto expected = WriteDrive(writer, decoder, 5000);
+  ASSERT_TRUE(writer.Finish());
+  std::string file = out.str();
+
+  // Wreck every chunk of Gear and Pressure
+  {
+    const auto reader = ColumnReader::Open(file);
+    ASSERT_TRUE(reader.has_value());
+    for (const std::uint32_t signal_id : {1u, 2u}) {
+      for (const ColumnChunk& chunk : reader->ChunksOf(signal_id)) {
+        file.replace(chunk.offset, chunk.timestamp_bytes + chunk.value_bytes,
+                     std::string(chunk.timestamp_bytes + chunk.value_bytes, '\xFF'));
+      }
+    }
+  }
+  const auto reader = ColumnReader::Open(file);
+  ASSERT_TRUE(reader.has_value());
+  EXPECT_EQ(ScanAll(*reader, 0), expected[0]);
+  // All-ones timestamps ask for 64-bit deltas the column does not have
+  EXPECT_FALSE(reader->Scan(2, [](const std::int64_t*, const double*, std::size_t) {}).has_value());
+}
+
+TEST(ColumnFileTest, RejectsIncompleteFiles) {
+  const DbcFile dbc_file = MakeFile();
+  const FrameDecoder decoder(dbc_file);
+  std::ostringstream out;
+  ColumnWriter writer(out, dbc_file);
+  WriteDrive(writer, decoder, 100);
+  ASSERT_TRUE(writer.Finish());
+  const std::string file = out.str();
+  ASSERT_TRUE(ColumnReader::Open(file).has_value());
+
+  EXPECT_FALSE(ColumnReader::Open("").has_value());
+  EXPECT_FALSE(ColumnReader::Open(file.substr(0, file.size() - 1)).has_value());
+  EXPECT_FALSE(ColumnReader::Open(file.substr(0, file.size() / 2)).has_value());
+  std::string bad_offset = file;
+  bad_offset[bad_offset.size() - 10] = '\x7F';
+  EXPECT_FALSE(ColumnReader::Open(bad_offset).has_value());
+
+  // No samples at all is still a valid file
+  std::ostringstream empty;
+  ColumnWriter empty_writer(empty, dbc_file);
+  ASSERT_TRUE(empty_writer.Finish());
+  const auto empty_reader = ColumnReader::Open(empty.str());
+  ASSERT_TRUE(empty_reader.has_value());
+  EXPECT_TRUE(empty_reader->signals().empty());
+  EXPECT_EQ(empty_reader->Scan(0, nullptr), std::optional<std::size_t>(0));
+}
+
+// A chunk count the encoded columns cannot hold is rejected on open, before
+// Scan sizes its buffers by it
+TEST(ColumnFileTest, RejectsChunkCountLargerThanItsColumns) {
+  const DbcFile dbc_file = MakeFile();
+  const FrameDecoder decoder(dbc_file);
+  std::ostringstream out;
+  ColumnWriter writer(out, dbc_file);
+  WriteDrive(writer, decoder, 100);
+  ASSERT_TRUE(writer.Finish());
+  const std::string file = out.str();
+  const auto reader = ColumnReader::Open(file);
+  ASSERT_TRUE(reader.has_value());
+  const ColumnChunk chunk = reader->ChunksOf(0).front();
+
+  // The footer entry starts with offset, signal ID and count
+  std::string entry;
+  for (int i = 0; i < 8; ++i) {
+    entry.push_back(static_cast<char>((chunk.offset >> (8 * i)) & 0xFF));
+  }
+  for (const std::uint32_t field : {chunk.signal_id, chunk.count}) {
+    for (int i = 0; i < 4; ++i) {
+      entry.push_back(static_cast<char>((field >> (8 * i)) & 0xFF));
+    }
+  }
+  const std::size_t count_at = file.rfind(entry) + 12;
+  ASSERT_GT(count_at, chunk.offset);
+
+  for (const std::uint32_t count : {8 * chunk.timestamp_bytes + 2, 0xFFFFFFFFu}) {
+    SCOPED_TRACE(count);
+    std::string corrupt = file;
+    for (int i = 0; i < 4; ++i) {
+      corrupt[count_at + i] = static_cast<char>((count >> (8 * i)) & 0xFF);
+    }
+    EXPECT_FALSE(ColumnReader::Open(corrupt).has_value());
+  }
+}
+
+TEST(ColumnFileTest, OpensFile) {
+  const DbcFile dbc_file = MakeFile();
+  const FrameDecoder decoder(dbc_file);
+  const std::string path = ::testing::TempDir() + "column_file_test.dbccols";
+  std::vector<std::vector<Sample>> expected;
+  {
+    std::ofstream out(path, std::ios::binary);
+    ColumnWriter writer(out, dbc_file);
+    expected = WriteDrive(writer, decoder, 3000);
+    ASSERT_TRUE(writer.Finish());
+  }
+
+  auto reader = ColumnReader::OpenFile(path);
+  ASSERT_TRUE(reader.has_value());
+  // Moving the reader keeps the mapping
+  const ColumnReader moved = std::move(*reader);
+  EXPECT_EQ(ScanAll(moved, 2), expected[2]);
+  EXPECT_FALSE(ColumnReader::OpenFile(path + ".missing").has_value());
+  std::remove(path.c_str());
+}
+
+}  // namespace
+}  // namespace storage
+}  // namespace dbc_parser
@@ -0,0 +1,332 @@
+#include "src/dbc_parser/storage/log_index.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace dbc_parser {
+namespace storage {
+namespace {
+
+using decoder::CanFrame;
+using decoder::DecodedFrame;
+using decoder::FrameDecoder;
+using decoder::LogDecodeOptions;
+using parser::DbcFile;
+using parser::Signal;
+using parser::TypeConverter;
+
+constexpr std::uint32_t kExtendedId = 0x18FEF100;
+
+void AddMessage(DbcFile& dbc_file, std::uint32_t dbc_id, const char* name, const char* signal_name) {
+  const int id = static_cast<int>(dbc_id);
+  DbcFile::MessageDef& message = dbc_file.messages_detailed[id];
+  message.id = id;
+  message.name = name;
+  message.size = 8;
+  message.first_signal = static_cast<std::uint32_t>(dbc_file.signal_layouts.size());
+  message.signal_count = 1;
+  Signal signal;
+  signal.name = signal_name;
+  signal.start_bit = 0;
+  signal.length = 8;
+  dbc_file.signal_layouts.push_back(TypeConverter::ToSignalLayout(signal));
+  dbc_file.signal_infos.push_back(TypeConverter::ToSignalInfo(std::move(signal), id));
+}
+
+DbcFile MakeFile() {
+  DbcFile dbc_file;
+  AddMessage(dbc_file, 0x100, "Fast", "FastCounter");
+  AddMessage(dbc_file, 0x200, "Slow", "Counter");
+  AddMessage(dbc_file, 0x300, "Burst", "Counter");
+  AddMessage(dbc_file, kExtendedId | CanFrame::kDbcExtendedIdFlag, "Extended", "ExtendedCounter");
+  return dbc_file;
+}
+
+struct Frame {
+  std::int64_t timestamp_ns;
+  std::uint32_t dbc_id;
+  int counter;
+
+  bool operator<(const Frame& other) const {
+    return std::tie(timestamp_ns, dbc_id, counter) < std::tie(other.timestamp_ns, other.dbc_id, other.counter);
+  }
+  bool operator==(const Frame& other) const {
+    return timestamp_ns == other.timestamp_ns && dbc_id == other.dbc_id && counter == other.counter;
+  }
+};
+
+// 60 s of Fast every 10 ms, Slow every 100 ms, Extended every second, and
+// Burst only from 30.0 to 30.5 s
+std::vector<Frame> MakeSchedule() {
+  std::vector<Frame> frames;
+  for (int i = 0; i < 6000; ++i) {
+    const std::int64_t timestamp_ns = 1'000'000 + i * std::int64_t{10'000'000};
+    frames.push_back({timestamp_ns, 0x100, i & 0xFF});
+    if (i % 10 == 0) {
+      frames.push_back({timestamp_ns + 1000, 0x200, (i / 10) & 0xFF});
+    }
+    if (i % 100 == 50) {
+      frames.push_back({timestamp_ns + 2000, kExtendedId | CanFrame::kDbcExtendedIdFlag, (i / 100) & 0xFF});
+    }
+    if (i >= 3000 && i <= 3050) {
+      frames.push_back({timestamp_ns + 3000, 0x300, i - 3000});
+    }
+  }
+  return frames;
+}
+
+std::string MakeCandump(const std::vector<Frame>& frames) {
+  std::string log;
+  for (const Frame& frame : frames) {
+    char line[64];
+    const bool extended = (frame.dbc_id & CanFrame::kDbcExtendedIdFlag) != 0;
+    std::snprintf(line, sizeof(line), extended ? "(%lld.%06lld) can0 %08X#%02X\n" : "(%lld.%06lld) can0 %03X#%02X\n",
+                  static_cast<long long>(frame.timestamp_ns / 1000000000),
+                  static_cast<long long>(frame.timestamp_ns % 1000000000 / 1000),
+                  frame.dbc_id & ~CanFrame::kDbcExtendedIdFlag, frame.counter);
+    log += line;
+  }
+  return log;
+}
+
+std::string MakeAsc(const std::vector<Frame>& frames, bool relative) {
+  std::string trace = "date Mon Sep 16 10:03:02.123 am 2019\n";
+  trace += relative ? "base hex  timestamps relative\n" : "base hex  timestamps absolute\n";
+  trace += "internal events logged\nBegin Triggerblock Mon Sep 16 10:03:02.123 am 2019\n";
+  std::int64_t previous_ns = 0;
+  for (const Frame& frame : frames) {
+    char line[96];
+    const std::int64_t time_ns = relative ? frame.timestamp_ns - previous_ns : frame.timestamp_ns;
+    previous_ns = frame.timestamp_ns;
+    const bool extended = (frame.dbc_id & CanFrame::kDbcExtendedIdFlag) != 0;
+    std::snprintf(line, sizeof(line), "%4lld.%06lld 1  %X%s             Rx   d 1 %02X\n",
+                  static_cast<long long>(time_ns / 1000000000), static_cast<long long>(time_ns % 1000000000 / 1000),
+                  frame.dbc_id & ~CanFrame::kDbcExtendedIdFlag, extended ? "x" : "", frame.counter);
+    trace += line;
+  }
+  return trace + "End TriggerBlock\n";
+}
+
+void Put(std::string& out, std::uint64_t value, int bytes) {
+  for (int i = 0; i < bytes; ++i) {
+    out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+  }
+}
+
+std::string Object(std::uint32_t type, std::int64_t timestamp_ns, const std::string& body) {
+  std::string object = "LOBJ";
+  Put(object, 32, 2);
+  Put(object, 1, 2);
+  Put(object, 32 + body.size(), 4);
+  Put(object, type, 4);
+  Put(object, 2, 4);
+  Put(object, 0, 4);
+  Put(object, static_cast<std::uint64_t>(timestamp_ns), 8);
+  return object + body;
+}
+
+// CAN_MESSAGE objects in zlib containers of container_bytes, so objects
+// continue from one container into the next
+std::string MakeBlf(const std::vector<Frame>& frames, std::size_t container_bytes) {
+  std::string stream;
+  for (const Frame& frame : frames) {
+    std::string body;
+    Put(body, 1, 2);
+    Put(body, 0, 1);
+    Put(body, 1, 1);
+    const bool extended = (frame.dbc_id & CanFrame::kDbcExtendedIdFlag) != 0;
+    Put(body, (frame.dbc_id & ~CanFrame::kDbcExtendedIdFlag) | (extended ? 0x80000000u : 0), 4);
+    Put(body, static_cast<std::uint64_t>(frame.counter), 1);
+    body.resize(16, '\0');
+    stream += Object(1, frame.timestamp_ns, body);
+  }
+
+  std::string file = "LOGG";
+  Put(file, 144, 4);
+  Put(file, 5, 1);
+  file.resize(32, '\0');
+  Put(file, frames.size(), 4);
+  Put(file, 0, 4);
+  for (const int field : {2019, 9, 1, 16, 10, 3, 2, 123}) {
+    Put(file, static_cast<std::uint64_t>(field), 2);
+  }
+  file.resize(144, '\0');
+  for (std::size_t pos = 0; pos < stream.size(); pos += container_bytes) {
+    const std::string slice = stream.substr(pos, container_bytes);
+    uLongf size = compressBound(static_cast<uLong>(slice.size()));
+    std::string payload(size, '\0');
+    compress2(reinterpret_cast<Bytef*>(payload.data()), &size, reinterpret_cast<const Bytef*>(slice.data()),
+              static_cast<uLong>(slice.size()), Z_DEFAULT_COMPRESSION);
+    payload.resize(size);
+    std::string body;
+    Put(body, 2, 2);
+    body.resize(8, '\0');
+    Put(body, slice.size(), 4);
+    body.resize(16, '\0');
+    const std::string container = Object(10, 0, body + payload);
+    file += container;
+    file.append(container.size() % 4, '\0');
+  }
+  return file;
+}
+
+std::vector<Frame> Expected(const std::vector<Frame>& frames, const LogQuery& query) {
+  std::vector<Frame> expected;
+  for (const Frame& frame : frames) {
+    if (frame.timestamp_ns >= query.from_ns && frame.timestamp_ns <= query.to_ns &&
+        (query.message_ids.empty() ||
+         std::binary_search(query.message_ids.begin(), query.message_ids.end(), frame.dbc_id))) {
+      expected.push_back(frame);
+    }
+  }
+  return expected;
+}
+
+struct QueryResult {
+  std::vector<Frame> frames;
+  std::uint64_t bytes = 0;
+};
+
+QueryResult Query(const LogIndex& index, const FrameDecoder& decoder, const LogQuery& query) {
+  QueryResult result;
+  LogDecodeOptions options;
+  options.threads = 2;
+  options.chunk_bytes = 1024;
+  const auto stats = index.Decode(
+      decoder, query,
+      [&result](const DecodedFrame& decoded) {
+        EXPECT_NE(decoded.message, nullptr);
+        result.frames.push_back({decoded.frame->timestamp_ns, static_cast<std::uint32_t>(decoded.message->message->id),
+                                 static_cast<int>(decoded.values[0])});
+      },
+      options);
+  EXPECT_TRUE(stats.has_value());
+  result.bytes = stats ? stats->bytes : 0;
+  std::sort(result.frames.begin(), result.frames.end());
+  return result;
+}
+
+// Queries an index of log and compares with the schedule
+void ExpectQueries(const std::string& log, LogFormat format, const std::vector<Frame>& frames) {
+  const DbcFile dbc_file = MakeFile();
+  const FrameDecoder decoder(dbc_file);
+  LogIndexOptions options;
+  options.block_bytes = 4096;
+  options.threads = 3;
+  const std::optional<std::string> built = LogIndex::Build(log, format, options);
+  ASSERT_TRUE(built.has_value());
+  const auto index = LogIndex::Open(*built, log);
+  ASSERT_TRUE(index.has_value());
+  EXPECT_EQ(index->format(), format);
+  EXPECT_EQ(index->frame_count(), frames.size());
+  EXPECT_EQ(index->id_count(), 4u);
+  EXPECT_EQ(index->id(0), 0x100u);
+  EXPECT_EQ(index->id(3), kExtendedId | CanFrame::kDbcExtendedIdFlag);
+  EXPECT_EQ(index->bucket_count(), 60u);
+  ASSERT_GT(index->block_count(), 20u);
+
+  // All of it
+  LogQuery query;
+  QueryResult result = Query(*index, decoder, query);
+  EXPECT_EQ(result.frames, Expected(frames, query));
+
+  // The burst, wherever it is
+  query.message_ids = *LogIndex::MessageIdsOf(dbc_file, {"Burst.Counter"});
+  result = Query(*index, decoder, query);
+  ASSERT_EQ(result.frames.size(), 51u);
+  EXPECT_EQ(result.frames, Expected(frames, query));
+  EXPECT_LT(result.bytes, log.size() / 10);
+
+  // Two messages in a time range that starts and ends inside blocks
+  query.message_ids = *LogIndex::MessageIdsOf(dbc_file, {"FastCounter", "ExtendedCounter"});
+  query.from_ns = 12'345'000'000;
+  query.to_ns = 17'500'000'000;
+  result = Query(*index, decoder, query);
+  EXPECT_EQ(result.frames, Expected(frames, query));
+  EXPECT_EQ(result.frames.size(), 515u + 5u);
+  EXPECT_LT(result.bytes, log.size() / 5);
+
+  // Outside the recording
+  query.from_ns = 100'000'000'000;
+  query.to_ns = 200'000'000'000;
+  EXPECT_TRUE(index->SelectBlocks(decoder, query).empty());
+}
+
+TEST(LogIndexTest, QueriesCandumpLogs) {
+  const std::vector<Frame> frames = MakeSchedule();
+  ExpectQueries(MakeCandump(frames), LogFormat::kCandump, frames);
+}
+
+TEST(LogIndexTest, QueriesAscTraces) {
+  const std::vector<Frame> frames = MakeSchedule();
+  ExpectQueries(MakeAsc(frames, false), LogFormat::kAsc, frames);
+  // Blocks start from the sum of the deltas before them
+  ExpectQueries(MakeAsc(frames, true), LogFormat::kAsc, frames);
+}
+
+TEST(LogIndexTest, QueriesBlfFiles) {
+  const std::vector<Frame> frames = MakeSchedule();
+  // 48-byte objects; most containers end inside one
+  ExpectQueries(MakeBlf(frames, 1000), LogFormat::kBlf, frames);
+}
+
+TEST(LogIndexTest, RejectsStaleAndMalformedIndexes) {
+  const std::string log = MakeCandump(MakeSchedule());
+  const std::optional<std::string> built = LogIndex::Build(log, LogFormat::kCandump);
+  ASSERT_TRUE(built.has_value());
+  ASSERT_TRUE(LogIndex::Open(*built, log).has_value());
+
+  EXPECT_FALSE(LogIndex::Open(*built, log.substr(0, log.size() - 1)).has_value());
+  EXPECT_FALSE(LogIndex::Open(built->substr(0, built->size() - 8), log).has_value());
+  EXPECT_FALSE(LogIndex::Open("", log).has_value());
+  std::string bad_magic = *built;
+  bad_magic[0] = 'X';
+  EXPECT_FALSE(LogIndex::Open(bad_magic, log).has_value());
+  EXPECT_FALSE(LogIndex::Build("not a blf file", LogFormat::kBlf).has_value());
+
+  const DbcFile dbc_file = MakeFile();
+  EXPECT_FALSE(LogIndex::MessageIdsOf(dbc_file, {"Counter", "Missing"}).has_value());
+  EXPECT_FALSE(LogIndex::MessageIdsOf(dbc_file, {"Fast.Counter"}).has_value());
+  EXPECT_EQ(LogIndex::MessageIdsOf(dbc_file, {"Counter"}), (std::vector<std::uint32_t>{0x200, 0x300}));
+}
+
+TEST(LogIndexTest, BuildsSidecarFiles) {
+  const std::vector<Frame> frames = MakeSchedule();
+  const std::string log_path = ::testing::TempDir() + "log_index_test.log";
+  {
+    std::ofstream out(log_path, std::ios::binary);
+    out << MakeCandump(frames);
+  }
+  EXPECT_EQ(LogFormatOf(log_path), LogFormat::kCandump);
+  EXPECT_EQ(LogFormatOf("drive.blf"), LogFormat::kBlf);
+  const std::string index_path = LogIndex::SidecarPath(log_path);
+  ASSERT_TRUE(LogIndex::BuildFile(log_path, index_path));
+
+  auto index = LogIndex::OpenFile(index_path, log_path);
+  ASSERT_TRUE(index.has_value());
+  // Moving the index keeps the mappings
+  const LogIndex moved = std::move(*index);
+  const DbcFile dbc_file = MakeFile();
+  const FrameDecoder decoder(dbc_file);
+  LogQuery query;
+  query.message_ids = {0x300};
+  EXPECT_EQ(Query(moved, decoder, query).frames, Expected(frames, query));
+  EXPECT_FALSE(LogIndex::OpenFile(index_path + ".missing", log_path).has_value());
+  std::remove(index_path.c_str());
+  std::remove(log_path.c_str());
+}
+
+}  // namespace
+}  // namespace storage
+}  // namespace dbc_parser
@@ -0,0 +1,213 @@
+#include "tools/dbc_generator.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace dbc_parser {
+namespace tools {
+namespace {
+
+std::vector<std::string> Lines(const std::string& text) {
+  std::vector<std::string> lines;
+  std::istringstream stream(text);
+  for (std::string line; std::getline(stream, line);) {
+    lines.push_back(line);
+  }
+  return lines;
+}
+
+bool StartsWith(std::string_view line, std::string_view prefix) {
+  return line.substr(0, prefix.size()) == prefix;
+}
+
+std::size_t CountPrefix(const std::vector<std::string>& lines, std::string_view prefix) {
+  std::size_t count = 0;
+  for (const std::string& line : lines) {
+    count += StartsWith(line, prefix) ? 1 : 0;
+  }
+  return count;
+}
+
+// IDs of all BO_ lines, as written (bit 31 marks extended frames).
+std::vector<std::uint32_t> MessageIds(const std::vector<std::string>& lines) {
+  std::vector<std::uint32_t> ids;
+  for (const std::string& line : lines) {
+    if (StartsWith(line, "BO_ ")) {
+      ids.push_back(static_cast<std::uint32_t>(std::strtoul(line.c_str() + 4, nullptr, 10)));
+    }
+  }
+  return ids;
+}
+
+GeneratorConfig FullConfig() {
+  GeneratorConfig config;
+  config.seed = 7;
+  config.num_messages = 200;
+  config.can_fd_ratio = 0.3;
+  config.extended_id_ratio = 0.3;
+  config.float_signal_ratio = 0.2;
+  config.multiplexed_message_ratio = 0.3;
+  config.mux_depth = 3;
+  return config;
+}
+
+TEST(DbcGeneratorTest, SameSeedGivesSameText) {
+  const GeneratedDbc first = DbcGenerator::Generate(FullConfig());
+  const GeneratedDbc second = DbcGenerator::Generate(FullConfig());
+  EXPECT_EQ(first.text, second.text);
+
+  GeneratorConfig other = FullConfig();
+  other.seed = 8;
+  EXPECT_NE(first.text, DbcGenerator::Generate(other).text);
+}
+
+TEST(DbcGeneratorTest, CountsMatchText) {
+  const GeneratedDbc dbc = DbcGenerator::Generate(FullConfig());
+  const std::vector<std::string> lines = Lines(dbc.text);
+  const StatementCounts& counts = dbc.counts;
+
+  EXPECT_EQ(counts.version, CountPrefix(lines, "VERSION "));
+  EXPECT_EQ(counts.new_symbols, CountPrefix(lines, "NS_ :"));
+  EXPECT_EQ(counts.bit_timing, CountPrefix(lines, "BS_:"));
+  EXPECT_EQ(counts.nodes, CountPrefix(lines, "BU_:"));
+  EXPECT_EQ(counts.value_tables, CountPrefix(lines, "VAL_TABLE_ "));
+  EXPECT_EQ(counts.messages, CountPrefix(lines, "BO_ "));
+  EXPECT_EQ(counts.signals, CountPrefix(lines, " SG_ "));
+  EXPECT_EQ(counts.message_transmitters, CountPrefix(lines, "BO_TX_BU_ "));
+  EXPECT_EQ(counts.environment_variables, CountPrefix(lines, "EV_ "));
+  EXPECT_EQ(counts.environment_variable_data, CountPrefix(lines, "ENVVAR_DATA_ "));
+  EXPECT_EQ(counts.comments, CountPrefix(lines, "CM_ "));
+  EXPECT_EQ(counts.attribute_definitions, CountPrefix(lines, "BA_DEF_ "));
+  EXPECT_EQ(counts.attribute_defaults, CountPrefix(lines, "BA_DEF_DEF_ "));
+  EXPECT_EQ(counts.attribute_values, CountPrefix(lines, "BA_ "));
+  EXPECT_EQ(counts.value_descriptions, CountPrefix(lines, "VAL_ "));
+  EXPECT_EQ(counts.signal_value_types, CountPrefix(lines, "SIG_VALTYPE_ "));
+  EXPECT_EQ(counts.signal_groups, CountPrefix(lines, "SIG_GROUP_ "));
+  EXPECT_EQ(counts.signal_multiplex_values, CountPrefix(lines, "SG_MUL_VAL_ "));
+}
+
+TEST(DbcGeneratorTest, CoversEveryStatementType) {
+  const StatementCounts counts = DbcGenerator::Generate(FullConfig()).counts;
+  EXPECT_EQ(counts.version, 1u);
+  EXPECT_EQ(counts.new_symbols, 1u);
+  EXPECT_EQ(counts.bit_timing, 1u);
+  EXPECT_EQ(counts.nodes, 1u);
+  EXPECT_EQ(counts.messages, 200u);
+  EXPECT_GT(counts.value_tables, 0u);
+  EXPECT_GT(counts.signals, counts.messages);
+  EXPECT_GT(counts.message_transmitters, 0u);
+  EXPECT_GT(counts.environment_variables, 0u);
+  EXPECT_GT(counts.environment_variable_data, 0u);
+  EXPECT_GT(counts.comments, 0u);
+  EXPECT_GT(counts.attribute_definitions, 0u);
+  EXPECT_GT(counts.attribute_defaults, 0u);
+  EXPECT_GT(counts.attribute_values, 0u);
+  EXPECT_GT(counts.value_descriptions, 0u);
+  EXPECT_GT(counts.signal_value_types, 0u);
+  EXPECT_GT(counts.signal_groups, 0u);
+  EXPECT_GT(counts.signal_multiplex_values, 0u);
+}
+
+TEST(DbcGeneratorTest, MessageIdsAreUniqueAndHonourExtendedRatio) {
+  GeneratorConfig config = FullConfig();
+  config.num_messages = 3000;  // more than the 11-bit ID space holds
+
+  config.extended_id_ratio = 0.0;
+  std::vector<std::uint32_t> ids = MessageIds(Lines(DbcGenerator::Generate(config).text));
+  ASSERT_EQ(ids.size(), 3000u);
+  std::size_t extended = 0;
+  for (std::size_t i = 0; i < ids.size(); ++i) {
+    if ((ids[i] & 0x80000000u) != 0) {
+      ++extended;
+      EXPECT_LE(ids[i] & 0x7FFFFFFFu, 0x1FFFFFFFu);
+    } else {
+      EXPECT_LE(ids[i], 0x7FFu);
+    }
+    for (std::size_t j = 0; j < i; ++j) {
+      ASSERT_NE(ids[i], ids[j]);
+    }
+  }
+  // Standard IDs run out, after which the generator falls back to extended ones.
+  EXPECT_GT(extended, 0u);
+  EXPECT_LT(extended, ids.size());
+
+  config.extended_id_ratio = 1.0;
+  for (std::uint32_t id : MessageIds(Lines(DbcGenerator::Generate(config).text))) {
+    EXPECT_NE(id & 0x80000000u, 0u);
+  }
+}
+
+TEST(DbcGeneratorTest, HonoursByteOrderRatio) {
+  GeneratorConfig config = FullConfig();
+  config.motorola_ratio = 0.0;
+  EXPECT_EQ(DbcGenerator::Generate(config).text.find("@0"), std::string::npos);
+  config.motorola_ratio = 1.0;
+  EXPECT_EQ(DbcGenerator::Generate(config).text.find("@1"), std::string::npos);
+}
+
+TEST(DbcGeneratorTest, MuxDepthControlsExtendedMultiplexing) {
+  GeneratorConfig config = FullConfig();
+  config.mux_depth = 1;
+  GeneratedDbc flat = DbcGenerator::Generate(config);
+  EXPECT_EQ(flat.counts.signal_multiplex_values, 0u);
+  EXPECT_NE(flat.text.find(" M :"), std::string::npos);
+  EXPECT_EQ(flat.text.find(" m0M :"), std::string::npos);
+
+  config.mux_depth = 3;
+  GeneratedDbc nested = DbcGenerator::Generate(config);
+  EXPECT_GT(nested.counts.signal_multiplex_values, 0u);
+  EXPECT_NE(nested.text.find(" m0M :"), std::string::npos);
+}
+
+TEST(DbcGeneratorTest, CommentAndEnumSizesStayWithinBounds) {
+  GeneratorConfig config = FullConfig();
+  config.min_comment_length = 30;
+  config.max_comment_length = 40;
+  config.min_enum_entries = 3;
+  config.max_enum_entries = 5;
+
+  for (const std::string& line : Lines(DbcGenerator::Generate(config).text)) {
+    if (StartsWith(line, "CM_ ")) {
+      const std::size_t open = line.find('"');
+      const std::size_t close = line.rfind('"');
+      ASSERT_NE(open, close) << line;
+      const std::size_t length = close - open - 1;
+      EXPECT_GE(length, 30u) << line;
+      EXPECT_LE(length, 40u) << line;
+    } else if (StartsWith(line, "VAL_ ") || StartsWith(line, "VAL_TABLE_ ")) {
+      std::size_t quotes = 0;
+      for (char c : line) {
+        quotes += c == '"' ? 1 : 0;
+      }
+      EXPECT_GE(quotes / 2, 3u) << line;
+      EXPECT_LE(quotes / 2, 5u) << line;
+    }
+  }
+}
+
+TEST(DbcGeneratorTest, ClampsInvalidKnobs) {
+  GeneratorConfig config;
+  config.num_nodes = 0;
+  config.num_messages = 3;
+  config.min_signals_per_message = 9;
+  config.max_signals_per_message = 2;
+  config.motorola_ratio = 7.0;
+  config.num_comments = -5;
+  config.mux_depth = 0;
+
+  const GeneratedDbc dbc = DbcGenerator::Generate(config);
+  EXPECT_EQ(dbc.counts.messages, 3u);
+  EXPECT_EQ(dbc.counts.comments, 0u);
+  EXPECT_GE(dbc.counts.signals, 6u);
+  EXPECT_EQ(dbc.text.find("@1"), std::string::npos);
+}
+
+}  // namespace
+}  // namespace tools
+}  // namespace dbc_parser
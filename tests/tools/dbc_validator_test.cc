@@ -0,0 +1,178 @@
+#include "tools/dbc_validator.h"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "src/dbc_parser/parser/dbc_file_parser.h"
+
+namespace dbc_parser {
+namespace tools {
+namespace {
+
+using parser::DbcFile;
+using parser::MultiplexType;
+using parser::Signal;
+using parser::TypeConverter;
+
+Signal MakeSignal(std::string name, int start_bit, int length, bool little_endian = true) {
+  Signal signal;
+  signal.name = std::move(name);
+  signal.start_bit = start_bit;
+  signal.length = length;
+  signal.byte_order = little_endian ? 1 : 0;
+  signal.receivers = {"ECU2"};
+  return signal;
+}
+
+Signal Multiplexed(Signal signal, int value) {
+  signal.multiplex_type = MultiplexType::kMultiplexed;
+  signal.multiplex_value = value;
+  return signal;
+}
+
+void AddMessage(DbcFile& dbc_file, int id, int size, std::vector<Signal> signals) {
+  DbcFile::MessageDef& message = dbc_file.messages_detailed[id];
+  message.id = id;
+  message.name = "Message" + std::to_string(id);
+  message.size = size;
+  message.transmitter = "ECU1";
+  message.first_signal = static_cast<std::uint32_t>(dbc_file.signal_layouts.size());
+  message.signal_count = static_cast<std::uint32_t>(signals.size());
+  for (Signal& signal : signals) {
+    dbc_file.signal_layouts.push_back(TypeConverter::ToSignalLayout(signal));
+    dbc_file.signal_infos.push_back(TypeConverter::ToSignalInfo(std::move(signal), id));
+  }
+}
+
+DbcFile MakeFile() {
+  DbcFile dbc_file;
+  dbc_file.nodes = {"ECU1", "ECU2"};
+  return dbc_file;
+}
+
+std::vector<std::string> Messages(const std::vector<ValidationIssue>& issues, Severity severity) {
+  std::vector<std::string> messages;
+  for (const ValidationIssue& issue : issues) {
+    if (issue.severity == severity) {
+      messages.push_back(issue.message);
+    }
+  }
+  return messages;
+}
+
+TEST(DbcValidatorTest, AcceptsConsistentFile) {
+  DbcFile dbc_file = MakeFile();
+  AddMessage(dbc_file, 100, 8, {MakeSignal("Speed", 0, 16), MakeSignal("Gear", 16, 4), MakeSignal("Rpm", 39, 16, false)});
+  EXPECT_TRUE(DbcValidator::Validate(dbc_file).empty());
+}
+
+TEST(DbcValidatorTest, ReportsSignalsOutsideMessage) {
+  DbcFile dbc_file = MakeFile();
+  // Intel bits 60..67 and Motorola 7..14 wrapping into the next byte
+  AddMessage(dbc_file, 100, 8, {MakeSignal("Tail", 60, 8), MakeSignal("Wide", 0, 65)});
+  AddMessage(dbc_file, 200, 1, {MakeSignal("Big", 7, 8, false), MakeSignal("TooBig", 7, 9, false)});
+
+  const auto issues = DbcValidator::Validate(dbc_file);
+  EXPECT_EQ(Messages(issues, Severity::kError),
+            (std::vector<std::string>{"BO_ 100 Message100: SG_ Tail: does not fit in the 8-byte payload",
+                                      "BO_ 100 Message100: SG_ Wide: length 65 is outside 1..64 bits",
+                                      "BO_ 200 Message200: SG_ TooBig: does not fit in the 1-byte payload"}));
+}
+
+TEST(DbcValidatorTest, OverlapIgnoresExclusiveMultiplexedSignals) {
+  DbcFile dbc_file = MakeFile();
+  Signal mux = MakeSignal("Mux", 0, 8);
+  mux.multiplex_type = MultiplexType::kMultiplexor;
+  AddMessage(dbc_file, 100, 8,
+             {mux, Multiplexed(MakeSignal("A", 8, 16), 1), Multiplexed(MakeSignal("B", 8, 16), 2),
+              Multiplexed(MakeSignal("C", 16, 8), 2), MakeSignal("D", 20, 4)});
+
+  const auto errors = Messages(DbcValidator::Validate(dbc_file), Severity::kError);
+  EXPECT_EQ(errors, (std::vector<std::string>{"BO_ 100 Message100: SG_ C: overlaps SG_ B",
+                                              "BO_ 100 Message100: SG_ D: overlaps SG_ A",
+                                              "BO_ 100 Message100: SG_ D: overlaps SG_ B",
+                                              "BO_ 100 Message100: SG_ D: overlaps SG_ C"}));
+}
+
+TEST(DbcValidatorTest, ReportsStructuralErrors) {
+  DbcFile dbc_file = MakeFile();
+  AddMessage(dbc_file, 100, 65, {});
+  AddMessage(dbc_file, 200, 8, {MakeSignal("Same", 0, 8), MakeSignal("Same", 8, 8), Multiplexed(MakeSignal("M", 16, 8), 1)});
+  dbc_file.signal_layouts.back().flags |= parser::SignalLayout::kFloat32;
+
+  const auto errors = Messages(DbcValidator::Validate(dbc_file), Severity::kError);
+  EXPECT_EQ(errors, (std::vector<std::string>{"BO_ 100 Message100: size 65 is outside 0..64 bytes",
+                                              "BO_ 200 Message200: SG_ Same: duplicate signal name",
+                                              "BO_ 200 Message200: SG_ M: SIG_VALTYPE_ does not match length 8",
+                                              "BO_ 200 Message200: multiplexed signals without a multiplexor"}));
+}
+
+TEST(DbcValidatorTest, ChecksPayloadSizeAgainstFrameFormat) {
+  DbcFile dbc_file = MakeFile();
+  AddMessage(dbc_file, 100, 64, {MakeSignal("Tail", 504, 8)});
+  AddMessage(dbc_file, 200, 64, {MakeSignal("Tail", 504, 8)});
+  AddMessage(dbc_file, 300, 10, {});
+  dbc_file.messages_detailed[200].frame_format = parser::FrameFormat::kStandardCanFd;
+  dbc_file.messages_detailed[300].frame_format = parser::FrameFormat::kStandardCanFd;
+
+  const auto issues = DbcValidator::Validate(dbc_file);
+  EXPECT_EQ(Messages(issues, Severity::kError),
+            (std::vector<std::string>{"BO_ 100 Message100: size 64 needs a CAN FD VFrameFormat"}));
+  EXPECT_EQ(Messages(issues, Severity::kWarning),
+            (std::vector<std::string>{"BO_ 300 Message300: size 10 is not a CAN FD payload size"}));
+}
+
+TEST(DbcValidatorTest, WarnsAboutUnknownNodesAndReferences) {
+  DbcFile dbc_file = MakeFile();
+  Signal signal = MakeSignal("Speed", 0, 16);
+  signal.receivers = {"ECU2", "Gateway", "Vector__XXX"};
+  signal.minimum = 10;
+  signal.maximum = 0;
+  AddMessage(dbc_file, 100, 8, {signal});
+  dbc_file.messages_detailed[100].transmitter = "Body";
+
+  DbcFile::ValueDescription description;
+  description.message_id = 100;
+  description.signal_name = "Sped";
+  dbc_file.value_descriptions.push_back(description);
+  DbcFile::CommentDef comment;
+  comment.type = parser::CommentType::MESSAGE;
+  comment.object_id = 300;
+  dbc_file.comments.push_back(comment);
+
+  const auto issues = DbcValidator::Validate(dbc_file);
+  EXPECT_EQ(DbcValidator::Count(issues, Severity::kError), 0u);
+  EXPECT_EQ(Messages(issues, Severity::kWarning),
+            (std::vector<std::string>{"BO_ 100 Message100: transmitter Body is not in BU_",
+                                      "BO_ 100 Message100: SG_ Speed: minimum is greater than maximum",
+                                      "BO_ 100 Message100: SG_ Speed: receiver Gateway is not in BU_",
+                                      "CM_ refers to unknown message 300",
+                                      "VAL_ refers to unknown signal BO_ 100 Sped"}));
+}
+
+// Environment variable VAL_ entries carry message ID -1 and are not signal
+// references
+TEST(DbcValidatorTest, IgnoresEnvironmentVariableValueDescriptions) {
+  const auto dbc_file = parser::DbcFileParser().Parse(R"(VERSION "1.0"
+BU_: ECU1 ECU2
+BO_ 100 Engine: 8 ECU1
+ SG_ Speed : 0|16@1+ (1,0) [0|65535] "" ECU2
+EV_ EngineMode: 0 [0|3] "" 0 1 DUMMY_NODE_VECTOR0 Vector__XXX;
+VAL_ 100 Speed 0 "Stopped" ;
+VAL_ EngineMode 0 "Off" 1 "On" ;
+)");
+  ASSERT_TRUE(dbc_file.has_value());
+  ASSERT_EQ(dbc_file->value_descriptions.size(), 2u);
+
+  const auto issues = DbcValidator::Validate(*dbc_file);
+  EXPECT_EQ(Messages(issues, Severity::kWarning), std::vector<std::string>());
+  EXPECT_EQ(DbcValidator::Count(issues, Severity::kError), 0u);
+}
+
+}  // namespace
+}  // namespace tools
+}  // namespace dbc_parser
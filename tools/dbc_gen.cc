@@ -0,0 +1,153 @@
+// Writes a synthetic DBC file to stdout or --output and a statement summary
+// to stderr. Every GeneratorConfig knob is available as --<name>=<value>;
+// --preset=vendor starts from DbcGenerator::VendorScaleConfig().
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "tools/dbc_generator.h"
+
+namespace {
+
+using dbc_parser::tools::DbcGenerator;
+using dbc_parser::tools::GeneratedDbc;
+using dbc_parser::tools::GeneratorConfig;
+using dbc_parser::tools::StatementCounts;
+
+struct IntFlag {
+  const char* name;
+  int GeneratorConfig::*field;
+};
+
+struct RatioFlag {
+  const char* name;
+  double GeneratorConfig::*field;
+};
+
+constexpr IntFlag kIntFlags[] = {
+    {"nodes", &GeneratorConfig::num_nodes},
+    {"messages", &GeneratorConfig::num_messages},
+    {"min_signals", &GeneratorConfig::min_signals_per_message},
+    {"max_signals", &GeneratorConfig::max_signals_per_message},
+    {"mux_depth", &GeneratorConfig::mux_depth},
+    {"mux_values", &GeneratorConfig::mux_values},
+    {"value_tables", &GeneratorConfig::num_value_tables},
+    {"min_enum_entries", &GeneratorConfig::min_enum_entries},
+    {"max_enum_entries", &GeneratorConfig::max_enum_entries},
+    {"comments", &GeneratorConfig::num_comments},
+    {"min_comment_length", &GeneratorConfig::min_comment_length},
+    {"max_comment_length", &GeneratorConfig::max_comment_length},
+    {"attribute_values", &GeneratorConfig::num_attribute_values},
+    {"signal_groups", &GeneratorConfig::num_signal_groups},
+    {"env_vars", &GeneratorConfig::num_env_vars},
+};
+
+constexpr RatioFlag kRatioFlags[] = {
+    {"can_fd_ratio", &GeneratorConfig::can_fd_ratio},
+    {"extended_id_ratio", &GeneratorConfig::extended_id_ratio},
+    {"motorola_ratio", &GeneratorConfig::motorola_ratio},
+    {"float_signal_ratio", &GeneratorConfig::float_signal_ratio},
+    {"multiplexed_message_ratio", &GeneratorConfig::multiplexed_message_ratio},
+    {"value_description_ratio", &GeneratorConfig::value_description_ratio},
+    {"transmitter_list_ratio", &GeneratorConfig::transmitter_list_ratio},
+};
+
+void PrintUsage() {
+  std::cerr << "Usage: dbc_gen [--preset=default|vendor] [--seed=N] [--output=FILE]";
+  for (const IntFlag& flag : kIntFlags) {
+    std::cerr << " [--" << flag.name << "=N]";
+  }
+  for (const RatioFlag& flag : kRatioFlags) {
+    std::cerr << " [--" << flag.name << "=R]";
+  }
+  std::cerr << "\n";
+}
+
+// Applies one --name=value argument. Returns false if it is not recognized.
+bool ApplyFlag(std::string_view name, const std::string& value, GeneratorConfig& config) {
+  if (name == "seed") {
+    config.seed = std::strtoull(value.c_str(), nullptr, 10);
+    return true;
+  }
+  for (const IntFlag& flag : kIntFlags) {
+    if (name == flag.name) {
+      config.*flag.field = std::atoi(value.c_str());
+      return true;
+    }
+  }
+  for (const RatioFlag& flag : kRatioFlags) {
+    if (name == flag.name) {
+      config.*flag.field = std::atof(value.c_str());
+      return true;
+    }
+  }
+  return false;
+}
+
+void PrintSummary(const GeneratedDbc& dbc) {
+  const StatementCounts& c = dbc.counts;
+  std::fprintf(stderr,
+               "bytes=%zu statements=%zu messages=%zu signals=%zu comments=%zu "
+               "attribute_values=%zu value_descriptions=%zu value_tables=%zu "
+               "signal_groups=%zu signal_value_types=%zu sg_mul_val=%zu "
+               "transmitters=%zu env_vars=%zu\n",
+               dbc.text.size(), c.Total(), c.messages, c.signals, c.comments, c.attribute_values,
+               c.value_descriptions, c.value_tables, c.signal_groups, c.signal_value_types,
+               c.signal_multiplex_values, c.message_transmitters, c.environment_variables);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  GeneratorConfig config;
+  std::string output;
+
+  // The preset is applied first so that other flags can refine it.
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--preset=vendor") == 0) {
+      config = DbcGenerator::VendorScaleConfig();
+    }
+  }
+
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg = argv[i];
+    const std::size_t equals = arg.find('=');
+    if (arg.substr(0, 2) != "--" || equals == std::string_view::npos) {
+      PrintUsage();
+      return 2;
+    }
+    const std::string_view name = arg.substr(2, equals - 2);
+    const std::string value(arg.substr(equals + 1));
+    if (name == "preset") {
+      if (value != "default" && value != "vendor") {
+        PrintUsage();
+        return 2;
+      }
+    } else if (name == "output") {
+      output = value;
+    } else if (!ApplyFlag(name, value, config)) {
+      PrintUsage();
+      return 2;
+    }
+  }
+
+  const GeneratedDbc dbc = DbcGenerator::Generate(config);
+  if (output.empty()) {
+    std::cout.write(dbc.text.data(), static_cast<std::streamsize>(dbc.text.size()));
+  } else {
+    std::ofstream file(output, std::ios::binary);
+    file.write(dbc.text.data(), static_cast<std::streamsize>(dbc.text.size()));
+    if (!file) {
+      std::cerr << "Cannot write " << output << "\n";
+      return 1;
+    }
+  }
+  PrintSummary(dbc);
+  return 0;
+}
@@ -0,0 +1,664 @@
+#include "tools/dbc_generator.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+namespace dbc_parser {
+namespace tools {
+namespace {
+
+// SplitMix64 (Steele, Lea, Flood 2014). Fully specified, unlike the std
+// distributions, so the output does not depend on the standard library.
+class SplitMix64 {
+ public:
+  explicit SplitMix64(std::uint64_t seed) noexcept : state_(seed) {}
+
+  std::uint64_t Next() noexcept {
+    std::uint64_t z = (state_ += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+  }
+
+  // Uniform integer in [lo, hi]; the modulo bias is irrelevant at these ranges.
+  int Range(int lo, int hi) noexcept {
+    if (hi <= lo) {
+      return lo;
+    }
+    return lo + static_cast<int>(Next() % static_cast<std::uint64_t>(hi - lo + 1));
+  }
+
+  // True with probability p.
+  bool Chance(double p) noexcept {
+    return static_cast<double>(Next() >> 11) * 0x1.0p-53 < p;
+  }
+
+  template<typename T, std::size_t N>
+  const T& Pick(const std::array<T, N>& items) noexcept {
+    return items[Next() % N];
+  }
+
+ private:
+  std::uint64_t state_;
+};
+
+constexpr std::array<const char*, 12> kSubsystems = {
+    "Engine", "Brake", "Steering", "Battery", "Door", "Climate",
+    "Gear", "Wheel", "Seat", "Light", "Airbag", "Charger"};
+constexpr std::array<const char*, 16> kQuantities = {
+    "Speed", "Temp", "Pressure", "Status", "Torque", "Voltage", "Current", "Position",
+    "Request", "Counter", "Checksum", "Angle", "Level", "Mode", "Fault", "Power"};
+constexpr std::array<const char*, 8> kSelectors = {
+    "Mode", "Page", "Service", "SubFunction", "Channel", "Index", "Group", "Frame"};
+constexpr std::array<const char*, 12> kUnits = {
+    "", "", "", "rpm", "degC", "kPa", "%", "Nm", "V", "A", "km/h", "m/s2"};
+constexpr std::array<const char*, 16> kEnumLabels = {
+    "Off", "On", "Error", "Init", "Standby", "Not available", "Reserved", "Active",
+    "Inactive", "Fault", "Low", "High", "Open", "Closed", "Left", "Right"};
+constexpr std::array<const char*, 24> kCommentWords = {
+    "signal", "value", "is", "sent", "by", "the", "control", "unit", "when", "request",
+    "active", "filtered", "over", "a", "window", "of", "10", "ms", "and", "clamped",
+    "to", "physical", "range", "invalid"};
+constexpr std::array<double, 8> kFactors = {1, 1, 0.1, 0.01, 0.5, 0.25, 0.001, 0.0625};
+constexpr std::array<double, 6> kOffsets = {0, 0, 0, -40, -1000, -273.15};
+
+constexpr const char* kNewSymbols[] = {
+    "NS_DESC_", "CM_", "BA_DEF_", "BA_", "VAL_", "CAT_DEF_", "CAT_", "FILTER",
+    "BA_DEF_DEF_", "EV_DATA_", "ENVVAR_DATA_", "SGTYPE_", "SGTYPE_VAL_", "BA_DEF_SGTYPE_",
+    "BA_SGTYPE_", "SIG_TYPE_REF_", "VAL_TABLE_", "SIG_GROUP_", "SIG_VALTYPE_",
+    "SIGTYPE_VALTYPE_", "BO_TX_BU_", "BA_DEF_REL_", "BA_REL_", "BA_DEF_DEF_REL_",
+    "BU_SG_REL_", "BU_EV_REL_", "BU_BO_REL_", "SG_MUL_VAL_"};
+
+// Attribute definitions written to every file, with their defaults.
+struct AttributeSpec {
+  const char* definition;
+  const char* default_value;
+};
+constexpr std::array<AttributeSpec, 8> kAttributes = {{
+    {"BA_DEF_ \"BusType\" STRING ;", "BA_DEF_DEF_ \"BusType\" \"CAN\";"},
+    {"BA_DEF_ BU_ \"NodeLayerModules\" STRING ;",
+     "BA_DEF_DEF_ \"NodeLayerModules\" \"CANoeILNLVector.dll\";"},
+    {"BA_DEF_ BO_ \"GenMsgCycleTime\" INT 0 65535;", "BA_DEF_DEF_ \"GenMsgCycleTime\" 0;"},
+    {"BA_DEF_ BO_ \"GenMsgSendType\" ENUM \"Cyclic\",\"Event\",\"CyclicIfActive\","
+     "\"NoMsgSendType\";",
+     "BA_DEF_DEF_ \"GenMsgSendType\" \"Cyclic\";"},
+    {"BA_DEF_ BO_ \"VFrameFormat\" ENUM \"StandardCAN\",\"ExtendedCAN\",\"StandardCAN_FD\","
+     "\"ExtendedCAN_FD\";",
+     "BA_DEF_DEF_ \"VFrameFormat\" \"StandardCAN\";"},
+    {"BA_DEF_ SG_ \"GenSigStartValue\" FLOAT 0 100000;", "BA_DEF_DEF_ \"GenSigStartValue\" 0;"},
+    {"BA_DEF_ SG_ \"GenSigSendType\" ENUM \"Cyclic\",\"OnChange\",\"OnWrite\","
+     "\"OnWriteWithRepetition\";",
+     "BA_DEF_DEF_ \"GenSigSendType\" \"Cyclic\";"},
+    {"BA_DEF_ EV_ \"GenEnvVarPrefix\" STRING ;", "BA_DEF_DEF_ \"GenEnvVarPrefix\" \"Env\";"},
+}};
+
+constexpr std::uint32_t kExtendedIdFlag = 0x80000000u;
+constexpr std::uint32_t kMaxStandardId = 0x7FF;
+
+// Fixed-point text without exponent or trailing zeros; SG_ ranges reject 1e+06.
+std::string FormatNumber(double value) {
+  char buffer[64];
+  std::snprintf(buffer, sizeof(buffer), "%.6f", value);
+  std::string text(buffer);
+  while (!text.empty() && text.back() == '0') {
+    text.pop_back();
+  }
+  if (!text.empty() && text.back() == '.') {
+    text.pop_back();
+  }
+  return text == "-0" ? "0" : text;
+}
+
+GeneratorConfig Normalize(GeneratorConfig config) {
+  auto count = [](int& value) { value = std::max(value, 0); };
+  auto bounds = [](int& lo, int& hi, int floor) {
+    lo = std::max(lo, floor);
+    hi = std::max(hi, floor);
+    if (lo > hi) {
+      std::swap(lo, hi);
+    }
+  };
+  auto ratio = [](double& value) {
+    value = std::isnan(value) ? 0.0 : std::min(std::max(value, 0.0), 1.0);
+  };
+
+  config.num_nodes = std::max(config.num_nodes, 1);  // every BO_ needs a sender
+  count(config.num_messages);
+  bounds(config.min_signals_per_message, config.max_signals_per_message, 0);
+  ratio(config.can_fd_ratio);
+  ratio(config.extended_id_ratio);
+  ratio(config.motorola_ratio);
+  ratio(config.float_signal_ratio);
+  ratio(config.multiplexed_message_ratio);
+  config.mux_depth = std::min(std::max(config.mux_depth, 1), 8);
+  config.mux_values = std::min(std::max(config.mux_values, 1), 256);
+  count(config.num_value_tables);
+  ratio(config.value_description_ratio);
+  bounds(config.min_enum_entries, config.max_enum_entries, 1);
+  count(config.num_comments);
+  bounds(config.min_comment_length, config.max_comment_length, 1);
+  count(config.num_attribute_values);
+  ratio(config.transmitter_list_ratio);
+  count(config.num_signal_groups);
+  count(config.num_env_vars);
+  return config;
+}
+
+class Generator {
+ public:
+  explicit Generator(const GeneratorConfig& config)
+      : config_(Normalize(config)), rng_(config_.seed) {}
+
+  GeneratedDbc Run() {
+    WriteHeader();
+    WriteValueTables();
+    messages_.reserve(static_cast<std::size_t>(config_.num_messages));
+    for (int m = 0; m < config_.num_messages; ++m) {
+      WriteMessage(m);
+    }
+    WriteTransmitters();
+    WriteEnvironmentVariables();
+    WriteComments();
+    WriteAttributes();
+    WriteValueDescriptions();
+    WriteSignalValueTypes();
+    WriteSignalGroups();
+    WriteSignalMultiplexValues();
+    return std::move(out_);
+  }
+
+ private:
+  struct SignalRef {
+    std::string name;
+    int value_type = 0;  ///< SIG_VALTYPE_ code: 0 integer, 1 float, 2 double
+  };
+
+  struct MessageRef {
+    std::uint32_t id = 0;  ///< As written in the file, bit 31 marks extended IDs
+    bool can_fd = false;
+    std::vector<SignalRef> signals;
+  };
+
+  void Line(const std::string& line, std::size_t& counter) {
+    out_.text += line;
+    out_.text += '\n';
+    ++counter;
+  }
+
+  void Blank() { out_.text += '\n'; }
+
+  std::string Node(int index) const {
+    return std::string(kSubsystems[static_cast<std::size_t>(index) % kSubsystems.size()]) + "Ecu" +
+           std::to_string(index);
+  }
+
+  std::string RandomNode() { return Node(rng_.Range(0, config_.num_nodes - 1)); }
+
+  std::string Receivers() {
+    if (rng_.Chance(0.1)) {
+      return "Vector__XXX";
+    }
+    std::string receivers = RandomNode();
+    for (int r = rng_.Range(0, 2); r > 0; --r) {
+      receivers += "," + RandomNode();
+    }
+    return receivers;
+  }
+
+  std::string SignalName() {
+    std::string name = rng_.Pick(kSubsystems);
+    name += rng_.Pick(kQuantities);
+    return name + "_" + std::to_string(next_signal_++);
+  }
+
+  std::string CommentText() {
+    const std::size_t length = static_cast<std::size_t>(
+        rng_.Range(config_.min_comment_length, config_.max_comment_length));
+    std::string text;
+    while (text.size() < length) {
+      if (!text.empty()) {
+        text += ' ';
+      }
+      text += rng_.Pick(kCommentWords);
+    }
+    text.resize(length);
+    if (text.back() == ' ') {
+      text.back() = '.';
+    }
+    return text;
+  }
+
+  // Value/label pairs in descending order, as CANdb++ writes them.
+  std::string EnumPairs() {
+    const int entries = rng_.Range(config_.min_enum_entries, config_.max_enum_entries);
+    const std::size_t first = rng_.Next() % kEnumLabels.size();
+    std::string text;
+    for (int v = entries - 1; v >= 0; --v) {
+      text += " " + std::to_string(v) + " \"" +
+              kEnumLabels[(first + static_cast<std::size_t>(v)) % kEnumLabels.size()] + "\"";
+    }
+    return text;
+  }
+
+  std::string MessageIdText(std::size_t index) const {
+    return std::to_string(messages_[index].id);
+  }
+
+  // Standard IDs are handed out in increasing order until the 11-bit space is
+  // used up; later messages fall back to extended IDs, which never collide.
+  std::uint32_t NextMessageId() {
+    if (!rng_.Chance(config_.extended_id_ratio) && next_standard_id_ <= kMaxStandardId) {
+      const std::uint32_t id = next_standard_id_;
+      next_standard_id_ += static_cast<std::uint32_t>(rng_.Range(1, 3));
+      return id;
+    }
+    // J1939-style: priority 6, a fresh PDU number and a random source address.
+    const std::uint32_t id = (6u << 26) | ((next_extended_pdu_++ & 0x3FFFFu) << 8) |
+                             static_cast<std::uint32_t>(rng_.Range(0, 0xFD));
+    return kExtendedIdFlag | id;
+  }
+
+  void WriteHeader() {
+    const int major = rng_.Range(1, 9);
+    const int minor = rng_.Range(0, 9);
+    Line("VERSION \"" + std::to_string(major) + "." + std::to_string(minor) + "\"",
+         out_.counts.version);
+    Blank();
+    Blank();
+    out_.text += "NS_ :\n";
+    for (const char* symbol : kNewSymbols) {
+      out_.text += '\t';
+      out_.text += symbol;
+      out_.text += '\n';
+    }
+    ++out_.counts.new_symbols;
+    Blank();
+    Line("BS_: 500 " + std::to_string(rng_.Range(1, 99)) + ".5", out_.counts.bit_timing);
+    Blank();
+    std::string nodes = "BU_:";
+    for (int n = 0; n < config_.num_nodes; ++n) {
+      nodes += " " + Node(n);
+    }
+    Line(nodes, out_.counts.nodes);
+    Blank();
+  }
+
+  void WriteValueTables() {
+    for (int t = 0; t < config_.num_value_tables; ++t) {
+      const std::string name = "VT_" + std::string(rng_.Pick(kQuantities)) + "_" + std::to_string(t);
+      Line("VAL_TABLE_ " + name + EnumPairs() + " ;", out_.counts.value_tables);
+    }
+    if (config_.num_value_tables > 0) {
+      Blank();
+    }
+  }
+
+  // Writes one SG_ line occupying [position, position + length) in the
+  // message's own bit numbering (LSB-first for Intel, MSB-first for Motorola).
+  void WriteSignal(MessageRef& message, bool motorola, int position, int length,
+                   const std::string& name, const std::string& mux, int value_type,
+                   bool is_signed) {
+    const int start_bit = motorola ? (position / 8) * 8 + 7 - position % 8 : position;
+    double factor = rng_.Pick(kFactors);
+    double offset = rng_.Pick(kOffsets);
+    double minimum;
+    double maximum;
+    if (value_type != 0) {
+      factor = 1;
+      offset = 0;
+      minimum = -1000000;
+      maximum = 1000000;
+    } else if (is_signed) {
+      const double half = std::ldexp(1.0, length - 1);
+      minimum = offset - factor * half;
+      maximum = offset + factor * (half - 1);
+    } else {
+      minimum = offset;
+      maximum = offset + factor * (std::ldexp(1.0, length) - 1);
+    }
+
+    const char* unit = rng_.Pick(kUnits);
+    std::string line = " SG_ " + name + " ";
+    if (!mux.empty()) {
+      line += mux + " ";
+    }
+    line += ": " + std::to_string(start_bit) + "|" + std::to_string(length) +
+            (motorola ? "@0" : "@1") + (is_signed ? "-" : "+") + " (" + FormatNumber(factor) +
+            "," + FormatNumber(offset) + ") [" + FormatNumber(minimum) + "|" +
+            FormatNumber(maximum) + "] \"" + unit + "\" " + Receivers();
+    Line(line, out_.counts.signals);
+    message.signals.push_back({name, value_type});
+  }
+
+  // Packs signals one after the other into [position, end). Lengths are drawn
+  // so that the remaining signals still fit; some signals become IEEE floats.
+  void WritePackedSignals(MessageRef& message, bool motorola, int position, int end, int count,
+                          const std::string& mux, const std::string& mux_selector) {
+    for (int s = 0; s < count && position < end; ++s) {
+      const int available = end - position;
+      const int share = std::max(1, available / (count - s));
+      int value_type = 0;
+      int length;
+      if (available >= 64 && rng_.Chance(config_.float_signal_ratio / 4)) {
+        value_type = 2;
+        length = 64;
+      } else if (available >= 32 && rng_.Chance(config_.float_signal_ratio)) {
+        value_type = 1;
+        length = 32;
+      } else {
+        length = rng_.Range(1, std::min(share, 32));
+      }
+      const std::string name = SignalName();
+      WriteSignal(message, motorola, position, length, name, mux, value_type,
+                  value_type != 0 || rng_.Chance(0.3));
+      if (!mux_selector.empty()) {
+        pending_mul_vals_.push_back(std::to_string(message.id) + " " + name + " " + mux_selector);
+      }
+      position += length;
+    }
+  }
+
+  void WriteMessage(int index) {
+    MessageRef message;
+    message.id = NextMessageId();
+    message.can_fd = rng_.Chance(config_.can_fd_ratio);
+    const int payload_bits = message.can_fd ? 512 : 64;
+    const bool motorola = rng_.Chance(config_.motorola_ratio);
+    const int count = rng_.Range(config_.min_signals_per_message, config_.max_signals_per_message);
+
+    const std::string name = rng_.Pick(kSubsystems) + std::string("Frame_") + std::to_string(index);
+    Line("BO_ " + std::to_string(message.id) + " " + name + ": " +
+             std::to_string(payload_bits / 8) + " " + RandomNode(),
+         out_.counts.messages);
+
+    if (count >= 2 && rng_.Chance(config_.multiplexed_message_ratio)) {
+      WriteMultiplexedSignals(message, motorola, payload_bits, count);
+    } else {
+      WritePackedSignals(message, motorola, 0, payload_bits, count, "", "");
+    }
+    Blank();
+    messages_.push_back(std::move(message));
+  }
+
+  // The selectors sit at the start of the payload: the root multiplexor (M)
+  // and, for extended multiplexing, one nested selector (m0M) per further
+  // level. Every other signal belongs to one (level, value) group, and the
+  // groups share the rest of the payload.
+  void WriteMultiplexedSignals(MessageRef& message, bool motorola, int payload_bits, int count) {
+    int width = 1;
+    while ((1 << width) < config_.mux_values) {
+      ++width;
+    }
+    const int levels = std::max(1, std::min({config_.mux_depth, count - 1,
+                                             payload_bits / (2 * width)}));
+    const bool extended = levels > 1;
+
+    std::vector<std::string> selectors;
+    for (int level = 0; level < levels; ++level) {
+      const std::string name = std::string(kSelectors[static_cast<std::size_t>(level) %
+                                                      kSelectors.size()]) +
+                               "_" + std::to_string(next_signal_++);
+      WriteSignal(message, motorola, level * width, width, name, level == 0 ? "M" : "m0M", 0,
+                  false);
+      if (level > 0) {
+        pending_mul_vals_.push_back(std::to_string(message.id) + " " + name + " " +
+                                    selectors.back() + " 0-0");
+      }
+      selectors.push_back(name);
+    }
+
+    const int payload_start = levels * width;
+    const int multiplexed = count - levels;
+    const int groups = levels * config_.mux_values;
+    for (int group = 0; group < groups && group < multiplexed; ++group) {
+      const int level = group % levels;
+      const int value = group / levels;
+      const int members = multiplexed / groups + (group < multiplexed % groups ? 1 : 0);
+      const std::string mux = "m" + std::to_string(value);
+      const std::string selector =
+          extended ? selectors[static_cast<std::size_t>(level)] : std::string();
+      WritePackedSignals(message, motorola, payload_start, payload_bits, members, mux,
+                         selector.empty() ? selector
+                                          : selector + " " + std::to_string(value) + "-" +
+                                                std::to_string(value));
+    }
+  }
+
+  void WriteTransmitters() {
+    bool any = false;
+    for (std::size_t m = 0; m < messages_.size(); ++m) {
+      if (rng_.Chance(config_.transmitter_list_ratio)) {
+        const std::string first = RandomNode();
+        const std::string second = RandomNode();
+        Line("BO_TX_BU_ " + MessageIdText(m) + " : " + first + "," + second + ";",
+             out_.counts.message_transmitters);
+        any = true;
+      }
+    }
+    if (any) {
+      Blank();
+    }
+  }
+
+  void WriteEnvironmentVariables() {
+    for (int e = 0; e < config_.num_env_vars; ++e) {
+      const std::string name = "Env" + std::string(rng_.Pick(kQuantities)) + "_" + std::to_string(e);
+      const int maximum = rng_.Range(1, 10000);
+      const char* unit = rng_.Pick(kUnits);
+      Line("EV_ " + name + " " + std::to_string(e % 2) + " [0|" + std::to_string(maximum) + "] \"" +
+               unit + "\" 0 " + std::to_string(e + 1) + " DUMMY_NODE_VECTOR0 " + RandomNode() +
+               ";",
+           out_.counts.environment_variables);
+      env_vars_.push_back(name);
+    }
+    for (int e = 0; e < config_.num_env_vars; e += 2) {
+      Line("ENVVAR_DATA_ " + env_vars_[static_cast<std::size_t>(e)] + ": " +
+               std::to_string(rng_.Range(1, 8)) + ";",
+           out_.counts.environment_variable_data);
+    }
+    if (config_.num_env_vars > 0) {
+      Blank();
+    }
+  }
+
+  // Picks a random message, optionally one that has at least one signal.
+  const MessageRef* RandomMessage(bool with_signals) {
+    if (messages_.empty()) {
+      return nullptr;
+    }
+    for (int attempt = 0; attempt < 8; ++attempt) {
+      const MessageRef& message = messages_[rng_.Next() % messages_.size()];
+      if (!with_signals || !message.signals.empty()) {
+        return &message;
+      }
+    }
+    return nullptr;
+  }
+
+  const SignalRef& RandomSignal(const MessageRef& message) {
+    return message.signals[rng_.Next() % message.signals.size()];
+  }
+
+  void WriteComments() {
+    for (int c = 0; c < config_.num_comments; ++c) {
+      const int kind = c == 0 ? -1 : rng_.Range(0, 99);
+      const MessageRef* message = RandomMessage(kind >= 45);
+      std::string object;
+      if (kind < 0 || (kind >= 8 && message == nullptr)) {
+        object = "";
+      } else if (kind < 5 || (kind < 8 && env_vars_.empty())) {
+        object = "BU_ " + RandomNode() + " ";
+      } else if (kind < 8) {
+        object = "EV_ " + env_vars_[rng_.Next() % env_vars_.size()] + " ";
+      } else if (kind < 45) {
+        object = "BO_ " + std::to_string(message->id) + " ";
+      } else {
+        object = "SG_ " + std::to_string(message->id) + " " + RandomSignal(*message).name + " ";
+      }
+      Line("CM_ " + object + "\"" + CommentText() + "\";", out_.counts.comments);
+    }
+    if (config_.num_comments > 0) {
+      Blank();
+    }
+  }
+
+  std::string AttributeValueLine() {
+    const int kind = rng_.Range(0, 99);
+    const MessageRef* message = RandomMessage(kind >= 55 && kind < 95);
+    if (kind >= 95 || message == nullptr) {
+      if (kind >= 98 && !env_vars_.empty()) {
+        return "BA_ \"GenEnvVarPrefix\" EV_ \"" + env_vars_[rng_.Next() % env_vars_.size()] +
+               "\" \"Env\";";
+      }
+      return "BA_ \"NodeLayerModules\" BU_ \"" + RandomNode() + "\" \"CANoeILNLVector.dll\";";
+    }
+    const std::string id = std::to_string(message->id);
+    if (kind < 35) {
+      return "BA_ \"GenMsgCycleTime\" BO_ " + id + " " + std::to_string(10 * rng_.Range(1, 100)) +
+             ";";
+    }
+    if (kind < 45) {
+      return "BA_ \"GenMsgSendType\" BO_ " + id + " " + std::to_string(rng_.Range(0, 3)) + ";";
+    }
+    if (kind < 55) {
+      const int format = ((message->id & kExtendedIdFlag) != 0 ? 1 : 0) + (message->can_fd ? 2 : 0);
+      return "BA_ \"VFrameFormat\" BO_ " + id + " " + std::to_string(format) + ";";
+    }
+    const std::string& signal = RandomSignal(*message).name;
+    if (kind < 85) {
+      return "BA_ \"GenSigStartValue\" SG_ " + id + " \"" + signal + "\" " +
+             std::to_string(rng_.Range(0, 1000)) + ".5;";
+    }
+    return "BA_ \"GenSigSendType\" SG_ " + id + " \"" + signal + "\" " +
+           std::to_string(rng_.Range(0, 3)) + ";";
+  }
+
+  void WriteAttributes() {
+    for (const AttributeSpec& attribute : kAttributes) {
+      Line(attribute.definition, out_.counts.attribute_definitions);
+    }
+    for (const AttributeSpec& attribute : kAttributes) {
+      Line(attribute.default_value, out_.counts.attribute_defaults);
+    }
+    for (int a = 0; a < config_.num_attribute_values; ++a) {
+      Line(AttributeValueLine(), out_.counts.attribute_values);
+    }
+    // A 64-byte payload is only valid on CAN FD, so those messages always
+    // say so
+    for (const MessageRef& message : messages_) {
+      if (message.can_fd) {
+        const int format = (message.id & kExtendedIdFlag) != 0 ? 3 : 2;
+        Line("BA_ \"VFrameFormat\" BO_ " + std::to_string(message.id) + " " + std::to_string(format) + ";",
+             out_.counts.attribute_values);
+      }
+    }
+  }
+
+  void WriteValueDescriptions() {
+    for (const MessageRef& message : messages_) {
+      for (const SignalRef& signal : message.signals) {
+        if (signal.value_type == 0 && rng_.Chance(config_.value_description_ratio)) {
+          Line("VAL_ " + std::to_string(message.id) + " " + signal.name + EnumPairs() + " ;",
+               out_.counts.value_descriptions);
+        }
+      }
+    }
+    for (std::size_t e = 0; e < env_vars_.size(); e += 2) {
+      Line("VAL_ " + env_vars_[e] + EnumPairs() + " ;", out_.counts.value_descriptions);
+    }
+  }
+
+  void WriteSignalValueTypes() {
+    for (const MessageRef& message : messages_) {
+      for (const SignalRef& signal : message.signals) {
+        if (signal.value_type != 0) {
+          Line("SIG_VALTYPE_ " + std::to_string(message.id) + " " + signal.name + " " +
+                   std::to_string(signal.value_type) + ";",
+               out_.counts.signal_value_types);
+        }
+      }
+    }
+  }
+
+  void WriteSignalGroups() {
+    for (int g = 0; g < config_.num_signal_groups; ++g) {
+      const MessageRef* message = RandomMessage(true);
+      if (message == nullptr) {
+        break;
+      }
+      const std::size_t members = std::min<std::size_t>(message->signals.size(),
+                                                        static_cast<std::size_t>(rng_.Range(1, 6)));
+      const std::size_t first = rng_.Next() % message->signals.size();
+      std::string line = "SIG_GROUP_ " + std::to_string(message->id) + " Group_" +
+                         std::to_string(g) + " 1 : ";
+      for (std::size_t s = 0; s < members; ++s) {
+        if (s > 0) {
+          line += ",";
+        }
+        line += message->signals[(first + s) % message->signals.size()].name;
+      }
+      Line(line + ";", out_.counts.signal_groups);
+    }
+  }
+
+  void WriteSignalMultiplexValues() {
+    for (const std::string& entry : pending_mul_vals_) {
+      Line("SG_MUL_VAL_ " + entry + ";", out_.counts.signal_multiplex_values);
+    }
+  }
+
+  const GeneratorConfig config_;
+  SplitMix64 rng_;
+  GeneratedDbc out_;
+  std::vector<MessageRef> messages_;
+  std::vector<std::string> env_vars_;
+  std::vector<std::string> pending_mul_vals_;  ///< SG_MUL_VAL_ bodies, written after the BO_ blocks
+  std::uint32_t next_standard_id_ = 1;
+  std::uint32_t next_extended_pdu_ = 0;
+  int next_signal_ = 0;
+};
+
+}  // namespace
+
+std::size_t StatementCounts::Total() const noexcept {
+  return version + new_symbols + bit_timing + nodes + value_tables + messages + signals +
+         message_transmitters + environment_variables + environment_variable_data + comments +
+         attribute_definitions + attribute_defaults + attribute_values + value_descriptions +
+         signal_value_types + signal_groups + signal_multiplex_values;
+}
+
+GeneratedDbc DbcGenerator::Generate(const GeneratorConfig& config) {
+  return Generator(config).Run();
+}
+
+GeneratorConfig DbcGenerator::VendorScaleConfig(std::uint64_t seed) {
+  GeneratorConfig config;
+  config.seed = seed;
+  config.num_nodes = 120;
+  config.num_messages = 10000;
+  config.min_signals_per_message = 5;
+  config.max_signals_per_message = 45;
+  config.can_fd_ratio = 0.5;
+  config.extended_id_ratio = 0.3;
+  config.motorola_ratio = 0.3;
+  config.float_signal_ratio = 0.02;
+  config.multiplexed_message_ratio = 0.25;
+  config.mux_depth = 3;
+  config.mux_values = 8;
+  config.num_value_tables = 200;
+  config.value_description_ratio = 0.15;
+  config.max_enum_entries = 32;
+  config.num_comments = 50000;
+  config.max_comment_length = 400;
+  config.num_attribute_values = 100000;
+  config.num_signal_groups = 2000;
+  config.num_env_vars = 200;
+  return config;
+}
+
+}  // namespace tools
+}  // namespace dbc_parser
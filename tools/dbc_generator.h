@@ -0,0 +1,127 @@
+#ifndef DBC_PARSER_TOOLS_DBC_GENERATOR_H_
+#define DBC_PARSER_TOOLS_DBC_GENERATOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace dbc_parser {
+namespace tools {
+
+/**
+ * @brief Knobs for the synthetic DBC generator.
+ *
+ * Ratios are probabilities in [0, 1] applied per message or per signal. The
+ * defaults give a small file that exercises every statement type.
+ */
+struct GeneratorConfig {
+  std::uint64_t seed = 1;              ///< Same seed and knobs give byte-identical output
+
+  int num_nodes = 8;                   ///< Nodes on BU_
+  int num_messages = 50;               ///< BO_ blocks
+  int min_signals_per_message = 2;     ///< SG_ lines per BO_ block (lower bound)
+  int max_signals_per_message = 12;    ///< SG_ lines per BO_ block (upper bound)
+  double can_fd_ratio = 0.0;           ///< CAN FD messages (VFrameFormat) with a 64-byte payload instead of 8
+  double extended_id_ratio = 0.1;      ///< Messages with a 29-bit ID (bit 31 set in the file)
+  double motorola_ratio = 0.25;        ///< Messages whose signals are big-endian (@0)
+  double float_signal_ratio = 0.05;    ///< Signals declared IEEE float via SIG_VALTYPE_
+
+  double multiplexed_message_ratio = 0.1;  ///< Messages with a multiplexor
+  int mux_depth = 1;                   ///< 1 = M/mX only; >1 adds nested mXM levels and SG_MUL_VAL_
+  int mux_values = 4;                  ///< Selector values used per multiplexor
+
+  int num_value_tables = 5;            ///< VAL_TABLE_ statements
+  double value_description_ratio = 0.2;  ///< Signals with a VAL_ statement
+  int min_enum_entries = 2;            ///< Entries per VAL_/VAL_TABLE_ (lower bound)
+  int max_enum_entries = 8;            ///< Entries per VAL_/VAL_TABLE_ (upper bound)
+
+  int num_comments = 40;               ///< CM_ statements
+  int min_comment_length = 10;         ///< Characters of comment text (lower bound)
+  int max_comment_length = 120;        ///< Characters of comment text (upper bound)
+
+  int num_attribute_values = 60;       ///< BA_ statements
+  double transmitter_list_ratio = 0.1;  ///< Messages with a BO_TX_BU_ statement
+  int num_signal_groups = 5;           ///< SIG_GROUP_ statements
+  int num_env_vars = 4;                ///< EV_ statements (every other one gets ENVVAR_DATA_)
+};
+
+/**
+ * @brief Number of statements of each type in a generated file.
+ */
+struct StatementCounts {
+  std::size_t version = 0;
+  std::size_t new_symbols = 0;
+  std::size_t bit_timing = 0;
+  std::size_t nodes = 0;
+  std::size_t value_tables = 0;
+  std::size_t messages = 0;
+  std::size_t signals = 0;
+  std::size_t message_transmitters = 0;
+  std::size_t environment_variables = 0;
+  std::size_t environment_variable_data = 0;
+  std::size_t comments = 0;
+  std::size_t attribute_definitions = 0;
+  std::size_t attribute_defaults = 0;
+  std::size_t attribute_values = 0;
+  std::size_t value_descriptions = 0;
+  std::size_t signal_value_types = 0;
+  std::size_t signal_groups = 0;
+  std::size_t signal_multiplex_values = 0;  ///< SG_MUL_VAL_ statements
+
+  /**
+   * @brief Sum of all counts, i.e. the number of statements in the file.
+   */
+  [[nodiscard]] std::size_t Total() const noexcept;
+};
+
+/**
+ * @brief A generated DBC file plus what it contains.
+ */
+struct GeneratedDbc {
+  std::string text;          ///< DBC file contents
+  StatementCounts counts;    ///< Statements written to text
+};
+
+/**
+ * @brief Deterministic, seed-driven generator of synthetic DBC files.
+ *
+ * The output is valid DBC text covering every statement type the DbcFileParser
+ * grammar recognizes, laid out in the usual order of vendor files. Signals of
+ * a message never overlap (except across multiplexor values), IDs are unique,
+ * and every satellite statement refers to an object that exists.
+ *
+ * The random stream is a SplitMix64 generator rather than a standard
+ * distribution, so a seed produces the same file on every platform.
+ */
+class DbcGenerator {
+ public:
+  DbcGenerator() = delete;
+
+  /**
+   * @brief Generates a DBC file.
+   *
+   * Out-of-range knobs are clamped: counts below zero become zero, inverted
+   * bounds are swapped and ratios are limited to [0, 1].
+   *
+   * @param config Generator knobs
+   * @return GeneratedDbc The file text and its statement counts
+   */
+  [[nodiscard]] static GeneratedDbc Generate(const GeneratorConfig& config);
+
+  /**
+   * @brief Knobs for a production-sized database.
+   *
+   * Roughly 10,000 messages with 250,000 signals, 50,000 comments and
+   * 100,000 attribute values, half of the frames CAN FD and heavy use of
+   * (extended) multiplexing.
+   *
+   * @param seed Random seed
+   * @return GeneratorConfig The knobs
+   */
+  [[nodiscard]] static GeneratorConfig VendorScaleConfig(std::uint64_t seed = 1);
+};
+
+}  // namespace tools
+}  // namespace dbc_parser
+
+#endif  // DBC_PARSER_TOOLS_DBC_GENERATOR_H_
@@ -0,0 +1,649 @@
+// Measures and checks DBC files and decodes CAN logs with them:
+//
+//   dbc_tool stats <file.dbc>
+//   dbc_tool validate [--warnings_as_errors] <file.dbc>
+//   dbc_tool bench [--iterations=N] [--warmup=N] <file.dbc>
+//   dbc_tool decode [--threads=N] [--chunk_bytes=N] [--print] [--from_s=S] [--j1939]
+//                  [--columns=PATH] [--stats] [--windows=PATH] [--rules=PATH] <file.dbc> <log>
+//   dbc_tool index [--bucket_s=S] [--block_bytes=N] [--threads=N] <log>
+//   dbc_tool query [--signals=A,B] [--from_s=S] [--to_s=S] [--threads=N] [--print]
+//                  <file.dbc> <log>
+//
+// decode memory-maps the log and decodes it with LogDecoder for candump logs,
+// AscReader for .asc and BlfReader for .blf files; --print writes every frame
+// with its signals in timestamp order before the summary, and --from_s starts
+// a .blf file at that many seconds into the measurement. --j1939 looks up
+// every extended message by PGN and reassembles transport protocol
+// transfers, which --print writes in place of their TP frames. --columns
+// also writes every decoded signal value to a column file at PATH, see
+// ColumnWriter. --stats prints the count, mean, standard deviation, range,
+// quantiles and out-of-range counts of every signal with samples, collected
+// on the decode workers by SignalStatsCollector; the signals of reassembled
+// J1939 transfers are not included. --windows writes 1 s, 10 s and 1 min
+// rollups of every signal to a CSV file at PATH, see WindowAggregator.
+// --rules evaluates the rules in PATH, one per line with # comments, see
+// RuleCompiler, and prints every time one of them starts to hold.
+// index writes a LogIndex of the log next to it, at <log>.dbcidx, and query
+// decodes only the blocks of that index that hold the messages of --signals
+// ("Message.Signal" or "Signal", all messages if absent) between --from_s and
+// --to_s seconds.
+// Results go to stdout as key=value lines, like ParseStats::ToString. Exit
+// status: 0 on success, 1 if a file cannot be read or parsed or validation
+// fails, 2 on bad usage.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <initializer_list>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "src/dbc_parser/decoder/asc_reader.h"
+#include "src/dbc_parser/decoder/blf_reader.h"
+#include "src/dbc_parser/decoder/candump_parser.h"
+#include "src/dbc_parser/decoder/frame_decoder.h"
+#include "src/dbc_parser/decoder/j1939_reassembler.h"
+#include "src/dbc_parser/decoder/log_decoder.h"
+#include "src/dbc_parser/parser/dbc_file_parser.h"
+#include "src/dbc_parser/parser/parse_stats.h"
+#include "src/dbc_parser/rules/rule_engine.h"
+#include "src/dbc_parser/stats/signal_stats.h"
+#include "src/dbc_parser/stats/window_aggregator.h"
+#include "src/dbc_parser/storage/column_writer.h"
+#include "src/dbc_parser/storage/log_index.h"
+#include "tools/dbc_validator.h"
+
+namespace {
+
+using dbc_parser::decoder::AscReader;
+using dbc_parser::decoder::BlfReader;
+using dbc_parser::decoder::CandumpParser;
+using dbc_parser::decoder::CanFrame;
+using dbc_parser::decoder::DecodedFrame;
+using dbc_parser::decoder::FrameDecoder;
+using dbc_parser::decoder::FrameDecoderOptions;
+using dbc_parser::decoder::J1939Reassembler;
+using dbc_parser::decoder::J1939Transfer;
+using dbc_parser::decoder::LogDecodeOptions;
+using dbc_parser::decoder::LogDecoder;
+using dbc_parser::decoder::LogDecodeStats;
+using dbc_parser::parser::DbcFile;
+using dbc_parser::parser::DbcFileParser;
+using dbc_parser::parser::ParseStats;
+using dbc_parser::rules::RuleEngine;
+using dbc_parser::stats::SignalMoments;
+using dbc_parser::stats::SignalStats;
+using dbc_parser::stats::SignalStatsCollector;
+using dbc_parser::stats::SignalWindow;
+using dbc_parser::stats::WindowAggregator;
+using dbc_parser::storage::ColumnWriter;
+using dbc_parser::storage::LogIndex;
+using dbc_parser::storage::LogIndexOptions;
+using dbc_parser::storage::LogQuery;
+using dbc_parser::tools::DbcValidator;
+using dbc_parser::tools::Severity;
+using dbc_parser::tools::ValidationIssue;
+
+constexpr int kUsageError = 2;
+
+struct Arguments {
+  std::vector<std::string> files;
+  std::vector<std::pair<std::string, std::string>> flags;  ///< --name=value, value "" for --name
+
+  // The flag's value, or std::nullopt if it was not given
+  [[nodiscard]] std::optional<std::string> Flag(std::string_view name) const {
+    for (const auto& [flag, value] : flags) {
+      if (flag == name) {
+        return value;
+      }
+    }
+    return std::nullopt;
+  }
+
+  [[nodiscard]] bool OnlyFlags(std::initializer_list<std::string_view> known) const {
+    return std::all_of(flags.begin(), flags.end(), [&known](const auto& flag) {
+      return std::find(known.begin(), known.end(), flag.first) != known.end();
+    });
+  }
+};
+
+void PrintUsage() {
+  std::fprintf(stderr,
+               "Usage: dbc_tool stats <file.dbc>\n"
+               "       dbc_tool validate [--warnings_as_errors] <file.dbc>\n"
+               "       dbc_tool bench [--iterations=N] [--warmup=N] <file.dbc>\n"
+               "       dbc_tool decode [--threads=N] [--chunk_bytes=N] [--print] [--from_s=S] [--j1939] "
+               "[--columns=PATH] [--stats] [--windows=PATH] [--rules=PATH] <file.dbc> <candump.log|trace.asc|trace.blf>\n"
+               "       dbc_tool index [--bucket_s=S] [--block_bytes=N] [--threads=N] <log>\n"
+               "       dbc_tool query [--signals=A,B] [--from_s=S] [--to_s=S] [--threads=N] [--print] "
+               "<file.dbc> <log>\n");
+}
+
+bool ReadFile(const std::string& path, std::string& contents) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    std::fprintf(stderr, "Cannot read %s\n", path.c_str());
+    return false;
+  }
+  contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  return true;
+}
+
+double SecondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+double MegabytesPerSecond(std::size_t bytes, double seconds) {
+  return seconds > 0 ? static_cast<double>(bytes) / 1e6 / seconds : 0.0;
+}
+
+std::optional<DbcFile> ParseDbc(const std::string& path, std::string& text, ParseStats* stats = nullptr) {
+  if (!ReadFile(path, text)) {
+    return std::nullopt;
+  }
+  auto dbc = DbcFileParser().Parse(text, stats);
+  if (!dbc) {
+    std::fprintf(stderr, "Cannot parse %s\n", path.c_str());
+  }
+  return dbc;
+}
+
+int RunStats(const Arguments& args) {
+  if (args.files.size() != 1 || !args.OnlyFlags({})) {
+    PrintUsage();
+    return kUsageError;
+  }
+  std::string text;
+  ParseStats stats;
+  const auto dbc = ParseDbc(args.files[0], text, &stats);
+  if (!dbc) {
+    return 1;
+  }
+
+  const double seconds = static_cast<double>(stats.total_nanoseconds) / 1e9;
+  std::printf("file bytes=%zu parse_ms=%.3f mb_per_s=%.1f\n", text.size(), seconds * 1e3,
+              MegabytesPerSecond(text.size(), seconds));
+  std::printf("model nodes=%zu messages=%zu signals=%zu value_tables=%zu comments=%zu "
+              "attribute_definitions=%zu attribute_values=%zu value_descriptions=%zu "
+              "signal_groups=%zu environment_variables=%zu\n",
+              dbc->nodes.size(), dbc->messages_detailed.size(), dbc->signal_layouts.size(),
+              dbc->value_tables.size(), dbc->comments.size(), dbc->attribute_definitions.size(),
+              dbc->attribute_values.size(), dbc->value_descriptions.size(), dbc->signal_groups.size(),
+              dbc->environment_variables.size());
+  std::fputs(stats.ToString().c_str(), stdout);
+  return 0;
+}
+
+int RunValidate(const Arguments& args) {
+  if (args.files.size() != 1 || !args.OnlyFlags({"warnings_as_errors"})) {
+    PrintUsage();
+    return kUsageError;
+  }
+  std::string text;
+  const auto dbc = ParseDbc(args.files[0], text);
+  if (!dbc) {
+    return 1;
+  }
+
+  const std::vector<ValidationIssue> issues = DbcValidator::Validate(*dbc);
+  for (const ValidationIssue& issue : issues) {
+    std::printf("%s: %s\n", issue.severity == Severity::kError ? "error" : "warning", issue.message.c_str());
+  }
+  const std::size_t errors = DbcValidator::Count(issues, Severity::kError);
+  const std::size_t warnings = DbcValidator::Count(issues, Severity::kWarning);
+  std::printf("validate errors=%zu warnings=%zu\n", errors, warnings);
+  const bool failed = errors > 0 || (args.Flag("warnings_as_errors") && warnings > 0);
+  return failed ? 1 : 0;
+}
+
+int RunBench(const Arguments& args) {
+  if (args.files.size() != 1 || !args.OnlyFlags({"iterations", "warmup"})) {
+    PrintUsage();
+    return kUsageError;
+  }
+  const int iterations = std::max(1, std::atoi(args.Flag("iterations").value_or("20").c_str()));
+  const int warmup = std::max(0, std::atoi(args.Flag("warmup").value_or("2").c_str()));
+  std::string text;
+  if (!ReadFile(args.files[0], text)) {
+    return 1;
+  }
+
+  std::vector<double> seconds;
+  seconds.reserve(static_cast<std::size_t>(iterations));
+  for (int i = 0; i < warmup + iterations; ++i) {
+    DbcFileParser dbc_parser;
+    const auto start = std::chrono::steady_clock::now();
+    const bool parsed = dbc_parser.Parse(text).has_value();
+    const double elapsed = SecondsSince(start);
+    if (!parsed) {
+      std::fprintf(stderr, "Cannot parse %s\n", args.files[0].c_str());
+      return 1;
+    }
+    if (i >= warmup) {
+      seconds.push_back(elapsed);
+    }
+  }
+
+  std::sort(seconds.begin(), seconds.end());
+  // Nearest-rank percentile
+  const auto percentile = [&seconds](double p) {
+    const auto rank = static_cast<std::size_t>(p / 100.0 * static_cast<double>(seconds.size()) + 0.999999);
+    return seconds[std::min(seconds.size(), std::max<std::size_t>(rank, 1)) - 1];
+  };
+  std::printf("bench bytes=%zu iterations=%d min_ms=%.3f p50_ms=%.3f p90_ms=%.3f p99_ms=%.3f max_ms=%.3f "
+              "p50_mb_per_s=%.1f\n",
+              text.size(), iterations, seconds.front() * 1e3, percentile(50) * 1e3, percentile(90) * 1e3,
+              percentile(99) * 1e3, seconds.back() * 1e3, MegabytesPerSecond(text.size(), percentile(50)));
+  return 0;
+}
+
+// The message name and the signals that have a value, ending the line
+void PrintSignals(const DbcFile& dbc, const FrameDecoder::MessageEntry& message, const double* values) {
+  std::printf(" %s", message.message->name.c_str());
+  for (std::uint32_t i = 0; i < message.signal_count; ++i) {
+    if (!std::isnan(values[i])) {
+      std::printf(" %s=%g", dbc.signal_infos[message.message->first_signal + i].name.c_str(), values[i]);
+    }
+  }
+  std::printf("\n");
+}
+
+// One decoded frame per line: time, channel, ID and the signals that have a value
+void PrintFrame(const DbcFile& dbc, const DecodedFrame& decoded) {
+  const CanFrame& frame = *decoded.frame;
+  std::printf("%lld.%06lld %u %X", static_cast<long long>(frame.timestamp_ns / 1000000000),
+              static_cast<long long>(frame.timestamp_ns % 1000000000 / 1000), frame.channel, frame.id);
+  if (decoded.message == nullptr) {
+    std::printf(" ?\n");
+    return;
+  }
+  PrintSignals(dbc, *decoded.message, decoded.values);
+}
+
+// One reassembled transfer per line: time, channel, PGN, source and
+// destination address, and the signals like PrintFrame
+void PrintTransfer(const DbcFile& dbc, const J1939Transfer& transfer) {
+  std::printf("%lld.%06lld %u PGN%05X %02X>%02X %zuB", static_cast<long long>(transfer.timestamp_ns / 1000000000),
+              static_cast<long long>(transfer.timestamp_ns % 1000000000 / 1000), transfer.channel, transfer.pgn,
+              transfer.source_address, transfer.destination_address, transfer.size);
+  if (transfer.message == nullptr) {
+    std::printf(" ?\n");
+    return;
+  }
+  PrintSignals(dbc, *transfer.message, transfer.values);
+}
+
+// One line per signal with samples: moments, quantiles and range violations
+void PrintSignalStats(const DbcFile& dbc, const SignalStats& stats) {
+  for (const auto& [id, message] : dbc.messages_detailed) {
+    for (std::uint32_t i = 0; i < message.signal_count; ++i) {
+      const std::uint32_t signal_id = message.first_signal + i;
+      const SignalMoments& moments = stats.moments(signal_id);
+      if (moments.count == 0) {
+        continue;
+      }
+      std::printf("signal name=%s.%s count=%llu mean=%g stddev=%g min=%g max=%g p50=%g p99=%g p999=%g "
+                  "below_minimum=%llu above_maximum=%llu\n",
+                  message.name.c_str(), dbc.signal_infos[signal_id].name.c_str(),
+                  static_cast<unsigned long long>(moments.count), moments.mean, moments.StandardDeviation(),
+                  moments.min, moments.max, stats.Quantile(signal_id, 0.5), stats.Quantile(signal_id, 0.99),
+                  stats.Quantile(signal_id, 0.999), static_cast<unsigned long long>(moments.below_minimum),
+                  static_cast<unsigned long long>(moments.above_maximum));
+    }
+  }
+}
+
+int RunDecode(const Arguments& args) {
+  if (args.files.size() != 2 ||
+      !args.OnlyFlags({"threads", "chunk_bytes", "print", "from_s", "j1939", "columns", "stats", "windows",
+                        "rules"})) {
+    PrintUsage();
+    return kUsageError;
+  }
+  LogDecodeOptions options;
+  options.threads = static_cast<std::size_t>(std::max(0, std::atoi(args.Flag("threads").value_or("0").c_str())));
+  if (const auto chunk_bytes = args.Flag("chunk_bytes")) {
+    options.chunk_bytes = static_cast<std::size_t>(std::max(1LL, std::atoll(chunk_bytes->c_str())));
+  }
+
+  std::string dbc_text;
+  const auto dbc = ParseDbc(args.files[0], dbc_text);
+  if (!dbc) {
+    return 1;
+  }
+  FrameDecoderOptions decoder_options;
+  decoder_options.j1939_all_extended = args.Flag("j1939").has_value();
+  const FrameDecoder decoder(*dbc, decoder_options);
+  const bool print = args.Flag("print").has_value();
+
+  std::ofstream columns_out;
+  std::optional<ColumnWriter> columns;
+  if (const auto columns_path = args.Flag("columns")) {
+    columns_out.open(*columns_path, std::ios::binary | std::ios::trunc);
+    if (!columns_out) {
+      std::fprintf(stderr, "Cannot write %s\n", columns_path->c_str());
+      return 1;
+    }
+    columns.emplace(columns_out, *dbc);
+  }
+  std::ofstream windows_out;
+  std::optional<WindowAggregator> windows;
+  if (const auto windows_path = args.Flag("windows")) {
+    windows_out.open(*windows_path, std::ios::trunc);
+    if (!windows_out) {
+      std::fprintf(stderr, "Cannot write %s\n", windows_path->c_str());
+      return 1;
+    }
+    windows_out << "signal,resolution_s,start_s,count,first,last,min,max,mean,mode\n";
+    windows.emplace(*dbc, [&dbc, &windows, &windows_out](const SignalWindow* closed, std::size_t count) {
+      char line[256];
+      for (std::size_t i = 0; i < count; ++i) {
+        const SignalWindow& window = closed[i];
+        const auto& info = dbc->signal_infos[window.signal_id];
+        std::snprintf(line, sizeof(line), "%s.%s,%g,%.6f,%llu,%g,%g,%g,%g,%g,%g\n",
+                      dbc->messages_detailed.at(info.message_id).name.c_str(), info.name.c_str(),
+                      static_cast<double>(windows->resolutions_ns()[window.resolution]) / 1e9,
+                      static_cast<double>(window.start_ns) / 1e9, static_cast<unsigned long long>(window.count),
+                      window.first, window.last, window.min, window.max, window.mean, window.mode);
+        windows_out << line;
+      }
+    });
+  }
+  std::optional<RuleEngine> rules;
+  if (const auto rules_path = args.Flag("rules")) {
+    std::string rules_text;
+    if (!ReadFile(*rules_path, rules_text)) {
+      return 1;
+    }
+    rules.emplace(decoder, *dbc, [&rules](std::uint32_t rule_id, std::int64_t timestamp_ns) {
+      std::printf("trigger t=%.6f rule=%u %s\n", static_cast<double>(timestamp_ns) / 1e9, rule_id,
+                  rules->rule(rule_id).text.c_str());
+    });
+    std::size_t line_number = 0;
+    for (std::string_view rest = rules_text; !rest.empty();) {
+      const std::size_t end = std::min(rest.find('\n'), rest.size());
+      std::string_view line = rest.substr(0, end);
+      rest.remove_prefix(std::min(end + 1, rest.size()));
+      ++line_number;
+      line = line.substr(0, line.find('#'));
+      if (line.find_first_not_of(" \t\r") == std::string_view::npos) {
+        continue;
+      }
+      std::string error;
+      if (!rules->AddRule(line, &error)) {
+        std::fprintf(stderr, "%s:%zu: %s\n", rules_path->c_str(), line_number, error.c_str());
+        return 1;
+      }
+    }
+  }
+  std::optional<SignalStatsCollector> signal_stats;
+  if (args.Flag("stats")) {
+    signal_stats.emplace(*dbc, options);
+  }
+
+  const auto on_message = [&dbc, &columns, &windows, &rules, print](const DecodedFrame& decoded) {
+    if (print) {
+      PrintFrame(*dbc, decoded);
+    }
+    if (columns && decoded.message != nullptr) {
+      columns->AddMessage(*decoded.message, decoded.frame->timestamp_ns, decoded.values);
+    }
+    if (windows && decoded.message != nullptr) {
+      windows->AddMessage(*decoded.message, decoded.frame->timestamp_ns, decoded.values);
+    }
+    if (rules && decoded.message != nullptr) {
+      rules->AddMessage(*decoded.message, decoded.frame->timestamp_ns, decoded.values);
+    }
+  };
+  LogDecoder::FrameCallback on_frame;
+  std::optional<J1939Reassembler> reassembler;
+  if (decoder_options.j1939_all_extended) {
+    reassembler.emplace(decoder, [&dbc, &columns, &windows, &rules, print](const J1939Transfer& transfer) {
+      if (print) {
+        PrintTransfer(*dbc, transfer);
+      }
+      if (columns && transfer.message != nullptr) {
+        columns->AddMessage(*transfer.message, transfer.timestamp_ns, transfer.values);
+      }
+      if (windows && transfer.message != nullptr) {
+        windows->AddMessage(*transfer.message, transfer.timestamp_ns, transfer.values);
+      }
+      if (rules && transfer.message != nullptr) {
+        rules->AddMessage(*transfer.message, transfer.timestamp_ns, transfer.values);
+      }
+    });
+    on_frame = [&reassembler, on_message](const DecodedFrame& decoded) {
+      if (!reassembler->Add(*decoded.frame)) {
+        on_message(decoded);
+      }
+    };
+  } else if (print || columns || windows || rules) {
+    on_frame = on_message;
+  }
+  const std::string& log_path = args.files[1];
+  const auto has_extension = [&log_path](std::string_view extension) {
+    return log_path.size() >= extension.size() &&
+           log_path.compare(log_path.size() - extension.size(), extension.size(), extension) == 0;
+  };
+  std::optional<LogDecodeStats> stats;
+  if (has_extension(".blf")) {
+    const auto from_s = args.Flag("from_s");
+    const std::int64_t from_ns =
+        from_s ? static_cast<std::int64_t>(std::atof(from_s->c_str()) * 1e9) : BlfReader::kFromStart;
+    stats = BlfReader(decoder, options).DecodeFile(log_path, on_frame, nullptr, from_ns);
+  } else if (has_extension(".asc")) {
+    stats = AscReader(decoder, options).DecodeFile(log_path, on_frame);
+  } else {
+    stats = LogDecoder(decoder, &CandumpParser::ParseLine, options).DecodeFile(log_path, on_frame);
+  }
+  if (!stats) {
+    std::fprintf(stderr, "Cannot read %s\n", args.files[1].c_str());
+    return 1;
+  }
+
+  std::printf("decode bytes=%llu chunks=%llu lines=%llu frames=%llu malformed_lines=%llu unknown_frames=%llu "
+              "signals=%llu late_frames=%llu threads=%zu decode_s=%.3f frames_per_s=%.0f mb_per_s=%.1f\n",
+              static_cast<unsigned long long>(stats->bytes), static_cast<unsigned long long>(stats->chunks),
+              static_cast<unsigned long long>(stats->lines), static_cast<unsigned long long>(stats->frames),
+              static_cast<unsigned long long>(stats->malformed_lines),
+              static_cast<unsigned long long>(stats->unknown_frames),
+              static_cast<unsigned long long>(stats->signals), static_cast<unsigned long long>(stats->late_frames),
+              stats->threads, stats->seconds, stats->FramesPerSecond(),
+              MegabytesPerSecond(static_cast<std::size_t>(stats->bytes), stats->seconds));
+  if (reassembler) {
+    const auto& j1939 = reassembler->stats();
+    std::printf("j1939 transfers=%llu aborted=%llu timed_out=%llu orphan_packets=%llu malformed=%llu\n",
+                static_cast<unsigned long long>(j1939.transfers), static_cast<unsigned long long>(j1939.aborted),
+                static_cast<unsigned long long>(j1939.timed_out),
+                static_cast<unsigned long long>(j1939.orphan_packets),
+                static_cast<unsigned long long>(j1939.malformed));
+  }
+  if (columns) {
+    if (!columns->Finish()) {
+      std::fprintf(stderr, "Cannot write %s\n", args.Flag("columns")->c_str());
+      return 1;
+    }
+    const auto& written = columns->stats();
+    std::printf("columns bytes=%llu samples=%llu chunks=%llu bytes_per_sample=%.2f\n",
+                static_cast<unsigned long long>(written.bytes), static_cast<unsigned long long>(written.samples),
+                static_cast<unsigned long long>(written.chunks),
+                written.samples == 0 ? 0.0 : static_cast<double>(written.bytes) / static_cast<double>(written.samples));
+  }
+  if (windows) {
+    windows->Finish();
+    if (!windows_out.flush()) {
+      std::fprintf(stderr, "Cannot write %s\n", args.Flag("windows")->c_str());
+      return 1;
+    }
+    std::printf("windows emitted=%llu\n", static_cast<unsigned long long>(windows->emitted()));
+  }
+  if (rules) {
+    std::printf("rules count=%zu evaluated=%llu triggered=%llu\n", rules->rule_count(),
+                static_cast<unsigned long long>(rules->evaluated()),
+                static_cast<unsigned long long>(rules->triggered()));
+  }
+  if (signal_stats) {
+    PrintSignalStats(*dbc, signal_stats->Finish());
+  }
+  return 0;
+}
+
+int RunIndex(const Arguments& args) {
+  if (args.files.size() != 1 || !args.OnlyFlags({"bucket_s", "block_bytes", "threads"})) {
+    PrintUsage();
+    return kUsageError;
+  }
+  LogIndexOptions options;
+  options.threads = static_cast<std::size_t>(std::max(0, std::atoi(args.Flag("threads").value_or("0").c_str())));
+  if (const auto bucket_s = args.Flag("bucket_s")) {
+    options.bucket_ns = std::max<std::int64_t>(1, static_cast<std::int64_t>(std::atof(bucket_s->c_str()) * 1e9));
+  }
+  if (const auto block_bytes = args.Flag("block_bytes")) {
+    options.block_bytes = static_cast<std::size_t>(std::max(1LL, std::atoll(block_bytes->c_str())));
+  }
+
+  const std::string& log_path = args.files[0];
+  const std::string index_path = LogIndex::SidecarPath(log_path);
+  const auto start = std::chrono::steady_clock::now();
+  if (!LogIndex::BuildFile(log_path, index_path, options)) {
+    std::fprintf(stderr, "Cannot index %s\n", log_path.c_str());
+    return 1;
+  }
+  const double seconds = SecondsSince(start);
+  const auto index = LogIndex::OpenFile(index_path, log_path);
+  if (!index) {
+    std::fprintf(stderr, "Cannot read %s\n", index_path.c_str());
+    return 1;
+  }
+  std::printf("index path=%s frames=%llu blocks=%zu buckets=%zu ids=%zu index_s=%.3f\n", index_path.c_str(),
+              static_cast<unsigned long long>(index->frame_count()), index->block_count(), index->bucket_count(),
+              index->id_count(), seconds);
+  return 0;
+}
+
+int RunQuery(const Arguments& args) {
+  if (args.files.size() != 2 || !args.OnlyFlags({"signals", "from_s", "to_s", "threads", "print"})) {
+    PrintUsage();
+    return kUsageError;
+  }
+  LogDecodeOptions options;
+  options.threads = static_cast<std::size_t>(std::max(0, std::atoi(args.Flag("threads").value_or("0").c_str())));
+
+  std::string dbc_text;
+  const auto dbc = ParseDbc(args.files[0], dbc_text);
+  if (!dbc) {
+    return 1;
+  }
+  const FrameDecoder decoder(*dbc);
+  const std::string& log_path = args.files[1];
+  const auto index = LogIndex::OpenFile(LogIndex::SidecarPath(log_path), log_path);
+  if (!index) {
+    std::fprintf(stderr, "Cannot read the index of %s; run dbc_tool index first\n", log_path.c_str());
+    return 1;
+  }
+
+  LogQuery query;
+  if (const auto signals = args.Flag("signals")) {
+    std::vector<std::string> names;
+    for (std::size_t begin = 0; begin <= signals->size();) {
+      const std::size_t end = std::min(signals->find(',', begin), signals->size());
+      if (end > begin) {
+        names.push_back(signals->substr(begin, end - begin));
+      }
+      begin = end + 1;
+    }
+    const auto ids = LogIndex::MessageIdsOf(*dbc, names);
+    if (!ids) {
+      std::fprintf(stderr, "Unknown signal in %s\n", signals->c_str());
+      return kUsageError;
+    }
+    query.message_ids = *ids;
+  }
+  if (const auto from_s = args.Flag("from_s")) {
+    query.from_ns = static_cast<std::int64_t>(std::atof(from_s->c_str()) * 1e9);
+  }
+  if (const auto to_s = args.Flag("to_s")) {
+    query.to_ns = static_cast<std::int64_t>(std::atof(to_s->c_str()) * 1e9);
+  }
+
+  const bool print = args.Flag("print").has_value();
+  std::uint64_t frames = 0;
+  const auto stats = index->Decode(
+      decoder, query,
+      [&dbc, &frames, print](const DecodedFrame& decoded) {
+        ++frames;
+        if (print) {
+          PrintFrame(*dbc, decoded);
+        }
+      },
+      options);
+  if (!stats) {
+    std::fprintf(stderr, "Cannot read %s\n", log_path.c_str());
+    return 1;
+  }
+  std::size_t blocks = 0;
+  for (const auto& [first, last] : index->SelectBlocks(decoder, query)) {
+    blocks += last - first;
+  }
+  std::uint64_t log_bytes = 0;
+  for (std::size_t i = 0; i < index->block_count(); ++i) {
+    log_bytes += index->block(i).size;
+  }
+  std::printf("query frames=%llu blocks=%zu total_blocks=%zu bytes=%llu total_bytes=%llu decode_s=%.3f\n",
+              static_cast<unsigned long long>(frames), blocks, index->block_count(),
+              static_cast<unsigned long long>(stats->bytes), static_cast<unsigned long long>(log_bytes),
+              stats->seconds);
+  return 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    PrintUsage();
+    return kUsageError;
+  }
+
+  Arguments args;
+  for (int i = 2; i < argc; ++i) {
+    const std::string_view arg = argv[i];
+    if (arg.substr(0, 2) == "--") {
+      const std::size_t equals = arg.find('=');
+      const std::string_view name = arg.substr(2, equals == std::string_view::npos ? arg.npos : equals - 2);
+      const std::string_view value = equals == std::string_view::npos ? "" : arg.substr(equals + 1);
+      args.flags.emplace_back(std::string(name), std::string(value));
+    } else {
+      args.files.emplace_back(arg);
+    }
+  }
+
+  const std::string_view command = argv[1];
+  if (command == "stats") {
+    return RunStats(args);
+  }
+  if (command == "validate") {
+    return RunValidate(args);
+  }
+  if (command == "bench") {
+    return RunBench(args);
+  }
+  if (command == "decode") {
+    return RunDecode(args);
+  }
+  if (command == "index") {
+    return RunIndex(args);
+  }
+  if (command == "query") {
+    return RunQuery(args);
+  }
+  PrintUsage();
+  return kUsageError;
+}
@@ -0,0 +1,206 @@
+#include "tools/dbc_validator.h"
+
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+
+#include "dbc_parser/decoder/can_frame.h"
+
+namespace dbc_parser {
+namespace tools {
+namespace {
+
+using decoder::CanFrame;
+using parser::DbcFile;
+using parser::SignalLayout;
+
+constexpr std::size_t kMaxMessageBytes = 64;
+constexpr std::string_view kNoNode = "Vector__XXX";
+
+// Payload bits, numbered byte * 8 + bit within the byte
+using PayloadBits = std::bitset<kMaxMessageBytes * 8>;
+
+std::string MessageLabel(int id, std::string_view name) {
+  std::string label = "BO_ " + std::to_string(static_cast<std::uint32_t>(id));
+  if (!name.empty()) {
+    label += ' ';
+    label += name;
+  }
+  return label;
+}
+
+// Marks the bits a signal occupies; returns false if it does not fit in
+// message_bytes
+bool MarkSignalBits(const SignalLayout& layout, std::size_t message_bytes, PayloadBits& bits) {
+  std::size_t bit = layout.start_bit;
+  for (unsigned i = 0; i < layout.length; ++i) {
+    if (bit / 8 >= message_bytes) {
+      return false;
+    }
+    bits.set(bit);
+    if (layout.is_little_endian()) {
+      ++bit;
+    } else if (bit % 8 == 0) {
+      // Motorola continues at the MSB of the next byte
+      bit += 15;
+    } else {
+      --bit;
+    }
+  }
+  return true;
+}
+
+// Whether two signals can be present in the same frame
+bool CanCoexist(const SignalLayout& a, const SignalLayout& b) {
+  return !(a.is_multiplexed() && b.is_multiplexed() && a.multiplex_value != b.multiplex_value);
+}
+
+class Checker {
+ public:
+  explicit Checker(const DbcFile& dbc_file) : dbc_file_(dbc_file) {
+    nodes_.insert(dbc_file.nodes.begin(), dbc_file.nodes.end());
+  }
+
+  std::vector<ValidationIssue> Run() {
+    std::unordered_set<std::string_view> message_names;
+    for (const auto& [id, message] : dbc_file_.messages_detailed) {
+      CheckMessage(message);
+      if (!message.name.empty() && !message_names.insert(message.name).second) {
+        Add(Severity::kWarning, MessageLabel(id, message.name) + ": duplicate message name");
+      }
+    }
+    CheckReferences();
+    return std::move(issues_);
+  }
+
+ private:
+  void Add(Severity severity, std::string message) { issues_.push_back({severity, std::move(message)}); }
+
+  bool IsKnownNode(const std::string& name) const {
+    return name.empty() || name == kNoNode || nodes_.count(name) != 0;
+  }
+
+  void CheckMessage(const DbcFile::MessageDef& message) {
+    const std::string label = MessageLabel(message.id, message.name);
+    if (!IsKnownNode(message.transmitter)) {
+      Add(Severity::kWarning, label + ": transmitter " + message.transmitter + " is not in BU_");
+    }
+    const bool size_valid = message.size >= 0 && static_cast<std::size_t>(message.size) <= kMaxMessageBytes;
+    if (!size_valid) {
+      Add(Severity::kError, label + ": size " + std::to_string(message.size) + " is outside 0..64 bytes");
+    } else if (!message.is_fd() && message.size > 8) {
+      Add(Severity::kError, label + ": size " + std::to_string(message.size) + " needs a CAN FD VFrameFormat");
+    } else if (message.is_fd() && !CanFrame::IsFdSize(static_cast<std::size_t>(message.size))) {
+      Add(Severity::kWarning, label + ": size " + std::to_string(message.size) + " is not a CAN FD payload size");
+    }
+
+    const SignalLayout* layouts = dbc_file_.SignalLayoutsOf(message);
+    std::vector<PayloadBits> bits(message.signal_count);
+    std::vector<bool> placed(message.signal_count, false);
+    std::unordered_set<std::string_view> names;
+    bool has_multiplexor = false;
+    bool has_multiplexed = false;
+
+    for (std::uint32_t i = 0; i < message.signal_count; ++i) {
+      const SignalLayout& layout = layouts[i];
+      const parser::SignalInfo& info = dbc_file_.signal_infos[message.first_signal + i];
+      const std::string signal = label + ": SG_ " + info.name;
+      has_multiplexor |= layout.is_multiplexor() && !layout.is_multiplexed();
+      has_multiplexed |= layout.is_multiplexed();
+
+      if (!names.insert(info.name).second) {
+        Add(Severity::kError, signal + ": duplicate signal name");
+      }
+      if (layout.length == 0 || layout.length > 64) {
+        Add(Severity::kError, signal + ": length " + std::to_string(layout.length) + " is outside 1..64 bits");
+      } else if (size_valid) {
+        placed[i] = MarkSignalBits(layout, static_cast<std::size_t>(message.size), bits[i]);
+        if (!placed[i]) {
+          Add(Severity::kError, signal + ": does not fit in the " + std::to_string(message.size) + "-byte payload");
+        }
+      }
+      if (((layout.flags & SignalLayout::kFloat32) && layout.length != 32) ||
+          ((layout.flags & SignalLayout::kFloat64) && layout.length != 64)) {
+        Add(Severity::kError, signal + ": SIG_VALTYPE_ does not match length " + std::to_string(layout.length));
+      }
+      if (layout.minimum > layout.maximum) {
+        Add(Severity::kWarning, signal + ": minimum is greater than maximum");
+      }
+      for (const std::string& receiver : info.receivers) {
+        if (!IsKnownNode(receiver)) {
+          Add(Severity::kWarning, signal + ": receiver " + receiver + " is not in BU_");
+        }
+      }
+
+      for (std::uint32_t j = 0; j < i && placed[i]; ++j) {
+        if (placed[j] && CanCoexist(layout, layouts[j]) && (bits[i] & bits[j]).any()) {
+          Add(Severity::kError,
+              signal + ": overlaps SG_ " + dbc_file_.signal_infos[message.first_signal + j].name);
+        }
+      }
+    }
+
+    if (has_multiplexed && !has_multiplexor) {
+      Add(Severity::kError, label + ": multiplexed signals without a multiplexor");
+    }
+  }
+
+  void CheckSignalReference(std::string_view statement, int message_id, const std::string& signal_name) {
+    if (dbc_file_.messages_detailed.count(message_id) == 0) {
+      Add(Severity::kWarning, std::string(statement) + " refers to unknown message " +
+                                  std::to_string(static_cast<std::uint32_t>(message_id)));
+    } else if (!dbc_file_.FindSignal(message_id, signal_name)) {
+      Add(Severity::kWarning, std::string(statement) + " refers to unknown signal " +
+                                  MessageLabel(message_id, "") + " " + signal_name);
+    }
+  }
+
+  void CheckReferences() {
+    for (const auto& comment : dbc_file_.comments) {
+      if (comment.type == parser::CommentType::MESSAGE &&
+          dbc_file_.messages_detailed.count(comment.object_id) == 0) {
+        Add(Severity::kWarning, "CM_ refers to unknown message " +
+                                    std::to_string(static_cast<std::uint32_t>(comment.object_id)));
+      } else if (comment.type == parser::CommentType::SIGNAL) {
+        CheckSignalReference("CM_", comment.object_id, comment.object_name);
+      }
+    }
+    for (const auto& description : dbc_file_.value_descriptions) {
+      if (description.type == parser::ValueDescriptionType::SIGNAL) {
+        CheckSignalReference("VAL_", description.message_id, description.signal_name);
+      }
+    }
+    for (const auto& value_type : dbc_file_.signal_value_types) {
+      CheckSignalReference("SIG_VALTYPE_", value_type.message_id, value_type.signal_name);
+    }
+    for (const auto& group : dbc_file_.signal_groups) {
+      for (const std::string& name : group.signal_names) {
+        CheckSignalReference("SIG_GROUP_ " + group.name, group.message_id, name);
+      }
+    }
+  }
+
+  const DbcFile& dbc_file_;
+  std::set<std::string, std::less<>> nodes_;
+  std::vector<ValidationIssue> issues_;
+};
+
+}  // namespace
+
+std::vector<ValidationIssue> DbcValidator::Validate(const parser::DbcFile& dbc_file) {
+  return Checker(dbc_file).Run();
+}
+
+std::size_t DbcValidator::Count(const std::vector<ValidationIssue>& issues, Severity severity) noexcept {
+  return static_cast<std::size_t>(std::count_if(issues.begin(), issues.end(), [severity](const ValidationIssue& issue) {
+    return issue.severity == severity;
+  }));
+}
+
+}  // namespace tools
+}  // namespace dbc_parser
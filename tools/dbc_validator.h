@@ -0,0 +1,70 @@
+#ifndef DBC_PARSER_TOOLS_DBC_VALIDATOR_H_
+#define DBC_PARSER_TOOLS_DBC_VALIDATOR_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "dbc_parser/parser/dbc_file_parser.h"
+
+namespace dbc_parser {
+namespace tools {
+
+/**
+ * @brief How serious a validation finding is.
+ */
+enum class Severity {
+  kWarning,  ///< Suspicious, but decoding still works
+  kError,    ///< Signals would decode wrongly or not at all
+};
+
+/**
+ * @brief One finding of DbcValidator.
+ */
+struct ValidationIssue {
+  Severity severity = Severity::kError;  ///< Seriousness
+  std::string message;                   ///< E.g. "BO_ 100 EngineData: SG_ Rpm overlaps SG_ Speed"
+};
+
+/**
+ * @brief Semantic checks on a parsed DBC file.
+ *
+ * The parser accepts anything that is syntactically valid; the validator
+ * finds what would break decoding. Errors:
+ * - message sizes outside 0..64 bytes
+ * - signals of length 0 or over 64 bits, or extending past the message size
+ * - signals that overlap another signal that can be present in the same frame
+ * - duplicate signal names within a message
+ * - multiplexed signals in a message without a multiplexor
+ * - SIG_VALTYPE_ float or double on a signal that is not 32 or 64 bits long
+ *
+ * Warnings:
+ * - transmitters and receivers missing from BU_ (Vector__XXX excepted)
+ * - signals with minimum greater than maximum
+ * - duplicate message names
+ * - CM_, VAL_, SIG_VALTYPE_ and SIG_GROUP_ statements naming an unknown
+ *   message or signal
+ */
+class DbcValidator {
+ public:
+  DbcValidator() = delete;
+
+  /**
+   * @brief Runs all checks.
+   *
+   * @param dbc_file Parsed file
+   * @return std::vector<ValidationIssue> Findings per message in message ID
+   *         order, then unresolved references
+   */
+  [[nodiscard]] static std::vector<ValidationIssue> Validate(const parser::DbcFile& dbc_file);
+
+  /**
+   * @brief Number of findings with the given severity.
+   */
+  [[nodiscard]] static std::size_t Count(const std::vector<ValidationIssue>& issues, Severity severity) noexcept;
+};
+
+}  // namespace tools
+}  // namespace dbc_parser
+
+#endif  // DBC_PARSER_TOOLS_DBC_VALIDATOR_H_